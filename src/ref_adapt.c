@@ -69,6 +69,10 @@ REF_FCN REF_STATUS ref_adapt_create(REF_ADAPT *ref_adapt_ptr) {
   ref_adapt->last_max_ratio = 6.0;
 
   ref_adapt->unlock_tet = REF_FALSE;
+  ref_adapt->active_region = REF_FALSE;
+
+  ref_adapt->attempted = 0;
+  ref_adapt->accepted = 0;
 
   ref_adapt->timing_level = 0;
   ref_adapt->watch_param = REF_FALSE;
@@ -107,6 +111,10 @@ REF_FCN REF_STATUS ref_adapt_deep_copy(REF_ADAPT *ref_adapt_ptr,
   ref_adapt->last_max_ratio = original->last_max_ratio;
 
   ref_adapt->unlock_tet = original->unlock_tet;
+  ref_adapt->active_region = original->active_region;
+
+  ref_adapt->attempted = original->attempted;
+  ref_adapt->accepted = original->accepted;
 
   ref_adapt->timing_level = original->timing_level;
   ref_adapt->watch_param = original->watch_param;
@@ -115,6 +123,56 @@ REF_FCN REF_STATUS ref_adapt_deep_copy(REF_ADAPT *ref_adapt_ptr,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_adapt_pack(REF_ADAPT ref_adapt, REF_DBL *setting) {
+  REF_INT i = 0;
+
+  setting[i++] = (REF_DBL)ref_adapt->split_ratio_growth;
+  setting[i++] = ref_adapt->split_ratio;
+  setting[i++] = ref_adapt->split_quality_absolute;
+  setting[i++] = ref_adapt->split_quality_relative;
+  setting[i++] = ref_adapt->collapse_ratio;
+  setting[i++] = ref_adapt->collapse_quality_absolute;
+  setting[i++] = ref_adapt->smooth_min_quality;
+  setting[i++] = ref_adapt->smooth_pliant_alpha;
+  setting[i++] = (REF_DBL)ref_adapt->swap_max_degree;
+  setting[i++] = ref_adapt->swap_min_quality;
+  setting[i++] = ref_adapt->post_min_normdev;
+  setting[i++] = ref_adapt->post_min_ratio;
+  setting[i++] = ref_adapt->post_max_ratio;
+  setting[i++] = ref_adapt->last_min_ratio;
+  setting[i++] = ref_adapt->last_max_ratio;
+  setting[i++] = (REF_DBL)ref_adapt->unlock_tet;
+  setting[i++] = (REF_DBL)ref_adapt->watch_topo;
+  setting[i++] = (REF_DBL)ref_adapt->active_region;
+  REIS(REF_ADAPT_NSETTING, i, "setting count");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_adapt_unpack(REF_ADAPT ref_adapt, REF_DBL *setting) {
+  REF_INT i = 0;
+
+  ref_adapt->split_ratio_growth = (REF_BOOL)setting[i++];
+  ref_adapt->split_ratio = setting[i++];
+  ref_adapt->split_quality_absolute = setting[i++];
+  ref_adapt->split_quality_relative = setting[i++];
+  ref_adapt->collapse_ratio = setting[i++];
+  ref_adapt->collapse_quality_absolute = setting[i++];
+  ref_adapt->smooth_min_quality = setting[i++];
+  ref_adapt->smooth_pliant_alpha = setting[i++];
+  ref_adapt->swap_max_degree = (REF_INT)setting[i++];
+  ref_adapt->swap_min_quality = setting[i++];
+  ref_adapt->post_min_normdev = setting[i++];
+  ref_adapt->post_min_ratio = setting[i++];
+  ref_adapt->post_max_ratio = setting[i++];
+  ref_adapt->last_min_ratio = setting[i++];
+  ref_adapt->last_max_ratio = setting[i++];
+  ref_adapt->unlock_tet = (REF_BOOL)setting[i++];
+  ref_adapt->watch_topo = (REF_BOOL)setting[i++];
+  ref_adapt->active_region = (REF_BOOL)setting[i++];
+  REIS(REF_ADAPT_NSETTING, i, "setting count");
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_adapt_free(REF_ADAPT ref_adapt) {
   ref_free(ref_adapt);
 
@@ -130,6 +188,7 @@ REF_FCN static REF_STATUS ref_adapt_parameter(REF_GRID ref_grid,
   REF_INT cell;
   REF_LONG ncell;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_DBL *edge_ratio, *cell_quality, *cell_volume;
   REF_DBL det, max_det, complexity, min_metric_vol;
   REF_DBL quality, min_quality;
   REF_DBL normdev, min_normdev;
@@ -169,16 +228,24 @@ REF_FCN static REF_STATUS ref_adapt_parameter(REF_GRID ref_grid,
   max_det = -1.0;
   complexity = 0.0;
   ncell = 0;
+  ref_malloc(cell_quality, ref_cell_max(ref_cell), REF_DBL);
+  ref_malloc(cell_volume, ref_cell_max(ref_cell), REF_DBL);
+  if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
+    RSS(ref_node_tri_quality_block(ref_node, ref_cell_max(ref_cell),
+                                   &(ref_cell_c2n(ref_cell, 0, 0)),
+                                   ref_cell_size_per(ref_cell), cell_quality,
+                                   cell_volume),
+        "qual");
+  } else {
+    RSS(ref_node_tet_quality_block(ref_node, ref_cell_max(ref_cell),
+                                   &(ref_cell_c2n(ref_cell, 0, 0)),
+                                   ref_cell_size_per(ref_cell), cell_quality,
+                                   cell_volume),
+        "qual");
+  }
   each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-    if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
-      RSS(ref_node_tri_quality(ref_grid_node(ref_grid), nodes, &quality),
-          "qual");
-      RSS(ref_node_tri_area(ref_grid_node(ref_grid), nodes, &volume), "vol");
-    } else {
-      RSS(ref_node_tet_quality(ref_grid_node(ref_grid), nodes, &quality),
-          "qual");
-      RSS(ref_node_tet_vol(ref_grid_node(ref_grid), nodes, &volume), "vol");
-    }
+    quality = cell_quality[cell];
+    volume = cell_volume[cell];
     min_quality = MIN(min_quality, quality);
     min_volume = MIN(min_volume, volume);
     max_volume = MAX(max_volume, volume);
@@ -214,6 +281,8 @@ REF_FCN static REF_STATUS ref_adapt_parameter(REF_GRID ref_grid,
     RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "owner");
     if (part == ref_mpi_rank(ref_mpi)) ncell++;
   }
+  ref_free(cell_volume);
+  ref_free(cell_quality);
   quality = min_quality;
   RSS(ref_mpi_min(ref_mpi, &quality, &min_quality, REF_DBL_TYPE), "mpi min");
   RSS(ref_mpi_bcast(ref_mpi, &quality, 1, REF_DBL_TYPE), "mbast");
@@ -275,17 +344,25 @@ REF_FCN static REF_STATUS ref_adapt_parameter(REF_GRID ref_grid,
   min_ratio = REF_DBL_MAX;
   max_ratio = REF_DBL_MIN;
   RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_node_ratio_batch(ref_grid_node(ref_grid), ref_edge_n(ref_edge),
+                           ref_edge->e2n, edge_ratio),
+      "ratio");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
     if (part == ref_mpi_rank(ref_grid_mpi(ref_grid))) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
+      ratio = edge_ratio[edge];
       min_ratio = MIN(min_ratio, ratio);
       max_ratio = MAX(max_ratio, ratio);
     }
+    /* edges outside the ratio limits keep their nodes active */
+    if (edge_ratio[edge] < ref_adapt->collapse_ratio ||
+        edge_ratio[edge] > ref_adapt->split_ratio) {
+      ref_node_touch(ref_node, ref_edge_e2n(ref_edge, 0, edge));
+      ref_node_touch(ref_node, ref_edge_e2n(ref_edge, 1, edge));
+    }
   }
+  ref_free(edge_ratio);
   RSS(ref_edge_free(ref_edge), "free edge");
   ratio = min_ratio;
   RSS(ref_mpi_min(ref_mpi, &ratio, &min_ratio, REF_DBL_TYPE), "mpi min");
@@ -373,6 +450,7 @@ REF_FCN static REF_STATUS ref_adapt_tattle(REF_GRID ref_grid,
   REF_CELL ref_cell;
   REF_INT cell;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_DBL *edge_ratio;
   REF_DBL quality, min_quality;
   REF_DBL normdev, min_normdev;
   REF_INT node, nnode;
@@ -431,17 +509,19 @@ REF_FCN static REF_STATUS ref_adapt_tattle(REF_GRID ref_grid,
   min_ratio = REF_DBL_MAX;
   max_ratio = REF_DBL_MIN;
   RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_node_ratio_batch(ref_grid_node(ref_grid), ref_edge_n(ref_edge),
+                           ref_edge->e2n, edge_ratio),
+      "ratio");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
     if (part == ref_mpi_rank(ref_grid_mpi(ref_grid))) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
+      ratio = edge_ratio[edge];
       min_ratio = MIN(min_ratio, ratio);
       max_ratio = MAX(max_ratio, ratio);
     }
   }
+  ref_free(edge_ratio);
   RSS(ref_edge_free(ref_edge), "free edge");
   ratio = min_ratio;
   RSS(ref_mpi_min(ref_mpi, &ratio, &min_ratio, REF_DBL_TYPE), "mpi min");
@@ -617,10 +697,124 @@ REF_FCN static REF_STATUS ref_adapt_topo(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
+/* extra swap sweeps while more than this fraction of attempts succeed */
+#define REF_ADAPT_SWAP_REPEAT (2)
+#define REF_ADAPT_SWAP_REPEAT_YIELD (0.25)
+
+REF_FCN static REF_STATUS ref_adapt_operator(REF_GRID ref_grid,
+                                             REF_INT operation,
+                                             REF_LONG *attempted,
+                                             REF_LONG *accepted) {
+  const char *frame[] = {"swap", "collapse", "smooth", "split"};
+  const char *watch[] = {"adapt swap", "adapt col", "adapt move", "adapt spl"};
+  const char *mode[] = {"swap", "col", "move", "split"};
+  REF_LONG yield[2];
+
+  ref_grid_adapt(ref_grid, attempted) = 0;
+  ref_grid_adapt(ref_grid, accepted) = 0;
+  switch (operation) {
+    case REF_ADAPT_SWAP:
+      RSS(ref_adapt_swap(ref_grid), "swap pass");
+      break;
+    case REF_ADAPT_COLLAPSE:
+      RSS(ref_collapse_pass(ref_grid), "col pass");
+      break;
+    case REF_ADAPT_SMOOTH:
+      RSS(ref_smooth_pass(ref_grid), "smooth pass");
+      break;
+    case REF_ADAPT_SPLIT:
+      RSS(ref_split_pass(ref_grid), "split surfpass");
+      break;
+    default:
+      THROW("operation not recognized");
+  }
+  yield[0] = ref_grid_adapt(ref_grid, attempted);
+  yield[1] = ref_grid_adapt(ref_grid, accepted);
+  RSS(ref_mpi_allsum(ref_grid_mpi(ref_grid), yield, 2, REF_LONG_TYPE),
+      "sum yield");
+  *attempted = yield[0];
+  *accepted = yield[1];
+
+  ref_gather_blocking_frame(ref_grid, frame[operation]);
+  if (ref_grid_adapt(ref_grid, timing_level) > 1)
+    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), watch[operation]);
+  if (ref_grid_adapt(ref_grid, watch_param)) {
+    if (ref_grid_once(ref_grid))
+      printf("%s attempted %ld accepted %ld\n", mode[operation], *attempted,
+             *accepted);
+    RSS(ref_adapt_tattle(ref_grid, mode[operation]), "tattle");
+  }
+  if (ref_grid_adapt(ref_grid, watch_topo))
+    RSS(ref_adapt_topo(ref_grid), "topo");
+
+  return REF_SUCCESS;
+}
+
+/* swap and smooth are skipped while idle, an operator is idle after it made
+ * no changes and stays idle until another operator changes the mesh */
+REF_FCN REF_STATUS ref_adapt_skip(REF_INT operation, REF_BOOL *idle,
+                                  REF_BOOL *skip) {
+  RAS(0 <= operation && operation < REF_ADAPT_NOPERATOR, "operation");
+  *skip = (REF_ADAPT_SWAP == operation || REF_ADAPT_SMOOTH == operation) &&
+          idle[operation];
+  return REF_SUCCESS;
+}
+
+/* update idle from the summed yield of one run, only swap repeats */
+REF_FCN REF_STATUS ref_adapt_yield(REF_INT operation, REF_INT sweep,
+                                   REF_LONG attempted, REF_LONG accepted,
+                                   REF_BOOL *idle, REF_BOOL *repeat) {
+  REF_INT other;
+  RAS(0 <= operation && operation < REF_ADAPT_NOPERATOR, "operation");
+  if (accepted > 0) {
+    for (other = 0; other < REF_ADAPT_NOPERATOR; other++)
+      idle[other] = REF_FALSE;
+  }
+  idle[operation] = (0 == accepted);
+  *repeat =
+      REF_ADAPT_SWAP == operation && sweep < REF_ADAPT_SWAP_REPEAT &&
+      (REF_DBL)accepted > REF_ADAPT_SWAP_REPEAT_YIELD * (REF_DBL)attempted;
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_adapt_schedule(REF_GRID ref_grid,
+                                             REF_INT operation,
+                                             REF_BOOL *idle) {
+  REF_LONG attempted, accepted;
+  REF_INT sweep;
+  REF_BOOL skip, repeat;
+
+  RSS(ref_adapt_skip(operation, idle, &skip), "skip");
+  if (skip) return REF_SUCCESS;
+
+  sweep = 0;
+  do {
+    RSS(ref_adapt_operator(ref_grid, operation, &attempted, &accepted), "op");
+    RSS(ref_adapt_yield(operation, sweep, attempted, accepted, idle, &repeat),
+        "yield");
+    sweep++;
+  } while (repeat);
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_adapt_pass(REF_GRID ref_grid, REF_BOOL *all_done) {
   REF_INT ngeom;
   REF_BOOL all_done0, all_done1;
   REF_INT i, swap_smooth_passes = 1;
+  REF_BOOL idle[REF_ADAPT_NOPERATOR];
+
+  for (i = 0; i < REF_ADAPT_NOPERATOR; i++) idle[i] = REF_FALSE;
+
+  /* nodes touched by the previous pass remain active for this pass */
+  if (ref_grid_adapt(ref_grid, active_region))
+    ref_node_sweep(ref_grid_node(ref_grid))++;
+
+  /* cached reconstruction weights do not survive adaptation */
+  if (NULL != (void *)ref_grid_recon(ref_grid)) {
+    RSS(ref_recon_free(ref_grid_recon(ref_grid)), "recon free");
+    ref_grid_recon(ref_grid) = NULL;
+  }
 
   RSS(ref_adapt_parameter(ref_grid, &all_done0), "param");
 
@@ -637,157 +831,45 @@ REF_FCN REF_STATUS ref_adapt_pass(REF_GRID ref_grid, REF_BOOL *all_done) {
   if (ref_grid_adapt(ref_grid, watch_topo))
     RSS(ref_adapt_topo(ref_grid), "topo");
 
-  RSS(ref_adapt_swap(ref_grid), "swap pass");
-  ref_gather_blocking_frame(ref_grid, "swap");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
-
-  RSS(ref_collapse_pass(ref_grid), "col pass");
-  ref_gather_blocking_frame(ref_grid, "collapse");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt col");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "col"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
-
-  RSS(ref_adapt_swap(ref_grid), "swap pass");
-  ref_gather_blocking_frame(ref_grid, "swap");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
+  RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
+  RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_COLLAPSE, idle), "col");
+  RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
 
   ref_grid_adapt(ref_grid, post_max_ratio) = sqrt(2.0);
-
-  RSS(ref_collapse_pass(ref_grid), "col pass");
-  ref_gather_blocking_frame(ref_grid, "collapse");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt col");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "col"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
-
+  RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_COLLAPSE, idle), "col");
   ref_grid_adapt(ref_grid, post_max_ratio) =
       ref_grid_adapt(ref_grid, last_max_ratio);
 
   for (i = 0; i < swap_smooth_passes; i++) {
-    RSS(ref_adapt_swap(ref_grid), "swap pass");
-    ref_gather_blocking_frame(ref_grid, "swap");
-    if (ref_grid_adapt(ref_grid, timing_level) > 1)
-      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-    if (ref_grid_adapt(ref_grid, watch_param))
-      RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-    if (ref_grid_adapt(ref_grid, watch_topo))
-      RSS(ref_adapt_topo(ref_grid), "topo");
-
-    RSS(ref_smooth_pass(ref_grid), "smooth pass");
-    ref_gather_blocking_frame(ref_grid, "smooth");
-    if (ref_grid_adapt(ref_grid, timing_level > 1))
-      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt move");
-    if (ref_grid_adapt(ref_grid, watch_param))
-      RSS(ref_adapt_tattle(ref_grid, "move"), "tattle");
-    if (ref_grid_adapt(ref_grid, watch_topo))
-      RSS(ref_adapt_topo(ref_grid), "topo");
+    RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
+    RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SMOOTH, idle), "smooth");
   }
 
-  RSS(ref_adapt_swap(ref_grid), "swap pass");
-  ref_gather_blocking_frame(ref_grid, "swap");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
+  RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
 
   RSS(ref_adapt_parameter(ref_grid, &all_done1), "param");
 
-  RSS(ref_split_pass(ref_grid), "split surfpass");
-  ref_gather_blocking_frame(ref_grid, "split");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt spl");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "split"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
-
-  RSS(ref_adapt_swap(ref_grid), "swap pass");
-  ref_gather_blocking_frame(ref_grid, "swap");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
-
-  for (i = 0; i < swap_smooth_passes; i++) {
-    RSS(ref_smooth_pass(ref_grid), "smooth pass");
-    ref_gather_blocking_frame(ref_grid, "smooth");
-    if (ref_grid_adapt(ref_grid, timing_level) > 1)
-      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt move");
-    if (ref_grid_adapt(ref_grid, watch_param))
-      RSS(ref_adapt_tattle(ref_grid, "move"), "tattle");
-    if (ref_grid_adapt(ref_grid, watch_topo))
-      RSS(ref_adapt_topo(ref_grid), "topo");
-
-    RSS(ref_adapt_swap(ref_grid), "swap pass");
-    ref_gather_blocking_frame(ref_grid, "swap");
-    if (ref_grid_adapt(ref_grid, timing_level) > 1)
-      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-    if (ref_grid_adapt(ref_grid, watch_param))
-      RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-    if (ref_grid_adapt(ref_grid, watch_topo))
-      RSS(ref_adapt_topo(ref_grid), "topo");
-  }
-
-  ref_grid_adapt(ref_grid, post_max_ratio) = sqrt(2.0);
+  /* converged before and after coarsening, remaining operators idle */
+  if (!(all_done0 && all_done1)) {
+    RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SPLIT, idle), "split");
+    RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
 
-  RSS(ref_collapse_pass(ref_grid), "col pass");
-  ref_gather_blocking_frame(ref_grid, "collapse");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt col");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "col"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
+    for (i = 0; i < swap_smooth_passes; i++) {
+      RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SMOOTH, idle), "smooth");
+      RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
+    }
 
-  ref_grid_adapt(ref_grid, post_max_ratio) =
-      ref_grid_adapt(ref_grid, last_max_ratio);
+    ref_grid_adapt(ref_grid, post_max_ratio) = sqrt(2.0);
+    RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_COLLAPSE, idle), "col");
+    ref_grid_adapt(ref_grid, post_max_ratio) =
+        ref_grid_adapt(ref_grid, last_max_ratio);
 
-  RSS(ref_adapt_swap(ref_grid), "swap pass");
-  ref_gather_blocking_frame(ref_grid, "swap");
-  if (ref_grid_adapt(ref_grid, timing_level) > 1)
-    ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-  if (ref_grid_adapt(ref_grid, watch_param))
-    RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-  if (ref_grid_adapt(ref_grid, watch_topo))
-    RSS(ref_adapt_topo(ref_grid), "topo");
+    RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
 
-  for (i = 0; i < swap_smooth_passes; i++) {
-    RSS(ref_smooth_pass(ref_grid), "smooth pass");
-    ref_gather_blocking_frame(ref_grid, "smooth");
-    if (ref_grid_adapt(ref_grid, timing_level) > 1)
-      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt move");
-    if (ref_grid_adapt(ref_grid, watch_param))
-      RSS(ref_adapt_tattle(ref_grid, "move"), "tattle");
-    if (ref_grid_adapt(ref_grid, watch_topo))
-      RSS(ref_adapt_topo(ref_grid), "topo");
-
-    RSS(ref_adapt_swap(ref_grid), "swap pass");
-    ref_gather_blocking_frame(ref_grid, "swap");
-    if (ref_grid_adapt(ref_grid, timing_level) > 1)
-      ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "adapt swap");
-    if (ref_grid_adapt(ref_grid, watch_param))
-      RSS(ref_adapt_tattle(ref_grid, "swap"), "tattle");
-    if (ref_grid_adapt(ref_grid, watch_topo))
-      RSS(ref_adapt_topo(ref_grid), "topo");
+    for (i = 0; i < swap_smooth_passes; i++) {
+      RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SMOOTH, idle), "smooth");
+      RSS(ref_adapt_schedule(ref_grid, REF_ADAPT_SWAP, idle), "swap");
+    }
   }
 
   if (ref_grid_adapt(ref_grid, unlock_tet)) {
@@ -822,7 +904,7 @@ REF_FCN REF_STATUS ref_adapt_surf_to_geom(REF_GRID ref_grid, REF_INT passes) {
              ref_mpi_n(ref_grid_mpi(ref_grid)));
     RSS(ref_adapt_pass(ref_grid, &all_done), "pass");
 
-    RSS(ref_migrate_to_balance(ref_grid), "migrate to single part");
+    RSS(ref_migrate_to_rebalance(ref_grid), "migrate to single part");
     RSS(ref_grid_pack(ref_grid), "pack");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "pack");
 
@@ -54,6 +54,13 @@ struct REF_ADAPT_STRUCT {
   REF_DBL last_max_ratio;
 
   REF_BOOL unlock_tet;
+  /* advance the node sweep each pass, so operators skip nodes that did not
+   * change in the previous pass, off by default */
+  REF_BOOL active_region;
+
+  /* operator yield, incremented by passes and reset by the scheduler */
+  REF_LONG attempted;
+  REF_LONG accepted;
 
   REF_INT timing_level;
   REF_BOOL watch_param;
@@ -65,6 +72,25 @@ REF_FCN REF_STATUS ref_adapt_deep_copy(REF_ADAPT *ref_adapt_ptr,
                                        REF_ADAPT original);
 REF_FCN REF_STATUS ref_adapt_free(REF_ADAPT ref_adapt);
 
+/* settings as a flat array, in the order stored by checkpoint files,
+ * run diagnostics (timing_level, watch_param) are not saved */
+#define REF_ADAPT_NSETTING (18)
+REF_FCN REF_STATUS ref_adapt_pack(REF_ADAPT ref_adapt, REF_DBL *setting);
+REF_FCN REF_STATUS ref_adapt_unpack(REF_ADAPT ref_adapt, REF_DBL *setting);
+
+/* operators run by the pass scheduler */
+#define REF_ADAPT_SWAP (0)
+#define REF_ADAPT_COLLAPSE (1)
+#define REF_ADAPT_SMOOTH (2)
+#define REF_ADAPT_SPLIT (3)
+#define REF_ADAPT_NOPERATOR (4)
+
+REF_FCN REF_STATUS ref_adapt_skip(REF_INT operation, REF_BOOL *idle,
+                                  REF_BOOL *skip);
+REF_FCN REF_STATUS ref_adapt_yield(REF_INT operation, REF_INT sweep,
+                                   REF_LONG attempted, REF_LONG accepted,
+                                   REF_BOOL *idle, REF_BOOL *repeat);
+
 REF_FCN REF_STATUS ref_adapt_pass(REF_GRID ref_grid, REF_BOOL *all_done);
 
 REF_FCN REF_STATUS ref_adapt_tattle_faces(REF_GRID ref_grid);
@@ -57,6 +57,38 @@ int main(int argc, char *argv[]) {
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "make mpi");
 
+  { /* idle swap and smooth skipped until the mesh changes */
+    REF_BOOL idle[REF_ADAPT_NOPERATOR], skip, repeat;
+    REF_INT i;
+    for (i = 0; i < REF_ADAPT_NOPERATOR; i++) idle[i] = REF_FALSE;
+    RSS(ref_adapt_yield(REF_ADAPT_SMOOTH, 0, 10, 0, idle, &repeat), "yield");
+    RAS(!repeat, "smooth does not repeat");
+    RSS(ref_adapt_skip(REF_ADAPT_SMOOTH, idle, &skip), "skip");
+    RAS(skip, "idle smooth skipped");
+    RSS(ref_adapt_yield(REF_ADAPT_SPLIT, 0, 10, 0, idle, &repeat), "yield");
+    RSS(ref_adapt_skip(REF_ADAPT_SPLIT, idle, &skip), "skip");
+    RAS(!skip, "split never skipped");
+    RSS(ref_adapt_skip(REF_ADAPT_SMOOTH, idle, &skip), "skip");
+    RAS(skip, "smooth still idle");
+    RSS(ref_adapt_yield(REF_ADAPT_COLLAPSE, 0, 10, 1, idle, &repeat), "yield");
+    RSS(ref_adapt_skip(REF_ADAPT_SMOOTH, idle, &skip), "skip");
+    RAS(!skip, "collapse wakes smooth");
+  }
+
+  { /* swap repeats while yield is high */
+    REF_BOOL idle[REF_ADAPT_NOPERATOR], repeat;
+    REF_INT i;
+    for (i = 0; i < REF_ADAPT_NOPERATOR; i++) idle[i] = REF_FALSE;
+    RSS(ref_adapt_yield(REF_ADAPT_SWAP, 0, 100, 50, idle, &repeat), "yield");
+    RAS(repeat, "high yield repeats");
+    RSS(ref_adapt_yield(REF_ADAPT_SWAP, 1, 100, 10, idle, &repeat), "yield");
+    RAS(!repeat, "low yield stops");
+    RSS(ref_adapt_yield(REF_ADAPT_SWAP, 2, 100, 50, idle, &repeat), "yield");
+    RAS(!repeat, "repeats are limited");
+    RSS(ref_adapt_yield(REF_ADAPT_SMOOTH, 0, 100, 50, idle, &repeat), "yield");
+    RAS(!repeat, "only swap repeats");
+  }
+
   { /* adapt twod */
     REF_GRID ref_grid;
     REF_INT i, passes;
@@ -0,0 +1,225 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_async.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#include "ref_compress.h"
+#include "ref_malloc.h"
+
+REF_FCN REF_STATUS ref_async_create(REF_ASYNC *ref_async_ptr) {
+  REF_ASYNC ref_async;
+
+  ref_malloc(*ref_async_ptr, 1, REF_ASYNC_STRUCT);
+  ref_async = (*ref_async_ptr);
+
+  ref_async->n = 0;
+  ref_async->max = 10;
+  ref_malloc_init(ref_async->job, ref_async->max, REF_ASYNC_JOB, NULL);
+  ref_async->stage = (FILE *)NULL;
+  ref_async->stage_data = (char *)NULL;
+  ref_async->stage_size = 0;
+#ifdef HAVE_PTHREAD
+  ref_async->threaded = REF_TRUE;
+#else
+  ref_async->threaded = REF_FALSE;
+#endif
+  ref_async->compress = REF_FALSE;
+  ref_async->pending = 0;
+  ref_async->limit = REF_ASYNC_LIMIT;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_async_free(REF_ASYNC ref_async) {
+  if (NULL == (void *)ref_async) return REF_NULL;
+  RSS(ref_async_wait(ref_async), "wait");
+  ref_free(ref_async->job);
+  ref_free(ref_async);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_async_open(REF_ASYNC ref_async, FILE **file) {
+  RAS(NULL == (void *)ref_async->stage, "stage already open");
+  if (ref_async->pending >= ref_async->limit)
+    RSS(ref_async_wait(ref_async), "drain before staging");
+  ref_async->stage_data = (char *)NULL;
+  ref_async->stage_size = 0;
+  ref_async->stage =
+      open_memstream(&(ref_async->stage_data), &(ref_async->stage_size));
+  RNS(ref_async->stage, "unable to open memory stream");
+  *file = ref_async->stage;
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_async_job_file(REF_ASYNC_JOB job) {
+  FILE *file;
+  file = fopen(job->filename, "w");
+  if (NULL == (void *)file) printf("unable to open %s\n", job->filename);
+  RNS(file, "unable to open file");
+  if (job->compress) {
+    REF_BYTE *packed;
+    REF_SIZE packed_size;
+    RSB(ref_compress_pack(job->data, job->size, 0, &packed, &packed_size),
+        "pack", fclose(file));
+    REIB(packed_size, fwrite(packed, sizeof(char), packed_size, file),
+         "write", {
+           ref_free(packed);
+           fclose(file);
+         });
+    ref_free(packed);
+  } else if (0 < job->size) {
+    REIS(job->size, fwrite(job->data, sizeof(char), job->size, file),
+         "write");
+  }
+  REIS(0, fclose(file), "close file");
+  return REF_SUCCESS;
+}
+
+#ifdef HAVE_PTHREAD
+static void *ref_async_job_thread(void *arg) {
+  REF_ASYNC_JOB job = (REF_ASYNC_JOB)arg;
+  job->status = ref_async_job_file(job);
+  free(job->data);
+  job->data = (char *)NULL;
+  return NULL;
+}
+#endif
+
+REF_FCN static REF_STATUS ref_async_queue(REF_ASYNC ref_async,
+                                          const char *filename, char *data,
+                                          size_t size, REF_BOOL compress) {
+  REF_ASYNC_JOB job;
+  REF_INT i;
+
+  for (i = 0; i < ref_async->n; i++) {
+    if (0 == strcmp(filename, ref_async->job[i]->filename)) {
+      RSS(ref_async_wait(ref_async), "drain same file");
+      break;
+    }
+  }
+  if (0 < ref_async->n && ref_async->pending + size > ref_async->limit)
+    RSS(ref_async_wait(ref_async), "drain to limit");
+
+  if (ref_async->n >= ref_async->max) {
+    REF_INT chunk = MAX(10, ref_async->max);
+    ref_async->max += chunk;
+    ref_realloc_init(ref_async->job, ref_async->n, ref_async->max,
+                     REF_ASYNC_JOB, NULL);
+  }
+
+  ref_malloc(job, 1, REF_ASYNC_JOB_STRUCT);
+  ref_malloc_size_t(job->filename, strlen(filename) + 1, char);
+  strcpy(job->filename, filename);
+  job->data = data;
+  job->size = size;
+  job->compress = compress;
+  job->status = REF_SUCCESS;
+  job->thread = NULL;
+  ref_async->job[ref_async->n] = job;
+  ref_async->n++;
+
+#ifdef HAVE_PTHREAD
+  if (size <= ref_async->limit) { /* larger files are written through */
+    pthread_t *thread;
+    ref_malloc(thread, 1, pthread_t);
+    if (0 == pthread_create(thread, NULL, ref_async_job_thread, job)) {
+      job->thread = (void *)thread;
+      ref_async->pending += size;
+      return REF_SUCCESS;
+    }
+    ref_free(thread); /* fall through to a blocking write */
+  }
+#endif
+
+  job->status = ref_async_job_file(job);
+  free(job->data);
+  job->data = (char *)NULL;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_async_write(REF_ASYNC ref_async, const char *filename,
+                                   char *data, size_t size) {
+  RSS(ref_async_queue(ref_async, filename, data, size, REF_FALSE), "queue");
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_async_stage(REF_ASYNC ref_async, FILE *file,
+                                          const char *filename,
+                                          REF_BOOL compress) {
+  RAS(file == ref_async->stage, "file is not the open stage");
+  REIS(0, fclose(file), "close stage");
+  ref_async->stage = (FILE *)NULL;
+  RSS(ref_async_queue(ref_async, filename, ref_async->stage_data,
+                      ref_async->stage_size, compress),
+      "queue stage");
+  ref_async->stage_data = (char *)NULL;
+  ref_async->stage_size = 0;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_async_close(REF_ASYNC ref_async, FILE *file,
+                                   const char *filename) {
+  RSS(ref_async_stage(ref_async, file, filename, REF_FALSE), "stage");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_async_close_packed(REF_ASYNC ref_async, FILE *file,
+                                          const char *filename) {
+  RSS(ref_async_stage(ref_async, file, filename, ref_async->compress),
+      "stage");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_async_wait(REF_ASYNC ref_async) {
+  REF_INT i, failures = 0;
+  REF_ASYNC_JOB job;
+
+  for (i = 0; i < ref_async->n; i++) {
+    job = ref_async->job[i];
+#ifdef HAVE_PTHREAD
+    if (NULL != job->thread) {
+      REIS(0, pthread_join(*((pthread_t *)(job->thread)), NULL), "join");
+      ref_free(job->thread);
+    }
+#endif
+    if (REF_SUCCESS != job->status) {
+      printf("async write of %s failed, status %d\n", job->filename,
+             job->status);
+      failures++;
+    }
+    ref_free(job->filename);
+    ref_free(job);
+    ref_async->job[i] = NULL;
+  }
+  ref_async->n = 0;
+  ref_async->pending = 0;
+
+  REIS(0, failures, "async writes failed");
+
+  return REF_SUCCESS;
+}
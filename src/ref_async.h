@@ -0,0 +1,91 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_ASYNC_H
+#define REF_ASYNC_H
+
+#include <stdio.h>
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_ASYNC_STRUCT REF_ASYNC_STRUCT;
+typedef REF_ASYNC_STRUCT *REF_ASYNC;
+typedef struct REF_ASYNC_JOB_STRUCT REF_ASYNC_JOB_STRUCT;
+typedef REF_ASYNC_JOB_STRUCT *REF_ASYNC_JOB;
+END_C_DECLORATION
+
+BEGIN_C_DECLORATION
+struct REF_ASYNC_JOB_STRUCT {
+  char *filename;
+  char *data;
+  size_t size;
+  REF_BOOL compress;
+  REF_STATUS status;
+  void *thread;
+};
+
+struct REF_ASYNC_STRUCT {
+  REF_INT n, max;
+  REF_ASYNC_JOB *job;
+  FILE *stage;
+  char *stage_data;
+  size_t stage_size;
+  REF_BOOL threaded;
+  REF_BOOL compress;
+  size_t pending; /* bytes queued since the last wait */
+  size_t limit;
+};
+
+/* default bound on bytes held by queued writes */
+#define REF_ASYNC_LIMIT ((size_t)1024 * 1024 * 1024)
+
+#define ref_async_n(ref_async) ((ref_async)->n)
+/* false when built without HAVE_PTHREAD, writes complete on close */
+#define ref_async_threaded(ref_async) ((ref_async)->threaded)
+/* when set, files closed with ref_async_close_packed are written as
+ * ref_compress containers, other files are always written plain */
+#define ref_async_compress(ref_async) ((ref_async)->compress)
+/* queueing past limit bytes waits, larger files are written through */
+#define ref_async_limit(ref_async) ((ref_async)->limit)
+
+/* owns snapshots of output files and writes them on background threads */
+REF_FCN REF_STATUS ref_async_create(REF_ASYNC *ref_async);
+/* waits for pending writes */
+REF_FCN REF_STATUS ref_async_free(REF_ASYNC ref_async);
+
+/* memory backed stream to snapshot one file, one stage open at a time */
+REF_FCN REF_STATUS ref_async_open(REF_ASYNC ref_async, FILE **file);
+/* closes the stage and queues its contents to be written to filename */
+REF_FCN REF_STATUS ref_async_close(REF_ASYNC ref_async, FILE *file,
+                                   const char *filename);
+/* ref_async_close, packed when ref_async_compress is set */
+REF_FCN REF_STATUS ref_async_close_packed(REF_ASYNC ref_async, FILE *file,
+                                          const char *filename);
+
+/* takes ownership of malloc allocated data, waits on a pending write
+ * of the same filename */
+REF_FCN REF_STATUS ref_async_write(REF_ASYNC ref_async, const char *filename,
+                                   char *data, size_t size);
+/* joins all pending writes, reports each failed file */
+REF_FCN REF_STATUS ref_async_wait(REF_ASYNC ref_async);
+
+END_C_DECLORATION
+
+#endif /* REF_ASYNC_H */
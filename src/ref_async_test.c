@@ -0,0 +1,191 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_async.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+
+static REF_STATUS ref_async_test_contents(const char *filename,
+                                          const char *expected) {
+  FILE *file;
+  char line[1024];
+  size_t length;
+  file = fopen(filename, "r");
+  RNS(file, "unable to open file");
+  length = fread(line, sizeof(char), sizeof(line) - 1, file);
+  line[length] = '\0';
+  REIS(0, fclose(file), "close");
+  REIS(0, strcmp(expected, line), "contents");
+  return REF_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  if (ref_mpi_once(ref_mpi)) { /* staged file */
+    REF_ASYNC ref_async;
+    FILE *file;
+    char filename[] = "ref_async_test_stage.txt";
+
+    RSS(ref_async_create(&ref_async), "create");
+    RSS(ref_async_open(ref_async, &file), "open");
+    fprintf(file, "staged %d\n", 7);
+    RSS(ref_async_close(ref_async, file, filename), "close");
+    REIS(1, ref_async_n(ref_async), "pending");
+    RSS(ref_async_wait(ref_async), "wait");
+    REIS(0, ref_async_n(ref_async), "pending");
+    RSS(ref_async_test_contents(filename, "staged 7\n"), "contents");
+    RSS(ref_async_free(ref_async), "free");
+    REIS(0, remove(filename), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* one stage at a time */
+    REF_ASYNC ref_async;
+    FILE *file, *second;
+
+    RSS(ref_async_create(&ref_async), "create");
+    RSS(ref_async_open(ref_async, &file), "open");
+    REIS(REF_FAILURE, ref_async_open(ref_async, &second), "second open");
+    RSS(ref_async_close(ref_async, file, "ref_async_test_empty.txt"),
+        "close");
+    RSS(ref_async_free(ref_async), "free");
+    RSS(ref_async_test_contents("ref_async_test_empty.txt", ""), "empty");
+    REIS(0, remove("ref_async_test_empty.txt"), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* many writes, queue grows */
+    REF_ASYNC ref_async;
+    REF_INT i, n = 25;
+    char filename[1024], expected[1024];
+    char *data;
+
+    RSS(ref_async_create(&ref_async), "create");
+    for (i = 0; i < n; i++) {
+      snprintf(filename, 1024, "ref_async_test_%d.txt", i);
+      snprintf(expected, 1024, "file %d", i);
+      ref_malloc_size_t(data, strlen(expected), char);
+      memcpy(data, expected, strlen(expected));
+      RSS(ref_async_write(ref_async, filename, data, strlen(expected)),
+          "write");
+    }
+    REIS(n, ref_async_n(ref_async), "pending");
+    RSS(ref_async_wait(ref_async), "wait");
+    for (i = 0; i < n; i++) {
+      snprintf(filename, 1024, "ref_async_test_%d.txt", i);
+      snprintf(expected, 1024, "file %d", i);
+      RSS(ref_async_test_contents(filename, expected), "contents");
+      REIS(0, remove(filename), "test clean up");
+    }
+    RSS(ref_async_free(ref_async), "free");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* queued bytes bounded by limit */
+    REF_ASYNC ref_async;
+    REF_INT i;
+    char filename[1024];
+    char *data;
+
+    RSS(ref_async_create(&ref_async), "create");
+    ref_async_limit(ref_async) = 16;
+    for (i = 0; i < 3; i++) {
+      snprintf(filename, 1024, "ref_async_test_limit_%d.txt", i);
+      ref_malloc_size_t(data, 10, char);
+      memcpy(data, "0123456789", 10);
+      RSS(ref_async_write(ref_async, filename, data, 10), "write");
+      REIS(1, ref_async_n(ref_async), "drained at limit");
+    }
+    ref_malloc_size_t(data, 32, char);
+    memset(data, 'x', 32);
+    RSS(ref_async_write(ref_async, "ref_async_test_limit_3.txt", data, 32),
+        "write through");
+    REIS(1, ref_async_n(ref_async), "drained for large file");
+    RSS(ref_async_free(ref_async), "free");
+    for (i = 0; i < 3; i++) {
+      snprintf(filename, 1024, "ref_async_test_limit_%d.txt", i);
+      RSS(ref_async_test_contents(filename, "0123456789"), "contents");
+      REIS(0, remove(filename), "test clean up");
+    }
+    REIS(0, remove("ref_async_test_limit_3.txt"), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* same file queued twice keeps last */
+    REF_ASYNC ref_async;
+    FILE *file;
+    char filename[] = "ref_async_test_again.txt";
+
+    RSS(ref_async_create(&ref_async), "create");
+    RSS(ref_async_open(ref_async, &file), "open");
+    fprintf(file, "first\n");
+    RSS(ref_async_close(ref_async, file, filename), "close");
+    RSS(ref_async_open(ref_async, &file), "open");
+    fprintf(file, "second\n");
+    RSS(ref_async_close(ref_async, file, filename), "close");
+    REIS(1, ref_async_n(ref_async), "first drained");
+    RSS(ref_async_free(ref_async), "free");
+    RSS(ref_async_test_contents(filename, "second\n"), "contents");
+    REIS(0, remove(filename), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* only packed closes compress */
+    REF_ASYNC ref_async;
+    FILE *file;
+    char plain[] = "ref_async_test_plain.txt";
+    char packed[] = "ref_async_test_packed.txt";
+
+    RSS(ref_async_create(&ref_async), "create");
+    ref_async_compress(ref_async) = REF_TRUE;
+    RSS(ref_async_open(ref_async, &file), "open");
+    fprintf(file, "plain\n");
+    RSS(ref_async_close(ref_async, file, plain), "close");
+    RSS(ref_async_open(ref_async, &file), "open");
+    fprintf(file, "packed\n");
+    RSS(ref_async_close_packed(ref_async, file, packed), "close");
+    RSS(ref_async_free(ref_async), "free");
+    RSS(ref_async_test_contents(plain, "plain\n"), "contents");
+    REIS(REF_FAILURE, ref_async_test_contents(packed, "packed\n"),
+         "expected container");
+    REIS(0, remove(plain), "test clean up");
+    REIS(0, remove(packed), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* failed write reported by wait */
+    REF_ASYNC ref_async;
+    FILE *file;
+
+    RSS(ref_async_create(&ref_async), "create");
+    RSS(ref_async_open(ref_async, &file), "open");
+    fprintf(file, "lost\n");
+    RSS(ref_async_close(ref_async, file, "ref_async_test_missing/dir.txt"),
+        "close");
+    REIS(REF_FAILURE, ref_async_wait(ref_async), "expected failure");
+    REIS(0, ref_async_n(ref_async), "pending cleared");
+    RSS(ref_async_free(ref_async), "free");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
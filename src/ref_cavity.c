@@ -696,6 +696,7 @@ REF_FCN REF_STATUS ref_cavity_replace(REF_CAVITY ref_cavity) {
     cell = ref_list_value(ref_cavity_tet_list(ref_cavity), item);
     RSS(ref_cell_nodes(ref_cell, cell, nodes), "rm");
     for (i = 0; i < 4; i++) {
+      ref_node_touch(ref_node, nodes[i]);
       RSS(ref_list_push(ref_list, nodes[i]), "tet list");
       RAS(ref_node_valid(ref_node, nodes[i]), "cavity rm tet nodes not valid");
       RAS(ref_node_owned(ref_node, nodes[i]), "cavity rm tet nodes not local");
@@ -708,6 +709,7 @@ REF_FCN REF_STATUS ref_cavity_replace(REF_CAVITY ref_cavity) {
     cell = ref_list_value(ref_cavity_tri_list(ref_cavity), item);
     RSS(ref_cell_nodes(ref_cell, cell, nodes), "rm");
     for (i = 0; i < 3; i++) {
+      ref_node_touch(ref_node, nodes[i]);
       RSS(ref_list_push(ref_list, nodes[i]), "tri list");
       RAS(ref_node_valid(ref_node, nodes[i]), "cavity rm tri nodes not valid");
       RAS(ref_node_owned(ref_node, nodes[i]), "cavity rm tri nodes not local");
@@ -2625,6 +2627,9 @@ REF_FCN static REF_STATUS ref_cavity_swap_tet_pass(REF_GRID ref_grid) {
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
   REF_INT cell, nodes[REF_CELL_MAX_SIZE_PER];
   REF_DBL quality, min_del, min_add, best;
+  REF_DBL block[REF_NODE_QUALITY_BLOCK];
+  REF_INT first = REF_EMPTY;
+  REF_BOOL swapped = REF_FALSE;
   REF_INT best_other;
   REF_CAVITY ref_cavity;
   REF_BOOL allowed;
@@ -2637,8 +2642,30 @@ REF_FCN static REF_STATUS ref_cavity_swap_tet_pass(REF_GRID ref_grid) {
   };
 
   each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-    RSS(ref_node_tet_quality(ref_node, nodes, &quality), "qual");
+    if (REF_EMPTY == first || cell >= first + REF_NODE_QUALITY_BLOCK) {
+      first = cell;
+      RSS(ref_node_tet_quality_block(
+              ref_node,
+              MIN(REF_NODE_QUALITY_BLOCK, ref_cell_max(ref_cell) - first),
+              &(ref_cell_c2n(ref_cell, 0, first)), ref_cell_size_per(ref_cell),
+              block, NULL),
+          "block qual");
+      swapped = REF_FALSE;
+    }
+    /* converged region, nothing changed nearby since the last sweep */
+    if (!ref_node_active(ref_node, nodes[0]) &&
+        !ref_node_active(ref_node, nodes[1]) &&
+        !ref_node_active(ref_node, nodes[2]) &&
+        !ref_node_active(ref_node, nodes[3]))
+      continue;
+    /* screened values are stale once a swap replaces cells in this block */
+    if (swapped) {
+      RSS(ref_node_tet_quality(ref_node, nodes, &quality), "qual");
+    } else {
+      quality = block[cell - first];
+    }
     if (quality < ref_grid_adapt(ref_grid, swap_min_quality)) {
+      ref_grid_adapt(ref_grid, attempted)++;
       best_other = REF_EMPTY;
       best = -2.0;
       for (other = 0; other < 12; other++) {
@@ -2708,6 +2735,8 @@ REF_FCN static REF_STATUS ref_cavity_swap_tet_pass(REF_GRID ref_grid) {
         }
         RSS(ref_cavity_replace(ref_cavity), "replace");
         RSS(ref_cavity_free(ref_cavity), "free");
+        ref_grid_adapt(ref_grid, accepted)++;
+        swapped = REF_TRUE;
       }
     }
   }
@@ -2739,6 +2768,7 @@ REF_FCN static REF_STATUS ref_cavity_surf_geom_edge_pass(REF_GRID ref_grid) {
     if (!ref_node_owned(ref_node, node0)) {
       continue;
     }
+    if (!ref_node_active(ref_node, node0)) continue;
 
     RSB(ref_cell_list_with2(tri, node0, node1, 2, &ncell, edge_tri), "tris", {
       REF_DBL xyz_phys[3];
@@ -2760,6 +2790,7 @@ REF_FCN static REF_STATUS ref_cavity_surf_geom_edge_pass(REF_GRID ref_grid) {
       RSS(ref_cell_nodes(tri, tri_cell, nodes), "cell nodes");
       RSS(ref_geom_tri_norm_deviation(ref_grid, nodes, &normdev), "nd");
       if (normdev < 0.5) {
+        ref_grid_adapt(ref_grid, attempted)++;
         RSS(ref_cavity_create(&ref_cavity), "create");
         RSS(ref_cavity_form_empty(ref_cavity, ref_grid, node0), "insert ball");
         RSS(ref_cavity_add_tri(ref_cavity, tri_cell), "insert tri");
@@ -2768,6 +2799,7 @@ REF_FCN static REF_STATUS ref_cavity_surf_geom_edge_pass(REF_GRID ref_grid) {
           RSS(ref_cavity_normdev(ref_cavity, &improved), "normdev tri");
           if (improved) {
             RSS(ref_cavity_replace(ref_cavity), "replace tri");
+            ref_grid_adapt(ref_grid, accepted)++;
           }
         }
         RSS(ref_cavity_free(ref_cavity), "free");
@@ -2789,6 +2821,7 @@ REF_FCN static REF_STATUS ref_cavity_surf_geom_face_pass(REF_GRID ref_grid) {
     if (!ref_node_owned(ref_node, nodes[0])) {
       continue;
     }
+    if (!ref_node_active(ref_node, nodes[0])) continue;
     RSS(ref_geom_is_a(ref_grid_geom(ref_grid), nodes[0], REF_GEOM_EDGE,
                       &geom_edge),
         "n");
@@ -2797,6 +2830,7 @@ REF_FCN static REF_STATUS ref_cavity_surf_geom_face_pass(REF_GRID ref_grid) {
     }
     RSS(ref_geom_tri_norm_deviation(ref_grid, nodes, &normdev), "nd");
     if (normdev < 0.1) {
+      ref_grid_adapt(ref_grid, attempted)++;
       RSS(ref_cavity_create(&ref_cavity), "create");
       RSS(ref_cavity_form_ball(ref_cavity, ref_grid, nodes[0]), "insert ball");
       RSS(ref_cavity_enlarge_conforming(ref_cavity), "enlarge tri");
@@ -2804,6 +2838,7 @@ REF_FCN static REF_STATUS ref_cavity_surf_geom_face_pass(REF_GRID ref_grid) {
         RSS(ref_cavity_normdev(ref_cavity, &improved), "normdev tri");
         if (improved) {
           RSS(ref_cavity_replace(ref_cavity), "replace tri");
+          ref_grid_adapt(ref_grid, accepted)++;
         }
       }
       RSS(ref_cavity_free(ref_cavity), "free");
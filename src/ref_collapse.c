@@ -29,6 +29,7 @@
 #include "ref_clump.h"
 #include "ref_edge.h"
 #include "ref_gather.h"
+#include "ref_heap.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
 #include "ref_mpi.h"
@@ -88,12 +89,13 @@ REF_FCN REF_STATUS ref_collapse_pass(REF_GRID ref_grid) {
   REF_CELL ref_cell;
   REF_EDGE ref_edge;
   REF_DBL *ratio;
-  REF_INT *order;
+  REF_HEAP ref_heap;
   REF_INT ntarget, *target, *node2target;
   REF_INT node, node0, node1;
   REF_INT i, edge;
+  REF_DBL key;
   REF_INT item, cell, nodes[REF_CELL_MAX_SIZE_PER];
-  REF_DBL edge_ratio;
+  REF_DBL *edge_ratio;
 
   if (ref_grid_surf(ref_grid)) {
     ref_cell = ref_grid_tri(ref_grid);
@@ -106,13 +108,18 @@ REF_FCN REF_STATUS ref_collapse_pass(REF_GRID ref_grid) {
   ref_malloc_init(ratio, ref_node_max(ref_node), REF_DBL,
                   2.0 * ref_grid_adapt(ref_grid, collapse_ratio));
 
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_node_ratio_active(ref_node, ref_edge_n(ref_edge), ref_edge->e2n,
+                            2.0 * ref_grid_adapt(ref_grid, collapse_ratio),
+                            edge_ratio),
+      "ratio");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     node0 = ref_edge_e2n(ref_edge, 0, edge);
     node1 = ref_edge_e2n(ref_edge, 1, edge);
-    RSS(ref_node_ratio(ref_node, node0, node1, &edge_ratio), "ratio");
-    ratio[node0] = MIN(ratio[node0], edge_ratio);
-    ratio[node1] = MIN(ratio[node1], edge_ratio);
+    ratio[node0] = MIN(ratio[node0], edge_ratio[edge]);
+    ratio[node1] = MIN(ratio[node1], edge_ratio[edge]);
   }
+  ref_free(edge_ratio);
 
   ref_malloc(target, ref_node_n(ref_node), REF_INT);
   ref_malloc_init(node2target, ref_node_max(ref_node), REF_INT, REF_EMPTY);
@@ -126,16 +133,20 @@ REF_FCN REF_STATUS ref_collapse_pass(REF_GRID ref_grid) {
       ntarget++;
     }
 
-  ref_malloc(order, ntarget, REF_INT);
-
-  RSS(ref_sort_heap_dbl(ntarget, ratio, order), "sort lengths");
+  /* shortest first, ratio is raised in place to invalidate queued targets */
+  RSS(ref_heap_create(&ref_heap), "target queue");
+  for (i = 0; i < ntarget; i++)
+    RSS(ref_heap_push(ref_heap, i, -ratio[i]), "push");
 
-  for (i = 0; i < ntarget; i++) {
-    if (ratio[order[i]] > ref_grid_adapt(ref_grid, collapse_ratio)) continue;
-    node1 = target[order[i]];
+  while (REF_SUCCESS == ref_heap_pop(ref_heap, &i, &key)) {
+    if (ratio[i] > ref_grid_adapt(ref_grid, collapse_ratio)) continue;
+    node1 = target[i];
     if (!ref_node_valid(ref_node, node1)) continue;
+    ref_grid_adapt(ref_grid, attempted)++;
     RSS(ref_collapse_to_remove_node1(ref_grid, &node0, node1), "collapse rm");
     if (!ref_node_valid(ref_node, node1)) {
+      ref_grid_adapt(ref_grid, accepted)++;
+      RSS(ref_grid_touch(ref_grid, node0), "touch");
       ref_node_age(ref_node, node0) = 0;
       each_ref_cell_having_node(ref_cell, node0, item, cell) {
         RSS(ref_cell_nodes(ref_cell, cell, nodes), "cell nodes");
@@ -149,7 +160,7 @@ REF_FCN REF_STATUS ref_collapse_pass(REF_GRID ref_grid) {
     }
   }
 
-  ref_free(order);
+  RSS(ref_heap_free(ref_heap), "free queue");
   ref_free(node2target);
   ref_free(target);
   ref_free(ratio);
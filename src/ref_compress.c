@@ -0,0 +1,582 @@
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_compress.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#include "ref_malloc.h"
+
+/* adaptive binary range coder with 11 bit probabilities */
+#define REF_COMPRESS_PROB_BITS (11)
+#define REF_COMPRESS_PROB_ONE (1 << REF_COMPRESS_PROB_BITS)
+#define REF_COMPRESS_PROB_SHIFT (5)
+#define REF_COMPRESS_TOP ((uint32_t)1 << 24)
+
+/* bytes of a double, one model per byte plane */
+#define REF_COMPRESS_PLANES (8)
+/* bit tree probabilities conditioned on the previous byte of the plane */
+#define REF_COMPRESS_CONTEXT (256 * 256)
+/* chunk stride marking bytes stored without coding */
+#define REF_COMPRESS_STORED (-1)
+/* leading bytes of a chunk examined to pick a stride */
+#define REF_COMPRESS_SAMPLE (16384)
+/* strides trial coded after ranking by entropy, besides no delta */
+#define REF_COMPRESS_TRIALS (3)
+#define REF_COMPRESS_MAX_STRIDE (128)
+#define REF_COMPRESS_MAX_THREADS (8)
+/* container integers are little endian on every host */
+#define REF_COMPRESS_LONG (8)
+#define REF_COMPRESS_INT (4)
+/* magic, raw size, chunk length, chunk count */
+#define REF_COMPRESS_HEADER (REF_COMPRESS_MAGIC_SIZE + 3 * REF_COMPRESS_LONG)
+
+static const unsigned char ref_compress_magic[REF_COMPRESS_MAGIC_SIZE] = {
+    0x89, 'R', 'E', 'F', 'Z', 'I', 'P', 0x01};
+
+typedef struct REF_COMPRESS_ENCODER_STRUCT {
+  unsigned char *out;
+  REF_SIZE n, max;
+  uint64_t low;
+  uint32_t range;
+  unsigned char cache;
+  uint64_t cache_size;
+  REF_BOOL overflow;
+} REF_COMPRESS_ENCODER_STRUCT;
+
+typedef struct REF_COMPRESS_DECODER_STRUCT {
+  unsigned char *in;
+  REF_SIZE n, position;
+  uint32_t range;
+  uint32_t code;
+} REF_COMPRESS_DECODER_STRUCT;
+
+typedef struct REF_COMPRESS_TASK_STRUCT {
+  REF_BOOL pack;
+  unsigned char *raw;
+  REF_SIZE raw_size;
+  REF_SIZE length;
+  REF_INT stride;
+  REF_LONG nchunk;
+  unsigned char **chunk;
+  REF_SIZE *chunk_size;
+  REF_LONG first, step;
+  REF_STATUS status;
+} REF_COMPRESS_TASK_STRUCT;
+
+static void ref_compress_put_long(unsigned char *bytes, REF_LONG value) {
+  REF_INT i;
+  for (i = 0; i < REF_COMPRESS_LONG; i++)
+    bytes[i] = (unsigned char)(((uint64_t)value) >> (8 * i));
+}
+
+static REF_LONG ref_compress_get_long(const unsigned char *bytes) {
+  uint64_t value = 0;
+  REF_INT i;
+  for (i = 0; i < REF_COMPRESS_LONG; i++)
+    value |= ((uint64_t)bytes[i]) << (8 * i);
+  return (REF_LONG)value;
+}
+
+static void ref_compress_put_int(unsigned char *bytes, REF_INT value) {
+  REF_INT i;
+  for (i = 0; i < REF_COMPRESS_INT; i++)
+    bytes[i] = (unsigned char)(((uint32_t)value) >> (8 * i));
+}
+
+static REF_INT ref_compress_get_int(const unsigned char *bytes) {
+  uint32_t value = 0;
+  REF_INT i;
+  for (i = 0; i < REF_COMPRESS_INT; i++)
+    value |= ((uint32_t)bytes[i]) << (8 * i);
+  return (REF_INT)value;
+}
+
+static void ref_compress_put(REF_COMPRESS_ENCODER_STRUCT *enc,
+                             unsigned char byte) {
+  if (enc->n < enc->max) {
+    enc->out[enc->n] = byte;
+    enc->n++;
+  } else {
+    enc->overflow = REF_TRUE;
+  }
+}
+
+static void ref_compress_shift_low(REF_COMPRESS_ENCODER_STRUCT *enc) {
+  if ((uint32_t)enc->low < (uint32_t)0xFF000000 || 0 != (enc->low >> 32)) {
+    unsigned char carry = (unsigned char)(enc->low >> 32);
+    unsigned char temp = enc->cache;
+    do {
+      ref_compress_put(enc, (unsigned char)(temp + carry));
+      temp = 0xFF;
+    } while (0 != --(enc->cache_size));
+    enc->cache = (unsigned char)((uint32_t)enc->low >> 24);
+  }
+  enc->cache_size++;
+  enc->low = (uint64_t)((uint32_t)enc->low << 8);
+}
+
+static void ref_compress_encode_bit(REF_COMPRESS_ENCODER_STRUCT *enc,
+                                    uint16_t *prob, REF_INT bit) {
+  uint32_t bound = (enc->range >> REF_COMPRESS_PROB_BITS) * (uint32_t)(*prob);
+  if (0 == bit) {
+    enc->range = bound;
+    *prob = (uint16_t)(*prob + ((REF_COMPRESS_PROB_ONE - *prob) >>
+                                REF_COMPRESS_PROB_SHIFT));
+  } else {
+    enc->low += bound;
+    enc->range -= bound;
+    *prob = (uint16_t)(*prob - (*prob >> REF_COMPRESS_PROB_SHIFT));
+  }
+  if (enc->range < REF_COMPRESS_TOP) {
+    enc->range <<= 8;
+    ref_compress_shift_low(enc);
+  }
+}
+
+static unsigned char ref_compress_next(REF_COMPRESS_DECODER_STRUCT *dec) {
+  unsigned char byte = 0;
+  if (dec->position < dec->n) {
+    byte = dec->in[dec->position];
+    dec->position++;
+  }
+  return byte;
+}
+
+static REF_INT ref_compress_decode_bit(REF_COMPRESS_DECODER_STRUCT *dec,
+                                       uint16_t *prob) {
+  REF_INT bit;
+  uint32_t bound = (dec->range >> REF_COMPRESS_PROB_BITS) * (uint32_t)(*prob);
+  if (dec->code < bound) {
+    dec->range = bound;
+    *prob = (uint16_t)(*prob + ((REF_COMPRESS_PROB_ONE - *prob) >>
+                                REF_COMPRESS_PROB_SHIFT));
+    bit = 0;
+  } else {
+    dec->code -= bound;
+    dec->range -= bound;
+    *prob = (uint16_t)(*prob - (*prob >> REF_COMPRESS_PROB_SHIFT));
+    bit = 1;
+  }
+  if (dec->range < REF_COMPRESS_TOP) {
+    dec->range <<= 8;
+    dec->code = (dec->code << 8) | (uint32_t)ref_compress_next(dec);
+  }
+  return bit;
+}
+
+/* codes the xor-delta byte planes of raw, false when out is too short */
+static REF_BOOL ref_compress_encode(unsigned char *raw, REF_SIZE n,
+                                    REF_SIZE s, uint16_t *prob,
+                                    unsigned char *out, REF_SIZE max,
+                                    REF_SIZE *coded) {
+  REF_COMPRESS_ENCODER_STRUCT enc;
+  REF_SIZE i;
+  REF_INT plane, k, bit, tree;
+  unsigned char byte, last;
+
+  enc.out = out;
+  enc.n = 0;
+  enc.max = max;
+  enc.low = 0;
+  enc.range = 0xFFFFFFFF;
+  enc.cache = 0;
+  enc.cache_size = 1;
+  enc.overflow = REF_FALSE;
+
+  for (plane = 0; plane < REF_COMPRESS_PLANES && !enc.overflow; plane++) {
+    for (k = 0; k < REF_COMPRESS_CONTEXT; k++)
+      prob[k] = (uint16_t)(REF_COMPRESS_PROB_ONE / 2);
+    last = 0;
+    for (i = (REF_SIZE)plane; i < n; i += REF_COMPRESS_PLANES) {
+      byte = raw[i];
+      if (0 < s && i >= s) byte = (unsigned char)(byte ^ raw[i - s]);
+      tree = 1;
+      for (k = 7; k >= 0; k--) {
+        bit = (byte >> k) & 1;
+        ref_compress_encode_bit(&enc, &(prob[256 * last + tree]), bit);
+        tree = (tree << 1) | bit;
+      }
+      last = byte;
+    }
+  }
+  for (k = 0; k < 5; k++) ref_compress_shift_low(&enc);
+
+  *coded = enc.n;
+  return !enc.overflow;
+}
+
+/* order zero entropy in bits of the xor-delta byte planes */
+static REF_DBL ref_compress_entropy(unsigned char *raw, REF_SIZE n,
+                                   REF_SIZE s, REF_SIZE *count) {
+  REF_SIZE i, total;
+  REF_INT plane, k;
+  unsigned char byte;
+  REF_DBL bits = 0.0, p;
+
+  for (k = 0; k < 256 * REF_COMPRESS_PLANES; k++) count[k] = 0;
+  for (i = 0; i < n; i++) {
+    byte = raw[i];
+    if (0 < s && i >= s) byte = (unsigned char)(byte ^ raw[i - s]);
+    count[256 * (i % REF_COMPRESS_PLANES) + byte]++;
+  }
+  for (plane = 0; plane < REF_COMPRESS_PLANES; plane++) {
+    total = 0;
+    for (k = 0; k < 256; k++) total += count[256 * plane + k];
+    for (k = 0; k < 256; k++) {
+      if (0 == count[256 * plane + k]) continue;
+      p = (REF_DBL)count[256 * plane + k] / (REF_DBL)total;
+      bits -= (REF_DBL)count[256 * plane + k] * log(p) / log(2.0);
+    }
+  }
+  return bits;
+}
+
+/* record length that codes a leading sample the smallest, strides are
+ * ranked by entropy and only the best few are trial coded */
+static REF_INT ref_compress_stride(unsigned char *raw, REF_SIZE n,
+                                   uint16_t *prob, unsigned char *scratch) {
+  REF_SIZE sample = MIN(n, (REF_SIZE)REF_COMPRESS_SAMPLE);
+  REF_SIZE count[256 * REF_COMPRESS_PLANES];
+  REF_INT candidate[REF_COMPRESS_TRIALS];
+  REF_DBL bits, candidate_bits[REF_COMPRESS_TRIALS];
+  REF_SIZE coded, best_coded;
+  REF_INT stride, best, trial, i;
+
+  for (trial = 0; trial < REF_COMPRESS_TRIALS; trial++) {
+    candidate[trial] = 0;
+    candidate_bits[trial] = -1.0;
+  }
+  for (stride = 4; stride <= REF_COMPRESS_MAX_STRIDE; stride += 4) {
+    if ((REF_SIZE)stride >= sample) break;
+    bits = ref_compress_entropy(raw, sample, (REF_SIZE)stride, count);
+    for (trial = 0; trial < REF_COMPRESS_TRIALS; trial++) {
+      if (0 == candidate[trial] || bits < candidate_bits[trial]) {
+        for (i = REF_COMPRESS_TRIALS - 1; i > trial; i--) {
+          candidate[i] = candidate[i - 1];
+          candidate_bits[i] = candidate_bits[i - 1];
+        }
+        candidate[trial] = stride;
+        candidate_bits[trial] = bits;
+        break;
+      }
+    }
+  }
+
+  best = 0;
+  if (!ref_compress_encode(raw, sample, 0, prob, scratch, sample,
+                           &best_coded))
+    best_coded = sample;
+  for (trial = 0; trial < REF_COMPRESS_TRIALS; trial++) {
+    stride = candidate[trial];
+    if (0 == stride) break;
+    if (ref_compress_encode(raw, sample, (REF_SIZE)stride, prob, scratch,
+                            best_coded, &coded) &&
+        coded < best_coded) {
+      best = stride;
+      best_coded = coded;
+    }
+  }
+  return best;
+}
+
+/* out holds n+4 bytes: the stride then coded planes or stored bytes */
+REF_FCN static REF_STATUS ref_compress_chunk_pack(unsigned char *raw,
+                                                  REF_SIZE n, REF_INT stride,
+                                                  unsigned char *out,
+                                                  REF_SIZE *used) {
+  uint16_t *prob;
+  REF_SIZE coded;
+  REF_BOOL fits;
+
+  ref_malloc(prob, REF_COMPRESS_CONTEXT, uint16_t);
+  /* the output buffer is scratch for sample trials */
+  if (0 == stride)
+    stride = ref_compress_stride(raw, n, prob, &(out[REF_COMPRESS_INT]));
+  fits = ref_compress_encode(raw, n, (REF_SIZE)stride, prob,
+                             &(out[REF_COMPRESS_INT]), n, &coded);
+  ref_free(prob);
+
+  if (!fits || coded >= n) {
+    stride = REF_COMPRESS_STORED;
+    if (0 < n) memcpy(&(out[REF_COMPRESS_INT]), raw, n);
+    *used = REF_COMPRESS_INT + n;
+  } else {
+    *used = REF_COMPRESS_INT + coded;
+  }
+  ref_compress_put_int(out, stride);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_compress_chunk_unpack(unsigned char *in,
+                                                    REF_SIZE used,
+                                                    unsigned char *raw,
+                                                    REF_SIZE n) {
+  REF_COMPRESS_DECODER_STRUCT dec;
+  uint16_t *prob;
+  REF_SIZE i, s;
+  REF_INT plane, k, tree, stride;
+  unsigned char last;
+
+  RAS(REF_COMPRESS_INT <= used, "chunk missing stride");
+  stride = ref_compress_get_int(in);
+  if (REF_COMPRESS_STORED == stride) {
+    REIS(REF_COMPRESS_INT + n, used, "stored chunk size");
+    if (0 < n) memcpy(raw, &(in[REF_COMPRESS_INT]), n);
+    return REF_SUCCESS;
+  }
+  RAS(0 <= stride && stride <= REF_COMPRESS_MAX_STRIDE, "chunk stride");
+  s = (REF_SIZE)stride;
+
+  dec.in = &(in[REF_COMPRESS_INT]);
+  dec.n = used - REF_COMPRESS_INT;
+  dec.position = 0;
+  dec.range = 0xFFFFFFFF;
+  dec.code = 0;
+  for (k = 0; k < 5; k++)
+    dec.code = (dec.code << 8) | (uint32_t)ref_compress_next(&dec);
+
+  ref_malloc(prob, REF_COMPRESS_CONTEXT, uint16_t);
+  for (plane = 0; plane < REF_COMPRESS_PLANES; plane++) {
+    for (k = 0; k < REF_COMPRESS_CONTEXT; k++)
+      prob[k] = (uint16_t)(REF_COMPRESS_PROB_ONE / 2);
+    last = 0;
+    for (i = (REF_SIZE)plane; i < n; i += REF_COMPRESS_PLANES) {
+      tree = 1;
+      for (k = 0; k < 8; k++)
+        tree = (tree << 1) |
+               ref_compress_decode_bit(&dec, &(prob[256 * last + tree]));
+      last = (unsigned char)(tree & 0xFF);
+      raw[i] = last;
+    }
+  }
+  ref_free(prob);
+
+  if (0 < s)
+    for (i = s; i < n; i++) raw[i] = (unsigned char)(raw[i] ^ raw[i - s]);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_compress_task_chunks(
+    REF_COMPRESS_TASK_STRUCT *task) {
+  REF_LONG chunk;
+  REF_SIZE offset, n;
+  for (chunk = task->first; chunk < task->nchunk; chunk += task->step) {
+    offset = (REF_SIZE)chunk * task->length;
+    n = MIN(task->length, task->raw_size - offset);
+    if (task->pack) {
+      RSS(ref_compress_chunk_pack(&(task->raw[offset]), n, task->stride,
+                                  task->chunk[chunk],
+                                  &(task->chunk_size[chunk])),
+          "chunk");
+    } else {
+      RSS(ref_compress_chunk_unpack(task->chunk[chunk],
+                                    task->chunk_size[chunk],
+                                    &(task->raw[offset]), n),
+          "chunk");
+    }
+  }
+  return REF_SUCCESS;
+}
+
+#ifdef HAVE_PTHREAD
+static void *ref_compress_task_thread(void *arg) {
+  REF_COMPRESS_TASK_STRUCT *task = (REF_COMPRESS_TASK_STRUCT *)arg;
+  task->status = ref_compress_task_chunks(task);
+  return NULL;
+}
+#endif
+
+/* chunks are independent, strided over threads when available */
+REF_FCN static REF_STATUS ref_compress_task(REF_COMPRESS_TASK_STRUCT *task) {
+#ifdef HAVE_PTHREAD
+  REF_COMPRESS_TASK_STRUCT *worker;
+  pthread_t *thread;
+  REF_BOOL *started;
+  REF_INT nthread, i;
+  REF_STATUS status = REF_SUCCESS;
+
+  nthread = (REF_INT)MIN((REF_LONG)REF_COMPRESS_MAX_THREADS, task->nchunk);
+  if (nthread <= 1) {
+    RSS(ref_compress_task_chunks(task), "serial chunks");
+    return REF_SUCCESS;
+  }
+  ref_malloc(worker, nthread, REF_COMPRESS_TASK_STRUCT);
+  ref_malloc(thread, nthread, pthread_t);
+  ref_malloc_init(started, nthread, REF_BOOL, REF_FALSE);
+  for (i = 0; i < nthread; i++) {
+    worker[i] = *task;
+    worker[i].first = i;
+    worker[i].step = nthread;
+    worker[i].status = REF_SUCCESS;
+    started[i] = (0 == pthread_create(&(thread[i]), NULL,
+                                      ref_compress_task_thread, &(worker[i])));
+  }
+  for (i = 0; i < nthread; i++) {
+    if (started[i]) {
+      REIS(0, pthread_join(thread[i], NULL), "join");
+    } else { /* finish the share of a thread that failed to start */
+      worker[i].status = ref_compress_task_chunks(&(worker[i]));
+    }
+    if (REF_SUCCESS != worker[i].status) status = worker[i].status;
+  }
+  ref_free(started);
+  ref_free(thread);
+  ref_free(worker);
+  RSS(status, "threaded chunks");
+#else
+  RSS(ref_compress_task_chunks(task), "serial chunks");
+#endif
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_compress_detect(REF_BYTE *data, REF_SIZE size,
+                                       REF_BOOL *compressed) {
+  *compressed = (REF_COMPRESS_MAGIC_SIZE <= size &&
+                 0 == memcmp(data, ref_compress_magic,
+                             REF_COMPRESS_MAGIC_SIZE));
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_compress_pack(REF_BYTE *raw, REF_SIZE raw_size,
+                                     REF_INT stride, REF_BYTE **packed,
+                                     REF_SIZE *packed_size) {
+  REF_COMPRESS_TASK_STRUCT task;
+  REF_LONG chunk, header[3];
+  REF_SIZE n, position;
+  REF_INT i;
+
+  RAS(0 <= stride && stride <= REF_COMPRESS_MAX_STRIDE, "stride range");
+
+  task.pack = REF_TRUE;
+  task.raw = (unsigned char *)raw;
+  task.raw_size = raw_size;
+  task.length = REF_COMPRESS_CHUNK;
+  task.stride = stride;
+  task.nchunk = (REF_LONG)((raw_size + task.length - 1) / task.length);
+  task.first = 0;
+  task.step = 1;
+  task.status = REF_SUCCESS;
+  ref_malloc_size_t(task.chunk, MAX(1, task.nchunk), unsigned char *);
+  ref_malloc_size_t(task.chunk_size, MAX(1, task.nchunk), REF_SIZE);
+  for (chunk = 0; chunk < task.nchunk; chunk++) {
+    n = MIN(task.length, raw_size - (REF_SIZE)chunk * task.length);
+    ref_malloc_size_t(task.chunk[chunk], REF_COMPRESS_INT + n, unsigned char);
+  }
+
+  RSS(ref_compress_task(&task), "pack chunks");
+
+  *packed_size =
+      REF_COMPRESS_HEADER + (REF_SIZE)task.nchunk * REF_COMPRESS_LONG;
+  for (chunk = 0; chunk < task.nchunk; chunk++)
+    *packed_size += task.chunk_size[chunk];
+  ref_malloc_size_t(*packed, *packed_size, REF_BYTE);
+
+  memcpy(*packed, ref_compress_magic, REF_COMPRESS_MAGIC_SIZE);
+  header[0] = (REF_LONG)raw_size;
+  header[1] = (REF_LONG)task.length;
+  header[2] = task.nchunk;
+  position = REF_COMPRESS_MAGIC_SIZE;
+  for (i = 0; i < 3; i++) {
+    ref_compress_put_long((unsigned char *)&((*packed)[position]), header[i]);
+    position += REF_COMPRESS_LONG;
+  }
+  for (chunk = 0; chunk < task.nchunk; chunk++) {
+    ref_compress_put_long((unsigned char *)&((*packed)[position]),
+                          (REF_LONG)task.chunk_size[chunk]);
+    position += REF_COMPRESS_LONG;
+  }
+  for (chunk = 0; chunk < task.nchunk; chunk++) {
+    memcpy(&((*packed)[position]), task.chunk[chunk],
+           task.chunk_size[chunk]);
+    position += task.chunk_size[chunk];
+    ref_free(task.chunk[chunk]);
+  }
+  REIS(*packed_size, position, "packed size mismatch");
+  ref_free(task.chunk_size);
+  ref_free(task.chunk);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_compress_unpack(REF_BYTE *packed,
+                                       REF_SIZE packed_size, REF_BYTE **raw,
+                                       REF_SIZE *raw_size) {
+  REF_COMPRESS_TASK_STRUCT task;
+  REF_LONG chunk, header[3], used;
+  REF_BOOL compressed;
+  REF_SIZE position;
+  REF_INT i;
+
+  *raw = NULL;
+  *raw_size = 0;
+  RSS(ref_compress_detect(packed, packed_size, &compressed), "detect");
+  RAS(compressed, "not a packed container");
+  RAS(REF_COMPRESS_HEADER <= packed_size, "truncated header");
+  for (i = 0; i < 3; i++)
+    header[i] = ref_compress_get_long((unsigned char *)&(
+        packed[REF_COMPRESS_MAGIC_SIZE + (REF_SIZE)i * REF_COMPRESS_LONG]));
+  RAS(0 <= header[0], "negative raw size");
+  RAS(0 < header[1] && 0 == header[1] % REF_COMPRESS_PLANES, "chunk length");
+  REIS((header[0] + header[1] - 1) / header[1], header[2], "chunk count");
+  RAS(REF_COMPRESS_HEADER + (REF_SIZE)header[2] * REF_COMPRESS_LONG <=
+          packed_size,
+      "truncated chunk table");
+
+  task.pack = REF_FALSE;
+  task.raw_size = (REF_SIZE)header[0];
+  task.length = (REF_SIZE)header[1];
+  task.stride = 0;
+  task.nchunk = header[2];
+  task.first = 0;
+  task.step = 1;
+  task.status = REF_SUCCESS;
+  ref_malloc_size_t(task.chunk, MAX(1, task.nchunk), unsigned char *);
+  ref_malloc_size_t(task.chunk_size, MAX(1, task.nchunk), REF_SIZE);
+  position = REF_COMPRESS_HEADER + (REF_SIZE)task.nchunk * REF_COMPRESS_LONG;
+  for (chunk = 0; chunk < task.nchunk; chunk++) {
+    used = ref_compress_get_long((unsigned char *)&(
+        packed[REF_COMPRESS_HEADER + (REF_SIZE)chunk * REF_COMPRESS_LONG]));
+    RAS(0 <= used && (REF_SIZE)used <= packed_size - position,
+        "truncated chunk");
+    task.chunk[chunk] = (unsigned char *)&(packed[position]);
+    task.chunk_size[chunk] = (REF_SIZE)used;
+    position += (REF_SIZE)used;
+  }
+  REIS(packed_size, position, "trailing bytes after chunks");
+
+  ref_malloc_size_t(*raw, MAX(1, task.raw_size), REF_BYTE);
+  task.raw = (unsigned char *)(*raw);
+  RSS(ref_compress_task(&task), "unpack chunks");
+  *raw_size = task.raw_size;
+
+  ref_free(task.chunk_size);
+  ref_free(task.chunk);
+
+  return REF_SUCCESS;
+}
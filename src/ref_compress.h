@@ -0,0 +1,49 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_COMPRESS_H
+#define REF_COMPRESS_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+
+/* raw bytes per independently coded chunk, a multiple of 8 */
+#define REF_COMPRESS_CHUNK (4194304)
+/* leading bytes of a packed container, its integers are little endian */
+#define REF_COMPRESS_MAGIC_SIZE (8)
+
+/* true when data starts with the packed container magic */
+REF_FCN REF_STATUS ref_compress_detect(REF_BYTE *data, REF_SIZE size,
+                                       REF_BOOL *compressed);
+
+/* lossless, stride is the record length in bytes (columns are
+ * xor-delta coded against the previous record), zero to pick a
+ * stride per chunk, packed is allocated with ref_malloc */
+REF_FCN REF_STATUS ref_compress_pack(REF_BYTE *raw, REF_SIZE raw_size,
+                                     REF_INT stride, REF_BYTE **packed,
+                                     REF_SIZE *packed_size);
+/* raw is allocated with ref_malloc */
+REF_FCN REF_STATUS ref_compress_unpack(REF_BYTE *packed,
+                                       REF_SIZE packed_size, REF_BYTE **raw,
+                                       REF_SIZE *raw_size);
+
+END_C_DECLORATION
+
+#endif /* REF_COMPRESS_H */
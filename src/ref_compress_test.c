@@ -0,0 +1,144 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_compress.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+
+static REF_STATUS ref_compress_test_round_trip(REF_BYTE *raw,
+                                               REF_SIZE raw_size,
+                                               REF_INT stride,
+                                               REF_SIZE *packed_size) {
+  REF_BYTE *packed, *unpacked;
+  REF_SIZE unpacked_size;
+  REF_BOOL compressed;
+
+  RSS(ref_compress_detect(raw, raw_size, &compressed), "detect raw");
+  RAS(!compressed, "raw detected as packed");
+  RSS(ref_compress_pack(raw, raw_size, stride, &packed, packed_size),
+      "pack");
+  RSS(ref_compress_detect(packed, *packed_size, &compressed), "detect");
+  RAS(compressed, "packed not detected");
+  RSS(ref_compress_unpack(packed, *packed_size, &unpacked, &unpacked_size),
+      "unpack");
+  REIS(raw_size, unpacked_size, "size");
+  if (0 < raw_size) REIS(0, memcmp(raw, unpacked, raw_size), "bytes");
+  ref_free(unpacked);
+  ref_free(packed);
+  return REF_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  if (ref_mpi_once(ref_mpi)) { /* empty */
+    REF_BYTE raw[1];
+    REF_SIZE packed_size;
+    RSS(ref_compress_test_round_trip(raw, 0, 0, &packed_size), "trip");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* short, odd length */
+    REF_BYTE raw[] = "short text";
+    REF_SIZE packed_size;
+    RSS(ref_compress_test_round_trip(raw, strlen(raw), 0, &packed_size),
+        "trip");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* smooth field over several chunks */
+    REF_INT ldim = 6, i, nnode = 200000;
+    REF_DBL *field;
+    REF_SIZE raw_size, packed_size;
+    ref_malloc(field, ldim * nnode, REF_DBL);
+    for (i = 0; i < ldim * nnode; i++)
+      field[i] = 1.0 + 0.5 * sin(1.0e-3 * (REF_DBL)(i / ldim)) +
+                 (REF_DBL)(i % ldim);
+    raw_size = (REF_SIZE)ldim * (REF_SIZE)nnode * sizeof(REF_DBL);
+    RAS(REF_COMPRESS_CHUNK < raw_size, "test one chunk");
+    RSS(ref_compress_test_round_trip((REF_BYTE *)field, raw_size,
+                                     ldim * (REF_INT)sizeof(REF_DBL),
+                                     &packed_size),
+        "trip stride");
+    RAS(2 * packed_size < raw_size, "poor compression");
+    RSS(ref_compress_test_round_trip((REF_BYTE *)field, raw_size, 0,
+                                     &packed_size),
+        "trip pick");
+    RAS(2 * packed_size < raw_size, "poor compression");
+    ref_free(field);
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* noise is stored */
+    REF_INT i, n = 100000;
+    REF_BYTE *raw;
+    REF_SIZE packed_size;
+    unsigned int seed = 1;
+    ref_malloc(raw, n, REF_BYTE);
+    for (i = 0; i < n; i++) {
+      seed = seed * 1103515245u + 12345u;
+      raw[i] = (REF_BYTE)(seed >> 16);
+    }
+    RSS(ref_compress_test_round_trip(raw, (REF_SIZE)n, 8, &packed_size),
+        "trip");
+    RAS(packed_size <= (REF_SIZE)n + 64, "stored grew");
+    ref_free(raw);
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* raw size is little endian */
+    REF_DBL field[512];
+    REF_BYTE *packed;
+    REF_SIZE packed_size;
+    REF_INT i;
+    for (i = 0; i < 512; i++) field[i] = (REF_DBL)i;
+    RSS(ref_compress_pack((REF_BYTE *)field, sizeof(field), 8, &packed,
+                          &packed_size),
+        "pack");
+    REIS(0x00, (unsigned char)packed[REF_COMPRESS_MAGIC_SIZE + 0], "byte 0");
+    REIS(0x10, (unsigned char)packed[REF_COMPRESS_MAGIC_SIZE + 1], "byte 1");
+    for (i = 2; i < 8; i++)
+      REIS(0x00, (unsigned char)packed[REF_COMPRESS_MAGIC_SIZE + i], "byte");
+    ref_free(packed);
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* truncated container */
+    REF_DBL field[512];
+    REF_BYTE *packed, *unpacked;
+    REF_SIZE packed_size, unpacked_size;
+    REF_INT i;
+    for (i = 0; i < 512; i++) field[i] = (REF_DBL)i;
+    RSS(ref_compress_pack((REF_BYTE *)field, sizeof(field), 8, &packed,
+                          &packed_size),
+        "pack");
+    REIS(REF_FAILURE,
+         ref_compress_unpack(packed, packed_size - 1, &unpacked,
+                             &unpacked_size),
+         "expected failure");
+    ref_free(packed);
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
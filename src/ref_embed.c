@@ -0,0 +1,258 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_embed.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_adapt.h"
+#include "ref_gather.h"
+#include "ref_histogram.h"
+#include "ref_malloc.h"
+#include "ref_migrate.h"
+#include "ref_validation.h"
+
+REF_FCN REF_STATUS ref_embed_create(REF_EMBED *ref_embed_ptr,
+                                    REF_MPI ref_mpi) {
+  REF_EMBED ref_embed;
+
+  ref_malloc(*ref_embed_ptr, 1, REF_EMBED_STRUCT);
+  ref_embed = (*ref_embed_ptr);
+
+  RSS(ref_grid_create(&(ref_embed->ref_grid), ref_mpi), "create grid");
+  ref_embed->ldim = 0;
+  ref_embed->passes = 20;
+  ref_embed->quiet = REF_TRUE;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_free(REF_EMBED ref_embed) {
+  if (NULL == (void *)ref_embed) return REF_NULL;
+  RSS(ref_grid_free(ref_embed->ref_grid), "free grid");
+  ref_free(ref_embed);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_node(REF_EMBED ref_embed, REF_INT nnode,
+                                  REF_GLOB nnode_global, REF_GLOB *l2g,
+                                  REF_INT *part, REF_DBL *xyz) {
+  REF_NODE ref_node = ref_grid_node(ref_embed_grid(ref_embed));
+  REF_INT node, new_node;
+
+  REIS(0, ref_node_n(ref_node), "nodes already imported");
+  RSS(ref_node_initialize_n_global(ref_node, nnode_global), "init global");
+  for (node = 0; node < nnode; node++) {
+    RSS(ref_node_add(ref_node, l2g[node], &new_node), "add node");
+    REIS(node, new_node, "nodes are expected to be unique");
+    ref_node_xyz(ref_node, 0, new_node) = xyz[0 + 3 * node];
+    ref_node_xyz(ref_node, 1, new_node) = xyz[1 + 3 * node];
+    ref_node_xyz(ref_node, 2, new_node) = xyz[2 + 3 * node];
+    ref_node_part(ref_node, new_node) = part[node];
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_cell(REF_EMBED ref_embed, REF_INT node_per,
+                                  REF_INT ncell, REF_INT *c2n) {
+  REF_CELL ref_cell;
+  REF_INT cell, new_cell;
+
+  RSS(ref_grid_cell_with(ref_embed_grid(ref_embed), node_per, &ref_cell),
+      "cell type");
+  for (cell = 0; cell < ncell; cell++) {
+    RSS(ref_cell_add(ref_cell, &(c2n[node_per * cell]), &new_cell),
+        "add cell");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_face(REF_EMBED ref_embed, REF_INT node_per,
+                                  REF_INT nface, REF_INT *f2n, REF_INT *id) {
+  REF_GRID ref_grid = ref_embed_grid(ref_embed);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_CELL ref_cell;
+  REF_INT face, node, new_face;
+  REF_BOOL has_a_local_node;
+
+  RSS(ref_grid_face_with(ref_grid, node_per, &ref_cell), "face type");
+  for (face = 0; face < nface; face++) {
+    has_a_local_node = REF_FALSE;
+    for (node = 0; node < node_per; node++) {
+      nodes[node] = f2n[node + node_per * face];
+      has_a_local_node =
+          has_a_local_node || ref_node_owned(ref_node, nodes[node]);
+    }
+    nodes[node_per] = id[face];
+    if (has_a_local_node)
+      RSS(ref_cell_add(ref_cell, nodes, &new_face), "add face");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_metric(REF_EMBED ref_embed, REF_DBL *metric) {
+  REF_NODE ref_node = ref_grid_node(ref_embed_grid(ref_embed));
+  REF_INT node;
+
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(ref_node_metric_set(ref_node, node, &(metric[6 * node])), "set");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_field(REF_EMBED ref_embed, REF_INT ldim,
+                                   REF_DBL *field) {
+  REF_NODE ref_node = ref_grid_node(ref_embed_grid(ref_embed));
+  REF_INT node, i;
+
+  RAS(0 <= ldim, "negative ldim");
+  ref_embed_ldim(ref_embed) = ldim;
+  ref_node_naux(ref_node) = ldim;
+  RSS(ref_node_resize_aux(ref_node), "size aux");
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < ldim; i++)
+      ref_node_aux(ref_node, i, node) = field[i + ldim * node];
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_adapt(REF_EMBED ref_embed) {
+  REF_GRID ref_grid = ref_embed_grid(ref_embed);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_BOOL quiet = ref_embed_quiet(ref_embed);
+  REF_BOOL all_done = REF_FALSE;
+  REF_INT pass;
+
+  RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync glob");
+  RSS(ref_gather_tec_movie_record_button(ref_grid_gather(ref_grid), REF_FALSE),
+      "rec");
+  if (!quiet) {
+    RSS(ref_validation_cell_volume(ref_grid), "vol");
+    RSS(ref_histogram_ratio(ref_grid), "gram");
+  }
+
+  for (pass = 0; !all_done && pass < ref_embed_passes(ref_embed); pass++) {
+    RSS(ref_adapt_pass(ref_grid, &all_done), "pass");
+    if (!quiet) {
+      ref_mpi_stopwatch_stop(ref_mpi, "pass");
+      RSS(ref_validation_cell_volume(ref_grid), "vol");
+      RSS(ref_histogram_ratio(ref_grid), "gram");
+    }
+    RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync g");
+    RSS(ref_migrate_to_rebalance(ref_grid), "balance");
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_size(REF_EMBED ref_embed, REF_INT *nnode,
+                                  REF_GLOB *nnode_global) {
+  REF_NODE ref_node = ref_grid_node(ref_embed_grid(ref_embed));
+
+  RSS(ref_node_synchronize_globals(ref_node), "sync glob");
+  *nnode = ref_node_n(ref_node);
+  *nnode_global = ref_node_n_global(ref_node);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_embed_cell_type(REF_EMBED ref_embed,
+                                              REF_INT node_per,
+                                              REF_BOOL faces,
+                                              REF_CELL *ref_cell) {
+  if (faces) {
+    RSS(ref_grid_face_with(ref_embed_grid(ref_embed), node_per, ref_cell),
+        "face type");
+  } else {
+    RSS(ref_grid_cell_with(ref_embed_grid(ref_embed), node_per, ref_cell),
+        "cell type");
+  }
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_ncell(REF_EMBED ref_embed, REF_INT node_per,
+                                   REF_BOOL faces, REF_INT *ncell) {
+  REF_CELL ref_cell;
+  RSS(ref_embed_cell_type(ref_embed, node_per, faces, &ref_cell), "type");
+  *ncell = ref_cell_n(ref_cell);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_each_node(REF_EMBED ref_embed,
+                                       REF_EMBED_NODE_FCN node_fcn,
+                                       void *state) {
+  REF_NODE ref_node = ref_grid_node(ref_embed_grid(ref_embed));
+  REF_INT *o2n, *n2o, compact, node;
+  REF_DBL *field;
+
+  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+  for (compact = 0; compact < ref_node_n(ref_node); compact++) {
+    node = n2o[compact];
+    field = NULL;
+    if (0 < ref_embed_ldim(ref_embed)) field = &ref_node_aux(ref_node, 0, node);
+    RSB(node_fcn(state, compact, ref_node_global(ref_node, node),
+                 ref_node_part(ref_node, node),
+                 &ref_node_xyz(ref_node, 0, node), ref_embed_ldim(ref_embed),
+                 field),
+        "node callback", {
+          ref_free(n2o);
+          ref_free(o2n);
+        });
+  }
+  ref_free(n2o);
+  ref_free(o2n);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_embed_each_cell(REF_EMBED ref_embed, REF_INT node_per,
+                                       REF_BOOL faces,
+                                       REF_EMBED_CELL_FCN cell_fcn,
+                                       void *state) {
+  REF_NODE ref_node = ref_grid_node(ref_embed_grid(ref_embed));
+  REF_CELL ref_cell;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT *o2n, *n2o, cell, node, id;
+
+  RSS(ref_embed_cell_type(ref_embed, node_per, faces, &ref_cell), "type");
+  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    for (node = 0; node < ref_cell_node_per(ref_cell); node++)
+      nodes[node] = o2n[nodes[node]];
+    id = REF_EMPTY;
+    if (ref_cell_last_node_is_an_id(ref_cell))
+      id = nodes[ref_cell_node_per(ref_cell)];
+    RSB(cell_fcn(state, ref_cell_node_per(ref_cell), nodes, id),
+        "cell callback", {
+          ref_free(n2o);
+          ref_free(o2n);
+        });
+  }
+  ref_free(n2o);
+  ref_free(o2n);
+
+  return REF_SUCCESS;
+}
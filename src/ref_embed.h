@@ -0,0 +1,102 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_EMBED_H
+#define REF_EMBED_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_EMBED_STRUCT REF_EMBED_STRUCT;
+typedef REF_EMBED_STRUCT *REF_EMBED;
+END_C_DECLORATION
+
+#include "ref_grid.h"
+#include "ref_mpi.h"
+
+BEGIN_C_DECLORATION
+
+/* visits a node with its zero-based compact index and ldim field values */
+typedef REF_STATUS (*REF_EMBED_NODE_FCN)(void *state, REF_INT node,
+                                         REF_GLOB global, REF_INT part,
+                                         REF_DBL *xyz, REF_INT ldim,
+                                         REF_DBL *field);
+/* visits a cell or face, nodes are compact indexes, id is the face tag
+ * (REF_EMPTY for volume cells) */
+typedef REF_STATUS (*REF_EMBED_CELL_FCN)(void *state, REF_INT node_per,
+                                         REF_INT *nodes, REF_INT id);
+
+struct REF_EMBED_STRUCT {
+  REF_GRID ref_grid;
+  REF_INT ldim;
+  REF_INT passes;
+  REF_BOOL quiet;
+};
+
+/* the adapted grid, valid until ref_embed_free */
+#define ref_embed_grid(ref_embed) ((ref_embed)->ref_grid)
+#define ref_embed_ldim(ref_embed) ((ref_embed)->ldim)
+/* maximum adaptation passes, 20 by default */
+#define ref_embed_passes(ref_embed) ((ref_embed)->passes)
+/* skips the volume and ratio reports between passes, true by default */
+#define ref_embed_quiet(ref_embed) ((ref_embed)->quiet)
+
+/* one independent grid per handle, no state is shared between handles,
+ * ref_mpi is borrowed and may be shared by handles on the same ranks */
+REF_FCN REF_STATUS ref_embed_create(REF_EMBED *ref_embed, REF_MPI ref_mpi);
+REF_FCN REF_STATUS ref_embed_free(REF_EMBED ref_embed);
+
+/* zero-based local nodes including ghosts: l2g global index, owning
+ * rank, and interleaved xyz[3*node], caller arrays are not retained */
+REF_FCN REF_STATUS ref_embed_node(REF_EMBED ref_embed, REF_INT nnode,
+                                  REF_GLOB nnode_global, REF_GLOB *l2g,
+                                  REF_INT *part, REF_DBL *xyz);
+/* volume cells of 4 (tet), 5 (pyr), 6 (pri), or 8 (hex) local nodes */
+REF_FCN REF_STATUS ref_embed_cell(REF_EMBED ref_embed, REF_INT node_per,
+                                  REF_INT ncell, REF_INT *c2n);
+/* boundary faces of 3 or 4 local nodes with a tag per face */
+REF_FCN REF_STATUS ref_embed_face(REF_EMBED ref_embed, REF_INT node_per,
+                                  REF_INT nface, REF_INT *f2n, REF_INT *id);
+/* six upper triangular entries per local node */
+REF_FCN REF_STATUS ref_embed_metric(REF_EMBED ref_embed, REF_DBL *metric);
+/* ldim values per local node, interpolated as the grid is adapted */
+REF_FCN REF_STATUS ref_embed_field(REF_EMBED ref_embed, REF_INT ldim,
+                                   REF_DBL *field);
+
+REF_FCN REF_STATUS ref_embed_adapt(REF_EMBED ref_embed);
+
+/* adapted node counts, nnode includes ghosts */
+REF_FCN REF_STATUS ref_embed_size(REF_EMBED ref_embed, REF_INT *nnode,
+                                  REF_GLOB *nnode_global);
+/* node_per selects volume cells, or faces when node_per is 3 or 4 and
+ * faces is true */
+REF_FCN REF_STATUS ref_embed_ncell(REF_EMBED ref_embed, REF_INT node_per,
+                                   REF_BOOL faces, REF_INT *ncell);
+/* walk the adapted grid in place, without staging output arrays */
+REF_FCN REF_STATUS ref_embed_each_node(REF_EMBED ref_embed,
+                                       REF_EMBED_NODE_FCN node_fcn,
+                                       void *state);
+REF_FCN REF_STATUS ref_embed_each_cell(REF_EMBED ref_embed, REF_INT node_per,
+                                       REF_BOOL faces,
+                                       REF_EMBED_CELL_FCN cell_fcn,
+                                       void *state);
+
+END_C_DECLORATION
+
+#endif /* REF_EMBED_H */
@@ -0,0 +1,200 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_embed.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_fixture.h"
+#include "ref_grid.h"
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+
+typedef struct {
+  REF_GLOB *l2g;
+  REF_INT *part;
+  REF_DBL *xyz;
+  REF_DBL *field;
+  REF_INT *c2n;
+  REF_INT *id;
+  REF_INT n;
+} REF_EMBED_TEST_ARRAYS;
+
+static REF_STATUS ref_embed_test_node(void *state, REF_INT node,
+                                      REF_GLOB global, REF_INT part,
+                                      REF_DBL *xyz, REF_INT ldim,
+                                      REF_DBL *field) {
+  REF_EMBED_TEST_ARRAYS *arrays = (REF_EMBED_TEST_ARRAYS *)state;
+  REF_INT i;
+  arrays->l2g[node] = global;
+  arrays->part[node] = part;
+  for (i = 0; i < 3; i++) arrays->xyz[i + 3 * node] = xyz[i];
+  for (i = 0; i < ldim; i++) arrays->field[i + ldim * node] = field[i];
+  return REF_SUCCESS;
+}
+
+static REF_STATUS ref_embed_test_cell(void *state, REF_INT node_per,
+                                      REF_INT *nodes, REF_INT id) {
+  REF_EMBED_TEST_ARRAYS *arrays = (REF_EMBED_TEST_ARRAYS *)state;
+  REF_INT i;
+  for (i = 0; i < node_per; i++)
+    arrays->c2n[i + node_per * arrays->n] = nodes[i];
+  if (NULL != arrays->id) arrays->id[arrays->n] = id;
+  arrays->n++;
+  return REF_SUCCESS;
+}
+
+/* copies the tet brick fixture out through the walkers into a handle */
+static REF_STATUS ref_embed_test_brick(REF_EMBED *ref_embed, REF_MPI ref_mpi,
+                                       REF_DBL h) {
+  REF_GRID ref_grid;
+  REF_EMBED fixture;
+  REF_EMBED_TEST_ARRAYS arrays;
+  REF_INT nnode, ntet, ntri, node;
+  REF_GLOB nnode_global;
+  REF_DBL *metric;
+
+  RSS(ref_embed_create(&fixture, ref_mpi), "create");
+  RSS(ref_grid_free(ref_embed_grid(fixture)), "free empty");
+  RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+  ref_embed_grid(fixture) = ref_grid;
+
+  RSS(ref_embed_size(fixture, &nnode, &nnode_global), "size");
+  RSS(ref_embed_ncell(fixture, 4, REF_FALSE, &ntet), "ntet");
+  RSS(ref_embed_ncell(fixture, 3, REF_TRUE, &ntri), "ntri");
+  ref_malloc(arrays.l2g, nnode, REF_GLOB);
+  ref_malloc(arrays.part, nnode, REF_INT);
+  ref_malloc(arrays.xyz, 3 * nnode, REF_DBL);
+  ref_malloc(arrays.c2n, 4 * ntet, REF_INT);
+  ref_malloc(arrays.id, ntri, REF_INT);
+  arrays.field = NULL;
+  RSS(ref_embed_each_node(fixture, ref_embed_test_node, &arrays), "nodes");
+
+  RSS(ref_embed_create(ref_embed, ref_mpi), "create");
+  RSS(ref_embed_node(*ref_embed, nnode, nnode_global, arrays.l2g, arrays.part,
+                     arrays.xyz),
+      "node");
+  arrays.n = 0;
+  arrays.id = NULL;
+  RSS(ref_embed_each_cell(fixture, 4, REF_FALSE, ref_embed_test_cell,
+                          &arrays),
+      "tets");
+  REIS(ntet, arrays.n, "tets walked");
+  RSS(ref_embed_cell(*ref_embed, 4, ntet, arrays.c2n), "tet");
+  ref_free(arrays.c2n);
+  ref_malloc(arrays.c2n, 3 * ntri, REF_INT);
+  ref_malloc(arrays.id, ntri, REF_INT);
+  arrays.n = 0;
+  RSS(ref_embed_each_cell(fixture, 3, REF_TRUE, ref_embed_test_cell, &arrays),
+      "tris");
+  REIS(ntri, arrays.n, "tris walked");
+  RSS(ref_embed_face(*ref_embed, 3, ntri, arrays.c2n, arrays.id), "tri");
+
+  ref_malloc(metric, 6 * nnode, REF_DBL);
+  for (node = 0; node < nnode; node++) {
+    metric[0 + 6 * node] = 1.0 / (h * h);
+    metric[1 + 6 * node] = 0.0;
+    metric[2 + 6 * node] = 0.0;
+    metric[3 + 6 * node] = 1.0 / (h * h);
+    metric[4 + 6 * node] = 0.0;
+    metric[5 + 6 * node] = 1.0 / (h * h);
+  }
+  RSS(ref_embed_metric(*ref_embed, metric), "metric");
+  ref_free(metric);
+
+  for (node = 0; node < nnode; node++) /* reuse xyz as a linear field */
+    arrays.xyz[node] = arrays.xyz[0 + 3 * node];
+  RSS(ref_embed_field(*ref_embed, 1, arrays.xyz), "field");
+
+  ref_free(arrays.id);
+  ref_free(arrays.c2n);
+  ref_free(arrays.xyz);
+  ref_free(arrays.part);
+  ref_free(arrays.l2g);
+  RSS(ref_embed_free(fixture), "free");
+  return REF_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  { /* create and free */
+    REF_EMBED ref_embed;
+    RSS(ref_embed_create(&ref_embed, ref_mpi), "create");
+    REIS(0, ref_embed_ldim(ref_embed), "ldim");
+    RSS(ref_embed_free(ref_embed), "free");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* two grids adapted side by side */
+    REF_EMBED fine, coarse;
+    REF_EMBED_TEST_ARRAYS arrays;
+    REF_INT nnode, ntet, node;
+    REF_GLOB fine_global, coarse_global;
+
+    RSS(ref_embed_test_brick(&fine, ref_mpi, 0.2), "fine");
+    RSS(ref_embed_test_brick(&coarse, ref_mpi, 0.6), "coarse");
+    RSS(ref_embed_size(fine, &nnode, &fine_global), "size");
+    REIS(64, fine_global, "brick nodes");
+
+    ref_embed_passes(fine) = 4;
+    ref_embed_passes(coarse) = 4;
+    RSS(ref_embed_adapt(fine), "adapt fine");
+    RSS(ref_embed_adapt(coarse), "adapt coarse");
+    RSS(ref_embed_size(fine, &nnode, &fine_global), "size");
+    RSS(ref_embed_size(coarse, &nnode, &coarse_global), "size");
+    RAS(64 < fine_global, "fine grid not refined");
+    RAS(coarse_global < 64, "coarse grid not coarsened");
+    RAS(coarse_global < fine_global, "handles not independent");
+
+    RSS(ref_embed_size(fine, &nnode, &fine_global), "size");
+    RSS(ref_embed_ncell(fine, 4, REF_FALSE, &ntet), "ntet");
+    ref_malloc(arrays.l2g, nnode, REF_GLOB);
+    ref_malloc(arrays.part, nnode, REF_INT);
+    ref_malloc(arrays.xyz, 3 * nnode, REF_DBL);
+    ref_malloc(arrays.field, nnode, REF_DBL);
+    ref_malloc(arrays.c2n, 4 * ntet, REF_INT);
+    arrays.id = NULL;
+    arrays.n = 0;
+    RSS(ref_embed_each_node(fine, ref_embed_test_node, &arrays), "nodes");
+    RSS(ref_embed_each_cell(fine, 4, REF_FALSE, ref_embed_test_cell,
+                            &arrays),
+        "tets");
+    REIS(ntet, arrays.n, "tets walked");
+    for (node = 0; node < 4 * ntet; node++)
+      RAS(0 <= arrays.c2n[node] && arrays.c2n[node] < nnode, "compact c2n");
+    for (node = 0; node < nnode; node++)
+      RAS(-1.0e-12 < arrays.field[node] && arrays.field[node] < 1.0 + 1.0e-12,
+          "interpolated field outside of original range");
+    ref_free(arrays.c2n);
+    ref_free(arrays.field);
+    ref_free(arrays.xyz);
+    ref_free(arrays.part);
+    ref_free(arrays.l2g);
+
+    RSS(ref_embed_free(coarse), "free");
+    RSS(ref_embed_free(fine), "free");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
@@ -27,7 +27,6 @@
 
 #include "ref_dict.h"
 #include "ref_edge.h"
-#include "ref_endian.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
 #include "ref_matrix.h"
@@ -220,6 +219,240 @@ REF_FCN static REF_STATUS ref_export_vtk(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
+REF_FCN static REF_STATUS ref_export_vtu_type(REF_GRID ref_grid,
+                                              REF_CELL ref_cell,
+                                              REF_INT *type) {
+  *type = REF_EMPTY;
+  if (ref_cell == ref_grid_tri(ref_grid)) *type = VTK_TRIANGLE;
+  if (ref_cell == ref_grid_qua(ref_grid)) *type = VTK_QUAD;
+  if (ref_cell == ref_grid_tet(ref_grid)) *type = VTK_TETRA;
+  if (ref_cell == ref_grid_pyr(ref_grid)) *type = VTK_PYRAMID;
+  if (ref_cell == ref_grid_pri(ref_grid)) *type = VTK_WEDGE;
+  if (ref_cell == ref_grid_hex(ref_grid)) *type = VTK_HEXAHEDRON;
+  return REF_SUCCESS;
+}
+
+/* VTK XML piece of the local partition with appended raw data,
+ * vtkGhostType marks entities owned by other ranks (1 is DUPLICATEPOINT and
+ * DUPLICATECELL) */
+REF_FCN static REF_STATUS ref_export_vtu(REF_GRID ref_grid,
+                                         const char *filename) {
+  FILE *file;
+  REF_WRITER ref_writer;
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT node;
+  REF_INT *o2n, *n2o;
+  REF_INT ncell, nconn, offset, type, part;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_INT node_per, cell;
+  REF_INT group;
+  REF_LONG block[6];
+  REF_FILEPOS start;
+  REF_BYTE flag;
+  REF_INT i, one = 1;
+  REF_BOOL big_endian;
+
+  file = fopen(filename, "w");
+  if (NULL == (void *)file) printf("unable to open %s\n", filename);
+  RNS(file, "unable to open file");
+
+  /* appended data is declared LittleEndian, swapped on big endian hosts */
+  big_endian = (1 != *((REF_BYTE *)&one));
+
+  RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
+
+  ncell = 0;
+  nconn = 0;
+  each_ref_grid_2d_3d_ref_cell(ref_grid, group, ref_cell) {
+    RSS(ref_export_vtu_type(ref_grid, ref_cell, &type), "type");
+    if (REF_EMPTY == type) continue;
+    ncell += ref_cell_n(ref_cell);
+    nconn += ref_cell_node_per(ref_cell) * ref_cell_n(ref_cell);
+  }
+
+  /* bytes of each appended array, each preceded by a UInt64 size */
+  block[0] = (REF_LONG)ref_node_n(ref_node);
+  block[1] = (REF_LONG)ncell;
+  block[2] = (REF_LONG)(3 * 8) * (REF_LONG)ref_node_n(ref_node);
+  block[3] = (REF_LONG)4 * (REF_LONG)nconn;
+  block[4] = (REF_LONG)4 * (REF_LONG)ncell;
+  block[5] = (REF_LONG)ncell;
+
+  fprintf(file, "<?xml version=\"1.0\"?>\n");
+  fprintf(file,
+          "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+          "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n");
+  fprintf(file, "<UnstructuredGrid>\n");
+  fprintf(file, "<Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n",
+          ref_node_n(ref_node), ncell);
+  start = 0;
+  fprintf(file, "<PointData>\n");
+  fprintf(file,
+          "<DataArray type=\"UInt8\" Name=\"vtkGhostType\" "
+          "format=\"appended\" offset=\"%ld\"/>\n",
+          (long)start);
+  start += 8 + block[0];
+  fprintf(file, "</PointData>\n");
+  fprintf(file, "<CellData>\n");
+  fprintf(file,
+          "<DataArray type=\"UInt8\" Name=\"vtkGhostType\" "
+          "format=\"appended\" offset=\"%ld\"/>\n",
+          (long)start);
+  start += 8 + block[1];
+  fprintf(file, "</CellData>\n");
+  fprintf(file, "<Points>\n");
+  fprintf(file,
+          "<DataArray type=\"Float64\" NumberOfComponents=\"3\" "
+          "format=\"appended\" offset=\"%ld\"/>\n",
+          (long)start);
+  start += 8 + block[2];
+  fprintf(file, "</Points>\n");
+  fprintf(file, "<Cells>\n");
+  fprintf(file,
+          "<DataArray type=\"Int32\" Name=\"connectivity\" "
+          "format=\"appended\" offset=\"%ld\"/>\n",
+          (long)start);
+  start += 8 + block[3];
+  fprintf(file,
+          "<DataArray type=\"Int32\" Name=\"offsets\" "
+          "format=\"appended\" offset=\"%ld\"/>\n",
+          (long)start);
+  start += 8 + block[4];
+  fprintf(file,
+          "<DataArray type=\"UInt8\" Name=\"types\" "
+          "format=\"appended\" offset=\"%ld\"/>\n",
+          (long)start);
+  fprintf(file, "</Cells>\n");
+  fprintf(file, "</Piece>\n");
+  fprintf(file, "</UnstructuredGrid>\n");
+  fprintf(file, "<AppendedData encoding=\"raw\">\n_");
+
+  i = 0;
+  RSS(ref_writer_create(&ref_writer, file, big_endian), "writer");
+
+  RSS(ref_writer_long(ref_writer, block[i++]), "point ghost size");
+  for (node = 0; node < ref_node_n(ref_node); node++) {
+    flag = (REF_BYTE)(ref_node_owned(ref_node, n2o[node]) ? 0 : 1);
+    RSS(ref_writer_bytes(ref_writer, 1, &flag), "point ghost");
+  }
+
+  RSS(ref_writer_long(ref_writer, block[i++]), "cell ghost size");
+  each_ref_grid_2d_3d_ref_cell(ref_grid, group, ref_cell) {
+    RSS(ref_export_vtu_type(ref_grid, ref_cell, &type), "type");
+    if (REF_EMPTY == type) continue;
+    each_ref_cell_valid_cell(ref_cell, cell) {
+      RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
+      flag = (REF_BYTE)((ref_mpi_rank(ref_mpi) == part) ? 0 : 1);
+      RSS(ref_writer_bytes(ref_writer, 1, &flag), "cell ghost");
+    }
+  }
+
+  RSS(ref_writer_long(ref_writer, block[i++]), "points size");
+  for (node = 0; node < ref_node_n(ref_node); node++) {
+    RSS(ref_writer_dbls(ref_writer, 3, ref_node_xyz_ptr(ref_node, n2o[node])),
+        "xyz");
+  }
+
+  RSS(ref_writer_long(ref_writer, block[i++]), "connectivity size");
+  each_ref_grid_2d_3d_ref_cell(ref_grid, group, ref_cell) {
+    RSS(ref_export_vtu_type(ref_grid, ref_cell, &type), "type");
+    if (REF_EMPTY == type) continue;
+    node_per = ref_cell_node_per(ref_cell);
+    each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+      if (5 == node_per) VTK_PYRAMID_ORDER(nodes);
+      if (6 == node_per) VTK_WEDGE_ORDER(nodes);
+      for (node = 0; node < node_per; node++)
+        RSS(ref_writer_int(ref_writer, o2n[nodes[node]]), "c2n");
+    }
+  }
+
+  RSS(ref_writer_long(ref_writer, block[i++]), "offsets size");
+  offset = 0;
+  each_ref_grid_2d_3d_ref_cell(ref_grid, group, ref_cell) {
+    RSS(ref_export_vtu_type(ref_grid, ref_cell, &type), "type");
+    if (REF_EMPTY == type) continue;
+    node_per = ref_cell_node_per(ref_cell);
+    each_ref_cell_valid_cell(ref_cell, cell) {
+      offset += node_per;
+      RSS(ref_writer_int(ref_writer, offset), "offset");
+    }
+  }
+
+  RSS(ref_writer_long(ref_writer, block[i++]), "types size");
+  each_ref_grid_2d_3d_ref_cell(ref_grid, group, ref_cell) {
+    RSS(ref_export_vtu_type(ref_grid, ref_cell, &type), "type");
+    if (REF_EMPTY == type) continue;
+    flag = (REF_BYTE)type;
+    each_ref_cell_valid_cell(ref_cell, cell) {
+      RSS(ref_writer_bytes(ref_writer, 1, &flag), "type");
+    }
+  }
+
+  RSS(ref_writer_free(ref_writer), "flush");
+  fprintf(file, "\n</AppendedData>\n");
+  fprintf(file, "</VTKFile>\n");
+
+  ref_free(n2o);
+  ref_free(o2n);
+
+  REIS(0, fclose(file), "close file");
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_export_pvtu(REF_GRID ref_grid, const char *filename) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  FILE *file;
+  char piece[1024];
+  const char *base;
+  size_t end_of_string;
+  REF_INT part;
+
+  end_of_string = strlen(filename);
+  RAS(end_of_string > 5 && 0 == strcmp(&filename[end_of_string - 5], ".pvtu"),
+      "expected .pvtu extension");
+
+  snprintf(piece, 1024, "%.*s_%d.vtu", (int)(end_of_string - 5), filename,
+           ref_mpi_rank(ref_mpi));
+  RSS(ref_export_vtu(ref_grid, piece), "piece");
+
+  if (ref_mpi_once(ref_mpi)) {
+    base = strrchr(filename, '/');
+    base = (NULL == base) ? filename : base + 1;
+    end_of_string = strlen(base);
+
+    file = fopen(filename, "w");
+    if (NULL == (void *)file) printf("unable to open %s\n", filename);
+    RNS(file, "unable to open file");
+
+    fprintf(file, "<?xml version=\"1.0\"?>\n");
+    fprintf(file,
+            "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" "
+            "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n");
+    fprintf(file, "<PUnstructuredGrid GhostLevel=\"1\">\n");
+    fprintf(file, "<PPointData>\n");
+    fprintf(file, "<PDataArray type=\"UInt8\" Name=\"vtkGhostType\"/>\n");
+    fprintf(file, "</PPointData>\n");
+    fprintf(file, "<PCellData>\n");
+    fprintf(file, "<PDataArray type=\"UInt8\" Name=\"vtkGhostType\"/>\n");
+    fprintf(file, "</PCellData>\n");
+    fprintf(file, "<PPoints>\n");
+    fprintf(file, "<PDataArray type=\"Float64\" NumberOfComponents=\"3\"/>\n");
+    fprintf(file, "</PPoints>\n");
+    for (part = 0; part < ref_mpi_n(ref_mpi); part++)
+      fprintf(file, "<Piece Source=\"%.*s_%d.vtu\"/>\n",
+              (int)(end_of_string - 5), base, part);
+    fprintf(file, "</PUnstructuredGrid>\n");
+    fprintf(file, "</VTKFile>\n");
+
+    REIS(0, fclose(file), "close file");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_export_tec_edg_zone(REF_GRID ref_grid,
                                                   FILE *file) {
   REF_NODE ref_node;
@@ -1543,19 +1776,18 @@ REF_FCN static REF_STATUS ref_export_ugrid(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_export_bin_ugrid_int(FILE *file, REF_BOOL swap,
-                                                   REF_BOOL fat,
-                                                   REF_INT output) {
+REF_FCN static REF_STATUS ref_export_bin_ugrid_ints(REF_WRITER ref_writer,
+                                                    REF_BOOL fat, REF_INT n,
+                                                    REF_INT *output) {
+  REF_LONG *longs;
+  REF_INT i;
   if (fat) {
-    REF_LONG actual;
-    actual = (REF_LONG)output;
-    if (swap) SWAP_LONG(actual);
-    REIS(1, fwrite(&actual, sizeof(REF_LONG), 1, file), "output long");
+    ref_malloc(longs, n, REF_LONG);
+    for (i = 0; i < n; i++) longs[i] = (REF_LONG)output[i];
+    RSS(ref_writer_longs(ref_writer, n, longs), "output longs");
+    ref_free(longs);
   } else {
-    REF_INT actual;
-    actual = output;
-    if (swap) SWAP_INT(actual);
-    REIS(1, fwrite(&actual, sizeof(REF_INT), 1, file), "output int");
+    RSS(ref_writer_ints(ref_writer, n, output), "output ints");
   }
   return REF_SUCCESS;
 }
@@ -1566,115 +1798,126 @@ REF_FCN static REF_STATUS ref_export_bin_ugrid(REF_GRID ref_grid,
   FILE *file;
   REF_NODE ref_node;
   REF_CELL ref_cell;
-  REF_INT node;
+  REF_INT node, ixyz;
   REF_INT *o2n, *n2o;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_INT node_per, cell;
-  REF_DBL swapped_dbl;
+  REF_WRITER ref_writer;
   REF_INT group;
   REF_INT faceid, min_faceid, max_faceid;
+  REF_INT sizes[7], *c2n, n;
+  REF_DBL *xyz;
 
   ref_node = ref_grid_node(ref_grid);
 
   file = fopen(filename, "w");
   if (NULL == (void *)file) printf("unable to open %s\n", filename);
   RNS(file, "unable to open file");
+  RSS(ref_writer_create(&ref_writer, file, swap), "writer");
 
-  RSS(ref_export_bin_ugrid_int(file, swap, fat, ref_node_n(ref_node)), "nnode");
-  RSS(ref_export_bin_ugrid_int(file, swap, fat,
-                               ref_cell_n(ref_grid_tri(ref_grid))),
-      "ntri");
-  RSS(ref_export_bin_ugrid_int(file, swap, fat,
-                               ref_cell_n(ref_grid_qua(ref_grid))),
-      "nqua");
-  RSS(ref_export_bin_ugrid_int(file, swap, fat,
-                               ref_cell_n(ref_grid_tet(ref_grid))),
-      "ntet");
-  RSS(ref_export_bin_ugrid_int(file, swap, fat,
-                               ref_cell_n(ref_grid_pyr(ref_grid))),
-      "npyr");
-  RSS(ref_export_bin_ugrid_int(file, swap, fat,
-                               ref_cell_n(ref_grid_pri(ref_grid))),
-      "npri");
-  RSS(ref_export_bin_ugrid_int(file, swap, fat,
-                               ref_cell_n(ref_grid_hex(ref_grid))),
-      "nhex");
+  sizes[0] = ref_node_n(ref_node);
+  sizes[1] = ref_cell_n(ref_grid_tri(ref_grid));
+  sizes[2] = ref_cell_n(ref_grid_qua(ref_grid));
+  sizes[3] = ref_cell_n(ref_grid_tet(ref_grid));
+  sizes[4] = ref_cell_n(ref_grid_pyr(ref_grid));
+  sizes[5] = ref_cell_n(ref_grid_pri(ref_grid));
+  sizes[6] = ref_cell_n(ref_grid_hex(ref_grid));
+  RSS(ref_export_bin_ugrid_ints(ref_writer, fat, 7, sizes), "sizes");
 
   RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
 
+  ref_malloc(xyz, 3 * ref_node_n(ref_node), REF_DBL);
   for (node = 0; node < ref_node_n(ref_node); node++) {
-    swapped_dbl = ref_node_xyz(ref_node, 0, n2o[node]);
-    if (swap) SWAP_DBL(swapped_dbl);
-    REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "x");
-    swapped_dbl = ref_node_xyz(ref_node, 1, n2o[node]);
-    if (swap) SWAP_DBL(swapped_dbl);
-    REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "y");
-    swapped_dbl = ref_node_xyz(ref_node, 2, n2o[node]);
-    if (swap) SWAP_DBL(swapped_dbl);
-    REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "z");
+    for (ixyz = 0; ixyz < 3; ixyz++)
+      xyz[ixyz + 3 * node] = ref_node_xyz(ref_node, ixyz, n2o[node]);
   }
+  RSS(ref_writer_dbls(ref_writer, 3 * ref_node_n(ref_node), xyz), "xyz");
+  ref_free(xyz);
 
   RSS(ref_export_faceid_range(ref_grid, &min_faceid, &max_faceid), "range");
 
   ref_cell = ref_grid_tri(ref_grid);
   node_per = ref_cell_node_per(ref_cell);
+  ref_malloc(c2n, node_per * ref_cell_n(ref_cell), REF_INT);
+  n = 0;
   for (faceid = min_faceid; faceid <= max_faceid; faceid++) {
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       if (nodes[node_per] == faceid) {
         for (node = 0; node < node_per; node++) {
-          nodes[node] = o2n[nodes[node]] + 1;
-          RSS(ref_export_bin_ugrid_int(file, swap, fat, nodes[node]), "c2n");
+          c2n[n] = o2n[nodes[node]] + 1;
+          n++;
         }
       }
     }
   }
+  RSS(ref_export_bin_ugrid_ints(ref_writer, fat, n, c2n), "tri c2n");
+  ref_free(c2n);
 
   ref_cell = ref_grid_qua(ref_grid);
   node_per = ref_cell_node_per(ref_cell);
+  ref_malloc(c2n, node_per * ref_cell_n(ref_cell), REF_INT);
+  n = 0;
   for (faceid = min_faceid; faceid <= max_faceid; faceid++) {
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       if (nodes[node_per] == faceid) {
         for (node = 0; node < node_per; node++) {
-          nodes[node] = o2n[nodes[node]] + 1;
-          RSS(ref_export_bin_ugrid_int(file, swap, fat, nodes[node]), "c2n");
+          c2n[n] = o2n[nodes[node]] + 1;
+          n++;
         }
       }
     }
   }
+  RSS(ref_export_bin_ugrid_ints(ref_writer, fat, n, c2n), "qua c2n");
+  ref_free(c2n);
 
   ref_cell = ref_grid_tri(ref_grid);
   node_per = ref_cell_node_per(ref_cell);
+  ref_malloc(c2n, ref_cell_n(ref_cell), REF_INT);
+  n = 0;
   for (faceid = min_faceid; faceid <= max_faceid; faceid++) {
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       if (nodes[node_per] == faceid) {
-        RSS(ref_export_bin_ugrid_int(file, swap, fat, nodes[3]), "c2n");
+        c2n[n] = nodes[3];
+        n++;
       }
     }
   }
+  RSS(ref_export_bin_ugrid_ints(ref_writer, fat, n, c2n), "tri id");
+  ref_free(c2n);
 
   ref_cell = ref_grid_qua(ref_grid);
   node_per = ref_cell_node_per(ref_cell);
+  ref_malloc(c2n, ref_cell_n(ref_cell), REF_INT);
+  n = 0;
   for (faceid = min_faceid; faceid <= max_faceid; faceid++) {
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       if (nodes[node_per] == faceid) {
-        RSS(ref_export_bin_ugrid_int(file, swap, fat, nodes[4]), "c2n");
+        c2n[n] = nodes[4];
+        n++;
       }
     }
   }
+  RSS(ref_export_bin_ugrid_ints(ref_writer, fat, n, c2n), "qua id");
+  ref_free(c2n);
 
   each_ref_grid_3d_ref_cell(ref_grid, group, ref_cell) {
     node_per = ref_cell_node_per(ref_cell);
+    ref_malloc(c2n, node_per * ref_cell_n(ref_cell), REF_INT);
+    n = 0;
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       for (node = 0; node < node_per; node++) {
-        nodes[node] = o2n[nodes[node]] + 1;
-        RSS(ref_export_bin_ugrid_int(file, swap, fat, nodes[node]), "c2n");
+        c2n[n] = o2n[nodes[node]] + 1;
+        n++;
       }
     }
+    RSS(ref_export_bin_ugrid_ints(ref_writer, fat, n, c2n), "c2n");
+    ref_free(c2n);
   }
 
   ref_free(n2o);
   ref_free(o2n);
 
+  RSS(ref_writer_free(ref_writer), "flush");
   fclose(file);
 
   return REF_SUCCESS;
@@ -1874,14 +2117,16 @@ REF_FCN static REF_STATUS ref_export_html(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
-REF_FCN REF_STATUS ref_export_meshb_next_position(FILE *file, REF_INT version,
+REF_FCN REF_STATUS ref_export_meshb_next_position(REF_WRITER ref_writer,
+                                                  REF_INT version,
                                                   REF_FILEPOS next_position) {
   int32_t one_word;
   int64_t two_word;
 
   if (3 <= version) {
     two_word = (int64_t)next_position;
-    REIS(1, fwrite(&two_word, sizeof(two_word), 1, file), "write next pos");
+    RSS(ref_writer_bytes(ref_writer, sizeof(two_word), &two_word),
+        "write next pos");
   } else {
     if (next_position < -2147483647 || 2147483647 < next_position) {
       printf("next_position %ld outside int32 limits %d %d\n",
@@ -1889,22 +2134,19 @@ REF_FCN REF_STATUS ref_export_meshb_next_position(FILE *file, REF_INT version,
       RSS(REF_INVALID, "meshb version does not support file size");
     }
     one_word = (int32_t)next_position;
-    REIS(1, fwrite(&one_word, sizeof(one_word), 1, file), "write next pos");
+    RSS(ref_writer_bytes(ref_writer, sizeof(one_word), &one_word),
+        "write next pos");
   }
 
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_export_meshb_int(FILE *file, REF_INT version,
-                                               REF_INT value) {
-  int int_value;
-  long long_value;
+REF_FCN static REF_STATUS ref_export_meshb_int(REF_WRITER ref_writer,
+                                               REF_INT version, REF_INT value) {
   if (version < 4) {
-    int_value = (int)value;
-    REIS(1, fwrite(&int_value, sizeof(int), 1, file), "int value");
+    RSS(ref_writer_int(ref_writer, value), "int value");
   } else {
-    long_value = (long)value;
-    REIS(1, fwrite(&long_value, sizeof(long), 1, file), "long value");
+    RSS(ref_writer_long(ref_writer, (REF_LONG)value), "long value");
   }
   return REF_SUCCESS;
 }
@@ -1917,7 +2159,8 @@ REF_FCN static REF_STATUS ref_export_meshb(REF_GRID ref_grid,
   REF_CELL ref_cell;
   REF_INT *o2n, *n2o;
   REF_INT code, version, dim;
-  REF_FILEPOS next_position;
+  REF_FILEPOS next_position, position;
+  REF_WRITER ref_writer;
   REF_INT keyword_code, header_size, int_size, fp_size;
   REF_INT node;
   REF_INT group, node_per, cell;
@@ -1947,58 +2190,59 @@ REF_FCN static REF_STATUS ref_export_meshb(REF_GRID ref_grid,
   file = fopen(filename, "w");
   if (NULL == (void *)file) printf("unable to open %s\n", filename);
   RNS(file, "unable to open file");
+  RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
 
   RSS(ref_node_compact(ref_node, &o2n, &n2o), "compact");
 
   code = 1;
-  REIS(1, fwrite(&code, sizeof(int), 1, file), "code");
-  REIS(1, fwrite(&version, sizeof(int), 1, file), "version");
-  next_position = (REF_FILEPOS)(4 + fp_size + 4) + ftell(file);
+  RSS(ref_writer_int(ref_writer, code), "code");
+  RSS(ref_writer_int(ref_writer, version), "version");
+  RSS(ref_writer_tell(ref_writer, &position), "tell");
+  next_position = (REF_FILEPOS)(4 + fp_size + 4) + position;
   keyword_code = 3;
-  REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-  RSS(ref_export_meshb_next_position(file, version, next_position), "next pos");
-  REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
-  REIS(next_position, ftell(file), "dim inconsistent");
+  RSS(ref_writer_int(ref_writer, keyword_code), "dim code");
+  RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+      "next pos");
+  RSS(ref_writer_int(ref_writer, dim), "dim");
+  RSS(ref_writer_tell(ref_writer, &position), "tell");
+  REIS(next_position, position, "dim inconsistent");
 
   if (ref_node_n(ref_node) > 0) {
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
     next_position =
         (REF_FILEPOS)header_size +
         (REF_FILEPOS)ref_node_n(ref_node) * (REF_FILEPOS)(dim * 8 + int_size) +
-        ftell(file);
+        position;
     keyword_code = 4;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    RSS(ref_export_meshb_int(file, version, ref_node_n(ref_node)), "nnode");
+    RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_export_meshb_int(ref_writer, version, ref_node_n(ref_node)),
+        "nnode");
     for (node = 0; node < ref_node_n(ref_node); node++) {
-      REIS(1,
-           fwrite(&(ref_node_xyz(ref_node, 0, n2o[node])), sizeof(double), 1,
-                  file),
-           "x");
-      REIS(1,
-           fwrite(&(ref_node_xyz(ref_node, 1, n2o[node])), sizeof(double), 1,
-                  file),
-           "y");
-      if (!ref_grid_twod(ref_grid))
-        REIS(1,
-             fwrite(&(ref_node_xyz(ref_node, 2, n2o[node])), sizeof(double), 1,
-                    file),
-             "z");
-      RSS(ref_export_meshb_int(file, version, REF_EXPORT_MESHB_VERTEX_ID),
+      RSS(ref_writer_dbls(ref_writer, dim,
+                          ref_node_xyz_ptr(ref_node, n2o[node])),
+          "xyz");
+      RSS(ref_export_meshb_int(ref_writer, version, REF_EXPORT_MESHB_VERTEX_ID),
           "nnode");
     }
-    REIS(next_position, ftell(file), "vertex inconsistent");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "vertex inconsistent");
   }
 
   each_ref_grid_all_ref_cell(ref_grid, group, ref_cell) {
     if (ref_cell_n(ref_cell) > 0) {
       RSS(ref_cell_meshb_keyword(ref_cell, &keyword_code), "kw");
       node_per = ref_cell_node_per(ref_cell);
-      next_position = ftell(file) + (REF_FILEPOS)header_size +
+      RSS(ref_writer_tell(ref_writer, &position), "tell");
+      next_position = position + (REF_FILEPOS)header_size +
                       (REF_FILEPOS)ref_cell_n(ref_cell) *
                           (REF_FILEPOS)(int_size * (node_per + 1));
-      REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword code");
-      RSS(ref_export_meshb_next_position(file, version, next_position), "next");
-      RSS(ref_export_meshb_int(file, version, ref_cell_n(ref_cell)), "ncell");
+      RSS(ref_writer_int(ref_writer, keyword_code), "keyword code");
+      RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+          "next");
+      RSS(ref_export_meshb_int(ref_writer, version, ref_cell_n(ref_cell)),
+          "ncell");
       each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
         for (node = 0; node < node_per; node++) {
           nodes[node] = o2n[nodes[node]] + 1;
@@ -2020,10 +2264,11 @@ REF_FCN static REF_STATUS ref_export_meshb(REF_GRID ref_grid,
         if (!ref_cell_last_node_is_an_id(ref_cell))
           nodes[node_per] = REF_EXPORT_MESHB_3D_ID;
         for (node = 0; node < (1 + node_per); node++) {
-          RSS(ref_export_meshb_int(file, version, nodes[node]), "c2n");
+          RSS(ref_export_meshb_int(ref_writer, version, nodes[node]), "c2n");
         }
       }
-      REIS(next_position, ftell(file), "cell inconsistent");
+      RSS(ref_writer_tell(ref_writer, &position), "tell");
+      REIS(next_position, position, "cell inconsistent");
     }
   }
 
@@ -2032,56 +2277,62 @@ REF_FCN static REF_STATUS ref_export_meshb(REF_GRID ref_grid,
     each_ref_geom_of(ref_geom, type, geom) ngeom++;
     if (ngeom > 0) {
       keyword_code = 40 + type; /* GmfVerticesOnGeometricVertices */
+      RSS(ref_writer_tell(ref_writer, &position), "tell");
       next_position =
-          ftell(file) + (REF_FILEPOS)header_size +
+          position + (REF_FILEPOS)header_size +
           (REF_FILEPOS)ngeom *
               (REF_FILEPOS)(int_size * 2 + 8 * type + (0 < type ? 8 : 0));
-      REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword");
-      RSS(ref_export_meshb_next_position(file, version, next_position), "next");
-      RSS(ref_export_meshb_int(file, version, ngeom), "ngeom");
+      RSS(ref_writer_int(ref_writer, keyword_code), "keyword");
+      RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+          "next");
+      RSS(ref_export_meshb_int(ref_writer, version, ngeom), "ngeom");
       each_ref_geom_of(ref_geom, type, geom) {
         node = o2n[ref_geom_node(ref_geom, geom)] + 1;
         id = ref_geom_id(ref_geom, geom);
-        RSS(ref_export_meshb_int(file, version, node), "node");
-        RSS(ref_export_meshb_int(file, version, id), "id");
+        RSS(ref_export_meshb_int(ref_writer, version, node), "node");
+        RSS(ref_export_meshb_int(ref_writer, version, id), "id");
         for (i = 0; i < type; i++)
-          REIS(1,
-               fwrite(&(ref_geom_param(ref_geom, i, geom)), sizeof(double), 1,
-                      file),
-               "id");
+          RSS(ref_writer_dbl(ref_writer, ref_geom_param(ref_geom, i, geom)),
+              "id");
         if (0 < type) {
           double double_gref = (double)ref_geom_gref(ref_geom, geom);
-          REIS(1, fwrite(&(double_gref), sizeof(double), 1, file), "gref");
+          RSS(ref_writer_dbl(ref_writer, double_gref), "gref");
         }
       }
-      REIS(next_position, ftell(file), "geom inconsistent");
+      RSS(ref_writer_tell(ref_writer, &position), "tell");
+      REIS(next_position, position, "geom inconsistent");
     }
   }
 
   if (0 < ref_geom_cad_data_size(ref_geom)) {
     keyword_code = 126; /* GmfByteFlow 173-47 */
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
     next_position = (REF_FILEPOS)header_size +
-                    (REF_FILEPOS)ref_geom_cad_data_size(ref_geom) + ftell(file);
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+                    (REF_FILEPOS)ref_geom_cad_data_size(ref_geom) + position;
+    RSS(ref_writer_int(ref_writer, keyword_code), "keyword");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
     size_bytes = (REF_INT)ref_geom_cad_data_size(ref_geom);
-    RSS(ref_export_meshb_int(file, version, size_bytes), "size in bytes");
-    REIS(ref_geom_cad_data_size(ref_geom),
-         fwrite(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
-                ref_geom_cad_data_size(ref_geom), file),
-         "node");
-    REIS(next_position, ftell(file), "cad_model inconsistent");
+    RSS(ref_export_meshb_int(ref_writer, version, size_bytes),
+        "size in bytes");
+    RSS(ref_writer_bytes(ref_writer, ref_geom_cad_data_size(ref_geom),
+                         ref_geom_cad_data(ref_geom)),
+        "node");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "cad_model inconsistent");
   }
 
   /* End */
   keyword_code = 54; /* GmfEnd 101-47 */
-  REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
+  RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
   next_position = 0;
-  RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+  RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+      "next p");
 
   ref_free(n2o);
   ref_free(o2n);
 
+  RSS(ref_writer_free(ref_writer), "flush");
   fclose(file);
 
   return REF_SUCCESS;
@@ -2718,6 +2969,11 @@ REF_FCN REF_STATUS ref_export_by_extension(REF_GRID ref_grid,
 
   if (strcmp(&filename[end_of_string - 4], ".vtk") == 0) {
     RSS(ref_export_vtk(ref_grid, filename), "vtk export failed");
+  } else if (strcmp(&filename[end_of_string - 4], ".vtu") == 0) {
+    RSS(ref_export_vtu(ref_grid, filename), "vtu export failed");
+  } else if (end_of_string > 5 &&
+             strcmp(&filename[end_of_string - 5], ".pvtu") == 0) {
+    RSS(ref_export_pvtu(ref_grid, filename), "pvtu export failed");
   } else if (strcmp(&filename[end_of_string - 2], ".c") == 0) {
     RSS(ref_export_c(ref_grid, filename), "C export failed");
   } else if (strcmp(&filename[end_of_string - 4], ".tec") == 0) {
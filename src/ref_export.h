@@ -32,6 +32,7 @@ BEGIN_C_DECLORATION
 END_C_DECLORATION
 
 #include "ref_grid.h"
+#include "ref_writer.h"
 
 BEGIN_C_DECLORATION
 
@@ -40,12 +41,16 @@ REF_FCN REF_STATUS ref_export_tec_surf(REF_GRID ref_grid, const char *filename);
 REF_FCN REF_STATUS ref_export_tec_metric_ellipse(REF_GRID ref_grid,
                                                  const char *root_filename);
 
-REF_FCN REF_STATUS ref_export_meshb_next_position(FILE *file, REF_INT version,
+REF_FCN REF_STATUS ref_export_meshb_next_position(REF_WRITER ref_writer,
+                                                  REF_INT version,
                                                   REF_FILEPOS next_position);
 
 REF_FCN REF_STATUS ref_export_order_segments(REF_INT n, REF_INT *c2n,
                                              REF_INT *order);
 
+/* each rank writes its partition to name_<rank>.vtu, rank 0 the master */
+REF_FCN REF_STATUS ref_export_pvtu(REF_GRID ref_grid, const char *filename);
+
 REF_FCN REF_STATUS ref_export_by_extension(REF_GRID ref_grid,
                                            const char *filename);
 
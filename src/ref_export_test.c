@@ -29,6 +29,7 @@
 #include "ref_dict.h"
 #include "ref_edge.h"
 #include "ref_fixture.h"
+#include "ref_gather.h"
 #include "ref_geom.h"
 #include "ref_grid.h"
 #include "ref_import.h"
@@ -59,6 +60,46 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
+  if (3 == argc && 0 == strcmp("--benchmark", argv[1])) {
+    REF_GRID ref_grid;
+    REF_INT n = atoi(argv[2]);
+    const char *files[] = {"ref_export_test_benchmark.lb8.ugrid",
+                           "ref_export_test_benchmark.b8.ugrid",
+                           "ref_export_test_benchmark.meshb"};
+    REF_INT i, gather;
+    FILE *file;
+    REF_FILEPOS bytes;
+    REF_DBL seconds;
+    RSS(ref_fixture_tet_brick_args_grid(&ref_grid, ref_mpi, 0, 1, 0, 1, 0, 1,
+                                        n, n, n),
+        "brick");
+    for (gather = 0; gather < 2; gather++) {
+      for (i = 0; i < 3; i++) {
+        RSS(ref_mpi_stopwatch_start(ref_mpi), "start");
+        if (gather) {
+          RSS(ref_gather_by_extension(ref_grid, files[i]), "gather");
+        } else {
+          RSS(ref_export_by_extension(ref_grid, files[i]), "export");
+        }
+        RSS(ref_mpi_stopwatch_delta(ref_mpi, &seconds), "delta");
+        file = fopen(files[i], "r");
+        RNS(file, "unable to open file");
+        REIS(0, fseeko(file, 0, SEEK_END), "seek end");
+        bytes = ftello(file);
+        fclose(file);
+        printf("%s %s %d nodes %.3f GB %.3f s %.3f GB/s\n",
+               gather ? "gather" : "export", files[i],
+               ref_node_n(ref_grid_node(ref_grid)), 1.0e-9 * (REF_DBL)bytes,
+               seconds, 1.0e-9 * (REF_DBL)bytes / MAX(seconds, 1.0e-9));
+        REIS(0, remove(files[i]), "test clean up");
+      }
+    }
+    RSS(ref_grid_free(ref_grid), "free");
+    RSS(ref_mpi_free(ref_mpi), "free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   { /* export .vtk tet */
     REF_GRID ref_grid;
     char file[] = "ref_export_test.vtk";
@@ -68,6 +109,26 @@ int main(int argc, char *argv[]) {
     REIS(0, remove(file), "test clean up");
   }
 
+  { /* export .vtu tet */
+    REF_GRID ref_grid;
+    char file[] = "ref_export_test.vtu";
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "set up tet");
+    RSS(ref_export_by_extension(ref_grid, file), "export");
+    RSS(ref_grid_free(ref_grid), "free");
+    REIS(0, remove(file), "test clean up");
+  }
+
+  { /* export .pvtu pri, one piece */
+    REF_GRID ref_grid;
+    char file[] = "ref_export_test.pvtu";
+    char piece[] = "ref_export_test_0.vtu";
+    RSS(ref_fixture_pri_grid(&ref_grid, ref_mpi), "set up pri");
+    RSS(ref_export_by_extension(ref_grid, file), "export");
+    RSS(ref_grid_free(ref_grid), "free");
+    REIS(0, remove(piece), "test clean up");
+    REIS(0, remove(file), "test clean up");
+  }
+
   { /* export .tec tet */
     REF_GRID ref_grid;
     char file[] = "ref_export_test.tec";
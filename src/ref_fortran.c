@@ -153,7 +153,7 @@ REF_STATUS REF_FORT_(ref_fortran_adapt, REF_FORTRAN_ADAPT)(void) {
     RSS(ref_validation_cell_volume(ref_grid), "vol");
     RSS(ref_histogram_ratio(ref_grid), "gram");
     RSS(ref_node_synchronize_globals(ref_grid_node(ref_grid)), "sync g");
-    RSS(ref_migrate_to_balance(ref_grid), "balance");
+    RSS(ref_migrate_to_rebalance(ref_grid), "balance");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "balance");
   }
 
@@ -27,9 +27,9 @@
 
 #include "ref_edge.h"
 #include "ref_egads.h"
-#include "ref_endian.h"
 #include "ref_export.h"
 #include "ref_histogram.h"
+#include "ref_import.h"
 #include "ref_malloc.h"
 #include "ref_matrix.h"
 #include "ref_mpi.h"
@@ -50,6 +50,8 @@ REF_FCN REF_STATUS ref_gather_create(REF_GATHER *ref_gather_ptr) {
   ref_gather->low_quality_zone = REF_FALSE;
   ref_gather->min_quality = 0.1;
 
+  ref_gather->async = NULL;
+
   return REF_SUCCESS;
 }
 
@@ -61,6 +63,30 @@ REF_FCN REF_STATUS ref_gather_free(REF_GATHER ref_gather) {
   return REF_SUCCESS;
 }
 
+REF_FCN static REF_STATUS ref_gather_open(REF_GRID ref_grid,
+                                         const char *filename, FILE **file) {
+  REF_ASYNC ref_async = ref_gather_async(ref_grid_gather(ref_grid));
+  if (NULL != (void *)ref_async) {
+    RSS(ref_async_open(ref_async, file), "stage");
+    return REF_SUCCESS;
+  }
+  *file = fopen(filename, "w");
+  if (NULL == (void *)(*file)) printf("unable to open %s\n", filename);
+  RNS(*file, "unable to open file");
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_gather_close(REF_GRID ref_grid,
+                                          const char *filename, FILE *file) {
+  REF_ASYNC ref_async = ref_gather_async(ref_grid_gather(ref_grid));
+  if (NULL != (void *)ref_async) {
+    RSS(ref_async_close(ref_async, file, filename), "queue");
+    return REF_SUCCESS;
+  }
+  REIS(0, fclose(file), "close file");
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_gather_tec_movie_record_button(REF_GATHER ref_gather,
                                                       REF_BOOL on_or_off) {
   ref_gather->recording = on_or_off;
@@ -235,10 +261,11 @@ REF_FCN static REF_STATUS ref_gather_node_tec_part(REF_NODE ref_node,
 
 REF_FCN static REF_STATUS ref_gather_node_tec_block(
     REF_NODE ref_node, REF_GLOB nnode, REF_GLOB *l2c, REF_INT ldim,
-    REF_DBL *scalar, int dataformat, FILE *file) {
+    REF_DBL *scalar, int dataformat, REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
+  float *single_float;
   REF_GLOB nnode_written, first, global;
   REF_INT local, n, i, ivar;
   REF_STATUS status;
@@ -310,16 +337,14 @@ REF_FCN static REF_STATUS ref_gather_node_tec_block(
       if (ref_mpi_once(ref_mpi)) {
         switch (dataformat) {
           case 1:
-            for (i = 0; i < n; i++) {
-              float single_float;
-              single_float = (float)xyzm[i];
-              REIS(1, fwrite(&single_float, sizeof(float), 1, file),
-                   "single float");
-            }
+            ref_malloc(single_float, n, float);
+            for (i = 0; i < n; i++) single_float[i] = (float)xyzm[i];
+            RSS(ref_writer_floats(ref_writer, n, single_float),
+                "single float");
+            ref_free(single_float);
             break;
           case 2:
-            REIS(n, fwrite(xyzm, sizeof(double), (unsigned long)n, file),
-                 "block chunk");
+            RSS(ref_writer_dbls(ref_writer, n, xyzm), "block chunk");
             break;
           default:
             return REF_IMPLEMENT;
@@ -337,18 +362,19 @@ REF_FCN static REF_STATUS ref_gather_node_tec_block(
   return REF_SUCCESS;
 }
 
+/* binary zero-based ints to ref_writer when present, else ASCII to file */
 REF_FCN static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node,
                                               REF_CELL ref_cell,
                                               REF_LONG ncell_expected,
-                                              REF_GLOB *l2c, REF_BOOL binary,
-                                              FILE *file) {
+                                              REF_GLOB *l2c, FILE *file,
+                                              REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT cell, node;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_GLOB globals[REF_CELL_MAX_SIZE_PER];
   REF_INT node_per = ref_cell_node_per(ref_cell);
   REF_GLOB *c2n;
-  REF_INT *int_c2n;
+  REF_INT *int_c2n = NULL;
   REF_INT proc, part, ncell;
   REF_LONG ncell_actual;
 
@@ -358,18 +384,18 @@ REF_FCN static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node,
     ref_mpi_stopwatch_stop(ref_mpi, "tet cell start");
 
   if (ref_mpi_once(ref_mpi)) {
+    if (NULL != (void *)ref_writer)
+      ref_malloc(int_c2n, node_per * ref_cell_n(ref_cell), REF_INT);
+    ncell = 0;
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
       if (ref_mpi_rank(ref_mpi) == part) {
         for (node = 0; node < node_per; node++) {
           globals[node] = l2c[nodes[node]];
         }
-        if (binary) {
-          for (node = 0; node < node_per; node++) {
-            int int_node;
-            int_node = (int)globals[node]; /* binary zero-based */
-            REIS(1, fwrite(&int_node, sizeof(int), 1, file), "int c2n");
-          }
+        if (NULL != (void *)ref_writer) {
+          for (node = 0; node < node_per; node++) /* binary zero-based */
+            int_c2n[node + node_per * ncell] = (REF_INT)globals[node];
         } else {
           for (node = 0; node < node_per; node++) {
             globals[node]++; /* ascii one-based */
@@ -377,9 +403,14 @@ REF_FCN static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node,
           }
           fprintf(file, "\n");
         }
-        ncell_actual++;
+        ncell++;
       }
     }
+    if (NULL != (void *)ref_writer) {
+      RSS(ref_writer_ints(ref_writer, node_per * ncell, int_c2n), "int c2n");
+      ref_free(int_c2n);
+    }
+    ncell_actual += ncell;
   }
 
   if (1 < ref_mpi_timing(ref_mpi))
@@ -395,13 +426,12 @@ REF_FCN static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node,
                               proc),
           "recv c2n");
 
-      if (binary) { /* binary 0-based int, ASCII 1-based */
+      /* binary 0-based int, ASCII 1-based */
+      if (NULL != (void *)ref_writer) {
         for (cell = 0; cell < ncell * node_per; cell++) {
           int_c2n[cell] = (REF_INT)c2n[cell];
         }
-        REIS(ncell * node_per,
-             fwrite(int_c2n, sizeof(int), (size_t)(ncell * node_per), file),
-             "int c2n");
+        RSS(ref_writer_ints(ref_writer, ncell * node_per, int_c2n), "int c2n");
       } else {
         for (cell = 0; cell < ncell * node_per; cell++) {
           c2n[cell]++;
@@ -502,8 +532,8 @@ REF_FCN static REF_STATUS ref_gather_cell_tec(REF_NODE ref_node,
 REF_FCN static REF_STATUS ref_gather_brick_tec(REF_NODE ref_node,
                                                REF_CELL ref_cell,
                                                REF_LONG ncell_expected,
-                                               REF_GLOB *l2c, REF_BOOL binary,
-                                               FILE *file) {
+                                               REF_GLOB *l2c,
+                                               REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT cell, node;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
@@ -511,12 +541,15 @@ REF_FCN static REF_STATUS ref_gather_brick_tec(REF_NODE ref_node,
   REF_GLOB globals[REF_CELL_MAX_SIZE_PER];
   REF_INT node_per = ref_cell_node_per(ref_cell);
   REF_GLOB *c2n;
+  REF_INT *int_c2n;
   REF_INT proc, part, ncell;
   REF_LONG ncell_actual;
 
   ncell_actual = 0;
 
   if (ref_mpi_once(ref_mpi)) {
+    ref_malloc(int_c2n, 8 * ref_cell_n(ref_cell), REF_INT);
+    ncell = 0;
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
       if (ref_mpi_rank(ref_mpi) == part) {
@@ -540,22 +573,14 @@ REF_FCN static REF_STATUS ref_gather_brick_tec(REF_NODE ref_node,
             RSS(REF_IMPLEMENT, "wrong nodes per cell");
             break;
         }
-        if (binary) {
-          for (node = 0; node < 8; node++) {
-            int int_node;
-            int_node = (int)brick[node]; /* binary zero-based */
-            REIS(1, fwrite(&int_node, sizeof(int), 1, file), "int c2n");
-          }
-        } else {
-          for (node = 0; node < 8; node++) {
-            brick[node]++; /* ascii one-based */
-            fprintf(file, " " REF_GLOB_FMT, brick[node]);
-          }
-          fprintf(file, "\n");
-        }
-        ncell_actual++;
+        for (node = 0; node < 8; node++) /* binary zero-based */
+          int_c2n[node + 8 * ncell] = (REF_INT)brick[node];
+        ncell++;
       }
     }
+    RSS(ref_writer_ints(ref_writer, 8 * ncell, int_c2n), "int c2n");
+    ref_free(int_c2n);
+    ncell_actual += ncell;
   }
 
   if (ref_mpi_once(ref_mpi)) {
@@ -563,6 +588,7 @@ REF_FCN static REF_STATUS ref_gather_brick_tec(REF_NODE ref_node,
       RSS(ref_mpi_gather_recv(ref_mpi, &ncell, 1, REF_INT_TYPE, proc),
           "recv ncell");
       ref_malloc(c2n, ncell * node_per, REF_GLOB);
+      ref_malloc(int_c2n, 8 * ncell, REF_INT);
       RSS(ref_mpi_gather_recv(ref_mpi, c2n, ncell * node_per, REF_GLOB_TYPE,
                               proc),
           "recv c2n");
@@ -584,21 +610,12 @@ REF_FCN static REF_STATUS ref_gather_brick_tec(REF_NODE ref_node,
             RSS(REF_IMPLEMENT, "wrong nodes per cell");
             break;
         }
-        if (binary) {
-          for (node = 0; node < 8; node++) {
-            int int_node;
-            int_node = (int)brick[node]; /* binary zero-based */
-            REIS(1, fwrite(&int_node, sizeof(int), 1, file), "int c2n");
-          }
-        } else {
-          for (node = 0; node < 8; node++) {
-            brick[node]++; /* ascii one-based */
-            fprintf(file, " " REF_GLOB_FMT, brick[node]);
-          }
-          fprintf(file, "\n");
-        }
+        for (node = 0; node < 8; node++) /* binary zero-based */
+          int_c2n[node + 8 * cell] = (REF_INT)brick[node];
         ncell_actual++;
       }
+      RSS(ref_writer_ints(ref_writer, 8 * ncell, int_c2n), "int c2n");
+      ref_free(int_c2n);
       ref_free(c2n);
     }
   } else {
@@ -633,20 +650,24 @@ REF_FCN static REF_STATUS ref_gather_brick_tec(REF_NODE ref_node,
 
 REF_FCN static REF_STATUS ref_gather_cell_id_tec(
     REF_NODE ref_node, REF_CELL ref_cell, REF_INT cell_id,
-    REF_LONG ncell_expected, REF_GLOB *l2c, REF_BOOL binary, FILE *file) {
+    REF_LONG ncell_expected, REF_GLOB *l2c, FILE *file,
+    REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT cell, node;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
   REF_GLOB globals[REF_CELL_MAX_SIZE_PER];
   REF_INT node_per = ref_cell_node_per(ref_cell);
   REF_GLOB *c2n;
-  REF_INT *int_c2n;
+  REF_INT *int_c2n = NULL;
   REF_INT proc, part, ncell;
   REF_LONG ncell_actual;
 
   ncell_actual = 0;
 
   if (ref_mpi_once(ref_mpi)) {
+    if (NULL != (void *)ref_writer)
+      ref_malloc(int_c2n, node_per * ref_cell_n(ref_cell), REF_INT);
+    ncell = 0;
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
       if (cell_id == nodes[ref_cell_id_index(ref_cell)]) {
         RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
@@ -654,12 +675,9 @@ REF_FCN static REF_STATUS ref_gather_cell_id_tec(
           for (node = 0; node < node_per; node++) {
             globals[node] = l2c[nodes[node]];
           }
-          if (binary) {
-            for (node = 0; node < node_per; node++) {
-              int int_node;
-              int_node = (int)globals[node]; /* binary zero-based */
-              REIS(1, fwrite(&int_node, sizeof(int), 1, file), "int c2n");
-            }
+          if (NULL != (void *)ref_writer) {
+            for (node = 0; node < node_per; node++) /* binary zero-based */
+              int_c2n[node + node_per * ncell] = (REF_INT)globals[node];
           } else {
             for (node = 0; node < node_per; node++) {
               globals[node]++; /* ascii one-based */
@@ -667,10 +685,15 @@ REF_FCN static REF_STATUS ref_gather_cell_id_tec(
             }
             fprintf(file, "\n");
           }
-          ncell_actual++;
+          ncell++;
         }
       }
     }
+    if (NULL != (void *)ref_writer) {
+      RSS(ref_writer_ints(ref_writer, node_per * ncell, int_c2n), "int c2n");
+      ref_free(int_c2n);
+    }
+    ncell_actual += ncell;
   }
 
   if (ref_mpi_once(ref_mpi)) {
@@ -683,13 +706,12 @@ REF_FCN static REF_STATUS ref_gather_cell_id_tec(
                               proc),
           "recv c2n");
 
-      if (binary) { /* binary 0-based int, ASCII 1-based */
+      /* binary 0-based int, ASCII 1-based */
+      if (NULL != (void *)ref_writer) {
         for (cell = 0; cell < ncell * node_per; cell++) {
           int_c2n[cell] = (REF_INT)c2n[cell];
         }
-        REIS(ncell * node_per,
-             fwrite(int_c2n, sizeof(int), (size_t)(ncell * node_per), file),
-             "int c2n");
+        RSS(ref_writer_ints(ref_writer, ncell * node_per, int_c2n), "int c2n");
       } else {
         for (cell = 0; cell < ncell * node_per; cell++) {
           c2n[cell]++;
@@ -977,8 +999,8 @@ REF_FCN REF_STATUS ref_gather_tec_movie_frame(REF_GRID ref_grid,
   RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar,
                                ref_gather->grid_file),
       "nodes");
-  RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_FALSE,
-                          ref_gather->grid_file),
+  RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, ref_gather->grid_file,
+                          NULL),
       "t");
   ref_free(l2c);
 
@@ -1043,9 +1065,7 @@ REF_FCN REF_STATUS ref_gather_tec_part(REF_GRID ref_grid,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
 
     fprintf(file, "title=\"tecplot refine partition file\"\n");
     fprintf(file, "variables = \"x\" \"y\" \"z\" \"p\" \"a\"\n");
@@ -1063,10 +1083,11 @@ REF_FCN REF_STATUS ref_gather_tec_part(REF_GRID ref_grid,
   }
 
   RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, 2, scalar, file), "nodes");
-  RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_FALSE, file),
+  RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, file, NULL),
       "nodes");
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   ref_free(scalar);
   ref_free(l2c);
@@ -1086,9 +1107,7 @@ REF_FCN static REF_STATUS ref_gather_tec(REF_GRID ref_grid,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
 
     fprintf(file, "title=\"geometry\"\n");
     fprintf(file, "variables = \"x\" \"y\" \"z\"\n");
@@ -1106,7 +1125,7 @@ REF_FCN static REF_STATUS ref_gather_tec(REF_GRID ref_grid,
               nnode, ncell, "point", "felineseg");
     }
     RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, 0, NULL, file), "nodes");
-    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_FALSE, file),
+    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, file, NULL),
         "nodes");
   }
   ref_free(l2c);
@@ -1123,7 +1142,7 @@ REF_FCN static REF_STATUS ref_gather_tec(REF_GRID ref_grid,
               nnode, ncell, "point", "fetriangle");
     }
     RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, 0, NULL, file), "nodes");
-    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_FALSE, file),
+    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, file, NULL),
         "nodes");
   }
   ref_free(l2c);
@@ -1140,63 +1159,53 @@ REF_FCN static REF_STATUS ref_gather_tec(REF_GRID ref_grid,
               nnode, ncell, "point", "fetetrahedron");
     }
     RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, 0, NULL, file), "nodes");
-    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_FALSE, file),
+    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, file, NULL),
         "nodes");
   }
   ref_free(l2c);
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_gather_meshb_size(FILE *file, REF_INT version,
+REF_FCN static REF_STATUS ref_gather_meshb_size(REF_WRITER ref_writer,
+                                                REF_INT version,
                                                 REF_SIZE value) {
-  unsigned int int_value;
-  unsigned long long_value;
   if (version < 4) {
-    int_value = (unsigned int)value;
-    REIS(1, fwrite(&int_value, sizeof(unsigned int), 1, file), "int value");
+    RSS(ref_writer_int(ref_writer, (REF_INT)value), "int value");
   } else {
-    long_value = value;
-    REIS(1, fwrite(&long_value, sizeof(unsigned long), 1, file), "long value");
+    RSS(ref_writer_long(ref_writer, (REF_LONG)value), "long value");
   }
   return REF_SUCCESS;
 }
-REF_FCN static REF_STATUS ref_gather_meshb_glob(FILE *file, REF_INT version,
+REF_FCN static REF_STATUS ref_gather_meshb_glob(REF_WRITER ref_writer,
+                                                REF_INT version,
                                                 REF_GLOB value) {
-  int int_value;
-  long long_value;
   if (version < 4) {
-    int_value = (int)value;
-    REIS(1, fwrite(&int_value, sizeof(int), 1, file), "int value");
+    RSS(ref_writer_int(ref_writer, (REF_INT)value), "int value");
   } else {
-    long_value = (long)value;
-    REIS(1, fwrite(&long_value, sizeof(long), 1, file), "long value");
+    RSS(ref_writer_long(ref_writer, (REF_LONG)value), "long value");
   }
   return REF_SUCCESS;
 }
-REF_FCN static REF_STATUS ref_gather_meshb_int(FILE *file, REF_INT version,
-                                               REF_INT value) {
-  int int_value;
-  long long_value;
+REF_FCN static REF_STATUS ref_gather_meshb_int(REF_WRITER ref_writer,
+                                               REF_INT version, REF_INT value) {
   if (version < 4) {
-    int_value = (int)value;
-    REIS(1, fwrite(&int_value, sizeof(int), 1, file), "int value");
+    RSS(ref_writer_int(ref_writer, value), "int value");
   } else {
-    long_value = (long)value;
-    REIS(1, fwrite(&long_value, sizeof(long), 1, file), "long value");
+    RSS(ref_writer_long(ref_writer, (REF_LONG)value), "long value");
   }
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_gather_node(REF_NODE ref_node,
-                                          REF_BOOL swap_endian, REF_INT version,
-                                          REF_BOOL twod, FILE *file) {
+REF_FCN static REF_STATUS ref_gather_node(REF_NODE ref_node, REF_INT version,
+                                          REF_BOOL twod,
+                                          REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_DBL *local_xyzm, *xyzm;
-  REF_DBL swapped_dbl;
   REF_GLOB nnode_written, first, global;
   REF_INT n, i;
   REF_INT local;
@@ -1247,19 +1256,11 @@ REF_FCN static REF_STATUS ref_gather_node(REF_NODE ref_node,
                  xyzm[3 + 4 * i]);
           node_not_used_once = REF_TRUE;
         }
-        swapped_dbl = xyzm[0 + 4 * i];
-        if (swap_endian) SWAP_DBL(swapped_dbl);
-        REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "x");
-        swapped_dbl = xyzm[1 + 4 * i];
-        if (swap_endian) SWAP_DBL(swapped_dbl);
-        REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "y");
-        if (!twod) {
-          swapped_dbl = xyzm[2 + 4 * i];
-          if (swap_endian) SWAP_DBL(swapped_dbl);
-          REIS(1, fwrite(&swapped_dbl, sizeof(REF_DBL), 1, file), "z");
-        }
+        RSS(ref_writer_dbls(ref_writer, (twod ? 2 : 3), &(xyzm[4 * i])),
+            "xyz");
         if (1 <= version && version <= 4)
-          RSS(ref_gather_meshb_int(file, version, REF_EXPORT_MESHB_VERTEX_ID),
+          RSS(ref_gather_meshb_int(ref_writer, version,
+                                   REF_EXPORT_MESHB_VERTEX_ID),
               "nnode");
       }
   }
@@ -1406,7 +1407,8 @@ REF_FCN static REF_STATUS ref_gather_node_metric_solb(REF_GRID ref_grid,
   REF_GLOB global, nnode_written, first;
   REF_INT local, n, i, im;
   REF_STATUS status;
-  REF_FILEPOS next_position = 0;
+  REF_WRITER ref_writer = NULL;
+  REF_FILEPOS next_position = 0, position = 0;
   REF_INT keyword_code, header_size;
   REF_INT code, version, dim, nmetric;
   REF_INT int_size, fp_size;
@@ -1435,31 +1437,36 @@ REF_FCN static REF_STATUS ref_gather_node_metric_solb(REF_GRID ref_grid,
   header_size = 4 + fp_size + int_size;
 
   if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
     code = 1;
-    REIS(1, fwrite(&code, sizeof(int), 1, file), "code");
-    REIS(1, fwrite(&version, sizeof(int), 1, file), "version");
-    next_position = (REF_FILEPOS)(4 + fp_size + 4) + ftell(file);
+    RSS(ref_writer_int(ref_writer, code), "code");
+    RSS(ref_writer_int(ref_writer, version), "version");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    next_position = (REF_FILEPOS)(4 + fp_size + 4) + position;
     keyword_code = 3;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
-    REIS(next_position, ftell(file), "dim inconsistent");
+    RSS(ref_writer_int(ref_writer, keyword_code), "dim code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_writer_int(ref_writer, dim), "dim");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "dim inconsistent");
   }
 
   if (ref_mpi_once(ref_mpi)) {
     next_position =
         (REF_FILEPOS)header_size + (REF_FILEPOS)(4 + 4) +
         (REF_FILEPOS)ref_node_n_global(ref_node) * (REF_FILEPOS)(nmetric * 8) +
-        ftell(file);
+        position;
     keyword_code = 62;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    RSS(ref_gather_meshb_glob(file, version, ref_node_n_global(ref_node)),
+    RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_gather_meshb_glob(ref_writer, version, ref_node_n_global(ref_node)),
         "nnode");
     keyword_code = 1; /* one solution at node */
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "n solutions");
+    RSS(ref_writer_int(ref_writer, keyword_code), "n solutions");
     keyword_code = 3; /* solution type 3, metric */
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "metric solution");
+    RSS(ref_writer_int(ref_writer, keyword_code), "metric solution");
   }
 
   chunk = (REF_INT)(ref_node_n_global(ref_node) / ref_mpi_n(ref_mpi) + 1);
@@ -1502,17 +1509,17 @@ REF_FCN static REF_STATUS ref_gather_node_metric_solb(REF_GRID ref_grid,
                  xyzm[6 + 7 * i]);
         }
         if (3 == dim) { /* threed */
-          REIS(1, fwrite(&(xyzm[0 + 7 * i]), sizeof(REF_DBL), 1, file), "m11");
-          REIS(1, fwrite(&(xyzm[1 + 7 * i]), sizeof(REF_DBL), 1, file), "m12");
+          RSS(ref_writer_dbl(ref_writer, xyzm[0 + 7 * i]), "m11");
+          RSS(ref_writer_dbl(ref_writer, xyzm[1 + 7 * i]), "m12");
           /* transposed 3,2 */
-          REIS(1, fwrite(&(xyzm[3 + 7 * i]), sizeof(REF_DBL), 1, file), "m22");
-          REIS(1, fwrite(&(xyzm[2 + 7 * i]), sizeof(REF_DBL), 1, file), "m13");
-          REIS(1, fwrite(&(xyzm[4 + 7 * i]), sizeof(REF_DBL), 1, file), "m23");
-          REIS(1, fwrite(&(xyzm[5 + 7 * i]), sizeof(REF_DBL), 1, file), "m33");
+          RSS(ref_writer_dbl(ref_writer, xyzm[3 + 7 * i]), "m22");
+          RSS(ref_writer_dbl(ref_writer, xyzm[2 + 7 * i]), "m13");
+          RSS(ref_writer_dbl(ref_writer, xyzm[4 + 7 * i]), "m23");
+          RSS(ref_writer_dbl(ref_writer, xyzm[5 + 7 * i]), "m33");
         } else { /* twod */
-          REIS(1, fwrite(&(xyzm[0 + 7 * i]), sizeof(REF_DBL), 1, file), "m11");
-          REIS(1, fwrite(&(xyzm[1 + 7 * i]), sizeof(REF_DBL), 1, file), "m12");
-          REIS(1, fwrite(&(xyzm[3 + 7 * i]), sizeof(REF_DBL), 1, file), "m22");
+          RSS(ref_writer_dbl(ref_writer, xyzm[0 + 7 * i]), "m11");
+          RSS(ref_writer_dbl(ref_writer, xyzm[1 + 7 * i]), "m12");
+          RSS(ref_writer_dbl(ref_writer, xyzm[3 + 7 * i]), "m22");
         }
       }
   }
@@ -1520,14 +1527,18 @@ REF_FCN static REF_STATUS ref_gather_node_metric_solb(REF_GRID ref_grid,
   ref_free(xyzm);
   ref_free(local_xyzm);
 
-  if (ref_mpi_once(ref_mpi))
-    REIS(next_position, ftell(file), "solb metric record len inconsistent");
+  if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "solb metric record len inconsistent");
+  }
 
   if (ref_mpi_once(ref_mpi)) { /* End */
     keyword_code = 54;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "end kw");
+    RSS(ref_writer_int(ref_writer, keyword_code), "end kw");
     next_position = 0;
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_writer_free(ref_writer), "flush");
   }
 
   return REF_SUCCESS;
@@ -1544,6 +1555,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_rst(REF_GRID ref_grid, REF_INT ldim,
   REF_INT local, n, i, im;
   REF_STATUS status;
   FILE *file;
+  REF_WRITER ref_writer = NULL;
   int variables, step, steps, dof;
 
   RSS(ref_node_synchronize_globals(ref_node), "sync");
@@ -1560,21 +1572,19 @@ REF_FCN static REF_STATUS ref_gather_scalar_rst(REF_GRID ref_grid, REF_INT ldim,
     int dim;
     int doubles = 0;
 
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
 
-    REIS(1, fwrite(&length, sizeof(length), 1, file), "length");
-    REIS(length, fwrite(magic, sizeof(char), (unsigned long)length, file),
-         "magic");
-    REIS(1, fwrite(&version, sizeof(version), 1, file), "version");
+    RSS(ref_writer_int(ref_writer, length), "length");
+    RSS(ref_writer_bytes(ref_writer, (REF_SIZE)length, magic), "magic");
+    RSS(ref_writer_int(ref_writer, version), "version");
     dim = 3;
     if (ref_grid_twod(ref_grid)) dim = 2;
-    REIS(1, fwrite(&dim, sizeof(dim), 1, file), "dim");
-    REIS(1, fwrite(&variables, sizeof(variables), 1, file), "variables");
-    REIS(1, fwrite(&steps, sizeof(steps), 1, file), "steps");
-    REIS(1, fwrite(&dof, sizeof(dof), 1, file), "dof");
-    REIS(1, fwrite(&doubles, sizeof(doubles), 1, file), "doubles");
+    RSS(ref_writer_int(ref_writer, dim), "dim");
+    RSS(ref_writer_int(ref_writer, variables), "variables");
+    RSS(ref_writer_int(ref_writer, steps), "steps");
+    RSS(ref_writer_int(ref_writer, dof), "dof");
+    RSS(ref_writer_int(ref_writer, doubles), "doubles");
     /* assume zero doubles, skip misc metadata (timestep) */
   }
 
@@ -1621,12 +1631,9 @@ REF_FCN static REF_STATUS ref_gather_scalar_rst(REF_GRID ref_grid, REF_INT ldim,
             printf("error gather node " REF_GLOB_FMT " %f\n", first + i,
                    xyzm[variables + (variables + 1) * i]);
           }
-          for (im = 0; im < variables; im++) {
-            REIS(1,
-                 fwrite(&(xyzm[im + (variables + 1) * i]), sizeof(REF_DBL), 1,
-                        file),
-                 "s");
-          }
+          RSS(ref_writer_dbls(ref_writer, variables,
+                              &(xyzm[(variables + 1) * i])),
+              "s");
         }
     }
   }
@@ -1634,7 +1641,10 @@ REF_FCN static REF_STATUS ref_gather_scalar_rst(REF_GRID ref_grid, REF_INT ldim,
   ref_free(xyzm);
   ref_free(local_xyzm);
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid)) {
+    RSS(ref_writer_free(ref_writer), "flush");
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
+  }
 
   return REF_SUCCESS;
 }
@@ -1642,7 +1652,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_rst(REF_GRID ref_grid, REF_INT ldim,
 REF_FCN static REF_STATUS ref_gather_node_scalar_bin(REF_NODE ref_node,
                                                      REF_INT ldim,
                                                      REF_DBL *scalar,
-                                                     FILE *file) {
+                                                     REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk, nchunk;
   REF_DBL *local_xyzm, *xyzm;
@@ -1701,11 +1711,7 @@ REF_FCN static REF_STATUS ref_gather_node_scalar_bin(REF_NODE ref_node,
           printf("error gather node " REF_GLOB_FMT " %f\n", first + i,
                  xyzm[ldim + (ldim + 1) * i]);
         }
-        for (im = 0; im < ldim; im++) {
-          REIS(1,
-               fwrite(&(xyzm[im + (ldim + 1) * i]), sizeof(REF_DBL), 1, file),
-               "s");
-        }
+        RSS(ref_writer_dbls(ref_writer, ldim, &(xyzm[(ldim + 1) * i])), "s");
       }
     if (1 < ref_mpi_timing(ref_mpi)) disk_toc += (clock() - tic);
   }
@@ -1814,7 +1820,8 @@ REF_FCN static REF_STATUS ref_gather_node_scalar_solb(REF_GRID ref_grid,
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_INT i;
-  REF_FILEPOS next_position = 0;
+  REF_WRITER ref_writer = NULL;
+  REF_FILEPOS next_position = 0, position = 0;
   REF_INT keyword_code, header_size;
   REF_INT code, version, dim;
   REF_INT int_size, fp_size;
@@ -1839,46 +1846,55 @@ REF_FCN static REF_STATUS ref_gather_node_scalar_solb(REF_GRID ref_grid,
   header_size = 4 + fp_size + int_size;
 
   if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
     code = 1;
-    REIS(1, fwrite(&code, sizeof(int), 1, file), "code");
-    REIS(1, fwrite(&version, sizeof(int), 1, file), "version");
-    next_position = (REF_FILEPOS)(4 + fp_size + 4) + ftell(file);
+    RSS(ref_writer_int(ref_writer, code), "code");
+    RSS(ref_writer_int(ref_writer, version), "version");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    next_position = (REF_FILEPOS)(4 + fp_size + 4) + position;
     keyword_code = 3;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
-    REIS(next_position, ftell(file), "dim inconsistent");
+    RSS(ref_writer_int(ref_writer, keyword_code), "dim code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_writer_int(ref_writer, dim), "dim");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "dim inconsistent");
   }
 
   if (ref_mpi_once(ref_mpi)) {
     next_position =
         (REF_FILEPOS)header_size + (REF_FILEPOS)(4 + (ldim * 4)) +
         (REF_FILEPOS)ref_node_n_global(ref_node) * (REF_FILEPOS)(ldim * 8) +
-        ftell(file);
+        position;
     keyword_code = 62;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    RSS(ref_gather_meshb_glob(file, version, ref_node_n_global(ref_node)),
+    RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_gather_meshb_glob(ref_writer, version, ref_node_n_global(ref_node)),
         "nnode");
     keyword_code = ldim; /* one solution at node */
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "n solutions");
+    RSS(ref_writer_int(ref_writer, keyword_code), "n solutions");
     keyword_code = 1; /* solution type 1, scalar */
     for (i = 0; i < ldim; i++) {
-      REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "scalar");
+      RSS(ref_writer_int(ref_writer, keyword_code), "scalar");
     }
   }
 
-  RSS(ref_gather_node_scalar_bin(ref_node, ldim, scalar, file),
+  RSS(ref_gather_node_scalar_bin(ref_node, ldim, scalar, ref_writer),
       "bin dump in solb");
 
-  if (ref_mpi_once(ref_mpi))
-    REIS(next_position, ftell(file), "solb metric record len inconsistent");
+  if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "solb metric record len inconsistent");
+  }
 
   if (ref_mpi_once(ref_mpi)) { /* End */
     keyword_code = 54;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "end kw");
+    RSS(ref_writer_int(ref_writer, keyword_code), "end kw");
     next_position = 0;
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_writer_free(ref_writer), "flush");
   }
 
   return REF_SUCCESS;
@@ -1927,8 +1943,8 @@ REF_FCN static REF_STATUS ref_gather_node_scalar_sol(REF_GRID ref_grid,
 
 REF_FCN static REF_STATUS ref_gather_cell(
     REF_NODE ref_node, REF_CELL ref_cell, REF_BOOL faceid_insted_of_c2n,
-    REF_BOOL always_id, REF_BOOL swap_endian, REF_BOOL sixty_four_bit,
-    REF_BOOL select_faceid, REF_INT faceid, REF_BOOL pad, FILE *file) {
+    REF_BOOL always_id, REF_BOOL sixty_four_bit, REF_BOOL select_faceid,
+    REF_INT faceid, REF_BOOL pad, REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT cell, node, part;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
@@ -1970,42 +1986,32 @@ REF_FCN static REF_STATUS ref_gather_cell(
         if (faceid_insted_of_c2n) {
           if (sixty_four_bit) {
             c2n_long = globals[node_per];
-            if (swap_endian) SWAP_LONG(c2n_long);
-            REIS(1, fwrite(&(c2n_long), sizeof(REF_LONG), 1, file), "long id");
+            RSS(ref_writer_long(ref_writer, c2n_long), "long id");
           } else {
             c2n_int = (REF_INT)globals[node_per];
-            if (swap_endian) SWAP_INT(c2n_int);
-            REIS(1, fwrite(&(c2n_int), sizeof(REF_INT), 1, file), "int id");
+            RSS(ref_writer_int(ref_writer, c2n_int), "int id");
           }
         } else {
           for (node = 0; node < node_per; node++) {
             if (sixty_four_bit) {
               c2n_long = globals[node];
-              if (swap_endian) SWAP_LONG(c2n_long);
-              REIS(1, fwrite(&c2n_long, sizeof(REF_LONG), 1, file),
-                   "long cel node");
+              RSS(ref_writer_long(ref_writer, c2n_long), "long cel node");
             } else {
               c2n_int = (REF_INT)globals[node];
-              if (swap_endian) SWAP_INT(c2n_int);
-              REIS(1, fwrite(&c2n_int, sizeof(REF_INT), 1, file),
-                   "int cel node");
+              RSS(ref_writer_int(ref_writer, c2n_int), "int cel node");
             }
           }
           if (pad) {
             REF_INT zero = 0;
-            if (swap_endian) SWAP_INT(zero);
-            REIS(1, fwrite(&(zero), sizeof(REF_INT), 1, file), "zero pad");
+            RSS(ref_writer_int(ref_writer, zero), "zero pad");
           }
           if (always_id) {
             if (sixty_four_bit) {
               c2n_long = globals[node_per];
-              if (swap_endian) SWAP_LONG(c2n_long);
-              REIS(1, fwrite(&(c2n_long), sizeof(REF_LONG), 1, file),
-                   "long id");
+              RSS(ref_writer_long(ref_writer, c2n_long), "long id");
             } else {
               c2n_int = (REF_INT)globals[node_per];
-              if (swap_endian) SWAP_INT(c2n_int);
-              REIS(1, fwrite(&(c2n_int), sizeof(REF_INT), 1, file), "int id");
+              RSS(ref_writer_int(ref_writer, c2n_int), "int id");
             }
           }
         }
@@ -2048,43 +2054,32 @@ REF_FCN static REF_STATUS ref_gather_cell(
           if (faceid_insted_of_c2n) {
             if (sixty_four_bit) {
               c2n_long = globals[node_per];
-              if (swap_endian) SWAP_LONG(c2n_long);
-              REIS(1, fwrite(&(c2n_long), sizeof(REF_LONG), 1, file),
-                   "long id");
+              RSS(ref_writer_long(ref_writer, c2n_long), "long id");
             } else {
               c2n_int = (REF_INT)globals[node_per];
-              if (swap_endian) SWAP_INT(c2n_int);
-              REIS(1, fwrite(&(c2n_int), sizeof(REF_INT), 1, file), "int id");
+              RSS(ref_writer_int(ref_writer, c2n_int), "int id");
             }
           } else {
             for (node = 0; node < node_per; node++) {
               if (sixty_four_bit) {
                 c2n_long = globals[node];
-                if (swap_endian) SWAP_LONG(c2n_long);
-                REIS(1, fwrite(&c2n_long, sizeof(REF_LONG), 1, file),
-                     "long cel node");
+                RSS(ref_writer_long(ref_writer, c2n_long), "long cel node");
               } else {
                 c2n_int = (REF_INT)globals[node];
-                if (swap_endian) SWAP_INT(c2n_int);
-                REIS(1, fwrite(&c2n_int, sizeof(REF_INT), 1, file),
-                     "int cel node");
+                RSS(ref_writer_int(ref_writer, c2n_int), "int cel node");
               }
             }
             if (pad) {
               REF_INT zero = 0;
-              if (swap_endian) SWAP_INT(zero);
-              REIS(1, fwrite(&(zero), sizeof(REF_INT), 1, file), "zero pad");
+              RSS(ref_writer_int(ref_writer, zero), "zero pad");
             }
             if (always_id) {
               if (sixty_four_bit) {
                 c2n_long = globals[node_per];
-                if (swap_endian) SWAP_LONG(c2n_long);
-                REIS(1, fwrite(&(c2n_long), sizeof(REF_LONG), 1, file),
-                     "long id");
+                RSS(ref_writer_long(ref_writer, c2n_long), "long id");
               } else {
                 c2n_int = (REF_INT)globals[node_per];
-                if (swap_endian) SWAP_INT(c2n_int);
-                REIS(1, fwrite(&(c2n_int), sizeof(REF_INT), 1, file), "int id");
+                RSS(ref_writer_int(ref_writer, c2n_int), "int id");
               }
             }
           }
@@ -2127,7 +2122,7 @@ REF_FCN static REF_STATUS ref_gather_cell(
 
 REF_FCN static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
                                           REF_INT version, REF_INT type,
-                                          FILE *file) {
+                                          REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT geom, id, i;
   REF_GLOB node;
@@ -2145,15 +2140,12 @@ REF_FCN static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
       node = ref_node_global(ref_node, ref_geom_node(ref_geom, geom)) + 1;
       id = ref_geom_id(ref_geom, geom);
       double_gref = (double)ref_geom_gref(ref_geom, geom);
-      RSS(ref_gather_meshb_glob(file, version, node), "node");
-      RSS(ref_gather_meshb_int(file, version, id), "id");
+      RSS(ref_gather_meshb_glob(ref_writer, version, node), "node");
+      RSS(ref_gather_meshb_int(ref_writer, version, id), "id");
       for (i = 0; i < type; i++)
-        REIS(1,
-             fwrite(&(ref_geom_param(ref_geom, i, geom)), sizeof(double), 1,
-                    file),
-             "id");
-      if (0 < type)
-        REIS(1, fwrite(&(double_gref), sizeof(double), 1, file), "id");
+        RSS(ref_writer_dbl(ref_writer, ref_geom_param(ref_geom, i, geom)),
+            "param");
+      if (0 < type) RSS(ref_writer_dbl(ref_writer, double_gref), "gref");
     }
   }
 
@@ -2173,13 +2165,11 @@ REF_FCN static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
           node = node_id[0 + 3 * geom] + 1;
           id = (REF_INT)node_id[1 + 3 * geom];
           double_gref = (double)node_id[2 + 3 * geom];
-          RSS(ref_gather_meshb_glob(file, version, node), "node");
-          RSS(ref_gather_meshb_int(file, version, id), "id");
+          RSS(ref_gather_meshb_glob(ref_writer, version, node), "node");
+          RSS(ref_gather_meshb_int(ref_writer, version, id), "id");
           for (i = 0; i < type; i++)
-            REIS(1, fwrite(&(param[i + 2 * geom]), sizeof(double), 1, file),
-                 "id");
-          if (0 < type)
-            REIS(1, fwrite(&(double_gref), sizeof(double), 1, file), "id");
+            RSS(ref_writer_dbl(ref_writer, param[i + 2 * geom]), "param");
+          if (0 < type) RSS(ref_writer_dbl(ref_writer, double_gref), "gref");
         }
         ref_free(param);
         ref_free(node_id);
@@ -2222,12 +2212,98 @@ REF_FCN static REF_STATUS ref_gather_geom(REF_NODE ref_node, REF_GEOM ref_geom,
   return REF_SUCCESS;
 }
 
+/* checkpoint node state and settings, ahead of the meshb End keyword */
+REF_FCN static REF_STATUS ref_gather_checkpoint_state(
+    REF_GRID ref_grid, REF_INT version, REF_BOOL curvature_metric,
+    REF_WRITER ref_writer, REF_FILEPOS *position) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT keyword_code, header_size, int_size, fp_size;
+  REF_FILEPOS next_position = 0;
+  REF_INT ldim, naux, node, i;
+  REF_DBL *state;
+  REF_DBL setting[REF_GATHER_CHECKPOINT_HEADER + REF_ADAPT_NSETTING];
+
+  int_size = 4;
+  fp_size = 4;
+  if (2 < version) fp_size = 8;
+  if (3 < version) int_size = 8;
+  header_size = 4 + fp_size + int_size;
+
+  naux = ref_node_naux(ref_node);
+  ldim = 6 + naux + 2; /* log metric, aux, age, part */
+  ref_malloc_init(state, ldim * ref_node_max(ref_node), REF_DBL, 0.0);
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(ref_node_metric_get_log(ref_node, node, &(state[ldim * node])), "log");
+    for (i = 0; i < naux; i++)
+      state[6 + i + ldim * node] = ref_node_aux(ref_node, i, node);
+    state[6 + naux + ldim * node] = (REF_DBL)ref_node_age(ref_node, node);
+    state[7 + naux + ldim * node] = (REF_DBL)ref_node_part(ref_node, node);
+  }
+
+  if (ref_grid_once(ref_grid)) {
+    next_position =
+        (REF_FILEPOS)header_size + (REF_FILEPOS)(4 + (ldim * 4)) +
+        (REF_FILEPOS)ref_node_n_global(ref_node) * (REF_FILEPOS)(ldim * 8) +
+        (*position);
+    keyword_code = 62; /* GmfSolAtVertices */
+    RSS(ref_writer_int(ref_writer, keyword_code), "keyword");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_gather_meshb_glob(ref_writer, version, ref_node_n_global(ref_node)),
+        "nnode");
+    RSS(ref_writer_int(ref_writer, ldim), "n solutions");
+    keyword_code = 1; /* solution type 1, scalar */
+    for (i = 0; i < ldim; i++) {
+      RSS(ref_writer_int(ref_writer, keyword_code), "scalar");
+    }
+  }
+  RSS(ref_gather_node_scalar_bin(ref_node, ldim, state, ref_writer), "state");
+  ref_free(state);
+  if (ref_grid_once(ref_grid)) {
+    RSS(ref_writer_tell(ref_writer, position), "tell");
+    REIS(next_position, *position, "state inconsistent");
+  }
+
+  if (ref_grid_once(ref_grid)) {
+    setting[0] = (REF_DBL)REF_GATHER_CHECKPOINT_VERSION;
+    setting[1] = (REF_DBL)ref_mpi_n(ref_grid_mpi(ref_grid));
+    setting[2] = (REF_DBL)naux;
+    setting[3] = (REF_DBL)curvature_metric;
+    RSS(ref_adapt_pack(ref_grid->adapt,
+                       &(setting[REF_GATHER_CHECKPOINT_HEADER])),
+        "pack");
+    next_position =
+        (REF_FILEPOS)header_size +
+        (REF_FILEPOS)(8 * (REF_GATHER_CHECKPOINT_HEADER + REF_ADAPT_NSETTING)) +
+        (*position);
+    keyword_code = REF_IMPORT_MESHB_CHECKPOINT_KEYWORD;
+    RSS(ref_writer_int(ref_writer, keyword_code), "keyword");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_gather_meshb_int(ref_writer, version,
+                             REF_GATHER_CHECKPOINT_HEADER + REF_ADAPT_NSETTING),
+        "nsetting");
+    RSS(ref_writer_dbls(ref_writer,
+                        REF_GATHER_CHECKPOINT_HEADER + REF_ADAPT_NSETTING,
+                        setting),
+        "settings");
+    RSS(ref_writer_tell(ref_writer, position), "tell");
+    REIS(next_position, *position, "settings inconsistent");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_gather_meshb(REF_GRID ref_grid,
-                                           const char *filename) {
+                                           const char *filename,
+                                           REF_BOOL checkpoint,
+                                           REF_BOOL curvature_metric) {
   FILE *file;
+  REF_ASYNC ref_async = ref_gather_async(ref_grid_gather(ref_grid));
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT code, version, dim;
-  REF_FILEPOS next_position = 0;
+  REF_WRITER ref_writer = NULL;
+  REF_FILEPOS next_position = 0, position = 0;
   REF_INT keyword_code, header_size, int_size, fp_size;
   REF_LONG ncell;
   REF_INT node_per;
@@ -2265,38 +2341,42 @@ REF_FCN static REF_STATUS ref_gather_meshb(REF_GRID ref_grid,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+    RSS(ref_writer_create(&ref_writer, file, swap_endian), "writer");
 
     code = 1;
-    REIS(1, fwrite(&code, sizeof(int), 1, file), "code");
-    REIS(1, fwrite(&version, sizeof(int), 1, file), "version");
+    RSS(ref_writer_int(ref_writer, code), "code");
+    RSS(ref_writer_int(ref_writer, version), "version");
     /* dimension keyword always int */
-    next_position = (REF_FILEPOS)(4 + fp_size + 4) + ftell(file);
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    next_position = (REF_FILEPOS)(4 + fp_size + 4) + position;
     keyword_code = 3;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
-    REIS(next_position, ftell(file), "dim inconsistent");
+    RSS(ref_writer_int(ref_writer, keyword_code), "dim code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_writer_int(ref_writer, dim), "dim");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "dim inconsistent");
   }
 
   if (ref_grid_once(ref_grid)) {
     next_position = (REF_FILEPOS)header_size +
                     (REF_FILEPOS)ref_node_n_global(ref_node) *
                         (REF_FILEPOS)(dim * 8 + int_size) +
-                    ftell(file);
+                    position;
     keyword_code = 4;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    RSS(ref_gather_meshb_glob(file, version, ref_node_n_global(ref_node)),
+    RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_gather_meshb_glob(ref_writer, version, ref_node_n_global(ref_node)),
         "nnode");
   }
-  RSS(ref_gather_node(ref_node, swap_endian, version, ref_grid_twod(ref_grid),
-                      file),
+  RSS(ref_gather_node(ref_node, version, ref_grid_twod(ref_grid), ref_writer),
       "nodes");
-  if (ref_grid_once(ref_grid))
-    REIS(next_position, ftell(file), "vertex inconsistent");
+  if (ref_grid_once(ref_grid)) {
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "vertex inconsistent");
+  }
 
   each_ref_grid_all_ref_cell(ref_grid, group, ref_cell) {
     RSS(ref_cell_ncell(ref_cell, ref_node, &ncell), "ncell");
@@ -2305,19 +2385,21 @@ REF_FCN static REF_STATUS ref_gather_meshb(REF_GRID ref_grid,
         RSS(ref_cell_meshb_keyword(ref_cell, &keyword_code), "kw");
         node_per = ref_cell_node_per(ref_cell);
         next_position =
-            ftell(file) + (REF_FILEPOS)header_size +
+            position + (REF_FILEPOS)header_size +
             (REF_FILEPOS)ncell * (REF_FILEPOS)(int_size * (node_per + 1));
-        REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword code");
-        RSS(ref_export_meshb_next_position(file, version, next_position),
+        RSS(ref_writer_int(ref_writer, keyword_code), "keyword code");
+        RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
             "next");
-        RSS(ref_gather_meshb_glob(file, version, ncell), "ncell");
+        RSS(ref_gather_meshb_glob(ref_writer, version, ncell), "ncell");
       }
       RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                          swap_endian, sixty_four_bit, select_faceid, faceid,
-                          pad, file),
+                          sixty_four_bit, select_faceid, faceid, pad,
+                          ref_writer),
           "nodes");
-      if (ref_grid_once(ref_grid))
-        REIS(next_position, ftell(file), "cell inconsistent");
+      if (ref_grid_once(ref_grid)) {
+        RSS(ref_writer_tell(ref_writer, &position), "tell");
+        REIS(next_position, position, "cell inconsistent");
+      }
     }
   }
 
@@ -2329,47 +2411,79 @@ REF_FCN static REF_STATUS ref_gather_meshb(REF_GRID ref_grid,
         next_position =
             (REF_FILEPOS)header_size +
             (REF_FILEPOS)ngeom * (REF_FILEPOS)(int_size * 2 + 8 * type) +
-            (0 < type ? 8 * ngeom : 0) + ftell(file);
-        REIS(1, fwrite(&keyword_code, sizeof(int), 1, file),
-             "vertex version code");
-        RSS(ref_export_meshb_next_position(file, version, next_position), "np");
-        RSS(ref_gather_meshb_int(file, version, ngeom), "ngeom");
+            (0 < type ? 8 * ngeom : 0) + position;
+        RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
+        RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+            "np");
+        RSS(ref_gather_meshb_int(ref_writer, version, ngeom), "ngeom");
+      }
+      RSS(ref_gather_geom(ref_node, ref_geom, version, type, ref_writer),
+          "nodes");
+      if (ref_grid_once(ref_grid)) {
+        RSS(ref_writer_tell(ref_writer, &position), "tell");
+        REIS(next_position, position, "geom inconsistent");
       }
-      RSS(ref_gather_geom(ref_node, ref_geom, version, type, file), "nodes");
-      if (ref_grid_once(ref_grid))
-        REIS(next_position, ftell(file), "geom inconsistent");
     }
   }
 
   if (ref_grid_once(ref_grid) && 0 < ref_geom_cad_data_size(ref_geom)) {
     keyword_code = 126; /* GmfByteFlow */
     next_position = (REF_FILEPOS)header_size +
-                    (REF_FILEPOS)ref_geom_cad_data_size(ref_geom) + ftell(file);
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    RSS(ref_gather_meshb_size(file, version, ref_geom_cad_data_size(ref_geom)),
+                    (REF_FILEPOS)ref_geom_cad_data_size(ref_geom) + position;
+    RSS(ref_writer_int(ref_writer, keyword_code), "keyword");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_gather_meshb_size(ref_writer, version,
+                              ref_geom_cad_data_size(ref_geom)),
         "cad size");
-    REIS(ref_geom_cad_data_size(ref_geom),
-         fwrite(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
-                (size_t)ref_geom_cad_data_size(ref_geom), file),
-         "node");
-    REIS(next_position, ftell(file), "cad_model inconsistent");
+    RSS(ref_writer_bytes(ref_writer, ref_geom_cad_data_size(ref_geom),
+                         ref_geom_cad_data(ref_geom)),
+        "cad data");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "cad_model inconsistent");
+  }
+
+  if (checkpoint) {
+    RSS(ref_gather_checkpoint_state(ref_grid, version, curvature_metric,
+                                    ref_writer, &position),
+        "checkpoint state");
   }
 
   if (ref_grid_once(ref_grid)) { /* End */
     keyword_code = 54;           /* GmfEnd 101-47 */
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "vertex version code");
+    RSS(ref_writer_int(ref_writer, keyword_code), "vertex version code");
     next_position = 0;
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
-    fclose(file);
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
+    RSS(ref_writer_free(ref_writer), "flush");
+    if (checkpoint && NULL != (void *)ref_async) {
+      RSS(ref_async_close_packed(ref_async, file, filename), "pack");
+    } else {
+      RSS(ref_gather_close(ref_grid, filename, file), "close");
+    }
   }
 
   return REF_SUCCESS;
 }
 
+/* string padded with nul bytes to width */
+REF_FCN static REF_STATUS ref_gather_avm_string(REF_WRITER ref_writer,
+                                                const char *string,
+                                                REF_INT width) {
+  char nul[128];
+  REF_INT length = (REF_INT)strlen(string);
+  RAS(0 <= width && width <= 128, "pad width");
+  memset(nul, 0, sizeof(nul));
+  RSS(ref_writer_bytes(ref_writer, (REF_SIZE)length, string), "string");
+  if (length < width)
+    RSS(ref_writer_bytes(ref_writer, (REF_SIZE)(width - length), nul), "nul");
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
                                          const char *filename) {
   FILE *file;
+  REF_WRITER ref_writer = NULL;
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_GLOB nnode;
@@ -2397,7 +2511,6 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
     int magic_number = 1;
     int revision_number = 2;
     int n_meshes = 1;
-    char nul = '\0';
     int length, i;
     char contact_info[] = "NASA/refine";
     int precision = 2;
@@ -2412,57 +2525,28 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
     double model_scale = 1.0;
     char mesh_units[12];
     int refined = 0;
-    int n_int;
     char element_scheme[] = "uniform";
     int faceid;
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-
-    REIS(6, fwrite(magic_string, sizeof(char), 6, file), "magic_string");
-    REIS(1, fwrite(&magic_number, sizeof(magic_number), 1, file),
-         "magic_number");
-    REIS(1, fwrite(&revision_number, sizeof(revision_number), 1, file),
-         "revision_number");
-    REIS(1, fwrite(&n_meshes, sizeof(n_meshes), 1, file), "n_meshes");
-    length = (int)strlen(contact_info);
-    REIS(length,
-         fwrite(contact_info, sizeof(char), (unsigned long)length, file),
-         "contact_info");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    REIS(1, fwrite(&precision, sizeof(precision), 1, file), "precision");
+    int counts[16];
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
+
+    RSS(ref_writer_bytes(ref_writer, 6, magic_string), "magic_string");
+    RSS(ref_writer_int(ref_writer, magic_number), "magic_number");
+    RSS(ref_writer_int(ref_writer, revision_number), "revision_number");
+    RSS(ref_writer_int(ref_writer, n_meshes), "n_meshes");
+    RSS(ref_gather_avm_string(ref_writer, contact_info, 128), "contact_info");
+    RSS(ref_writer_int(ref_writer, precision), "precision");
     dimension = (ref_grid_twod(ref_grid) ? 2 : 3);
-    REIS(1, fwrite(&dimension, sizeof(dimension), 1, file), "dimension");
+    RSS(ref_writer_int(ref_writer, dimension), "dimension");
     length = (int)strlen(file_description);
-    REIS(1, fwrite(&length, sizeof(length), 1, file), "length");
-    REIS(length,
-         fwrite(file_description, sizeof(char), (unsigned long)length, file),
-         "file_description");
-    length = (int)strlen(mesh_name);
-    REIS(length, fwrite(mesh_name, sizeof(char), (unsigned long)length, file),
-         "mesh_name");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    length = (int)strlen(mesh_type);
-    REIS(length, fwrite(mesh_type, sizeof(char), (unsigned long)length, file),
-         "mesh_type");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    length = (int)strlen(mesh_generator);
-    REIS(length,
-         fwrite(mesh_generator, sizeof(char), (unsigned long)length, file),
-         "mesh_generator");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
+    RSS(ref_writer_int(ref_writer, length), "length");
+    RSS(ref_writer_bytes(ref_writer, (REF_SIZE)length, file_description),
+        "file_description");
+    RSS(ref_gather_avm_string(ref_writer, mesh_name, 128), "mesh_name");
+    RSS(ref_gather_avm_string(ref_writer, mesh_type, 128), "mesh_type");
+    RSS(ref_gather_avm_string(ref_writer, mesh_generator, 128),
+        "mesh_generator");
     if (ref_grid_twod(ref_grid)) {
       snprintf(coordinate_system, 7, "xByUzL"); /* 2D: always xByUzL */
     } else {
@@ -2490,15 +2574,9 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
           THROW("REF_GRID_COORDSYS_LAST");
       }
     }
-    length = (int)strlen(coordinate_system);
-    REIS(length,
-         fwrite(coordinate_system, sizeof(char), (unsigned long)length, file),
-         "coordinate_system");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    REIS(1, fwrite(&model_scale, sizeof(model_scale), 1, file), "model_scale");
+    RSS(ref_gather_avm_string(ref_writer, coordinate_system, 128),
+        "coordinate_system");
+    RSS(ref_writer_dbl(ref_writer, model_scale), "model_scale");
     if (ref_geom_model_loaded(ref_grid_geom(ref_grid))) {
       const char *unit;
       REF_STATUS ref_status;
@@ -2524,13 +2602,7 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
       case REF_GRID_UNIT_LAST:
         THROW("REF_GRID_UNIT_LAST");
     }
-    length = (int)strlen(mesh_units);
-    REIS(length, fwrite(mesh_units, sizeof(char), (unsigned long)length, file),
-         "mesh_units");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
+    RSS(ref_gather_avm_string(ref_writer, mesh_units, 128), "mesh_units");
     if (ref_geom_model_loaded(ref_grid_geom(ref_grid))) {
       const REF_DBL *reference;
       REF_STATUS ref_status;
@@ -2543,95 +2615,44 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
         }
       }
     }
-    REIS(7, fwrite(&ref_grid_reference(ref_grid, 0), sizeof(double), 7, file),
-         "reference");
-    length = (int)strlen(ref_point_desc);
-    REIS(length,
-         fwrite(ref_point_desc, sizeof(char), (unsigned long)length, file),
-         "ref_point_desc");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    REIS(1, fwrite(&refined, sizeof(refined), 1, file), "refined");
-    length = (int)strlen(mesh_description);
-    REIS(length,
-         fwrite(mesh_description, sizeof(char), (unsigned long)length, file),
-         "mesh_description");
-    length = 128 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    n_int = (int)nnode;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "nodes");
-    if (ref_grid_twod(ref_grid)) {
-      n_int = ((int)nedg + 3 * (int)ntri) / 2;
-    } else {
-      n_int = ((int)ntri + 4 * (int)ntet) / 2;
-    }
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "nfaces");
-    if (ref_grid_twod(ref_grid)) {
-      n_int = (int)ntri;
-    } else {
-      n_int = (int)ntet;
-    }
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "ncells");
+    RSS(ref_writer_dbls(ref_writer, 7, &ref_grid_reference(ref_grid, 0)),
+        "reference");
+    RSS(ref_gather_avm_string(ref_writer, ref_point_desc, 128),
+        "ref_point_desc");
+    RSS(ref_writer_int(ref_writer, refined), "refined");
+    RSS(ref_gather_avm_string(ref_writer, mesh_description, 128),
+        "mesh_description");
+    /* nodes, faces, cells, max nodes per face, nodes and faces per cell */
+    counts[0] = (int)nnode;
     if (ref_grid_twod(ref_grid)) {
-      n_int = 2;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "max nodes per face");
-      n_int = 3;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "max nodes per cell");
-      n_int = 3;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "max faces per cell");
+      counts[1] = ((int)nedg + 3 * (int)ntri) / 2;
+      counts[2] = (int)ntri;
+      counts[3] = 2;
+      counts[4] = 3;
+      counts[5] = 3;
     } else {
-      n_int = 3;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "max nodes per face");
-      n_int = 4;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "max nodes per cell");
-      n_int = 4;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "max faces per cell");
-    }
-    length = (int)strlen(element_scheme);
-    REIS(length,
-         fwrite(element_scheme, sizeof(char), (unsigned long)length, file),
-         "element_scheme");
-    length = 32 - length;
-    for (i = 0; i < length; i++) {
-      REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-    }
-    n_int = 1;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "face polynomial order");
-    n_int = 1;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "cell polynomial order");
-    n_int = nfaceid;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "# boundary patches");
-    n_int = 0;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "nhex");
-    if (ref_grid_twod(ref_grid)) {
-      n_int = (int)ntri;
-    } else {
-      n_int = (int)ntet;
-    }
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "ntet");
-    n_int = 0;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "npri");
-    n_int = 0;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "npyr");
-    if (ref_grid_twod(ref_grid)) {
-      n_int = (int)nedg;
-    } else {
-      n_int = (int)ntri;
-    }
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "# boundary tri faces");
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "# tri faces");
-    n_int = 0;
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "# boundary quad faces");
-    REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "# quad faces");
-    length = 5;
-    for (i = 0; i < length; i++) {
-      n_int = 0;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "zeros");
+      counts[1] = ((int)ntri + 4 * (int)ntet) / 2;
+      counts[2] = (int)ntet;
+      counts[3] = 3;
+      counts[4] = 4;
+      counts[5] = 4;
     }
+    RSS(ref_writer_ints(ref_writer, 6, counts), "sizes");
+    RSS(ref_gather_avm_string(ref_writer, element_scheme, 32),
+        "element_scheme");
+    /* face and cell order, patches, hex, tet, pri, pyr, boundary and all
+     * tri faces, boundary and all quad faces, five zeros */
+    counts[0] = 1;
+    counts[1] = 1;
+    counts[2] = nfaceid;
+    counts[3] = 0;
+    counts[4] = (int)(ref_grid_twod(ref_grid) ? ntri : ntet);
+    counts[5] = 0;
+    counts[6] = 0;
+    counts[7] = (int)(ref_grid_twod(ref_grid) ? nedg : ntri);
+    counts[8] = counts[7];
+    for (i = 9; i < 16; i++) counts[i] = 0;
+    RSS(ref_writer_ints(ref_writer, 16, counts), "counts");
     for (faceid = min_faceid; faceid <= max_faceid; faceid++) {
       REF_GEOM ref_geom = ref_grid_geom(ref_grid);
       const char *patch_label, *patch_type;
@@ -2644,44 +2665,28 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
                                            "av:patch_label", &patch_label);
       if (REF_SUCCESS != ref_status) patch_label = "unknown";
       snprintf(patch_label_index, 33, "%s-%d", patch_label, faceid);
-      length = (int)strlen(patch_label_index);
-      REIS(length,
-           fwrite(patch_label_index, sizeof(char), (unsigned long)length, file),
-           "patch_label");
-      length = 32 - length;
-      for (i = 0; i < length; i++) {
-        REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-      }
+      RSS(ref_gather_avm_string(ref_writer, patch_label_index, 32),
+          "patch_label");
       ref_status = ref_egads_get_attribute(ref_geom, ref_geom_type, faceid,
                                            "av:patch_type", &patch_type);
       if (REF_SUCCESS != ref_status || NULL == patch_type)
         patch_type = unknown_patch_type;
-      length = (int)strlen(patch_type);
-      REIS(length,
-           fwrite(patch_type, sizeof(char), (unsigned long)length, file),
-           "patch_label");
-      length = 16 - length;
-      for (i = 0; i < length; i++) {
-        REIS(1, fwrite(&nul, sizeof(nul), 1, file), "nul");
-      }
-      n_int = -faceid;
-      REIS(1, fwrite(&n_int, sizeof(n_int), 1, file), "patch ID");
+      RSS(ref_gather_avm_string(ref_writer, patch_type, 16), "patch_type");
+      RSS(ref_writer_int(ref_writer, -faceid), "patch ID");
     }
   }
 
   {
-    REF_BOOL swap_endian = REF_FALSE;
     REF_INT version = 0; /* meshb version, zero is no id */
     /* twod still has 3 coordinates, with z coordinate ignored/set to zero */
     REF_BOOL twod = REF_FALSE;
-    RSS(ref_gather_node(ref_node, swap_endian, version, twod, file), "nodes");
+    RSS(ref_gather_node(ref_node, version, twod, ref_writer), "nodes");
   }
 
   if (ref_grid_twod(ref_grid)) {
     REF_CELL ref_cell = ref_grid_edg(ref_grid);
     REF_BOOL faceid_insted_of_c2n = REF_FALSE;
     REF_BOOL always_id = REF_TRUE;
-    REF_BOOL swap_endian = REF_FALSE;
     REF_BOOL sixty_four_bit = REF_FALSE;
     REF_BOOL select_faceid = REF_FALSE;
     REF_INT faceid = 0;
@@ -2692,8 +2697,7 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
           -ref_cell_c2n(ref_cell, ref_cell_id_index(ref_cell), cell);
     }
     RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, sixty_four_bit, select_faceid, faceid, pad,
-                        file),
+                        sixty_four_bit, select_faceid, faceid, pad, ref_writer),
         "nodes");
     each_ref_cell_valid_cell(ref_cell, cell) {
       ref_cell_c2n(ref_cell, ref_cell_id_index(ref_cell), cell) =
@@ -2703,7 +2707,6 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
     REF_CELL ref_cell = ref_grid_tri(ref_grid);
     REF_BOOL faceid_insted_of_c2n = REF_FALSE;
     REF_BOOL always_id = REF_TRUE;
-    REF_BOOL swap_endian = REF_FALSE;
     REF_BOOL sixty_four_bit = REF_FALSE;
     REF_BOOL select_faceid = REF_FALSE;
     REF_INT faceid = 0;
@@ -2714,8 +2717,7 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
           -ref_cell_c2n(ref_cell, ref_cell_id_index(ref_cell), cell);
     }
     RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, sixty_four_bit, select_faceid, faceid, pad,
-                        file),
+                        sixty_four_bit, select_faceid, faceid, pad, ref_writer),
         "nodes");
     each_ref_cell_valid_cell(ref_cell, cell) {
       ref_cell_c2n(ref_cell, ref_cell_id_index(ref_cell), cell) =
@@ -2727,7 +2729,6 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
     REF_CELL ref_cell = ref_grid_tri(ref_grid);
     REF_BOOL faceid_insted_of_c2n = REF_FALSE;
     REF_BOOL always_id = REF_FALSE;
-    REF_BOOL swap_endian = REF_FALSE;
     REF_BOOL sixty_four_bit = REF_FALSE;
     REF_BOOL select_faceid = REF_FALSE;
     REF_INT faceid = 0;
@@ -2740,8 +2741,7 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
       ref_cell_c2n(ref_cell, 1, cell) = temp_node;
     }
     RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, sixty_four_bit, select_faceid, faceid, pad,
-                        file),
+                        sixty_four_bit, select_faceid, faceid, pad, ref_writer),
         "nodes");
     /* wind back (flip) after write */
     each_ref_cell_valid_cell(ref_cell, cell) {
@@ -2753,18 +2753,19 @@ REF_FCN static REF_STATUS ref_gather_avm(REF_GRID ref_grid,
     REF_CELL ref_cell = ref_grid_tet(ref_grid);
     REF_BOOL faceid_insted_of_c2n = REF_FALSE;
     REF_BOOL always_id = REF_FALSE;
-    REF_BOOL swap_endian = REF_FALSE;
     REF_BOOL sixty_four_bit = REF_FALSE;
     REF_BOOL select_faceid = REF_FALSE;
     REF_INT faceid = 0;
     REF_BOOL pad = REF_FALSE;
     RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, always_id,
-                        swap_endian, sixty_four_bit, select_faceid, faceid, pad,
-                        file),
+                        sixty_four_bit, select_faceid, faceid, pad, ref_writer),
         "nodes");
   }
 
-  if (ref_mpi_once(ref_mpi)) fclose(file);
+  if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_writer_free(ref_writer), "flush");
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
+  }
   return REF_SUCCESS;
 }
 
@@ -2773,12 +2774,11 @@ REF_FCN static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid,
                                                REF_BOOL swap_endian,
                                                REF_BOOL sixty_four_bit) {
   FILE *file;
+  REF_WRITER ref_writer = NULL;
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_GLOB nnode;
   REF_LONG ntri, nqua, ntet, npyr, npri, nhex;
-  REF_LONG size_long;
-  REF_INT size_int;
   REF_CELL ref_cell;
   REF_INT group;
   REF_INT faceid;
@@ -2800,65 +2800,35 @@ REF_FCN static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+    RSS(ref_writer_create(&ref_writer, file, swap_endian), "writer");
 
     if (sixty_four_bit) {
-      size_long = (REF_LONG)nnode;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "nnode");
-
-      size_long = (REF_LONG)ntri;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "ntri");
-      size_long = (REF_LONG)nqua;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "nqua");
-
-      size_long = (REF_LONG)ntet;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "ntet");
-      size_long = (REF_LONG)npyr;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "npyr");
-      size_long = (REF_LONG)npri;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "npri");
-      size_long = (REF_LONG)nhex;
-      if (swap_endian) SWAP_LONG(size_long);
-      REIS(1, fwrite(&size_long, sizeof(REF_LONG), 1, file), "nhex");
+      RSS(ref_writer_long(ref_writer, (REF_LONG)nnode), "nnode");
+
+      RSS(ref_writer_long(ref_writer, (REF_LONG)ntri), "ntri");
+      RSS(ref_writer_long(ref_writer, (REF_LONG)nqua), "nqua");
+
+      RSS(ref_writer_long(ref_writer, (REF_LONG)ntet), "ntet");
+      RSS(ref_writer_long(ref_writer, (REF_LONG)npyr), "npyr");
+      RSS(ref_writer_long(ref_writer, (REF_LONG)npri), "npri");
+      RSS(ref_writer_long(ref_writer, (REF_LONG)nhex), "nhex");
     } else {
-      size_int = (REF_INT)nnode;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "nnode");
-
-      size_int = (REF_INT)ntri;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "ntri");
-      size_int = (REF_INT)nqua;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "nqua");
-
-      size_int = (REF_INT)ntet;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "ntet");
-      size_int = (REF_INT)npyr;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "npyr");
-      size_int = (REF_INT)npri;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "npri");
-      size_int = (REF_INT)nhex;
-      if (swap_endian) SWAP_INT(size_int);
-      REIS(1, fwrite(&size_int, sizeof(REF_INT), 1, file), "nhex");
+      RSS(ref_writer_int(ref_writer, (REF_INT)nnode), "nnode");
+
+      RSS(ref_writer_int(ref_writer, (REF_INT)ntri), "ntri");
+      RSS(ref_writer_int(ref_writer, (REF_INT)nqua), "nqua");
+
+      RSS(ref_writer_int(ref_writer, (REF_INT)ntet), "ntet");
+      RSS(ref_writer_int(ref_writer, (REF_INT)npyr), "npyr");
+      RSS(ref_writer_int(ref_writer, (REF_INT)npri), "npri");
+      RSS(ref_writer_int(ref_writer, (REF_INT)nhex), "nhex");
     }
   }
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "ugrid header");
 
-  RSS(ref_gather_node(ref_node, swap_endian, version, REF_FALSE, file),
-      "nodes");
+  RSS(ref_gather_node(ref_node, version, REF_FALSE, ref_writer), "nodes");
 
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "ugrid node");
@@ -2867,12 +2837,12 @@ REF_FCN static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid,
   select_faceid = REF_FALSE;
   faceid = REF_EMPTY;
   RSS(ref_gather_cell(ref_node, ref_grid_tri(ref_grid), faceid_insted_of_c2n,
-                      version, swap_endian, sixty_four_bit, select_faceid,
-                      faceid, pad, file),
+                      version, sixty_four_bit, select_faceid, faceid, pad,
+                      ref_writer),
       "tri c2n");
   RSS(ref_gather_cell(ref_node, ref_grid_qua(ref_grid), faceid_insted_of_c2n,
-                      version, swap_endian, sixty_four_bit, select_faceid,
-                      faceid, pad, file),
+                      version, sixty_four_bit, select_faceid, faceid, pad,
+                      ref_writer),
       "qua c2n");
 
   if (0 < ref_mpi_timing(ref_mpi))
@@ -2882,12 +2852,12 @@ REF_FCN static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid,
   select_faceid = REF_FALSE;
   faceid = REF_EMPTY;
   RSS(ref_gather_cell(ref_node, ref_grid_tri(ref_grid), faceid_insted_of_c2n,
-                      version, swap_endian, sixty_four_bit, select_faceid,
-                      faceid, pad, file),
+                      version, sixty_four_bit, select_faceid, faceid, pad,
+                      ref_writer),
       "tri faceid");
   RSS(ref_gather_cell(ref_node, ref_grid_qua(ref_grid), faceid_insted_of_c2n,
-                      version, swap_endian, sixty_four_bit, select_faceid,
-                      faceid, pad, file),
+                      version, sixty_four_bit, select_faceid, faceid, pad,
+                      ref_writer),
       "qua faceid");
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "ugrid faceid write");
@@ -2897,14 +2867,16 @@ REF_FCN static REF_STATUS ref_gather_bin_ugrid(REF_GRID ref_grid,
   faceid = REF_EMPTY;
   each_ref_grid_3d_ref_cell(ref_grid, group, ref_cell) {
     RSS(ref_gather_cell(ref_node, ref_cell, faceid_insted_of_c2n, version,
-                        swap_endian, sixty_four_bit, select_faceid, faceid, pad,
-                        file),
+                        sixty_four_bit, select_faceid, faceid, pad, ref_writer),
         "cell c2n");
     if (0 < ref_mpi_timing(ref_mpi))
       ref_mpi_stopwatch_stop(ref_mpi, "ugrid vol cell write");
   }
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid)) {
+    RSS(ref_writer_free(ref_writer), "flush");
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
+  }
 
   return REF_SUCCESS;
 }
@@ -2932,6 +2904,12 @@ REF_FCN REF_STATUS ref_gather_by_extension(REF_GRID ref_grid,
         "scalar plt");
     return REF_SUCCESS;
   }
+  if (end_of_string > 5 &&
+      (strcmp(&filename[end_of_string - 5], ".pvtu") == 0)) {
+    /* written in pieces by each rank, no gather */
+    RSS(ref_export_pvtu(ref_grid, filename), "pvtu");
+    return REF_SUCCESS;
+  }
   if (end_of_string > 10 &&
       strcmp(&filename[end_of_string - 10], ".lb8.ugrid") == 0) {
     RSS(ref_gather_bin_ugrid(ref_grid, filename, REF_FALSE, REF_FALSE),
@@ -2970,7 +2948,8 @@ REF_FCN REF_STATUS ref_gather_by_extension(REF_GRID ref_grid,
   }
   if (end_of_string > 6 &&
       strcmp(&filename[end_of_string - 6], ".meshb") == 0) {
-    RSS(ref_gather_meshb(ref_grid, filename), "meshb failed");
+    RSS(ref_gather_meshb(ref_grid, filename, REF_FALSE, REF_FALSE),
+        "meshb failed");
     return REF_SUCCESS;
   }
   printf("%s: %d: %s %s\n", __FILE__, __LINE__,
@@ -2978,6 +2957,14 @@ REF_FCN REF_STATUS ref_gather_by_extension(REF_GRID ref_grid,
   return REF_FAILURE;
 }
 
+REF_FCN REF_STATUS ref_gather_checkpoint(REF_GRID ref_grid,
+                                         REF_BOOL curvature_metric,
+                                         const char *filename) {
+  RSS(ref_gather_meshb(ref_grid, filename, REF_TRUE, curvature_metric),
+      "checkpoint meshb");
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_gather_metric(REF_GRID ref_grid, const char *filename) {
   FILE *file;
   REF_NODE ref_node = ref_grid_node(ref_grid);
@@ -2989,9 +2976,7 @@ REF_FCN REF_STATUS ref_gather_metric(REF_GRID ref_grid, const char *filename) {
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
 
     end_of_string = strlen(filename);
     if (end_of_string > 5 && strcmp(&filename[end_of_string - 5], ".solb") == 0)
@@ -3010,7 +2995,8 @@ REF_FCN REF_STATUS ref_gather_metric(REF_GRID ref_grid, const char *filename) {
     RSS(ref_gather_node_metric(ref_node, file), "nodes");
   }
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
@@ -3026,16 +3012,15 @@ REF_FCN static REF_STATUS ref_gather_scalar_txt(REF_GRID ref_grid, REF_INT ldim,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
   }
 
   RSS(ref_gather_node_scalar_txt(ref_node, ldim, scalar, separator, REF_FALSE,
                                  file),
       "nodes");
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
@@ -3044,20 +3029,23 @@ REF_FCN static REF_STATUS ref_gather_scalar_bin(REF_GRID ref_grid, REF_INT ldim,
                                                 REF_DBL *scalar,
                                                 const char *filename) {
   FILE *file;
+  REF_WRITER ref_writer = NULL;
   REF_NODE ref_node = ref_grid_node(ref_grid);
 
   RSS(ref_node_synchronize_globals(ref_node), "sync");
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
   }
 
-  RSS(ref_gather_node_scalar_bin(ref_node, ldim, scalar, file), "nodes");
+  RSS(ref_gather_node_scalar_bin(ref_node, ldim, scalar, ref_writer), "nodes");
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid)) {
+    RSS(ref_writer_free(ref_writer), "flush");
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
+  }
 
   return REF_SUCCESS;
 }
@@ -3066,20 +3054,27 @@ REF_FCN static REF_STATUS ref_gather_scalar_solb(REF_GRID ref_grid,
                                                  REF_INT ldim, REF_DBL *scalar,
                                                  const char *filename) {
   FILE *file;
+  REF_ASYNC ref_async = ref_gather_async(ref_grid_gather(ref_grid));
   REF_NODE ref_node = ref_grid_node(ref_grid);
 
   RSS(ref_node_synchronize_globals(ref_node), "sync");
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
   }
 
   RSS(ref_gather_node_scalar_solb(ref_grid, ldim, scalar, file), "nodes");
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid)) {
+    /* restart solutions are the bulk of the output, ref_part_scalar
+     * expands them */
+    if (NULL != (void *)ref_async) {
+      RSS(ref_async_close_packed(ref_async, file, filename), "pack");
+    } else {
+      RSS(ref_gather_close(ref_grid, filename, file), "close");
+    }
+  }
 
   return REF_SUCCESS;
 }
@@ -3134,14 +3129,13 @@ REF_FCN static REF_STATUS ref_gather_scalar_sol(REF_GRID ref_grid, REF_INT ldim,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
   }
 
   RSS(ref_gather_node_scalar_sol(ref_grid, ldim, scalar, file), "nodes");
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
@@ -3150,13 +3144,14 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
                                                REF_DBL *scalar,
                                                const char *filename) {
   FILE *file;
+  REF_WRITER ref_writer = NULL;
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = NULL;
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_LONG ncell_local, ncell, ntet, npri;
   int version, code, keyword_code, dim, cell_keyword;
   REF_INT i, header_size, ncell_int;
-  REF_FILEPOS next_position;
+  REF_FILEPOS next_position, position = 0;
   REF_INT part, cell, nodes[REF_CELL_MAX_SIZE_PER];
   REF_DBL cell_average, *data;
   REF_INT node, j, proc;
@@ -3183,9 +3178,8 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
   }
 
   if (REF_EXPORT_MESHB_VERTEX_3 < ntet + npri) {
@@ -3198,15 +3192,18 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
 
   if (ref_mpi_once(ref_mpi)) {
     code = 1;
-    REIS(1, fwrite(&code, sizeof(int), 1, file), "code");
-    REIS(1, fwrite(&version, sizeof(int), 1, file), "version");
-    next_position = (REF_FILEPOS)header_size + ftell(file);
+    RSS(ref_writer_int(ref_writer, code), "code");
+    RSS(ref_writer_int(ref_writer, version), "version");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    next_position = (REF_FILEPOS)header_size + position;
     keyword_code = 3;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "dim code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+    RSS(ref_writer_int(ref_writer, keyword_code), "dim code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
     dim = 3;
-    REIS(1, fwrite(&dim, sizeof(int), 1, file), "dim");
-    REIS(next_position, ftell(file), "dim inconsistent");
+    RSS(ref_writer_int(ref_writer, dim), "dim");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "dim inconsistent");
   }
 
   ncell_local = 0;
@@ -3223,18 +3220,19 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
 
   if (ref_mpi_once(ref_mpi)) {
     next_position = (REF_FILEPOS)header_size + (REF_FILEPOS)(4 + (ldim * 4)) +
-                    (REF_FILEPOS)ncell * (REF_FILEPOS)(ldim * 8) + ftell(file);
+                    (REF_FILEPOS)ncell * (REF_FILEPOS)(ldim * 8) + position;
     /* GmfSolAtTetrahedra 113 - 47 = 66 */
     keyword_code = cell_keyword;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "keyword code");
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+    RSS(ref_writer_int(ref_writer, keyword_code), "keyword code");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
     ncell_int = (int)ncell;
-    REIS(1, fwrite(&ncell_int, sizeof(int), 1, file), "nnode");
+    RSS(ref_writer_int(ref_writer, ncell_int), "nnode");
     keyword_code = ldim; /* one solution at node */
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "n solutions");
+    RSS(ref_writer_int(ref_writer, keyword_code), "n solutions");
     keyword_code = 1; /* solution type 1, scalar */
     for (i = 0; i < ldim; i++) {
-      REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "scalar");
+      RSS(ref_writer_int(ref_writer, keyword_code), "scalar");
     }
   }
 
@@ -3247,7 +3245,7 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
           for (node = 0; node < ref_cell_node_per(ref_cell); node++)
             cell_average += scalar[i + ldim * nodes[node]];
           cell_average /= (REF_DBL)ref_cell_node_per(ref_cell);
-          REIS(1, fwrite(&cell_average, sizeof(REF_DBL), 1, file), "cell avg");
+          RSS(ref_writer_dbl(ref_writer, cell_average), "cell avg");
         }
       }
     }
@@ -3259,9 +3257,8 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
         RSS(ref_mpi_gather_recv(ref_mpi, data, (REF_INT)(ldim * ncell_recv),
                                 REF_DBL_TYPE, proc),
             "send data");
-        REIS((size_t)(ldim * ncell_recv),
-             fwrite(data, sizeof(REF_DBL), (size_t)(ldim * ncell_recv), file),
-             "worker cell avg");
+        RSS(ref_writer_dbls(ref_writer, (REF_INT)(ldim * ncell_recv), data),
+            "worker cell avg");
         ref_free(data);
       }
     }
@@ -3292,17 +3289,23 @@ REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
     }
   }
 
-  if (ref_mpi_once(ref_mpi))
-    REIS(next_position, ftell(file), "solb metric record len inconsistent");
+  if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(next_position, position, "solb metric record len inconsistent");
+  }
 
   if (ref_mpi_once(ref_mpi)) { /* End */
     keyword_code = 54;
-    REIS(1, fwrite(&keyword_code, sizeof(int), 1, file), "end kw");
+    RSS(ref_writer_int(ref_writer, keyword_code), "end kw");
     next_position = 0;
-    RSS(ref_export_meshb_next_position(file, version, next_position), "next p");
+    RSS(ref_export_meshb_next_position(ref_writer, version, next_position),
+        "next p");
   }
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid)) {
+    RSS(ref_writer_free(ref_writer), "flush");
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
+  }
 
   return REF_SUCCESS;
 }
@@ -3337,9 +3340,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_pcd(REF_GRID ref_grid, REF_INT ldim,
 
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
     fprintf(file, "# .PCD v.7 - Point Cloud Data file format\n");
     fprintf(file, "VERSION .7\n");
     fprintf(file, "FIELDS x y z");
@@ -3368,7 +3369,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_pcd(REF_GRID ref_grid, REF_INT ldim,
       "text export");
 
   if (ref_grid_once(ref_grid)) {
-    fclose(file);
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
   }
 
   return REF_SUCCESS;
@@ -3387,9 +3388,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_tec(REF_GRID ref_grid, REF_INT ldim,
   REF_INT min_faceid, max_faceid, cell_id;
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
     fprintf(file, "title=\"tecplot refine gather\"\n");
     fprintf(file, "variables = \"x\" \"y\" \"z\"");
     if (NULL != scalar_names) {
@@ -3419,8 +3418,8 @@ REF_FCN static REF_STATUS ref_gather_scalar_tec(REF_GRID ref_grid, REF_INT ldim,
       }
       RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar, file),
           "nodes");
-      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c,
-                                 REF_FALSE, file),
+      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c, file,
+                                 NULL),
           "t");
     }
     ref_free(l2c);
@@ -3439,8 +3438,8 @@ REF_FCN static REF_STATUS ref_gather_scalar_tec(REF_GRID ref_grid, REF_INT ldim,
       }
       RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar, file),
           "nodes");
-      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c,
-                                 REF_FALSE, file),
+      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c, file,
+                                 NULL),
           "t");
     }
     ref_free(l2c);
@@ -3459,12 +3458,13 @@ REF_FCN static REF_STATUS ref_gather_scalar_tec(REF_GRID ref_grid, REF_INT ldim,
     }
     RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar, file),
         "nodes");
-    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_FALSE, file),
+    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, file, NULL),
         "t");
   }
   ref_free(l2c);
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
@@ -3484,9 +3484,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_edge_tec(REF_GRID ref_grid,
   REF_INT min_id, max_id, cell_id;
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
     fprintf(file, "title=\"tecplot refine gather\"\n");
     fprintf(file, "variables = \"x\" \"y\" \"z\"");
     if (NULL != scalar_names) {
@@ -3516,14 +3514,15 @@ REF_FCN static REF_STATUS ref_gather_scalar_edge_tec(REF_GRID ref_grid,
       }
       RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar, file),
           "nodes");
-      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c,
-                                 REF_FALSE, file),
+      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c, file,
+                                 NULL),
           "t");
     }
     ref_free(l2c);
   }
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
@@ -3541,9 +3540,7 @@ REF_FCN REF_STATUS ref_gather_scalar_surf_tec(REF_GRID ref_grid, REF_INT ldim,
   REF_INT min_faceid, max_faceid, cell_id;
   file = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
     fprintf(file, "title=\"tecplot refine gather\"\n");
     fprintf(file, "variables = \"x\" \"y\" \"z\"");
     if (NULL != scalar_names) {
@@ -3573,8 +3570,8 @@ REF_FCN REF_STATUS ref_gather_scalar_surf_tec(REF_GRID ref_grid, REF_INT ldim,
       }
       RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar, file),
           "nodes");
-      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c,
-                                 REF_FALSE, file),
+      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c, file,
+                                 NULL),
           "t");
     }
     ref_free(l2c);
@@ -3593,14 +3590,15 @@ REF_FCN REF_STATUS ref_gather_scalar_surf_tec(REF_GRID ref_grid, REF_INT ldim,
       }
       RSS(ref_gather_node_tec_part(ref_node, nnode, l2c, ldim, scalar, file),
           "nodes");
-      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c,
-                                 REF_FALSE, file),
+      RSS(ref_gather_cell_id_tec(ref_node, ref_cell, cell_id, ncell, l2c, file,
+                                 NULL),
           "t");
     }
     ref_free(l2c);
   }
 
-  if (ref_grid_once(ref_grid)) fclose(file);
+  if (ref_grid_once(ref_grid))
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
 
   return REF_SUCCESS;
 }
@@ -3618,7 +3616,8 @@ REF_FCN REF_STATUS ref_gather_plt_char_int(const char *char_string, REF_INT max,
 }
 
 REF_FCN static REF_STATUS ref_gather_plt_tri_header(REF_GRID ref_grid,
-                                                    REF_INT id, FILE *file) {
+                                                    REF_INT id,
+                                                    REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_CELL ref_cell = ref_grid_tri(ref_grid);
   char zonename[256];
@@ -3656,26 +3655,26 @@ REF_FCN static REF_STATUS ref_gather_plt_tri_header(REF_GRID ref_grid,
   numelements = (int)ncell;
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     snprintf(zonename, 256, "tri%d", id);
     RSS(ref_gather_plt_char_int(zonename, 256, &len, ascii), "a2i");
-    REIS(len, fwrite(&ascii, sizeof(int), (unsigned long)len, file), "title");
-
-    REIS(1, fwrite(&parentzone, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&strandid, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&solutiontime, sizeof(double), 1, file), "double");
-    REIS(1, fwrite(&notused, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&zonetype, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&datapacking, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varloc, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&faceneighbors, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numpts, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numelements, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&aux, sizeof(int), 1, file), "int");
+    RSS(ref_writer_ints(ref_writer, len, ascii), "title");
+
+    RSS(ref_writer_int(ref_writer, parentzone), "int");
+    RSS(ref_writer_int(ref_writer, strandid), "int");
+    RSS(ref_writer_dbl(ref_writer, solutiontime), "double");
+    RSS(ref_writer_int(ref_writer, notused), "int");
+    RSS(ref_writer_int(ref_writer, zonetype), "int");
+    RSS(ref_writer_int(ref_writer, datapacking), "int");
+    RSS(ref_writer_int(ref_writer, varloc), "int");
+    RSS(ref_writer_int(ref_writer, faceneighbors), "int");
+    RSS(ref_writer_int(ref_writer, numpts), "int");
+    RSS(ref_writer_int(ref_writer, numelements), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, aux), "int");
   }
 
   ref_free(l2c);
@@ -3683,7 +3682,8 @@ REF_FCN static REF_STATUS ref_gather_plt_tri_header(REF_GRID ref_grid,
 }
 
 REF_FCN static REF_STATUS ref_gather_plt_qua_header(REF_GRID ref_grid,
-                                                    REF_INT id, FILE *file) {
+                                                    REF_INT id,
+                                                    REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_CELL ref_cell = ref_grid_qua(ref_grid);
   char zonename[256];
@@ -3721,26 +3721,26 @@ REF_FCN static REF_STATUS ref_gather_plt_qua_header(REF_GRID ref_grid,
   numelements = (int)ncell;
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     snprintf(zonename, 256, "qua%d", id);
     RSS(ref_gather_plt_char_int(zonename, 256, &len, ascii), "a2i");
-    REIS(len, fwrite(&ascii, sizeof(int), (unsigned long)len, file), "title");
-
-    REIS(1, fwrite(&parentzone, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&strandid, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&solutiontime, sizeof(double), 1, file), "double");
-    REIS(1, fwrite(&notused, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&zonetype, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&datapacking, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varloc, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&faceneighbors, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numpts, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numelements, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&aux, sizeof(int), 1, file), "int");
+    RSS(ref_writer_ints(ref_writer, len, ascii), "title");
+
+    RSS(ref_writer_int(ref_writer, parentzone), "int");
+    RSS(ref_writer_int(ref_writer, strandid), "int");
+    RSS(ref_writer_dbl(ref_writer, solutiontime), "double");
+    RSS(ref_writer_int(ref_writer, notused), "int");
+    RSS(ref_writer_int(ref_writer, zonetype), "int");
+    RSS(ref_writer_int(ref_writer, datapacking), "int");
+    RSS(ref_writer_int(ref_writer, varloc), "int");
+    RSS(ref_writer_int(ref_writer, faceneighbors), "int");
+    RSS(ref_writer_int(ref_writer, numpts), "int");
+    RSS(ref_writer_int(ref_writer, numelements), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, aux), "int");
   }
 
   ref_free(l2c);
@@ -3748,7 +3748,7 @@ REF_FCN static REF_STATUS ref_gather_plt_qua_header(REF_GRID ref_grid,
 }
 
 REF_FCN static REF_STATUS ref_gather_plt_tet_header(REF_GRID ref_grid,
-                                                    FILE *file) {
+                                                    REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
   int ascii[8];
@@ -3783,27 +3783,27 @@ REF_FCN static REF_STATUS ref_gather_plt_tet_header(REF_GRID ref_grid,
   numelements = (int)ncell;
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     ascii[0] = (int)'e';
     ascii[1] = (int)'4';
     ascii[2] = 0;
-    REIS(3, fwrite(&ascii, sizeof(int), 3, file), "title");
-
-    REIS(1, fwrite(&parentzone, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&strandid, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&solutiontime, sizeof(double), 1, file), "double");
-    REIS(1, fwrite(&notused, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&zonetype, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&datapacking, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varloc, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&faceneighbors, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numpts, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numelements, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&aux, sizeof(int), 1, file), "int");
+    RSS(ref_writer_ints(ref_writer, 3, ascii), "title");
+
+    RSS(ref_writer_int(ref_writer, parentzone), "int");
+    RSS(ref_writer_int(ref_writer, strandid), "int");
+    RSS(ref_writer_dbl(ref_writer, solutiontime), "double");
+    RSS(ref_writer_int(ref_writer, notused), "int");
+    RSS(ref_writer_int(ref_writer, zonetype), "int");
+    RSS(ref_writer_int(ref_writer, datapacking), "int");
+    RSS(ref_writer_int(ref_writer, varloc), "int");
+    RSS(ref_writer_int(ref_writer, faceneighbors), "int");
+    RSS(ref_writer_int(ref_writer, numpts), "int");
+    RSS(ref_writer_int(ref_writer, numelements), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, aux), "int");
   }
 
   ref_free(l2c);
@@ -3812,7 +3812,7 @@ REF_FCN static REF_STATUS ref_gather_plt_tet_header(REF_GRID ref_grid,
 
 REF_FCN static REF_STATUS ref_gather_plt_brick_header(REF_GRID ref_grid,
                                                       REF_CELL ref_cell,
-                                                      FILE *file) {
+                                                      REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   char zonename[256];
   int ascii[256];
@@ -3848,26 +3848,26 @@ REF_FCN static REF_STATUS ref_gather_plt_brick_header(REF_GRID ref_grid,
   numelements = (int)ncell;
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     snprintf(zonename, 256, "brick%d", ref_cell_node_per(ref_cell));
     RSS(ref_gather_plt_char_int(zonename, 256, &len, ascii), "a2i");
-    REIS(len, fwrite(&ascii, sizeof(int), (unsigned long)len, file), "title");
-
-    REIS(1, fwrite(&parentzone, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&strandid, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&solutiontime, sizeof(double), 1, file), "double");
-    REIS(1, fwrite(&notused, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&zonetype, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&datapacking, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varloc, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&faceneighbors, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numpts, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&numelements, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&celldim, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&aux, sizeof(int), 1, file), "int");
+    RSS(ref_writer_ints(ref_writer, len, ascii), "title");
+
+    RSS(ref_writer_int(ref_writer, parentzone), "int");
+    RSS(ref_writer_int(ref_writer, strandid), "int");
+    RSS(ref_writer_dbl(ref_writer, solutiontime), "double");
+    RSS(ref_writer_int(ref_writer, notused), "int");
+    RSS(ref_writer_int(ref_writer, zonetype), "int");
+    RSS(ref_writer_int(ref_writer, datapacking), "int");
+    RSS(ref_writer_int(ref_writer, varloc), "int");
+    RSS(ref_writer_int(ref_writer, faceneighbors), "int");
+    RSS(ref_writer_int(ref_writer, numpts), "int");
+    RSS(ref_writer_int(ref_writer, numelements), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, celldim), "int");
+    RSS(ref_writer_int(ref_writer, aux), "int");
   }
 
   ref_free(l2c);
@@ -3876,7 +3876,7 @@ REF_FCN static REF_STATUS ref_gather_plt_brick_header(REF_GRID ref_grid,
 
 REF_FCN static REF_STATUS ref_gather_plt_tri_zone(REF_GRID ref_grid, REF_INT id,
                                                   REF_INT ldim, REF_DBL *scalar,
-                                                  FILE *file) {
+                                                  REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tri(ref_grid);
@@ -3904,15 +3904,15 @@ REF_FCN static REF_STATUS ref_gather_plt_tri_zone(REF_GRID ref_grid, REF_INT id,
     ref_mpi_stopwatch_stop(ref_mpi, "plt tri compact");
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     for (i = 0; i < 3 + ldim; i++) {
-      REIS(1, fwrite(&dataformat, sizeof(int), 1, file), "int");
+      RSS(ref_writer_int(ref_writer, dataformat), "int");
     }
 
-    REIS(1, fwrite(&passive, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varsharing, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&connsharing, sizeof(int), 1, file), "int");
+    RSS(ref_writer_int(ref_writer, passive), "int");
+    RSS(ref_writer_int(ref_writer, varsharing), "int");
+    RSS(ref_writer_int(ref_writer, connsharing), "int");
   }
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tri header");
@@ -3931,8 +3931,8 @@ REF_FCN static REF_STATUS ref_gather_plt_tri_zone(REF_GRID ref_grid, REF_INT id,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
   for (i = 0; i < ldim; i++) {
@@ -3949,21 +3949,21 @@ REF_FCN static REF_STATUS ref_gather_plt_tri_zone(REF_GRID ref_grid, REF_INT id,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tri minmax");
 
   RSS(ref_gather_node_tec_block(ref_node, nnode, l2c, ldim, scalar, dataformat,
-                                file),
+                                ref_writer),
       "block points");
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tri node");
 
-  RSS(ref_gather_cell_id_tec(ref_node, ref_cell, id, ncell, l2c, REF_TRUE,
-                             file),
+  RSS(ref_gather_cell_id_tec(ref_node, ref_cell, id, ncell, l2c, NULL,
+                             ref_writer),
       "c2n");
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tri cell");
@@ -3974,7 +3974,7 @@ REF_FCN static REF_STATUS ref_gather_plt_tri_zone(REF_GRID ref_grid, REF_INT id,
 
 REF_FCN static REF_STATUS ref_gather_plt_qua_zone(REF_GRID ref_grid, REF_INT id,
                                                   REF_INT ldim, REF_DBL *scalar,
-                                                  FILE *file) {
+                                                  REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_qua(ref_grid);
@@ -3997,15 +3997,15 @@ REF_FCN static REF_STATUS ref_gather_plt_qua_zone(REF_GRID ref_grid, REF_INT id,
   }
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     for (i = 0; i < 3 + ldim; i++) {
-      REIS(1, fwrite(&dataformat, sizeof(int), 1, file), "int");
+      RSS(ref_writer_int(ref_writer, dataformat), "int");
     }
 
-    REIS(1, fwrite(&passive, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varsharing, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&connsharing, sizeof(int), 1, file), "int");
+    RSS(ref_writer_int(ref_writer, passive), "int");
+    RSS(ref_writer_int(ref_writer, varsharing), "int");
+    RSS(ref_writer_int(ref_writer, connsharing), "int");
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++) {
@@ -4022,8 +4022,8 @@ REF_FCN static REF_STATUS ref_gather_plt_qua_zone(REF_GRID ref_grid, REF_INT id,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
   for (i = 0; i < ldim; i++) {
@@ -4040,26 +4040,185 @@ REF_FCN static REF_STATUS ref_gather_plt_qua_zone(REF_GRID ref_grid, REF_INT id,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
 
   RSS(ref_gather_node_tec_block(ref_node, nnode, l2c, ldim, scalar, dataformat,
-                                file),
+                                ref_writer),
       "block points");
 
-  RSS(ref_gather_cell_id_tec(ref_node, ref_cell, id, ncell, l2c, REF_TRUE,
-                             file),
+  RSS(ref_gather_cell_id_tec(ref_node, ref_cell, id, ncell, l2c, NULL,
+                             ref_writer),
       "c2n");
 
   ref_free(l2c);
   return REF_SUCCESS;
 }
 
+/* per-rank slices of the volume zone data, written at file offsets */
+typedef struct REF_GATHER_PIECES_STRUCT {
+  REF_INT n, max;
+  REF_FILEPOS *offset;
+  REF_SIZE *size;
+  REF_BYTE **data;
+} REF_GATHER_PIECES_STRUCT;
+typedef REF_GATHER_PIECES_STRUCT *REF_GATHER_PIECES;
+
+REF_FCN static REF_STATUS ref_gather_plt_skip(REF_MPI ref_mpi,
+                                              REF_WRITER ref_writer,
+                                              REF_SIZE bytes,
+                                              REF_FILEPOS *start) {
+  REF_LONG position = 0;
+  if (ref_mpi_once(ref_mpi)) {
+    REF_FILEPOS tell;
+    RSS(ref_writer_tell(ref_writer, &tell), "tell");
+    position = (REF_LONG)tell;
+    RSS(ref_writer_skip(ref_writer, bytes), "seek past rank slices");
+  }
+  RSS(ref_mpi_bcast(ref_mpi, &position, 1, REF_LONG_TYPE), "bcast position");
+  *start = (REF_FILEPOS)position;
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_gather_plt_node_pieces(
+    REF_NODE ref_node, REF_GLOB nnode, REF_GLOB *l2c, REF_INT ldim,
+    REF_DBL *scalar, REF_WRITER ref_writer, REF_GATHER_PIECES pieces) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_FILEPOS start;
+  REF_GLOB first, last;
+  REF_INT node, n, ivar;
+  REF_DBL *slice;
+
+  RAB(pieces->n + 3 + ldim <= pieces->max, "pieces overflow", {
+    printf("n %d ldim %d max %d\n", pieces->n, ldim, pieces->max);
+  });
+  RSS(ref_gather_plt_skip(ref_mpi, ref_writer,
+                          (REF_SIZE)nnode * (REF_SIZE)(3 + ldim) *
+                              sizeof(double),
+                          &start),
+      "skip");
+
+  /* compact numbering of owned nodes is contiguous on each rank */
+  n = 0;
+  first = nnode;
+  last = -1;
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    if (REF_EMPTY != l2c[node] && ref_node_owned(ref_node, node)) {
+      n++;
+      first = MIN(first, l2c[node]);
+      last = MAX(last, l2c[node]);
+    }
+  }
+  if (0 == n) first = 0;
+  RAB(0 == n || (REF_GLOB)n == last - first + 1, "owned l2c not contiguous", {
+    printf("n %d first " REF_GLOB_FMT " last " REF_GLOB_FMT "\n", n, first,
+           last);
+  });
+
+  for (ivar = 0; ivar < 3 + ldim; ivar++) {
+    ref_malloc(slice, n, REF_DBL);
+    for (node = 0; node < ref_node_max(ref_node); node++) {
+      if (REF_EMPTY != l2c[node] && ref_node_owned(ref_node, node)) {
+        if (ivar < 3) {
+          slice[l2c[node] - first] = ref_node_xyz(ref_node, ivar, node);
+        } else {
+          slice[l2c[node] - first] = scalar[(ivar - 3) + ldim * node];
+        }
+      }
+    }
+    pieces->offset[pieces->n] =
+        start + (REF_FILEPOS)(((REF_GLOB)ivar * nnode + first) *
+                              (REF_GLOB)sizeof(double));
+    pieces->size[pieces->n] = (REF_SIZE)n * sizeof(double);
+    pieces->data[pieces->n] = (REF_BYTE *)slice;
+    pieces->n++;
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_gather_plt_cell_pieces(
+    REF_NODE ref_node, REF_CELL ref_cell, REF_LONG ncell, REF_GLOB *l2c,
+    REF_BOOL as_brick, REF_WRITER ref_writer, REF_GATHER_PIECES pieces) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_INT node_per = ref_cell_node_per(ref_cell);
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_GLOB globals[REF_CELL_MAX_SIZE_PER];
+  REF_GLOB brick[8];
+  REF_INT width = (as_brick ? 8 : node_per);
+  REF_FILEPOS start;
+  REF_LONG first;
+  REF_INT cell, node, part, nlocal, proc, *counts;
+  int *c2n;
+
+  RAB(pieces->n < pieces->max, "pieces overflow",
+      { printf("n %d max %d\n", pieces->n, pieces->max); });
+  RSS(ref_gather_plt_skip(ref_mpi, ref_writer,
+                          (REF_SIZE)ncell * (REF_SIZE)width * sizeof(int),
+                          &start),
+      "skip");
+
+  nlocal = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
+    if (ref_mpi_rank(ref_mpi) == part) nlocal++;
+  }
+  ref_malloc(counts, ref_mpi_n(ref_mpi), REF_INT);
+  RSS(ref_mpi_allgather(ref_mpi, &nlocal, counts, REF_INT_TYPE), "counts");
+  first = 0;
+  for (proc = 0; proc < ref_mpi_rank(ref_mpi); proc++) first += counts[proc];
+  ref_free(counts);
+
+  ref_malloc(c2n, width * nlocal, int);
+  nlocal = 0;
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "part");
+    if (ref_mpi_rank(ref_mpi) != part) continue;
+    for (node = 0; node < node_per; node++) {
+      globals[node] = l2c[nodes[node]];
+    }
+    if (as_brick) {
+      switch (node_per) {
+        case 4:
+          REF_CELL_TEC_BRICK_TET(brick, globals);
+          break;
+        case 5:
+          REF_CELL_TEC_BRICK_PYR(brick, globals);
+          break;
+        case 6:
+          REF_CELL_TEC_BRICK_PRI(brick, globals);
+          break;
+        case 8:
+          REF_CELL_TEC_BRICK_HEX(brick, globals);
+          break;
+        default:
+          RSS(REF_IMPLEMENT, "wrong nodes per cell");
+          break;
+      }
+      for (node = 0; node < 8; node++)
+        c2n[node + 8 * nlocal] = (int)brick[node];
+    } else {
+      for (node = 0; node < node_per; node++)
+        c2n[node + node_per * nlocal] = (int)globals[node];
+    }
+    nlocal++;
+  }
+
+  pieces->offset[pieces->n] =
+      start + (REF_FILEPOS)(first * width * (REF_LONG)sizeof(int));
+  pieces->size[pieces->n] = (REF_SIZE)nlocal * (REF_SIZE)width * sizeof(int);
+  pieces->data[pieces->n] = (REF_BYTE *)c2n;
+  pieces->n++;
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_gather_plt_tet_zone(REF_GRID ref_grid,
                                                   REF_INT ldim, REF_DBL *scalar,
-                                                  FILE *file) {
+                                                  REF_GATHER_PIECES pieces,
+                                                  REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
@@ -4086,15 +4245,15 @@ REF_FCN static REF_STATUS ref_gather_plt_tet_zone(REF_GRID ref_grid,
     ref_mpi_stopwatch_stop(ref_mpi, "plt tet compact");
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     for (i = 0; i < 3 + ldim; i++) {
-      REIS(1, fwrite(&dataformat, sizeof(int), 1, file), "int");
+      RSS(ref_writer_int(ref_writer, dataformat), "int");
     }
 
-    REIS(1, fwrite(&passive, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varsharing, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&connsharing, sizeof(int), 1, file), "int");
+    RSS(ref_writer_int(ref_writer, passive), "int");
+    RSS(ref_writer_int(ref_writer, varsharing), "int");
+    RSS(ref_writer_int(ref_writer, connsharing), "int");
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++) {
@@ -4111,8 +4270,8 @@ REF_FCN static REF_STATUS ref_gather_plt_tet_zone(REF_GRID ref_grid,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
   for (i = 0; i < ldim; i++) {
@@ -4129,21 +4288,33 @@ REF_FCN static REF_STATUS ref_gather_plt_tet_zone(REF_GRID ref_grid,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tet min/max");
 
-  RSS(ref_gather_node_tec_block(ref_node, nnode, l2c, ldim, scalar, dataformat,
-                                file),
-      "block points");
+  if (NULL != (void *)pieces) {
+    RSS(ref_gather_plt_node_pieces(ref_node, nnode, l2c, ldim, scalar,
+                                   ref_writer, pieces),
+        "node pieces");
+  } else {
+    RSS(ref_gather_node_tec_block(ref_node, nnode, l2c, ldim, scalar,
+                                  dataformat, ref_writer),
+        "block points");
+  }
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tet node");
 
-  RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, REF_TRUE, file),
-      "c2n");
+  if (NULL != (void *)pieces) {
+    RSS(ref_gather_plt_cell_pieces(ref_node, ref_cell, ncell, l2c, REF_FALSE,
+                                   ref_writer, pieces),
+        "cell pieces");
+  } else {
+    RSS(ref_gather_cell_tec(ref_node, ref_cell, ncell, l2c, NULL, ref_writer),
+        "c2n");
+  }
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt tet cell");
 
@@ -4155,7 +4326,8 @@ REF_FCN static REF_STATUS ref_gather_plt_brick_zone(REF_GRID ref_grid,
                                                     REF_CELL ref_cell,
                                                     REF_INT ldim,
                                                     REF_DBL *scalar,
-                                                    FILE *file) {
+                                                    REF_GATHER_PIECES pieces,
+                                                    REF_WRITER ref_writer) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   float zonemarker = 299.0;
@@ -4176,15 +4348,15 @@ REF_FCN static REF_STATUS ref_gather_plt_brick_zone(REF_GRID ref_grid,
   }
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&zonemarker, sizeof(float), 1, file), "zonemarker");
+    RSS(ref_writer_float(ref_writer, zonemarker), "zonemarker");
 
     for (i = 0; i < 3 + ldim; i++) {
-      REIS(1, fwrite(&dataformat, sizeof(int), 1, file), "int");
+      RSS(ref_writer_int(ref_writer, dataformat), "int");
     }
 
-    REIS(1, fwrite(&passive, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&varsharing, sizeof(int), 1, file), "int");
-    REIS(1, fwrite(&connsharing, sizeof(int), 1, file), "int");
+    RSS(ref_writer_int(ref_writer, passive), "int");
+    RSS(ref_writer_int(ref_writer, varsharing), "int");
+    RSS(ref_writer_int(ref_writer, connsharing), "int");
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++) {
@@ -4201,8 +4373,8 @@ REF_FCN static REF_STATUS ref_gather_plt_brick_zone(REF_GRID ref_grid,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
   for (i = 0; i < ldim; i++) {
@@ -4219,17 +4391,25 @@ REF_FCN static REF_STATUS ref_gather_plt_brick_zone(REF_GRID ref_grid,
     tempdata = maxdata;
     RSS(ref_mpi_max(ref_mpi, &tempdata, &maxdata, REF_DBL_TYPE), "mpi max");
     if (ref_mpi_once(ref_mpi)) {
-      REIS(1, fwrite(&mindata, sizeof(double), 1, file), "mindata");
-      REIS(1, fwrite(&maxdata, sizeof(double), 1, file), "maxdata");
+      RSS(ref_writer_dbl(ref_writer, mindata), "mindata");
+      RSS(ref_writer_dbl(ref_writer, maxdata), "maxdata");
     }
   }
 
-  RSS(ref_gather_node_tec_block(ref_node, nnode, l2c, ldim, scalar, dataformat,
-                                file),
-      "block points");
-
-  RSS(ref_gather_brick_tec(ref_node, ref_cell, ncell, l2c, REF_TRUE, file),
-      "c2n");
+  if (NULL != (void *)pieces) {
+    RSS(ref_gather_plt_node_pieces(ref_node, nnode, l2c, ldim, scalar,
+                                   ref_writer, pieces),
+        "node pieces");
+    RSS(ref_gather_plt_cell_pieces(ref_node, ref_cell, ncell, l2c, REF_TRUE,
+                                   ref_writer, pieces),
+        "cell pieces");
+  } else {
+    RSS(ref_gather_node_tec_block(ref_node, nnode, l2c, ldim, scalar,
+                                  dataformat, ref_writer),
+        "block points");
+    RSS(ref_gather_brick_tec(ref_node, ref_cell, ncell, l2c, ref_writer),
+        "c2n");
+  }
 
   ref_free(l2c);
   return REF_SUCCESS;
@@ -4243,44 +4423,62 @@ REF_FCN static REF_STATUS ref_gather_scalar_plt(REF_GRID ref_grid, REF_INT ldim,
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   FILE *file = NULL;
+  REF_WRITER ref_writer = NULL;
+  char magic[] = "#!TDV112";
   int one = 1;
   int filetype = 0;
   int ascii[1024];
   int i, len, numvar = 3 + ldim;
   float eohmarker = 357.0;
   REF_INT cell_id, min_faceid, max_faceid;
+  REF_GATHER_PIECES_STRUCT pieces_struct;
+  REF_GATHER_PIECES pieces = NULL;
+  REF_BOOL staged;
 
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "reset timing");
 
+  /* volume zones are written by each rank at its own offsets, unless rank 0
+   * stages the whole file in memory */
+  staged = (NULL != (void *)ref_gather_async(ref_grid_gather(ref_grid)));
+  RSS(ref_mpi_bcast(ref_mpi, &staged, 1, REF_INT_TYPE), "bcast staged");
+  if (ref_mpi_para(ref_mpi) && !staged) {
+    pieces = &pieces_struct;
+    pieces->n = 0;
+    pieces->max = 4 * (3 + ldim + 1);
+    ref_malloc(pieces->offset, pieces->max, REF_FILEPOS);
+    ref_malloc(pieces->size, pieces->max, REF_SIZE);
+    ref_malloc(pieces->data, pieces->max, REF_BYTE *);
+  }
+
   RSS(ref_node_synchronize_globals(ref_node), "sync");
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "header sync global");
 
   if (ref_mpi_once(ref_mpi)) {
-    file = fopen(filename, "w");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_gather_open(ref_grid, filename, &file), "open");
+
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "writer");
 
-    REIS(8, fwrite(&"#!TDV112", sizeof(char), 8, file), "header");
-    REIS(1, fwrite(&one, sizeof(int), 1, file), "magic");
-    REIS(1, fwrite(&filetype, sizeof(int), 1, file), "filetype");
+    RSS(ref_writer_bytes(ref_writer, 8, magic), "header");
+    RSS(ref_writer_int(ref_writer, one), "magic");
+    RSS(ref_writer_int(ref_writer, filetype), "filetype");
 
     ascii[0] = (int)'f';
     ascii[1] = (int)'t';
     ascii[2] = 0;
-    REIS(3, fwrite(&ascii, sizeof(int), 3, file), "title");
+    RSS(ref_writer_ints(ref_writer, 3, ascii), "title");
 
-    REIS(1, fwrite(&numvar, sizeof(int), 1, file), "numvar");
+    RSS(ref_writer_int(ref_writer, numvar), "numvar");
     ascii[0] = (int)'x';
     ascii[1] = 0;
-    REIS(2, fwrite(&ascii, sizeof(int), 2, file), "var");
+    RSS(ref_writer_ints(ref_writer, 2, ascii), "var");
     ascii[0] = (int)'y';
     ascii[1] = 0;
-    REIS(2, fwrite(&ascii, sizeof(int), 2, file), "var");
+    RSS(ref_writer_ints(ref_writer, 2, ascii), "var");
     ascii[0] = (int)'z';
     ascii[1] = 0;
-    REIS(2, fwrite(&ascii, sizeof(int), 2, file), "var");
+    RSS(ref_writer_ints(ref_writer, 2, ascii), "var");
     for (i = 0; i < ldim; i++) {
       len = 0;
       if (NULL == scalar_names) {
@@ -4290,7 +4488,7 @@ REF_FCN static REF_STATUS ref_gather_scalar_plt(REF_GRID ref_grid, REF_INT ldim,
       } else {
         RSS(ref_gather_plt_char_int(scalar_names[i], 1024, &len, ascii), "a2i");
       }
-      REIS(len, fwrite(&ascii, sizeof(int), (unsigned long)len, file), "var");
+      RSS(ref_writer_ints(ref_writer, len, ascii), "var");
     }
   }
 
@@ -4301,60 +4499,80 @@ REF_FCN static REF_STATUS ref_gather_scalar_plt(REF_GRID ref_grid, REF_INT ldim,
     ref_mpi_stopwatch_stop(ref_mpi, "header faceid range");
 
   for (cell_id = min_faceid; cell_id <= max_faceid; cell_id++) {
-    RSS(ref_gather_plt_tri_header(ref_grid, cell_id, file), "plt tri header");
-    RSS(ref_gather_plt_qua_header(ref_grid, cell_id, file), "plt qua header");
+    RSS(ref_gather_plt_tri_header(ref_grid, cell_id, ref_writer),
+        "plt tri header");
+    RSS(ref_gather_plt_qua_header(ref_grid, cell_id, ref_writer),
+        "plt qua header");
   }
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "header surf");
   if (as_brick) {
-    RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_tet(ref_grid), file),
+    RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_tet(ref_grid),
+                                    ref_writer),
         "plt tet brick header");
   } else {
-    RSS(ref_gather_plt_tet_header(ref_grid, file), "plt tet header");
+    RSS(ref_gather_plt_tet_header(ref_grid, ref_writer), "plt tet header");
   }
-  RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_pyr(ref_grid), file),
+  RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_pyr(ref_grid),
+                                  ref_writer),
       "plt pyr brick header");
-  RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_pri(ref_grid), file),
+  RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_pri(ref_grid),
+                                  ref_writer),
       "plt pri brick header");
-  RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_hex(ref_grid), file),
+  RSS(ref_gather_plt_brick_header(ref_grid, ref_grid_hex(ref_grid),
+                                  ref_writer),
       "plt hex brick header");
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "header vol");
 
   if (ref_mpi_once(ref_mpi)) {
-    REIS(1, fwrite(&eohmarker, sizeof(float), 1, file), "eohmarker");
+    RSS(ref_writer_float(ref_writer, eohmarker), "eohmarker");
   }
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "plt end of header");
 
   for (cell_id = min_faceid; cell_id <= max_faceid; cell_id++) {
-    RSS(ref_gather_plt_tri_zone(ref_grid, cell_id, ldim, scalar, file),
+    RSS(ref_gather_plt_tri_zone(ref_grid, cell_id, ldim, scalar, ref_writer),
         "plt tri zone");
-    RSS(ref_gather_plt_qua_zone(ref_grid, cell_id, ldim, scalar, file),
+    RSS(ref_gather_plt_qua_zone(ref_grid, cell_id, ldim, scalar, ref_writer),
         "plt qua zone");
   }
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "surf zone");
 
   if (as_brick) {
     RSS(ref_gather_plt_brick_zone(ref_grid, ref_grid_tet(ref_grid), ldim,
-                                  scalar, file),
+                                  scalar, pieces, ref_writer),
         "plt tet brick zone");
   } else {
-    RSS(ref_gather_plt_tet_zone(ref_grid, ldim, scalar, file), "surf zone");
+    RSS(ref_gather_plt_tet_zone(ref_grid, ldim, scalar, pieces, ref_writer),
+        "surf zone");
   }
   RSS(ref_gather_plt_brick_zone(ref_grid, ref_grid_pyr(ref_grid), ldim, scalar,
-                                file),
+                                pieces, ref_writer),
       "plt pyr brick zone");
   RSS(ref_gather_plt_brick_zone(ref_grid, ref_grid_pri(ref_grid), ldim, scalar,
-                                file),
+                                pieces, ref_writer),
       "plt pri brick zone");
   RSS(ref_gather_plt_brick_zone(ref_grid, ref_grid_hex(ref_grid), ldim, scalar,
-                                file),
+                                pieces, ref_writer),
       "plt hex brick zone");
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "vol zone");
 
   if (ref_mpi_once(ref_mpi)) {
-    fclose(file);
+    RSS(ref_writer_free(ref_writer), "flush");
+    RSS(ref_gather_close(ref_grid, filename, file), "close");
+  }
+
+  if (NULL != (void *)pieces) {
+    RSS(ref_mpi_write_at_all(ref_mpi, filename, pieces->n, pieces->offset,
+                             pieces->size, pieces->data),
+        "write rank slices");
+    for (i = 0; i < pieces->n; i++) ref_free(pieces->data[i]);
+    ref_free(pieces->data);
+    ref_free(pieces->size);
+    ref_free(pieces->offset);
+    if (0 < ref_mpi_timing(ref_mpi))
+      ref_mpi_stopwatch_stop(ref_mpi, "vol slices");
   }
 
   return REF_SUCCESS;
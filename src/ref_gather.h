@@ -27,6 +27,7 @@ typedef struct REF_GATHER_STRUCT REF_GATHER_STRUCT;
 typedef REF_GATHER_STRUCT *REF_GATHER;
 END_C_DECLORATION
 
+#include "ref_async.h"
 #include "ref_cell.h"
 #include "ref_geom.h"
 #include "ref_grid.h"
@@ -41,10 +42,13 @@ struct REF_GATHER_STRUCT {
   REF_DBL time;
   REF_BOOL low_quality_zone;
   REF_DBL min_quality;
+  REF_ASYNC async;
 };
 
 #define ref_gather_low_quality_zone(ref_gather) ((ref_gather)->low_quality_zone)
 #define ref_gather_min_quality(ref_gather) ((ref_gather)->min_quality)
+/* when set (not owned), files are staged in memory and written by async */
+#define ref_gather_async(ref_gather) ((ref_gather)->async)
 
 REF_FCN REF_STATUS ref_gather_create(REF_GATHER *ref_gather);
 REF_FCN REF_STATUS ref_gather_free(REF_GATHER ref_gather);
@@ -62,6 +66,14 @@ REF_FCN REF_STATUS ref_gather_tec_part(REF_GRID ref_grid, const char *filename);
 REF_FCN REF_STATUS ref_gather_by_extension(REF_GRID ref_grid,
                                            const char *filename);
 
+/* meshb with node log metric, aux, age, part, and adapt settings,
+ * version 3 added active_region, version 2 is read with it off */
+#define REF_GATHER_CHECKPOINT_VERSION (3)
+/* version, ranks, naux, curvature metric ahead of the adapt settings */
+#define REF_GATHER_CHECKPOINT_HEADER (4)
+REF_FCN REF_STATUS ref_gather_checkpoint(REF_GRID ref_grid,
+                                         REF_BOOL curvature_metric,
+                                         const char *filename);
 REF_FCN REF_STATUS ref_gather_metric(REF_GRID ref_grid, const char *filename);
 
 REF_FCN REF_STATUS ref_gather_scalar_cell_solb(REF_GRID ref_grid, REF_INT ldim,
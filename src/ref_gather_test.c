@@ -26,7 +26,9 @@
 
 #include "ref_adj.h"
 #include "ref_args.h"
+#include "ref_async.h"
 #include "ref_cell.h"
+#include "ref_compress.h"
 #include "ref_dict.h"
 #include "ref_edge.h"
 #include "ref_export.h"
@@ -42,6 +44,78 @@
 #include "ref_part.h"
 #include "ref_sort.h"
 
+/* point and cell counts of a .vtu piece with the owned, not ghost, counts */
+REF_FCN static REF_STATUS ref_gather_test_vtu_owned(const char *filename,
+                                                    REF_INT *npoint,
+                                                    REF_INT *owned_point,
+                                                    REF_INT *ncell,
+                                                    REF_INT *owned_cell) {
+  FILE *file;
+  char *contents, *data;
+  const char *appended = "<AppendedData encoding=\"raw\">\n_";
+  long length;
+  REF_LONG size;
+  REF_INT i;
+  file = fopen(filename, "rb");
+  RNS(file, "unable to open piece");
+  REIS(0, fseek(file, 0, SEEK_END), "end");
+  length = ftell(file);
+  REIS(0, fseek(file, 0, SEEK_SET), "start");
+  ref_malloc(contents, length + 1, char);
+  REIS(length, fread(contents, sizeof(char), (size_t)length, file), "read");
+  contents[length] = '\0';
+  REIS(0, fclose(file), "close");
+
+  data = strstr(contents, "NumberOfPoints=\"");
+  RNS(data, "NumberOfPoints missing");
+  REIS(2, sscanf(data, "NumberOfPoints=\"%d\" NumberOfCells=\"%d\"", npoint,
+                 ncell),
+       "piece counts");
+  data = strstr(contents, appended);
+  RNS(data, "appended data missing");
+  data += strlen(appended);
+
+  memcpy(&size, data, sizeof(REF_LONG));
+  data += sizeof(REF_LONG);
+  REIS(*npoint, size, "point ghost bytes");
+  *owned_point = 0;
+  for (i = 0; i < *npoint; i++) {
+    RAS(0 == data[i] || 1 == data[i], "point ghost flag");
+    if (0 == data[i]) (*owned_point)++;
+  }
+  data += *npoint;
+
+  memcpy(&size, data, sizeof(REF_LONG));
+  data += sizeof(REF_LONG);
+  REIS(*ncell, size, "cell ghost bytes");
+  *owned_cell = 0;
+  for (i = 0; i < *ncell; i++) {
+    RAS(0 == data[i] || 1 == data[i], "cell ghost flag");
+    if (0 == data[i]) (*owned_cell)++;
+  }
+
+  ref_free(contents);
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_gather_test_same_file(const char *filename1,
+                                                    const char *filename2) {
+  FILE *file1, *file2;
+  int char1, char2;
+  file1 = fopen(filename1, "rb");
+  RNS(file1, "unable to open file1");
+  file2 = fopen(filename2, "rb");
+  RNS(file2, "unable to open file2");
+  do {
+    char1 = fgetc(file1);
+    char2 = fgetc(file2);
+    REIS(char1, char2, "files differ");
+  } while (EOF != char1);
+  REIS(0, fclose(file2), "close");
+  REIS(0, fclose(file1), "close");
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_gather_meshb_fixture(REF_MPI ref_mpi,
                                                    const char *filename,
                                                    REF_INT version) {
@@ -516,6 +590,166 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  { /* pieces of tet brick .pvtu */
+    REF_GRID seq_grid, para_grid;
+    char seq_file[] = "ref_gather_test_pvtu.lb8.ugrid";
+    char para_file[] = "ref_gather_test_para.pvtu";
+    char piece[1024];
+    REF_INT npoint, owned_point, ncell, owned_cell, owned, node;
+    REF_LONG ntet, ntri;
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_tet_brick_grid(&seq_grid, ref_mpi), "set up tet");
+      RSS(ref_export_by_extension(seq_grid, seq_file), "export");
+      RSS(ref_grid_free(seq_grid), "free");
+    }
+    RSS(ref_part_by_extension(&para_grid, ref_mpi, seq_file), "part");
+    RSS(ref_gather_by_extension(para_grid, para_file), "gather");
+    RSS(ref_node_synchronize_globals(ref_grid_node(para_grid)), "sync");
+    RSS(ref_cell_ncell(ref_grid_tet(para_grid), ref_grid_node(para_grid),
+                       &ntet),
+        "global tets");
+    RSS(ref_cell_ncell(ref_grid_tri(para_grid), ref_grid_node(para_grid),
+                       &ntri),
+        "global tris");
+    snprintf(piece, 1024, "ref_gather_test_para_%d.vtu", ref_mpi_rank(ref_mpi));
+    RSS(ref_gather_test_vtu_owned(piece, &npoint, &owned_point, &ncell,
+                                  &owned_cell),
+        "parse piece");
+    REIS(ref_node_n(ref_grid_node(para_grid)), npoint, "piece points");
+    REIS(ref_cell_n(ref_grid_tet(para_grid)) +
+             ref_cell_n(ref_grid_tri(para_grid)),
+         ncell, "piece cells");
+    owned = 0;
+    each_ref_node_valid_node(ref_grid_node(para_grid), node) {
+      if (ref_node_owned(ref_grid_node(para_grid), node)) owned++;
+    }
+    REIS(owned, owned_point, "owned points");
+    RSS(ref_mpi_allsum(ref_mpi, &owned_point, 1, REF_INT_TYPE), "sum");
+    REIS(ref_node_n_global(ref_grid_node(para_grid)), owned_point,
+         "owned points partition the grid");
+    RSS(ref_mpi_allsum(ref_mpi, &owned_cell, 1, REF_INT_TYPE), "sum");
+    REIS(ntet + ntri, owned_cell, "owned cells partition the grid");
+    RSS(ref_grid_free(para_grid), "free");
+    REIS(0, remove(piece), "test clean up");
+    if (ref_mpi_once(ref_mpi)) {
+      REIS(0, remove(seq_file), "test clean up");
+      REIS(0, remove(para_file), "test clean up");
+    }
+  }
+
+  { /* rank slices of .plt match the gathered write */
+    REF_GRID seq_grid, para_grid;
+    REF_ASYNC ref_async = NULL;
+    char seq_file[] = "ref_gather_test_plt.lb8.ugrid";
+    char direct[2][1024] = {"ref_gather_test_direct.plt",
+                            "ref_gather_test_direct-brick.plt"};
+    char staged[2][1024] = {"ref_gather_test_staged.plt",
+                            "ref_gather_test_staged-brick.plt"};
+    const char *scalar_names[] = {"rank", "x2"};
+    REF_INT ldim = 2, node, i;
+    REF_DBL *scalar;
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_tet_brick_grid(&seq_grid, ref_mpi), "set up tet");
+      RSS(ref_export_by_extension(seq_grid, seq_file), "export");
+      RSS(ref_grid_free(seq_grid), "free");
+    }
+    RSS(ref_part_by_extension(&para_grid, ref_mpi, seq_file), "part");
+    ref_malloc(scalar, ldim * ref_node_max(ref_grid_node(para_grid)), REF_DBL);
+    each_ref_node_valid_node(ref_grid_node(para_grid), node) {
+      scalar[0 + ldim * node] = (REF_DBL)ref_mpi_rank(ref_mpi);
+      scalar[1 + ldim * node] =
+          2.0 * ref_node_xyz(ref_grid_node(para_grid), 0, node);
+    }
+    for (i = 0; i < 2; i++) {
+      RSS(ref_gather_scalar_by_extension(para_grid, ldim, scalar, scalar_names,
+                                         direct[i]),
+          "direct");
+    }
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_async_create(&ref_async), "async");
+      ref_gather_async(ref_grid_gather(para_grid)) = ref_async;
+    }
+    for (i = 0; i < 2; i++) {
+      RSS(ref_gather_scalar_by_extension(para_grid, ldim, scalar, scalar_names,
+                                         staged[i]),
+          "staged");
+    }
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_async_free(ref_async), "free async");
+      ref_gather_async(ref_grid_gather(para_grid)) = NULL;
+      for (i = 0; i < 2; i++) {
+        RSS(ref_gather_test_same_file(direct[i], staged[i]), "same");
+        REIS(0, remove(direct[i]), "test clean up");
+        REIS(0, remove(staged[i]), "test clean up");
+      }
+      REIS(0, remove(seq_file), "test clean up");
+    }
+    ref_free(scalar);
+    RSS(ref_grid_free(para_grid), "free");
+  }
+
+  { /* packed .solb round trip through ref_part_scalar */
+    REF_GRID seq_grid, para_grid;
+    REF_ASYNC ref_async = NULL;
+    char seq_file[] = "ref_gather_test_packed.lb8.ugrid";
+    char solb_file[] = "ref_gather_test_packed.solb";
+    REF_INT ldim = 3, read_ldim, node, i;
+    REF_DBL *scalar, *read_scalar;
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_tet_brick_grid(&seq_grid, ref_mpi), "set up tet");
+      RSS(ref_export_by_extension(seq_grid, seq_file), "export");
+      RSS(ref_grid_free(seq_grid), "free");
+    }
+    RSS(ref_part_by_extension(&para_grid, ref_mpi, seq_file), "part");
+    ref_malloc(scalar, ldim * ref_node_max(ref_grid_node(para_grid)), REF_DBL);
+    each_ref_node_valid_node(ref_grid_node(para_grid), node) {
+      for (i = 0; i < ldim; i++) {
+        scalar[i + ldim * node] =
+            (REF_DBL)(i + 1) * ref_node_xyz(ref_grid_node(para_grid), i, node);
+      }
+    }
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_async_create(&ref_async), "async");
+      ref_async_compress(ref_async) = REF_TRUE;
+      ref_gather_async(ref_grid_gather(para_grid)) = ref_async;
+    }
+    RSS(ref_gather_scalar_by_extension(para_grid, ldim, scalar, NULL,
+                                       solb_file),
+        "packed");
+    if (ref_mpi_once(ref_mpi)) {
+      FILE *file;
+      REF_BYTE magic[REF_COMPRESS_MAGIC_SIZE];
+      REF_BOOL compressed;
+      RSS(ref_async_free(ref_async), "free async");
+      ref_gather_async(ref_grid_gather(para_grid)) = NULL;
+      file = fopen(solb_file, "r");
+      RNS(file, "unable to open file");
+      REIS(REF_COMPRESS_MAGIC_SIZE,
+           fread(magic, sizeof(REF_BYTE), REF_COMPRESS_MAGIC_SIZE, file),
+           "magic");
+      REIS(0, fclose(file), "close");
+      RSS(ref_compress_detect(magic, REF_COMPRESS_MAGIC_SIZE, &compressed),
+          "detect");
+      RAS(compressed, "solb not packed");
+    }
+    RSS(ref_part_scalar(para_grid, &read_ldim, &read_scalar, solb_file),
+        "read packed");
+    REIS(ldim, read_ldim, "ldim");
+    each_ref_node_valid_node(ref_grid_node(para_grid), node) {
+      for (i = 0; i < ldim; i++) {
+        RWDS(scalar[i + ldim * node], read_scalar[i + ldim * node], -1.0,
+             "field");
+      }
+    }
+    ref_free(read_scalar);
+    ref_free(scalar);
+    RSS(ref_grid_free(para_grid), "free");
+    if (ref_mpi_once(ref_mpi)) {
+      REIS(0, remove(solb_file), "test clean up");
+      REIS(0, remove(seq_file), "test clean up");
+    }
+  }
+
   { /* recycle tet brick b8.ugrid */
     REF_GRID seq_grid = NULL, para_grid;
     char seq_file[] = "ref_gather_test_seq.b8.ugrid";
@@ -50,10 +50,13 @@ REF_FCN REF_STATUS ref_grid_create(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi) {
   RSS(ref_gather_create(&ref_grid_gather(ref_grid)), "gather create");
   RSS(ref_adapt_create(&(ref_grid->adapt)), "adapt create");
   ref_grid_interp(ref_grid) = NULL;
+  ref_grid_recon(ref_grid) = NULL;
 
   ref_grid_partitioner(ref_grid) = REF_MIGRATE_RECOMMENDED;
   ref_grid_partitioner_seed(ref_grid) = 0;
   ref_grid_partitioner_full(ref_grid) = REF_FALSE;
+  ref_grid_partitioner_work(ref_grid) = REF_FALSE;
+  ref_grid_partitioner_imbalance(ref_grid) = 0.0;
 
   ref_grid_meshb_version(ref_grid) = 0;
   ref_grid_coordinate_system(ref_grid) = REF_GRID_XBYRZU;
@@ -103,10 +106,14 @@ REF_FCN REF_STATUS ref_grid_deep_copy(REF_GRID *ref_grid_ptr,
       "adapt deep copy");
 
   ref_grid_interp(ref_grid) = NULL;
+  ref_grid_recon(ref_grid) = NULL;
 
   ref_grid_partitioner(ref_grid) = ref_grid_partitioner(original);
   ref_grid_partitioner_seed(ref_grid) = 0;
   ref_grid_partitioner_full(ref_grid) = ref_grid_partitioner_full(original);
+  ref_grid_partitioner_work(ref_grid) = ref_grid_partitioner_work(original);
+  ref_grid_partitioner_imbalance(ref_grid) =
+      ref_grid_partitioner_imbalance(original);
 
   ref_grid_meshb_version(ref_grid) = 0;
   ref_grid_coordinate_system(ref_grid) = ref_grid_coordinate_system(original);
@@ -200,6 +207,10 @@ REF_FCN REF_STATUS ref_grid_free(REF_GRID ref_grid) {
     RSS(ref_interp_free(ref_grid->interp), "interp free");
   }
 
+  if (NULL != (void *)ref_grid_recon(ref_grid)) {
+    RSS(ref_recon_free(ref_grid_recon(ref_grid)), "recon free");
+  }
+
   RSS(ref_adapt_free(ref_grid->adapt), "adapt free");
   RSS(ref_gather_free(ref_grid_gather(ref_grid)), "gather free");
   RSS(ref_geom_free(ref_grid_geom(ref_grid)), "geom free");
@@ -257,6 +268,8 @@ REF_FCN REF_STATUS ref_grid_inspect(REF_GRID ref_grid) {
   printf(" %d partitioner\n", (int)(ref_grid->partitioner));
   printf(" %d partitioner seed\n", (int)(ref_grid->partitioner_seed));
   printf(" %d partitioner full\n", (int)(ref_grid->partitioner_full));
+  printf(" %d partitioner work\n", (int)(ref_grid->partitioner_work));
+  printf(" %f partitioner imbalance\n", ref_grid->partitioner_imbalance);
   printf(" %d mesb_version\n", (ref_grid->meshb_version));
   printf(" %d twod\n", (ref_grid->twod));
   printf(" %d surf\n", (ref_grid->surf));
@@ -872,6 +885,23 @@ REF_FCN REF_STATUS ref_grid_node_list_around(REF_GRID ref_grid, REF_INT node,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_grid_touch(REF_GRID ref_grid, REF_INT node) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT cell, item, cell_node, group;
+  REF_CELL ref_cell;
+
+  ref_node_touch(ref_node, node);
+  each_ref_grid_2d_3d_ref_cell(ref_grid, group, ref_cell) {
+    each_ref_cell_having_node(ref_cell, node, item, cell) {
+      each_ref_cell_cell_node(ref_cell, cell_node) {
+        ref_node_touch(ref_node, ref_cell_c2n(ref_cell, cell_node, cell));
+      }
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_grid_exhaustive_enclosing_tet(REF_GRID ref_grid,
                                                             REF_DBL *xyz,
                                                             REF_INT *tet,
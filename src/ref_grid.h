@@ -35,6 +35,7 @@ END_C_DECLORATION
 #include "ref_migrate.h"
 #include "ref_mpi.h"
 #include "ref_node.h"
+#include "ref_recon.h"
 
 BEGIN_C_DECLORATION
 
@@ -60,10 +61,13 @@ struct REF_GRID_STRUCT {
   REF_ADAPT adapt;
 
   REF_INTERP interp;
+  REF_RECON recon;
 
   REF_MIGRATE_PARTIONER partitioner;
   REF_INT partitioner_seed;
   REF_BOOL partitioner_full;
+  REF_BOOL partitioner_work;
+  REF_DBL partitioner_imbalance;
 
   REF_INT meshb_version;
   REF_GRID_COORDSYS coordinate_system;
@@ -109,6 +113,7 @@ REF_FCN REF_STATUS ref_grid_pack(REF_GRID ref_grid);
 #define ref_grid_gather(ref_grid) ((ref_grid)->gather)
 #define ref_grid_adapt(ref_grid, param) (((ref_grid)->adapt)->param)
 #define ref_grid_interp(ref_grid) ((ref_grid)->interp)
+#define ref_grid_recon(ref_grid) ((ref_grid)->recon)
 #define ref_grid_background(ref_grid)  \
   ((NULL == ref_grid_interp(ref_grid)) \
        ? NULL                          \
@@ -117,6 +122,9 @@ REF_FCN REF_STATUS ref_grid_pack(REF_GRID ref_grid);
 #define ref_grid_partitioner(ref_grid) ((ref_grid)->partitioner)
 #define ref_grid_partitioner_seed(ref_grid) ((ref_grid)->partitioner_seed)
 #define ref_grid_partitioner_full(ref_grid) ((ref_grid)->partitioner_full)
+#define ref_grid_partitioner_work(ref_grid) ((ref_grid)->partitioner_work)
+#define ref_grid_partitioner_imbalance(ref_grid) \
+  ((ref_grid)->partitioner_imbalance)
 
 #define ref_grid_meshb_version(ref_grid) ((ref_grid)->meshb_version)
 #define ref_grid_coordinate_system(ref_grid) ((ref_grid)->coordinate_system)
@@ -206,6 +214,8 @@ REF_FCN REF_STATUS ref_grid_orient_twod(REF_GRID ref_grid);
 REF_FCN REF_STATUS ref_grid_node_list_around(REF_GRID ref_grid, REF_INT node,
                                              REF_INT max_node, REF_INT *nnode,
                                              REF_INT *node_list);
+/* adds node and its neighbors to the active set of this sweep */
+REF_FCN REF_STATUS ref_grid_touch(REF_GRID ref_grid, REF_INT node);
 
 REF_FCN REF_STATUS ref_grid_enclosing_tet(REF_GRID ref_grid, REF_DBL *xyz,
                                           REF_INT *tet, REF_DBL *bary);
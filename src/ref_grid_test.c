@@ -292,6 +292,35 @@ int main(int argc, char *argv[]) {
     RSS(ref_grid_free(ref_grid), "cleanup");
   }
 
+  if (!ref_mpi_para(ref_mpi)) { /* touch activates node and neighbors */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_INT node, nnode, list[100], i, far;
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+    ref_node = ref_grid_node(ref_grid);
+    RAS(ref_node_active(ref_node, 0), "new nodes active");
+    ref_node_sweep(ref_node) += 2;
+    RAS(!ref_node_active(ref_node, 0), "untouched nodes inactive");
+
+    RSS(ref_grid_touch(ref_grid, 0), "touch");
+    RAS(ref_node_active(ref_node, 0), "touched");
+    RSS(ref_grid_node_list_around(ref_grid, 0, 100, &nnode, list), "around");
+    for (i = 0; i < nnode; i++)
+      RAS(ref_node_active(ref_node, list[i]), "neighbor");
+    far = REF_EMPTY;
+    each_ref_node_valid_node(ref_node, node) {
+      if (!ref_node_active(ref_node, node)) far = node;
+    }
+    RAS(REF_EMPTY != far, "far node active");
+
+    ref_node_sweep(ref_node)++;
+    RAS(ref_node_active(ref_node, 0), "touched last sweep");
+    ref_node_sweep(ref_node)++;
+    RAS(!ref_node_active(ref_node, 0), "touched two sweeps ago");
+
+    RSS(ref_grid_free(ref_grid), "cleanup");
+  }
+
   if (!ref_mpi_para(ref_mpi)) { /* single tet enclosing */
     REF_GRID ref_grid;
     REF_DBL xyz[3], bary[4];
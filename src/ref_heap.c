@@ -0,0 +1,113 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_heap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_malloc.h"
+
+REF_FCN REF_STATUS ref_heap_create(REF_HEAP *ref_heap_ptr) {
+  REF_HEAP ref_heap;
+
+  ref_malloc(*ref_heap_ptr, 1, REF_HEAP_STRUCT);
+
+  ref_heap = (*ref_heap_ptr);
+
+  ref_heap_n(ref_heap) = 0;
+  ref_heap_max(ref_heap) = 100;
+
+  ref_malloc(ref_heap->item, ref_heap_max(ref_heap), REF_INT);
+  ref_malloc(ref_heap->key, ref_heap_max(ref_heap), REF_DBL);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_heap_free(REF_HEAP ref_heap) {
+  if (NULL == (void *)ref_heap) return REF_NULL;
+  ref_free(ref_heap->key);
+  ref_free(ref_heap->item);
+  ref_free(ref_heap);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_heap_push(REF_HEAP ref_heap, REF_INT item,
+                                 REF_DBL key) {
+  REF_INT child, parent;
+
+  if (ref_heap_max(ref_heap) == ref_heap_n(ref_heap)) {
+    ref_heap_max(ref_heap) += MAX(1000, ref_heap_max(ref_heap) / 2);
+    ref_realloc(ref_heap->item, ref_heap_max(ref_heap), REF_INT);
+    ref_realloc(ref_heap->key, ref_heap_max(ref_heap), REF_DBL);
+  }
+
+  /* sift the hole up from the new leaf */
+  child = ref_heap_n(ref_heap);
+  ref_heap_n(ref_heap)++;
+  while (child > 0) {
+    parent = (child - 1) / 2;
+    if (ref_heap->key[parent] >= key) break;
+    ref_heap->item[child] = ref_heap->item[parent];
+    ref_heap->key[child] = ref_heap->key[parent];
+    child = parent;
+  }
+  ref_heap->item[child] = item;
+  ref_heap->key[child] = key;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_heap_pop(REF_HEAP ref_heap, REF_INT *item,
+                                REF_DBL *key) {
+  REF_INT parent, child, last;
+
+  if (0 == ref_heap_n(ref_heap)) {
+    *item = REF_EMPTY;
+    *key = 0.0;
+    return REF_FAILURE;
+  }
+
+  *item = ref_heap->item[0];
+  *key = ref_heap->key[0];
+
+  /* sift the last leaf down from the root */
+  ref_heap_n(ref_heap)--;
+  last = ref_heap_n(ref_heap);
+  parent = 0;
+  child = 1;
+  while (child < last) {
+    if (child + 1 < last && ref_heap->key[child + 1] > ref_heap->key[child])
+      child++;
+    if (ref_heap->key[last] >= ref_heap->key[child]) break;
+    ref_heap->item[parent] = ref_heap->item[child];
+    ref_heap->key[parent] = ref_heap->key[child];
+    parent = child;
+    child = 2 * parent + 1;
+  }
+  ref_heap->item[parent] = ref_heap->item[last];
+  ref_heap->key[parent] = ref_heap->key[last];
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_heap_erase(REF_HEAP ref_heap) {
+  ref_heap_n(ref_heap) = 0;
+  return REF_SUCCESS;
+}
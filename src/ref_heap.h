@@ -0,0 +1,53 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_HEAP_H
+#define REF_HEAP_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_HEAP_STRUCT REF_HEAP_STRUCT;
+typedef REF_HEAP_STRUCT *REF_HEAP;
+END_C_DECLORATION
+
+BEGIN_C_DECLORATION
+/* binary max-heap of items keyed by a double, an item may be pushed again
+ * with a new key and the caller skips the stale entries (lazy deletion) */
+struct REF_HEAP_STRUCT {
+  REF_INT n, max;
+  REF_INT *item;
+  REF_DBL *key;
+};
+
+REF_FCN REF_STATUS ref_heap_create(REF_HEAP *ref_heap);
+REF_FCN REF_STATUS ref_heap_free(REF_HEAP ref_heap);
+
+#define ref_heap_n(ref_heap) ((ref_heap)->n)
+#define ref_heap_max(ref_heap) ((ref_heap)->max)
+
+REF_FCN REF_STATUS ref_heap_push(REF_HEAP ref_heap, REF_INT item, REF_DBL key);
+/* largest key first, REF_FAILURE and REF_EMPTY item when empty */
+REF_FCN REF_STATUS ref_heap_pop(REF_HEAP ref_heap, REF_INT *item,
+                                REF_DBL *key);
+REF_FCN REF_STATUS ref_heap_erase(REF_HEAP ref_heap);
+
+END_C_DECLORATION
+
+#endif /* REF_HEAP_H */
@@ -0,0 +1,98 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_heap.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ref_mpi.h"
+
+int main(int argc, char *argv[]) {
+  REF_HEAP ref_heap;
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  {
+    REIS(REF_NULL, ref_heap_free(NULL), "dont free NULL");
+    RSS(ref_heap_create(&ref_heap), "create");
+    REIS(0, ref_heap_n(ref_heap), "init zero");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* pop empty */
+    REF_INT item;
+    REF_DBL key;
+    RSS(ref_heap_create(&ref_heap), "create");
+    REIS(REF_FAILURE, ref_heap_pop(ref_heap, &item, &key), "empty");
+    REIS(REF_EMPTY, item, "empty item");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* push pop one */
+    REF_INT item;
+    REF_DBL key;
+    RSS(ref_heap_create(&ref_heap), "create");
+    RSS(ref_heap_push(ref_heap, 27, 2.5), "push");
+    REIS(1, ref_heap_n(ref_heap), "has one");
+    RSS(ref_heap_pop(ref_heap, &item, &key), "pop");
+    REIS(27, item, "item");
+    RWDS(2.5, key, -1, "key");
+    REIS(0, ref_heap_n(ref_heap), "empty");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* largest first past growth, stale entries kept */
+    REF_INT i, n = 2500, item;
+    REF_DBL key, last;
+    RSS(ref_heap_create(&ref_heap), "create");
+    for (i = 0; i < n; i++) {
+      RSS(ref_heap_push(ref_heap, i, (REF_DBL)((7 * i) % n)), "push");
+    }
+    RSS(ref_heap_push(ref_heap, 3, 1.0e10), "repush");
+    REIS(n + 1, ref_heap_n(ref_heap), "all");
+    RSS(ref_heap_pop(ref_heap, &item, &key), "pop");
+    REIS(3, item, "repushed first");
+    last = key;
+    for (i = 0; i < n; i++) {
+      RSS(ref_heap_pop(ref_heap, &item, &key), "pop");
+      RAS(key <= last, "descending");
+      RWDS((REF_DBL)((7 * item) % n), key, -1, "key of item");
+      last = key;
+    }
+    REIS(0, ref_heap_n(ref_heap), "empty");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  { /* erase */
+    RSS(ref_heap_create(&ref_heap), "create");
+    RSS(ref_heap_push(ref_heap, 1, 1.0), "push");
+    RSS(ref_heap_push(ref_heap, 2, 2.0), "push");
+    RSS(ref_heap_erase(ref_heap), "erase");
+    REIS(0, ref_heap_n(ref_heap), "empty");
+    RSS(ref_heap_free(ref_heap), "free");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
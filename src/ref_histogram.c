@@ -380,17 +380,19 @@ REF_FCN REF_STATUS ref_histogram_add_ratio(REF_HISTOGRAM ref_histogram,
                                            REF_GRID ref_grid) {
   REF_EDGE ref_edge;
   REF_INT edge, part;
+  REF_DBL *edge_ratio;
   REF_DBL ratio;
 
   RSS(ref_edge_create(&ref_edge, ref_grid), "make edges");
+  ref_malloc(edge_ratio, ref_edge_n(ref_edge), REF_DBL);
+  RSS(ref_node_ratio_batch(ref_grid_node(ref_grid), ref_edge_n(ref_edge),
+                           ref_edge->e2n, edge_ratio),
+      "ratio");
 
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
     if (part == ref_mpi_rank(ref_grid_mpi(ref_grid))) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
+      ratio = edge_ratio[edge];
       RSB(ref_histogram_add(ref_histogram, ratio), "add", {
         printf("ratio %e at %f %f %f\n", ratio,
                ref_node_xyz(ref_grid_node(ref_grid), 0,
@@ -408,16 +410,14 @@ REF_FCN REF_STATUS ref_histogram_add_ratio(REF_HISTOGRAM ref_histogram,
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
     RSS(ref_edge_part(ref_edge, edge, &part), "edge part");
     if (part == ref_mpi_rank(ref_grid_mpi(ref_grid))) {
-      RSS(ref_node_ratio(ref_grid_node(ref_grid),
-                         ref_edge_e2n(ref_edge, 0, edge),
-                         ref_edge_e2n(ref_edge, 1, edge), &ratio),
-          "rat");
+      ratio = edge_ratio[edge];
       RSS(ref_histogram_add_stat(ref_histogram, ratio), "add");
     }
   }
   RSS(ref_histogram_gather_stat(ref_histogram, ref_grid_mpi(ref_grid)),
       "gather");
 
+  ref_free(edge_ratio);
   RSS(ref_edge_free(ref_edge), "free edge");
 
   return REF_SUCCESS;
@@ -428,26 +428,37 @@ REF_FCN REF_STATUS ref_histogram_add_quality(REF_HISTOGRAM ref_histogram,
   REF_CELL ref_cell;
   REF_INT cell;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-  REF_DBL quality;
+  REF_DBL quality, *cell_quality;
 
   if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
     ref_cell = ref_grid_tri(ref_grid);
   } else {
     ref_cell = ref_grid_tet(ref_grid);
   }
+  ref_malloc(cell_quality, ref_cell_max(ref_cell), REF_DBL);
+  if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
+    RSS(ref_node_tri_quality_block(ref_grid_node(ref_grid),
+                                   ref_cell_max(ref_cell),
+                                   &(ref_cell_c2n(ref_cell, 0, 0)),
+                                   ref_cell_size_per(ref_cell), cell_quality,
+                                   NULL),
+        "qual");
+  } else {
+    RSS(ref_node_tet_quality_block(ref_grid_node(ref_grid),
+                                   ref_cell_max(ref_cell),
+                                   &(ref_cell_c2n(ref_cell, 0, 0)),
+                                   ref_cell_size_per(ref_cell), cell_quality,
+                                   NULL),
+        "qual");
+  }
   each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
     if (ref_node_part(ref_grid_node(ref_grid), nodes[0]) ==
         ref_mpi_rank(ref_grid_mpi(ref_grid))) {
-      if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
-        RSS(ref_node_tri_quality(ref_grid_node(ref_grid), nodes, &quality),
-            "qual");
-      } else {
-        RSS(ref_node_tet_quality(ref_grid_node(ref_grid), nodes, &quality),
-            "qual");
-      }
+      quality = cell_quality[cell];
       if (quality > 0.0) RSS(ref_histogram_add(ref_histogram, quality), "add");
     }
   }
+  ref_free(cell_quality);
 
   RSS(ref_histogram_gather(ref_histogram, ref_grid_mpi(ref_grid)), "gather");
 
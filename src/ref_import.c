@@ -453,38 +453,28 @@ REF_FCN static REF_STATUS ref_import_surf(REF_GRID *ref_grid_ptr,
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_import_bin_ugrid_chunk(FILE *file, REF_BOOL swap,
+REF_FCN static REF_STATUS ref_import_bin_ugrid_chunk(REF_MMAP ref_mmap,
                                                      REF_BOOL fat, REF_INT n,
                                                      REF_INT *chunk) {
   REF_INT i;
   if (fat) {
     REF_LONG *actual;
     ref_malloc(actual, n, REF_LONG);
-    REIS(n, fread(actual, sizeof(REF_LONG), (size_t)(n), file), "long chunk");
-    if (swap) {
-      for (i = 0; i < n; i++) {
-        SWAP_LONG(actual[i]);
-      }
-    }
+    RSS(ref_mmap_longs(ref_mmap, n, actual), "long chunk");
     for (i = 0; i < n; i++) {
       chunk[i] = (REF_INT)actual[i];
     }
     ref_free(actual);
   } else {
-    REIS(n, fread(chunk, sizeof(REF_INT), (size_t)(n), file), "int chunk");
-    if (swap) {
-      for (i = 0; i < n; i++) {
-        SWAP_INT(chunk[i]);
-      }
-    }
+    RSS(ref_mmap_ints(ref_mmap, n, chunk), "int chunk");
   }
 
   return REF_SUCCESS;
 }
 
 REF_FCN static REF_STATUS ref_import_bin_ugrid_c2n(REF_CELL ref_cell,
-                                                   REF_INT ncell, FILE *file,
-                                                   REF_BOOL swap,
+                                                   REF_INT ncell,
+                                                   REF_MMAP ref_mmap,
                                                    REF_BOOL fat) {
   REF_INT node_per, max_chunk, nread, chunk, cell, node, new_cell;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
@@ -500,7 +490,7 @@ REF_FCN static REF_STATUS ref_import_bin_ugrid_c2n(REF_CELL ref_cell,
     nread = 0;
     while (nread < ncell) {
       chunk = MIN(max_chunk, ncell - nread);
-      RSS(ref_import_bin_ugrid_chunk(file, swap, fat, node_per * chunk, c2n),
+      RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, node_per * chunk, c2n),
           "c2n");
       for (cell = 0; cell < chunk; cell++) {
         for (node = 0; node < node_per; node++) {
@@ -518,7 +508,7 @@ REF_FCN static REF_STATUS ref_import_bin_ugrid_c2n(REF_CELL ref_cell,
 }
 
 REF_FCN static REF_STATUS ref_import_bin_ugrid_bound_tag(
-    REF_CELL ref_cell, REF_INT ncell, FILE *file, REF_BOOL swap, REF_BOOL fat) {
+    REF_CELL ref_cell, REF_INT ncell, REF_MMAP ref_mmap, REF_BOOL fat) {
   REF_INT node_per, max_chunk, nread, chunk, cell;
   REF_INT *tag;
 
@@ -529,7 +519,7 @@ REF_FCN static REF_STATUS ref_import_bin_ugrid_bound_tag(
     nread = 0;
     while (nread < ncell) {
       chunk = MIN(max_chunk, ncell - nread);
-      RSS(ref_import_bin_ugrid_chunk(file, swap, fat, chunk, tag), "tag");
+      RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, chunk, tag), "tag");
       for (cell = 0; cell < chunk; cell++) {
         ref_cell_c2n(ref_cell, node_per, nread + cell) = tag[cell];
       }
@@ -547,28 +537,26 @@ REF_FCN static REF_STATUS ref_import_bin_ugrid(REF_GRID *ref_grid_ptr,
                                                REF_BOOL swap, REF_BOOL fat) {
   REF_GRID ref_grid;
   REF_NODE ref_node;
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT nnode, ntri, nqua, ntet, npyr, npri, nhex;
 
   REF_INT node, new_node;
-  REF_INT max_chunk, nread, chunk, ixyz;
+  REF_INT max_chunk, nread, chunk;
   REF_DBL *xyz;
 
   RSS(ref_grid_create(ref_grid_ptr, ref_mpi), "create grid");
   ref_grid = (*ref_grid_ptr);
   ref_node = ref_grid_node(ref_grid);
 
-  file = fopen(filename, "r");
-  if (NULL == (void *)file) printf("unable to open %s\n", filename);
-  RNS(file, "unable to open file");
+  RSS(ref_mmap_create(&ref_mmap, filename, swap), "map");
 
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &nnode), "nnode");
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &ntri), "ntri");
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &nqua), "nqua");
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &ntet), "ntet");
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &npyr), "npyr");
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &npri), "npri");
-  RSS(ref_import_bin_ugrid_chunk(file, swap, fat, 1, &nhex), "nhex");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &nnode), "nnode");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &ntri), "ntri");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &nqua), "nqua");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &ntet), "ntet");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &npyr), "npyr");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &npri), "npri");
+  RSS(ref_import_bin_ugrid_chunk(ref_mmap, fat, 1, &nhex), "nhex");
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "ugrid header");
 
@@ -578,10 +566,7 @@ REF_FCN static REF_STATUS ref_import_bin_ugrid(REF_GRID *ref_grid_ptr,
   nread = 0;
   while (nread < nnode) {
     chunk = MIN(max_chunk, nnode - nread);
-    REIS(3 * chunk, fread(xyz, sizeof(REF_DBL), (size_t)(3 * chunk), file),
-         "xyz");
-    if (swap)
-      for (ixyz = 0; ixyz < 3 * chunk; ixyz++) SWAP_DBL(xyz[ixyz]);
+    RSS(ref_mmap_dbls(ref_mmap, 3 * chunk, xyz), "xyz");
     for (node = 0; node < chunk; node++) {
       RSS(ref_node_add(ref_node, node + nread, &new_node), "new_node");
       ref_node_xyz(ref_node, 0, new_node) = xyz[0 + 3 * node];
@@ -596,33 +581,33 @@ REF_FCN static REF_STATUS ref_import_bin_ugrid(REF_GRID *ref_grid_ptr,
   if (0 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "ugrid node");
 
-  RSS(ref_import_bin_ugrid_c2n(ref_grid_tri(ref_grid), ntri, file, swap, fat),
+  RSS(ref_import_bin_ugrid_c2n(ref_grid_tri(ref_grid), ntri, ref_mmap, fat),
       "tri face nodes");
-  RSS(ref_import_bin_ugrid_c2n(ref_grid_qua(ref_grid), nqua, file, swap, fat),
+  RSS(ref_import_bin_ugrid_c2n(ref_grid_qua(ref_grid), nqua, ref_mmap, fat),
       "qua face nodes");
 
-  RSS(ref_import_bin_ugrid_bound_tag(ref_grid_tri(ref_grid), ntri, file, swap,
+  RSS(ref_import_bin_ugrid_bound_tag(ref_grid_tri(ref_grid), ntri, ref_mmap,
                                      fat),
       "tri face tags");
-  RSS(ref_import_bin_ugrid_bound_tag(ref_grid_qua(ref_grid), nqua, file, swap,
+  RSS(ref_import_bin_ugrid_bound_tag(ref_grid_qua(ref_grid), nqua, ref_mmap,
                                      fat),
       "tri face tags");
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "ugrid tri");
 
-  RSS(ref_import_bin_ugrid_c2n(ref_grid_tet(ref_grid), ntet, file, swap, fat),
+  RSS(ref_import_bin_ugrid_c2n(ref_grid_tet(ref_grid), ntet, ref_mmap, fat),
       "tet face nodes");
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "ugrid tet");
-  RSS(ref_import_bin_ugrid_c2n(ref_grid_pyr(ref_grid), npyr, file, swap, fat),
+  RSS(ref_import_bin_ugrid_c2n(ref_grid_pyr(ref_grid), npyr, ref_mmap, fat),
       "pyr face nodes");
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "ugrid pyr");
-  RSS(ref_import_bin_ugrid_c2n(ref_grid_pri(ref_grid), npri, file, swap, fat),
+  RSS(ref_import_bin_ugrid_c2n(ref_grid_pri(ref_grid), npri, ref_mmap, fat),
       "pri face nodes");
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "ugrid pri");
-  RSS(ref_import_bin_ugrid_c2n(ref_grid_hex(ref_grid), nhex, file, swap, fat),
+  RSS(ref_import_bin_ugrid_c2n(ref_grid_hex(ref_grid), nhex, ref_mmap, fat),
       "hex face nodes");
   if (0 < ref_mpi_timing(ref_mpi)) ref_mpi_stopwatch_stop(ref_mpi, "ugrid hex");
 
-  fclose(file);
+  RSS(ref_mmap_free(ref_mmap), "unmap");
 
   return REF_SUCCESS;
 }
@@ -1369,31 +1354,32 @@ REF_FCN static REF_STATUS ref_import_i_like_cfd_grid(REF_GRID *ref_grid_ptr,
   return REF_SUCCESS;
 }
 
-static REF_STATUS meshb_real(FILE *file, REF_INT version, REF_DBL *real) {
+static REF_STATUS meshb_real(REF_MMAP ref_mmap, REF_INT version,
+                             REF_DBL *real) {
   float temp_float;
-  double temp_double;
 
   if (1 == version) {
-    REIS(1, fread(&temp_float, sizeof(temp_float), 1, file), "read float");
+    RSS(ref_mmap_bytes(ref_mmap, sizeof(temp_float), &temp_float),
+        "read float");
     *real = (REF_DBL)temp_float;
   } else {
-    REIS(1, fread(&temp_double, sizeof(temp_double), 1, file), "read double");
-    *real = (REF_DBL)temp_double;
+    RSS(ref_mmap_dbl(ref_mmap, real), "read double");
   }
 
   return REF_SUCCESS;
 }
 
-static REF_STATUS meshb_pos(FILE *file, REF_INT version, REF_FILEPOS *pos) {
-  int temp_int;
-  long temp_long;
+static REF_STATUS meshb_pos(REF_MMAP ref_mmap, REF_INT version,
+                            REF_FILEPOS *pos) {
+  REF_INT temp_int;
+  REF_LONG temp_long;
 
   if (3 <= version) {
-    REIS(1, fread(&temp_long, sizeof(temp_long), 1, file), "read long");
-    *pos = temp_long;
+    RSS(ref_mmap_long(ref_mmap, &temp_long), "read long");
+    *pos = (REF_FILEPOS)temp_long;
   } else {
-    REIS(1, fread(&temp_int, sizeof(temp_int), 1, file), "read double");
-    *pos = temp_int;
+    RSS(ref_mmap_int(ref_mmap, &temp_int), "read int");
+    *pos = (REF_FILEPOS)temp_int;
   }
 
   return REF_SUCCESS;
@@ -1401,8 +1387,17 @@ static REF_STATUS meshb_pos(FILE *file, REF_INT version, REF_FILEPOS *pos) {
 REF_FCN REF_STATUS ref_import_meshb_header(const char *filename,
                                            REF_INT *version,
                                            REF_FILEPOS *key_pos) {
-  FILE *file;
-  int int_code, int_version;
+  REF_MMAP ref_mmap;
+  RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+  RSS(ref_import_meshb_header_mmap(ref_mmap, version, key_pos), "header");
+  RSS(ref_mmap_free(ref_mmap), "unmap");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_import_meshb_header_mmap(REF_MMAP ref_mmap,
+                                                REF_INT *version,
+                                                REF_FILEPOS *key_pos) {
+  REF_INT int_code, int_version;
   REF_INT keyword_code;
   REF_FILEPOS position, next_position, end_position;
 
@@ -1410,53 +1405,34 @@ REF_FCN REF_STATUS ref_import_meshb_header(const char *filename,
        keyword_code++)
     key_pos[keyword_code] = REF_EMPTY;
 
-  file = fopen(filename, "r");
-  if (NULL == (void *)file) printf("unable to open %s\n", filename);
-  RNS(file, "unable to open file");
-
-  REIS(1, fread((unsigned char *)&int_code, 4, 1, file), "code");
+  RSS(ref_mmap_seek(ref_mmap, 0), "rewind");
+  RSS(ref_mmap_int(ref_mmap, &int_code), "code");
   REIS(1, int_code, "code");
-  REIS(1, fread((unsigned char *)&int_version, 4, 1, file), "version");
+  RSS(ref_mmap_int(ref_mmap, &int_version), "version");
   if (int_version < 1 || 4 < int_version) {
     printf("version %d not supported\n", int_version);
     THROW("version");
   }
-  *version = (REF_INT)int_version;
+  *version = int_version;
 
-  next_position = ftello(file);
-  REIS(0, fseeko(file, 0, SEEK_END), "fseeko END failed");
-  end_position = ftello(file);
+  next_position = ref_mmap_position(ref_mmap);
+  end_position = ref_mmap_size(ref_mmap);
   while (next_position <= end_position && 0 != next_position) {
     position = next_position;
-    REIS(0, fseeko(file, position, SEEK_SET), "fseeko NEXT failed");
-    /*
-#include <inttypes.h>
-    , {
-      printf("end_position = %jd\n", (intmax_t)end_position);
-      printf("next_position = %jd\n", (intmax_t)next_position);
-      for (keyword_code = 0; keyword_code < REF_IMPORT_MESHB_LAST_KEYWORD;
-           keyword_code++) {
-        if (REF_EMPTY != key_pos[keyword_code]) {
-          printf("key_pos[%d] = %jd\n", keyword_code,
-                 (intmax_t)key_pos[keyword_code]);
-        }
-      }
-    });
-    */
-    REIS(1, fread((unsigned char *)&keyword_code, 4, 1, file), "keyword code");
+    RSS(ref_mmap_seek(ref_mmap, position), "seek next");
+    RSS(ref_mmap_int(ref_mmap, &keyword_code), "keyword code");
     if (0 <= keyword_code && keyword_code < REF_IMPORT_MESHB_LAST_KEYWORD) {
       key_pos[keyword_code] = position;
     } else {
       printf("ignoring keyword %d\n", keyword_code);
     }
-    RSS(meshb_pos(file, *version, &next_position), "pos");
+    RSS(meshb_pos(ref_mmap, *version, &next_position), "pos");
   }
 
-  fclose(file);
   return REF_SUCCESS;
 }
 
-REF_FCN REF_STATUS ref_import_meshb_jump(FILE *file, REF_INT version,
+REF_FCN REF_STATUS ref_import_meshb_jump(REF_MMAP ref_mmap, REF_INT version,
                                          REF_FILEPOS *key_pos, REF_INT keyword,
                                          REF_BOOL *available,
                                          REF_FILEPOS *next_position) {
@@ -1477,36 +1453,52 @@ REF_FCN REF_STATUS ref_import_meshb_jump(FILE *file, REF_INT version,
     *next_position = 0;
     return REF_SUCCESS;
   }
-  REIS(0, fseeko(file, position, SEEK_SET), "fseeko keyword failed");
-  REIS(1, fread((unsigned char *)&keyword_code, 4, 1, file), "keyword code");
+  RSS(ref_mmap_seek(ref_mmap, position), "seek keyword");
+  RSS(ref_mmap_int(ref_mmap, &keyword_code), "keyword code");
   REIS(keyword, keyword_code, "keyword code");
-  RSS(meshb_pos(file, version, next_position), "pos");
+  RSS(meshb_pos(ref_mmap, version, next_position), "pos");
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_import_meshb_int(FILE *file, REF_INT version,
+REF_FCN static REF_STATUS ref_import_meshb_int(REF_MMAP ref_mmap,
+                                               REF_INT version,
                                                REF_INT *value) {
-  int int_value;
-  long long_value;
+  REF_LONG long_value;
   if (version < 4) {
-    REIS(1, fread(&int_value, sizeof(int), 1, file), "int value");
-    *value = int_value;
+    RSS(ref_mmap_int(ref_mmap, value), "int value");
   } else {
-    REIS(1, fread(&long_value, sizeof(long), 1, file), "long value");
+    RSS(ref_mmap_long(ref_mmap, &long_value), "long value");
     *value = (REF_INT)long_value;
   }
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_import_meshb_size(FILE *file, REF_INT version,
+REF_FCN static REF_STATUS ref_import_meshb_ints(REF_MMAP ref_mmap,
+                                                REF_INT version, REF_INT n,
+                                                REF_INT *values) {
+  REF_LONG *long_values;
+  REF_INT i;
+  if (version < 4) {
+    RSS(ref_mmap_ints(ref_mmap, n, values), "int values");
+  } else {
+    ref_malloc(long_values, n, REF_LONG);
+    RSS(ref_mmap_longs(ref_mmap, n, long_values), "long values");
+    for (i = 0; i < n; i++) values[i] = (REF_INT)long_values[i];
+    ref_free(long_values);
+  }
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_import_meshb_size(REF_MMAP ref_mmap,
+                                                REF_INT version,
                                                 REF_SIZE *value) {
-  unsigned int int_value;
-  unsigned long long_value;
+  REF_INT int_value;
+  REF_LONG long_value;
   if (version < 4) {
-    REIS(1, fread(&int_value, sizeof(int), 1, file), "int value");
-    *value = (REF_SIZE)int_value;
+    RSS(ref_mmap_int(ref_mmap, &int_value), "int value");
+    *value = (REF_SIZE)(unsigned int)int_value;
   } else {
-    REIS(1, fread(&long_value, sizeof(long), 1, file), "long value");
+    RSS(ref_mmap_long(ref_mmap, &long_value), "long value");
     *value = (REF_SIZE)long_value;
   }
   return REF_SUCCESS;
@@ -1536,7 +1528,7 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
   REF_NODE ref_node;
   REF_CELL ref_cell;
   REF_GEOM ref_geom;
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT version, dim;
   REF_BOOL available;
   REF_FILEPOS next_position;
@@ -1544,6 +1536,8 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
   REF_INT keyword_code, nnode, node, new_node;
   REF_INT ncell, cell;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER + 1]; /* everyone gets id in meshb */
+  REF_INT *c2n;
+  REF_DBL *xyz;
   REF_INT new_cell;
   REF_INT n0, n1, n2, n3, n4, id, group, node_per;
   REF_INT geom_keyword, type, i, geom, ngeom;
@@ -1551,8 +1545,9 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
   REF_INT cad_data_keyword;
   REF_BOOL verbose = REF_FALSE;
 
-  if (verbose) printf("header %s\n", filename);
-  RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+  if (verbose) printf("open %s\n", filename);
+  RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+  RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
   if (verbose) printf("meshb version %d\n", version);
 
   RSS(ref_grid_create(ref_grid_ptr, ref_mpi), "create grid");
@@ -1560,16 +1555,11 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
   ref_node = ref_grid_node(ref_grid);
   ref_geom = ref_grid_geom(ref_grid);
 
-  if (verbose) printf("open %s\n", filename);
-  file = fopen(filename, "r");
-  if (NULL == (void *)file) printf("unable to open %s\n", filename);
-  RNS(file, "unable to open file");
-
-  RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+  RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
                             &next_position),
       "jump");
   RAS(available, "meshb missing dimension");
-  REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+  RSS(ref_mmap_int(ref_mmap, &dim), "dim");
   if (verbose) printf("meshb dim %d\n", dim);
   if (dim < 2 || 3 < dim) {
     printf("dim %d not supported\n", dim);
@@ -1577,47 +1567,55 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
   }
   if (2 == dim) ref_grid_twod(ref_grid) = REF_TRUE;
 
-  RSS(ref_import_meshb_jump(file, version, key_pos, 4, &available,
+  RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 4, &available,
                             &next_position),
       "jump");
   RAS(available, "meshb missing vertex");
-  RSS(ref_import_meshb_int(file, version, &nnode), "nnode");
+  RSS(ref_import_meshb_int(ref_mmap, version, &nnode), "nnode");
   if (verbose) printf("nnode %d\n", nnode);
 
+  ref_malloc(xyz, dim * nnode, REF_DBL);
+  if (1 == version) {
+    for (node = 0; node < nnode; node++) {
+      for (i = 0; i < dim; i++)
+        RSS(meshb_real(ref_mmap, version, &(xyz[i + dim * node])), "xyz");
+      RSS(ref_import_meshb_int(ref_mmap, version, &id), "id");
+    }
+  } else {
+    RSS(ref_mmap_dbls_strided(ref_mmap, nnode, dim,
+                              (REF_INT)sizeof(REF_DBL) * dim +
+                                  (version < 4 ? 4 : 8),
+                              xyz),
+        "xyz");
+  }
   for (node = 0; node < nnode; node++) {
     RSS(ref_node_add(ref_node, node, &new_node), "add node");
-    if (2 == dim) {
-      RSS(meshb_real(file, version, &(ref_node_xyz(ref_node, 0, new_node))),
-          "x");
-      RSS(meshb_real(file, version, &(ref_node_xyz(ref_node, 1, new_node))),
-          "y");
-      ref_node_xyz(ref_node, 2, new_node) = 0.0;
-    } else {
-      RSS(meshb_real(file, version, &(ref_node_xyz(ref_node, 0, new_node))),
-          "x");
-      RSS(meshb_real(file, version, &(ref_node_xyz(ref_node, 1, new_node))),
-          "y");
-      RSS(meshb_real(file, version, &(ref_node_xyz(ref_node, 2, new_node))),
-          "z");
-    }
-    RSS(ref_import_meshb_int(file, version, &id), "nnode");
+    ref_node_xyz(ref_node, 0, new_node) = xyz[0 + dim * node];
+    ref_node_xyz(ref_node, 1, new_node) = xyz[1 + dim * node];
+    ref_node_xyz(ref_node, 2, new_node) =
+        (2 == dim ? 0.0 : xyz[2 + dim * node]);
   }
-  REIS(next_position, ftello(file), "end location");
+  ref_free(xyz);
+  REIS(next_position, ref_mmap_position(ref_mmap), "end location");
 
   RSS(ref_node_initialize_n_global(ref_node, nnode), "init glob");
 
   each_ref_grid_all_ref_cell(ref_grid, group, ref_cell) {
     RSS(ref_cell_meshb_keyword(ref_cell, &keyword_code), "kw");
-    RSS(ref_import_meshb_jump(file, version, key_pos, keyword_code, &available,
-                              &next_position),
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, keyword_code,
+                              &available, &next_position),
         "jump");
     if (available) {
       node_per = ref_cell_node_per(ref_cell);
-      RSS(ref_import_meshb_int(file, version, &ncell), "ncell");
+      RSS(ref_import_meshb_int(ref_mmap, version, &ncell), "ncell");
       if (verbose) printf(" group %d ncell %d\n", group, ncell);
+      ref_malloc(c2n, (1 + node_per) * ncell, REF_INT);
+      RSS(ref_import_meshb_ints(ref_mmap, version, (1 + node_per) * ncell,
+                                c2n),
+          "c2n");
       for (cell = 0; cell < ncell; cell++) {
         for (node = 0; node < (1 + node_per); node++) {
-          RSS(ref_import_meshb_int(file, version, &(nodes[node])), "c2n");
+          nodes[node] = c2n[node + (1 + node_per) * cell];
         }
         for (node = 0; node < node_per; node++) {
           nodes[node]--;
@@ -1638,44 +1636,44 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
         }
         RSS(ref_cell_add(ref_cell, nodes, &new_cell), "add cell");
       }
-      REIS(next_position, ftell(file), "cell inconsistent");
+      ref_free(c2n);
+      REIS(next_position, ref_mmap_position(ref_mmap), "cell inconsistent");
     }
   }
 
   each_ref_type(ref_geom, type) {
     geom_keyword = 40 + type;
-    RSS(ref_import_meshb_jump(file, version, key_pos, geom_keyword, &available,
-                              &next_position),
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, geom_keyword,
+                              &available, &next_position),
         "jump");
     if (available) {
-      RSS(ref_import_meshb_int(file, version, &(ngeom)), "ngeom");
+      RSS(ref_import_meshb_int(ref_mmap, version, &(ngeom)), "ngeom");
       if (verbose) printf("type %d ngeom %d\n", type, ngeom);
 
       for (geom = 0; geom < ngeom; geom++) {
-        RSS(ref_import_meshb_int(file, version, &(node)), "node");
-        RSS(ref_import_meshb_int(file, version, &(id)), "node");
-        for (i = 0; i < type; i++)
-          REIS(1, fread(&(param[i]), sizeof(double), 1, file), "param");
+        RSS(ref_import_meshb_int(ref_mmap, version, &(node)), "node");
+        RSS(ref_import_meshb_int(ref_mmap, version, &(id)), "node");
+        if (0 < type) RSS(ref_mmap_dbls(ref_mmap, type, param), "param");
         node--;
         RSS(ref_geom_add(ref_geom, node, type, id, param), "add geom");
         if (0 < type) {
-          double double_gref;
+          REF_DBL double_gref;
           REF_INT new_geom;
-          REIS(1, fread(&(double_gref), sizeof(double), 1, file), "gref");
+          RSS(ref_mmap_dbl(ref_mmap, &double_gref), "gref");
           RSS(ref_geom_find(ref_geom, node, type, id, &new_geom), "find");
           ref_geom_gref(ref_geom, new_geom) = (REF_INT)double_gref;
         }
       }
-      REIS(next_position, ftello(file), "end location");
+      REIS(next_position, ref_mmap_position(ref_mmap), "end location");
     }
   }
 
   cad_data_keyword = 126; /* GmfByteFlow */
-  RSS(ref_import_meshb_jump(file, version, key_pos, cad_data_keyword,
+  RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, cad_data_keyword,
                             &available, &next_position),
       "jump");
   if (available) {
-    RSS(ref_import_meshb_size(file, version,
+    RSS(ref_import_meshb_size(ref_mmap, version,
                               &(ref_geom_cad_data_size(ref_geom))),
         "cad data size");
     if (verbose)
@@ -1684,14 +1682,13 @@ REF_FCN static REF_STATUS ref_import_meshb(REF_GRID *ref_grid_ptr,
     ref_free(ref_geom_cad_data(ref_geom));
     ref_malloc_size_t(ref_geom_cad_data(ref_geom),
                       ref_geom_cad_data_size(ref_geom), REF_BYTE);
-    REIS(ref_geom_cad_data_size(ref_geom),
-         fread(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
-               ref_geom_cad_data_size(ref_geom), file),
-         "cad_data");
-    REIS(next_position, ftello(file), "end location");
+    RSS(ref_mmap_bytes(ref_mmap, (REF_SIZE)ref_geom_cad_data_size(ref_geom),
+                       ref_geom_cad_data(ref_geom)),
+        "cad_data");
+    REIS(next_position, ref_mmap_position(ref_mmap), "end location");
   }
 
-  fclose(file);
+  RSS(ref_mmap_free(ref_mmap), "unmap");
 
   return REF_SUCCESS;
 }
@@ -1765,23 +1762,19 @@ REF_FCN REF_STATUS ref_import_by_extension(REF_GRID *ref_grid_ptr,
 }
 
 REF_FCN REF_STATUS ref_import_examine_header(const char *filename) {
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_FILEPOS next_position, end_position;
-  int i4, i4_swapped, version, keyword_code;
-  long i8, i8_swapped;
+  REF_INT i4, i4_swapped, version, keyword_code;
+  REF_LONG i8, i8_swapped;
   int i;
   REF_BOOL file_position_report = REF_FALSE;
 
-  file = fopen(filename, "r");
-  if (NULL == (void *)file) printf("unable to open %s\n", filename);
-  RNS(file, "unable to open file");
+  RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
 
   printf(" -- 32bit ugrid header\n");
 
-  rewind(file);
-
   for (i = 0; i < 8; i++) {
-    RES(1, fread(&i4, sizeof(int), 1, file), "int");
+    RSS(ref_mmap_int(ref_mmap, &i4), "int");
     i4_swapped = i4;
     SWAP_INT(i4_swapped);
     printf(" %d: %d (%d swapped) ints\n", i, i4, i4_swapped);
@@ -1789,13 +1782,13 @@ REF_FCN REF_STATUS ref_import_examine_header(const char *filename) {
 
   printf(" -- 64bit ugrid header\n");
 
-  rewind(file);
+  RSS(ref_mmap_seek(ref_mmap, 0), "rewind");
 
   for (i = 0; i < 3; i++) {
-    RES(1, fread(&i4, sizeof(int), 1, file), "int");
+    RSS(ref_mmap_int(ref_mmap, &i4), "int");
   }
   for (i = 3; i < 7; i++) {
-    RES(1, fread(&i8, sizeof(long), 1, file), "long");
+    RSS(ref_mmap_long(ref_mmap, &i8), "long");
     i8_swapped = i8;
     SWAP_INT(i8_swapped);
     printf(" %d: %ld (%ld swapped) long\n", i, i8, i8_swapped);
@@ -1803,28 +1796,25 @@ REF_FCN REF_STATUS ref_import_examine_header(const char *filename) {
 
   printf(" -- meshb/solb\n");
 
-  rewind(file);
-
   printf("%d sizeof(REF_FILEPOS)\n", (REF_INT)sizeof(REF_FILEPOS));
 
-  REIS(0, fseeko(file, 0, SEEK_END), "fseeko END failed");
-  end_position = ftello(file);
+  end_position = ref_mmap_size(ref_mmap);
   if (file_position_report) printf("%ld end_position\n", (long)end_position);
-  rewind(file);
+  RSS(ref_mmap_seek(ref_mmap, 0), "rewind");
 
-  REIS(1, fread((unsigned char *)&i4, 4, 1, file), "code");
+  RSS(ref_mmap_int(ref_mmap, &i4), "code");
   printf("%d meshb code\n", i4);
   if (1 != i4) goto close_file_and_return;
-  REIS(1, fread((unsigned char *)&i4, 4, 1, file), "version");
+  RSS(ref_mmap_int(ref_mmap, &i4), "version");
   printf("%d version\n", i4);
   if (1 > i4 || i4 > 4) goto close_file_and_return;
   version = i4;
-  next_position = ftello(file);
+  next_position = ref_mmap_position(ref_mmap);
   while (next_position <= end_position && 0 < next_position) {
-    REIS(0, fseeko(file, next_position, SEEK_SET), "fseeko NEXT failed");
+    RSS(ref_mmap_seek(ref_mmap, next_position), "seek next");
     if (file_position_report)
       printf("%ld current position\n", (long)next_position);
-    REIS(1, fread((unsigned char *)&keyword_code, 4, 1, file), "keyword code");
+    RSS(ref_mmap_int(ref_mmap, &keyword_code), "keyword code");
     printf("%d keyword", keyword_code);
     switch (keyword_code) {
       case 3:
@@ -1902,31 +1892,32 @@ REF_FCN REF_STATUS ref_import_examine_header(const char *filename) {
       default:
         printf("\n");
     }
-    RSS(meshb_pos(file, version, &next_position), "meshb pos");
+    RSS(meshb_pos(ref_mmap, version, &next_position), "meshb pos");
     if (file_position_report) printf("%ld next position", (long)next_position);
     if (next_position > 0) {
-      printf(" %ld size\n", (long)(next_position - ftello(file)));
+      printf(" %ld size\n",
+             (long)(next_position - ref_mmap_position(ref_mmap)));
     } else {
       printf("\n");
     }
     if (version >= 4 && keyword_code != 3) {
-      if (ftello(file) < end_position) {
-        REIS(1, fread((unsigned char *)&i8, 8, 1, file), "code");
+      if (ref_mmap_position(ref_mmap) < end_position) {
+        RSS(ref_mmap_long(ref_mmap, &i8), "code");
         printf("  %ld first i8\n", i8);
       }
     } else {
-      if (ftello(file) < end_position) {
-        REIS(1, fread((unsigned char *)&i4, 4, 1, file), "code");
+      if (ref_mmap_position(ref_mmap) < end_position) {
+        RSS(ref_mmap_int(ref_mmap, &i4), "code");
         printf("  %d first i4\n", i4);
       }
     }
-    if (ftello(file) < end_position) {
-      REIS(1, fread((unsigned char *)&i4, 4, 1, file), "code");
+    if (ref_mmap_position(ref_mmap) < end_position) {
+      RSS(ref_mmap_int(ref_mmap, &i4), "code");
       printf("  %d second i4\n", i4);
     }
   }
 
 close_file_and_return:
-  fclose(file);
+  RSS(ref_mmap_free(ref_mmap), "unmap");
   return REF_SUCCESS;
 }
@@ -24,17 +24,24 @@
 
 #include "ref_dict.h"
 #include "ref_grid.h"
+#include "ref_mmap.h"
 
 BEGIN_C_DECLORATION
 
 REF_FCN REF_STATUS ref_import_by_extension(REF_GRID *ref_grid, REF_MPI ref_mpi,
                                            const char *filename);
 
-#define REF_IMPORT_MESHB_LAST_KEYWORD (156) /* 203-47 */
+#define REF_IMPORT_MESHB_LAST_KEYWORD (256) /* 203-47 and private */
+/* refine checkpoint state, past the libMeshb keywords so other readers skip */
+#define REF_IMPORT_MESHB_CHECKPOINT_KEYWORD (255)
 REF_FCN REF_STATUS ref_import_meshb_header(const char *filename,
                                            REF_INT *version,
                                            REF_FILEPOS *key_pos);
-REF_FCN REF_STATUS ref_import_meshb_jump(FILE *file, REF_INT version,
+/* keyword positions of an open meshb, so a packed file expands once */
+REF_FCN REF_STATUS ref_import_meshb_header_mmap(REF_MMAP ref_mmap,
+                                                REF_INT *version,
+                                                REF_FILEPOS *key_pos);
+REF_FCN REF_STATUS ref_import_meshb_jump(REF_MMAP ref_mmap, REF_INT version,
                                          REF_FILEPOS *key_pos, REF_INT keyword,
                                          REF_BOOL *available,
                                          REF_FILEPOS *next_position);
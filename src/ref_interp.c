@@ -24,6 +24,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 #include "ref_edge.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
@@ -32,6 +36,18 @@
 
 #define MAX_NODE_LIST (200)
 
+/* transfer operator rows are split into contiguous blocks over threads,
+ * a block has at least this many row entries (rows times leading_dim) */
+#define REF_INTERP_MAX_THREADS (8)
+#define REF_INTERP_MIN_BLOCK (16384)
+
+typedef struct REF_INTERP_SPMV_STRUCT {
+  REF_INT first, last, leading_dim;
+  REF_INT *ptr, *node;
+  REF_DBL *weight, *from, *to;
+  REF_STATUS status;
+} REF_INTERP_SPMV_STRUCT;
+
 #define ref_interp_bary_inside(ref_interp, bary)                             \
   ((bary)[0] >= (ref_interp)->inside && (bary)[1] >= (ref_interp)->inside && \
    (bary)[2] >= (ref_interp)->inside && (bary)[3] >= (ref_interp)->inside)
@@ -143,6 +159,24 @@ REF_FCN static REF_STATUS ref_interp_create_search(REF_INTERP ref_interp) {
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_interp_plan_free(REF_INTERP ref_interp) {
+  ref_free(ref_interp->plan_recept_node);
+  ref_free(ref_interp->plan_recept_size);
+  ref_free(ref_interp->plan_donor_weight);
+  ref_free(ref_interp->plan_donor_node);
+  ref_free(ref_interp->plan_donor_ptr);
+  ref_free(ref_interp->plan_donor_size);
+  ref_interp->plan_n_donor = 0;
+  ref_interp->plan_n_recept = 0;
+  ref_interp->plan_donor_size = NULL;
+  ref_interp->plan_donor_ptr = NULL;
+  ref_interp->plan_donor_node = NULL;
+  ref_interp->plan_donor_weight = NULL;
+  ref_interp->plan_recept_size = NULL;
+  ref_interp->plan_recept_node = NULL;
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_interp_create(REF_INTERP *ref_interp_ptr,
                                      REF_GRID from_grid, REF_GRID to_grid) {
   REF_INTERP ref_interp;
@@ -200,12 +234,22 @@ REF_FCN REF_STATUS ref_interp_create(REF_INTERP *ref_interp_ptr,
   ref_interp_search_donor_scale(ref_interp) = 2.0;
   RSS(ref_interp_create_search(ref_interp), "fill search");
 
+  ref_interp->plan_n_donor = 0;
+  ref_interp->plan_n_recept = 0;
+  ref_interp->plan_donor_size = NULL;
+  ref_interp->plan_donor_ptr = NULL;
+  ref_interp->plan_donor_node = NULL;
+  ref_interp->plan_donor_weight = NULL;
+  ref_interp->plan_recept_size = NULL;
+  ref_interp->plan_recept_node = NULL;
+
   return REF_SUCCESS;
 }
 
 REF_FCN REF_STATUS ref_interp_resize(REF_INTERP ref_interp, REF_INT max) {
   REF_INT old = ref_interp_max(ref_interp);
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
   ref_realloc_init(ref_interp->agent_hired, old, max, REF_BOOL, REF_FALSE);
   ref_realloc_init(ref_interp->cell, old, max, REF_INT, REF_EMPTY);
   ref_realloc_init(ref_interp->part, old, max, REF_INT, REF_EMPTY);
@@ -220,6 +264,7 @@ REF_FCN REF_STATUS ref_interp_reset(REF_INTERP ref_interp) {
   REF_INT node_max =
       ref_node_max(ref_grid_node(ref_interp_to_grid(ref_interp)));
   REF_INT node;
+  RSS(ref_interp_plan_free(ref_interp), "plan");
   for (node = 0; node < ref_interp_max(ref_interp); node++) {
     RAS(!ref_interp->agent_hired[node],
         "agent should not be hired during reset");
@@ -286,6 +331,7 @@ REF_FCN REF_STATUS ref_interp_create_identity(REF_INTERP *ref_interp_ptr,
 
 REF_FCN REF_STATUS ref_interp_free(REF_INTERP ref_interp) {
   if (NULL == (void *)ref_interp) return REF_NULL;
+  ref_interp_plan_free(ref_interp);
   ref_search_free(ref_interp->ref_search);
   ref_list_free(ref_interp->visualize);
   ref_agents_free(ref_interp->ref_agents);
@@ -307,6 +353,7 @@ REF_FCN REF_STATUS ref_interp_pack(REF_INTERP ref_interp, REF_INT *n2o) {
   REF_INT i, node, n, max;
 
   if (NULL == ref_interp) return REF_SUCCESS;
+  RSS(ref_interp_plan_free(ref_interp), "plan");
 
   n = ref_node_n(ref_grid_node(ref_interp_to_grid(ref_interp)));
   max = ref_interp_max(ref_interp);
@@ -358,6 +405,7 @@ REF_FCN REF_STATUS ref_interp_pack(REF_INTERP ref_interp, REF_INT *n2o) {
 
 REF_FCN REF_STATUS ref_interp_remove(REF_INTERP ref_interp, REF_INT node) {
   if (NULL == ref_interp) return REF_SUCCESS;
+  RSS(ref_interp_plan_free(ref_interp), "plan");
   if (!ref_interp_continuously(ref_interp)) return REF_SUCCESS;
   REIS(REF_FALSE, ref_interp->agent_hired[node], "remove node agent hired");
   RUS(REF_EMPTY, ref_interp_cell(ref_interp, node), "remove node no located");
@@ -1718,6 +1766,8 @@ REF_FCN REF_STATUS ref_interp_locate(REF_INTERP ref_interp) {
   REF_BOOL increase_fuzz;
   REF_INT tries;
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
+
   if (ref_interp->instrument)
     RSS(ref_mpi_stopwatch_start(ref_mpi), "locate clock");
 
@@ -1754,6 +1804,8 @@ REF_FCN REF_STATUS ref_interp_locate_warm(REF_INTERP ref_interp) {
   REF_INT tries;
   REF_INT node;
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
+
   if (ref_interp->instrument)
     RSS(ref_mpi_stopwatch_start(ref_mpi), "locate clock");
 
@@ -1790,6 +1842,8 @@ REF_FCN REF_STATUS ref_interp_locate_subset(REF_INTERP ref_interp) {
   REF_BOOL increase_fuzz;
   REF_INT tries;
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
+
   if (ref_interp->instrument)
     RSS(ref_mpi_stopwatch_start(ref_mpi), "locate clock");
 
@@ -1823,6 +1877,8 @@ REF_FCN REF_STATUS ref_interp_locate_nearest(REF_INTERP ref_interp) {
   REF_MPI ref_mpi = ref_interp_mpi(ref_interp);
   REF_GRID from_grid = ref_interp_from_grid(ref_interp);
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
+
   REF_CELL from_tri = ref_interp_from_tri(ref_interp);
   REF_NODE from_node = ref_grid_node(from_grid);
 
@@ -1869,6 +1925,7 @@ REF_FCN REF_STATUS ref_interp_locate_node(REF_INTERP ref_interp, REF_INT node) {
   REF_AGENTS ref_agents;
   REF_INT i, id;
   RNS(ref_interp, "ref_interp NULL");
+  RSS(ref_interp_plan_free(ref_interp), "plan");
   ref_mpi = ref_interp_mpi(ref_interp);
 
   RAS(node <= ref_interp_max(ref_interp), "more nodes added, should move only");
@@ -1954,6 +2011,7 @@ REF_FCN REF_STATUS ref_interp_locate_between(REF_INTERP ref_interp,
   REF_AGENTS ref_agents;
   REF_INT i, id;
   RNS(ref_interp, "ref_interp NULL");
+  RSS(ref_interp_plan_free(ref_interp), "plan");
 
   ref_mpi = ref_interp_mpi(ref_interp);
   ref_grid = ref_interp_to_grid(ref_interp);
@@ -2048,19 +2106,19 @@ REF_FCN REF_STATUS ref_interp_locate_between(REF_INTERP ref_interp,
   return REF_SUCCESS;
 }
 
-REF_FCN REF_STATUS ref_interp_scalar(REF_INTERP ref_interp, REF_INT leading_dim,
-                                     REF_DBL *from_scalar, REF_DBL *to_scalar) {
+REF_FCN static REF_STATUS ref_interp_plan_create(REF_INTERP ref_interp) {
   REF_GRID to_grid = ref_interp_to_grid(ref_interp);
   REF_GRID from_grid = ref_interp_from_grid(ref_interp);
   REF_NODE to_node = ref_grid_node(to_grid);
   REF_MPI ref_mpi = ref_grid_mpi(to_grid);
   REF_CELL from_cell;
-  REF_INT node, ibary, im;
+  REF_INT node, ibary, part;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-  REF_INT receptor, n_recept, donation, n_donor;
-  REF_DBL *recept_scalar, *donor_scalar, *recept_bary, *donor_bary;
-  REF_INT *donor_node, *donor_ret, *donor_cell;
-  REF_INT *recept_proc, *recept_ret, *recept_node, *recept_cell;
+  REF_INT receptor, n_recept, donation, n_donor, nnz;
+  REF_INT *recept_size, *donor_size, *recept_next;
+  REF_INT *recept_cell, *recept_node, *donor_cell;
+  REF_INT *donor_ptr, *donor_node;
+  REF_DBL *recept_bary, *donor_bary, *donor_weight;
 
   if (ref_grid_twod(from_grid)) {
     from_cell = ref_interp_from_tri(ref_interp);
@@ -2068,95 +2126,194 @@ REF_FCN REF_STATUS ref_interp_scalar(REF_INTERP ref_interp, REF_INT leading_dim,
     from_cell = ref_interp_from_tet(ref_interp);
   }
 
-  n_recept = 0;
+  ref_malloc_init(recept_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(donor_size, ref_mpi_n(ref_mpi), REF_INT, 0);
   each_ref_node_valid_node(to_node, node) {
     if (ref_node_owned(to_node, node)) {
-      n_recept++;
+      RUS(REF_EMPTY, ref_interp->cell[node], "node needs to be localized");
+      recept_size[ref_interp->part[node]]++;
     }
   }
+  RSS(ref_mpi_alltoall(ref_mpi, recept_size, donor_size, REF_INT_TYPE),
+      "alltoall sizes");
+  n_recept = 0;
+  each_ref_mpi_part(ref_mpi, part) { n_recept += recept_size[part]; }
+  n_donor = 0;
+  each_ref_mpi_part(ref_mpi, part) { n_donor += donor_size[part]; }
 
+  /* receptors grouped by donor part, donations return in this order */
+  ref_malloc(recept_next, ref_mpi_n(ref_mpi), REF_INT);
+  recept_next[0] = 0;
+  each_ref_mpi_worker(ref_mpi, part) {
+    recept_next[part] = recept_next[part - 1] + recept_size[part - 1];
+  }
   ref_malloc(recept_bary, 4 * n_recept, REF_DBL);
   ref_malloc(recept_cell, n_recept, REF_INT);
   ref_malloc(recept_node, n_recept, REF_INT);
-  ref_malloc(recept_ret, n_recept, REF_INT);
-  ref_malloc(recept_proc, n_recept, REF_INT);
-
-  n_recept = 0;
   each_ref_node_valid_node(to_node, node) {
     if (ref_node_owned(to_node, node)) {
-      RUS(REF_EMPTY, ref_interp->cell[node], "node needs to be localized");
+      receptor = recept_next[ref_interp->part[node]];
       RSS(ref_node_clip_bary4(&(ref_interp->bary[4 * node]),
-                              &(recept_bary[4 * n_recept])),
+                              &(recept_bary[4 * receptor])),
           "clip");
-      recept_proc[n_recept] = ref_interp->part[node];
-      recept_cell[n_recept] = ref_interp->cell[node];
-      recept_node[n_recept] = node;
-      recept_ret[n_recept] = ref_mpi_rank(ref_mpi);
-      n_recept++;
+      recept_cell[receptor] = ref_interp->cell[node];
+      recept_node[receptor] = node;
+      recept_next[ref_interp->part[node]]++;
     }
   }
+  ref_free(recept_next);
 
-  RSS(ref_mpi_blindsend(ref_mpi, recept_proc, (void *)recept_cell, 1, n_recept,
-                        (void **)(&donor_cell), &n_donor, REF_INT_TYPE),
-      "blind send cell");
-  RSS(ref_mpi_blindsend(ref_mpi, recept_proc, (void *)recept_ret, 1, n_recept,
-                        (void **)(&donor_ret), &n_donor, REF_INT_TYPE),
-      "blind send ret");
-  RSS(ref_mpi_blindsend(ref_mpi, recept_proc, (void *)recept_node, 1, n_recept,
-                        (void **)(&donor_node), &n_donor, REF_INT_TYPE),
-      "blind send node");
-  RSS(ref_mpi_blindsend(ref_mpi, recept_proc, (void *)recept_bary, 4, n_recept,
-                        (void **)(&donor_bary), &n_donor, REF_DBL_TYPE),
-      "blind send bary");
-
-  ref_free(recept_proc);
-  ref_free(recept_ret);
-  ref_free(recept_node);
+  ref_malloc(donor_cell, n_donor, REF_INT);
+  ref_malloc(donor_bary, 4 * n_donor, REF_DBL);
+  RSS(ref_mpi_alltoallv(ref_mpi, recept_cell, recept_size, donor_cell,
+                        donor_size, 1, REF_INT_TYPE),
+      "alltoallv cell");
+  RSS(ref_mpi_alltoallv(ref_mpi, recept_bary, recept_size, donor_bary,
+                        donor_size, 4, REF_DBL_TYPE),
+      "alltoallv bary");
   ref_free(recept_cell);
   ref_free(recept_bary);
 
-  ref_malloc(donor_scalar, leading_dim * n_donor, REF_DBL);
-
+  /* CSR transfer operator, zero weights of clipped bary dropped */
+  ref_malloc(donor_ptr, n_donor + 1, REF_INT);
+  ref_malloc(donor_node, 4 * n_donor, REF_INT);
+  ref_malloc(donor_weight, 4 * n_donor, REF_DBL);
+  nnz = 0;
+  donor_ptr[0] = 0;
   for (donation = 0; donation < n_donor; donation++) {
     RSS(ref_cell_nodes(from_cell, donor_cell[donation], nodes),
         "node needs to be localized");
-    for (im = 0; im < leading_dim; im++) {
-      donor_scalar[im + leading_dim * donation] = 0.0;
-      for (ibary = 0; ibary < ref_cell_node_per(from_cell); ibary++) {
-        donor_scalar[im + leading_dim * donation] +=
-            donor_bary[ibary + 4 * donation] *
-            from_scalar[im + leading_dim * nodes[ibary]];
-      }
-      /*
-      RAB(isfinite(donor_scalar[im + leading_dim * donation]), "donor_scalar", {
-        printf("%.20e\n", donor_scalar[im + leading_dim * donation]);
-        for (ibary = 0; ibary < ref_cell_node_per(from_cell); ibary++) {
-          printf("%.20e %.20e %.20e\n",
-                 donor_bary[ibary + 4 * donation] *
-                     from_scalar[im + leading_dim * nodes[ibary]],
-                 donor_bary[ibary + 4 * donation],
-                 from_scalar[im + leading_dim * nodes[ibary]]);
-        }
-      });
-      */
+    for (ibary = 0; ibary < ref_cell_node_per(from_cell); ibary++) {
+      if (0.0 == donor_bary[ibary + 4 * donation]) continue;
+      donor_node[nnz] = nodes[ibary];
+      donor_weight[nnz] = donor_bary[ibary + 4 * donation];
+      nnz++;
     }
+    donor_ptr[donation + 1] = nnz;
   }
-  ref_free(donor_cell);
   ref_free(donor_bary);
+  ref_free(donor_cell);
 
-  RSS(ref_mpi_blindsend(ref_mpi, donor_ret, (void *)donor_scalar, leading_dim,
-                        n_donor, (void **)(&recept_scalar), &n_recept,
-                        REF_DBL_TYPE),
-      "blind send bary");
-  RSS(ref_mpi_blindsend(ref_mpi, donor_ret, (void *)donor_node, 1, n_donor,
-                        (void **)(&recept_node), &n_recept, REF_INT_TYPE),
-      "blind send node");
+  ref_interp->plan_n_donor = n_donor;
+  ref_interp->plan_n_recept = n_recept;
+  ref_interp->plan_donor_size = donor_size;
+  ref_interp->plan_donor_ptr = donor_ptr;
+  ref_interp->plan_donor_node = donor_node;
+  ref_interp->plan_donor_weight = donor_weight;
+  ref_interp->plan_recept_size = recept_size;
+  ref_interp->plan_recept_node = recept_node;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_interp_spmv_rows(REF_INTERP_SPMV_STRUCT *spmv) {
+  REF_INT row, entry, im, leading_dim = spmv->leading_dim;
+  REF_DBL *from, *to;
+  for (row = spmv->first; row < spmv->last; row++) {
+    to = &(spmv->to[leading_dim * row]);
+    for (im = 0; im < leading_dim; im++) to[im] = 0.0;
+    for (entry = spmv->ptr[row]; entry < spmv->ptr[row + 1]; entry++) {
+      from = &(spmv->from[leading_dim * spmv->node[entry]]);
+      for (im = 0; im < leading_dim; im++)
+        to[im] += spmv->weight[entry] * from[im];
+    }
+  }
+  return REF_SUCCESS;
+}
+
+#ifdef HAVE_PTHREAD
+static void *ref_interp_spmv_thread(void *arg) {
+  REF_INTERP_SPMV_STRUCT *spmv = (REF_INTERP_SPMV_STRUCT *)arg;
+  spmv->status = ref_interp_spmv_rows(spmv);
+  return NULL;
+}
+#endif
+
+/* rows write disjoint outputs, row blocks run on threads when available */
+REF_FCN static REF_STATUS ref_interp_spmv(REF_INTERP_SPMV_STRUCT *spmv) {
+#ifdef HAVE_PTHREAD
+  REF_INTERP_SPMV_STRUCT *worker;
+  pthread_t *thread;
+  REF_BOOL *started;
+  REF_INT nthread, i, nrow;
+  REF_STATUS status = REF_SUCCESS;
+
+  nrow = spmv->last - spmv->first;
+  nthread = (REF_INT)MIN((REF_LONG)REF_INTERP_MAX_THREADS,
+                         (REF_LONG)nrow * (REF_LONG)spmv->leading_dim /
+                             (REF_LONG)REF_INTERP_MIN_BLOCK);
+  if (nthread <= 1) {
+    RSS(ref_interp_spmv_rows(spmv), "serial rows");
+    return REF_SUCCESS;
+  }
+  ref_malloc(worker, nthread, REF_INTERP_SPMV_STRUCT);
+  ref_malloc(thread, nthread, pthread_t);
+  ref_malloc_init(started, nthread, REF_BOOL, REF_FALSE);
+  for (i = 0; i < nthread; i++) {
+    worker[i] = *spmv;
+    worker[i].first = spmv->first + (REF_INT)((REF_LONG)nrow * i / nthread);
+    worker[i].last =
+        spmv->first + (REF_INT)((REF_LONG)nrow * (i + 1) / nthread);
+    worker[i].status = REF_SUCCESS;
+    started[i] = (0 == pthread_create(&(thread[i]), NULL,
+                                      ref_interp_spmv_thread, &(worker[i])));
+  }
+  for (i = 0; i < nthread; i++) {
+    if (started[i]) {
+      REIS(0, pthread_join(thread[i], NULL), "join");
+    } else { /* finish the rows of a thread that failed to start */
+      worker[i].status = ref_interp_spmv_rows(&(worker[i]));
+    }
+    if (REF_SUCCESS != worker[i].status) status = worker[i].status;
+  }
+  ref_free(started);
+  ref_free(thread);
+  ref_free(worker);
+  RSS(status, "threaded rows");
+#else
+  RSS(ref_interp_spmv_rows(spmv), "serial rows");
+#endif
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_interp_scalar(REF_INTERP ref_interp, REF_INT leading_dim,
+                                     REF_DBL *from_scalar, REF_DBL *to_scalar) {
+  REF_GRID to_grid = ref_interp_to_grid(ref_interp);
+  REF_NODE to_node = ref_grid_node(to_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(to_grid);
+  REF_INT node, im;
+  REF_INT receptor, n_recept, n_donor;
+  REF_DBL *recept_scalar, *donor_scalar;
+  REF_INTERP_SPMV_STRUCT spmv;
+
+  if (NULL == ref_interp->plan_donor_size) {
+    RSS(ref_interp_plan_create(ref_interp), "plan");
+  }
+  n_donor = ref_interp->plan_n_donor;
+  n_recept = ref_interp->plan_n_recept;
+
+  /* SpMV over all leading_dim fields, one exchange for the batch */
+  ref_malloc(donor_scalar, leading_dim * n_donor, REF_DBL);
+  spmv.first = 0;
+  spmv.last = n_donor;
+  spmv.leading_dim = leading_dim;
+  spmv.ptr = ref_interp->plan_donor_ptr;
+  spmv.node = ref_interp->plan_donor_node;
+  spmv.weight = ref_interp->plan_donor_weight;
+  spmv.from = from_scalar;
+  spmv.to = donor_scalar;
+  spmv.status = REF_SUCCESS;
+  RSS(ref_interp_spmv(&spmv), "spmv");
+
+  ref_malloc(recept_scalar, leading_dim * n_recept, REF_DBL);
+  RSS(ref_mpi_alltoallv(ref_mpi, donor_scalar, ref_interp->plan_donor_size,
+                        recept_scalar, ref_interp->plan_recept_size,
+                        leading_dim, REF_DBL_TYPE),
+      "alltoallv scalar");
   ref_free(donor_scalar);
-  ref_free(donor_node);
-  ref_free(donor_ret);
 
   for (receptor = 0; receptor < n_recept; receptor++) {
-    node = recept_node[receptor];
+    node = ref_interp->plan_recept_node[receptor];
     for (im = 0; im < leading_dim; im++) {
       RAS(isfinite(recept_scalar[im + leading_dim * receptor]),
           "recept_scalar");
@@ -2164,17 +2321,8 @@ REF_FCN REF_STATUS ref_interp_scalar(REF_INTERP ref_interp, REF_INT leading_dim,
           recept_scalar[im + leading_dim * receptor];
     }
   }
-
-  ref_free(recept_node);
   ref_free(recept_scalar);
 
-  /*
-  each_ref_node_valid_node(to_node, node) {
-    for (im = 0; im < leading_dim; im++) {
-      RAS(isfinite(to_scalar[im + leading_dim * node]), "to_scalar local");
-    }
-  }
-  */
   RSS(ref_node_ghost_dbl(to_node, to_scalar, leading_dim), "ghost");
   each_ref_node_valid_node(to_node, node) {
     for (im = 0; im < leading_dim; im++) {
@@ -2204,6 +2352,8 @@ REF_FCN REF_STATUS ref_interp_face_only(REF_INTERP ref_interp, REF_INT faceid,
   REF_BOOL increase_fuzz;
   REF_INT tries;
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
+
   RSS(ref_grid_compact_surf_id_nodes(to_grid, faceid, &nnode, &ncell, &l2c),
       "l2c");
 
@@ -2754,6 +2904,8 @@ REF_FCN REF_STATUS ref_interp_from_part(REF_INTERP ref_interp,
   REF_BOOL report_migration_volume = REF_FALSE;
   REF_BOOL report_interp_error = REF_FALSE;
 
+  RSS(ref_interp_plan_free(ref_interp), "plan");
+
   if (ref_grid_twod(from_grid)) {
     from_cell = ref_interp_from_tri(ref_interp);
   } else {
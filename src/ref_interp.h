@@ -63,6 +63,14 @@ struct REF_INTERP_STRUCT {
   REF_DBL search_fuzz;
   REF_DBL search_donor_scale;
   REF_SEARCH ref_search;
+  REF_INT plan_n_donor;
+  REF_INT plan_n_recept;
+  REF_INT *plan_donor_size;
+  REF_INT *plan_donor_ptr; /* CSR rows of donor nodes and weights */
+  REF_INT *plan_donor_node;
+  REF_DBL *plan_donor_weight;
+  REF_INT *plan_recept_size;
+  REF_INT *plan_recept_node;
 };
 
 #define ref_interp_from_grid(ref_interp) ((ref_interp)->from_grid)
@@ -104,6 +112,8 @@ REF_FCN REF_STATUS ref_interp_locate_between(REF_INTERP ref_interp,
                                              REF_INT node0, REF_INT node1,
                                              REF_INT new_node);
 
+/* donor/receptor exchange of ref_interp_scalar, kept until donors change */
+REF_FCN REF_STATUS ref_interp_plan_free(REF_INTERP ref_interp);
 REF_FCN REF_STATUS ref_interp_scalar(REF_INTERP ref_interp, REF_INT leading_dim,
                                      REF_DBL *from_scalar, REF_DBL *to_scalar);
 
@@ -1333,6 +1333,63 @@ int main(int argc, char *argv[]) {
       RWDS(0.0, dist2, 2.0e-3, "interp scalar xyz not matching");
     }
 
+    /* reuse the exchange plan with another leading_dim */
+    each_ref_node_valid_node(ref_grid_node(from), node) {
+      from_scalar[node] = ref_node_xyz(ref_grid_node(from), 2, node);
+    }
+    RSS(ref_interp_scalar(ref_interp, 1, from_scalar, to_scalar), "interp");
+    each_ref_node_valid_node(ref_grid_node(to), node) {
+      RWDS(ref_node_xyz(ref_grid_node(to), 2, node), to_scalar[node], 5.0e-2,
+           "reused plan z not matching");
+    }
+
+    /* many fields in one call split the rows over threads */
+    {
+      REF_INT ldim = 512, im;
+      REF_DBL *many_from, *many_to;
+      ref_malloc(many_from, ldim * ref_node_max(ref_grid_node(from)),
+                 REF_DBL);
+      ref_malloc_init(many_to, ldim * ref_node_max(ref_grid_node(to)),
+                      REF_DBL, 0.0);
+      each_ref_node_valid_node(ref_grid_node(from), node) {
+        for (im = 0; im < ldim; im++)
+          many_from[im + ldim * node] = (REF_DBL)(im + 1) * from_scalar[node];
+      }
+      RSS(ref_interp_scalar(ref_interp, ldim, many_from, many_to), "interp");
+      each_ref_node_valid_node(ref_grid_node(to), node) {
+        for (im = 0; im < ldim; im++)
+          RWDS((REF_DBL)(im + 1) * to_scalar[node], many_to[im + ldim * node],
+               1.0e-12 * (REF_DBL)(im + 1), "many fields not matching");
+      }
+      ref_free(many_to);
+      ref_free(many_from);
+    }
+
+    /* transfer operator rows are partitions of unity, at most 4 donors */
+    for (i = 0; i < ref_interp->plan_n_donor; i++) {
+      REF_INT entry;
+      dist2 = 0.0;
+      RAS(ref_interp->plan_donor_ptr[i + 1] - ref_interp->plan_donor_ptr[i] > 0,
+          "empty row");
+      RAS(ref_interp->plan_donor_ptr[i + 1] - ref_interp->plan_donor_ptr[i] <=
+              4,
+          "row too long");
+      for (entry = ref_interp->plan_donor_ptr[i];
+           entry < ref_interp->plan_donor_ptr[i + 1]; entry++) {
+        dist2 += ref_interp->plan_donor_weight[entry];
+      }
+      RWDS(1.0, dist2, -1.0, "row weights");
+    }
+
+    /* removing a located node invalidates the plan */
+    RAS(NULL != ref_interp->plan_donor_size, "plan expected");
+    ref_interp_continuously(ref_interp) = REF_FALSE;
+    each_ref_node_valid_node(ref_grid_node(to), node) {
+      RSS(ref_interp_remove(ref_interp, node), "remove");
+      break;
+    }
+    RAS(NULL == ref_interp->plan_donor_size, "stale plan kept");
+
     RSS(ref_interp_free(ref_interp), "free");
     ref_free(to_scalar);
     ref_free(from_scalar);
@@ -72,6 +72,7 @@ REF_FCN static REF_STATUS ref_iso_ghost(REF_GRID iso_grid, REF_EDGE ref_edge,
       for (i = 0; i < REF_NODE_REAL_PER; i++)
         ref_node_real(ref_grid_node(iso_grid), i, node) =
             edge_real[i + REF_NODE_REAL_PER * edge];
+      ref_node_metric_stale(ref_grid_node(iso_grid), node);
     }
   }
 
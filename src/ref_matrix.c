@@ -315,6 +315,93 @@ REF_FCN REF_STATUS ref_matrix_diag_m2(REF_DBL *m, REF_DBL *d) {
   return REF_SUCCESS;
 }
 
+/* cyclic Jacobi rotation of the (p,q) entry of lanes of symmetric
+ * matrices, r is the remaining row, selects instead of branches */
+static void ref_matrix_jacobi_rotate(REF_INT lanes,
+                                     REF_DBL (*a)[REF_MATRIX_LANES],
+                                     REF_DBL (*v)[REF_MATRIX_LANES], REF_INT p,
+                                     REF_INT q, REF_INT pp, REF_INT qq,
+                                     REF_INT pq, REF_INT rp, REF_INT rq) {
+  REF_INT lane, k;
+  REF_DBL apq, theta, t, c, s, arp, arq, vkp, vkq;
+  for (lane = 0; lane < lanes; lane++) {
+    apq = a[pq][lane];
+    theta = (a[qq][lane] - a[pp][lane]) / (0.0 != apq ? 2.0 * apq : 1.0);
+    t = (theta >= 0.0 ? 1.0 : -1.0) / (ABS(theta) + sqrt(theta * theta + 1.0));
+    t = (0.0 != apq ? t : 0.0);
+    c = 1.0 / sqrt(t * t + 1.0);
+    s = t * c;
+    a[pp][lane] -= t * apq;
+    a[qq][lane] += t * apq;
+    a[pq][lane] = 0.0;
+    arp = a[rp][lane];
+    arq = a[rq][lane];
+    a[rp][lane] = c * arp - s * arq;
+    a[rq][lane] = s * arp + c * arq;
+    for (k = 0; k < 3; k++) {
+      vkp = v[k + 3 * p][lane];
+      vkq = v[k + 3 * q][lane];
+      v[k + 3 * p][lane] = c * vkp - s * vkq;
+      v[k + 3 * q][lane] = s * vkp + c * vkq;
+    }
+  }
+}
+
+/* reports the first of n matrices with an inf or nan entry */
+REF_FCN static REF_STATUS ref_matrix_finite_many(REF_INT n, REF_DBL *m) {
+  REF_INT i;
+  for (i = 0; i < 6 * n; i++) {
+    if (!isfinite(m[i])) {
+      printf("matrix %d of %d is not finite\n", i / 6, n);
+      ref_matrix_show_m(&(m[6 * (i / 6)]));
+      return REF_INVALID;
+    }
+  }
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_matrix_diag_m_many(REF_INT n, REF_DBL *m,
+                                          REF_DBL *d) {
+  REF_DBL a[6][REF_MATRIX_LANES], v[9][REF_MATRIX_LANES];
+  REF_DBL off, scale;
+  REF_INT first, lanes, lane, i, sweep;
+
+  RSS(ref_matrix_finite_many(n, m), "jacobi input");
+
+  for (first = 0; first < n; first += REF_MATRIX_LANES) {
+    lanes = MIN(REF_MATRIX_LANES, n - first);
+    for (i = 0; i < 6; i++)
+      for (lane = 0; lane < lanes; lane++)
+        a[i][lane] = m[i + 6 * (first + lane)];
+    for (i = 0; i < 9; i++)
+      for (lane = 0; lane < lanes; lane++)
+        v[i][lane] = (0 == i % 4 ? 1.0 : 0.0);
+    for (sweep = 0; sweep < REF_MATRIX_JACOBI_SWEEPS; sweep++) {
+      ref_matrix_jacobi_rotate(lanes, a, v, 0, 1, 0, 3, 1, 2, 4);
+      ref_matrix_jacobi_rotate(lanes, a, v, 0, 2, 0, 5, 2, 1, 4);
+      ref_matrix_jacobi_rotate(lanes, a, v, 1, 2, 3, 5, 4, 1, 2);
+    }
+    for (lane = 0; lane < lanes; lane++) {
+      off = ABS(a[1][lane]) + ABS(a[2][lane]) + ABS(a[4][lane]);
+      scale = ABS(a[0][lane]) + ABS(a[3][lane]) + ABS(a[5][lane]);
+      if (off > 1.0e-10 * scale) {
+        printf("matrix %d of %d did not converge in %d sweeps\n",
+               first + lane, n, REF_MATRIX_JACOBI_SWEEPS);
+        ref_matrix_show_m(&(m[6 * (first + lane)]));
+        return REF_FAILURE;
+      }
+    }
+    for (lane = 0; lane < lanes; lane++) {
+      ref_matrix_eig(&(d[12 * (first + lane)]), 0) = a[0][lane];
+      ref_matrix_eig(&(d[12 * (first + lane)]), 1) = a[3][lane];
+      ref_matrix_eig(&(d[12 * (first + lane)]), 2) = a[5][lane];
+      for (i = 0; i < 9; i++) d[3 + i + 12 * (first + lane)] = v[i][lane];
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_matrix_descending_eig(REF_DBL *d) {
   REF_DBL temp;
   REF_INT i;
@@ -564,6 +651,100 @@ REF_FCN REF_STATUS ref_matrix_sqrt_m(REF_DBL *m_upper_tri,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_matrix_log_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                         REF_DBL *log_m_upper_tri) {
+  REF_DBL d[12 * REF_MATRIX_LANES];
+  REF_INT first, lanes, lane;
+
+  for (first = 0; first < n; first += REF_MATRIX_LANES) {
+    lanes = MIN(REF_MATRIX_LANES, n - first);
+    RSB(ref_matrix_diag_m_many(lanes, &(m_upper_tri[6 * first]), d), "diag",
+        { printf("batch starts at matrix %d of %d\n", first, n); });
+    for (lane = 0; lane < lanes; lane++) {
+      d[0 + 12 * lane] = log(d[0 + 12 * lane]);
+      d[1 + 12 * lane] = log(d[1 + 12 * lane]);
+      d[2 + 12 * lane] = log(d[2 + 12 * lane]);
+      RSS(ref_matrix_form_m(&(d[12 * lane]),
+                            &(log_m_upper_tri[6 * (first + lane)])),
+          "form m");
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_matrix_exp_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                         REF_DBL *exp_m_upper_tri) {
+  REF_DBL d[12 * REF_MATRIX_LANES];
+  REF_INT first, lanes, lane;
+
+  for (first = 0; first < n; first += REF_MATRIX_LANES) {
+    lanes = MIN(REF_MATRIX_LANES, n - first);
+    RSB(ref_matrix_diag_m_many(lanes, &(m_upper_tri[6 * first]), d), "diag",
+        { printf("batch starts at matrix %d of %d\n", first, n); });
+    for (lane = 0; lane < lanes; lane++) {
+      d[0 + 12 * lane] = exp(d[0 + 12 * lane]);
+      d[1 + 12 * lane] = exp(d[1 + 12 * lane]);
+      d[2 + 12 * lane] = exp(d[2 + 12 * lane]);
+      RSS(ref_matrix_form_m(&(d[12 * lane]),
+                            &(exp_m_upper_tri[6 * (first + lane)])),
+          "form m");
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+/* ref_matrix_sqrt_m from a diagonal system, which is overwritten */
+REF_FCN static REF_STATUS ref_matrix_sqrt_d(REF_DBL *d,
+                                            REF_DBL *sqrt_m_upper_tri,
+                                            REF_DBL *inv_sqrt_m_upper_tri) {
+  if (d[0] < 0.0 || d[1] < 0.0 || d[2] < 0.0) return REF_FAILURE;
+  d[0] = sqrt(d[0]);
+  d[1] = sqrt(d[1]);
+  d[2] = sqrt(d[2]);
+
+  RSS(ref_matrix_form_m(d, sqrt_m_upper_tri), "form m");
+
+  if (!ref_math_divisible(1.0, d[0]) || !ref_math_divisible(1.0, d[1]) ||
+      !ref_math_divisible(1.0, d[2])) {
+    return REF_DIV_ZERO;
+  }
+  d[0] = 1.0 / d[0];
+  d[1] = 1.0 / d[1];
+  d[2] = 1.0 / d[2];
+
+  RSS(ref_matrix_form_m(d, inv_sqrt_m_upper_tri), "form inv m");
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_matrix_sqrt_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                          REF_DBL *sqrt_m_upper_tri,
+                                          REF_DBL *inv_sqrt_m_upper_tri) {
+  REF_DBL d[12 * REF_MATRIX_LANES];
+  REF_INT first, lanes, lane;
+  REF_STATUS status;
+
+  for (first = 0; first < n; first += REF_MATRIX_LANES) {
+    lanes = MIN(REF_MATRIX_LANES, n - first);
+    RSB(ref_matrix_diag_m_many(lanes, &(m_upper_tri[6 * first]), d), "diag",
+        { printf("batch starts at matrix %d of %d\n", first, n); });
+    for (lane = 0; lane < lanes; lane++) {
+      status = ref_matrix_sqrt_d(&(d[12 * lane]),
+                                 &(sqrt_m_upper_tri[6 * (first + lane)]),
+                                 &(inv_sqrt_m_upper_tri[6 * (first + lane)]));
+      if (REF_FAILURE == status) {
+        REF_WHERE("negative eigenvalues");
+        ref_matrix_show_m(&(m_upper_tri[6 * (first + lane)]));
+      }
+      if (REF_SUCCESS != status) return status;
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_matrix_sqrt_abs_m(REF_DBL *m_upper_tri,
                                                 REF_DBL *sqrt_m_upper_tri,
                                                 REF_DBL *inv_sqrt_m_upper_tri) {
@@ -719,6 +900,60 @@ REF_FCN REF_STATUS ref_matrix_intersect(REF_DBL *m1, REF_DBL *m2,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_matrix_intersect_many(REF_INT n, REF_DBL *m1,
+                                             REF_DBL *m2, REF_DBL *m12) {
+  REF_DBL d[12 * REF_MATRIX_LANES];
+  REF_DBL m1half[6 * REF_MATRIX_LANES], m1neghalf[6 * REF_MATRIX_LANES];
+  REF_DBL m2bar[6 * REF_MATRIX_LANES], m12bar[6];
+  REF_STATUS status[REF_MATRIX_LANES];
+  REF_INT first, lanes, lane, i;
+
+  for (first = 0; first < n; first += REF_MATRIX_LANES) {
+    lanes = MIN(REF_MATRIX_LANES, n - first);
+    RSB(ref_matrix_diag_m_many(lanes, &(m1[6 * first]), d), "diag m1",
+        { printf("batch starts at matrix %d of %d\n", first, n); });
+    for (lane = 0; lane < lanes; lane++) {
+      status[lane] = ref_matrix_sqrt_d(&(d[12 * lane]), &(m1half[6 * lane]),
+                                       &(m1neghalf[6 * lane]));
+      if (REF_DIV_ZERO == status[lane]) {
+        /* m12 = m2 like ref_matrix_intersect, diagonalize a placeholder */
+        for (i = 0; i < 6; i++) m2bar[i + 6 * lane] = 0.0;
+        continue;
+      }
+      if (REF_SUCCESS != status[lane]) {
+        REF_WHERE("ref_matrix_sqrt_m failed");
+        printf("m1\n");
+        ref_matrix_show_m(&(m1[6 * (first + lane)]));
+        printf("m2\n");
+        ref_matrix_show_m(&(m2[6 * (first + lane)]));
+        return status[lane];
+      }
+      RSS(ref_matrix_mult_m0m1m0(&(m1neghalf[6 * lane]),
+                                 &(m2[6 * (first + lane)]),
+                                 &(m2bar[6 * lane])),
+          "m2bar=m1half*m2*m1half");
+    }
+    RSB(ref_matrix_diag_m_many(lanes, m2bar, d), "diag m12bar",
+        { printf("batch starts at matrix %d of %d\n", first, n); });
+    for (lane = 0; lane < lanes; lane++) {
+      if (REF_DIV_ZERO == status[lane]) {
+        for (i = 0; i < 6; i++)
+          m12[i + 6 * (first + lane)] = m2[i + 6 * (first + lane)];
+        continue;
+      }
+      for (i = 0; i < 3; i++)
+        ref_matrix_eig(&(d[12 * lane]), i) =
+            MAX(1.0, ref_matrix_eig(&(d[12 * lane]), i));
+      RSS(ref_matrix_form_m(&(d[12 * lane]), m12bar), "form m12bar");
+      RSS(ref_matrix_mult_m0m1m0(&(m1half[6 * lane]), m12bar,
+                                 &(m12[6 * (first + lane)])),
+          "m12=m1half*m12bar*m1half");
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_matrix_bound(REF_DBL *m1, REF_DBL *m2, REF_DBL *m12) {
   REF_DBL m1half[6];
   REF_DBL m1neghalf[6];
@@ -52,6 +52,14 @@ REF_FCN REF_STATUS ref_matrix_diag_m(REF_DBL *m_upper_tri,
 REF_FCN REF_STATUS ref_matrix_diag_m2(REF_DBL *m_upper_tri,
                                       REF_DBL *diagonal_system);
 
+/* matrices diagonalized together by the _many batched variants */
+#define REF_MATRIX_LANES (8)
+/* fixed cyclic Jacobi sweeps, no convergence test */
+#define REF_MATRIX_JACOBI_SWEEPS (5)
+/* n packed m_upper_tri[6*n] into diagonal_system[12*n], unsorted */
+REF_FCN REF_STATUS ref_matrix_diag_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                          REF_DBL *diagonal_system);
+
 REF_FCN REF_STATUS ref_matrix_descending_eig(REF_DBL *diagonal_system);
 REF_FCN REF_STATUS ref_matrix_descending_eig_twod(REF_DBL *diagonal_system);
 
@@ -72,6 +80,13 @@ REF_FCN REF_STATUS ref_matrix_exp_m(REF_DBL *m_upper_tri,
 REF_FCN REF_STATUS ref_matrix_sqrt_m(REF_DBL *m_upper_tri,
                                      REF_DBL *sqrt_m_upper_tri,
                                      REF_DBL *inv_sqrt_m_upper_tri);
+REF_FCN REF_STATUS ref_matrix_log_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                         REF_DBL *log_m_upper_tri);
+REF_FCN REF_STATUS ref_matrix_exp_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                         REF_DBL *exp_m_upper_tri);
+REF_FCN REF_STATUS ref_matrix_sqrt_m_many(REF_INT n, REF_DBL *m_upper_tri,
+                                          REF_DBL *sqrt_m_upper_tri,
+                                          REF_DBL *inv_sqrt_m_upper_tri);
 REF_FCN REF_STATUS ref_matrix_weight_m(REF_DBL *m0_upper_tri,
                                        REF_DBL *m1_upper_tri, REF_DBL m1_weight,
                                        REF_DBL *avg_m_upper_tri);
@@ -80,6 +95,8 @@ REF_FCN REF_STATUS ref_matrix_mult_m0m1m0(REF_DBL *m0, REF_DBL *m1, REF_DBL *m);
 REF_FCN REF_STATUS ref_matrix_vect_mult(REF_DBL *a, REF_DBL *x, REF_DBL *b);
 
 REF_FCN REF_STATUS ref_matrix_intersect(REF_DBL *m1, REF_DBL *m2, REF_DBL *m12);
+REF_FCN REF_STATUS ref_matrix_intersect_many(REF_INT n, REF_DBL *m1,
+                                             REF_DBL *m2, REF_DBL *m12);
 REF_FCN REF_STATUS ref_matrix_bound(REF_DBL *m1, REF_DBL *m2, REF_DBL *m12);
 
 REF_FCN REF_STATUS ref_matrix_healthy_m(REF_DBL *m);
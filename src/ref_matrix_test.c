@@ -483,6 +483,102 @@ ee =
     RWDS(m[5], m2[5], tol, "m[5]");
   }
 
+  { /* batched jacobi diag decom, reform and orthonormal */
+    REF_DBL m[6 * 11] = {1.0, 0.0, 0.0, 1.0, 0.0, 1.0, 13.0, -4.0, 0.0, 7.0,
+                         0.0, 1.0, 13.0, 0.0, -4.0, 4.0, 0.0, 7.0, 1.0, 0.0,
+                         0.0, 1000.0, 0.0, 1000000.0, 1.0, 2.0, 3.0, 4.0, 5.0,
+                         6.0, 1345234.0, 245.0, 1700.0, 45.0, 5.0, 24000.0,
+                         1345234.0, -10000.0, 3400.0, 2345.0, -15.0, 24.0,
+                         2.656600171239854e+10, -1.553315064215467e+10,
+                         5.234282331017903e+10, 9.082258454339514e+09,
+                         -3.060805186711674e+10, 1.036440949614571e+11, 0.0,
+                         0.0, 0.0, 0.0, 0.0, 0.0, 2.0, 1.0, 1.0, 2.0, 1.0, 2.0,
+                         5.569680, -0.166955, -0.056476, 5.645046, 1.230437,
+                         2.881886};
+    REF_DBL d[12 * 11], ql[12], m2[6];
+    REF_DBL scale, dot, tol;
+    REF_INT n = 11, i, j, k, e;
+
+    RSS(ref_matrix_diag_m_many(n, m, d), "diag many");
+    for (i = 0; i < n; i++) {
+      scale = 0.0;
+      for (j = 0; j < 6; j++) scale = MAX(scale, ABS(m[j + 6 * i]));
+      tol = MAX(1.0e-14, 1.0e-14 * scale);
+      RSS(ref_matrix_form_m(&(d[12 * i]), m2), "reform m");
+      for (j = 0; j < 6; j++) RWDS(m[j + 6 * i], m2[j], tol, "reform");
+      for (j = 0; j < 3; j++) {
+        for (k = 0; k < 3; k++) {
+          dot = 0.0;
+          for (e = 0; e < 3; e++)
+            dot += ref_matrix_vec(&(d[12 * i]), e, j) *
+                   ref_matrix_vec(&(d[12 * i]), e, k);
+          RWDS((j == k ? 1.0 : 0.0), dot, 1.0e-14, "orthonormal");
+        }
+      }
+      RSS(ref_matrix_diag_m(&(m[6 * i]), ql), "ql diag");
+      RSS(ref_matrix_descending_eig(ql), "sort ql");
+      RSS(ref_matrix_descending_eig(&(d[12 * i])), "sort jacobi");
+      for (j = 0; j < 3; j++)
+        RWDS(ref_matrix_eig(ql, j), ref_matrix_eig(&(d[12 * i]), j), tol,
+             "eig");
+    }
+  }
+
+  { /* batched jacobi diag decom, non-finite */
+    REF_DBL m[6] = {1.0, 0.0, 0.0, 1.0, 0.0, 1.0};
+    REF_DBL d[12];
+    m[4] = 1.0 / 0.0;
+    REIS(REF_INVALID, ref_matrix_diag_m_many(1, m, d), "inf");
+  }
+
+  { /* batched log, exp, sqrt, intersect match scalar */
+    REF_INT n = 10, i, j;
+    REF_DBL m1[6 * 10], m2[6 * 10], batch[6 * 10], inv[6 * 10];
+    REF_DBL scalar[6], scalar_inv[6], back[6 * 10];
+    REF_DBL tol;
+    REF_DBL spd[6 * 5] = {1.0,   0.0,   0.0,   1.0,   0.0,   1.0,
+                          13.0,  -4.0,  0.0,   7.0,   0.0,   1.0,
+                          13.0,  0.0,   -4.0,  4.0,   0.0,   7.0,
+                          100.0, 0.0,   0.0,   1.0,   0.0,   0.01,
+                          5.569680, -0.166955, -0.056476, 5.645046,
+                          1.230437, 2.881886};
+    for (i = 0; i < n; i++) {
+      for (j = 0; j < 6; j++) {
+        m1[j + 6 * i] = spd[j + 6 * (i % 5)];
+        m2[j + 6 * i] = spd[j + 6 * ((3 * i + 1) % 5)] * (1.0 + (REF_DBL)i);
+      }
+    }
+
+    RSS(ref_matrix_log_m_many(n, m1, batch), "log many");
+    for (i = 0; i < n; i++) {
+      RSS(ref_matrix_log_m(&(m1[6 * i]), scalar), "log");
+      for (j = 0; j < 6; j++) RWDS(scalar[j], batch[j + 6 * i], -1, "log");
+    }
+    RSS(ref_matrix_exp_m_many(n, batch, back), "exp many");
+    for (i = 0; i < n; i++) {
+      for (j = 0; j < 6; j++) RWDS(m1[j + 6 * i], back[j + 6 * i], -1, "exp");
+    }
+
+    RSS(ref_matrix_sqrt_m_many(n, m1, batch, inv), "sqrt many");
+    for (i = 0; i < n; i++) {
+      RSS(ref_matrix_sqrt_m(&(m1[6 * i]), scalar, scalar_inv), "sqrt");
+      for (j = 0; j < 6; j++) {
+        RWDS(scalar[j], batch[j + 6 * i], -1, "sqrt");
+        RWDS(scalar_inv[j], inv[j + 6 * i], -1, "inv sqrt");
+      }
+    }
+
+    for (j = 0; j < 6; j++) m1[j + 6 * 7] = 0.0; /* zero m1 takes m2 */
+    RSS(ref_matrix_intersect_many(n, m1, m2, batch), "intersect many");
+    for (i = 0; i < n; i++) {
+      RSS(ref_matrix_intersect(&(m1[6 * i]), &(m2[6 * i]), scalar), "int");
+      for (j = 0; j < 6; j++) {
+        tol = MAX(1.0e-12, 1.0e-11 * ABS(scalar[j]));
+        RWDS(scalar[j], batch[j + 6 * i], tol, "intersect");
+      }
+    }
+  }
+
   /* jac test code
     m =[
      5.569680  -0.166955  -0.056476
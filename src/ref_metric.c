@@ -29,6 +29,7 @@
 #include "ref_edge.h"
 #include "ref_egads.h"
 #include "ref_grid.h"
+#include "ref_heap.h"
 #include "ref_interp.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
@@ -68,11 +69,21 @@ REF_FCN REF_STATUS ref_metric_from_node(REF_DBL *metric, REF_NODE ref_node) {
 }
 
 REF_FCN REF_STATUS ref_metric_to_node(REF_DBL *metric, REF_NODE ref_node) {
-  REF_INT node;
+  REF_INT node, i, n;
+  REF_INT nodes[8 * REF_MATRIX_LANES];
+  REF_DBL m[6 * 8 * REF_MATRIX_LANES];
 
+  n = 0;
   each_ref_node_valid_node(ref_node, node) {
-    RSS(ref_node_metric_set(ref_node, node, &(metric[6 * node])), "set");
+    nodes[n] = node;
+    for (i = 0; i < 6; i++) m[i + 6 * n] = metric[i + 6 * node];
+    n++;
+    if (8 * REF_MATRIX_LANES == n) {
+      RSS(ref_node_metric_set_many(ref_node, n, nodes, m), "set");
+      n = 0;
+    }
   }
+  RSS(ref_node_metric_set_many(ref_node, n, nodes, m), "set");
 
   return REF_SUCCESS;
 }
@@ -490,6 +501,7 @@ REF_FCN REF_STATUS ref_metric_interpolate_node(REF_GRID ref_grid,
   }
 
   if (!ref_interp_continuously(ref_interp)) {
+    RSS(ref_interp_plan_free(ref_interp), "plan");
     ref_interp_cell(ref_interp, node) = REF_EMPTY; /* mark moved */
     return REF_SUCCESS;
   }
@@ -549,6 +561,7 @@ REF_FCN REF_STATUS ref_metric_interpolate_between(REF_GRID ref_grid,
   }
 
   if (!ref_interp_continuously(ref_interp)) {
+    RSS(ref_interp_plan_free(ref_interp), "plan");
     ref_interp->cell[new_node] = REF_EMPTY; /* initialize new_node locate */
     return REF_SUCCESS;
   }
@@ -809,6 +822,90 @@ REF_FCN REF_STATUS ref_metric_metric_space_gradation(REF_DBL *metric,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_metric_metric_space_front_gradation(REF_DBL *metric,
+                                                           REF_GRID ref_grid,
+                                                           REF_DBL r) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_EDGE ref_edge;
+  REF_HEAP ref_heap;
+  REF_DBL *key;
+  REF_DBL ratio, enlarge, log_r, det, priority;
+  REF_DBL direction[3];
+  REF_DBL limit_metric[6], limited[6];
+  REF_DBL tol = 1.0e-8;
+  REF_INT node, other, i, item, edge;
+  REF_INT round, max_rounds = 100;
+  REF_INT changed;
+
+  log_r = log(r);
+
+  RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
+  RSS(ref_heap_create(&ref_heap), "heap");
+  ref_malloc_init(key, ref_node_max(ref_node), REF_DBL, 0.0);
+
+  /* densest metric first, its limits can only tighten sparser nodes */
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(ref_matrix_det_m(&(metric[6 * node]), &(key[node])), "det");
+    RSS(ref_heap_push(ref_heap, node, key[node]), "push");
+  }
+
+  for (round = 0; round < max_rounds; round++) {
+    while (REF_SUCCESS == ref_heap_pop(ref_heap, &node, &priority)) {
+      if (priority != key[node]) continue; /* stale, tightened since push */
+      each_edge_having_node(ref_edge, node, item, edge) {
+        other = ref_edge_e2n(ref_edge, 0, edge);
+        if (other == node) other = ref_edge_e2n(ref_edge, 1, edge);
+        for (i = 0; i < 3; i++)
+          direction[i] = ref_node_xyz(ref_node, i, other) -
+                         ref_node_xyz(ref_node, i, node);
+        /* F. Alauzet doi:10.1016/j.finel.2009.06.028 equation (9) */
+        ratio = ref_matrix_sqrt_vt_m_v(&(metric[6 * node]), direction);
+        enlarge = pow(1.0 + ratio * log_r, -2.0);
+        for (i = 0; i < 6; i++)
+          limit_metric[i] = metric[i + 6 * node] * enlarge;
+        if (REF_SUCCESS != ref_matrix_intersect(&(metric[6 * other]),
+                                                limit_metric, limited)) {
+          REF_WHERE("limit with enlarged neighbor");
+          ref_node_location(ref_node, other);
+          printf("ratio %24.15e enlarge %24.15e \n", ratio, enlarge);
+          printf("RECOVER ref_metric_metric_space_front_gradation\n");
+          continue;
+        }
+        RSS(ref_matrix_det_m(limited, &det), "det");
+        if (det > (1.0 + tol) * key[other]) {
+          for (i = 0; i < 6; i++) metric[i + 6 * other] = limited[i];
+          key[other] = det;
+          RSS(ref_heap_push(ref_heap, other, key[other]), "push");
+        }
+      }
+    }
+
+    /* owners overwrite ghosts, restart the front where a ghost changed */
+    RSS(ref_node_ghost_dbl(ref_node, metric, 6), "update ghosts");
+    changed = 0;
+    each_ref_node_valid_node(ref_node, node) {
+      if (ref_node_owned(ref_node, node)) continue;
+      RSS(ref_matrix_det_m(&(metric[6 * node]), &det), "det");
+      if (ABS(det - key[node]) > tol * MAX(ABS(det), ABS(key[node]))) {
+        key[node] = det;
+        RSS(ref_heap_push(ref_heap, node, key[node]), "push");
+        changed++;
+      }
+    }
+    RSS(ref_mpi_allsum(ref_mpi, &changed, 1, REF_INT_TYPE), "sum");
+    if (0 == changed) break;
+  }
+  if (max_rounds == round && ref_mpi_once(ref_mpi))
+    printf("front gradation stopped after %d ghost rounds\n", max_rounds);
+
+  ref_free(key);
+  RSS(ref_heap_free(ref_heap), "heap");
+  ref_edge_free(ref_edge);
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_metric_mixed_space_gradation(REF_DBL *metric,
                                                     REF_GRID ref_grid,
                                                     REF_DBL r, REF_DBL t) {
@@ -994,35 +1091,51 @@ REF_FCN REF_STATUS ref_metric_interpolation_error(
     REF_DBL *interpolation_error) {
   /* Corollary 3.4 CONTINUOUS MESH FRAMEWORK PART I DOI:10.1137/090754078 */
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_INT node;
-  REF_DBL error[6], m1half[6], m1neghalf[6], det, sqrt_det;
+  REF_INT node, i, im, nlist, *list;
+  REF_DBL error[6], det, sqrt_det;
+  REF_DBL *m, *m1half, *m1neghalf;
   REF_DBL constant = 1.0 / 10.0;
   if (ref_grid_twod(ref_grid)) {
     constant = 1.0 / 8.0;
   }
+  ref_malloc(list, ref_node_n(ref_node), REF_INT);
+  ref_malloc(m, 6 * ref_node_n(ref_node), REF_DBL);
+  nlist = 0;
   each_ref_node_valid_node(ref_node, node) {
     if (ref_node_owned(ref_node, node)) {
-      RSS(ref_matrix_sqrt_m(&(metric[6 * node]), m1half, m1neghalf), "m^-1/2");
-      RSS(ref_matrix_mult_m0m1m0(m1neghalf, &(hess[6 * node]), error),
-          "error=m1half*hess*m1half");
-      RSS(ref_matrix_det_m(&(metric[6 * node]), &det), "det");
-      if (ref_grid_twod(ref_grid)) {
-        interpolation_error[node] = constant * (error[0] + error[3]);
-      } else {
-        interpolation_error[node] = constant * (error[0] + error[3] + error[5]);
-      }
-      if (det >= 0.0) {
-        sqrt_det = sqrt(det);
-        if (ref_math_divisible(interpolation_error[node], sqrt_det)) {
-          interpolation_error[node] /= sqrt_det;
-        } else {
-          interpolation_error[node] = 0.0;
-        }
+      for (im = 0; im < 6; im++) m[im + 6 * nlist] = metric[im + 6 * node];
+      list[nlist] = node;
+      nlist++;
+    }
+  }
+  ref_malloc(m1half, 6 * nlist, REF_DBL);
+  ref_malloc(m1neghalf, 6 * nlist, REF_DBL);
+  RSS(ref_matrix_sqrt_m_many(nlist, m, m1half, m1neghalf), "m^-1/2");
+  for (i = 0; i < nlist; i++) {
+    node = list[i];
+    RSS(ref_matrix_mult_m0m1m0(&(m1neghalf[6 * i]), &(hess[6 * node]), error),
+        "error=m1half*hess*m1half");
+    RSS(ref_matrix_det_m(&(metric[6 * node]), &det), "det");
+    if (ref_grid_twod(ref_grid)) {
+      interpolation_error[node] = constant * (error[0] + error[3]);
+    } else {
+      interpolation_error[node] = constant * (error[0] + error[3] + error[5]);
+    }
+    if (det >= 0.0) {
+      sqrt_det = sqrt(det);
+      if (ref_math_divisible(interpolation_error[node], sqrt_det)) {
+        interpolation_error[node] /= sqrt_det;
       } else {
         interpolation_error[node] = 0.0;
       }
+    } else {
+      interpolation_error[node] = 0.0;
     }
   }
+  ref_free(m1neghalf);
+  ref_free(m1half);
+  ref_free(m);
+  ref_free(list);
   RSS(ref_node_ghost_dbl(ref_node, interpolation_error, 1), "update ghosts");
 
   return REF_SUCCESS;
@@ -1087,6 +1200,11 @@ REF_FCN REF_STATUS ref_metric_gradation_at_complexity(REF_DBL *metric,
                current_complexity);
       return REF_DIV_ZERO;
     }
+    /* the front reaches the gradation fixed point every relaxation, stop
+     * once gradation no longer changes the complexity */
+    if (gradation >= 1.0 && relaxations > 0 &&
+        ABS(current_complexity - complexity) < 1.0e-3 * complexity)
+      break;
     each_ref_node_valid_node(ref_node, node) {
       for (i = 0; i < 6; i++) {
         metric[i + 6 * node] *=
@@ -1102,7 +1220,8 @@ REF_FCN REF_STATUS ref_metric_gradation_at_complexity(REF_DBL *metric,
       RSS(ref_metric_mixed_space_gradation(metric, ref_grid, -1.0, -1.0),
           "gradation");
     } else {
-      RSS(ref_metric_metric_space_gradation(metric, ref_grid, gradation),
+      RSS(ref_metric_metric_space_front_gradation(metric, ref_grid,
+                                                  gradation),
           "gradation");
     }
     if (ref_grid_twod(ref_grid)) {
@@ -1288,9 +1407,8 @@ REF_FCN REF_STATUS ref_metric_interpolated_curvature(REF_GRID ref_grid) {
 
 REF_FCN REF_STATUS ref_metric_constrain_curvature(REF_GRID ref_grid) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_DBL *curvature_metric;
-  REF_DBL m[6], m_constrained[6];
-  REF_INT node, gradation;
+  REF_DBL *curvature_metric, *curve, *m, *m_constrained;
+  REF_INT node, gradation, i, im, nlist, *list;
 
   ref_malloc(curvature_metric, 6 * ref_node_max(ref_node), REF_DBL);
   RSS(ref_metric_from_curvature(curvature_metric, ref_grid), "curve");
@@ -1300,14 +1418,29 @@ REF_FCN REF_STATUS ref_metric_constrain_curvature(REF_GRID ref_grid) {
         "grad");
   }
 
+  ref_malloc(list, ref_node_n(ref_node), REF_INT);
+  ref_malloc(curve, 6 * ref_node_n(ref_node), REF_DBL);
+  ref_malloc(m, 6 * ref_node_n(ref_node), REF_DBL);
+  ref_malloc(m_constrained, 6 * ref_node_n(ref_node), REF_DBL);
+  nlist = 0;
   each_ref_node_valid_node(ref_node, node) {
-    RSS(ref_node_metric_get(ref_node, node, m), "get");
-    RSS(ref_matrix_intersect(&(curvature_metric[6 * node]), m, m_constrained),
-        "intersect");
+    RSS(ref_node_metric_get(ref_node, node, &(m[6 * nlist])), "get");
+    for (im = 0; im < 6; im++)
+      curve[im + 6 * nlist] = curvature_metric[im + 6 * node];
+    list[nlist] = node;
+    nlist++;
+  }
+  RSS(ref_matrix_intersect_many(nlist, curve, m, m_constrained), "intersect");
+  for (i = 0; i < nlist; i++) {
     if (ref_grid_twod(ref_grid))
-      RSS(ref_matrix_twod_m(m_constrained), "enforce twod");
-    RSS(ref_node_metric_set(ref_node, node, m_constrained), "set node met");
+      RSS(ref_matrix_twod_m(&(m_constrained[6 * i])), "enforce twod");
+    RSS(ref_node_metric_set(ref_node, list[i], &(m_constrained[6 * i])),
+        "set node met");
   }
+  ref_free(m_constrained);
+  ref_free(m);
+  ref_free(curve);
+  ref_free(list);
 
   ref_free(curvature_metric);
 
@@ -1576,10 +1709,32 @@ static REF_STATUS add_sub_tri(REF_INT n0, REF_INT n1, REF_INT n2,
   return REF_SUCCESS;
 }
 
+/* metric of each listed node from its log, log_m is packed in list order */
+REF_FCN static REF_STATUS ref_metric_exp_list(REF_INT n, REF_INT *list,
+                                              REF_DBL *log_m,
+                                              REF_DBL *metric) {
+  REF_DBL *m;
+  REF_INT i, im;
+  ref_malloc(m, 6 * n, REF_DBL);
+  RSB(ref_matrix_exp_m_many(n, log_m, m), "exp many", {
+    for (i = 0; i < n; i++)
+      for (im = 0; im < 6; im++)
+        if (!isfinite(log_m[im + 6 * i])) {
+          printf("node %d has a non-finite log metric\n", list[i]);
+          break;
+        }
+  });
+  for (i = 0; i < n; i++)
+    for (im = 0; im < 6; im++) metric[im + 6 * list[i]] = m[im + 6 * i];
+  ref_free(m);
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_metric_imply_from(REF_DBL *metric, REF_GRID ref_grid) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_DBL m[6], log_m[6];
+  REF_DBL *log_m;
   REF_DBL *total_node_volume;
+  REF_INT *list, nlist;
   REF_INT node, im;
   REF_INT cell;
   REF_CELL ref_cell;
@@ -1652,19 +1807,25 @@ REF_FCN REF_STATUS ref_metric_imply_from(REF_DBL *metric, REF_GRID ref_grid) {
         "hex sub tet");
   }
 
+  ref_malloc(list, ref_node_n(ref_node), REF_INT);
+  ref_malloc(log_m, 6 * ref_node_n(ref_node), REF_DBL);
+  nlist = 0;
   each_ref_node_valid_node(ref_node, node) {
     if (ref_node_owned(ref_node, node)) {
       RAS(0.0 < total_node_volume[node], "zero metric contributions");
       for (im = 0; im < 6; im++) {
         if (!ref_math_divisible(metric[im + 6 * node], total_node_volume[node]))
           RSS(REF_DIV_ZERO, "zero volume");
-        log_m[im] = metric[im + 6 * node] / total_node_volume[node];
+        log_m[im + 6 * nlist] = metric[im + 6 * node] / total_node_volume[node];
       }
-      RSS(ref_matrix_exp_m(log_m, m), "exp");
-      for (im = 0; im < 6; im++) metric[im + 6 * node] = m[im];
+      list[nlist] = node;
+      nlist++;
       total_node_volume[node] = 0.0;
     }
   }
+  RSS(ref_metric_exp_list(nlist, list, log_m, metric), "exp");
+  ref_free(log_m);
+  ref_free(list);
 
   ref_free(total_node_volume);
 
@@ -2499,31 +2660,21 @@ REF_FCN REF_STATUS ref_metric_moving_multiscale(
     REF_RECON_RECONSTRUCTION reconstruction, REF_INT p_norm, REF_DBL gradation,
     REF_DBL complexity) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_DBL *jac, *x, *grad, *hess, *xyz, det;
+  REF_DBL *jac, *hess, *xyz, det;
   REF_INT i, j, node;
   ref_malloc(hess, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   ref_malloc(jac, 9 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
-  ref_malloc(x, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
-  ref_malloc(grad, 3 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
 
-  for (j = 0; j < 3; j++) {
-    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      x[node] = displaced[j + 3 * node];
-    }
-    RSS(ref_recon_gradient(ref_grid, x, grad, reconstruction), "recon x");
-    if (ref_grid_twod(ref_grid)) {
-      each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-        grad[2 + 3 * node] = 1.0;
-      }
-    }
+  /* jac[i+3*j+9*node] is d displaced_j / d x_i */
+  RSS(ref_recon_gradient_many(ref_grid, 3, displaced, jac, reconstruction),
+      "recon x");
+  if (ref_grid_twod(ref_grid)) {
     each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
-      for (i = 0; i < 3; i++) {
-        jac[i + 3 * j + 9 * node] = grad[i + 3 * node];
+      for (j = 0; j < 3; j++) {
+        jac[2 + 3 * j + 9 * node] = 1.0;
       }
     }
   }
-  ref_free(grad);
-  ref_free(x);
 
   ref_malloc(xyz, 3 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
   each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
@@ -2636,27 +2787,40 @@ REF_FCN REF_STATUS ref_metric_opt_goal(REF_DBL *metric, REF_GRID ref_grid,
     for (i = 0; i < 6; i++) metric[i + 6 * node] = 0.0;
   }
 
-  for (var = 0; var < nequations; var++) {
+  {
     REF_DBL *lam, *grad_lam, *flux, *hess_flux;
-    ref_malloc_init(lam, ref_node_max(ref_node), REF_DBL, 0.0);
-    ref_malloc_init(grad_lam, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
-    ref_malloc_init(flux, ref_node_max(ref_node), REF_DBL, 0.0);
-    ref_malloc_init(hess_flux, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
+    ref_malloc_init(lam, nequations * ref_node_max(ref_node), REF_DBL, 0.0);
+    ref_malloc_init(grad_lam, 3 * nequations * ref_node_max(ref_node), REF_DBL,
+                    0.0);
+    ref_malloc_init(flux, 3 * nequations * ref_node_max(ref_node), REF_DBL,
+                    0.0);
+    ref_malloc_init(hess_flux, 18 * nequations * ref_node_max(ref_node),
+                    REF_DBL, 0.0);
     each_ref_node_valid_node(ref_node, node) {
-      lam[node] = solution[var + ldim * node];
+      for (var = 0; var < nequations; var++) {
+        lam[var + nequations * node] = solution[var + ldim * node];
+      }
+      for (i = 0; i < 3 * nequations; i++) {
+        flux[i + 3 * nequations * node] =
+            solution[nequations + i + ldim * node];
+      }
     }
-    RSS(ref_recon_gradient(ref_grid, lam, grad_lam, reconstruction),
+    RSS(ref_recon_gradient_many(ref_grid, nequations, lam, grad_lam,
+                                reconstruction),
         "grad_lam");
-
-    for (dir = 0; dir < 3; dir++) {
-      each_ref_node_valid_node(ref_node, node) {
-        flux[node] = solution[var + nequations * (1 + dir) + ldim * node];
-      }
-      RSS(ref_recon_hessian(ref_grid, flux, hess_flux, reconstruction), "hess");
-      each_ref_node_valid_node(ref_node, node) {
-        for (i = 0; i < 6; i++)
-          metric[i + 6 * node] +=
-              ABS(grad_lam[dir + 3 * node]) * hess_flux[i + 6 * node];
+    RSS(ref_recon_hessian_many(ref_grid, 3 * nequations, flux, hess_flux,
+                               reconstruction),
+        "hess");
+
+    for (var = 0; var < nequations; var++) {
+      for (dir = 0; dir < 3; dir++) {
+        each_ref_node_valid_node(ref_node, node) {
+          for (i = 0; i < 6; i++)
+            metric[i + 6 * node] +=
+                ABS(grad_lam[dir + 3 * (var + nequations * node)]) *
+                hess_flux[i + 6 * (var + nequations * dir +
+                                   3 * nequations * node)];
+        }
       }
     }
     ref_free(hess_flux);
@@ -2692,36 +2856,41 @@ REF_FCN REF_STATUS ref_metric_belme_gfe(
   REF_INT nequ;
   REF_DBL state[5], node_flux[5], direction[3];
   REF_DBL *lam, *grad_lam, *flux, *hess_flux;
-  ref_malloc_init(lam, ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(grad_lam, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(flux, ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(hess_flux, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(lam, 5 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(grad_lam, 15 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(flux, 15 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(hess_flux, 90 * ref_node_max(ref_node), REF_DBL, 0.0);
 
   nequ = ldim / 2;
 
-  for (var = 0; var < 5; var++) {
-    each_ref_node_valid_node(ref_node, node) {
-      lam[node] = prim_dual[var + 1 * nequ + ldim * node];
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < 5; i++) {
+      state[i] = prim_dual[i + 0 * nequ + ldim * node];
+      lam[i + 5 * node] = prim_dual[i + 1 * nequ + ldim * node];
     }
-    RSS(ref_recon_gradient(ref_grid, lam, grad_lam, reconstruction),
-        "grad_lam");
     for (dir = 0; dir < 3; dir++) {
-      each_ref_node_valid_node(ref_node, node) {
-        direction[0] = 0.0;
-        direction[1] = 0.0;
-        direction[2] = 0.0;
-        direction[dir] = 1.0;
-        for (i = 0; i < 5; i++) {
-          state[i] = prim_dual[i + 0 * nequ + ldim * node];
-        }
-        RSS(ref_phys_euler(state, direction, node_flux), "euler");
-        flux[node] = node_flux[var];
+      direction[0] = 0.0;
+      direction[1] = 0.0;
+      direction[2] = 0.0;
+      direction[dir] = 1.0;
+      RSS(ref_phys_euler(state, direction, node_flux), "euler");
+      for (var = 0; var < 5; var++) {
+        flux[var + 5 * dir + 15 * node] = node_flux[var];
       }
-      RSS(ref_recon_hessian(ref_grid, flux, hess_flux, reconstruction), "hess");
+    }
+  }
+  RSS(ref_recon_gradient_many(ref_grid, 5, lam, grad_lam, reconstruction),
+      "grad_lam");
+  RSS(ref_recon_hessian_many(ref_grid, 15, flux, hess_flux, reconstruction),
+      "hess");
+
+  for (var = 0; var < 5; var++) {
+    for (dir = 0; dir < 3; dir++) {
       each_ref_node_valid_node(ref_node, node) {
         for (i = 0; i < 6; i++) {
           metric[i + 6 * node] +=
-              ABS(grad_lam[dir + 3 * node]) * hess_flux[i + 6 * node];
+              ABS(grad_lam[dir + 3 * (var + 5 * node)]) *
+              hess_flux[i + 6 * (var + 5 * dir + 15 * node)];
         }
       }
     }
@@ -2758,25 +2927,33 @@ REF_FCN REF_STATUS ref_metric_belme_gu(
   REF_DBL turbulent_pr = 0.90;
   REF_DBL thermal_conductivity;
   REF_DBL rho, turb, mu_t;
+  REF_BOOL cached;
 
   nequ = ldim / 2;
 
-  ref_malloc_init(lam, ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(hess_lam, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(lam, 5 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(hess_lam, 30 * ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(grad_lam, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(sr_lam, 5 * ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(u, ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(u, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(hess_u, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(grad_u, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(grad_u, 9 * ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(omega, 9 * ref_node_max(ref_node), REF_DBL, 0.0);
 
-  for (var = 0; var < 5; var++) {
-    each_ref_node_valid_node(ref_node, node) {
-      lam[node] = prim_dual[var + 1 * nequ + ldim * node];
+  /* weights shared by the nine reconstructions below */
+  RSS(ref_recon_cache(ref_grid, reconstruction, &cached), "cache");
+
+  each_ref_node_valid_node(ref_node, node) {
+    for (var = 0; var < 5; var++) {
+      lam[var + 5 * node] = prim_dual[var + 1 * nequ + ldim * node];
     }
-    RSS(ref_recon_hessian(ref_grid, lam, hess_lam, reconstruction), "hess_lam");
+  }
+  RSS(ref_recon_hessian_many(ref_grid, 5, lam, hess_lam, reconstruction),
+      "hess_lam");
+  for (var = 0; var < 5; var++) {
     each_ref_node_valid_node(ref_node, node) {
-      RSS(ref_matrix_diag_m(&(hess_lam[6 * node]), diag_system), "decomp");
+      RSS(ref_matrix_diag_m(&(hess_lam[6 * (var + 5 * node)]), diag_system),
+          "decomp");
       sr_lam[var + 5 * node] = MAX(MAX(ABS(ref_matrix_eig(diag_system, 0)),
                                        ABS(ref_matrix_eig(diag_system, 1))),
                                    ABS(ref_matrix_eig(diag_system, 2)));
@@ -2789,14 +2966,18 @@ REF_FCN REF_STATUS ref_metric_belme_gu(
   }
   RSS(ref_recon_gradient(ref_grid, lam, grad_lam, reconstruction), "grad_u");
 
-  for (dir = 0; dir < 3; dir++) {
-    var = 1 + dir;
-    each_ref_node_valid_node(ref_node, node) {
-      u[node] = prim_dual[var + 0 * nequ + ldim * node];
+  each_ref_node_valid_node(ref_node, node) {
+    for (dir = 0; dir < 3; dir++) {
+      var = 1 + dir;
+      u[dir + 3 * node] = prim_dual[var + 0 * nequ + ldim * node];
     }
-    RSS(ref_recon_gradient(ref_grid, u, grad_u, reconstruction), "grad_u");
+  }
+  RSS(ref_recon_gradient_many(ref_grid, 3, u, grad_u, reconstruction),
+      "grad_u");
+  for (dir = 0; dir < 3; dir++) {
     each_ref_node_valid_node(ref_node, node) {
-      ref_math_cross_product(&(grad_u[3 * node]), &(grad_lam[3 * node]),
+      ref_math_cross_product(&(grad_u[3 * (dir + 3 * node)]),
+                             &(grad_lam[3 * node]),
                              &(omega[3 * dir + 9 * node]));
     }
   }
@@ -2929,6 +3110,8 @@ REF_FCN REF_STATUS ref_metric_belme_gu(
     }
   }
 
+  RSS(ref_recon_uncache(ref_grid, cached), "uncache");
+
   ref_free(omega);
   ref_free(grad_u);
   ref_free(hess_u);
@@ -2953,15 +3136,18 @@ REF_FCN REF_STATUS ref_metric_cons_euler_g(
 
   nequ = ldim / 2;
 
-  ref_malloc_init(lam, ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(grad_lam, 3 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(lam, 5 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(grad_lam, 15 * ref_node_max(ref_node), REF_DBL, 0.0);
 
-  for (var = 0; var < 5; var++) {
-    each_ref_node_valid_node(ref_node, node) {
-      lam[node] = prim_dual[var + 1 * nequ + ldim * node];
+  each_ref_node_valid_node(ref_node, node) {
+    for (var = 0; var < 5; var++) {
+      lam[var + 5 * node] = prim_dual[var + 1 * nequ + ldim * node];
     }
-    RSS(ref_recon_gradient(ref_grid, lam, grad_lam, reconstruction),
-        "grad_lam");
+  }
+  RSS(ref_recon_gradient_many(ref_grid, 5, lam, grad_lam, reconstruction),
+      "grad_lam");
+
+  for (var = 0; var < 5; var++) {
     for (dir = 0; dir < 3; dir++) {
       each_ref_node_valid_node(ref_node, node) {
         direction[0] = 0.0;
@@ -2973,17 +3159,17 @@ REF_FCN REF_STATUS ref_metric_cons_euler_g(
         }
         RSS(ref_phys_euler_jac(state, direction, dflux_dcons), "euler");
         for (i = 0; i < 5; i++) {
-          g[i + 5 * node] +=
-              dflux_dcons[var + i * 5] * grad_lam[dir + 3 * node];
+          g[i + 5 * node] += dflux_dcons[var + i * 5] *
+                             grad_lam[dir + 3 * (var + 5 * node)];
         }
       }
     }
+  }
 
-    if (debug_export) {
-      char filename[32];
-      snprintf(filename, 32, "gradlam%d.tec", var);
-      ref_gather_scalar_by_extension(ref_grid, 3, grad_lam, NULL, filename);
-    }
+  if (debug_export) {
+    RSS(ref_gather_scalar_by_extension(ref_grid, 15, grad_lam, NULL,
+                                       "gradlam.tec"),
+        "dump grad lam");
   }
   ref_free(grad_lam);
   ref_free(lam);
@@ -3001,9 +3187,9 @@ REF_FCN REF_STATUS ref_metric_cons_viscous_g(
     REF_DBL mach, REF_DBL re, REF_DBL reference_temp,
     REF_RECON_RECONSTRUCTION reconstruction) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_INT var, node;
+  REF_INT var, node, i;
   REF_INT nequ;
-  REF_DBL *lam, *rhou1star, *rhou2star, *rhou3star, *rhoestar;
+  REF_DBL *lam, *hess_lam, *rhou1star, *rhou2star, *rhou3star, *rhoestar;
   REF_DBL gamma = 1.4;
   REF_DBL t, mu, u1, u2, u3, q2, e;
   REF_DBL pr = 0.72;
@@ -3019,28 +3205,25 @@ REF_FCN REF_STATUS ref_metric_cons_viscous_g(
   ref_malloc_init(rhou2star, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(rhou3star, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
   ref_malloc_init(rhoestar, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(lam, ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(lam, 4 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(hess_lam, 24 * ref_node_max(ref_node), REF_DBL, 0.0);
 
-  var = 1;
-  each_ref_node_valid_node(ref_node, node) {
-    lam[node] = prim_dual[var + 1 * nequ + ldim * node];
-  }
-  RSS(ref_recon_signed_hessian(ref_grid, lam, rhou1star, reconstruction), "h1");
-  var = 2;
-  each_ref_node_valid_node(ref_node, node) {
-    lam[node] = prim_dual[var + 1 * nequ + ldim * node];
-  }
-  RSS(ref_recon_signed_hessian(ref_grid, lam, rhou2star, reconstruction), "h2");
-  var = 3;
   each_ref_node_valid_node(ref_node, node) {
-    lam[node] = prim_dual[var + 1 * nequ + ldim * node];
+    for (var = 1; var < 5; var++) {
+      lam[(var - 1) + 4 * node] = prim_dual[var + 1 * nequ + ldim * node];
+    }
   }
-  RSS(ref_recon_signed_hessian(ref_grid, lam, rhou3star, reconstruction), "h3");
-  var = 4;
+  RSS(ref_recon_signed_hessian_many(ref_grid, 4, lam, hess_lam, reconstruction),
+      "h1-4");
   each_ref_node_valid_node(ref_node, node) {
-    lam[node] = prim_dual[var + 1 * nequ + ldim * node];
+    for (i = 0; i < 6; i++) {
+      rhou1star[i + 6 * node] = hess_lam[i + 6 * (0 + 4 * node)];
+      rhou2star[i + 6 * node] = hess_lam[i + 6 * (1 + 4 * node)];
+      rhou3star[i + 6 * node] = hess_lam[i + 6 * (2 + 4 * node)];
+      rhoestar[i + 6 * node] = hess_lam[i + 6 * (3 + 4 * node)];
+    }
   }
-  RSS(ref_recon_signed_hessian(ref_grid, lam, rhoestar, reconstruction), "h4");
+  ref_free(hess_lam);
   ref_free(lam);
 
   each_ref_node_valid_node(ref_node, node) {
@@ -3118,24 +3301,28 @@ REF_FCN REF_STATUS ref_metric_cons_assembly(
   REF_DBL state[5], conserved[5];
   REF_DBL *cons, *hess_cons;
 
-  ref_malloc_init(cons, ref_node_max(ref_node), REF_DBL, 0.0);
-  ref_malloc_init(hess_cons, 6 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(cons, 5 * ref_node_max(ref_node), REF_DBL, 0.0);
+  ref_malloc_init(hess_cons, 30 * ref_node_max(ref_node), REF_DBL, 0.0);
 
-  for (var = 0; var < 5; var++) {
-    each_ref_node_valid_node(ref_node, node) {
-      for (i = 0; i < 5; i++) {
-        state[i] = prim_dual[i + ldim * node];
-      }
-      RSS(ref_phys_make_conserved(state, conserved), "prim2cons");
-      cons[node] = conserved[var];
+  each_ref_node_valid_node(ref_node, node) {
+    for (i = 0; i < 5; i++) {
+      state[i] = prim_dual[i + ldim * node];
+    }
+    RSS(ref_phys_make_conserved(state, conserved), "prim2cons");
+    for (var = 0; var < 5; var++) {
+      cons[var + 5 * node] = conserved[var];
     }
-    RSS(ref_recon_hessian(ref_grid, cons, hess_cons, reconstruction), "hess");
+  }
+  RSS(ref_recon_hessian_many(ref_grid, 5, cons, hess_cons, reconstruction),
+      "hess");
+
+  for (var = 0; var < 5; var++) {
     each_ref_node_valid_node(ref_node, node) {
       for (i = 0; i < 6; i++) {
         metric[i + 6 * node] +=
-            ABS(g[var + 5 * node]) * hess_cons[i + 6 * node];
+            ABS(g[var + 5 * node]) * hess_cons[i + 6 * (var + 5 * node)];
         RAS(isfinite(ABS(g[var + 5 * node])), "g not finite");
-        RAS(isfinite(hess_cons[i + 6 * node]), "hess not finite");
+        RAS(isfinite(hess_cons[i + 6 * (var + 5 * node)]), "hess not finite");
         RAS(isfinite(metric[i + 6 * node]), "metric not finite");
       }
     }
@@ -58,6 +58,10 @@ REF_FCN REF_STATUS ref_metric_interpolate_between(REF_GRID ref_grid,
 REF_FCN REF_STATUS ref_metric_metric_space_gradation(REF_DBL *metric,
                                                      REF_GRID ref_grid,
                                                      REF_DBL beta);
+/* one pass front propagation to the metric_space_gradation fixed point */
+REF_FCN REF_STATUS ref_metric_metric_space_front_gradation(REF_DBL *metric,
+                                                           REF_GRID ref_grid,
+                                                           REF_DBL beta);
 REF_FCN REF_STATUS ref_metric_mixed_space_gradation(REF_DBL *metric,
                                                     REF_GRID ref_grid,
                                                     REF_DBL beta, REF_DBL t);
@@ -2759,6 +2759,90 @@ int main(int argc, char *argv[]) {
     RSS(ref_grid_free(ref_grid), "free");
   }
 
+  if (!ref_mpi_para(ref_mpi)) { /* front gradation */
+    REF_GRID ref_grid;
+    REF_DBL *metric;
+    REF_INT node;
+    REF_DBL tol = -1.0;
+
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "brick");
+
+    ref_malloc(metric, 6 * ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+
+    each_ref_node_valid_node(ref_grid_node(ref_grid), node) {
+      metric[0 + 6 * node] = 1.0;
+      metric[1 + 6 * node] = 0.0;
+      metric[2 + 6 * node] = 0.0;
+      metric[3 + 6 * node] = 1.0;
+      metric[4 + 6 * node] = 0.0;
+      metric[5 + 6 * node] = 1.0;
+    }
+    node = 0;
+    metric[5 + 6 * node] = 4.0;
+
+    RSS(ref_metric_metric_space_front_gradation(metric, ref_grid, 1.1),
+        "grad");
+
+    node = 0;
+    RWDS(1.0, metric[0 + 6 * node], tol, "m[0]");
+    RWDS(1.0, metric[3 + 6 * node], tol, "m[3]");
+    RWDS(4.0, metric[5 + 6 * node], tol, "m[5]");
+
+    node = 3;
+    RWDS(1.0, metric[0 + 6 * node], tol, "m[0]");
+    RWDS(1.0, metric[3 + 6 * node], tol, "m[3]");
+    RWDS(2.821716527185583, metric[5 + 6 * node], tol, "m[5]");
+
+    ref_free(metric);
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  { /* front gradation matches converged edge sweeps */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_DBL *metric, *swept;
+    REF_DBL h;
+    REF_INT node, i, sweep;
+
+    RSS(ref_fixture_tet_brick_args_grid(&ref_grid, ref_mpi, 0, 1, 0, 1, 0, 1,
+                                        10, 10, 10),
+        "brick");
+    ref_node = ref_grid_node(ref_grid);
+
+    ref_malloc(metric, 6 * ref_node_max(ref_node), REF_DBL);
+    ref_malloc(swept, 6 * ref_node_max(ref_node), REF_DBL);
+    each_ref_node_valid_node(ref_node, node) {
+      h = 0.3;
+      if (ref_node_xyz(ref_node, 0, node) < 0.01 &&
+          ref_node_xyz(ref_node, 1, node) < 0.01)
+        h = 0.0001;
+      metric[0 + 6 * node] = 1.0 / (h * h);
+      metric[1 + 6 * node] = 0.0;
+      metric[2 + 6 * node] = 0.0;
+      metric[3 + 6 * node] = 1.0 / (h * h);
+      metric[4 + 6 * node] = 0.0;
+      metric[5 + 6 * node] = 1.0 / (0.3 * 0.3);
+      for (i = 0; i < 6; i++) swept[i + 6 * node] = metric[i + 6 * node];
+    }
+
+    RSS(ref_metric_metric_space_front_gradation(metric, ref_grid, 1.5),
+        "front");
+    for (sweep = 0; sweep < 100; sweep++)
+      RSS(ref_metric_metric_space_gradation(swept, ref_grid, 1.5), "sweep");
+
+    each_ref_node_valid_node(ref_node, node) {
+      for (i = 0; i < 6; i++)
+        RWDS(swept[i + 6 * node], metric[i + 6 * node],
+             1.0e-6 * MAX(1.0, ABS(swept[i + 6 * node])), "front");
+    }
+
+    ref_free(swept);
+    ref_free(metric);
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   if (!ref_mpi_para(ref_mpi)) { /* aspect ratio, 32 tri */
     REF_GRID ref_grid;
     REF_DBL *metric;
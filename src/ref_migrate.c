@@ -46,6 +46,7 @@
 #endif
 #endif
 
+#include "ref_edge.h"
 #include "ref_export.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
@@ -79,7 +80,8 @@ REF_FCN REF_STATUS ref_migrate_create(REF_MIGRATE *ref_migrate_ptr,
   ref_malloc_init(ref_migrate->global, ref_migrate_max(ref_migrate), REF_GLOB,
                   REF_EMPTY);
   ref_malloc(ref_migrate->xyz, 3 * ref_migrate_max(ref_migrate), REF_DBL);
-  ref_malloc(ref_migrate->weight, ref_migrate_max(ref_migrate), REF_DBL);
+  ref_malloc_init(ref_migrate->weight, ref_migrate_max(ref_migrate), REF_DBL,
+                  1.0);
   ref_malloc(ref_migrate->age, ref_migrate_max(ref_migrate), REF_INT);
 
   each_ref_node_valid_node(ref_node, node) {
@@ -93,7 +95,6 @@ REF_FCN REF_STATUS ref_migrate_create(REF_MIGRATE *ref_migrate_ptr,
       ref_migrate_xyz(ref_migrate, 0, node) = ref_node_xyz(ref_node, 0, node);
       ref_migrate_xyz(ref_migrate, 1, node) = ref_node_xyz(ref_node, 1, node);
       ref_migrate_xyz(ref_migrate, 2, node) = ref_node_xyz(ref_node, 2, node);
-      ref_migrate_weight(ref_migrate, node) = 1.0;
       ref_migrate_age(ref_migrate, node) = ref_node_age(ref_node, node);
     }
   }
@@ -213,7 +214,8 @@ REF_FCN REF_STATUS ref_migrate_2d_agglomeration_keep(REF_MIGRATE ref_migrate,
   if (!ref_migrate_valid(ref_migrate, keep)) return REF_SUCCESS;
 
   ref_migrate_xyz(ref_migrate, 1, keep) = 0.5;
-  ref_migrate_weight(ref_migrate, keep) = 2.0;
+  ref_migrate_weight(ref_migrate, keep) +=
+      ref_migrate_weight(ref_migrate, lose);
   /* collect age in general case */
   RSS(ref_adj_add(ref_migrate_parent_local(ref_migrate), keep, lose), "add");
   RSS(ref_adj_add(ref_migrate_parent_part(ref_migrate), keep,
@@ -265,13 +267,30 @@ REF_FCN REF_STATUS ref_migrate_2d_agglomeration(REF_MIGRATE ref_migrate) {
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_migrate_report_load_balance(REF_GRID ref_grid,
-                                                          REF_INT npart,
-                                                          REF_INT *node_part) {
+/* node_weight is ghosted and may be NULL for unit weights */
+REF_FCN static REF_STATUS ref_migrate_set_weight(REF_MIGRATE ref_migrate,
+                                                 REF_DBL *node_weight) {
+  REF_NODE ref_node = ref_grid_node(ref_migrate_grid(ref_migrate));
+  REF_INT node;
+
+  if (NULL == node_weight) return REF_SUCCESS;
+
+  each_ref_node_valid_node(ref_node, node) {
+    ref_migrate_weight(ref_migrate, node) = node_weight[node];
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_migrate_report_load_balance(
+    REF_GRID ref_grid, REF_INT npart, REF_INT *node_part,
+    REF_DBL *node_weight) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_INT min_part, max_part, node, proc, *partition_size;
+  REF_DBL *partition_work, total_work, max_work;
   ref_malloc_init(partition_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(partition_work, ref_mpi_n(ref_mpi), REF_DBL, 0.0);
 
   each_ref_node_valid_node(ref_node, node) {
     if (ref_node_owned(ref_node, node)) {
@@ -281,6 +300,8 @@ REF_FCN static REF_STATUS ref_migrate_report_load_balance(REF_GRID ref_grid,
                    node, node_part[node], ref_mpi_n(ref_mpi));
           });
       partition_size[node_part[node]] += 1;
+      if (NULL != node_weight)
+        partition_work[node_part[node]] += node_weight[node];
     }
   }
   RSS(ref_mpi_allsum(ref_mpi, partition_size, ref_mpi_n(ref_mpi), REF_INT_TYPE),
@@ -301,10 +322,116 @@ REF_FCN static REF_STATUS ref_migrate_report_load_balance(REF_GRID ref_grid,
            (REF_INT)(ref_node_n_global(ref_node) / (REF_GLOB)npart), min_part,
            max_part);
   }
+
+  if (NULL != node_weight) {
+    RSS(ref_mpi_allsum(ref_mpi, partition_work, ref_mpi_n(ref_mpi),
+                       REF_DBL_TYPE),
+        "allsum");
+    total_work = 0.0;
+    max_work = 0.0;
+    for (proc = 0; proc < npart; proc++) {
+      total_work += partition_work[proc];
+      max_work = MAX(max_work, partition_work[proc]);
+    }
+    if (ref_mpi_once(ref_mpi) && ref_math_divisible(max_work, total_work)) {
+      printf("work balance %6.3f on %d of %d total work %.0f max %.0f\n",
+             max_work / total_work * (REF_DBL)npart, npart, ref_mpi_n(ref_mpi),
+             total_work, max_work);
+    }
+  }
+
+  ref_free(partition_work);
   ref_free(partition_size);
   return REF_SUCCESS;
 }
 
+REF_FCN static REF_STATUS ref_migrate_report_edge_cut(REF_GRID ref_grid,
+                                                     REF_INT *node_part) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_EDGE ref_edge;
+  REF_INT *part, node, edge, owner;
+  REF_LONG counts[2];
+
+  /* diagnostic builds all edges, only with timing requested */
+  if (0 == ref_mpi_timing(ref_mpi)) return REF_SUCCESS;
+
+  ref_malloc_init(part, ref_node_max(ref_node), REF_INT, REF_EMPTY);
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) part[node] = node_part[node];
+  }
+  RSS(ref_node_ghost_int(ref_node, part, 1), "ghost part");
+
+  RSS(ref_edge_create(&ref_edge, ref_grid), "edges");
+  counts[0] = 0;
+  counts[1] = 0;
+  each_ref_edge(ref_edge, edge) {
+    RSS(ref_edge_part(ref_edge, edge, &owner), "edge owner");
+    if (ref_mpi_rank(ref_mpi) != owner) continue;
+    counts[0]++;
+    if (part[ref_edge_e2n(ref_edge, 0, edge)] !=
+        part[ref_edge_e2n(ref_edge, 1, edge)])
+      counts[1]++;
+  }
+  RSS(ref_edge_free(ref_edge), "free edges");
+  ref_free(part);
+
+  RSS(ref_mpi_allsum(ref_mpi, counts, 2, REF_LONG_TYPE), "allsum");
+  if (ref_mpi_once(ref_mpi)) {
+    printf("edge cut %ld of %ld edges %6.3f%%\n", counts[1], counts[0],
+           100.0 * (REF_DBL)counts[1] / (REF_DBL)MAX(1, counts[0]));
+  }
+
+  return REF_SUCCESS;
+}
+
+/* node_part is ghosted, payload of owner changes in ref_migrate_shufflin */
+REF_FCN static REF_STATUS ref_migrate_report_moved(REF_GRID ref_grid,
+                                                   REF_INT *node_part) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT node, group, cell, cell_node, part;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_LONG moved[3];
+
+  moved[0] = 0; /* nodes */
+  moved[1] = 0; /* cells */
+  moved[2] = 0; /* bytes */
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node) &&
+        node_part[node] != ref_node_part(ref_node, node)) {
+      moved[0]++;
+      moved[2] += (REF_LONG)sizeof(REF_GLOB) +
+                  (REF_LONG)(REF_NODE_REAL_PER + ref_node_naux(ref_node)) *
+                      (REF_LONG)sizeof(REF_DBL);
+    }
+  }
+  each_ref_grid_all_ref_cell(ref_grid, group, ref_cell) {
+    each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+      RSS(ref_cell_part(ref_cell, ref_node, cell, &part), "owner");
+      if (ref_mpi_rank(ref_mpi) != part) continue;
+      for (cell_node = 0; cell_node < ref_cell_node_per(ref_cell);
+           cell_node++) {
+        if (node_part[nodes[cell_node]] !=
+            ref_node_part(ref_node, nodes[cell_node])) {
+          moved[1]++;
+          moved[2] += (REF_LONG)ref_cell_size_per(ref_cell) *
+                      (REF_LONG)(sizeof(REF_GLOB) + sizeof(REF_INT));
+          break;
+        }
+      }
+    }
+  }
+  RSS(ref_mpi_allsum(ref_mpi, moved, 3, REF_LONG_TYPE), "allsum");
+
+  if (ref_mpi_once(ref_mpi))
+    printf("moved %ld nodes %ld cells %.3f MB\n", moved[0], moved[1],
+           (REF_DBL)moved[2] / 1048576.0);
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_migrate_single_part(REF_GRID ref_grid,
                                                   REF_INT *node_part) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
@@ -388,19 +515,22 @@ REF_FCN REF_STATUS ref_migrate_split_ratio(REF_INT number_of_partitions,
 }
 
 REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
-    REF_MPI ref_mpi, REF_INT n, REF_DBL *xyz, REF_DBL *transform, REF_INT npart,
-    REF_INT offset, REF_INT *owners, REF_INT *locals, REF_MPI global_mpi,
-    REF_INT *part, REF_INT seed, REF_INT dir, REF_BOOL twod) {
+    REF_MPI ref_mpi, REF_INT n, REF_DBL *xyz, REF_DBL *weight,
+    REF_DBL *transform, REF_INT npart, REF_INT offset, REF_INT *owners,
+    REF_INT *locals, REF_MPI global_mpi, REF_INT *part, REF_INT seed,
+    REF_INT dir, REF_BOOL twod) {
   REF_INT i, j, n0, n1, npart0, npart1, offset0, offset1;
   REF_INT bal_n0, bal_n1;
   REF_DBL *xyz0, *xyz1, *x;
   REF_DBL *bal_xyz0, *bal_xyz1;
+  REF_DBL *weight0, *weight1;
+  REF_DBL *bal_weight0, *bal_weight1;
   REF_INT *owners0, *owners1;
   REF_INT *bal_owners0, *bal_owners1;
   REF_INT *locals0, *locals1;
   REF_INT *bal_locals0, *bal_locals1;
   REF_DBL ratio, value0, value1;
-  REF_LONG position, total;
+  REF_DBL total;
   REF_MPI split_mpi;
   REF_INT seed_base = 3;
   REF_DBL ratio_shift, ratio0, ratio1;
@@ -439,16 +569,21 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
     x[i] = transformed[dir];
   }
 
-  total = (REF_LONG)n;
-  RSS(ref_mpi_allsum(ref_mpi, &total, 1, REF_LONG_TYPE), "high_pos");
+  total = 0.0;
+  for (i = 0; i < n; i++) total += weight[i];
+  RSS(ref_mpi_allsum(ref_mpi, &total, 1, REF_DBL_TYPE), "total weight");
 
-  position = (REF_LONG)((REF_DBL)total * ratio0);
-  RSS(ref_search_selection(ref_mpi, n, x, position, &value0), "target");
-  position = (REF_LONG)((REF_DBL)total * ratio1);
-  RSS(ref_search_selection(ref_mpi, n, x, position, &value1), "target");
+  RSS(ref_search_weighted_selection(ref_mpi, n, x, weight, total * ratio0,
+                                    &value0),
+      "target");
+  RSS(ref_search_weighted_selection(ref_mpi, n, x, weight, total * ratio1,
+                                    &value1),
+      "target");
 
   ref_malloc(xyz0, 3 * n, REF_DBL);
   ref_malloc(xyz1, 3 * n, REF_DBL);
+  ref_malloc(weight0, n, REF_DBL);
+  ref_malloc(weight1, n, REF_DBL);
   ref_malloc(owners0, n, REF_INT);
   ref_malloc(owners1, n, REF_INT);
   ref_malloc(locals0, n, REF_INT);
@@ -459,11 +594,13 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
   for (i = 0; i < n; i++) {
     if (x[i] < value0 || value1 < x[i]) {
       for (j = 0; j < 3; j++) xyz0[j + 3 * n0] = xyz[j + 3 * i];
+      weight0[n0] = weight[i];
       owners0[n0] = owners[i];
       locals0[n0] = locals[i];
       n0++;
     } else {
       for (j = 0; j < 3; j++) xyz1[j + 3 * n1] = xyz[j + 3 * i];
+      weight1[n1] = weight[i];
       owners1[n1] = owners[i];
       locals1[n1] = locals[i];
       n1++;
@@ -483,6 +620,14 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
                       REF_DBL_TYPE),
       "split 1");
 
+  RSS(ref_mpi_balance(ref_mpi, 1, n0, (void *)weight0, 0, npart0 - 1, &bal_n0,
+                      (void **)(&bal_weight0), REF_DBL_TYPE),
+      "split weight 0");
+  RSS(ref_mpi_balance(ref_mpi, 1, n1, (void *)weight1, npart0,
+                      ref_mpi_n(ref_mpi) - 1, &bal_n1, (void **)(&bal_weight1),
+                      REF_DBL_TYPE),
+      "split weight 1");
+
   RSS(ref_mpi_balance(ref_mpi, 1, n0, (void *)owners0, 0, npart0 - 1, &bal_n0,
                       (void **)(&bal_owners0), REF_INT_TYPE),
       "split owner 0");
@@ -510,13 +655,15 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
   }
   if (ref_mpi_rank(ref_mpi) < npart0) {
     RSS(ref_migrate_native_rcb_direction(
-            split_mpi, bal_n0, bal_xyz0, transform, npart0, offset0,
-            bal_owners0, bal_locals0, global_mpi, part, seed, dir, twod),
+            split_mpi, bal_n0, bal_xyz0, bal_weight0, transform, npart0,
+            offset0, bal_owners0, bal_locals0, global_mpi, part, seed, dir,
+            twod),
         "recurse 0");
   } else {
     RSS(ref_migrate_native_rcb_direction(
-            split_mpi, bal_n1, bal_xyz1, transform, npart1, offset1,
-            bal_owners1, bal_locals1, global_mpi, part, seed, dir, twod),
+            split_mpi, bal_n1, bal_xyz1, bal_weight1, transform, npart1,
+            offset1, bal_owners1, bal_locals1, global_mpi, part, seed, dir,
+            twod),
         "recurse 1");
   }
 
@@ -529,6 +676,9 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
   ref_free(bal_owners1);
   ref_free(bal_owners0);
 
+  ref_free(bal_weight1);
+  ref_free(bal_weight0);
+
   ref_free(bal_xyz1);
   ref_free(bal_xyz0);
 
@@ -538,6 +688,9 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
   ref_free(owners1);
   ref_free(owners0);
 
+  ref_free(weight1);
+  ref_free(weight0);
+
   ref_free(xyz1);
   ref_free(xyz0);
 
@@ -547,12 +700,13 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_direction(
 
 REF_FCN static REF_STATUS ref_migrate_native_rcb_part(REF_GRID ref_grid,
                                                       REF_INT npart,
-                                                      REF_INT *node_part) {
+                                                      REF_INT *node_part,
+                                                      REF_DBL *node_weight) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_INT node;
   REF_INT i, n;
-  REF_DBL *xyz;
+  REF_DBL *xyz, *weight;
   REF_INT offset;
   REF_INT *owners;
   REF_INT *locals;
@@ -565,12 +719,14 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_part(REF_GRID ref_grid,
 
   n = ref_node_n(ref_node);
   ref_malloc(xyz, 3 * n, REF_DBL);
+  ref_malloc_init(weight, n, REF_DBL, 1.0);
   ref_malloc(owners, n, REF_INT);
   ref_malloc(locals, n, REF_INT);
   n = 0;
   each_ref_node_valid_node(ref_node, node) {
     if (ref_node_owned(ref_node, node)) {
       for (i = 0; i < 3; i++) xyz[i + 3 * n] = ref_node_xyz(ref_node, i, node);
+      if (NULL != node_weight) weight[n] = node_weight[node];
       owners[n] = ref_node_part(ref_node, node);
       locals[n] = node;
       n++;
@@ -596,8 +752,8 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_part(REF_GRID ref_grid,
   RSS(ref_mpi_bcast(ref_mpi, transform, 9, REF_DBL_TYPE), "bcast xform");
 
   RSS(ref_migrate_native_rcb_direction(
-          ref_mpi, n, xyz, transform, npart, offset, owners, locals, ref_mpi,
-          node_part, ref_grid_partitioner_seed(ref_grid), -1,
+          ref_mpi, n, xyz, weight, transform, npart, offset, owners, locals,
+          ref_mpi, node_part, ref_grid_partitioner_seed(ref_grid), -1,
           ref_grid_twod(ref_grid)),
       "split");
   ref_grid_partitioner_seed(ref_grid)++;
@@ -606,6 +762,7 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_part(REF_GRID ref_grid,
 
   ref_free(locals);
   ref_free(owners);
+  ref_free(weight);
   ref_free(xyz);
 
   ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "native RCB part");
@@ -613,6 +770,903 @@ REF_FCN static REF_STATUS ref_migrate_native_rcb_part(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
+#define REF_MIGRATE_GRAPH_COARSEST (64)
+#define REF_MIGRATE_GRAPH_SEEDS (4)
+#define REF_MIGRATE_GRAPH_FM_PASSES (8)
+#define REF_MIGRATE_GRAPH_KWAY_PASSES (8)
+#define REF_MIGRATE_GRAPH_TOLERANCE (0.01)
+#define REF_MIGRATE_GRAPH_IMBALANCE (1.03)
+#define REF_MIGRATE_GRAPH_GATHER (20000)
+#define REF_MIGRATE_GRAPH_GATHER_PER_PART (100)
+
+REF_FCN REF_STATUS ref_migrate_graph_coarsen(
+    REF_INT n, REF_INT *xadj, REF_INT *adjncy, REF_INT *adjwgt, REF_INT *vwgt,
+    REF_INT max_vwgt, REF_INT *cmap, REF_INT *nc_ptr, REF_INT **cxadj_ptr,
+    REF_INT **cadjncy_ptr, REF_INT **cadjwgt_ptr, REF_INT **cvwgt_ptr) {
+  REF_INT *order, *match, *mark, *members;
+  REF_INT *cxadj, *cadjncy, *cadjwgt, *cvwgt;
+  REF_INT i, j, v, u, best, best_wgt, nc, c, cu, degree, member;
+
+  ref_malloc(order, n, REF_INT);
+  ref_malloc_init(match, n, REF_INT, REF_EMPTY);
+  RSS(ref_sort_shuffle(n, order), "shuffle visit order");
+
+  /* heavy edge matching, pair weight limited to keep coarse levels even */
+  for (i = 0; i < n; i++) {
+    v = order[i];
+    if (REF_EMPTY != match[v]) continue;
+    best = v;
+    best_wgt = REF_INT_MIN;
+    for (j = xadj[v]; j < xadj[v + 1]; j++) {
+      u = adjncy[j];
+      if (REF_EMPTY != match[u] || u == v) continue;
+      if (vwgt[v] + vwgt[u] > max_vwgt) continue;
+      if (adjwgt[j] > best_wgt) {
+        best = u;
+        best_wgt = adjwgt[j];
+      }
+    }
+    match[v] = best;
+    match[best] = v;
+  }
+  ref_free(order);
+
+  ref_malloc(members, 2 * n, REF_INT);
+  for (v = 0; v < n; v++) cmap[v] = REF_EMPTY;
+  nc = 0;
+  for (v = 0; v < n; v++) {
+    if (REF_EMPTY != cmap[v]) continue;
+    cmap[v] = nc;
+    cmap[match[v]] = nc;
+    members[0 + 2 * nc] = v;
+    members[1 + 2 * nc] = match[v];
+    nc++;
+  }
+  ref_free(match);
+
+  ref_malloc(cxadj, nc + 1, REF_INT);
+  ref_malloc(cvwgt, nc, REF_INT);
+  ref_malloc(cadjncy, MAX(1, xadj[n]), REF_INT);
+  ref_malloc(cadjwgt, MAX(1, xadj[n]), REF_INT);
+  ref_malloc_init(mark, nc, REF_INT, REF_EMPTY);
+
+  cxadj[0] = 0;
+  for (c = 0; c < nc; c++) {
+    degree = 0;
+    cvwgt[c] = 0;
+    for (member = 0; member < 2; member++) {
+      v = members[member + 2 * c];
+      if (1 == member && v == members[0 + 2 * c]) continue;
+      cvwgt[c] += vwgt[v];
+      for (j = xadj[v]; j < xadj[v + 1]; j++) {
+        cu = cmap[adjncy[j]];
+        if (cu == c) continue;
+        if (REF_EMPTY == mark[cu]) {
+          mark[cu] = cxadj[c] + degree;
+          cadjncy[mark[cu]] = cu;
+          cadjwgt[mark[cu]] = adjwgt[j];
+          degree++;
+        } else {
+          cadjwgt[mark[cu]] += adjwgt[j];
+        }
+      }
+    }
+    cxadj[c + 1] = cxadj[c] + degree;
+    for (j = cxadj[c]; j < cxadj[c + 1]; j++) mark[cadjncy[j]] = REF_EMPTY;
+  }
+
+  ref_free(mark);
+  ref_free(members);
+
+  *nc_ptr = nc;
+  *cxadj_ptr = cxadj;
+  *cadjncy_ptr = cadjncy;
+  *cadjwgt_ptr = cadjwgt;
+  *cvwgt_ptr = cvwgt;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_migrate_graph_edge_cut(REF_INT n, REF_INT *xadj,
+                                              REF_INT *adjncy, REF_INT *adjwgt,
+                                              REF_INT *part, REF_LONG *cut) {
+  REF_INT v, j;
+  *cut = 0;
+  for (v = 0; v < n; v++) {
+    for (j = xadj[v]; j < xadj[v + 1]; j++) {
+      if (part[v] != part[adjncy[j]]) (*cut) += (REF_LONG)adjwgt[j];
+    }
+  }
+  /* each cut edge seen from both sides */
+  (*cut) /= 2;
+  return REF_SUCCESS;
+}
+
+/* indexed max heap of vertices keyed by gain, pos is shared by both sides */
+static void ref_migrate_graph_heap_swap(REF_INT *heap, REF_INT *pos, REF_INT i,
+                                        REF_INT j) {
+  REF_INT temp = heap[i];
+  heap[i] = heap[j];
+  heap[j] = temp;
+  pos[heap[i]] = i;
+  pos[heap[j]] = j;
+}
+static void ref_migrate_graph_heap_fix(REF_INT n, REF_INT *heap, REF_INT *pos,
+                                       REF_INT *gain, REF_INT i) {
+  REF_INT left, right, biggest;
+  while (i > 0 && gain[heap[(i - 1) / 2]] < gain[heap[i]]) {
+    ref_migrate_graph_heap_swap(heap, pos, i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+  while (REF_TRUE) {
+    left = 2 * i + 1;
+    right = 2 * i + 2;
+    biggest = i;
+    if (left < n && gain[heap[left]] > gain[heap[biggest]]) biggest = left;
+    if (right < n && gain[heap[right]] > gain[heap[biggest]]) biggest = right;
+    if (biggest == i) break;
+    ref_migrate_graph_heap_swap(heap, pos, i, biggest);
+    i = biggest;
+  }
+}
+static void ref_migrate_graph_heap_push(REF_INT *n, REF_INT *heap, REF_INT *pos,
+                                        REF_INT *gain, REF_INT v) {
+  heap[*n] = v;
+  pos[v] = *n;
+  (*n)++;
+  ref_migrate_graph_heap_fix(*n, heap, pos, gain, (*n) - 1);
+}
+static void ref_migrate_graph_heap_remove(REF_INT *n, REF_INT *heap,
+                                          REF_INT *pos, REF_INT *gain,
+                                          REF_INT v) {
+  REF_INT i = pos[v];
+  (*n)--;
+  if (i != *n) {
+    heap[i] = heap[*n];
+    pos[heap[i]] = i;
+    ref_migrate_graph_heap_fix(*n, heap, pos, gain, i);
+  }
+  pos[v] = REF_EMPTY;
+}
+
+static REF_LONG ref_migrate_graph_excess(REF_LONG *w, REF_LONG *maxw) {
+  return MAX(0, w[0] - maxw[0]) + MAX(0, w[1] - maxw[1]);
+}
+
+/* Fiduccia-Mattheyses bisection refinement restricted to boundary vertices,
+ * each pass keeps the best prefix of moves (balance first, then cut) */
+REF_FCN static REF_STATUS ref_migrate_graph_fm(REF_INT n, REF_INT *xadj,
+                                               REF_INT *adjncy,
+                                               REF_INT *adjwgt, REF_INT *vwgt,
+                                               REF_LONG *maxw, REF_INT *side) {
+  REF_INT *gain, *pos, *heap[2], nheap[2], *moved;
+  REF_BOOL *locked, boundary;
+  REF_LONG w[2], cut, best_cut, excess, best_excess;
+  REF_INT pass, nmove, best_nmove, limit, v, u, j, from, s, i;
+
+  if (n < 2) return REF_SUCCESS;
+
+  ref_malloc(gain, n, REF_INT);
+  ref_malloc(pos, n, REF_INT);
+  ref_malloc(heap[0], n, REF_INT);
+  ref_malloc(heap[1], n, REF_INT);
+  ref_malloc(moved, n, REF_INT);
+  ref_malloc(locked, n, REF_BOOL);
+
+  limit = MAX(25, MIN(200, n / 50));
+
+  for (pass = 0; pass < REF_MIGRATE_GRAPH_FM_PASSES; pass++) {
+    w[0] = 0;
+    w[1] = 0;
+    cut = 0;
+    nheap[0] = 0;
+    nheap[1] = 0;
+    for (v = 0; v < n; v++) {
+      w[side[v]] += (REF_LONG)vwgt[v];
+      gain[v] = 0;
+      pos[v] = REF_EMPTY;
+      locked[v] = REF_FALSE;
+    }
+    for (v = 0; v < n; v++) {
+      boundary = REF_FALSE;
+      for (j = xadj[v]; j < xadj[v + 1]; j++) {
+        if (side[v] != side[adjncy[j]]) {
+          gain[v] += adjwgt[j];
+          cut += (REF_LONG)adjwgt[j];
+          boundary = REF_TRUE;
+        } else {
+          gain[v] -= adjwgt[j];
+        }
+      }
+      if (boundary)
+        ref_migrate_graph_heap_push(&(nheap[side[v]]), heap[side[v]], pos,
+                                    gain, v);
+    }
+    cut /= 2;
+    best_cut = cut;
+    best_excess = ref_migrate_graph_excess(w, maxw);
+    nmove = 0;
+    best_nmove = 0;
+    while (nmove - best_nmove < limit) {
+      from = REF_EMPTY;
+      if (w[0] > maxw[0]) {
+        from = 0;
+      } else if (w[1] > maxw[1]) {
+        from = 1;
+      } else {
+        for (s = 0; s < 2; s++) {
+          if (0 == nheap[s]) continue;
+          if (w[1 - s] + (REF_LONG)vwgt[heap[s][0]] > maxw[1 - s]) continue;
+          if (REF_EMPTY == from || gain[heap[s][0]] > gain[heap[from][0]])
+            from = s;
+        }
+      }
+      if (REF_EMPTY == from || 0 == nheap[from]) break;
+
+      v = heap[from][0];
+      ref_migrate_graph_heap_remove(&(nheap[from]), heap[from], pos, gain, v);
+      locked[v] = REF_TRUE;
+      cut -= (REF_LONG)gain[v];
+      side[v] = 1 - from;
+      w[from] -= (REF_LONG)vwgt[v];
+      w[1 - from] += (REF_LONG)vwgt[v];
+      moved[nmove] = v;
+      nmove++;
+
+      for (j = xadj[v]; j < xadj[v + 1]; j++) {
+        u = adjncy[j];
+        if (locked[u]) continue;
+        if (side[u] == side[v]) {
+          gain[u] -= 2 * adjwgt[j];
+        } else {
+          gain[u] += 2 * adjwgt[j];
+        }
+        if (REF_EMPTY != pos[u]) {
+          ref_migrate_graph_heap_fix(nheap[side[u]], heap[side[u]], pos, gain,
+                                     pos[u]);
+        } else if (side[u] != side[v]) {
+          ref_migrate_graph_heap_push(&(nheap[side[u]]), heap[side[u]], pos,
+                                      gain, u);
+        }
+      }
+
+      excess = ref_migrate_graph_excess(w, maxw);
+      if (excess < best_excess || (excess == best_excess && cut < best_cut)) {
+        best_excess = excess;
+        best_cut = cut;
+        best_nmove = nmove;
+      }
+    }
+    /* roll back moves past the best prefix */
+    for (i = nmove - 1; i >= best_nmove; i--) {
+      v = moved[i];
+      side[v] = 1 - side[v];
+    }
+    if (0 == best_nmove) break;
+  }
+
+  ref_free(locked);
+  ref_free(moved);
+  ref_free(heap[1]);
+  ref_free(heap[0]);
+  ref_free(pos);
+  ref_free(gain);
+
+  return REF_SUCCESS;
+}
+
+/* greedy graph growing from seed into side 0 until target0 is reached */
+REF_FCN static REF_STATUS ref_migrate_graph_grow(REF_INT n, REF_INT *xadj,
+                                                 REF_INT *adjncy, REF_INT *vwgt,
+                                                 REF_INT seed, REF_LONG target0,
+                                                 REF_INT *side) {
+  REF_INT *queue, first, last, v, u, j, next_seed;
+  REF_LONG w0;
+
+  ref_malloc(queue, n, REF_INT);
+  for (v = 0; v < n; v++) side[v] = 1;
+  w0 = 0;
+  first = 0;
+  last = 0;
+  next_seed = 0;
+  queue[last] = seed;
+  last++;
+  side[seed] = REF_EMPTY;
+  while (w0 < target0) {
+    if (first == last) { /* disconnected, restart from unvisited vertex */
+      while (next_seed < n && 1 != side[next_seed]) next_seed++;
+      if (next_seed >= n) break;
+      queue[last] = next_seed;
+      last++;
+      side[next_seed] = REF_EMPTY;
+    }
+    v = queue[first];
+    first++;
+    side[v] = 0;
+    w0 += (REF_LONG)vwgt[v];
+    for (j = xadj[v]; j < xadj[v + 1]; j++) {
+      u = adjncy[j];
+      if (1 != side[u]) continue;
+      side[u] = REF_EMPTY;
+      queue[last] = u;
+      last++;
+    }
+  }
+  for (v = 0; v < n; v++)
+    if (REF_EMPTY == side[v]) side[v] = 1;
+  ref_free(queue);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_migrate_graph_bisect(REF_INT n, REF_INT *xadj,
+                                                   REF_INT *adjncy,
+                                                   REF_INT *adjwgt,
+                                                   REF_INT *vwgt,
+                                                   REF_DBL fraction0,
+                                                   REF_INT *side) {
+  REF_LONG total, target0, slack, maxw[2];
+  REF_INT v, max_vwgt;
+
+  total = 0;
+  max_vwgt = 0;
+  for (v = 0; v < n; v++) {
+    total += (REF_LONG)vwgt[v];
+    max_vwgt = MAX(max_vwgt, vwgt[v]);
+  }
+  target0 = (REF_LONG)(fraction0 * (REF_DBL)total);
+  slack = MAX((REF_LONG)(REF_MIGRATE_GRAPH_TOLERANCE * (REF_DBL)total),
+              (REF_LONG)max_vwgt);
+  maxw[0] = target0 + slack;
+  maxw[1] = (total - target0) + slack;
+
+  if (n > REF_MIGRATE_GRAPH_COARSEST) {
+    REF_INT nc, *cmap, *cxadj, *cadjncy, *cadjwgt, *cvwgt, *cside;
+    REF_INT max_pair;
+    max_pair = (REF_INT)MIN(
+        (REF_LONG)REF_INT_MAX,
+        MAX((REF_LONG)max_vwgt,
+            (3 * total) / (2 * (REF_LONG)REF_MIGRATE_GRAPH_COARSEST)));
+    ref_malloc(cmap, n, REF_INT);
+    RSS(ref_migrate_graph_coarsen(n, xadj, adjncy, adjwgt, vwgt, max_pair, cmap,
+                                  &nc, &cxadj, &cadjncy, &cadjwgt, &cvwgt),
+        "coarsen");
+    if ((REF_DBL)nc < 0.9 * (REF_DBL)n) {
+      ref_malloc(cside, nc, REF_INT);
+      RSS(ref_migrate_graph_bisect(nc, cxadj, cadjncy, cadjwgt, cvwgt,
+                                   fraction0, cside),
+          "coarse bisect");
+      for (v = 0; v < n; v++) side[v] = cside[cmap[v]];
+      ref_free(cside);
+      RSS(ref_migrate_graph_fm(n, xadj, adjncy, adjwgt, vwgt, maxw, side),
+          "fm projected");
+      ref_free(cvwgt);
+      ref_free(cadjwgt);
+      ref_free(cadjncy);
+      ref_free(cxadj);
+      ref_free(cmap);
+      return REF_SUCCESS;
+    }
+    ref_free(cvwgt);
+    ref_free(cadjwgt);
+    ref_free(cadjncy);
+    ref_free(cxadj);
+    ref_free(cmap);
+  }
+
+  { /* initial bisection on the coarsest level, best of several seeds */
+    REF_INT *trial, seed, attempt;
+    REF_LONG cut, best_cut, excess, best_excess, w[2];
+    best_cut = REF_INT_MAX;
+    best_excess = REF_INT_MAX;
+    ref_malloc(trial, n, REF_INT);
+    for (attempt = 0; attempt < MIN(n, REF_MIGRATE_GRAPH_SEEDS); attempt++) {
+      seed = (REF_INT)(((REF_LONG)attempt * (REF_LONG)n) /
+                       (REF_LONG)REF_MIGRATE_GRAPH_SEEDS);
+      RSS(ref_migrate_graph_grow(n, xadj, adjncy, vwgt, seed, target0, trial),
+          "grow");
+      RSS(ref_migrate_graph_fm(n, xadj, adjncy, adjwgt, vwgt, maxw, trial),
+          "fm initial");
+      RSS(ref_migrate_graph_edge_cut(n, xadj, adjncy, adjwgt, trial, &cut),
+          "cut");
+      w[0] = 0;
+      w[1] = 0;
+      for (v = 0; v < n; v++) w[trial[v]] += (REF_LONG)vwgt[v];
+      excess = ref_migrate_graph_excess(w, maxw);
+      if (excess < best_excess || (excess == best_excess && cut < best_cut)) {
+        best_excess = excess;
+        best_cut = cut;
+        for (v = 0; v < n; v++) side[v] = trial[v];
+      }
+    }
+    ref_free(trial);
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_migrate_graph_recursive(
+    REF_INT n, REF_INT *xadj, REF_INT *adjncy, REF_INT *adjwgt, REF_INT *vwgt,
+    REF_INT npart, REF_INT offset, REF_INT *part) {
+  REF_INT *side, *sub;
+  REF_INT *sxadj, *sadjncy, *sadjwgt, *svwgt, *spart;
+  REF_INT npart0, s, ns, v, j, degree;
+
+  if (0 == n) return REF_SUCCESS;
+  if (1 == npart) {
+    for (v = 0; v < n; v++) part[v] = offset;
+    return REF_SUCCESS;
+  }
+
+  npart0 = npart / 2;
+  ref_malloc(side, n, REF_INT);
+  RSS(ref_migrate_graph_bisect(n, xadj, adjncy, adjwgt, vwgt,
+                               (REF_DBL)npart0 / (REF_DBL)npart, side),
+      "bisect");
+
+  ref_malloc(sub, n, REF_INT);
+  for (s = 0; s < 2; s++) {
+    ns = 0;
+    for (v = 0; v < n; v++) {
+      sub[v] = REF_EMPTY;
+      if (s == side[v]) {
+        sub[v] = ns;
+        ns++;
+      }
+    }
+    ref_malloc(sxadj, ns + 1, REF_INT);
+    ref_malloc(sadjncy, MAX(1, xadj[n]), REF_INT);
+    ref_malloc(sadjwgt, MAX(1, xadj[n]), REF_INT);
+    ref_malloc(svwgt, ns, REF_INT);
+    ref_malloc(spart, ns, REF_INT);
+    sxadj[0] = 0;
+    for (v = 0; v < n; v++) {
+      if (REF_EMPTY == sub[v]) continue;
+      degree = 0;
+      for (j = xadj[v]; j < xadj[v + 1]; j++) {
+        if (REF_EMPTY == sub[adjncy[j]]) continue;
+        sadjncy[sxadj[sub[v]] + degree] = sub[adjncy[j]];
+        sadjwgt[sxadj[sub[v]] + degree] = adjwgt[j];
+        degree++;
+      }
+      sxadj[sub[v] + 1] = sxadj[sub[v]] + degree;
+      svwgt[sub[v]] = vwgt[v];
+    }
+    if (0 == s) {
+      RSS(ref_migrate_graph_recursive(ns, sxadj, sadjncy, sadjwgt, svwgt,
+                                      npart0, offset, spart),
+          "recurse 0");
+    } else {
+      RSS(ref_migrate_graph_recursive(ns, sxadj, sadjncy, sadjwgt, svwgt,
+                                      npart - npart0, offset + npart0, spart),
+          "recurse 1");
+    }
+    for (v = 0; v < n; v++)
+      if (REF_EMPTY != sub[v]) part[v] = spart[sub[v]];
+    ref_free(spart);
+    ref_free(svwgt);
+    ref_free(sadjwgt);
+    ref_free(sadjncy);
+    ref_free(sxadj);
+  }
+  ref_free(sub);
+  ref_free(side);
+
+  return REF_SUCCESS;
+}
+
+/* greedy k-way boundary refinement, moves by positive gain, zero gain when it
+ * evens the part weights, or any gain to relieve an overweight part */
+REF_FCN static REF_STATUS ref_migrate_graph_kway_refine(
+    REF_INT n, REF_INT *xadj, REF_INT *adjncy, REF_INT *adjwgt, REF_INT *vwgt,
+    REF_INT npart, REF_INT *part) {
+  REF_LONG *pw, total, maxpw;
+  REF_INT *conn, *touched, ntouched;
+  REF_INT pass, moves, v, j, i, p, q, best, gain;
+
+  ref_malloc_init(pw, npart, REF_LONG, 0);
+  ref_malloc_init(conn, npart, REF_INT, 0);
+  ref_malloc(touched, npart, REF_INT);
+  total = 0;
+  for (v = 0; v < n; v++) {
+    pw[part[v]] += (REF_LONG)vwgt[v];
+    total += (REF_LONG)vwgt[v];
+  }
+  maxpw = (REF_LONG)(REF_MIGRATE_GRAPH_IMBALANCE * (REF_DBL)total /
+                     (REF_DBL)npart) +
+          1;
+
+  for (pass = 0; pass < REF_MIGRATE_GRAPH_KWAY_PASSES; pass++) {
+    moves = 0;
+    for (v = 0; v < n; v++) {
+      p = part[v];
+      ntouched = 0;
+      for (j = xadj[v]; j < xadj[v + 1]; j++) {
+        q = part[adjncy[j]];
+        if (0 == conn[q] && q != p) {
+          touched[ntouched] = q;
+          ntouched++;
+        }
+        conn[q] += adjwgt[j];
+      }
+      best = REF_EMPTY;
+      for (i = 0; i < ntouched; i++) {
+        q = touched[i];
+        if (pw[q] + (REF_LONG)vwgt[v] > maxpw) continue;
+        if (REF_EMPTY == best || conn[q] > conn[best] ||
+            (conn[q] == conn[best] && pw[q] < pw[best]))
+          best = q;
+      }
+      if (REF_EMPTY != best) {
+        gain = conn[best] - conn[p];
+        if (0 < gain || (0 == gain && pw[best] + (REF_LONG)vwgt[v] < pw[p]) ||
+            pw[p] > maxpw) {
+          part[v] = best;
+          pw[p] -= (REF_LONG)vwgt[v];
+          pw[best] += (REF_LONG)vwgt[v];
+          moves++;
+        }
+      }
+      for (i = 0; i < ntouched; i++) conn[touched[i]] = 0;
+      conn[p] = 0;
+    }
+    if (0 == moves) break;
+  }
+
+  ref_free(touched);
+  ref_free(conn);
+  ref_free(pw);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_migrate_graph_partition(REF_INT n, REF_INT *xadj,
+                                               REF_INT *adjncy, REF_INT *adjwgt,
+                                               REF_INT *vwgt, REF_INT npart,
+                                               REF_INT *part) {
+  RAS(0 < npart, "npart must be positive");
+  RSS(ref_migrate_graph_recursive(n, xadj, adjncy, adjwgt, vwgt, npart, 0,
+                                  part),
+      "recursive bisection");
+  RSS(ref_migrate_graph_kway_refine(n, xadj, adjncy, adjwgt, vwgt, npart, part),
+      "k-way refine");
+  return REF_SUCCESS;
+}
+
+/* parallel boundary refinement of the fine graph, alternating the direction
+ * of moves between part ids so neighboring ranks do not swap nodes back */
+REF_FCN static REF_STATUS ref_migrate_native_graph_refine(
+    REF_MIGRATE ref_migrate, REF_INT *vwgt, REF_INT npart, REF_INT *node_part) {
+  REF_GRID ref_grid = ref_migrate_grid(ref_migrate);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_LONG *pw, *added, total, maxpw;
+  REF_INT *conn, *touched, ntouched;
+  REF_INT pass, phase, moves, node, item, ref, i, p, q, best, gain, weight;
+
+  ref_malloc(pw, npart, REF_LONG);
+  ref_malloc(added, npart, REF_LONG);
+  ref_malloc_init(conn, npart, REF_INT, 0);
+  ref_malloc(touched, npart, REF_INT);
+
+  for (pass = 0; pass < REF_MIGRATE_GRAPH_KWAY_PASSES; pass++) {
+    moves = 0;
+    for (phase = 0; phase < 2; phase++) {
+      RSS(ref_node_ghost_int(ref_node, node_part, 1), "ghost part");
+      for (p = 0; p < npart; p++) {
+        pw[p] = 0;
+        added[p] = 0;
+      }
+      each_ref_migrate_node(ref_migrate, node) {
+        pw[node_part[node]] += (REF_LONG)vwgt[node];
+      }
+      RSS(ref_mpi_allsum(ref_mpi, pw, npart, REF_LONG_TYPE), "part weight");
+      total = 0;
+      for (p = 0; p < npart; p++) total += pw[p];
+      maxpw = (REF_LONG)(REF_MIGRATE_GRAPH_IMBALANCE * (REF_DBL)total /
+                         (REF_DBL)npart) +
+              1;
+      each_ref_migrate_node(ref_migrate, node) {
+        p = node_part[node];
+        weight = vwgt[node];
+        ntouched = 0;
+        each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node,
+                                        item, ref) {
+          q = node_part[ref];
+          if (q < 0 || npart <= q) continue;
+          if (0 == conn[q] && q != p) {
+            touched[ntouched] = q;
+            ntouched++;
+          }
+          conn[q] += ref_migrate_age(ref_migrate, node) +
+                     ref_migrate_age(ref_migrate, ref) + 1;
+        }
+        best = REF_EMPTY;
+        for (i = 0; i < ntouched; i++) {
+          q = touched[i];
+          if ((0 == phase && q < p) || (1 == phase && q > p)) continue;
+          /* budget assumes every rank could add to q concurrently */
+          if (pw[q] + (REF_LONG)ref_mpi_n(ref_mpi) *
+                          (added[q] + (REF_LONG)weight) >
+              maxpw)
+            continue;
+          if (REF_EMPTY == best || conn[q] > conn[best]) best = q;
+        }
+        if (REF_EMPTY != best) {
+          gain = conn[best] - conn[p];
+          if (0 < gain) {
+            node_part[node] = best;
+            added[best] += (REF_LONG)weight;
+            moves++;
+          }
+        }
+        for (i = 0; i < ntouched; i++) conn[touched[i]] = 0;
+        conn[p] = 0;
+      }
+    }
+    RSS(ref_mpi_allsum(ref_mpi, &moves, 1, REF_INT_TYPE), "moves");
+    if (0 == moves) break;
+  }
+
+  ref_free(touched);
+  ref_free(conn);
+  ref_free(added);
+  ref_free(pw);
+
+  return REF_SUCCESS;
+}
+
+/* Multilevel graph partitioning without third party libraries. Each rank
+ * contracts its own subgraph with heavy edge matching (no communication),
+ * the coarsest graph is partitioned on rank 0 by multilevel recursive
+ * bisection with FM refinement, and the projected parts are refined in
+ * parallel at the fine level. */
+REF_FCN static REF_STATUS ref_migrate_native_graph_part(REF_GRID ref_grid,
+                                                        REF_INT npart,
+                                                        REF_INT *node_part,
+                                                        REF_DBL *node_weight) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MIGRATE ref_migrate;
+  REF_INT *local, *coarse, *fine_vwgt;
+  REF_INT n, nc, ncoarse, target, node, item, ref, degree, i, j, c, proc;
+  REF_INT *xadj, *adjncy, *adjwgt, *vwgt, *cmap;
+  REF_INT *cxadj, *cadjncy, *cadjwgt, *cvwgt;
+  REF_INT *vtxdist, *count, *first, *next;
+  REF_GLOB *cglobal, *nbr, my_global;
+  REF_INT *nbr_wgt, *order, *gxadj, *gadjncy, *gadjwgt, *gvwgt, *gpart, *cpart;
+  REF_INT *deg, *local_adjncy, *local_adjwgt, nedge, ntotal;
+
+  RSS(ref_migrate_create(&ref_migrate, ref_grid), "create migrate");
+  RSS(ref_migrate_set_weight(ref_migrate, node_weight), "set weight");
+
+  /* skip agglomeration stuff */
+
+  ref_malloc_init(local, ref_migrate_max(ref_migrate), REF_INT, REF_EMPTY);
+  ref_malloc_init(fine_vwgt, ref_migrate_max(ref_migrate), REF_INT, 1);
+  n = 0;
+  each_ref_migrate_node(ref_migrate, node) {
+    local[node] = n;
+    fine_vwgt[node] =
+        MAX(1, (REF_INT)(ref_migrate_weight(ref_migrate, node) + 0.5));
+    n++;
+  }
+
+  /* rank local subgraph of owned nodes */
+  ref_malloc(xadj, n + 1, REF_INT);
+  ref_malloc(vwgt, n, REF_INT);
+  xadj[0] = 0;
+  each_ref_migrate_node(ref_migrate, node) {
+    degree = 0;
+    each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node, item,
+                                    ref) {
+      if (REF_EMPTY != local[ref]) degree++;
+    }
+    xadj[local[node] + 1] = xadj[local[node]] + degree;
+    vwgt[local[node]] = fine_vwgt[node];
+  }
+  ref_malloc(adjncy, MAX(1, xadj[n]), REF_INT);
+  ref_malloc(adjwgt, MAX(1, xadj[n]), REF_INT);
+  each_ref_migrate_node(ref_migrate, node) {
+    degree = 0;
+    each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node, item,
+                                    ref) {
+      if (REF_EMPTY == local[ref]) continue;
+      adjncy[xadj[local[node]] + degree] = local[ref];
+      adjwgt[xadj[local[node]] + degree] = ref_migrate_age(ref_migrate, node) +
+                                           ref_migrate_age(ref_migrate, ref) +
+                                           1;
+      degree++;
+    }
+  }
+
+  /* contract the local subgraph without communication */
+  target = MAX(1, MAX(REF_MIGRATE_GRAPH_GATHER,
+                      REF_MIGRATE_GRAPH_GATHER_PER_PART * npart) /
+                      ref_mpi_n(ref_mpi));
+  ref_malloc(coarse, n, REF_INT);
+  for (i = 0; i < n; i++) coarse[i] = i;
+  ncoarse = n;
+  while (ncoarse > target) {
+    REF_INT max_pair = REF_INT_MAX / 2;
+    ref_malloc(cmap, ncoarse, REF_INT);
+    RSS(ref_migrate_graph_coarsen(ncoarse, xadj, adjncy, adjwgt, vwgt, max_pair,
+                                  cmap, &nc, &cxadj, &cadjncy, &cadjwgt,
+                                  &cvwgt),
+        "coarsen local");
+    if ((REF_DBL)nc > 0.95 * (REF_DBL)ncoarse) {
+      ref_free(cvwgt);
+      ref_free(cadjwgt);
+      ref_free(cadjncy);
+      ref_free(cxadj);
+      ref_free(cmap);
+      break;
+    }
+    for (i = 0; i < n; i++) coarse[i] = cmap[coarse[i]];
+    ref_free(cmap);
+    ref_free(adjwgt);
+    ref_free(adjncy);
+    ref_free(xadj);
+    ref_free(vwgt);
+    xadj = cxadj;
+    adjncy = cadjncy;
+    adjwgt = cadjwgt;
+    vwgt = cvwgt;
+    ncoarse = nc;
+  }
+  ref_free(adjwgt);
+  ref_free(adjncy);
+  ref_free(xadj);
+  ref_mpi_stopwatch_stop(ref_mpi, "native graph contract");
+
+  /* number the coarse vertices globally and learn ghost coarse ids */
+  ref_malloc(vtxdist, ref_mpi_n(ref_mpi) + 1, REF_INT);
+  ref_malloc(count, ref_mpi_n(ref_mpi), REF_INT);
+  RSS(ref_mpi_allgather(ref_mpi, &ncoarse, count, REF_INT_TYPE),
+      "gather coarse size");
+  vtxdist[0] = 0;
+  each_ref_mpi_part(ref_mpi, proc) {
+    RAS((REF_LONG)vtxdist[proc] + (REF_LONG)count[proc] < REF_INT_MAX,
+        "coarse graph too large for REF_INT");
+    vtxdist[proc + 1] = vtxdist[proc] + count[proc];
+  }
+  ref_malloc_init(cglobal, ref_migrate_max(ref_migrate), REF_GLOB, REF_EMPTY);
+  each_ref_migrate_node(ref_migrate, node) {
+    cglobal[node] =
+        (REF_GLOB)vtxdist[ref_mpi_rank(ref_mpi)] + coarse[local[node]];
+  }
+  RSS(ref_node_ghost_glob(ref_node, cglobal, 1), "ghost coarse global");
+
+  /* coarse adjacency including off rank neighbors, merged per vertex */
+  ref_malloc_init(first, ncoarse + 1, REF_INT, 0);
+  each_ref_migrate_node(ref_migrate, node) {
+    RSS(ref_adj_degree(ref_migrate_conn(ref_migrate), node, &degree), "deg");
+    first[coarse[local[node]] + 1] += degree;
+  }
+  for (c = 0; c < ncoarse; c++) first[c + 1] += first[c];
+  ref_malloc(next, ncoarse, REF_INT);
+  for (c = 0; c < ncoarse; c++) next[c] = first[c];
+  ref_malloc(nbr, MAX(1, first[ncoarse]), REF_GLOB);
+  ref_malloc(nbr_wgt, MAX(1, first[ncoarse]), REF_INT);
+  each_ref_migrate_node(ref_migrate, node) {
+    c = coarse[local[node]];
+    each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node, item,
+                                    ref) {
+      nbr[next[c]] = cglobal[ref];
+      nbr_wgt[next[c]] = ref_migrate_age(ref_migrate, node) +
+                         ref_migrate_age(ref_migrate, ref) + 1;
+      next[c]++;
+    }
+  }
+  ref_malloc(deg, ncoarse, REF_INT);
+  ref_malloc(local_adjncy, MAX(1, first[ncoarse]), REF_INT);
+  ref_malloc(local_adjwgt, MAX(1, first[ncoarse]), REF_INT);
+  ref_malloc(order, MAX(1, first[ncoarse]), REF_INT);
+  nedge = 0;
+  for (c = 0; c < ncoarse; c++) {
+    my_global = (REF_GLOB)vtxdist[ref_mpi_rank(ref_mpi)] + c;
+    degree = 0;
+    RSS(ref_sort_heap_glob(first[c + 1] - first[c], &(nbr[first[c]]), order),
+        "sort neighbors");
+    for (i = 0; i < first[c + 1] - first[c]; i++) {
+      j = first[c] + order[i];
+      if (my_global == nbr[j] || REF_EMPTY == nbr[j]) continue;
+      if (0 < degree && local_adjncy[nedge - 1] == (REF_INT)nbr[j]) {
+        local_adjwgt[nedge - 1] += nbr_wgt[j];
+      } else {
+        local_adjncy[nedge] = (REF_INT)nbr[j];
+        local_adjwgt[nedge] = nbr_wgt[j];
+        nedge++;
+        degree++;
+      }
+    }
+    deg[c] = degree;
+  }
+  ref_free(order);
+  ref_free(nbr_wgt);
+  ref_free(nbr);
+  ref_free(next);
+  ref_free(first);
+  ref_free(cglobal);
+
+  /* gather the coarsest graph to rank 0, partition once, return parts */
+  ntotal = vtxdist[ref_mpi_n(ref_mpi)];
+  ref_malloc_init(gxadj, ref_mpi_once(ref_mpi) ? ntotal + 1 : 1, REF_INT, 0);
+  ref_malloc(gvwgt, ref_mpi_once(ref_mpi) ? MAX(1, ntotal) : 1, REF_INT);
+  RSS(ref_mpi_gatherv(ref_mpi, deg, count, &(gxadj[1]), REF_INT_TYPE),
+      "gather degree");
+  RSS(ref_mpi_gatherv(ref_mpi, vwgt, count, gvwgt, REF_INT_TYPE),
+      "gather vertex weight");
+  if (ref_mpi_once(ref_mpi)) {
+    for (c = 0; c < ntotal; c++) gxadj[c + 1] += gxadj[c];
+    each_ref_mpi_part(ref_mpi, proc) {
+      count[proc] = gxadj[vtxdist[proc + 1]] - gxadj[vtxdist[proc]];
+    }
+  } else {
+    count[ref_mpi_rank(ref_mpi)] = nedge;
+  }
+  ref_malloc(gadjncy, ref_mpi_once(ref_mpi) ? MAX(1, gxadj[ntotal]) : 1,
+             REF_INT);
+  ref_malloc(gadjwgt, ref_mpi_once(ref_mpi) ? MAX(1, gxadj[ntotal]) : 1,
+             REF_INT);
+  RSS(ref_mpi_gatherv(ref_mpi, local_adjncy, count, gadjncy, REF_INT_TYPE),
+      "gather adjncy");
+  RSS(ref_mpi_gatherv(ref_mpi, local_adjwgt, count, gadjwgt, REF_INT_TYPE),
+      "gather adjwgt");
+  ref_free(local_adjwgt);
+  ref_free(local_adjncy);
+  ref_free(deg);
+  ref_mpi_stopwatch_stop(ref_mpi, "native graph gather");
+
+  ref_malloc_init(cpart, MAX(1, ncoarse), REF_INT, REF_EMPTY);
+  each_ref_mpi_part(ref_mpi, proc) {
+    count[proc] = vtxdist[proc + 1] - vtxdist[proc];
+  }
+  if (ref_mpi_once(ref_mpi)) {
+    ref_malloc_init(gpart, MAX(1, ntotal), REF_INT, REF_EMPTY);
+    RSS(ref_migrate_graph_partition(ntotal, gxadj, gadjncy, gadjwgt, gvwgt,
+                                    npart, gpart),
+        "partition coarsest graph");
+    for (c = 0; c < ncoarse; c++) cpart[c] = gpart[c];
+    each_ref_mpi_worker(ref_mpi, proc) {
+      RSS(ref_mpi_scatter_send(ref_mpi, &(gpart[vtxdist[proc]]), count[proc],
+                               REF_INT_TYPE, proc),
+          "send part");
+    }
+    ref_free(gpart);
+  } else {
+    RSS(ref_mpi_scatter_recv(ref_mpi, cpart, ncoarse, REF_INT_TYPE),
+        "recv part");
+  }
+  ref_free(gadjwgt);
+  ref_free(gadjncy);
+  ref_free(gvwgt);
+  ref_free(gxadj);
+  ref_free(vwgt);
+  ref_mpi_stopwatch_stop(ref_mpi, "native graph coarse part");
+
+  for (node = 0; node < ref_node_max(ref_node); node++)
+    node_part[node] = REF_EMPTY;
+  each_ref_migrate_node(ref_migrate, node) {
+    node_part[node] = cpart[coarse[local[node]]];
+  }
+  RSS(ref_migrate_native_graph_refine(ref_migrate, fine_vwgt, npart,
+                                      node_part),
+      "refine");
+  ref_mpi_stopwatch_stop(ref_mpi, "native graph refine");
+
+  ref_free(cpart);
+  ref_free(count);
+  ref_free(vtxdist);
+  ref_free(coarse);
+  ref_free(fine_vwgt);
+  ref_free(local);
+
+  RSS(ref_migrate_free(ref_migrate), "free migrate");
+
+  return REF_SUCCESS;
+}
+
 #if defined(HAVE_ZOLTAN) && defined(HAVE_MPI)
 static int ref_migrate_zoltan_local_n(void *void_ref_migrate, int *ierr) {
   REF_MIGRATE ref_migrate = ((REF_MIGRATE)void_ref_migrate);
@@ -735,7 +1789,8 @@ static void ref_migrate_zoltan_edge_list(void *void_ref_migrate, int global_dim,
   }
 }
 REF_FCN REF_STATUS ref_migrate_zoltan_part(REF_GRID ref_grid,
-                                           REF_INT *node_part) {
+                                           REF_INT *node_part,
+                                           REF_DBL *node_weight) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_MIGRATE ref_migrate;
@@ -767,6 +1822,7 @@ REF_FCN REF_STATUS ref_migrate_zoltan_part(REF_GRID ref_grid,
   if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
 
   RSS(ref_migrate_create(&ref_migrate, ref_grid), "create migrate");
+  RSS(ref_migrate_set_weight(ref_migrate, node_weight), "set weight");
   ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "zoltan init");
 
   if (ref_grid_twod(ref_grid)) {
@@ -916,20 +1972,17 @@ REF_FCN REF_STATUS ref_migrate_zoltan_part(REF_GRID ref_grid,
 #endif
 
 #if defined(HAVE_PARMETIS) && defined(HAVE_MPI)
-REF_FCN static REF_STATUS ref_migrate_metis_wrapper(PARM_INT n, PARM_INT *xadj,
-                                                    PARM_INT *adjncy,
-                                                    PARM_INT *adjwgt,
-                                                    PARM_INT npart,
-                                                    PARM_INT *part) {
+REF_FCN static REF_STATUS ref_migrate_metis_wrapper(
+    PARM_INT n, PARM_INT *xadj, PARM_INT *adjncy, PARM_INT *adjwgt,
+    PARM_INT *vwgt, PARM_INT npart, PARM_INT *part) {
   PARM_INT ncon;
-  PARM_INT *vwgt, *vsize, objval;
+  PARM_INT *vsize, objval;
   PARM_REAL *tpwgts, *ubvec;
   PARM_INT options[METIS_NOPTIONS];
 
   ncon = 1;
   vsize = NULL;
 
-  ref_malloc_init(vwgt, ncon * n, PARM_INT, 1);
   ref_malloc_init(tpwgts, ncon * npart, PARM_REAL,
                   (PARM_REAL)1.0 / (PARM_REAL)npart);
   ref_malloc_init(ubvec, ncon, PARM_REAL, 1.001);
@@ -946,16 +1999,16 @@ REF_FCN static REF_STATUS ref_migrate_metis_wrapper(PARM_INT n, PARM_INT *xadj,
 
   ref_free(ubvec);
   ref_free(tpwgts);
-  ref_free(vwgt);
 
   return REF_SUCCESS;
 }
 REF_FCN static REF_STATUS ref_migrate_metis_subset(
     REF_MPI ref_mpi, PARM_INT npart, PARM_INT *vtxdist, PARM_INT *xadjdist,
-    PARM_INT *adjncydist, PARM_INT *adjwgtdist, PARM_INT *partdist) {
+    PARM_INT *adjncydist, PARM_INT *adjwgtdist, PARM_INT *vwgtdist,
+    PARM_INT *partdist) {
   REF_INT *count;
   PARM_INT global;
-  PARM_INT n, *xadj, *adjncy, *adjwgt, *part;
+  PARM_INT n, *xadj, *adjncy, *adjwgt, *vwgt, *part;
   REF_INT i, proc;
   REF_TYPE parm_type;
   RSS(ref_mpi_int_size_type(sizeof(PARM_INT), &parm_type), "calc parm_type");
@@ -968,6 +2021,9 @@ REF_FCN static REF_STATUS ref_migrate_metis_subset(
   }
   RSS(ref_mpi_allgatherv(ref_mpi, &(xadjdist[1]), count, &(xadj[1]), parm_type),
       "gather adj");
+  ref_malloc_init(vwgt, n, PARM_INT, 1);
+  RSS(ref_mpi_allgatherv(ref_mpi, vwgtdist, count, vwgt, parm_type),
+      "gather vwgt");
   xadj[0] = 0;
   each_ref_mpi_part(ref_mpi, proc) {
     for (global = vtxdist[proc] + 1; global <= vtxdist[proc + 1]; global++) {
@@ -989,7 +2045,7 @@ REF_FCN static REF_STATUS ref_migrate_metis_subset(
   ref_malloc_init(part, n, PARM_INT, REF_EMPTY);
 
   if (ref_mpi_once(ref_mpi)) {
-    RSS(ref_migrate_metis_wrapper(n, xadj, adjncy, adjwgt, npart, part),
+    RSS(ref_migrate_metis_wrapper(n, xadj, adjncy, adjwgt, vwgt, npart, part),
         "metis wrap");
   }
 
@@ -1014,6 +2070,7 @@ REF_FCN static REF_STATUS ref_migrate_metis_subset(
   ref_free(part);
   ref_free(adjwgt);
   ref_free(adjncy);
+  ref_free(vwgt);
   ref_free(xadj);
   ref_free(count);
 
@@ -1021,8 +2078,8 @@ REF_FCN static REF_STATUS ref_migrate_metis_subset(
 }
 REF_FCN static REF_STATUS ref_migrate_parmetis_wrapper(
     REF_MPI ref_mpi, PARM_INT npart, PARM_INT *vtxdist, PARM_INT *xadjdist,
-    PARM_INT *adjncydist, PARM_INT *adjwgtdist, PARM_INT *partdist) {
-  PARM_INT *vwgt;
+    PARM_INT *adjncydist, PARM_INT *adjwgtdist, PARM_INT *vwgtdist,
+    PARM_INT *partdist) {
   PARM_REAL *tpwgts, *ubvec;
   PARM_INT wgtflag = 3;
   PARM_INT numflag = 0;
@@ -1030,36 +2087,31 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_wrapper(
   PARM_INT edgecut;
   PARM_INT options[] = {1, 0 /* PARMETIS_DBGLVL_PROGRESS */, 42};
   MPI_Comm comm = (*((MPI_Comm *)(ref_mpi->comm)));
-  REF_INT n, proc;
 
-  proc = ref_mpi_rank(ref_mpi);
-  n = (REF_INT)(vtxdist[proc + 1] - vtxdist[proc]);
   ncon = 1;
-  ref_malloc_init(vwgt, ncon * n, PARM_INT, 1);
   ref_malloc_init(tpwgts, ncon * npart, PARM_REAL,
                   (PARM_REAL)1.0 / (PARM_REAL)npart);
   ref_malloc_init(ubvec, ncon, PARM_REAL, 1.01);
 
   REIS(METIS_OK,
-       ParMETIS_V3_PartKway(vtxdist, xadjdist, adjncydist, vwgt, adjwgtdist,
-                            &wgtflag, &numflag, &ncon, &npart, tpwgts, ubvec,
-                            options, &edgecut, partdist, &comm),
+       ParMETIS_V3_PartKway(vtxdist, xadjdist, adjncydist, vwgtdist,
+                            adjwgtdist, &wgtflag, &numflag, &ncon, &npart,
+                            tpwgts, ubvec, options, &edgecut, partdist, &comm),
        "ParMETIS is not o.k.");
 
   ref_free(ubvec);
   ref_free(tpwgts);
-  ref_free(vwgt);
   return REF_SUCCESS;
 }
 REF_FCN static REF_STATUS ref_migrate_parmetis_subset(
     REF_MPI ref_mpi, PARM_INT npart, REF_INT newproc, PARM_INT *vtxdist,
     PARM_INT *xadjdist, PARM_INT *adjncydist, PARM_INT *adjwgtdist,
-    PARM_INT *partdist) {
+    PARM_INT *vwgtdist, PARM_INT *partdist) {
   REF_INT proc, nold, nnew, i, first;
   REF_INT nsend, nrecv, *send_size, *recv_size;
   PARM_INT ntotal;
   PARM_INT n0, n1;
-  PARM_INT *vtx, *xadj, *adjncy, *adjwgt, *part;
+  PARM_INT *vtx, *xadj, *adjncy, *adjwgt, *vwgt, *part;
   REF_INT *deg, *newdeg;
   REF_MPI split_mpi;
   REF_TYPE parm_type;
@@ -1088,6 +2140,7 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_subset(
   if (debug) printf("%d: nold %d nnew %d\n", ref_mpi_rank(ref_mpi), nold, nnew);
   ref_malloc_init(part, nnew, PARM_INT, REF_EMPTY);
   ref_malloc_init(xadj, nnew + 1, PARM_INT, 0);
+  ref_malloc_init(vwgt, nnew, PARM_INT, 1);
   ref_malloc_init(deg, nold, REF_INT, 0);
   ref_malloc_init(newdeg, nnew, REF_INT, 0);
   for (i = 0; i < nold; i++) {
@@ -1118,6 +2171,9 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_subset(
   RSS(ref_mpi_alltoallv(ref_mpi, deg, send_size, newdeg, recv_size, 1,
                         REF_INT_TYPE),
       "alltoallv degree");
+  RSS(ref_mpi_alltoallv(ref_mpi, vwgtdist, send_size, vwgt, recv_size, 1,
+                        parm_type),
+      "alltoallv vwgt");
   xadj[0] = 0;
   for (i = 0; i < nnew; i++) {
     xadj[i + 1] = xadj[i] + (PARM_INT)(newdeg[i]);
@@ -1176,13 +2232,14 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_subset(
   RSS(ref_mpi_front_comm(ref_mpi, &split_mpi, newproc), "split comm");
   if (ref_mpi_rank(ref_mpi) < newproc) {
     RSS(ref_migrate_parmetis_wrapper(split_mpi, npart, vtx, xadj, adjncy,
-                                     adjwgt, part),
+                                     adjwgt, vwgt, part),
         "parmetis wrapper");
   }
   RSS(ref_mpi_join_comm(split_mpi), "join comm");
   RSS(ref_mpi_free(split_mpi), "free split comm");
   ref_free(adjwgt);
   ref_free(adjncy);
+  ref_free(vwgt);
   ref_free(xadj);
   ref_mpi_stopwatch_stop(ref_mpi, "parmetis part");
 
@@ -1212,12 +2269,13 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_subset(
 
 REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
                                                     REF_INT npart,
-                                                    REF_INT *node_part) {
+                                                    REF_INT *node_part,
+                                                    REF_DBL *node_weight) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_MIGRATE ref_migrate;
   PARM_INT *vtxdist;
-  PARM_INT *xadj, *adjncy, *adjwgt;
+  PARM_INT *xadj, *adjncy, *adjwgt, *vwgt;
   PARM_INT *part;
 
   REF_GLOB *implied, shift;
@@ -1231,6 +2289,7 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
   if (!ref_mpi_para(ref_mpi)) return REF_SUCCESS;
 
   RSS(ref_migrate_create(&ref_migrate, ref_grid), "create migrate");
+  RSS(ref_migrate_set_weight(ref_migrate, node_weight), "set weight");
 
   /* skip agglomeration stuff */
 
@@ -1244,6 +2303,7 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
   ref_malloc(vtxdist, ref_mpi_n(ref_mpi) + 1, PARM_INT);
   ref_malloc_init(implied, ref_migrate_max(ref_migrate), REF_GLOB, REF_EMPTY);
   ref_malloc(xadj, n + 1, PARM_INT);
+  ref_malloc(vwgt, n, PARM_INT);
   ref_malloc_init(part, n, PARM_INT, ref_mpi_rank(ref_mpi));
 
   vtxdist[0] = 0;
@@ -1256,6 +2316,9 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
   xadj[0] = 0;
   each_ref_migrate_node(ref_migrate, node) {
     implied[node] = shift + (REF_GLOB)n;
+    /* metis vertex weights are integers */
+    vwgt[n] = (PARM_INT)MAX(
+        1, (REF_INT)(ref_migrate_weight(ref_migrate, node) + 0.5));
     RSS(ref_adj_degree(ref_migrate_conn(ref_migrate), node, &degree), "deg");
     RAS(0 < degree, "hanging node island, zero degree");
     xadj[n + 1] = xadj[n] + degree;
@@ -1286,12 +2349,12 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
 
   if (1 == newpart) {
     RSS(ref_migrate_metis_subset(ref_mpi, npart, vtxdist, xadj, adjncy, adjwgt,
-                                 part),
+                                 vwgt, part),
         "metis wrapper");
     ref_mpi_stopwatch_stop(ref_mpi, "metis part");
   } else {
     RSS(ref_migrate_parmetis_subset(ref_mpi, npart, newpart, vtxdist, xadj,
-                                    adjncy, adjwgt, part),
+                                    adjncy, adjwgt, vwgt, part),
         "subset");
   }
 
@@ -1306,6 +2369,7 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
   ref_free(adjwgt);
   ref_free(adjncy);
   ref_free(part);
+  ref_free(vwgt);
   ref_free(xadj);
   ref_free(implied);
   ref_free(vtxdist);
@@ -1317,8 +2381,173 @@ REF_FCN static REF_STATUS ref_migrate_parmetis_part(REF_GRID ref_grid,
 }
 #endif
 
+#define REF_MIGRATE_DIFFUSE_ROUNDS (20)
+
+/* First order diffusion of load between neighboring parts. Each round moves
+ * a layer of boundary nodes toward lighter neighbors, most connected nodes
+ * first. Declines (diffused false) when the current parts are not the
+ * npart active ranks or the imbalance is above the partitioner limit. */
+REF_FCN static REF_STATUS ref_migrate_diffuse_part(REF_GRID ref_grid,
+                                                   REF_INT npart,
+                                                   REF_INT *node_part,
+                                                   REF_DBL *node_weight,
+                                                   REF_BOOL *diffused) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MIGRATE ref_migrate;
+  REF_INT rank = ref_mpi_rank(ref_mpi);
+  REF_INT node, item, ref, other, part, best, count, best_count;
+  REF_INT round, ncand, i, *cand, *cand_part, *cand_key, *order;
+  REF_INT *degree;
+  REF_DBL *load, *change, *flow, total, max_load, imbalance, weight;
+  REF_DBL initial_imbalance;
+  REF_LONG nmoved;
+
+  *diffused = REF_FALSE;
+
+  ref_malloc_init(load, ref_mpi_n(ref_mpi), REF_DBL, 0.0);
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node))
+      load[rank] += (NULL == node_weight ? 1.0 : node_weight[node]);
+  }
+  RSS(ref_mpi_allsum(ref_mpi, load, ref_mpi_n(ref_mpi), REF_DBL_TYPE),
+      "allsum load");
+  total = 0.0;
+  max_load = 0.0;
+  each_ref_mpi_part(ref_mpi, part) {
+    if ((part < npart) != (load[part] > 0.0)) {
+      ref_free(load); /* active ranks change, repartition */
+      return REF_SUCCESS;
+    }
+    total += load[part];
+    max_load = MAX(max_load, load[part]);
+  }
+  imbalance = max_load / (total / (REF_DBL)npart);
+  if (imbalance > ref_grid_partitioner_imbalance(ref_grid)) {
+    ref_free(load);
+    return REF_SUCCESS;
+  }
+  *diffused = REF_TRUE;
+  initial_imbalance = imbalance;
+
+  each_ref_node_valid_node(ref_node, node) {
+    node_part[node] = ref_node_part(ref_node, node);
+  }
+
+  RSS(ref_migrate_create(&ref_migrate, ref_grid), "create migrate");
+  ref_malloc(change, ref_mpi_n(ref_mpi), REF_DBL);
+  ref_malloc(flow, ref_mpi_n(ref_mpi), REF_DBL);
+  ref_malloc(degree, ref_mpi_n(ref_mpi), REF_INT);
+  ref_malloc(cand, ref_node_max(ref_node), REF_INT);
+  ref_malloc(cand_part, ref_node_max(ref_node), REF_INT);
+  ref_malloc(cand_key, ref_node_max(ref_node), REF_INT);
+  ref_malloc(order, ref_node_max(ref_node), REF_INT);
+
+  for (round = 0; round < REF_MIGRATE_DIFFUSE_ROUNDS &&
+                  imbalance > REF_MIGRATE_DIFFUSE_TARGET;
+       round++) {
+    /* neighbor parts of this rank, flagged in flow */
+    each_ref_mpi_part(ref_mpi, part) {
+      flow[part] = 0.0;
+      degree[part] = 0;
+    }
+    each_ref_migrate_node(ref_migrate, node) {
+      each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node,
+                                      item, ref) {
+        if (rank != node_part[ref]) flow[node_part[ref]] = 1.0;
+      }
+    }
+    each_ref_mpi_part(ref_mpi, part) {
+      if (flow[part] > 0.0) degree[rank]++;
+    }
+    RSS(ref_mpi_allsum(ref_mpi, degree, ref_mpi_n(ref_mpi), REF_INT_TYPE),
+        "allsum degree");
+    each_ref_mpi_part(ref_mpi, part) {
+      if (flow[part] > 0.0 && load[rank] > load[part]) {
+        flow[part] = (load[rank] - load[part]) /
+                     (REF_DBL)(MAX(degree[rank], degree[part]) + 1);
+      } else {
+        flow[part] = 0.0;
+      }
+    }
+
+    /* candidates from the labels at the start of the round */
+    ncand = 0;
+    each_ref_migrate_node(ref_migrate, node) {
+      if (rank != node_part[node]) continue;
+      best = REF_EMPTY;
+      best_count = 0;
+      each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node,
+                                      item, ref) {
+        part = node_part[ref];
+        if (rank == part || flow[part] <= 0.0) continue;
+        count = 0;
+        each_ref_adj_node_item_with_ref(ref_migrate_conn(ref_migrate), node,
+                                        i, other) {
+          if (part == node_part[other]) count++;
+        }
+        if (count > best_count) {
+          best = part;
+          best_count = count;
+        }
+      }
+      if (REF_EMPTY == best) continue;
+      cand[ncand] = node;
+      cand_part[ncand] = best;
+      cand_key[ncand] = -best_count;
+      ncand++;
+    }
+    RSS(ref_sort_heap_int(ncand, cand_key, order), "sort candidates");
+
+    each_ref_mpi_part(ref_mpi, part) { change[part] = 0.0; }
+    nmoved = 0;
+    for (i = 0; i < ncand; i++) {
+      node = cand[order[i]];
+      part = cand_part[order[i]];
+      weight = (NULL == node_weight ? 1.0 : node_weight[node]);
+      if (flow[part] < 0.5 * weight) continue;
+      node_part[node] = part;
+      flow[part] -= weight;
+      change[rank] -= weight;
+      change[part] += weight;
+      nmoved++;
+    }
+    RSS(ref_mpi_allsum(ref_mpi, change, ref_mpi_n(ref_mpi), REF_DBL_TYPE),
+        "allsum change");
+    RSS(ref_mpi_allsum(ref_mpi, &nmoved, 1, REF_LONG_TYPE), "allsum moved");
+    if (0 == nmoved) break;
+    RSS(ref_node_ghost_int(ref_node, node_part, 1), "ghost part");
+
+    max_load = 0.0;
+    each_ref_mpi_part(ref_mpi, part) {
+      load[part] += change[part];
+      max_load = MAX(max_load, load[part]);
+    }
+    imbalance = max_load / (total / (REF_DBL)npart);
+  }
+
+  if (ref_mpi_once(ref_mpi))
+    printf("diffused %d rounds imbalance %6.3f to %6.3f\n", round,
+           initial_imbalance, imbalance);
+
+  ref_free(order);
+  ref_free(cand_key);
+  ref_free(cand_part);
+  ref_free(cand);
+  ref_free(degree);
+  ref_free(flow);
+  ref_free(change);
+  ref_free(load);
+  RSS(ref_migrate_free(ref_migrate), "free migrate");
+
+  ref_mpi_stopwatch_stop(ref_mpi, "diffuse part");
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_migrate_new_part(REF_GRID ref_grid, REF_INT npart,
-                                               REF_INT *new_part) {
+                                               REF_INT *new_part,
+                                               REF_DBL *node_weight) {
   /* synchronize_globals and collect_ghost_age by ref_migrate_to_balance */
 
   if (!ref_mpi_para(ref_grid_mpi(ref_grid)) || (2 > npart)) {
@@ -1331,33 +2560,40 @@ REF_FCN static REF_STATUS ref_migrate_new_part(REF_GRID ref_grid, REF_INT npart,
       RSS(ref_migrate_single_part(ref_grid, new_part), "single by method");
       break;
     case REF_MIGRATE_NATIVE_RCB:
-      RSS(ref_migrate_native_rcb_part(ref_grid, npart, new_part),
+      RSS(ref_migrate_native_rcb_part(ref_grid, npart, new_part, node_weight),
           "single by method");
       break;
+    case REF_MIGRATE_NATIVE_GRAPH:
+      RSS(ref_migrate_native_graph_part(ref_grid, npart, new_part,
+                                        node_weight),
+          "native graph part");
+      break;
     case REF_MIGRATE_ZOLTAN_GRAPH:
     case REF_MIGRATE_ZOLTAN_RCB:
 #if defined(HAVE_ZOLTAN) && defined(HAVE_MPI)
-      RSS(ref_migrate_zoltan_part(ref_grid, new_part), "zoltan part");
+      RSS(ref_migrate_zoltan_part(ref_grid, new_part, node_weight),
+          "zoltan part");
       break;
 #endif
     case REF_MIGRATE_PARMETIS:
 #if defined(HAVE_PARMETIS) && defined(HAVE_MPI)
-      RSS(ref_migrate_parmetis_part(ref_grid, npart, new_part),
+      RSS(ref_migrate_parmetis_part(ref_grid, npart, new_part, node_weight),
           "parmetis part");
       break;
 #endif
     case REF_MIGRATE_RECOMMENDED:
 #if defined(HAVE_PARMETIS) && defined(HAVE_MPI)
-      RSS(ref_migrate_parmetis_part(ref_grid, npart, new_part),
+      RSS(ref_migrate_parmetis_part(ref_grid, npart, new_part, node_weight),
           "parmetis part");
       break;
 #endif
 #if !defined(HAVE_PARMETIS) && defined(HAVE_ZOLTAN) && defined(HAVE_MPI)
-      RSS(ref_migrate_zoltan_part(ref_grid, new_part), "zoltan part");
+      RSS(ref_migrate_zoltan_part(ref_grid, new_part, node_weight),
+          "zoltan part");
       break;
 #endif
 #if !defined(HAVE_PARMETIS) && !defined(HAVE_ZOLTAN)
-      RSS(ref_migrate_native_rcb_part(ref_grid, npart, new_part),
+      RSS(ref_migrate_native_rcb_part(ref_grid, npart, new_part, node_weight),
           "single by method");
       break;
 #endif
@@ -1372,7 +2608,9 @@ REF_FCN static REF_STATUS ref_migrate_new_part(REF_GRID ref_grid, REF_INT npart,
       break;
   }
 
-  RSS(ref_migrate_report_load_balance(ref_grid, npart, new_part), "report bal");
+  RSS(ref_migrate_report_load_balance(ref_grid, npart, new_part, node_weight),
+      "report bal");
+  RSS(ref_migrate_report_edge_cut(ref_grid, new_part), "report cut");
 
   return REF_SUCCESS;
 }
@@ -1462,6 +2700,7 @@ REF_FCN static REF_STATUS ref_migrate_shufflin_node(REF_NODE ref_node) {
     RSS(ref_node_local(ref_node, b_global[node], &local), "local");
     for (i = 0; i < REF_NODE_REAL_PER; i++)
       ref_node_real(ref_node, i, local) = b_real[i + REF_NODE_REAL_PER * node];
+    ref_node_metric_stale(ref_node, local);
     for (i = 0; i < ref_node_naux(ref_node); i++)
       ref_node_aux(ref_node, i, local) =
           b_aux[i + ref_node_naux(ref_node) * node];
@@ -1730,16 +2969,23 @@ REF_FCN REF_STATUS ref_migrate_shufflin(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
-REF_FCN REF_STATUS ref_migrate_to_balance(REF_GRID ref_grid) {
+REF_FCN static REF_STATUS ref_migrate_balance(REF_GRID ref_grid,
+                                              REF_DBL *node_weight,
+                                              REF_BOOL diffuse) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_INT npart;
   REF_INT node, age, max_age;
   REF_INT node_per_core, heuristic;
   REF_INT *node_part;
+  REF_DBL total;
+  REF_BOOL diffused;
 
   RSS(ref_node_synchronize_globals(ref_node), "sync global nodes");
   RSS(ref_node_collect_ghost_age(ref_node), "collect ghost age");
+  if (NULL != node_weight) {
+    RSS(ref_node_ghost_dbl(ref_node, node_weight, 1), "ghost weight");
+  }
   if (ref_grid_partitioner_full(ref_grid)) {
     npart = ref_mpi_n(ref_mpi);
   } else {
@@ -1752,15 +2998,35 @@ REF_FCN REF_STATUS ref_migrate_to_balance(REF_GRID ref_grid) {
     RSS(ref_mpi_max(ref_mpi, &age, &max_age, REF_INT_TYPE), "mpi max");
     RSS(ref_mpi_bcast(ref_mpi, &max_age, 1, REF_INT_TYPE), "min");
     node_per_core = MAX(1000, 10 * max_age);
-    heuristic = MAX(
-        1, (REF_INT)(ref_node_n_global(ref_node) / (REF_GLOB)node_per_core));
+    total = (REF_DBL)ref_node_n_global(ref_node);
+    if (NULL != node_weight) { /* cores for the predicted work */
+      total = 0.0;
+      each_ref_node_valid_node(ref_node, node) {
+        if (ref_node_owned(ref_node, node)) total += node_weight[node];
+      }
+      RSS(ref_mpi_allsum(ref_mpi, &total, 1, REF_DBL_TYPE), "sum weight");
+    }
+    heuristic = MAX(1, (REF_INT)(total / (REF_DBL)node_per_core));
     npart = MIN(ref_mpi_n(ref_mpi), heuristic);
   }
 
   ref_malloc_init(node_part, ref_node_max(ref_node), REF_INT, REF_EMPTY);
 
-  RSS(ref_migrate_new_part(ref_grid, npart, node_part), "new part");
+  diffused = REF_FALSE;
+  if (diffuse && ref_mpi_para(ref_mpi) &&
+      ref_grid_partitioner_imbalance(ref_grid) > 1.0) {
+    RSS(ref_migrate_diffuse_part(ref_grid, npart, node_part, node_weight,
+                                 &diffused),
+        "diffuse");
+  }
+  if (diffused) {
+    RSS(ref_migrate_report_edge_cut(ref_grid, node_part), "report cut");
+  } else {
+    RSS(ref_migrate_new_part(ref_grid, npart, node_part, node_weight),
+        "new part");
+  }
   RSS(ref_node_ghost_int(ref_node, node_part, 1), "ghost part");
+  RSS(ref_migrate_report_moved(ref_grid, node_part), "report moved");
   if (1 < ref_mpi_timing(ref_mpi))
     ref_mpi_stopwatch_stop(ref_mpi, "migrate: new part");
 
@@ -1780,6 +3046,98 @@ REF_FCN REF_STATUS ref_migrate_to_balance(REF_GRID ref_grid) {
   return REF_SUCCESS;
 }
 
+/* nodes per unit metric volume of a regular unit mesh, about six tets or
+ * two triangles per node */
+#define REF_MIGRATE_WORK_TET_NODES (1.4)
+#define REF_MIGRATE_WORK_TRI_NODES (1.15)
+
+REF_FCN REF_STATUS ref_migrate_adapt_work(REF_GRID ref_grid, REF_DBL *work) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell;
+  REF_INT cell, cell_node, node;
+  REF_INT nodes[REF_CELL_MAX_SIZE_PER];
+  REF_DBL m[6], det, volume, nodes_per_volume;
+  REF_DBL normal[3], normal_projection;
+
+  if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
+    ref_cell = ref_grid_tri(ref_grid);
+    nodes_per_volume = REF_MIGRATE_WORK_TRI_NODES;
+  } else {
+    ref_cell = ref_grid_tet(ref_grid);
+    nodes_per_volume = REF_MIGRATE_WORK_TET_NODES;
+  }
+
+  for (node = 0; node < ref_node_max(ref_node); node++) work[node] = 0.0;
+
+  /* each owned node collects its share of the complexity */
+  each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+    if (ref_grid_twod(ref_grid) || ref_grid_surf(ref_grid)) {
+      RSS(ref_node_tri_area(ref_node, nodes, &volume), "area");
+    } else {
+      RSS(ref_node_tet_vol(ref_node, nodes, &volume), "vol");
+    }
+    for (cell_node = 0; cell_node < ref_cell_node_per(ref_cell); cell_node++) {
+      node = nodes[cell_node];
+      if (!ref_node_owned(ref_node, node)) continue;
+      RSS(ref_node_metric_get(ref_node, node, m), "get");
+      RSS(ref_matrix_det_m(m, &det), "det");
+      if (ref_grid_surf(ref_grid)) {
+        RSS(ref_node_tri_normal(ref_node, nodes, normal), "norm");
+        if (REF_SUCCESS != ref_math_normalize(normal)) continue;
+        normal_projection = ref_matrix_vt_m_v(m, normal);
+        if (!ref_math_divisible(det, normal_projection)) continue;
+        det /= normal_projection;
+      }
+      if (det > 0.0)
+        work[node] +=
+            sqrt(det) * volume / ((REF_DBL)ref_cell_node_per(ref_cell));
+    }
+  }
+
+  /* existing nodes are always visited, even when coarsened away */
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) {
+      work[node] = MAX(1.0, nodes_per_volume * work[node]);
+    } else {
+      work[node] = 1.0;
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_migrate_to_balance_weighted(REF_GRID ref_grid,
+                                                   REF_DBL *node_weight) {
+  RSS(ref_migrate_balance(ref_grid, node_weight, REF_FALSE), "balance");
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_migrate_balance_by_work(REF_GRID ref_grid,
+                                                      REF_BOOL diffuse) {
+  REF_DBL *work = NULL;
+
+  if (ref_grid_partitioner_work(ref_grid)) {
+    ref_malloc(work, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+    RSS(ref_migrate_adapt_work(ref_grid, work), "adapt work");
+  }
+
+  RSS(ref_migrate_balance(ref_grid, work, diffuse), "balance");
+
+  ref_free(work);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_migrate_to_balance(REF_GRID ref_grid) {
+  RSS(ref_migrate_balance_by_work(ref_grid, REF_FALSE), "full");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_migrate_to_rebalance(REF_GRID ref_grid) {
+  RSS(ref_migrate_balance_by_work(ref_grid, REF_TRUE), "diffuse");
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_migrate_replicate_ghost(REF_GRID ref_grid) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
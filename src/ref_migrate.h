@@ -31,7 +31,8 @@ typedef enum REF_MIGRATE_PARTIONERS { /* 0 */ REF_MIGRATE_RECOMMENDED,
                                       /* 3 */ REF_MIGRATE_ZOLTAN_GRAPH,
                                       /* 4 */ REF_MIGRATE_ZOLTAN_RCB,
                                       /* 5 */ REF_MIGRATE_NATIVE_RCB,
-                                      /* 6 */ REF_MIGRATE_LAST
+                                      /* 6 */ REF_MIGRATE_NATIVE_GRAPH,
+                                      /* 7 */ REF_MIGRATE_LAST
 } REF_MIGRATE_PARTIONER;
 END_C_DECLORATION
 
@@ -93,11 +94,34 @@ REF_FCN REF_STATUS ref_migrate_split_dir(REF_MPI ref_mpi, REF_INT n,
 REF_FCN REF_STATUS ref_migrate_split_ratio(REF_INT number_of_partitions,
                                            REF_DBL *ratio);
 
+REF_FCN REF_STATUS ref_migrate_graph_coarsen(
+    REF_INT n, REF_INT *xadj, REF_INT *adjncy, REF_INT *adjwgt, REF_INT *vwgt,
+    REF_INT max_vwgt, REF_INT *cmap, REF_INT *nc, REF_INT **cxadj,
+    REF_INT **cadjncy, REF_INT **cadjwgt, REF_INT **cvwgt);
+REF_FCN REF_STATUS ref_migrate_graph_edge_cut(REF_INT n, REF_INT *xadj,
+                                              REF_INT *adjncy, REF_INT *adjwgt,
+                                              REF_INT *part, REF_LONG *cut);
+REF_FCN REF_STATUS ref_migrate_graph_partition(REF_INT n, REF_INT *xadj,
+                                               REF_INT *adjncy, REF_INT *adjwgt,
+                                               REF_INT *vwgt, REF_INT npart,
+                                               REF_INT *part);
+
 REF_FCN REF_STATUS ref_migrate_shufflin_cell(REF_NODE ref_node,
                                              REF_CELL ref_cell);
 REF_FCN REF_STATUS ref_migrate_shufflin(REF_GRID ref_grid);
 
+/* node_weight of owned nodes, ghosts are updated, NULL for unit weights */
+REF_FCN REF_STATUS ref_migrate_to_balance_weighted(REF_GRID ref_grid,
+                                                   REF_DBL *node_weight);
+/* predicted adaptation work of owned nodes from the metric complexity */
+REF_FCN REF_STATUS ref_migrate_adapt_work(REF_GRID ref_grid, REF_DBL *work);
 REF_FCN REF_STATUS ref_migrate_to_balance(REF_GRID ref_grid);
+/* max over mean part work where diffusion stops */
+#define REF_MIGRATE_DIFFUSE_TARGET (1.03)
+/* after an adaptation pass, diffuses boundary nodes between neighboring
+ * parts when the imbalance is under ref_grid_partitioner_imbalance and
+ * repartitions with ref_migrate_to_balance otherwise */
+REF_FCN REF_STATUS ref_migrate_to_rebalance(REF_GRID ref_grid);
 
 REF_FCN REF_STATUS ref_migrate_replicate_ghost(REF_GRID ref_grid);
 
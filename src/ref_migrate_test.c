@@ -40,6 +40,80 @@
 #include "ref_part.h"
 #include "ref_sort.h"
 
+/* max over mean of the predicted adaptation work summed on each rank */
+REF_FCN static REF_STATUS ref_migrate_test_work_imbalance(REF_GRID ref_grid,
+                                                          REF_DBL *imbalance) {
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL *work, *load, total, max_load;
+  REF_INT node, part;
+
+  ref_malloc(work, ref_node_max(ref_node), REF_DBL);
+  ref_malloc_init(load, ref_mpi_n(ref_mpi), REF_DBL, 0.0);
+  RSS(ref_migrate_adapt_work(ref_grid, work), "work");
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node))
+      load[ref_mpi_rank(ref_mpi)] += work[node];
+  }
+  RSS(ref_mpi_allsum(ref_mpi, load, ref_mpi_n(ref_mpi), REF_DBL_TYPE), "sum");
+  total = 0.0;
+  max_load = 0.0;
+  each_ref_mpi_part(ref_mpi, part) {
+    total += load[part];
+    max_load = MAX(max_load, load[part]);
+  }
+  *imbalance = max_load / (total / (REF_DBL)ref_mpi_n(ref_mpi));
+  ref_free(load);
+  ref_free(work);
+  return REF_SUCCESS;
+}
+
+/* sorted globals of the nodes owned by this rank */
+REF_FCN static REF_STATUS ref_migrate_test_owned(REF_NODE ref_node, REF_INT *n,
+                                                 REF_GLOB **owned) {
+  REF_INT node;
+  REF_GLOB *unsorted;
+  REF_INT *order, i;
+  *n = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) (*n)++;
+  }
+  ref_malloc(unsorted, *n, REF_GLOB);
+  ref_malloc(order, *n, REF_INT);
+  ref_malloc(*owned, *n, REF_GLOB);
+  *n = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    if (ref_node_owned(ref_node, node)) {
+      unsorted[*n] = ref_node_global(ref_node, node);
+      (*n)++;
+    }
+  }
+  RSS(ref_sort_heap_glob(*n, unsorted, order), "sort");
+  for (i = 0; i < *n; i++) (*owned)[i] = unsorted[order[i]];
+  ref_free(order);
+  ref_free(unsorted);
+  return REF_SUCCESS;
+}
+
+/* owned nodes, summed over ranks, that were not owned here before */
+REF_FCN static REF_STATUS ref_migrate_test_moved(REF_NODE ref_node, REF_INT n,
+                                                 REF_GLOB *owned,
+                                                 REF_LONG *moved) {
+  REF_INT node, position;
+  REF_STATUS status;
+  *moved = 0;
+  each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_owned(ref_node, node)) continue;
+    status = ref_sort_search_glob(n, owned, ref_node_global(ref_node, node),
+                                  &position);
+    RXS(status, REF_NOT_FOUND, "search");
+    if (REF_NOT_FOUND == status) (*moved)++;
+  }
+  RSS(ref_mpi_allsum(ref_node_mpi(ref_node), moved, 1, REF_LONG_TYPE),
+      "sum");
+  return REF_SUCCESS;
+}
+
 int main(int argc, char *argv[]) {
   REF_MPI ref_mpi;
   RSS(ref_mpi_start(argc, argv), "start");
@@ -201,6 +275,248 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
   }
 
+  if (1 == argc) { /* part and migrate tet b8.ugrid native graph */
+    REF_GRID import_grid;
+    char grid_file[] = "ref_migrate_test.b8.ugrid";
+
+    if (ref_mpi_once(ref_mpi)) {
+      REF_GRID export_grid;
+      RSS(ref_fixture_tet_brick_grid(&export_grid, ref_mpi), "set up tet");
+      RSS(ref_export_by_extension(export_grid, grid_file), "export");
+      RSS(ref_grid_free(export_grid), "free");
+    }
+
+    RSS(ref_part_by_extension(&import_grid, ref_mpi, grid_file), "import");
+    ref_grid_partitioner(import_grid) = REF_MIGRATE_NATIVE_GRAPH;
+    ref_grid_partitioner_full(import_grid) = REF_TRUE;
+    RSS(ref_migrate_to_balance(import_grid), "create");
+
+    RSS(ref_grid_free(import_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
+  }
+
+  if (1 == argc) { /* part and migrate tet b8.ugrid by predicted work */
+    REF_GRID import_grid;
+    REF_NODE ref_node;
+    REF_INT node;
+    REF_DBL h, imbalance;
+    char grid_file[] = "ref_migrate_test.b8.ugrid";
+
+    if (ref_mpi_once(ref_mpi)) {
+      REF_GRID export_grid;
+      RSS(ref_fixture_tet_brick_args_grid(&export_grid, ref_mpi, 0.0, 1.0, 0.0,
+                                          1.0, 0.0, 1.0, 11, 11, 11),
+          "set up tet");
+      RSS(ref_export_by_extension(export_grid, grid_file), "export");
+      RSS(ref_grid_free(export_grid), "free");
+    }
+
+    RSS(ref_part_by_extension(&import_grid, ref_mpi, grid_file), "import");
+    ref_node = ref_grid_node(import_grid);
+    each_ref_node_valid_node(ref_node, node) {
+      h = 0.5;
+      if (ref_node_xyz(ref_node, 0, node) < 0.25) h = 0.05;
+      RSS(ref_node_metric_form(ref_node, node, 1.0 / (h * h), 0, 0,
+                               1.0 / (h * h), 0, 1.0 / (h * h)),
+          "set metric");
+    }
+    ref_grid_partitioner(import_grid) = REF_MIGRATE_NATIVE_RCB;
+    ref_grid_partitioner_full(import_grid) = REF_TRUE;
+    ref_grid_partitioner_work(import_grid) = REF_TRUE;
+    RSS(ref_migrate_to_balance(import_grid), "create");
+    RSS(ref_migrate_test_work_imbalance(import_grid, &imbalance), "imbalance");
+    RAB(imbalance <= REF_MIGRATE_DIFFUSE_TARGET, "predicted work imbalance",
+        { printf("imbalance %f\n", imbalance); });
+
+    RSS(ref_grid_free(import_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
+  }
+
+  if (1 == argc) { /* rebalance predicted work by diffusion */
+    REF_GRID import_grid;
+    REF_NODE ref_node;
+    REF_INT node, nowned;
+    REF_GLOB *owned;
+    REF_LONG moved;
+    REF_DBL h, before, after;
+    char grid_file[] = "ref_migrate_test.b8.ugrid";
+
+    if (ref_mpi_once(ref_mpi)) {
+      REF_GRID export_grid;
+      RSS(ref_fixture_tet_brick_args_grid(&export_grid, ref_mpi, 0.0, 1.0, 0.0,
+                                          1.0, 0.0, 1.0, 11, 11, 11),
+          "set up tet");
+      RSS(ref_export_by_extension(export_grid, grid_file), "export");
+      RSS(ref_grid_free(export_grid), "free");
+    }
+
+    RSS(ref_part_by_extension(&import_grid, ref_mpi, grid_file), "import");
+    ref_grid_partitioner(import_grid) = REF_MIGRATE_NATIVE_RCB;
+    ref_grid_partitioner_full(import_grid) = REF_TRUE;
+    RSS(ref_migrate_to_balance(import_grid), "balance count");
+    ref_node = ref_grid_node(import_grid);
+    ref_grid_partitioner_work(import_grid) = REF_TRUE;
+    ref_grid_partitioner_imbalance(import_grid) = 10.0;
+
+    RSS(ref_migrate_test_work_imbalance(import_grid, &before), "imbalance");
+    RSS(ref_migrate_test_owned(ref_node, &nowned, &owned), "owned");
+    RSS(ref_migrate_to_rebalance(import_grid), "diffuse balanced");
+    RSS(ref_migrate_test_moved(ref_node, nowned, owned, &moved), "moved");
+    ref_free(owned);
+    if (ref_mpi_para(ref_mpi)) REIS(0, moved, "balanced parts moved nodes");
+
+    each_ref_node_valid_node(ref_node, node) {
+      h = 0.1;
+      if (ref_node_xyz(ref_node, 0, node) < 0.3) h = 0.07;
+      RSS(ref_node_metric_form(ref_node, node, 1.0 / (h * h), 0, 0,
+                               1.0 / (h * h), 0, 1.0 / (h * h)),
+          "set metric");
+    }
+    RSS(ref_migrate_test_work_imbalance(import_grid, &before), "imbalance");
+    RSS(ref_migrate_test_owned(ref_node, &nowned, &owned), "owned");
+    RSS(ref_migrate_to_rebalance(import_grid), "diffuse work");
+    RSS(ref_migrate_test_moved(ref_node, nowned, owned, &moved), "moved");
+    ref_free(owned);
+    RSS(ref_migrate_test_work_imbalance(import_grid, &after), "imbalance");
+    if (ref_mpi_para(ref_mpi)) RAS(0 < moved, "imbalanced parts kept nodes");
+    RAB(after <= REF_MIGRATE_DIFFUSE_TARGET, "diffused imbalance", {
+      printf("imbalance %f before %f after\n", before, after);
+    });
+
+    RSS(ref_grid_free(import_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* predicted adapt work */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_INT node;
+    REF_DBL *work, total, h = 0.05;
+
+    RSS(ref_fixture_tet_brick_args_grid(&ref_grid, ref_mpi, 0.0, 1.0, 0.0, 1.0,
+                                        0.0, 1.0, 9, 9, 9),
+        "set up tet");
+    ref_node = ref_grid_node(ref_grid);
+    ref_malloc(work, ref_node_max(ref_node), REF_DBL);
+
+    RSS(ref_migrate_adapt_work(ref_grid, work), "unit metric work");
+    each_ref_node_valid_node(ref_node, node) {
+      RWDS(1.0, work[node], -1.0, "coarse metric is one node each");
+    }
+
+    each_ref_node_valid_node(ref_node, node) {
+      RSS(ref_node_metric_form(ref_node, node, 1.0 / (h * h), 0, 0,
+                               1.0 / (h * h), 0, 1.0 / (h * h)),
+          "set metric");
+    }
+    RSS(ref_migrate_adapt_work(ref_grid, work), "fine metric work");
+    total = 0.0;
+    each_ref_node_valid_node(ref_node, node) { total += work[node]; }
+    /* complexity times nodes per volume, floor adds less than one per node */
+    RAS(1.4 / (h * h * h) - 1.0e-6 * total < total, "work too small");
+    RAS(total < 1.4 / (h * h * h) + (REF_DBL)ref_node_n(ref_node),
+        "work too large");
+
+    ref_free(work);
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* coarsen path graph */
+    REF_INT xadj[] = {0, 1, 3, 5, 6};
+    REF_INT adjncy[] = {1, 0, 2, 1, 3, 2};
+    REF_INT adjwgt[] = {1, 1, 5, 5, 1, 1};
+    REF_INT vwgt[] = {1, 1, 1, 1};
+    REF_INT cmap[4], nc;
+    REF_INT *cxadj, *cadjncy, *cadjwgt, *cvwgt;
+
+    RSS(ref_migrate_graph_coarsen(4, xadj, adjncy, adjwgt, vwgt, 10, cmap, &nc,
+                                  &cxadj, &cadjncy, &cadjwgt, &cvwgt),
+        "coarsen");
+    RAS(2 <= nc && nc <= 3, "expected pairs");
+    REIS(4, cvwgt[0] + cvwgt[1] + (3 == nc ? cvwgt[2] : 0), "weight total");
+    REIS(2 * (nc - 1), cxadj[nc], "coarse path edges");
+
+    ref_free(cvwgt);
+    ref_free(cadjwgt);
+    ref_free(cadjncy);
+    ref_free(cxadj);
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* partition brick edge graph */
+    REF_GRID ref_grid;
+    REF_EDGE ref_edge;
+    REF_NODE ref_node;
+    REF_INT *xadj, *adjncy, *adjwgt, *vwgt, *part, *degree;
+    REF_INT n, node, edge, n0, n1, npart = 4, p;
+    REF_LONG cut, strip_cut, size[4];
+
+    RSS(ref_fixture_tet_brick_args_grid(&ref_grid, ref_mpi, 0.0, 1.0, 0.0, 1.0,
+                                        0.0, 1.0, 9, 9, 9),
+        "set up tet");
+    ref_node = ref_grid_node(ref_grid);
+    n = ref_node_n(ref_node);
+    for (node = 0; node < n; node++)
+      RAS(ref_node_valid(ref_node, node), "expected compact nodes");
+    RSS(ref_edge_create(&ref_edge, ref_grid), "edges");
+    ref_malloc_init(degree, n, REF_INT, 0);
+    ref_malloc_init(xadj, n + 1, REF_INT, 0);
+    ref_malloc(adjncy, 2 * ref_edge_n(ref_edge), REF_INT);
+    ref_malloc_init(adjwgt, 2 * ref_edge_n(ref_edge), REF_INT, 1);
+    ref_malloc_init(vwgt, n, REF_INT, 1);
+    ref_malloc(part, n, REF_INT);
+    each_ref_edge(ref_edge, edge) {
+      xadj[1 + ref_edge_e2n(ref_edge, 0, edge)]++;
+      xadj[1 + ref_edge_e2n(ref_edge, 1, edge)]++;
+    }
+    for (node = 0; node < n; node++)
+      xadj[node + 1] += xadj[node];
+    each_ref_edge(ref_edge, edge) {
+      n0 = ref_edge_e2n(ref_edge, 0, edge);
+      n1 = ref_edge_e2n(ref_edge, 1, edge);
+      adjncy[xadj[n0] + degree[n0]] = n1;
+      degree[n0]++;
+      adjncy[xadj[n1] + degree[n1]] = n0;
+      degree[n1]++;
+    }
+
+    RSS(ref_migrate_graph_partition(n, xadj, adjncy,
+                                    adjwgt, vwgt, npart, part),
+        "partition");
+    for (p = 0; p < npart; p++) size[p] = 0;
+    for (node = 0; node < n; node++) {
+      RAS(0 <= part[node] && part[node] < npart, "part range");
+      size[part[node]]++;
+    }
+    for (p = 0; p < npart; p++) {
+      RAS((REF_DBL)size[p] <= 1.03 * (REF_DBL)ref_node_n(ref_node) /
+                                     (REF_DBL)npart +
+                                 1.0,
+          "part too large");
+      RAS(0 < size[p], "empty part");
+    }
+    RSS(ref_migrate_graph_edge_cut(n, xadj, adjncy,
+                                   adjwgt, part, &cut),
+        "cut");
+    /* slabs along x are a reasonable partition of a brick */
+    for (node = 0; node < n; node++) {
+      part[node] = MIN(npart - 1, (REF_INT)((REF_DBL)npart *
+                                            ref_node_xyz(ref_node, 0, node)));
+    }
+    RSS(ref_migrate_graph_edge_cut(n, xadj, adjncy,
+                                   adjwgt, part, &strip_cut),
+        "cut");
+    RAS(cut <= strip_cut, "multilevel cut worse than slabs");
+
+    ref_free(part);
+    ref_free(vwgt);
+    ref_free(adjwgt);
+    ref_free(adjncy);
+    ref_free(xadj);
+    ref_free(degree);
+    RSS(ref_edge_free(ref_edge), "free edge");
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   if (1 == argc) { /* replicate tet b8.ugrid */
     REF_GRID ref_grid = NULL;
     REF_GLOB nnode = 0;
@@ -0,0 +1,220 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_mmap.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ref_compress.h"
+#include "ref_malloc.h"
+#include "ref_writer.h"
+
+REF_FCN REF_STATUS ref_mmap_create(REF_MMAP *ref_mmap_ptr,
+                                   const char *filename,
+                                   REF_BOOL swap_endian) {
+  REF_MMAP ref_mmap;
+  struct stat file_stat;
+  void *data;
+  int fd;
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0) printf("unable to open %s\n", filename);
+  RAS(0 <= fd, "unable to open file");
+  if (0 != fstat(fd, &file_stat)) {
+    close(fd);
+    THROW("fstat failed");
+  }
+
+  ref_malloc(*ref_mmap_ptr, 1, REF_MMAP_STRUCT);
+  ref_mmap = (*ref_mmap_ptr);
+
+  ref_mmap->data = NULL;
+  ref_mmap->size = (REF_FILEPOS)file_stat.st_size;
+  ref_mmap->position = 0;
+  ref_mmap->swap_endian = swap_endian;
+  ref_mmap->mapped = REF_FALSE;
+  ref_mmap->packed = REF_FALSE;
+
+  if (0 < ref_mmap->size) {
+    data = mmap(NULL, (size_t)ref_mmap->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED != data) {
+      ref_mmap->data = (REF_BYTE *)data;
+      ref_mmap->mapped = REF_TRUE;
+      /* advisory, the page cache reads ahead of the cursor */
+      (void)posix_madvise(data, (size_t)ref_mmap->size,
+                          POSIX_MADV_SEQUENTIAL);
+    } else {
+      FILE *file;
+      file = fopen(filename, "r");
+      if (NULL == (void *)file) {
+        close(fd);
+        ref_free(ref_mmap);
+        THROW("unable to fopen file after mmap failed");
+      }
+      ref_malloc_size_t(ref_mmap->data, (size_t)ref_mmap->size, REF_BYTE);
+      REIS(ref_mmap->size,
+           fread(ref_mmap->data, sizeof(REF_BYTE), (size_t)ref_mmap->size,
+                 file),
+           "read whole file");
+      fclose(file);
+    }
+  }
+  close(fd);
+
+  if (0 < ref_mmap->size) {
+    REF_BOOL compressed;
+    RSS(ref_compress_detect(ref_mmap->data, (REF_SIZE)ref_mmap->size,
+                            &compressed),
+        "detect");
+    if (compressed) { /* readers see the expanded bytes */
+      REF_BYTE *raw;
+      REF_SIZE raw_size;
+      RSS(ref_compress_unpack(ref_mmap->data, (REF_SIZE)ref_mmap->size, &raw,
+                              &raw_size),
+          "unpack");
+      if (ref_mmap->mapped) {
+        REIS(0, munmap(ref_mmap->data, (size_t)ref_mmap->size), "munmap");
+      } else {
+        ref_free(ref_mmap->data);
+      }
+      ref_mmap->data = raw;
+      ref_mmap->size = (REF_FILEPOS)raw_size;
+      ref_mmap->mapped = REF_FALSE;
+      ref_mmap->packed = REF_TRUE;
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_free(REF_MMAP ref_mmap) {
+  if (NULL == (void *)ref_mmap) return REF_NULL;
+  if (ref_mmap->mapped) {
+    REIS(0, munmap(ref_mmap->data, (size_t)ref_mmap->size), "munmap");
+  } else {
+    ref_free(ref_mmap->data);
+  }
+  ref_free(ref_mmap);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_seek(REF_MMAP ref_mmap, REF_FILEPOS position) {
+  RAS(0 <= position && position <= ref_mmap->size, "seek outside of file");
+  ref_mmap->position = position;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_view(REF_MMAP ref_mmap, REF_SIZE size,
+                                 REF_BYTE **view) {
+  *view = NULL;
+  RAS((REF_FILEPOS)size <= ref_mmap_remaining(ref_mmap),
+      "read past end of file");
+  *view = &(ref_mmap->data[ref_mmap->position]);
+  ref_mmap->position += (REF_FILEPOS)size;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_bytes(REF_MMAP ref_mmap, REF_SIZE size,
+                                  void *bytes) {
+  REF_BYTE *view;
+  RSS(ref_mmap_view(ref_mmap, size, &view), "view");
+  if (0 < size) memcpy(bytes, view, size);
+  return REF_SUCCESS;
+}
+
+/* copy n words and swap the whole destination in one pass */
+REF_FCN static REF_STATUS ref_mmap_words(REF_MMAP ref_mmap, REF_SIZE n,
+                                         REF_INT width, REF_BYTE *words) {
+  RSS(ref_mmap_bytes(ref_mmap, (REF_SIZE)width * n, words), "copy");
+  if (ref_mmap->swap_endian) RSS(ref_writer_swap(words, n, width), "swap");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_int(REF_MMAP ref_mmap, REF_INT *value) {
+  RSS(ref_mmap_words(ref_mmap, 1, (REF_INT)sizeof(REF_INT),
+                     (REF_BYTE *)value),
+      "int");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_long(REF_MMAP ref_mmap, REF_LONG *value) {
+  RSS(ref_mmap_words(ref_mmap, 1, (REF_INT)sizeof(REF_LONG),
+                     (REF_BYTE *)value),
+      "long");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_dbl(REF_MMAP ref_mmap, REF_DBL *value) {
+  RSS(ref_mmap_words(ref_mmap, 1, (REF_INT)sizeof(REF_DBL),
+                     (REF_BYTE *)value),
+      "dbl");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_ints(REF_MMAP ref_mmap, REF_INT n,
+                                 REF_INT *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_mmap_words(ref_mmap, (REF_SIZE)n, (REF_INT)sizeof(REF_INT),
+                     (REF_BYTE *)values),
+      "ints");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_longs(REF_MMAP ref_mmap, REF_INT n,
+                                  REF_LONG *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_mmap_words(ref_mmap, (REF_SIZE)n, (REF_INT)sizeof(REF_LONG),
+                     (REF_BYTE *)values),
+      "longs");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_dbls(REF_MMAP ref_mmap, REF_INT n,
+                                 REF_DBL *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_mmap_words(ref_mmap, (REF_SIZE)n, (REF_INT)sizeof(REF_DBL),
+                     (REF_BYTE *)values),
+      "dbls");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_mmap_dbls_strided(REF_MMAP ref_mmap, REF_INT n,
+                                         REF_INT width, REF_INT stride,
+                                         REF_DBL *values) {
+  REF_BYTE *view;
+  REF_INT i;
+  RAS(0 <= n, "negative n");
+  RAS((REF_INT)sizeof(REF_DBL) * width <= stride, "stride smaller than width");
+  RSS(ref_mmap_view(ref_mmap, (REF_SIZE)stride * (REF_SIZE)n, &view), "view");
+  for (i = 0; i < n; i++) {
+    memcpy(&(values[width * i]), &(view[(REF_SIZE)stride * (REF_SIZE)i]),
+           sizeof(REF_DBL) * (REF_SIZE)width);
+  }
+  if (ref_mmap->swap_endian)
+    RSS(ref_writer_swap((REF_BYTE *)values, (REF_SIZE)width * (REF_SIZE)n,
+                        (REF_INT)sizeof(REF_DBL)),
+        "swap");
+  return REF_SUCCESS;
+}
@@ -0,0 +1,80 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_MMAP_H
+#define REF_MMAP_H
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_MMAP_STRUCT REF_MMAP_STRUCT;
+typedef REF_MMAP_STRUCT *REF_MMAP;
+END_C_DECLORATION
+
+BEGIN_C_DECLORATION
+struct REF_MMAP_STRUCT {
+  REF_BYTE *data;
+  REF_FILEPOS size;
+  REF_FILEPOS position;
+  REF_BOOL swap_endian;
+  REF_BOOL mapped;
+  REF_BOOL packed;
+};
+
+#define ref_mmap_size(ref_mmap) ((ref_mmap)->size)
+#define ref_mmap_position(ref_mmap) ((ref_mmap)->position)
+#define ref_mmap_swap_endian(ref_mmap) ((ref_mmap)->swap_endian)
+/* false when the file was read into memory because mmap was refused
+ * or the file was a ref_compress container */
+#define ref_mmap_mapped(ref_mmap) ((ref_mmap)->mapped)
+/* true when data was expanded from a ref_compress container */
+#define ref_mmap_packed(ref_mmap) ((ref_mmap)->packed)
+#define ref_mmap_remaining(ref_mmap) ((ref_mmap)->size - (ref_mmap)->position)
+
+/* read only view of a whole file, with a cursor for sequential reads,
+ * ref_compress containers are expanded transparently */
+REF_FCN REF_STATUS ref_mmap_create(REF_MMAP *ref_mmap, const char *filename,
+                                   REF_BOOL swap_endian);
+REF_FCN REF_STATUS ref_mmap_free(REF_MMAP ref_mmap);
+
+REF_FCN REF_STATUS ref_mmap_seek(REF_MMAP ref_mmap, REF_FILEPOS position);
+/* pointer to size raw (unswapped, unaligned) bytes at the cursor */
+REF_FCN REF_STATUS ref_mmap_view(REF_MMAP ref_mmap, REF_SIZE size,
+                                 REF_BYTE **view);
+REF_FCN REF_STATUS ref_mmap_bytes(REF_MMAP ref_mmap, REF_SIZE size,
+                                  void *bytes);
+
+REF_FCN REF_STATUS ref_mmap_int(REF_MMAP ref_mmap, REF_INT *value);
+REF_FCN REF_STATUS ref_mmap_long(REF_MMAP ref_mmap, REF_LONG *value);
+REF_FCN REF_STATUS ref_mmap_dbl(REF_MMAP ref_mmap, REF_DBL *value);
+
+REF_FCN REF_STATUS ref_mmap_ints(REF_MMAP ref_mmap, REF_INT n,
+                                 REF_INT *values);
+REF_FCN REF_STATUS ref_mmap_longs(REF_MMAP ref_mmap, REF_INT n,
+                                  REF_LONG *values);
+REF_FCN REF_STATUS ref_mmap_dbls(REF_MMAP ref_mmap, REF_INT n,
+                                 REF_DBL *values);
+/* leading width doubles of n records that are stride bytes apart */
+REF_FCN REF_STATUS ref_mmap_dbls_strided(REF_MMAP ref_mmap, REF_INT n,
+                                         REF_INT width, REF_INT stride,
+                                         REF_DBL *values);
+
+END_C_DECLORATION
+
+#endif /* REF_MMAP_H */
@@ -0,0 +1,178 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_mmap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_compress.h"
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+#include "ref_writer.h"
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  if (ref_mpi_once(ref_mpi)) { /* empty file */
+    REF_MMAP ref_mmap;
+    FILE *file;
+    char filename[] = "ref_mmap_test_empty.bin";
+
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    fclose(file);
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "create");
+    REIS(0, ref_mmap_size(ref_mmap), "size");
+    REIS(0, ref_mmap_remaining(ref_mmap), "remaining");
+    RSS(ref_mmap_free(ref_mmap), "free");
+    REIS(0, remove(filename), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* scalars, seek, and view */
+    REF_WRITER ref_writer;
+    REF_MMAP ref_mmap;
+    FILE *file;
+    char filename[] = "ref_mmap_test_scalar.bin";
+    REF_INT int_value;
+    REF_LONG long_value;
+    REF_DBL dbl_value;
+    REF_BYTE *view;
+
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "create");
+    RSS(ref_writer_int(ref_writer, 7), "int");
+    RSS(ref_writer_long(ref_writer, 8), "long");
+    RSS(ref_writer_dbl(ref_writer, 9.0), "dbl");
+    RSS(ref_writer_free(ref_writer), "free");
+    fclose(file);
+
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "create");
+    REIS(4 + 8 + 8, ref_mmap_size(ref_mmap), "size");
+    RSS(ref_mmap_int(ref_mmap, &int_value), "int");
+    REIS(7, int_value, "int");
+    RSS(ref_mmap_long(ref_mmap, &long_value), "long");
+    REIS(8, long_value, "long");
+    RSS(ref_mmap_dbl(ref_mmap, &dbl_value), "dbl");
+    RWDS(9.0, dbl_value, -1, "dbl");
+    REIS(0, ref_mmap_remaining(ref_mmap), "at end");
+    RSS(ref_mmap_seek(ref_mmap, 4), "seek");
+    RSS(ref_mmap_view(ref_mmap, 8, &view), "view");
+    REIS(4 + 8, ref_mmap_position(ref_mmap), "view advances");
+    RSS(ref_mmap_seek(ref_mmap, 0), "seek");
+    RSS(ref_mmap_int(ref_mmap, &int_value), "int");
+    REIS(7, int_value, "int");
+    RSS(ref_mmap_free(ref_mmap), "free");
+    REIS(0, remove(filename), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* swapped arrays and strided records */
+    REF_WRITER ref_writer;
+    REF_MMAP ref_mmap;
+    FILE *file;
+    char filename[] = "ref_mmap_test_swap.bin";
+    REF_INT i, n = 1000;
+    REF_INT *ints;
+    REF_LONG *longs;
+    REF_DBL *dbls;
+
+    ref_malloc(ints, n, REF_INT);
+    ref_malloc(longs, n, REF_LONG);
+    ref_malloc(dbls, 3 * n, REF_DBL);
+
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    RSS(ref_writer_create(&ref_writer, file, REF_TRUE), "create");
+    for (i = 0; i < n; i++) RSS(ref_writer_int(ref_writer, i), "int");
+    for (i = 0; i < n; i++)
+      RSS(ref_writer_long(ref_writer, (REF_LONG)(2 * i)), "long");
+    for (i = 0; i < n; i++) { /* meshb like vertex records */
+      RSS(ref_writer_dbl(ref_writer, (REF_DBL)i), "x");
+      RSS(ref_writer_dbl(ref_writer, 0.5 * (REF_DBL)i), "y");
+      RSS(ref_writer_dbl(ref_writer, -(REF_DBL)i), "z");
+      RSS(ref_writer_int(ref_writer, 9), "id");
+    }
+    RSS(ref_writer_free(ref_writer), "free");
+    fclose(file);
+
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_TRUE), "create");
+    RSS(ref_mmap_ints(ref_mmap, n, ints), "ints");
+    RSS(ref_mmap_longs(ref_mmap, n, longs), "longs");
+    RSS(ref_mmap_dbls_strided(ref_mmap, n, 2, 3 * 8 + 4, dbls), "strided");
+    REIS(0, ref_mmap_remaining(ref_mmap), "at end");
+    for (i = 0; i < n; i++) {
+      REIS(i, ints[i], "int");
+      REIS(2 * i, longs[i], "long");
+      RWDS((REF_DBL)i, dbls[0 + 2 * i], -1, "x");
+      RWDS(0.5 * (REF_DBL)i, dbls[1 + 2 * i], -1, "y");
+    }
+    RSS(ref_mmap_seek(ref_mmap, (REF_FILEPOS)(12 * n)), "seek records");
+    RSS(ref_mmap_dbls(ref_mmap, 3, dbls), "first record");
+    RWDS(-0.0, dbls[2], -1, "z");
+    RSS(ref_mmap_int(ref_mmap, &i), "id");
+    REIS(9, i, "id");
+    RSS(ref_mmap_free(ref_mmap), "free");
+
+    REIS(0, remove(filename), "test clean up");
+    ref_free(dbls);
+    ref_free(longs);
+    ref_free(ints);
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* compressed container */
+    REF_MMAP ref_mmap;
+    FILE *file;
+    char filename[] = "ref_mmap_test_compress.bin";
+    REF_INT i, n = 1000;
+    REF_DBL *dbls;
+    REF_BYTE *packed;
+    REF_SIZE packed_size;
+
+    ref_malloc(dbls, n, REF_DBL);
+    for (i = 0; i < n; i++) dbls[i] = 0.25 * (REF_DBL)i;
+    RSS(ref_compress_pack((REF_BYTE *)dbls, sizeof(REF_DBL) * (REF_SIZE)n, 0,
+                          &packed, &packed_size),
+        "pack");
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    REIS(packed_size, fwrite(packed, sizeof(REF_BYTE), packed_size, file),
+         "write");
+    fclose(file);
+    ref_free(packed);
+
+    for (i = 0; i < n; i++) dbls[i] = 0.0;
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "create");
+    RAS(!ref_mmap_mapped(ref_mmap), "expanded in memory");
+    RAS(ref_mmap_packed(ref_mmap), "expanded from container");
+    REIS(8 * n, ref_mmap_size(ref_mmap), "raw size");
+    RSS(ref_mmap_dbls(ref_mmap, n, dbls), "dbls");
+    for (i = 0; i < n; i++) RWDS(0.25 * (REF_DBL)i, dbls[i], -1, "dbl");
+    RSS(ref_mmap_free(ref_mmap), "free");
+
+    REIS(0, remove(filename), "test clean up");
+    ref_free(dbls);
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}
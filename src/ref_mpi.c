@@ -976,6 +976,42 @@ REF_FCN REF_STATUS ref_mpi_allgatherv(REF_MPI ref_mpi, void *local_array,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_mpi_gatherv(REF_MPI ref_mpi, void *local_array,
+                                   REF_INT *counts, void *concatenated_array,
+                                   REF_TYPE type) {
+#ifdef HAVE_MPI
+  REF_INT proc;
+  REF_INT *displs;
+  MPI_Datatype datatype;
+
+  if (!ref_mpi_para(ref_mpi)) {
+    RSS(ref_mpi_allgatherv(ref_mpi, local_array, counts, concatenated_array,
+                           type),
+        "copy");
+    return REF_SUCCESS;
+  }
+
+  ref_type_mpi_type(type, datatype);
+  ref_malloc(displs, ref_mpi_n(ref_mpi), REF_INT);
+
+  displs[0] = 0;
+  each_ref_mpi_worker(ref_mpi, proc) displs[proc] =
+      displs[proc - 1] + counts[proc - 1];
+
+  MPI_Gatherv(local_array, counts[ref_mpi_rank(ref_mpi)], datatype,
+              concatenated_array, counts, displs, datatype, 0,
+              ref_mpi_comm(ref_mpi));
+
+  ref_free(displs);
+#else
+  RSS(ref_mpi_allgatherv(ref_mpi, local_array, counts, concatenated_array,
+                         type),
+      "copy");
+#endif
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_mpi_allconcat(REF_MPI ref_mpi, REF_INT ldim,
                                      REF_INT my_size, void *my_array,
                                      REF_INT *total_size, REF_INT **source,
@@ -1238,3 +1274,53 @@ REF_FCN REF_STATUS ref_mpi_balance(REF_MPI ref_mpi, REF_INT ldim, REF_INT nitem,
 
   return REF_SUCCESS;
 }
+
+REF_FCN REF_STATUS ref_mpi_write_at_all(REF_MPI ref_mpi, const char *filename,
+                                        REF_INT npiece, REF_FILEPOS *offset,
+                                        REF_SIZE *size, REF_BYTE **data) {
+  REF_INT piece;
+#ifdef HAVE_MPI
+  if (ref_mpi_para(ref_mpi)) {
+    MPI_File fh;
+    MPI_Status status;
+    REF_SIZE chunk = 1073741824, done, length;
+    REF_INT nchunk, max_nchunk, ichunk;
+    REF_BYTE *start;
+    REIS(MPI_SUCCESS,
+         MPI_File_open(ref_mpi_comm(ref_mpi), (char *)filename, MPI_MODE_WRONLY,
+                       MPI_INFO_NULL, &fh),
+         "MPI_File_open");
+    for (piece = 0; piece < npiece; piece++) {
+      nchunk = (REF_INT)((size[piece] + chunk - 1) / chunk);
+      RSS(ref_mpi_max(ref_mpi, &nchunk, &max_nchunk, REF_INT_TYPE), "max");
+      RSS(ref_mpi_bcast(ref_mpi, &max_nchunk, 1, REF_INT_TYPE), "bcast");
+      done = 0;
+      for (ichunk = 0; ichunk < max_nchunk; ichunk++) {
+        length = MIN(chunk, size[piece] - done);
+        start = (0 < length ? &(data[piece][done]) : NULL);
+        REIS(MPI_SUCCESS,
+             MPI_File_write_at_all(fh, (MPI_Offset)(offset[piece] + done),
+                                   start, (int)length, MPI_BYTE, &status),
+             "MPI_File_write_at_all");
+        done += length;
+      }
+    }
+    REIS(MPI_SUCCESS, MPI_File_close(&fh), "MPI_File_close");
+    return REF_SUCCESS;
+  }
+#endif
+  if (ref_mpi_once(ref_mpi)) {
+    FILE *file;
+    file = fopen(filename, "r+b");
+    if (NULL == (void *)file) printf("unable to open %s\n", filename);
+    RNS(file, "unable to open file");
+    for (piece = 0; piece < npiece; piece++) {
+      if (0 == size[piece]) continue;
+      REIS(0, fseeko(file, offset[piece], SEEK_SET), "seek piece");
+      REIS(size[piece], fwrite(data[piece], 1, size[piece], file), "piece");
+    }
+    REIS(0, fclose(file), "close file");
+  }
+
+  return REF_SUCCESS;
+}
@@ -132,6 +132,10 @@ REF_FCN REF_STATUS ref_mpi_allgather(REF_MPI ref_mpi, void *scalar, void *array,
 REF_FCN REF_STATUS ref_mpi_allgatherv(REF_MPI ref_mpi, void *local_array,
                                       REF_INT *counts, void *concatenated_array,
                                       REF_TYPE type);
+/* concatenated_array only filled on rank 0 */
+REF_FCN REF_STATUS ref_mpi_gatherv(REF_MPI ref_mpi, void *local_array,
+                                   REF_INT *counts, void *concatenated_array,
+                                   REF_TYPE type);
 
 REF_FCN REF_STATUS ref_mpi_allconcat(REF_MPI ref_mpi, REF_INT ldim,
                                      REF_INT my_size, void *my_array,
@@ -149,6 +153,12 @@ REF_FCN REF_STATUS ref_mpi_balance(REF_MPI ref_mpi, REF_INT ldim, REF_INT nitem,
                                    REF_INT last_rank, REF_INT *nbalanced,
                                    void **balanced, REF_TYPE type);
 
+/* collective, every rank passes the same npiece, pieces are written at
+ * absolute byte offsets of an existing file */
+REF_FCN REF_STATUS ref_mpi_write_at_all(REF_MPI ref_mpi, const char *filename,
+                                        REF_INT npiece, REF_FILEPOS *offset,
+                                        REF_SIZE *size, REF_BYTE **data);
+
 END_C_DECLORATION
 
 #endif /* REF_MPI_H */
@@ -599,6 +599,35 @@ int main(int argc, char *argv[]) {
     ref_mpi_stopwatch_stop(ref_mpi, "balance");
   }
 
+  { /* gatherv to rank 0 */
+    REF_INT *counts, *local, *all;
+    REF_INT proc, i, total;
+    ref_malloc(counts, ref_mpi_n(ref_mpi), REF_INT);
+    total = 0;
+    each_ref_mpi_part(ref_mpi, proc) {
+      counts[proc] = proc + 1;
+      total += counts[proc];
+    }
+    ref_malloc(local, ref_mpi_rank(ref_mpi) + 1, REF_INT);
+    for (i = 0; i <= ref_mpi_rank(ref_mpi); i++) {
+      local[i] = ref_mpi_rank(ref_mpi);
+    }
+    ref_malloc_init(all, total, REF_INT, REF_EMPTY);
+    RSS(ref_mpi_gatherv(ref_mpi, local, counts, all, REF_INT_TYPE), "gatherv");
+    if (ref_mpi_once(ref_mpi)) {
+      total = 0;
+      each_ref_mpi_part(ref_mpi, proc) {
+        for (i = 0; i < counts[proc]; i++) {
+          REIS(proc, all[total], "gathered value");
+          total++;
+        }
+      }
+    }
+    ref_free(all);
+    ref_free(local);
+    ref_free(counts);
+  }
+
   { /* deep reduce chunk */
     REF_MPI deep_copy;
     RSS(ref_mpi_deep_copy(&deep_copy, ref_mpi), "deep copy");
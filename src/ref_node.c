@@ -58,8 +58,11 @@ REF_FCN REF_STATUS ref_node_create(REF_NODE *ref_node_ptr, REF_MPI ref_mpi) {
 
   ref_malloc(ref_node->part, max, REF_INT);
   ref_malloc(ref_node->age, max, REF_INT);
+  ref_node_sweep(ref_node) = 0;
+  ref_malloc_init(ref_node->touched, max, REF_INT, 0);
 
   ref_malloc(ref_node->real, REF_NODE_REAL_PER * max, REF_DBL);
+  ref_malloc_init(ref_node->metric_det, max, REF_DBL, -1.0);
 
   ref_node_naux(ref_node) = 0;
   ref_node->aux = NULL;
@@ -90,7 +93,9 @@ REF_FCN REF_STATUS ref_node_free(REF_NODE ref_node) {
   ref_free(ref_node->unused_global);
   /* ref_mpi reference only */
   ref_free(ref_node->aux);
+  ref_free(ref_node->metric_det);
   ref_free(ref_node->real);
+  ref_free(ref_node->touched);
   ref_free(ref_node->age);
   ref_free(ref_node->part);
   ref_free(ref_node->sorted_local);
@@ -133,10 +138,16 @@ REF_FCN REF_STATUS ref_node_deep_copy(REF_NODE *ref_node_ptr, REF_MPI ref_mpi,
   for (node = 0; node < max; node++)
     ref_node_age(ref_node, node) = ref_node_age(original, node);
 
+  ref_node_sweep(ref_node) = ref_node_sweep(original);
+  ref_malloc(ref_node->touched, max, REF_INT);
+  for (node = 0; node < max; node++)
+    ref_node->touched[node] = original->touched[node];
+
   ref_malloc(ref_node->real, REF_NODE_REAL_PER * max, REF_DBL);
   for (node = 0; node < max; node++)
     for (i = 0; i < REF_NODE_REAL_PER; i++)
       ref_node_real(ref_node, i, node) = ref_node_real(original, i, node);
+  ref_malloc_init(ref_node->metric_det, max, REF_DBL, -1.0);
 
   ref_node_naux(ref_node) = ref_node_naux(original);
   ref_node->aux = NULL;
@@ -197,9 +208,14 @@ REF_FCN REF_STATUS ref_node_pack(REF_NODE ref_node, REF_INT *o2n,
   for (node = 0; node < ref_node_n(ref_node); node++)
     ref_node->age[node] = copy->age[n2o[node]];
 
+  for (node = 0; node < ref_node_n(ref_node); node++)
+    ref_node->touched[node] = copy->touched[n2o[node]];
+
   for (node = 0; node < ref_node_n(ref_node); node++)
     for (i = 0; i < REF_NODE_REAL_PER; i++)
       ref_node_real(ref_node, i, node) = ref_node_real(copy, i, n2o[node]);
+  for (node = 0; node < ref_node_max(ref_node); node++)
+    ref_node_metric_stale(ref_node, node);
 
   if (ref_node_naux(ref_node) > 0) {
     for (node = 0; node < ref_node_n(ref_node); node++)
@@ -301,11 +317,13 @@ REF_FCN static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_GLOB global,
 
     ref_realloc(ref_node->part, ref_node_max(ref_node), REF_INT);
     ref_realloc(ref_node->age, ref_node_max(ref_node), REF_INT);
+    ref_realloc(ref_node->touched, ref_node_max(ref_node), REF_INT);
 
     ref_realloc(ref_node->real,
                 ((unsigned long)REF_NODE_REAL_PER *
                  (unsigned long)ref_node_max(ref_node)),
                 REF_DBL);
+    ref_realloc(ref_node->metric_det, ref_node_max(ref_node), REF_DBL);
 
     if (ref_node_naux(ref_node) > 0)
       ref_realloc(ref_node->aux,
@@ -321,6 +339,7 @@ REF_FCN static REF_STATUS ref_node_add_core(REF_NODE ref_node, REF_GLOB global,
   ref_node->part[*node] =
       ref_mpi_rank(ref_node_mpi(ref_node)); /*local default*/
   ref_node->age[*node] = 0;                 /* default new born */
+  ref_node_touch(ref_node, *node);
 
   RSS(ref_node_metric_form(ref_node, *node, 1, 0, 0, 1, 0, 1), "set ident");
 
@@ -896,8 +915,12 @@ REF_FCN REF_STATUS ref_node_compact(REF_NODE ref_node, REF_INT **o2n_ptr,
 }
 
 REF_FCN REF_STATUS ref_node_ghost_real(REF_NODE ref_node) {
+  REF_INT node;
   RSS(ref_node_ghost_dbl(ref_node, ref_node->real, REF_NODE_REAL_PER),
       "ghost dbl");
+  each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_owned(ref_node, node)) ref_node_metric_stale(ref_node, node);
+  }
   if (ref_node_naux(ref_node) > 0)
     RSS(ref_node_ghost_dbl(ref_node, ref_node->aux, ref_node_naux(ref_node)),
         "ghost dbl");
@@ -1313,6 +1336,8 @@ REF_FCN REF_STATUS ref_node_metric_set(REF_NODE ref_node, REF_INT node,
   for (i = 0; i < 6; i++) {
     ((ref_node)->real[(i + 9) + REF_NODE_REAL_PER * (node)]) = log_m[i];
   }
+  ref_node_metric_stale(ref_node, node);
+  ref_node_touch(ref_node, node);
   return REF_SUCCESS;
 }
 
@@ -1325,6 +1350,29 @@ REF_FCN REF_STATUS ref_node_metric_get(REF_NODE ref_node, REF_INT node,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_node_metric_set_many(REF_NODE ref_node, REF_INT n,
+                                            REF_INT *nodes, REF_DBL *m) {
+  REF_INT i, lane, node;
+  REF_DBL log_m[6 * REF_MATRIX_LANES];
+  REF_INT first, lanes;
+  for (first = 0; first < n; first += REF_MATRIX_LANES) {
+    lanes = MIN(REF_MATRIX_LANES, n - first);
+    RSS(ref_matrix_log_m_many(lanes, &(m[6 * first]), log_m), "log");
+    for (lane = 0; lane < lanes; lane++) {
+      node = nodes[first + lane];
+      for (i = 0; i < 6; i++) {
+        ((ref_node)->real[(i + 3) + REF_NODE_REAL_PER * (node)]) =
+            m[i + 6 * (first + lane)];
+        ((ref_node)->real[(i + 9) + REF_NODE_REAL_PER * (node)]) =
+            log_m[i + 6 * lane];
+      }
+      ref_node_metric_stale(ref_node, node);
+      ref_node_touch(ref_node, node);
+    }
+  }
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_node_metric_set_log(REF_NODE ref_node, REF_INT node,
                                            REF_DBL *log_m) {
   REF_INT i;
@@ -1336,6 +1384,19 @@ REF_FCN REF_STATUS ref_node_metric_set_log(REF_NODE ref_node, REF_INT node,
   for (i = 0; i < 6; i++) {
     ((ref_node)->real[(i + 3) + REF_NODE_REAL_PER * (node)]) = m[i];
   }
+  ref_node_metric_stale(ref_node, node);
+  ref_node_touch(ref_node, node);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_node_metric_det(REF_NODE ref_node, REF_INT node,
+                                       REF_DBL *det) {
+  REF_DBL m[6];
+  if (ref_node->metric_det[node] < 0.0) {
+    RSS(ref_node_metric_get(ref_node, node, m), "get");
+    RSS(ref_matrix_det_m(m, &(ref_node->metric_det[node])), "det");
+  }
+  *det = ref_node->metric_det[node];
   return REF_SUCCESS;
 }
 
@@ -1452,6 +1513,130 @@ REF_FCN REF_STATUS ref_node_ratio(REF_NODE ref_node, REF_INT node0,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_node_ratio_batch(REF_NODE ref_node, REF_INT n,
+                                        REF_INT *e2n, REF_DBL *ratio) {
+  REF_DBL d[3][REF_NODE_RATIO_LANES], len[REF_NODE_RATIO_LANES];
+  REF_DBL m0[6][REF_NODE_RATIO_LANES], m1[6][REF_NODE_RATIO_LANES];
+  REF_DBL r0[REF_NODE_RATIO_LANES], r1[REF_NODE_RATIO_LANES];
+  REF_DBL r, r_min, r_max;
+  REF_INT first, lanes, lane, i, node0, node1;
+
+  for (first = 0; first < n; first += REF_NODE_RATIO_LANES) {
+    lanes = MIN(REF_NODE_RATIO_LANES, n - first);
+
+    /* gather, idle lanes repeat the last edge */
+    for (lane = 0; lane < REF_NODE_RATIO_LANES; lane++) {
+      node0 = e2n[0 + 2 * (first + MIN(lane, lanes - 1))];
+      node1 = e2n[1 + 2 * (first + MIN(lane, lanes - 1))];
+      if (!ref_node_valid(ref_node, node0) || !ref_node_valid(ref_node, node1))
+        RSS(REF_INVALID, "node invalid");
+      for (i = 0; i < 3; i++)
+        d[i][lane] = ref_node_xyz(ref_node, i, node1) -
+                     ref_node_xyz(ref_node, i, node0);
+      for (i = 0; i < 6; i++) {
+        m0[i][lane] = ref_node->real[(i + 3) + REF_NODE_REAL_PER * node0];
+        m1[i][lane] = ref_node->real[(i + 3) + REF_NODE_REAL_PER * node1];
+      }
+    }
+
+    /* straight line over lanes, same operation order as ref_node_ratio */
+    for (lane = 0; lane < REF_NODE_RATIO_LANES; lane++) {
+      len[lane] = sqrt(d[0][lane] * d[0][lane] + d[1][lane] * d[1][lane] +
+                       d[2][lane] * d[2][lane]);
+      r0[lane] = sqrt(d[0][lane] * (m0[0][lane] * d[0][lane] +
+                                    m0[1][lane] * d[1][lane] +
+                                    m0[2][lane] * d[2][lane]) +
+                      d[1][lane] * (m0[1][lane] * d[0][lane] +
+                                    m0[3][lane] * d[1][lane] +
+                                    m0[4][lane] * d[2][lane]) +
+                      d[2][lane] * (m0[2][lane] * d[0][lane] +
+                                    m0[4][lane] * d[1][lane] +
+                                    m0[5][lane] * d[2][lane]));
+      r1[lane] = sqrt(d[0][lane] * (m1[0][lane] * d[0][lane] +
+                                    m1[1][lane] * d[1][lane] +
+                                    m1[2][lane] * d[2][lane]) +
+                      d[1][lane] * (m1[1][lane] * d[0][lane] +
+                                    m1[3][lane] * d[1][lane] +
+                                    m1[4][lane] * d[2][lane]) +
+                      d[2][lane] * (m1[2][lane] * d[0][lane] +
+                                    m1[4][lane] * d[1][lane] +
+                                    m1[5][lane] * d[2][lane]));
+    }
+
+    for (lane = 0; lane < lanes; lane++) {
+      if (!ref_math_divisible(d[0][lane], len[lane]) ||
+          !ref_math_divisible(d[1][lane], len[lane]) ||
+          !ref_math_divisible(d[2][lane], len[lane])) {
+        ratio[first + lane] = 0.0;
+        continue;
+      }
+      if (REF_NODE_RATIO_QUADRATURE == ref_node->ratio_method) {
+        RSS(ref_node_ratio_log_quadrature(ref_node, e2n[0 + 2 * (first + lane)],
+                                          e2n[1 + 2 * (first + lane)],
+                                          &(ratio[first + lane])),
+            "ratio");
+        continue;
+      }
+      if (r0[lane] < 1.0e-12 || r1[lane] < 1.0e-12) {
+        ratio[first + lane] = MIN(r0[lane], r1[lane]);
+        continue;
+      }
+      r_min = MIN(r0[lane], r1[lane]);
+      r_max = MAX(r0[lane], r1[lane]);
+      r = r_min / r_max;
+      if (ABS(r - 1.0) < 1.0e-12) {
+        ratio[first + lane] = 0.5 * (r0[lane] + r1[lane]);
+        continue;
+      }
+      ratio[first + lane] = r_min * (r - 1.0) / (r * log(r));
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_node_ratio_active(REF_NODE ref_node, REF_INT n,
+                                         REF_INT *e2n, REF_DBL in_range,
+                                         REF_DBL *ratio) {
+  REF_INT *active_e2n;
+  REF_DBL *active_ratio;
+  REF_INT i, nactive;
+
+  /* sweep never advanced, every node is active */
+  if (0 == ref_node_sweep(ref_node)) {
+    RSS(ref_node_ratio_batch(ref_node, n, e2n, ratio), "ratio");
+    return REF_SUCCESS;
+  }
+
+  ref_malloc(active_e2n, 2 * n, REF_INT);
+  nactive = 0;
+  for (i = 0; i < n; i++) {
+    if (!ref_node_active(ref_node, e2n[0 + 2 * i]) &&
+        !ref_node_active(ref_node, e2n[1 + 2 * i]))
+      continue;
+    active_e2n[0 + 2 * nactive] = e2n[0 + 2 * i];
+    active_e2n[1 + 2 * nactive] = e2n[1 + 2 * i];
+    nactive++;
+  }
+  ref_malloc(active_ratio, nactive, REF_DBL);
+  RSS(ref_node_ratio_batch(ref_node, nactive, active_e2n, active_ratio),
+      "ratio");
+  nactive = 0;
+  for (i = 0; i < n; i++) {
+    if (!ref_node_active(ref_node, e2n[0 + 2 * i]) &&
+        !ref_node_active(ref_node, e2n[1 + 2 * i])) {
+      ratio[i] = in_range;
+      continue;
+    }
+    ratio[i] = active_ratio[nactive];
+    nactive++;
+  }
+  ref_free(active_ratio);
+  ref_free(active_e2n);
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_node_dratio_dnode0_quadrature(REF_NODE ref_node,
                                                             REF_INT node0,
                                                             REF_INT node1,
@@ -1651,7 +1836,6 @@ REF_FCN static REF_STATUS ref_node_tet_epic_quality(REF_NODE ref_node,
   REF_DBL det, min_det, volume;
   REF_DBL volume_in_metric;
   REF_DBL num, denom;
-  REF_DBL m[6];
 
   RSS(ref_node_tet_vol(ref_node, nodes, &volume), "vol");
 
@@ -1667,20 +1851,16 @@ REF_FCN static REF_STATUS ref_node_tet_epic_quality(REF_NODE ref_node,
   RSS(ref_node_ratio(ref_node, nodes[1], nodes[3], &l4), "l4");
   RSS(ref_node_ratio(ref_node, nodes[2], nodes[3], &l5), "l5");
 
-  RSS(ref_node_metric_get(ref_node, nodes[0], m), "nodes[0] m");
-  RSS(ref_matrix_det_m(m, &det), "n0");
+  RSS(ref_node_metric_det(ref_node, nodes[0], &det), "n0");
   min_det = det;
 
-  RSS(ref_node_metric_get(ref_node, nodes[1], m), "nodes[1] m");
-  RSS(ref_matrix_det_m(m, &det), "n1");
+  RSS(ref_node_metric_det(ref_node, nodes[1], &det), "n1");
   min_det = MIN(min_det, det);
 
-  RSS(ref_node_metric_get(ref_node, nodes[2], m), "nodes[2] m");
-  RSS(ref_matrix_det_m(m, &det), "n2");
+  RSS(ref_node_metric_det(ref_node, nodes[2], &det), "n2");
   min_det = MIN(min_det, det);
 
-  RSS(ref_node_metric_get(ref_node, nodes[3], m), "nodes[3] m");
-  RSS(ref_matrix_det_m(m, &det), "n3");
+  RSS(ref_node_metric_det(ref_node, nodes[3], &det), "n3");
   min_det = MIN(min_det, det);
 
   volume_in_metric = sqrt(min_det) * volume;
@@ -1710,7 +1890,6 @@ REF_FCN static REF_STATUS ref_node_tet_epic_dquality_dnode0(
   REF_DBL num, denom;
   REF_DBL d_num[3], d_denom[3];
   REF_INT i;
-  REF_DBL m[6];
 
   RSS(ref_node_dratio_dnode0(ref_node, nodes[0], nodes[1], &l0, d_l0), "l0");
   RSS(ref_node_dratio_dnode0(ref_node, nodes[0], nodes[2], &l1, d_l1), "l1");
@@ -1727,20 +1906,16 @@ REF_FCN static REF_STATUS ref_node_tet_epic_dquality_dnode0(
     return REF_SUCCESS;
   }
 
-  RSS(ref_node_metric_get(ref_node, nodes[0], m), "nodes[0] m");
-  RSS(ref_matrix_det_m(m, &det), "n0");
+  RSS(ref_node_metric_det(ref_node, nodes[0], &det), "n0");
   min_det = det;
 
-  RSS(ref_node_metric_get(ref_node, nodes[1], m), "nodes[1] m");
-  RSS(ref_matrix_det_m(m, &det), "n1");
+  RSS(ref_node_metric_det(ref_node, nodes[1], &det), "n1");
   min_det = MIN(min_det, det);
 
-  RSS(ref_node_metric_get(ref_node, nodes[2], m), "nodes[2] m");
-  RSS(ref_matrix_det_m(m, &det), "n2");
+  RSS(ref_node_metric_det(ref_node, nodes[2], &det), "n2");
   min_det = MIN(min_det, det);
 
-  RSS(ref_node_metric_get(ref_node, nodes[3], m), "nodes[3] m");
-  RSS(ref_matrix_det_m(m, &det), "n3");
+  RSS(ref_node_metric_det(ref_node, nodes[3], &det), "n3");
   min_det = MIN(min_det, det);
 
   volume_in_metric = sqrt(min_det) * volume;
@@ -1775,7 +1950,7 @@ REF_FCN static REF_STATUS ref_node_tet_jac_dquality_dnode0(REF_NODE ref_node,
                                                            REF_DBL *quality,
                                                            REF_DBL *d_quality) {
   REF_DBL mlog0[6], mlog1[6], mlog2[6], mlog3[6];
-  REF_DBL mlog[6], m[6], jac[9];
+  REF_DBL mlog[6], m[6];
   REF_DBL e0[3], e1[3], e2[3], e3[3], e4[3], e5[3];
   REF_INT i;
 
@@ -1798,7 +1973,6 @@ REF_FCN static REF_STATUS ref_node_tet_jac_dquality_dnode0(REF_NODE ref_node,
   for (i = 0; i < 6; i++)
     mlog[i] = (mlog0[i] + mlog1[i] + mlog2[i] + mlog3[i]) / 4.0;
   RSS(ref_matrix_exp_m(mlog, m), "exp");
-  RSS(ref_matrix_jacob_m(m, jac), "jac");
 
   for (i = 0; i < 3; i++)
     e0[i] = ref_node_xyz(ref_node, i, nodes[1]) -
@@ -1886,7 +2060,7 @@ REF_FCN static REF_STATUS ref_node_tet_jac_quality(REF_NODE ref_node,
                                                    REF_INT *nodes,
                                                    REF_DBL *quality) {
   REF_DBL mlog0[6], mlog1[6], mlog2[6], mlog3[6];
-  REF_DBL mlog[6], m[6], jac[9];
+  REF_DBL mlog[6], m[6];
   REF_DBL e0[3], e1[3], e2[3], e3[3], e4[3], e5[3];
   REF_INT i;
 
@@ -1905,7 +2079,6 @@ REF_FCN static REF_STATUS ref_node_tet_jac_quality(REF_NODE ref_node,
   for (i = 0; i < 6; i++)
     mlog[i] = (mlog0[i] + mlog1[i] + mlog2[i] + mlog3[i]) / 4.0;
   RSS(ref_matrix_exp_m(mlog, m), "exp");
-  RSS(ref_matrix_jacob_m(m, jac), "jac");
 
   for (i = 0; i < 3; i++)
     e0[i] = ref_node_xyz(ref_node, i, nodes[1]) -
@@ -1969,7 +2142,6 @@ REF_FCN static REF_STATUS ref_node_tri_epic_quality(REF_NODE ref_node,
   REF_DBL det, min_det, area;
   REF_DBL area_in_metric;
   REF_DBL num, denom;
-  REF_DBL m[6];
 
   RSS(ref_node_ratio(ref_node, nodes[0], nodes[1], &l0), "l0");
   RSS(ref_node_ratio(ref_node, nodes[0], nodes[2], &l1), "l1");
@@ -1977,16 +2149,13 @@ REF_FCN static REF_STATUS ref_node_tri_epic_quality(REF_NODE ref_node,
 
   RSS(ref_node_tri_area(ref_node, nodes, &area), "area");
 
-  RSS(ref_node_metric_get(ref_node, nodes[0], m), "nodes[0] m");
-  RSS(ref_matrix_det_m(m, &det), "n0");
+  RSS(ref_node_metric_det(ref_node, nodes[0], &det), "n0");
   min_det = det;
 
-  RSS(ref_node_metric_get(ref_node, nodes[1], m), "nodes[1] m");
-  RSS(ref_matrix_det_m(m, &det), "n1");
+  RSS(ref_node_metric_det(ref_node, nodes[1], &det), "n1");
   min_det = MIN(min_det, det);
 
-  RSS(ref_node_metric_get(ref_node, nodes[2], m), "nodes[2] m");
-  RSS(ref_matrix_det_m(m, &det), "n2");
+  RSS(ref_node_metric_det(ref_node, nodes[2], &det), "n2");
   min_det = MIN(min_det, det);
 
   area_in_metric = pow(min_det, 1.0 / 3.0) * area;
@@ -2062,6 +2231,243 @@ REF_FCN REF_STATUS ref_node_tri_quality(REF_NODE ref_node, REF_INT *nodes,
   return REF_SUCCESS;
 }
 
+/* ref_node_tet_jac_quality for packed lanes with known volumes, the
+ * jacobian of the mean metric is not needed for the quality */
+REF_FCN static REF_STATUS ref_node_tet_jac_quality_lanes(
+    REF_NODE ref_node, REF_INT lanes, REF_INT *cells, REF_INT *c2n,
+    REF_INT size_per, REF_DBL *vol, REF_DBL *quality) {
+  REF_INT tet_e2n[6][2] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}};
+  REF_DBL m[6][REF_NODE_RATIO_LANES], det[REF_NODE_RATIO_LANES];
+  REF_DBL l2[REF_NODE_RATIO_LANES], e[3][REF_NODE_RATIO_LANES];
+  REF_DBL mlog[6], mavg[6], num;
+  REF_INT lane, i, edge;
+  REF_INT *nodes;
+
+  /* tail lanes stay zero so the l2 sum runs over every lane */
+  for (lane = 0; lane < REF_NODE_RATIO_LANES; lane++) {
+    for (i = 0; i < 6; i++) m[i][lane] = 0.0;
+    for (i = 0; i < 3; i++) e[i][lane] = 0.0;
+    det[lane] = 0.0;
+    l2[lane] = 0.0;
+  }
+  for (lane = 0; lane < lanes; lane++) {
+    if (vol[lane] <= ref_node_min_volume(ref_node)) continue;
+    nodes = &(c2n[size_per * cells[lane]]);
+    for (i = 0; i < 6; i++)
+      mlog[i] = (ref_node->real[(i + 9) + REF_NODE_REAL_PER * nodes[0]] +
+                 ref_node->real[(i + 9) + REF_NODE_REAL_PER * nodes[1]] +
+                 ref_node->real[(i + 9) + REF_NODE_REAL_PER * nodes[2]] +
+                 ref_node->real[(i + 9) + REF_NODE_REAL_PER * nodes[3]]) /
+                4.0;
+    RSS(ref_matrix_exp_m(mlog, mavg), "exp");
+    RSS(ref_matrix_det_m(mavg, &(det[lane])), "det(mavg)");
+    for (i = 0; i < 6; i++) m[i][lane] = mavg[i];
+  }
+
+  /* edge lengths in the mean metric, summed in ref_node_tet_jac_quality
+   * order over straight-line lanes */
+  for (edge = 0; edge < 6; edge++) {
+    for (lane = 0; lane < lanes; lane++) {
+      nodes = &(c2n[size_per * cells[lane]]);
+      for (i = 0; i < 3; i++)
+        e[i][lane] = ref_node_xyz(ref_node, i, nodes[tet_e2n[edge][1]]) -
+                     ref_node_xyz(ref_node, i, nodes[tet_e2n[edge][0]]);
+    }
+    for (lane = 0; lane < REF_NODE_RATIO_LANES; lane++) {
+      l2[lane] += e[0][lane] * (m[0][lane] * e[0][lane] +
+                                m[1][lane] * e[1][lane] +
+                                m[2][lane] * e[2][lane]) +
+                  e[1][lane] * (m[1][lane] * e[0][lane] +
+                                m[3][lane] * e[1][lane] +
+                                m[4][lane] * e[2][lane]) +
+                  e[2][lane] * (m[2][lane] * e[0][lane] +
+                                m[4][lane] * e[1][lane] +
+                                m[5][lane] * e[2][lane]);
+    }
+  }
+
+  for (lane = 0; lane < lanes; lane++) {
+    if (vol[lane] <= ref_node_min_volume(ref_node)) {
+      quality[cells[lane]] = vol[lane] - ref_node_min_volume(ref_node);
+      continue;
+    }
+    num = pow(sqrt(det[lane]) * vol[lane], 2.0 / 3.0);
+    if (ref_math_divisible(num, l2[lane])) {
+      /* 36/3^(1/3) */
+      quality[cells[lane]] = 24.9610058766228 * num / l2[lane];
+    } else {
+      quality[cells[lane]] = -1.0;
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_node_tet_quality_block(REF_NODE ref_node, REF_INT ncell,
+                                              REF_INT *c2n, REF_INT size_per,
+                                              REF_DBL *quality,
+                                              REF_DBL *volume) {
+  REF_INT tet_e2n[6][2] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}};
+  REF_INT cells[REF_NODE_RATIO_LANES];
+  REF_INT e2n[2 * 6 * REF_NODE_RATIO_LANES];
+  REF_DBL ratio[6 * REF_NODE_RATIO_LANES];
+  REF_DBL vol[REF_NODE_RATIO_LANES];
+  REF_DBL *a, *b, *c, *d;
+  REF_DBL det, min_det, num, denom;
+  REF_INT next, lanes, lane, cell, edge, node;
+  REF_INT *nodes;
+
+  next = 0;
+  while (next < ncell) {
+    /* pack the next lanes of valid cells */
+    lanes = 0;
+    while (next < ncell && lanes < REF_NODE_RATIO_LANES) {
+      if (REF_EMPTY != c2n[size_per * next]) {
+        nodes = &(c2n[size_per * next]);
+        for (node = 0; node < 4; node++)
+          if (!ref_node_valid(ref_node, nodes[node]))
+            RSS(REF_INVALID, "node invalid");
+        cells[lanes] = next;
+        lanes++;
+      }
+      next++;
+    }
+    if (0 == lanes) continue;
+
+    /* same operation order as ref_node_tet_vol */
+    for (lane = 0; lane < lanes; lane++) {
+      nodes = &(c2n[size_per * cells[lane]]);
+      a = ref_node_xyz_ptr(ref_node, nodes[0]);
+      b = ref_node_xyz_ptr(ref_node, nodes[1]);
+      c = ref_node_xyz_ptr(ref_node, nodes[2]);
+      d = ref_node_xyz_ptr(ref_node, nodes[3]);
+      vol[lane] =
+          -((a[0] - d[0]) * ((b[1] - d[1]) * (c[2] - d[2]) -
+                             (c[1] - d[1]) * (b[2] - d[2])) -
+            (a[1] - d[1]) * ((b[0] - d[0]) * (c[2] - d[2]) -
+                             (c[0] - d[0]) * (b[2] - d[2])) +
+            (a[2] - d[2]) * ((b[0] - d[0]) * (c[1] - d[1]) -
+                             (c[0] - d[0]) * (b[1] - d[1]))) /
+          6.0;
+    }
+    if (NULL != volume)
+      for (lane = 0; lane < lanes; lane++) volume[cells[lane]] = vol[lane];
+
+    if (REF_NODE_JAC_QUALITY == ref_node->tet_quality) {
+      RSS(ref_node_tet_jac_quality_lanes(ref_node, lanes, cells, c2n, size_per,
+                                         vol, quality),
+          "jac lanes");
+      continue;
+    }
+    if (REF_NODE_EPIC_QUALITY != ref_node->tet_quality)
+      THROW("case not recognized");
+
+    for (lane = 0; lane < lanes; lane++) {
+      nodes = &(c2n[size_per * cells[lane]]);
+      for (edge = 0; edge < 6; edge++) {
+        e2n[0 + 2 * (edge + 6 * lane)] = nodes[tet_e2n[edge][0]];
+        e2n[1 + 2 * (edge + 6 * lane)] = nodes[tet_e2n[edge][1]];
+      }
+    }
+    RSS(ref_node_ratio_batch(ref_node, 6 * lanes, e2n, ratio), "ratios");
+
+    for (lane = 0; lane < lanes; lane++) {
+      cell = cells[lane];
+      if (vol[lane] <= ref_node_min_volume(ref_node)) {
+        quality[cell] = vol[lane] - ref_node_min_volume(ref_node);
+        continue;
+      }
+      nodes = &(c2n[size_per * cell]);
+      min_det = REF_DBL_MAX;
+      for (node = 0; node < 4; node++) {
+        RSS(ref_node_metric_det(ref_node, nodes[node], &det), "det");
+        min_det = (0 == node ? det : MIN(min_det, det));
+      }
+      num = pow(sqrt(min_det) * vol[lane], 2.0 / 3.0);
+      denom = 0.0;
+      for (edge = 0; edge < 6; edge++)
+        denom += ratio[edge + 6 * lane] * ratio[edge + 6 * lane];
+      if (ref_math_divisible(num, denom)) {
+        /* 36/3^(1/3) */
+        quality[cell] = 24.9610058766228 * num / denom;
+      } else {
+        quality[cell] = -1.0;
+      }
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_node_tri_quality_block(REF_NODE ref_node, REF_INT ncell,
+                                              REF_INT *c2n, REF_INT size_per,
+                                              REF_DBL *quality, REF_DBL *area) {
+  REF_INT tri_e2n[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+  REF_INT cells[REF_NODE_RATIO_LANES];
+  REF_INT e2n[2 * 3 * REF_NODE_RATIO_LANES];
+  REF_DBL ratio[3 * REF_NODE_RATIO_LANES];
+  REF_DBL det, min_det, cell_area, num, denom;
+  REF_INT next, lanes, lane, cell, edge, node;
+  REF_INT *nodes;
+
+  next = 0;
+  while (next < ncell) {
+    lanes = 0;
+    while (next < ncell && lanes < REF_NODE_RATIO_LANES) {
+      if (REF_EMPTY != c2n[size_per * next]) {
+        cells[lanes] = next;
+        lanes++;
+      }
+      next++;
+    }
+    if (0 == lanes) continue;
+
+    if (REF_NODE_EPIC_QUALITY != ref_node->tri_quality) {
+      for (lane = 0; lane < lanes; lane++) {
+        nodes = &(c2n[size_per * cells[lane]]);
+        RSS(ref_node_tri_quality(ref_node, nodes, &(quality[cells[lane]])),
+            "cell quality");
+        if (NULL != area)
+          RSS(ref_node_tri_area(ref_node, nodes, &(area[cells[lane]])),
+              "area");
+      }
+      continue;
+    }
+
+    for (lane = 0; lane < lanes; lane++) {
+      nodes = &(c2n[size_per * cells[lane]]);
+      for (edge = 0; edge < 3; edge++) {
+        e2n[0 + 2 * (edge + 3 * lane)] = nodes[tri_e2n[edge][0]];
+        e2n[1 + 2 * (edge + 3 * lane)] = nodes[tri_e2n[edge][1]];
+      }
+    }
+    RSS(ref_node_ratio_batch(ref_node, 3 * lanes, e2n, ratio), "ratios");
+
+    for (lane = 0; lane < lanes; lane++) {
+      cell = cells[lane];
+      nodes = &(c2n[size_per * cell]);
+      RSS(ref_node_tri_area(ref_node, nodes, &cell_area), "area");
+      if (NULL != area) area[cell] = cell_area;
+      min_det = REF_DBL_MAX;
+      for (node = 0; node < 3; node++) {
+        RSS(ref_node_metric_det(ref_node, nodes[node], &det), "det");
+        min_det = (0 == node ? det : MIN(min_det, det));
+      }
+      num = pow(min_det, 1.0 / 3.0) * cell_area;
+      denom = ratio[0 + 3 * lane] * ratio[0 + 3 * lane] +
+              ratio[1 + 3 * lane] * ratio[1 + 3 * lane] +
+              ratio[2 + 3 * lane] * ratio[2 + 3 * lane];
+      if (ref_math_divisible(num, denom)) {
+        quality[cell] = 4.0 / sqrt(3.0) * 3 * num / denom;
+      } else {
+        quality[cell] = -1.0;
+      }
+    }
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_node_tri_epic_dquality_dnode0(
     REF_NODE ref_node, REF_INT *nodes, REF_DBL *quality, REF_DBL *d_quality) {
   REF_DBL l0, l1, l2;
@@ -2071,7 +2477,6 @@ REF_FCN static REF_STATUS ref_node_tri_epic_dquality_dnode0(
   REF_DBL num, d_num[3], denom, d_denom[3];
   REF_DBL d_l0[3], d_l1[3];
   REF_INT i;
-  REF_DBL m[6];
 
   RSS(ref_node_dratio_dnode0(ref_node, nodes[0], nodes[1], &l0, d_l0), "l0");
   RSS(ref_node_dratio_dnode0(ref_node, nodes[0], nodes[2], &l1, d_l1), "l1");
@@ -2079,16 +2484,13 @@ REF_FCN static REF_STATUS ref_node_tri_epic_dquality_dnode0(
 
   RSS(ref_node_tri_darea_dnode0(ref_node, nodes, &area, d_area), "area");
 
-  RSS(ref_node_metric_get(ref_node, nodes[0], m), "nodes[0] m");
-  RSS(ref_matrix_det_m(m, &det), "n0");
+  RSS(ref_node_metric_det(ref_node, nodes[0], &det), "n0");
   min_det = det;
 
-  RSS(ref_node_metric_get(ref_node, nodes[1], m), "nodes[1] m");
-  RSS(ref_matrix_det_m(m, &det), "n1");
+  RSS(ref_node_metric_det(ref_node, nodes[1], &det), "n1");
   min_det = MIN(min_det, det);
 
-  RSS(ref_node_metric_get(ref_node, nodes[2], m), "nodes[2] m");
-  RSS(ref_matrix_det_m(m, &det), "n2");
+  RSS(ref_node_metric_det(ref_node, nodes[2], &det), "n2");
   min_det = MIN(min_det, det);
 
   area_in_metric = pow(min_det, 1.0 / 3.0) * area;
@@ -39,7 +39,10 @@ struct REF_NODE_STRUCT {
   REF_INT *sorted_local;
   REF_INT *part;
   REF_INT *age;
+  REF_INT sweep;
+  REF_INT *touched; /* sweep of the last change near each node */
   REF_DBL *real;
+  REF_DBL *metric_det; /* cached det(m), negative when stale */
   REF_INT naux;
   REF_DBL *aux;
   REF_MPI ref_mpi;
@@ -62,6 +65,11 @@ struct REF_NODE_STRUCT {
 #define REF_NODE_RATIO_GEOMETRIC (1)
 #define REF_NODE_RATIO_QUADRATURE (2)
 
+/* edges evaluated together by ref_node_ratio_batch */
+#define REF_NODE_RATIO_LANES (8)
+/* cells screened together by sweeps that modify the grid as they go */
+#define REF_NODE_QUALITY_BLOCK (64)
+
 #define ref_node_n(ref_node) ((ref_node)->n)
 #define ref_node_max(ref_node) ((ref_node)->max)
 
@@ -88,6 +96,9 @@ struct REF_NODE_STRUCT {
 
 #define ref_node_real(ref_node, ireal, node) \
   ((ref_node)->real[(ireal) + REF_NODE_REAL_PER * (node)])
+/* required after writing the metric with ref_node_real */
+#define ref_node_metric_stale(ref_node, node) \
+  ((ref_node)->metric_det[(node)] = -1.0)
 
 #define ref_node_owned(ref_node, node) \
   (ref_mpi_rank(ref_node_mpi(ref_node)) == ref_node_part(ref_node, node))
@@ -95,6 +106,15 @@ struct REF_NODE_STRUCT {
 #define ref_node_part(ref_node, node) ((ref_node)->part[(node)])
 #define ref_node_age(ref_node, node) ((ref_node)->age[(node)])
 
+/* nodes changed during this or the previous sweep form the active set,
+ * ghost nodes are always active because their changes are not seen */
+#define ref_node_sweep(ref_node) ((ref_node)->sweep)
+#define ref_node_touch(ref_node, node) \
+  ((ref_node)->touched[(node)] = ref_node_sweep(ref_node))
+#define ref_node_active(ref_node, node)   \
+  (!ref_node_owned(ref_node, node) ||     \
+   (ref_node)->touched[(node)] + 1 >= ref_node_sweep(ref_node))
+
 #define ref_node_naux(ref_node) ((ref_node)->naux)
 #define ref_node_aux(ref_node, iaux, node) \
   ((ref_node)->aux[(iaux) + ref_node_naux(ref_node) * (node)])
@@ -186,13 +206,29 @@ REF_FCN REF_STATUS ref_node_metric_set(REF_NODE ref_node, REF_INT node,
                                        REF_DBL *m);
 REF_FCN REF_STATUS ref_node_metric_get(REF_NODE ref_node, REF_INT node,
                                        REF_DBL *m);
+/* m[6*i] is the metric of nodes[i], logs from batched diagonalization */
+REF_FCN REF_STATUS ref_node_metric_set_many(REF_NODE ref_node, REF_INT n,
+                                            REF_INT *nodes, REF_DBL *m);
 REF_FCN REF_STATUS ref_node_metric_set_log(REF_NODE ref_node, REF_INT node,
                                            REF_DBL *log_m);
+/* det(m) computed once per metric change, reused by quality evaluation */
+REF_FCN REF_STATUS ref_node_metric_det(REF_NODE ref_node, REF_INT node,
+                                       REF_DBL *det);
 REF_FCN REF_STATUS ref_node_metric_get_log(REF_NODE ref_node, REF_INT node,
                                            REF_DBL *log_m);
 
 REF_FCN REF_STATUS ref_node_ratio(REF_NODE ref_node, REF_INT node0,
                                   REF_INT node1, REF_DBL *ratio);
+/* ref_node_ratio of n edges with nodes e2n[0+2*i] and e2n[1+2*i], same
+ * operation order so results are bitwise equal unless the compiler is
+ * allowed to reassociate (-ffast-math), then they agree to 1e-12 */
+REF_FCN REF_STATUS ref_node_ratio_batch(REF_NODE ref_node, REF_INT n,
+                                        REF_INT *e2n, REF_DBL *ratio);
+/* ref_node_ratio_batch of edges with an active node, the others are given
+ * the ratio in_range because they were within limits when last screened */
+REF_FCN REF_STATUS ref_node_ratio_active(REF_NODE ref_node, REF_INT n,
+                                         REF_INT *e2n, REF_DBL in_range,
+                                         REF_DBL *ratio);
 REF_FCN REF_STATUS ref_node_dratio_dnode0(REF_NODE ref_node, REF_INT node0,
                                           REF_INT node1, REF_DBL *ratio,
                                           REF_DBL *dratio_dnode0);
@@ -222,6 +258,11 @@ REF_FCN REF_STATUS ref_node_tri_darea_dnode0(REF_NODE ref_node, REF_INT *nodes,
 
 REF_FCN REF_STATUS ref_node_tri_quality(REF_NODE ref_node, REF_INT *nodes,
                                         REF_DBL *quality);
+/* quality and area (may be NULL) of ncell tris stored size_per apart in c2n,
+ * cells with c2n[0] of REF_EMPTY are skipped and their outputs untouched */
+REF_FCN REF_STATUS ref_node_tri_quality_block(REF_NODE ref_node, REF_INT ncell,
+                                              REF_INT *c2n, REF_INT size_per,
+                                              REF_DBL *quality, REF_DBL *area);
 REF_FCN REF_STATUS ref_node_tri_dquality_dnode0(REF_NODE ref_node,
                                                 REF_INT *nodes,
                                                 REF_DBL *quality,
@@ -241,6 +282,13 @@ REF_FCN REF_STATUS ref_node_tri_seg_intersection(REF_NODE ref_node,
                                                  REF_DBL *t, REF_DBL *uvw);
 REF_FCN REF_STATUS ref_node_tet_quality(REF_NODE ref_node, REF_INT *nodes,
                                         REF_DBL *quality);
+/* quality and volume (may be NULL) of ncell tets stored size_per apart in
+ * c2n, equal to ref_node_tet_quality and ref_node_tet_vol per cell,
+ * cells with c2n[0] of REF_EMPTY are skipped and their outputs untouched */
+REF_FCN REF_STATUS ref_node_tet_quality_block(REF_NODE ref_node, REF_INT ncell,
+                                              REF_INT *c2n, REF_INT size_per,
+                                              REF_DBL *quality,
+                                              REF_DBL *volume);
 REF_FCN REF_STATUS ref_node_tet_dquality_dnode0(REF_NODE ref_node,
                                                 REF_INT *nodes,
                                                 REF_DBL *quality,
@@ -23,7 +23,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
+#include "ref_cell.h"
+#include "ref_fixture.h"
+#include "ref_grid.h"
 #include "ref_list.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
@@ -36,6 +40,60 @@ int main(int argc, char *argv[]) {
   RSS(ref_mpi_start(argc, argv), "start");
   RSS(ref_mpi_create(&ref_mpi), "make mpi");
 
+  if (3 == argc && 0 == strcmp("--benchmark", argv[1])) {
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_CELL ref_cell;
+    REF_INT n = atoi(argv[2]);
+    REF_INT cell, nodes[REF_CELL_MAX_SIZE_PER], repeat, nrepeat = 10;
+    REF_DBL *quality, total;
+    clock_t tic;
+    REF_DBL scalar_seconds, block_seconds;
+#if defined(__AVX512F__)
+    const char *isa = "avx512";
+#elif defined(__AVX2__)
+    const char *isa = "avx2";
+#else
+    const char *isa = "baseline";
+#endif
+    RSS(ref_fixture_tet_brick_args_grid(&ref_grid, ref_mpi, 0, 1, 0, 1, 0, 1,
+                                        n, n, n),
+        "brick");
+    ref_node = ref_grid_node(ref_grid);
+    ref_cell = ref_grid_tet(ref_grid);
+    ref_malloc(quality, ref_cell_max(ref_cell), REF_DBL);
+    total = 0.0;
+    tic = clock();
+    for (repeat = 0; repeat < nrepeat; repeat++) {
+      each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
+        RSS(ref_node_tet_quality(ref_node, nodes, &(quality[cell])), "qual");
+        total += quality[cell];
+      }
+    }
+    scalar_seconds = (REF_DBL)(clock() - tic) / ((REF_DBL)CLOCKS_PER_SEC);
+    tic = clock();
+    for (repeat = 0; repeat < nrepeat; repeat++) {
+      RSS(ref_node_tet_quality_block(ref_node, ref_cell_max(ref_cell),
+                                     &(ref_cell_c2n(ref_cell, 0, 0)),
+                                     ref_cell_size_per(ref_cell), quality,
+                                     NULL),
+          "block");
+      each_ref_cell_valid_cell(ref_cell, cell) { total -= quality[cell]; }
+    }
+    block_seconds = (REF_DBL)(clock() - tic) / ((REF_DBL)CLOCKS_PER_SEC);
+    scalar_seconds = MAX(scalar_seconds, 1e-9);
+    block_seconds = MAX(block_seconds, 1e-9);
+    printf("%s %d tets scalar %.3e cells/s block %.3e cells/s (%.1e)\n", isa,
+           ref_cell_n(ref_cell),
+           (REF_DBL)(nrepeat * ref_cell_n(ref_cell)) / scalar_seconds,
+           (REF_DBL)(nrepeat * ref_cell_n(ref_cell)) / block_seconds, total);
+    ref_free(quality);
+    RSS(ref_grid_free(ref_grid), "free");
+    RSS(ref_mpi_free(ref_mpi), "free");
+    RSS(ref_mpi_stop(), "stop");
+    return 0;
+  }
+
   REIS(REF_NULL, ref_node_free(NULL), "dont free NULL");
 
   { /* init */
@@ -706,6 +764,58 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  { /* cached metric det refreshed by set */
+    REF_NODE ref_node;
+    REF_INT node;
+    REF_DBL m[6] = {2.0, 0.1, 0.0, 3.0, 0.2, 5.0};
+    REF_DBL det, expected;
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    RSS(ref_node_add(ref_node, 0, &node), "add");
+    RSS(ref_node_metric_det(ref_node, node, &det), "det");
+    RWDS(1.0, det, -1.0, "identity det");
+    RSS(ref_node_metric_set(ref_node, node, m), "set");
+    RSS(ref_node_metric_det(ref_node, node, &det), "det");
+    RSS(ref_matrix_det_m(m, &expected), "det m");
+    RWDS(expected, det, -1.0, "set det");
+    m[0] = 4.0;
+    RSS(ref_node_metric_set_many(ref_node, 1, &node, m), "set many");
+    RSS(ref_node_metric_det(ref_node, node, &det), "det");
+    RSS(ref_matrix_det_m(m, &expected), "det m");
+    RWDS(expected, det, -1.0, "set many det");
+    RSS(ref_node_free(ref_node), "free");
+  }
+
+  { /* set many matches set */
+    REF_NODE ref_node;
+    REF_INT global, node, nodes[11], i, j;
+    REF_DBL m[6 * 11], m1[6], log0[6], log1[6];
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    for (i = 0; i < 11; i++) {
+      global = 11 - i;
+      RSS(ref_node_add(ref_node, global, &(nodes[i])), "add");
+      m[0 + 6 * i] = 10.0 + (REF_DBL)i;
+      m[1 + 6 * i] = -1.0;
+      m[2 + 6 * i] = 0.5 * (REF_DBL)i;
+      m[3 + 6 * i] = 20.0;
+      m[4 + 6 * i] = 2.0;
+      m[5 + 6 * i] = 1.0 / (1.0 + (REF_DBL)i);
+    }
+    RSS(ref_node_metric_set_many(ref_node, 11, nodes, m), "set many");
+    for (i = 0; i < 11; i++) {
+      node = nodes[i];
+      RSS(ref_node_metric_get(ref_node, node, m1), "get");
+      RSS(ref_node_metric_get_log(ref_node, node, log1), "get log");
+      RSS(ref_node_metric_set(ref_node, node, &(m[6 * i])), "set");
+      RSS(ref_node_metric_get_log(ref_node, node, log0), "get log");
+      for (j = 0; j < 6; j++) {
+        RWDS(m[j + 6 * i], m1[j], -1.0, "m");
+        RWDS(log0[j], log1[j], -1.0, "log m");
+      }
+    }
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
   { /* geometric distance in zero metric */
     REF_NODE ref_node;
     REF_INT node0, node1, global;
@@ -791,6 +901,132 @@ int main(int argc, char *argv[]) {
     RSS(ref_node_free(ref_node), "free");
   }
 
+  { /* block quality matches cell by cell */
+    REF_NODE ref_node;
+    REF_INT node, global, cell, ncell = 11, method;
+    REF_INT c2n[5 * 11];
+    REF_DBL quality[11], volume[11], expected, h;
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    for (global = 0; global < 8; global++) {
+      RSS(ref_node_add(ref_node, global, &node), "add");
+      ref_node_xyz(ref_node, 0, node) = (REF_DBL)(global % 2) + 0.01 * global;
+      ref_node_xyz(ref_node, 1, node) = (REF_DBL)((global / 2) % 2);
+      ref_node_xyz(ref_node, 2, node) = (REF_DBL)(global / 4) - 0.02 * global;
+      h = 0.1 + 0.05 * (REF_DBL)global;
+      RSS(ref_node_metric_form(ref_node, node, 1.0 / (h * h), 0, 0.1, 4.0, 0,
+                               1.0 / h),
+          "met");
+    }
+    for (cell = 0; cell < ncell; cell++) {
+      c2n[0 + 5 * cell] = cell % 8;
+      c2n[1 + 5 * cell] = (cell + 1) % 8;
+      c2n[2 + 5 * cell] = (cell + 3) % 8;
+      c2n[3 + 5 * cell] = (cell + 4) % 8;
+      c2n[4 + 5 * cell] = 1;
+    }
+    c2n[5 * 4] = REF_EMPTY; /* unused slot */
+    quality[4] = 7.0;
+
+    for (method = REF_NODE_EPIC_QUALITY; method <= REF_NODE_JAC_QUALITY;
+         method++) {
+      ref_node->tet_quality = method;
+      ref_node->tri_quality = method;
+      RSS(ref_node_tet_quality_block(ref_node, ncell, c2n, 5, quality, volume),
+          "tet block");
+      for (cell = 0; cell < ncell; cell++) {
+        if (REF_EMPTY == c2n[5 * cell]) continue;
+        RSS(ref_node_tet_quality(ref_node, &(c2n[5 * cell]), &expected),
+            "qual");
+        RWDS(expected, quality[cell], 1.0e-12, "tet quality differs");
+        RSS(ref_node_tet_vol(ref_node, &(c2n[5 * cell]), &expected), "vol");
+        RWDS(expected, volume[cell], 1.0e-12, "tet volume differs");
+      }
+      RWDS(7.0, quality[4], -1.0, "empty tet touched");
+      RSS(ref_node_tri_quality_block(ref_node, ncell, c2n, 5, quality, NULL),
+          "tri block");
+      for (cell = 0; cell < ncell; cell++) {
+        if (REF_EMPTY == c2n[5 * cell]) continue;
+        RSS(ref_node_tri_quality(ref_node, &(c2n[5 * cell]), &expected),
+            "qual");
+        RWDS(expected, quality[cell], 1.0e-12, "tri quality differs");
+      }
+    }
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
+  { /* batch ratio matches edge by edge */
+    REF_NODE ref_node;
+    REF_INT node, global, edge, nedge = 13, method;
+    REF_INT e2n[26];
+    REF_DBL batch[13], ratio, h;
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    for (global = 0; global < 7; global++) {
+      RSS(ref_node_add(ref_node, global, &node), "add");
+      ref_node_xyz(ref_node, 0, node) = 0.3 * (REF_DBL)(global % 3);
+      ref_node_xyz(ref_node, 1, node) = 0.2 * (REF_DBL)(global % 2);
+      ref_node_xyz(ref_node, 2, node) = 0.1 * (REF_DBL)global;
+      h = 0.05 + 0.1 * (REF_DBL)(global % 4);
+      RSS(ref_node_metric_form(ref_node, node, 1.0 / (h * h), 0.1, 0, 2, 0,
+                               1.0 / h),
+          "met");
+    }
+    ref_node_xyz(ref_node, 0, 6) = ref_node_xyz(ref_node, 0, 5);
+    ref_node_xyz(ref_node, 1, 6) = ref_node_xyz(ref_node, 1, 5);
+    ref_node_xyz(ref_node, 2, 6) = ref_node_xyz(ref_node, 2, 5);
+    for (edge = 0; edge < nedge; edge++) {
+      e2n[0 + 2 * edge] = edge % 7;
+      e2n[1 + 2 * edge] = (3 * edge + 1) % 7;
+    }
+    e2n[0 + 2 * 12] = 5; /* zero length */
+    e2n[1 + 2 * 12] = 6;
+
+    for (method = REF_NODE_RATIO_GEOMETRIC; method <= REF_NODE_RATIO_QUADRATURE;
+         method++) {
+      ref_node->ratio_method = method;
+      RSS(ref_node_ratio_batch(ref_node, nedge, e2n, batch), "batch");
+      for (edge = 0; edge < nedge; edge++) {
+        RSS(ref_node_ratio(ref_node, e2n[0 + 2 * edge], e2n[1 + 2 * edge],
+                           &ratio),
+            "ratio");
+        RWDS(ratio, batch[edge], 1.0e-12, "batch differs");
+      }
+    }
+    RWDS(0.0, batch[12], -1.0, "zero length");
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
+  { /* active ratio skips edges between settled nodes */
+    REF_NODE ref_node;
+    REF_INT node, global;
+    REF_INT e2n[4] = {0, 1, 2, 3};
+    REF_DBL ratio[2], m[6] = {4.0, 0.0, 0.0, 1.0, 0.0, 1.0};
+
+    RSS(ref_node_create(&ref_node, ref_mpi), "create");
+    for (global = 0; global < 4; global++) {
+      RSS(ref_node_add(ref_node, global, &node), "add");
+      ref_node_xyz(ref_node, 0, node) = (REF_DBL)global;
+      ref_node_xyz(ref_node, 1, node) = 0.0;
+      ref_node_xyz(ref_node, 2, node) = 0.0;
+    }
+    RSS(ref_node_ratio_active(ref_node, 2, e2n, -1.0, ratio), "active");
+    RWDS(1.0, ratio[0], -1.0, "new nodes active");
+    RWDS(1.0, ratio[1], -1.0, "new nodes active");
+
+    ref_node_sweep(ref_node) += 2;
+    RAS(!ref_node_active(ref_node, 0), "settled");
+    RSS(ref_node_metric_set(ref_node, 0, m), "set");
+    RAS(ref_node_active(ref_node, 0), "metric change touches");
+    RSS(ref_node_ratio_active(ref_node, 2, e2n, -1.0, ratio), "active");
+    RWDS(1.0 / log(2.0), ratio[0], 1.0e-12, "changed metric");
+    RWDS(-1.0, ratio[1], -1.0, "settled edge in range");
+
+    RSS(ref_node_free(ref_node), "free");
+  }
+
   { /* quadrature distance in metric */
     REF_NODE ref_node;
     REF_INT node0, node1, global;
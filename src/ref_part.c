@@ -29,96 +29,89 @@
 #include "ref_dict.h"
 #include "ref_endian.h"
 #include "ref_export.h"
+#include "ref_gather.h"
 #include "ref_import.h"
 #include "ref_malloc.h"
 #include "ref_migrate.h"
 #include "ref_mpi.h"
 
-REF_FCN static REF_STATUS ref_part_meshb_long(FILE *file, REF_INT version,
+REF_FCN static REF_STATUS ref_part_meshb_long(REF_MMAP ref_mmap,
+                                              REF_INT version,
                                               REF_LONG *value) {
-  int int_value;
-  long long_value;
+  REF_INT int_value;
   if (version < 4) {
-    REIS(1, fread(&int_value, sizeof(int), 1, file), "int value");
+    RSS(ref_mmap_int(ref_mmap, &int_value), "int value");
     *value = (REF_LONG)int_value;
   } else {
-    REIS(1, fread(&long_value, sizeof(long), 1, file), "long value");
-    *value = long_value;
+    RSS(ref_mmap_long(ref_mmap, value), "long value");
   }
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_part_meshb_size(FILE *file, REF_INT version,
+REF_FCN static REF_STATUS ref_part_meshb_size(REF_MMAP ref_mmap,
+                                              REF_INT version,
                                               REF_SIZE *value) {
-  unsigned int int_value;
-  unsigned long long_value;
+  REF_INT int_value;
+  REF_LONG long_value;
   if (version < 4) {
-    REIS(1, fread(&int_value, sizeof(int), 1, file), "int value");
-    *value = (REF_SIZE)int_value;
+    RSS(ref_mmap_int(ref_mmap, &int_value), "int value");
+    *value = (REF_SIZE)(unsigned int)int_value;
   } else {
-    REIS(1, fread(&long_value, sizeof(long), 1, file), "long value");
+    RSS(ref_mmap_long(ref_mmap, &long_value), "long value");
     *value = (REF_SIZE)long_value;
   }
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_part_node(FILE *file, REF_BOOL swap_endian,
-                                        REF_INT version, REF_BOOL twod,
-                                        REF_NODE ref_node, REF_LONG nnode) {
+/* xyz of n vertex records, meshb records carry a trailing id */
+REF_FCN static REF_STATUS ref_part_node_xyz(REF_MMAP ref_mmap, REF_INT version,
+                                            REF_BOOL twod, REF_INT n,
+                                            REF_DBL *xyz) {
+  REF_INT node, dim, stride;
+  dim = (twod ? 2 : 3);
+  stride = dim * (REF_INT)sizeof(REF_DBL);
+  if (0 < version) stride += (version < 4 ? 4 : 8);
+  RSS(ref_mmap_dbls_strided(ref_mmap, n, dim, stride, xyz), "xyz records");
+  if (twod) {
+    for (node = n - 1; node >= 0; node--) {
+      xyz[2 + 3 * node] = 0.0;
+      xyz[1 + 3 * node] = xyz[1 + 2 * node];
+      xyz[0 + 3 * node] = xyz[0 + 2 * node];
+    }
+  }
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_part_node(REF_MMAP ref_mmap, REF_INT version,
+                                        REF_BOOL twod, REF_NODE ref_node,
+                                        REF_LONG nnode) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT node, new_node;
   REF_INT part;
   REF_INT n;
-  REF_LONG id;
-  REF_DBL dbl;
   REF_DBL *xyz;
 
   RSS(ref_node_initialize_n_global(ref_node, nnode), "init nnodesg");
 
   if (ref_mpi_once(ref_mpi)) {
-    part = 0;
-    for (node = 0; node < ref_part_first(nnode, ref_mpi_n(ref_mpi), 1);
-         node++) {
+    n = (REF_INT)ref_part_first(nnode, ref_mpi_n(ref_mpi), 1);
+    ref_malloc(xyz, 3 * n, REF_DBL);
+    RSS(ref_part_node_xyz(ref_mmap, version, twod, n, xyz), "xyz");
+    for (node = 0; node < n; node++) {
       RSS(ref_node_add(ref_node, node, &new_node), "new_node");
       ref_node_part(ref_node, new_node) = ref_mpi_rank(ref_mpi);
-      RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "x");
-      if (swap_endian) SWAP_DBL(dbl);
-      ref_node_xyz(ref_node, 0, new_node) = dbl;
-      RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "y");
-      if (swap_endian) SWAP_DBL(dbl);
-      ref_node_xyz(ref_node, 1, new_node) = dbl;
-      if (!twod) {
-        RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "z");
-        if (swap_endian) SWAP_DBL(dbl);
-      } else {
-        dbl = 0.0;
-      }
-      ref_node_xyz(ref_node, 2, new_node) = dbl;
-      if (version > 0) RSS(ref_part_meshb_long(file, version, &id), "nnode");
+      ref_node_xyz(ref_node, 0, new_node) = xyz[0 + 3 * node];
+      ref_node_xyz(ref_node, 1, new_node) = xyz[1 + 3 * node];
+      ref_node_xyz(ref_node, 2, new_node) = xyz[2 + 3 * node];
     }
+    ref_free(xyz);
     each_ref_mpi_worker(ref_mpi, part) {
       n = (REF_INT)(ref_part_first(nnode, ref_mpi_n(ref_mpi), part + 1) -
                     ref_part_first(nnode, ref_mpi_n(ref_mpi), part));
       RSS(ref_mpi_scatter_send(ref_mpi, &n, 1, REF_INT_TYPE, part), "send");
       if (n > 0) {
         ref_malloc(xyz, 3 * n, REF_DBL);
-        for (node = 0; node < n; node++) {
-          RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "x");
-          if (swap_endian) SWAP_DBL(dbl);
-          xyz[0 + 3 * node] = dbl;
-          RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "y");
-          if (swap_endian) SWAP_DBL(dbl);
-          xyz[1 + 3 * node] = dbl;
-          if (!twod) {
-            RES(1, fread(&dbl, sizeof(REF_DBL), 1, file), "z");
-            if (swap_endian) SWAP_DBL(dbl);
-          } else {
-            dbl = 0.0;
-          }
-          xyz[2 + 3 * node] = dbl;
-          if (version > 0)
-            RSS(ref_part_meshb_long(file, version, &id), "nnode");
-        }
+        RSS(ref_part_node_xyz(ref_mmap, version, twod, n, xyz), "xyz");
         RSS(ref_mpi_scatter_send(ref_mpi, xyz, 3 * n, REF_DBL_TYPE, part),
             "send");
         free(xyz);
@@ -331,7 +324,7 @@ REF_FCN REF_STATUS ref_part_meshb_geom_delete_me(REF_GEOM ref_geom,
 
 REF_FCN static REF_STATUS ref_part_meshb_geom_bcast(
     REF_GEOM ref_geom, REF_LONG ngeom, REF_INT type, REF_NODE ref_node,
-    REF_INT version, FILE *file) {
+    REF_INT version, REF_MMAP ref_mmap) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_INT chunk;
   REF_LONG *read_node;
@@ -359,16 +352,15 @@ REF_FCN static REF_STATUS ref_part_meshb_geom_bcast(
     section_size = MIN(chunk, (REF_INT)(ngeom - ngeom_read));
     if (ref_mpi_once(ref_mpi)) {
       for (geom = 0; geom < section_size; geom++) {
-        RSS(ref_part_meshb_long(file, version, &(read_node[geom])), "node");
-        RSS(ref_part_meshb_long(file, version, &(read_id[geom])), "node");
+        RSS(ref_part_meshb_long(ref_mmap, version, &(read_node[geom])),
+            "node");
+        RSS(ref_part_meshb_long(ref_mmap, version, &(read_id[geom])), "node");
         for (i = 0; i < 2; i++)
           read_param[i + 2 * geom] = 0.0; /* ensure init */
-        for (i = 0; i < type; i++)
-          REIS(1, fread(&(read_param[i + 2 * geom]), sizeof(double), 1, file),
-               "param");
+        RSS(ref_mmap_dbls(ref_mmap, type, &(read_param[2 * geom])), "param");
         read_gref[geom] = read_id[geom];
         if (0 < type) {
-          REIS(1, fread(&(double_gref), sizeof(double), 1, file), "gref");
+          RSS(ref_mmap_dbl(ref_mmap, &double_gref), "gref");
           read_gref[geom] = (REF_LONG)double_gref;
         }
       }
@@ -406,7 +398,7 @@ REF_FCN static REF_STATUS ref_part_meshb_geom_bcast(
 REF_FCN static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_LONG ncell,
                                               REF_NODE ref_node, REF_LONG nnode,
                                               REF_INT version, REF_BOOL pad,
-                                              FILE *file) {
+                                              REF_MMAP ref_mmap) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_LONG ncell_read;
   REF_INT chunk;
@@ -426,7 +418,7 @@ REF_FCN static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_LONG ncell,
   REF_INT part, node;
   REF_INT ncell_keep;
   REF_INT new_location;
-  size_t nread;
+  REF_INT nread;
 
   chunk = (REF_INT)MAX(1000000, ncell / (REF_LONG)ref_mpi_n(ref_mpi));
 
@@ -446,19 +438,17 @@ REF_FCN static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_LONG ncell,
     ncell_read = 0;
     while (ncell_read < ncell) {
       section_size = MIN(chunk, (REF_INT)(ncell - ncell_read));
-      nread = (size_t)(section_size * (1 + node_per));
+      nread = section_size * (1 + node_per);
       if (pad) {
         for (cell = 0; cell < section_size; cell++) {
           REF_INT zero;
-          REIS(node_per,
-               fread(&(c2n_int[(node_per + 1) * cell]), sizeof(REF_INT),
-                     (size_t)node_per, file),
-               "int c2n pad node");
-          REIS(1, fread(&(zero), sizeof(REF_INT), 1, file), "int c2n pad zero");
-          REIS(1,
-               fread(&(c2n_int[node_per + (node_per + 1) * cell]),
-                     sizeof(REF_INT), 1, file),
-               "int c2n pad tag");
+          RSS(ref_mmap_ints(ref_mmap, node_per,
+                            &(c2n_int[(node_per + 1) * cell])),
+              "int c2n pad node");
+          RSS(ref_mmap_int(ref_mmap, &zero), "int c2n pad zero");
+          RSS(ref_mmap_int(ref_mmap,
+                           &(c2n_int[node_per + (node_per + 1) * cell])),
+              "int c2n pad tag");
         }
         for (cell = 0; cell < section_size; cell++)
           for (node = 0; node < size_per; node++)
@@ -466,14 +456,13 @@ REF_FCN static REF_STATUS ref_part_meshb_cell(REF_CELL ref_cell, REF_LONG ncell,
                 (REF_GLOB)c2n_int[node + (node_per + 1) * cell];
       } else {
         if (version < 4) {
-          REIS(nread, fread(c2n_int, sizeof(REF_INT), nread, file), "int c2n");
+          RSS(ref_mmap_ints(ref_mmap, nread, c2n_int), "int c2n");
           for (cell = 0; cell < section_size; cell++)
             for (node = 0; node < size_per; node++)
               c2n[node + size_per * cell] =
                   (REF_GLOB)c2n_int[node + (node_per + 1) * cell];
         } else {
-          REIS(nread, fread(c2n_long, sizeof(REF_LONG), nread, file),
-               "long c2n");
+          RSS(ref_mmap_longs(ref_mmap, nread, c2n_long), "long c2n");
           for (cell = 0; cell < section_size; cell++)
             for (node = 0; node < size_per; node++)
               c2n[node + size_per * cell] =
@@ -607,7 +596,7 @@ REF_FCN static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell,
                                                     REF_GLOB ncell,
                                                     REF_NODE ref_node,
                                                     REF_INT version,
-                                                    FILE *file) {
+                                                    REF_MMAP ref_mmap) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_GLOB ncell_read;
   REF_INT chunk;
@@ -619,7 +608,7 @@ REF_FCN static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell,
   REF_INT cell, node, local, new_cell;
   REF_BOOL have_all_nodes, one_node_local;
   REF_INT nodes[REF_CELL_MAX_SIZE_PER];
-  size_t nread;
+  REF_INT nread;
 
   chunk = (REF_INT)MAX(1000000, ncell / (REF_LONG)ref_mpi_n(ref_mpi));
 
@@ -634,15 +623,15 @@ REF_FCN static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell,
   while (ncell_read < ncell) {
     section_size = MIN(chunk, (REF_INT)(ncell - ncell_read));
     if (ref_mpi_once(ref_mpi)) {
-      nread = (size_t)(section_size * (1 + node_per));
+      nread = section_size * (1 + node_per);
       if (version < 4) {
-        REIS(nread, fread(c2n_int, sizeof(REF_INT), nread, file), "int c2n");
+        RSS(ref_mmap_ints(ref_mmap, nread, c2n_int), "int c2n");
         for (cell = 0; cell < section_size; cell++)
           for (node = 0; node < size_per; node++)
             c2n[node + size_per * cell] =
                 (REF_GLOB)c2n_int[node + (node_per + 1) * cell];
       } else {
-        REIS(nread, fread(c2n_long, sizeof(REF_LONG), nread, file), "long c2n");
+        RSS(ref_mmap_longs(ref_mmap, nread, c2n_long), "long c2n");
         for (cell = 0; cell < section_size; cell++)
           for (node = 0; node < size_per; node++)
             c2n[node + size_per * cell] =
@@ -690,9 +679,10 @@ REF_FCN static REF_STATUS ref_part_meshb_cell_bcast(REF_CELL ref_cell,
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
-                                         REF_MPI ref_mpi,
-                                         const char *filename) {
+/* ref_mmap is only mapped and used on the once rank */
+REF_FCN static REF_STATUS ref_part_meshb_mmap(REF_GRID *ref_grid_ptr,
+                                              REF_MPI ref_mpi,
+                                              REF_MMAP ref_mmap) {
   REF_BOOL verbose = REF_FALSE;
   REF_INT version, dim;
   REF_BOOL available;
@@ -701,8 +691,6 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
   REF_GRID ref_grid;
   REF_NODE ref_node;
   REF_GEOM ref_geom;
-  FILE *file;
-  REF_BOOL swap_endian = REF_FALSE;
   REF_LONG nnode;
   REF_INT group, keyword_code;
   REF_CELL ref_cell;
@@ -712,19 +700,14 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
   REF_INT cad_data_keyword;
   REF_BOOL pad = REF_FALSE;
 
-  file = NULL;
   if (ref_mpi_once(ref_mpi)) {
-    RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+    RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
     if (verbose) printf("meshb version %d\n", version);
-    if (verbose) printf("open %s\n", filename);
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
                               &next_position),
         "jump");
     RAS(available, "meshb missing dimension");
-    REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+    RSS(ref_mmap_int(ref_mmap, &dim), "dim");
     if (verbose) printf("meshb dim %d\n", dim);
   }
   RSS(ref_mpi_bcast(ref_mpi, &version, 1, REF_INT_TYPE), "bcast");
@@ -736,28 +719,28 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
   ref_grid_twod(ref_grid) = (2 == dim);
 
   if (ref_grid_once(ref_grid)) {
-    RSS(ref_import_meshb_jump(file, version, key_pos, 4, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 4, &available,
                               &next_position),
         "jump");
     RAS(available, "meshb missing vertex");
-    RSS(ref_part_meshb_long(file, version, &nnode), "nnode");
+    RSS(ref_part_meshb_long(ref_mmap, version, &nnode), "nnode");
     if (verbose) printf("nnode %ld\n", nnode);
   }
   RSS(ref_mpi_bcast(ref_mpi, &nnode, 1, REF_LONG_TYPE), "bcast");
-  RSS(ref_part_node(file, swap_endian, version, ref_grid_twod(ref_grid),
-                    ref_node, nnode),
+  RSS(ref_part_node(ref_mmap, version, ref_grid_twod(ref_grid), ref_node,
+                    nnode),
       "part node");
   if (ref_grid_once(ref_grid))
-    REIS(next_position, ftello(file), "vertex file location");
+    REIS(next_position, ref_mmap_position(ref_mmap), "vertex file location");
 
   each_ref_grid_all_ref_cell(ref_grid, group, ref_cell) {
     if (ref_grid_once(ref_grid)) {
       RSS(ref_cell_meshb_keyword(ref_cell, &keyword_code), "kw");
-      RSS(ref_import_meshb_jump(file, version, key_pos, keyword_code,
+      RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, keyword_code,
                                 &available, &next_position),
           "jump");
       if (available) {
-        RSS(ref_part_meshb_long(file, version, &ncell), "ncell");
+        RSS(ref_part_meshb_long(ref_mmap, version, &ncell), "ncell");
         if (verbose) printf("group %d ncell %ld\n", group, ncell);
       }
     }
@@ -765,21 +748,21 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
     if (available) {
       RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_LONG_TYPE), "bcast");
       RSS(ref_part_meshb_cell(ref_cell, ncell, ref_node, nnode, version, pad,
-                              file),
+                              ref_mmap),
           "part cell");
       if (ref_grid_once(ref_grid))
-        REIS(next_position, ftello(file), "cell file location");
+        REIS(next_position, ref_mmap_position(ref_mmap), "cell file location");
     }
   }
 
   each_ref_type(ref_geom, type) {
     if (ref_grid_once(ref_grid)) {
       geom_keyword = 40 + type;
-      RSS(ref_import_meshb_jump(file, version, key_pos, geom_keyword,
+      RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, geom_keyword,
                                 &available, &next_position),
           "jump");
       if (available) {
-        RSS(ref_part_meshb_long(file, version, &ngeom), "ngeom");
+        RSS(ref_part_meshb_long(ref_mmap, version, &ngeom), "ngeom");
         if (verbose) printf("type %d ngeom %ld\n", type, ngeom);
       }
     }
@@ -787,20 +770,20 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
     if (available) {
       RSS(ref_mpi_bcast(ref_mpi, &ngeom, 1, REF_LONG_TYPE), "bcast");
       RSS(ref_part_meshb_geom_bcast(ref_geom, ngeom, type, ref_node, version,
-                                    file),
+                                    ref_mmap),
           "part geom");
       if (ref_grid_once(ref_grid))
-        REIS(next_position, ftello(file), "end location");
+        REIS(next_position, ref_mmap_position(ref_mmap), "end location");
     }
   }
 
   if (ref_grid_once(ref_grid)) {
     cad_data_keyword = 126; /* GmfByteFlow */
-    RSS(ref_import_meshb_jump(file, version, key_pos, cad_data_keyword,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, cad_data_keyword,
                               &available, &next_position),
         "jump");
     if (available) {
-      RSS(ref_part_meshb_size(file, version,
+      RSS(ref_part_meshb_size(ref_mmap, version,
                               &(ref_geom_cad_data_size(ref_geom))),
           "cad data size");
       if (verbose)
@@ -809,11 +792,10 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
       ref_free(ref_geom_cad_data(ref_geom));
       ref_malloc_size_t(ref_geom_cad_data(ref_geom),
                         ref_geom_cad_data_size(ref_geom), REF_BYTE);
-      REIS(ref_geom_cad_data_size(ref_geom),
-           fread(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
-                 ref_geom_cad_data_size(ref_geom), file),
-           "cad_data");
-      REIS(next_position, ftello(file), "end location");
+      RSS(ref_mmap_bytes(ref_mmap, (REF_SIZE)ref_geom_cad_data_size(ref_geom),
+                         ref_geom_cad_data(ref_geom)),
+          "cad_data");
+      REIS(next_position, ref_mmap_position(ref_mmap), "end location");
     }
   }
   RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
@@ -838,17 +820,24 @@ REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
   RSS(ref_grid_inward_boundary_orientation(ref_grid),
       "inward boundary orientation");
 
-  if (ref_grid_once(ref_grid)) {
-    fclose(file);
-  }
+  return REF_SUCCESS;
+}
 
+REF_FCN static REF_STATUS ref_part_meshb(REF_GRID *ref_grid_ptr,
+                                         REF_MPI ref_mpi,
+                                         const char *filename) {
+  REF_MMAP ref_mmap = NULL;
+  if (ref_mpi_once(ref_mpi))
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+  RSS(ref_part_meshb_mmap(ref_grid_ptr, ref_mpi, ref_mmap), "meshb");
+  if (ref_mpi_once(ref_mpi)) RSS(ref_mmap_free(ref_mmap), "unmap");
   return REF_SUCCESS;
 }
 
 REF_FCN REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT version = REF_EMPTY, dim = REF_EMPTY;
   REF_BOOL available;
   REF_FILEPOS next_position;
@@ -862,29 +851,27 @@ REF_FCN REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
   if (strcmp(&filename[end_of_string - 6], ".meshb") != 0)
     RSS(REF_INVALID, "expected .meshb extension");
 
-  file = NULL;
+  ref_mmap = NULL;
   if (ref_mpi_once(ref_mpi)) {
-    RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+    RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
     if (verbose) printf("meshb version %d\n", version);
     if (verbose) printf("open %s\n", filename);
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
                               &next_position),
         "jump");
     RAS(available, "meshb missing dimension");
-    REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+    RSS(ref_mmap_int(ref_mmap, &dim), "dim");
     if (verbose) printf("meshb dim %d\n", dim);
   }
 
   if (ref_grid_once(ref_grid)) {
     cad_data_keyword = 126; /* GmfByteFlow */
-    RSS(ref_import_meshb_jump(file, version, key_pos, cad_data_keyword,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, cad_data_keyword,
                               &available, &next_position),
         "jump");
     if (available) {
-      RSS(ref_part_meshb_size(file, version,
+      RSS(ref_part_meshb_size(ref_mmap, version,
                               &(ref_geom_cad_data_size(ref_geom))),
           "cad data size");
       if (verbose)
@@ -893,11 +880,10 @@ REF_FCN REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
       ref_free(ref_geom_cad_data(ref_geom));
       ref_malloc_size_t(ref_geom_cad_data(ref_geom),
                         ref_geom_cad_data_size(ref_geom), REF_BYTE);
-      REIS(ref_geom_cad_data_size(ref_geom),
-           fread(ref_geom_cad_data(ref_geom), sizeof(REF_BYTE),
-                 (size_t)ref_geom_cad_data_size(ref_geom), file),
-           "cad_data");
-      REIS(next_position, ftello(file), "end location");
+      RSS(ref_mmap_bytes(ref_mmap, (REF_SIZE)ref_geom_cad_data_size(ref_geom),
+                         ref_geom_cad_data(ref_geom)),
+          "cad_data");
+      REIS(next_position, ref_mmap_position(ref_mmap), "end location");
     }
   }
   RSS(ref_mpi_bcast(ref_mpi, &available, 1, REF_INT_TYPE), "bcast");
@@ -920,7 +906,7 @@ REF_FCN REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename) {
   }
 
   if (ref_grid_once(ref_grid)) {
-    fclose(file);
+    RSS(ref_mmap_free(ref_mmap), "unmap");
   }
 
   return REF_SUCCESS;
@@ -931,7 +917,7 @@ REF_FCN REF_STATUS ref_part_cad_association(REF_GRID ref_grid,
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT version, dim;
   REF_BOOL available;
   REF_FILEPOS next_position = REF_EMPTY;
@@ -946,19 +932,17 @@ REF_FCN REF_STATUS ref_part_cad_association(REF_GRID ref_grid,
   if (strcmp(&filename[end_of_string - 6], ".meshb") != 0)
     RSS(REF_INVALID, "expected .meshb extension");
 
-  file = NULL;
+  ref_mmap = NULL;
   if (ref_mpi_once(ref_mpi)) {
-    RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+    RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
     if (verbose) printf("meshb version %d\n", version);
     if (verbose) printf("open %s\n", filename);
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
                               &next_position),
         "jump");
     RAS(available, "meshb missing dimension");
-    REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+    RSS(ref_mmap_int(ref_mmap, &dim), "dim");
     if (verbose) printf("meshb dim %d\n", dim);
   }
   RSS(ref_mpi_bcast(ref_mpi, &version, 1, REF_INT_TYPE), "bcast");
@@ -968,11 +952,11 @@ REF_FCN REF_STATUS ref_part_cad_association(REF_GRID ref_grid,
   each_ref_type(ref_geom, type) {
     if (ref_grid_once(ref_grid)) {
       geom_keyword = 40 + type;
-      RSS(ref_import_meshb_jump(file, version, key_pos, geom_keyword,
+      RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, geom_keyword,
                                 &available, &next_position),
           "jump");
       if (available) {
-        RSS(ref_part_meshb_long(file, version, &ngeom), "ngeom");
+        RSS(ref_part_meshb_long(ref_mmap, version, &ngeom), "ngeom");
         if (verbose) printf("type %d ngeom %ld\n", type, ngeom);
       }
     }
@@ -980,15 +964,15 @@ REF_FCN REF_STATUS ref_part_cad_association(REF_GRID ref_grid,
     if (available) {
       RSS(ref_mpi_bcast(ref_mpi, &ngeom, 1, REF_LONG_TYPE), "bcast");
       RSS(ref_part_meshb_geom_bcast(ref_geom, ngeom, type, ref_node, version,
-                                    file),
+                                    ref_mmap),
           "part geom bcast");
       if (ref_grid_once(ref_grid))
-        REIS(next_position, ftello(file), "end location");
+        REIS(next_position, ref_mmap_position(ref_mmap), "end location");
     }
   }
 
   if (ref_grid_once(ref_grid)) {
-    fclose(file);
+    RSS(ref_mmap_free(ref_mmap), "unmap");
   }
 
   return REF_SUCCESS;
@@ -998,7 +982,7 @@ REF_FCN REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid,
                                               const char *filename) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT version, dim;
   REF_BOOL available;
   REF_FILEPOS next_position = REF_EMPTY;
@@ -1012,19 +996,17 @@ REF_FCN REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid,
   if (strcmp(&filename[end_of_string - 6], ".meshb") != 0)
     RSS(REF_INVALID, "expected .meshb extension");
 
-  file = NULL;
+  ref_mmap = NULL;
   if (ref_mpi_once(ref_mpi)) {
-    RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+    RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
     if (verbose) printf("meshb version %d\n", version);
     if (verbose) printf("open %s\n", filename);
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
                               &next_position),
         "jump");
     RAS(available, "meshb missing dimension");
-    REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+    RSS(ref_mmap_int(ref_mmap, &dim), "dim");
     if (verbose) printf("meshb dim %d\n", dim);
   }
   RSS(ref_mpi_bcast(ref_mpi, &version, 1, REF_INT_TYPE), "bcast");
@@ -1033,11 +1015,11 @@ REF_FCN REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid,
   RSS(ref_cell_create(&ref_grid_edg(ref_grid), REF_CELL_EDG), "edg");
 
   if (ref_grid_once(ref_grid)) {
-    RSS(ref_import_meshb_jump(file, version, key_pos, 5, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 5, &available,
                               &next_position),
         "jump");
     if (available) {
-      RSS(ref_part_meshb_long(file, version, &ncell), "ncell");
+      RSS(ref_part_meshb_long(ref_mmap, version, &ncell), "ncell");
       if (verbose) printf("nedge %ld\n", ncell);
     }
   }
@@ -1048,21 +1030,21 @@ REF_FCN REF_STATUS ref_part_cad_discrete_edge(REF_GRID ref_grid,
   RSS(ref_mpi_bcast(ref_mpi, &ncell, 1, REF_GLOB_TYPE), "bcast");
 
   RSS(ref_part_meshb_cell_bcast(ref_grid_edg(ref_grid), ncell, ref_node,
-                                version, file),
+                                version, ref_mmap),
       "part cell");
 
   if (ref_grid_once(ref_grid)) {
-    REIS(next_position, ftello(file), "end location");
-    fclose(file);
+    REIS(next_position, ref_mmap_position(ref_mmap), "end location");
+    RSS(ref_mmap_free(ref_mmap), "unmap");
   }
 
   return REF_SUCCESS;
 }
 
 REF_FCN static REF_STATUS ref_part_bin_ugrid_pack_cell(
-    FILE *file, REF_BOOL swap_endian, REF_BOOL sixty_four_bit,
-    REF_FILEPOS conn_offset, REF_FILEPOS faceid_offset, REF_INT section_size,
-    REF_LONG ncell_read, REF_INT node_per, REF_INT size_per, REF_GLOB *c2n) {
+    REF_MMAP ref_mmap, REF_BOOL sixty_four_bit, REF_FILEPOS conn_offset,
+    REF_FILEPOS faceid_offset, REF_INT section_size, REF_LONG ncell_read,
+    REF_INT node_per, REF_INT size_per, REF_GLOB *c2n) {
   REF_INT cell, node;
   REF_FILEPOS ibyte;
   ibyte = (sixty_four_bit ? 8 : 4);
@@ -1070,16 +1052,10 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_pack_cell(
   if (sixty_four_bit) {
     REF_LONG *c2t;
     ref_malloc(c2t, node_per * section_size, REF_LONG);
-    REIS(0,
-         fseeko(file, conn_offset + ibyte * node_per * (REF_FILEPOS)ncell_read,
-                SEEK_SET),
-         "seek conn failed");
-    RES((size_t)(section_size * node_per),
-        fread(c2t, sizeof(REF_LONG), (size_t)(section_size * node_per), file),
-        "cn");
-    for (cell = 0; cell < section_size * node_per; cell++) {
-      if (swap_endian) SWAP_LONG(c2t[cell]);
-    }
+    RSS(ref_mmap_seek(ref_mmap, conn_offset + ibyte * node_per *
+                                                  (REF_FILEPOS)ncell_read),
+        "seek conn failed");
+    RSS(ref_mmap_longs(ref_mmap, section_size * node_per, c2t), "cn");
     for (cell = 0; cell < section_size; cell++) {
       for (node = 0; node < node_per; node++) {
         c2n[node + size_per * cell] = c2t[node + node_per * cell] - 1;
@@ -1088,15 +1064,10 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_pack_cell(
     if (node_per != size_per) {
       REF_LONG *tag;
       ref_malloc(tag, section_size, REF_LONG);
-      REIS(0,
-           fseeko(file, faceid_offset + ibyte * (REF_FILEPOS)ncell_read,
-                  SEEK_SET),
-           "seek tag failed");
-      RES((size_t)(section_size),
-          fread(tag, sizeof(REF_LONG), (size_t)section_size, file), "tag");
-      for (cell = 0; cell < section_size; cell++) {
-        if (swap_endian) SWAP_LONG(tag[cell]);
-      }
+      RSS(ref_mmap_seek(ref_mmap,
+                        faceid_offset + ibyte * (REF_FILEPOS)ncell_read),
+          "seek tag failed");
+      RSS(ref_mmap_longs(ref_mmap, section_size, tag), "tag");
       /* sort into right locations */
       for (cell = 0; cell < section_size; cell++)
         c2n[node_per + cell * size_per] = tag[cell];
@@ -1106,16 +1077,10 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_pack_cell(
   } else {
     REF_INT *c2t;
     ref_malloc(c2t, node_per * section_size, REF_INT);
-    REIS(0,
-         fseeko(file, conn_offset + ibyte * node_per * (REF_FILEPOS)ncell_read,
-                SEEK_SET),
-         "seek conn failed");
-    REIS((size_t)(section_size * node_per),
-         fread(c2t, sizeof(REF_INT), (size_t)(section_size * node_per), file),
-         "cn");
-    for (cell = 0; cell < section_size * node_per; cell++) {
-      if (swap_endian) SWAP_INT(c2t[cell]);
-    }
+    RSS(ref_mmap_seek(ref_mmap, conn_offset + ibyte * node_per *
+                                                  (REF_FILEPOS)ncell_read),
+        "seek conn failed");
+    RSS(ref_mmap_ints(ref_mmap, section_size * node_per, c2t), "cn");
     for (cell = 0; cell < section_size; cell++) {
       for (node = 0; node < node_per; node++) {
         c2n[node + size_per * cell] = c2t[node + node_per * cell] - 1;
@@ -1124,15 +1089,10 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_pack_cell(
     if (node_per != size_per) {
       REF_INT *tag;
       ref_malloc(tag, section_size, REF_INT);
-      REIS(0,
-           fseeko(file, faceid_offset + ibyte * (REF_FILEPOS)ncell_read,
-                  SEEK_SET),
-           "seek tag failed");
-      RES((size_t)(section_size),
-          fread(tag, sizeof(REF_INT), (size_t)section_size, file), "tag");
-      for (cell = 0; cell < section_size; cell++) {
-        if (swap_endian) SWAP_INT(tag[cell]);
-      }
+      RSS(ref_mmap_seek(ref_mmap,
+                        faceid_offset + ibyte * (REF_FILEPOS)ncell_read),
+          "seek tag failed");
+      RSS(ref_mmap_ints(ref_mmap, section_size, tag), "tag");
       /* sort into right locations */
       for (cell = 0; cell < section_size; cell++)
         c2n[node_per + cell * size_per] = tag[cell];
@@ -1145,8 +1105,8 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_pack_cell(
 
 REF_FCN static REF_STATUS ref_part_bin_ugrid_cell(
     REF_CELL ref_cell, REF_LONG ncell, REF_NODE ref_node, REF_GLOB nnode,
-    FILE *file, REF_FILEPOS conn_offset, REF_FILEPOS faceid_offset,
-    REF_BOOL swap_endian, REF_BOOL sixty_four_bit) {
+    REF_MMAP ref_mmap, REF_FILEPOS conn_offset, REF_FILEPOS faceid_offset,
+    REF_BOOL sixty_four_bit) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_LONG ncell_read;
   REF_INT chunk;
@@ -1190,9 +1150,9 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_cell(
       section_size = (REF_INT)MIN((REF_LONG)chunk, ncell - ncell_read);
 
       tic = clock();
-      RSS(ref_part_bin_ugrid_pack_cell(file, swap_endian, sixty_four_bit,
-                                       conn_offset, faceid_offset, section_size,
-                                       ncell_read, node_per, size_per, c2n),
+      RSS(ref_part_bin_ugrid_pack_cell(ref_mmap, sixty_four_bit, conn_offset,
+                                       faceid_offset, section_size, ncell_read,
+                                       node_per, size_per, c2n),
           "read c2n");
       read_toc += (clock() - tic);
       ncell_read += section_size;
@@ -1320,13 +1280,109 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid_cell(
   return REF_SUCCESS;
 }
 
+/* every rank reads a contiguous slab of the cell block and forwards each cell
+ * to the owner of its first node in one sparse exchange per round */
+REF_FCN static REF_STATUS ref_part_bin_ugrid_slab_cell(
+    REF_CELL ref_cell, REF_LONG ncell, REF_NODE ref_node, REF_GLOB nnode,
+    REF_MMAP ref_mmap, REF_FILEPOS conn_offset, REF_FILEPOS faceid_offset,
+    REF_BOOL sixty_four_bit) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_LONG first, last, ncell_read, max_slab;
+  REF_INT chunk, nround, round;
+  REF_INT node_per, size_per;
+  REF_INT section_size, nrecv;
+  REF_INT cell, node;
+  REF_GLOB *c2n, *recv_c2n;
+  REF_INT *dest, *recv_part;
+
+  size_per = ref_cell_size_per(ref_cell);
+  node_per = ref_cell_node_per(ref_cell);
+
+  first = ref_part_first(ncell, (REF_LONG)ref_mpi_n(ref_mpi),
+                         (REF_LONG)ref_mpi_rank(ref_mpi));
+  last = ref_part_first(ncell, (REF_LONG)ref_mpi_n(ref_mpi),
+                        (REF_LONG)ref_mpi_rank(ref_mpi) + 1);
+  max_slab = ref_part_large_part_size(ncell, (REF_LONG)ref_mpi_n(ref_mpi));
+  chunk = 1000000;
+  nround = (REF_INT)((max_slab + chunk - 1) / chunk);
+
+  if (1 < ref_mpi_timing(ref_mpi) && ref_mpi_once(ref_mpi))
+    printf("slab %ld rounds %d ncell %ld nproc %d\n", max_slab, nround, ncell,
+           ref_mpi_n(ref_mpi));
+
+  ref_malloc(c2n, size_per * chunk, REF_GLOB);
+  ref_malloc(dest, chunk, REF_INT);
+
+  ncell_read = first;
+  for (round = 0; round < nround; round++) {
+    section_size = (REF_INT)MIN((REF_LONG)chunk, last - ncell_read);
+    if (0 < section_size) {
+      RSS(ref_part_bin_ugrid_pack_cell(ref_mmap, sixty_four_bit, conn_offset,
+                                       faceid_offset, section_size, ncell_read,
+                                       node_per, size_per, c2n),
+          "read c2n");
+      ncell_read += section_size;
+    }
+    for (cell = 0; cell < section_size; cell++)
+      dest[cell] =
+          ref_part_implicit(nnode, ref_mpi_n(ref_mpi), c2n[size_per * cell]);
+
+    RSS(ref_mpi_blindsend(ref_mpi, dest, c2n, size_per, section_size,
+                          (void **)(&recv_c2n), &nrecv, REF_GLOB_TYPE),
+        "blind send cells");
+
+    if (0 < nrecv) {
+      ref_malloc_init(recv_part, size_per * nrecv, REF_INT, REF_EMPTY);
+      for (cell = 0; cell < nrecv; cell++)
+        for (node = 0; node < node_per; node++)
+          recv_part[node + size_per * cell] = ref_part_implicit(
+              nnode, ref_mpi_n(ref_mpi), recv_c2n[node + size_per * cell]);
+      RSS(ref_cell_add_many_global(ref_cell, ref_node, nrecv, recv_c2n,
+                                   recv_part, ref_mpi_rank(ref_mpi)),
+          "glob");
+      ref_free(recv_part);
+    }
+    ref_free(recv_c2n);
+  }
+  REIS(last, ncell_read, "slab miscount");
+
+  ref_free(dest);
+  ref_free(c2n);
+
+  if (1 < ref_mpi_timing(ref_mpi))
+    ref_mpi_stopwatch_stop(ref_mpi, "ugrid slab read");
+  RSS(ref_migrate_shufflin_cell(ref_node, ref_cell), "fill ghosts");
+  if (1 < ref_mpi_timing(ref_mpi))
+    ref_mpi_stopwatch_stop(ref_mpi, "ugrid slab shuffle");
+
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_part_bin_ugrid_block(
+    REF_CELL ref_cell, REF_LONG ncell, REF_NODE ref_node, REF_GLOB nnode,
+    REF_MMAP ref_mmap, REF_FILEPOS conn_offset, REF_FILEPOS faceid_offset,
+    REF_BOOL sixty_four_bit, REF_BOOL slab) {
+  if (slab) {
+    RSS(ref_part_bin_ugrid_slab_cell(ref_cell, ncell, ref_node, nnode,
+                                     ref_mmap, conn_offset, faceid_offset,
+                                     sixty_four_bit),
+        "slab");
+  } else {
+    RSS(ref_part_bin_ugrid_cell(ref_cell, ncell, ref_node, nnode, ref_mmap,
+                                conn_offset, faceid_offset, sixty_four_bit),
+        "rank 0");
+  }
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
                                              REF_MPI ref_mpi,
                                              const char *filename,
                                              REF_BOOL swap_endian,
                                              REF_BOOL sixty_four_bit) {
-  FILE *file;
+  REF_MMAP ref_mmap, slab_mmap;
   REF_LONG nnode, ntri, nqua, ntet, npyr, npri, nhex;
+  REF_BOOL packed = REF_FALSE, slab;
 
   REF_FILEPOS conn_offset, faceid_offset;
 
@@ -1348,51 +1404,33 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
 
   /* header */
 
-  file = NULL;
+  ref_mmap = NULL;
   if (ref_grid_once(ref_grid)) {
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_mmap_create(&ref_mmap, filename, swap_endian), "map");
+    packed = ref_mmap_packed(ref_mmap);
 
     if (sixty_four_bit) {
-      RES(1, fread(&nnode, sizeof(REF_LONG), 1, file), "nnode");
-      RES(1, fread(&ntri, sizeof(REF_LONG), 1, file), "ntri");
-      RES(1, fread(&nqua, sizeof(REF_LONG), 1, file), "nqua");
-      RES(1, fread(&ntet, sizeof(REF_LONG), 1, file), "ntet");
-      RES(1, fread(&npyr, sizeof(REF_LONG), 1, file), "npyr");
-      RES(1, fread(&npri, sizeof(REF_LONG), 1, file), "npri");
-      RES(1, fread(&nhex, sizeof(REF_LONG), 1, file), "nhex");
-
-      if (swap_endian) {
-        SWAP_LONG(nnode);
-        SWAP_LONG(ntri);
-        SWAP_LONG(nqua);
-        SWAP_LONG(ntet);
-        SWAP_LONG(npyr);
-        SWAP_LONG(npri);
-        SWAP_LONG(nhex);
-      }
+      RSS(ref_mmap_long(ref_mmap, &nnode), "nnode");
+      RSS(ref_mmap_long(ref_mmap, &ntri), "ntri");
+      RSS(ref_mmap_long(ref_mmap, &nqua), "nqua");
+      RSS(ref_mmap_long(ref_mmap, &ntet), "ntet");
+      RSS(ref_mmap_long(ref_mmap, &npyr), "npyr");
+      RSS(ref_mmap_long(ref_mmap, &npri), "npri");
+      RSS(ref_mmap_long(ref_mmap, &nhex), "nhex");
     } else {
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "nnode");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "nnode");
       nnode = single;
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "ntri");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "ntri");
       ntri = single;
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "nqua");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "nqua");
       nqua = single;
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "ntet");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "ntet");
       ntet = single;
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "npyr");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "npyr");
       npyr = single;
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "npri");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "npri");
       npri = single;
-      RES(1, fread(&single, sizeof(REF_INT), 1, file), "nhex");
-      if (swap_endian) SWAP_INT(single);
+      RSS(ref_mmap_int(ref_mmap, &single), "nhex");
       nhex = single;
     }
   }
@@ -1404,11 +1442,21 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
   RSS(ref_mpi_bcast(ref_grid_mpi(ref_grid), &npyr, 1, REF_LONG_TYPE), "bcast");
   RSS(ref_mpi_bcast(ref_grid_mpi(ref_grid), &npri, 1, REF_LONG_TYPE), "bcast");
   RSS(ref_mpi_bcast(ref_grid_mpi(ref_grid), &nhex, 1, REF_LONG_TYPE), "bcast");
+  RSS(ref_mpi_bcast(ref_grid_mpi(ref_grid), &packed, 1, REF_INT_TYPE),
+      "bcast");
 
   if (instrument)
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "ugrid header");
 
-  RSS(ref_part_node(file, swap_endian, version, REF_FALSE, ref_node, nnode),
+  /* in parallel, each rank maps the file to read its own slab of cells,
+   * a packed file is expanded once by rank 0 and its cells scattered */
+  slab = ref_mpi_para(ref_mpi) && !packed;
+  slab_mmap = ref_mmap;
+  if (slab && !ref_mpi_once(ref_mpi)) {
+    RSS(ref_mmap_create(&slab_mmap, filename, swap_endian), "map slab");
+  }
+
+  RSS(ref_part_node(ref_mmap, version, REF_FALSE, ref_node, nnode),
       "part node");
   if (instrument) ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "ugrid nodes");
 
@@ -1417,9 +1465,9 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
     faceid_offset = 7 * ibyte + (REF_FILEPOS)nnode * (8 * 3) +
                     (REF_FILEPOS)ntri * 3 * ibyte +
                     (REF_FILEPOS)nqua * 4 * ibyte;
-    RSS(ref_part_bin_ugrid_cell(ref_grid_tri(ref_grid), ntri, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
-                                sixty_four_bit),
+    RSS(ref_part_bin_ugrid_block(ref_grid_tri(ref_grid), ntri, ref_node, nnode,
+                                 slab_mmap, conn_offset, faceid_offset,
+                                 sixty_four_bit, slab),
         "tri");
   }
 
@@ -1429,9 +1477,9 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
     faceid_offset = 7 * ibyte + (REF_FILEPOS)nnode * (8 * 3) +
                     (REF_FILEPOS)ntri * 4 * ibyte +
                     (REF_FILEPOS)nqua * 4 * ibyte;
-    RSS(ref_part_bin_ugrid_cell(ref_grid_qua(ref_grid), nqua, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
-                                sixty_four_bit),
+    RSS(ref_part_bin_ugrid_block(ref_grid_qua(ref_grid), nqua, ref_node, nnode,
+                                 slab_mmap, conn_offset, faceid_offset,
+                                 sixty_four_bit, slab),
         "qua");
   }
 
@@ -1441,9 +1489,9 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
     conn_offset = 7 * ibyte + (REF_FILEPOS)nnode * (8 * 3) +
                   (REF_FILEPOS)ntri * 4 * ibyte + (REF_FILEPOS)nqua * 5 * ibyte;
     faceid_offset = (REF_FILEPOS)REF_EMPTY;
-    RSS(ref_part_bin_ugrid_cell(ref_grid_tet(ref_grid), ntet, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
-                                sixty_four_bit),
+    RSS(ref_part_bin_ugrid_block(ref_grid_tet(ref_grid), ntet, ref_node, nnode,
+                                 slab_mmap, conn_offset, faceid_offset,
+                                 sixty_four_bit, slab),
         "tet");
   }
   if (instrument) ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "ugrid tet");
@@ -1453,9 +1501,9 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
                   (REF_FILEPOS)ntri * 4 * ibyte +
                   (REF_FILEPOS)nqua * 5 * ibyte + (REF_FILEPOS)ntet * 4 * ibyte;
     faceid_offset = (REF_FILEPOS)REF_EMPTY;
-    RSS(ref_part_bin_ugrid_cell(ref_grid_pyr(ref_grid), npyr, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
-                                sixty_four_bit),
+    RSS(ref_part_bin_ugrid_block(ref_grid_pyr(ref_grid), npyr, ref_node, nnode,
+                                 slab_mmap, conn_offset, faceid_offset,
+                                 sixty_four_bit, slab),
         "pyr");
   }
   if (instrument) ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "ugrid pyr");
@@ -1466,9 +1514,9 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
                   (REF_FILEPOS)nqua * 5 * ibyte +
                   (REF_FILEPOS)ntet * 4 * ibyte + (REF_FILEPOS)npyr * 5 * ibyte;
     faceid_offset = (REF_FILEPOS)REF_EMPTY;
-    RSS(ref_part_bin_ugrid_cell(ref_grid_pri(ref_grid), npri, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
-                                sixty_four_bit),
+    RSS(ref_part_bin_ugrid_block(ref_grid_pri(ref_grid), npri, ref_node, nnode,
+                                 slab_mmap, conn_offset, faceid_offset,
+                                 sixty_four_bit, slab),
         "pri");
   }
   if (instrument) ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "ugrid pri");
@@ -1480,14 +1528,15 @@ REF_FCN static REF_STATUS ref_part_bin_ugrid(REF_GRID *ref_grid_ptr,
                   (REF_FILEPOS)ntet * 4 * ibyte +
                   (REF_FILEPOS)npyr * 5 * ibyte + (REF_FILEPOS)npri * 6 * ibyte;
     faceid_offset = REF_EMPTY;
-    RSS(ref_part_bin_ugrid_cell(ref_grid_hex(ref_grid), nhex, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
-                                sixty_four_bit),
+    RSS(ref_part_bin_ugrid_block(ref_grid_hex(ref_grid), nhex, ref_node, nnode,
+                                 slab_mmap, conn_offset, faceid_offset,
+                                 sixty_four_bit, slab),
         "hex");
   }
   if (instrument) ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "ugrid hex");
 
-  if (ref_grid_once(ref_grid)) REIS(0, fclose(file), "close file");
+  if (ref_grid_once(ref_grid)) RSS(ref_mmap_free(ref_mmap), "unmap");
+  if (slab_mmap != ref_mmap) RSS(ref_mmap_free(slab_mmap), "unmap slab");
 
   /* ghost xyz */
 
@@ -1508,7 +1557,7 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
   REF_GRID ref_grid;
   REF_NODE ref_node;
   REF_BOOL verbose = REF_TRUE;
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT dim;
   REF_LONG nnode;
   REF_LONG ntet;
@@ -1518,7 +1567,7 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
   ref_grid = *ref_grid_ptr;
   ref_node = ref_grid_node(ref_grid);
 
-  file = NULL;
+  ref_mmap = NULL;
   if (ref_mpi_once(ref_mpi)) {
     int i, length, magic, revision, meshes, precision;
     char letter;
@@ -1543,93 +1592,90 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     char patch_type[17];
     int patch_id;
 
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
     length = 6;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(1, fread(&magic, sizeof(magic), 1, file), "magic");
+    RSS(ref_mmap_int(ref_mmap, &magic), "magic");
     if (verbose) printf("%d magic\n", magic);
     REIS(1, magic, "magic");
-    REIS(1, fread(&revision, sizeof(revision), 1, file), "revision");
+    RSS(ref_mmap_int(ref_mmap, &revision), "revision");
     if (verbose) printf("%d revision\n", revision);
     REIS(2, revision, "revision");
-    REIS(1, fread(&meshes, sizeof(meshes), 1, file), "meshes");
+    RSS(ref_mmap_int(ref_mmap, &meshes), "meshes");
     if (verbose) printf("%d meshes\n", meshes);
     REIS(1, meshes, "meshes");
     length = 128;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(1, fread(&precision, sizeof(precision), 1, file), "precision");
+    RSS(ref_mmap_int(ref_mmap, &precision), "precision");
     if (verbose) printf("%d precision\n", precision);
     REIS(2, precision, "precision");
-    REIS(1, fread(&dim, sizeof(dim), 1, file), "dim");
+    RSS(ref_mmap_int(ref_mmap, &dim), "dim");
     if (verbose) printf("%d dim\n", dim);
     RAS(2 <= dim && dim <= 3, "dim");
-    REIS(1, fread(&length, sizeof(length), 1, file), "length");
+    RSS(ref_mmap_int(ref_mmap, &length), "length");
     if (verbose) printf("%d description length\n", length);
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
     /* mesh name */
     length = 128;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(7, fread(mesh_type, sizeof(char), 7, file), "letter");
+    RSS(ref_mmap_bytes(ref_mmap, 7, mesh_type), "letter");
     mesh_type[7] = '\0';
     if (verbose) printf("%s", mesh_type);
     REIS(0, strcmp("unstruc", mesh_type), "mesh type");
     length = 128 - 7;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
     /* mesh generator */
     length = 128;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(6, fread(coordinate_system, sizeof(char), 6, file),
-         "coordinate_system");
+    RSS(ref_mmap_bytes(ref_mmap, 6, coordinate_system), "coordinate_system");
     coordinate_system[6] = '\0';
     if (verbose) printf("%s", coordinate_system);
     RSS(ref_grid_parse_coordinate_system(ref_grid, coordinate_system),
         "parse coordinate_system");
     length = 128 - 6;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(1, fread(&model_scale, sizeof(model_scale), 1, file), "model_scale");
+    RSS(ref_mmap_dbl(ref_mmap, &model_scale), "model_scale");
     if (verbose) printf("%f model_scale\n", model_scale);
     RWDS(1, model_scale, -1, "model_scale");
-    REIS(2, fread(units, sizeof(char), 2, file), "units");
+    RSS(ref_mmap_bytes(ref_mmap, 2, units), "units");
     units[2] = '\0';
     if (verbose) printf("%s", units);
     RSS(ref_grid_parse_unit(ref_grid, units), "parse unit");
     length = 128 - 2;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(7, fread(reference, sizeof(double), 7, file), "letter");
+    RSS(ref_mmap_dbls(ref_mmap, 7, reference), "letter");
     for (i = 0; i < 7; i++) {
       ref_grid_reference(ref_grid, i) = reference[i];
       if (verbose) printf("%f reference %d\n", reference[i], i);
@@ -1637,84 +1683,78 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     /* reference point description */
     length = 128;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(1, fread(&refined, sizeof(refined), 1, file), "refined");
+    RSS(ref_mmap_int(ref_mmap, &refined), "refined");
     if (verbose) printf("%d refined\n", refined);
     REIS(0, refined, "refined");
     /* mesh description */
     length = 128;
     for (i = 0; i < length; i++) {
-      REIS(1, fread(&letter, sizeof(letter), 1, file), "letter");
+      RSS(ref_mmap_bytes(ref_mmap, 1, &letter), "letter");
       if (verbose) printf("%c", letter);
     }
     if (verbose) printf("\n");
-    REIS(1, fread(&nnodes, sizeof(nnodes), 1, file), "nnodes");
-    REIS(1, fread(&nfaces, sizeof(nfaces), 1, file), "nfaces");
-    REIS(1, fread(&ncells, sizeof(ncells), 1, file), "ncells");
+    RSS(ref_mmap_int(ref_mmap, &nnodes), "nnodes");
+    RSS(ref_mmap_int(ref_mmap, &nfaces), "nfaces");
+    RSS(ref_mmap_int(ref_mmap, &ncells), "ncells");
     if (verbose)
       printf("%d nnodes %d nfaces %d ncells\n", nnodes, nfaces, ncells);
-    REIS(1, fread(&max_nodes_per_face, sizeof(max_nodes_per_face), 1, file),
-         "max_nodes_per_face");
-    REIS(1, fread(&max_nodes_per_cell, sizeof(max_nodes_per_cell), 1, file),
-         "max_nodes_per_cell");
-    REIS(1, fread(&max_faces_per_cell, sizeof(max_faces_per_cell), 1, file),
-         "max_faces_per_cell");
+    RSS(ref_mmap_int(ref_mmap, &max_nodes_per_face), "max_nodes_per_face");
+    RSS(ref_mmap_int(ref_mmap, &max_nodes_per_cell), "max_nodes_per_cell");
+    RSS(ref_mmap_int(ref_mmap, &max_faces_per_cell), "max_faces_per_cell");
     if (verbose)
       printf(
           "%d max_nodes_per_face %d max_faces_per_face %d max_faces_per_cell\n",
           max_nodes_per_face, max_nodes_per_cell, max_faces_per_cell);
-    REIS(32, fread(element_scheme, sizeof(char), 32, file), "element_scheme");
+    RSS(ref_mmap_bytes(ref_mmap, 32, element_scheme), "element_scheme");
     element_scheme[32] = '\0';
     if (verbose) printf("%s\n", element_scheme);
     REIS(0, strcmp("uniform", element_scheme), "element_scheme");
-    REIS(1,
-         fread(&face_polynomial_order, sizeof(face_polynomial_order), 1, file),
-         "face_polynomial_order");
-    REIS(1,
-         fread(&cell_polynomial_order, sizeof(cell_polynomial_order), 1, file),
-         "cell_polynomial_order");
+    RSS(ref_mmap_int(ref_mmap, &face_polynomial_order),
+        "face_polynomial_order");
+    RSS(ref_mmap_int(ref_mmap, &cell_polynomial_order),
+        "cell_polynomial_order");
     if (verbose)
       printf("%d face_polynomial_order %d cell_polynomial_order\n",
              face_polynomial_order, cell_polynomial_order);
     REIS(1, face_polynomial_order, "face_polynomial_order");
     REIS(1, cell_polynomial_order, "cell_polynomial_order");
-    REIS(1, fread(&boundary_patches, sizeof(boundary_patches), 1, file),
-         "boundary_patches");
+    RSS(ref_mmap_int(ref_mmap, &boundary_patches), "boundary_patches");
     if (verbose) printf("%d boundary_patches\n", boundary_patches);
-    REIS(1, fread(&nhex, sizeof(nhex), 1, file), "nhex");
-    REIS(1, fread(&ntet_int, sizeof(ntet_int), 1, file), "ntet_int");
+    RSS(ref_mmap_int(ref_mmap, &nhex), "nhex");
+    RSS(ref_mmap_int(ref_mmap, &ntet_int), "ntet_int");
     ntet = (REF_LONG)ntet_int;
-    REIS(1, fread(&npri, sizeof(npri), 1, file), "npri");
-    REIS(1, fread(&npyr, sizeof(npyr), 1, file), "npyr");
+    RSS(ref_mmap_int(ref_mmap, &npri), "npri");
+    RSS(ref_mmap_int(ref_mmap, &npyr), "npyr");
     if (verbose)
       printf("%d nhex %d ntet %d npri %d npyr\n", nhex, ntet_int, npri, npyr);
     REIS(0, nhex, "cant do hex");
     REIS(0, npri, "cant do prism");
     REIS(0, npyr, "cant do pyramid");
     REIS(ncells, ntet_int, "ncells does not match ntet");
-    REIS(1, fread(&ntri_int, sizeof(ntri_int), 1, file), "ntri_int");
+    RSS(ref_mmap_int(ref_mmap, &ntri_int), "ntri_int");
     ntri = (REF_LONG)ntri_int;
-    REIS(1, fread(&ntri2, sizeof(ntri2), 1, file), "ntri2");
-    REIS(1, fread(&nqua, sizeof(nqua), 1, file), "nqua");
-    REIS(1, fread(&nqua2, sizeof(nqua2), 1, file), "nqua2");
+    RSS(ref_mmap_int(ref_mmap, &ntri2), "ntri2");
+    RSS(ref_mmap_int(ref_mmap, &nqua), "nqua");
+    RSS(ref_mmap_int(ref_mmap, &nqua2), "nqua2");
     if (verbose)
       printf("%d ntri %d ntri %d nqua %d nqua\n", ntri_int, ntri2, nqua, nqua2);
     REIS(ntri, ntri2, "ntri mismatch");
     REIS(0, nqua, "cant do quad");
     REIS(nqua, nqua2, "nquad mismatch");
-    REIS(5, fread(zeros, sizeof(int), 5, file), "zeros");
+    RSS(ref_mmap_ints(ref_mmap, 5, zeros), "zeros");
     for (i = 0; i < 5; i++) {
       REIS(0, zeros[i], "zeros not zero");
     }
     for (i = 0; i < boundary_patches; i++) {
-      REIS(32, fread(patch_label, sizeof(char), 32, file), "patch_label");
+      RSS(ref_mmap_bytes(ref_mmap, 32, patch_label), "patch_label");
       patch_label[32] = '\0';
-      REIS(16, fread(patch_type, sizeof(char), 16, file), "patch_type");
+      RSS(ref_mmap_bytes(ref_mmap, 16, patch_type), "patch_type");
       patch_type[16] = '\0';
-      REIS(1, fread(&patch_id, sizeof(patch_id), 1, file), "patch_id");
+      RSS(ref_mmap_int(ref_mmap, &patch_id), "patch_id");
       if (verbose)
         printf("%s %s %d -> %d\n", patch_label, patch_type, patch_id,
                -patch_id);
@@ -1739,10 +1779,9 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
   RSS(ref_mpi_bcast(ref_grid_mpi(ref_grid), &ntet, 1, REF_LONG_TYPE), "bcast");
 
   {
-    REF_BOOL swap_endian = REF_FALSE;
     REF_INT version = 0;
     REF_BOOL twod = REF_FALSE;
-    RSS(ref_part_node(file, swap_endian, version, twod, ref_node, nnode),
+    RSS(ref_part_node(ref_mmap, version, twod, ref_node, nnode),
         "part node");
   }
 
@@ -1752,7 +1791,7 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     REF_INT cell;
     REF_BOOL pad = REF_TRUE;
     RSS(ref_part_meshb_cell(ref_cell, ntri, ref_node, nnode, version, pad,
-                            file),
+                            ref_mmap),
         "read edg as tri");
     /* positive face ids */
     each_ref_cell_valid_cell(ref_cell, cell) {
@@ -1765,7 +1804,7 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     REF_INT cell;
     REF_BOOL pad = REF_FALSE;
     RSS(ref_part_meshb_cell(ref_cell, ntri, ref_node, nnode, version, pad,
-                            file),
+                            ref_mmap),
         "read tri");
     /* positive face ids */
     each_ref_cell_valid_cell(ref_cell, cell) {
@@ -1780,7 +1819,7 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     REF_BOOL pad = REF_FALSE;
     REF_INT cell, temp_node;
     RSS(ref_part_meshb_cell(ref_cell, ntet, ref_node, nnode, version, pad,
-                            file),
+                            ref_mmap),
         "read tri");
     /* avm winds tri different than EGADS */
     each_ref_cell_valid_cell(ref_cell, cell) {
@@ -1790,18 +1829,17 @@ REF_FCN static REF_STATUS ref_part_avm(REF_GRID *ref_grid_ptr, REF_MPI ref_mpi,
     }
   } else {
     REF_FILEPOS conn_offset, faceid_offset;
-    REF_BOOL swap_endian = REF_FALSE;
     REF_BOOL sixty_four_bit = REF_FALSE;
     conn_offset = 0;
-    if (ref_grid_once(ref_grid)) conn_offset = ftello(file);
+    if (ref_grid_once(ref_grid)) conn_offset = ref_mmap_position(ref_mmap);
     faceid_offset = 0;
     RSS(ref_part_bin_ugrid_cell(ref_grid_tet(ref_grid), ntet, ref_node, nnode,
-                                file, conn_offset, faceid_offset, swap_endian,
+                                ref_mmap, conn_offset, faceid_offset,
                                 sixty_four_bit),
         "read tet");
   }
 
-  if (ref_grid_once(ref_grid)) REIS(0, fclose(file), "close file");
+  if (ref_grid_once(ref_grid)) RSS(ref_mmap_free(ref_mmap), "unmap");
   return REF_SUCCESS;
 }
 
@@ -1810,7 +1848,7 @@ REF_FCN static REF_STATUS ref_part_metric_solb(REF_NODE ref_node,
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
   REF_FILEPOS next_position = REF_EMPTY;
   REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
-  FILE *file;
+  REF_MMAP ref_mmap;
   REF_INT chunk;
   REF_DBL *metric;
   REF_LONG nnode_read;
@@ -1821,28 +1859,26 @@ REF_FCN static REF_STATUS ref_part_metric_solb(REF_NODE ref_node,
   REF_GLOB global;
   REF_LONG nnode;
 
-  file = NULL;
+  ref_mmap = NULL;
   if (ref_mpi_once(ref_mpi)) {
-    RSS(ref_import_meshb_header(filename, &version, key_pos), "header");
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+    RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
     RAS(2 <= version && version <= 4, "unsupported version");
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
                               &next_position),
         "jump");
     RAS(available, "solb missing dimension");
-    REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
+    RSS(ref_mmap_int(ref_mmap, &dim), "dim");
     RAS(2 <= dim && dim <= 3, "unsupported dimension");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 62, &available,
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 62, &available,
                               &next_position),
         "jump");
     RAS(available, "SolAtVertices missing");
-    RSS(ref_part_meshb_long(file, version, &nnode), "nnode");
-    REIS(1, fread((unsigned char *)&ntype, 4, 1, file), "ntype");
+    RSS(ref_part_meshb_long(ref_mmap, version, &nnode), "nnode");
+    RSS(ref_mmap_int(ref_mmap, &ntype), "ntype");
     ldim = 0;
     for (i = 0; i < ntype; i++) {
-      REIS(1, fread((unsigned char *)&type, 4, 1, file), "type");
+      RSS(ref_mmap_int(ref_mmap, &type), "type");
       RAB(1 <= type && type <= 3,
           "only types 1 (scalar) or 3 (tensor)) supported",
           { printf(" %d type\n", type); });
@@ -1890,26 +1926,17 @@ REF_FCN static REF_STATUS ref_part_metric_solb(REF_NODE ref_node,
     if (ref_mpi_once(ref_node_mpi(ref_node))) {
       for (node = 0; node < section_size; node++) {
         if (6 == ldim) {
-          REIS(1, fread(&(metric[0 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m11");
-          REIS(1, fread(&(metric[1 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m12");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[0 + 6 * node])), "m11");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[1 + 6 * node])), "m12");
           /* transposed 3,2 */
-          REIS(1, fread(&(metric[3 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m22");
-          REIS(1, fread(&(metric[2 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m31");
-          REIS(1, fread(&(metric[4 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m32");
-          REIS(1, fread(&(metric[5 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m33");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[3 + 6 * node])), "m22");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[2 + 6 * node])), "m31");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[4 + 6 * node])), "m32");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[5 + 6 * node])), "m33");
         } else if (3 == ldim) {
-          REIS(1, fread(&(metric[0 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m11");
-          REIS(1, fread(&(metric[1 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m12");
-          REIS(1, fread(&(metric[3 + 6 * node]), sizeof(REF_DBL), 1, file),
-               "m22");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[0 + 6 * node])), "m11");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[1 + 6 * node])), "m12");
+          RSS(ref_mmap_dbl(ref_mmap, &(metric[3 + 6 * node])), "m22");
           metric[2 + 6 * node] = 0.0; /* m13 */
           metric[4 + 6 * node] = 0.0; /* m23 */
           metric[5 + 6 * node] = 1.0; /* m33 */
@@ -1946,8 +1973,8 @@ REF_FCN static REF_STATUS ref_part_metric_solb(REF_NODE ref_node,
 
   ref_free(metric);
   if (ref_mpi_once(ref_mpi)) {
-    REIS(next_position, ftello(file), "end location");
-    REIS(0, fclose(file), "close file");
+    REIS(next_position, ref_mmap_position(ref_mmap), "end location");
+    RSS(ref_mmap_free(ref_mmap), "unmap");
   }
 
   return REF_SUCCESS;
@@ -2962,67 +2989,56 @@ REF_FCN static REF_STATUS ref_part_scalar_sol(REF_NODE ref_node, REF_INT *ldim,
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_part_scalar_solb(REF_NODE ref_node, REF_INT *ldim,
-                                               REF_DBL **scalar,
-                                               const char *filename) {
+/* rank 0 maps filename and leaves the cursor at the first record */
+/* ref_mmap is only mapped and used on the once rank */
+REF_FCN static REF_STATUS ref_part_solb_header(REF_NODE ref_node,
+                                               const char *filename,
+                                               REF_MMAP ref_mmap,
+                                               REF_FILEPOS *next_position,
+                                               REF_INT *dim, REF_LONG *nnode,
+                                               REF_INT *ldim) {
   REF_MPI ref_mpi = ref_node_mpi(ref_node);
-  REF_FILEPOS next_position = REF_EMPTY;
   REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
-  FILE *file;
-  REF_INT chunk;
-  REF_DBL *data;
-  REF_INT section_size;
-  REF_GLOB global;
-  REF_INT node, local;
   REF_BOOL available;
-  REF_INT version, dim, ntype, type, i;
-  REF_LONG nnode, nnode_read;
+  REF_INT version, ntype, type, i;
 
-  file = NULL;
-  if (ref_mpi_once(ref_node_mpi(ref_node))) {
-    RSS(ref_import_meshb_header(filename, &version, key_pos), "head");
+  *next_position = REF_EMPTY;
+  if (ref_mpi_once(ref_mpi)) {
+    RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "head");
     RAS(2 <= version && version <= 4, "unsupported version");
-    file = fopen(filename, "r");
-    if (NULL == (void *)file) printf("unable to open %s\n", filename);
-    RNS(file, "unable to open file");
-    RSS(ref_import_meshb_jump(file, version, key_pos, 3, &available,
-                              &next_position),
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 3, &available,
+                              next_position),
         "jump");
     RAS(available, "solb missing dimension");
-    REIS(1, fread((unsigned char *)&dim, 4, 1, file), "dim");
-    RAS(2 <= dim && dim <= 3, "unsupported dimension");
+    RSS(ref_mmap_int(ref_mmap, dim), "dim");
+    RAS(2 <= *dim && *dim <= 3, "unsupported dimension");
 
-    RSS(ref_import_meshb_jump(file, version, key_pos, 62, &available,
-                              &next_position),
+    RSS(ref_import_meshb_jump(ref_mmap, version, key_pos, 62, &available,
+                              next_position),
         "jmp");
     RAS(available, "SolAtVertices missing");
-    RSS(ref_part_meshb_long(file, version, &nnode), "nnode");
-    REIS(1, fread((unsigned char *)&ntype, 4, 1, file), "ntype");
+    RSS(ref_part_meshb_long(ref_mmap, version, nnode), "nnode");
+    RSS(ref_mmap_int(ref_mmap, &ntype), "ntype");
     *ldim = 0;
     for (i = 0; i < ntype; i++) {
-      REIS(1, fread((unsigned char *)&type, 4, 1, file), "type");
+      RSS(ref_mmap_int(ref_mmap, &type), "type");
       RAB(1 <= type && type <= 2,
           "only types 1 (scalar) or 2 (vector) supported",
           { printf(" %d type\n", type); });
       if (1 == type) (*ldim) += 1;
-      if (2 == type) (*ldim) += dim;
+      if (2 == type) (*ldim) += *dim;
     }
   }
-  RSS(ref_mpi_bcast(ref_node_mpi(ref_node), &version, 1, REF_INT_TYPE),
-      "bcast version");
-  RSS(ref_mpi_bcast(ref_node_mpi(ref_node), &dim, 1, REF_INT_TYPE),
-      "bcast dim");
-  RSS(ref_mpi_bcast(ref_node_mpi(ref_node), &nnode, 1, REF_GLOB_TYPE),
-      "bcast nnode");
-  RSS(ref_mpi_bcast(ref_node_mpi(ref_node), ldim, 1, REF_INT_TYPE),
-      "bcast ldim");
+  RSS(ref_mpi_bcast(ref_mpi, dim, 1, REF_INT_TYPE), "bcast dim");
+  RSS(ref_mpi_bcast(ref_mpi, nnode, 1, REF_GLOB_TYPE), "bcast nnode");
+  RSS(ref_mpi_bcast(ref_mpi, ldim, 1, REF_INT_TYPE), "bcast ldim");
 
-  if ((nnode != ref_node_n_global(ref_node)) &&
-      (nnode / 2 != ref_node_n_global(ref_node))) {
+  if ((*nnode != ref_node_n_global(ref_node)) &&
+      (*nnode / 2 != ref_node_n_global(ref_node))) {
     if (ref_mpi_once(ref_mpi))
-      printf("file %ld ref_node " REF_GLOB_FMT " %s\n", nnode,
+      printf("file %ld ref_node " REF_GLOB_FMT " %s\n", *nnode,
              ref_node_n_global(ref_node), filename);
-    if (nnode > ref_node_n_global(ref_node)) {
+    if (*nnode > ref_node_n_global(ref_node)) {
       if (ref_mpi_once(ref_mpi))
         REF_WHERE("WARNING: global count mismatch, too many");
     } else {
@@ -3030,10 +3046,58 @@ REF_FCN static REF_STATUS ref_part_scalar_solb(REF_NODE ref_node, REF_INT *ldim,
     }
   }
 
+  return REF_SUCCESS;
+}
+
+/* copies width values per record of a broadcast section to owned nodes */
+REF_FCN static REF_STATUS ref_part_solb_section(
+    REF_NODE ref_node, REF_INT dim, REF_LONG nnode, REF_LONG nnode_read,
+    REF_INT section_size, REF_INT width, REF_DBL *data, REF_INT stride,
+    REF_DBL *scalar) {
+  REF_GLOB global;
+  REF_INT node, local, i;
+  for (node = 0; node < section_size; node++) {
+    global = node + nnode_read;
+    RXS(ref_node_local(ref_node, global, &local), REF_NOT_FOUND, "local");
+    if (REF_EMPTY != local) {
+      for (i = 0; i < width; i++) {
+        scalar[i + local * stride] = data[i + node * width];
+      }
+    }
+    if (2 == dim) {
+      global = nnode + (REF_GLOB)node + nnode_read;
+      RXS(ref_node_local(ref_node, global, &local), REF_NOT_FOUND, "local");
+      if (REF_EMPTY != local) {
+        for (i = 0; i < width; i++) {
+          scalar[i + local * stride] = data[i + node * width];
+        }
+      }
+    }
+  }
+  return REF_SUCCESS;
+}
+
+/* ref_mmap is only mapped and used on the once rank */
+REF_FCN static REF_STATUS ref_part_scalar_solb_mmap(REF_NODE ref_node,
+                                                    REF_INT *ldim,
+                                                    REF_DBL **scalar,
+                                                    const char *filename,
+                                                    REF_MMAP ref_mmap) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_FILEPOS next_position;
+  REF_INT chunk;
+  REF_DBL *data;
+  REF_INT section_size;
+  REF_INT dim;
+  REF_LONG nnode, nnode_read;
+
+  RSS(ref_part_solb_header(ref_node, filename, ref_mmap, &next_position, &dim,
+                           &nnode, ldim),
+      "header");
+
   ref_malloc(*scalar, (*ldim) * ref_node_max(ref_node), REF_DBL);
 
-  chunk =
-      (REF_INT)MAX(100000, nnode / (REF_LONG)ref_mpi_n(ref_node_mpi(ref_node)));
+  chunk = (REF_INT)MAX(100000, nnode / (REF_LONG)ref_mpi_n(ref_mpi));
   chunk = (REF_INT)MIN((REF_LONG)chunk, nnode);
 
   ref_malloc_init(data, (*ldim) * chunk, REF_DBL, -1.0);
@@ -3041,48 +3105,117 @@ REF_FCN static REF_STATUS ref_part_scalar_solb(REF_NODE ref_node, REF_INT *ldim,
   nnode_read = 0;
   while (nnode_read < nnode) {
     section_size = MIN(chunk, (REF_INT)(nnode - nnode_read));
-    if (ref_mpi_once(ref_node_mpi(ref_node))) {
-      REIS((*ldim) * section_size,
-           fread(data, sizeof(REF_DBL), (size_t)((*ldim) * section_size), file),
-           "dat");
-      RSS(ref_mpi_bcast(ref_node_mpi(ref_node), data, (*ldim) * chunk,
-                        REF_DBL_TYPE),
-          "bcast");
-    } else {
-      RSS(ref_mpi_bcast(ref_node_mpi(ref_node), data, (*ldim) * chunk,
-                        REF_DBL_TYPE),
-          "bcast");
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_mmap_dbls(ref_mmap, (*ldim) * section_size, data), "dat");
     }
-    for (node = 0; node < section_size; node++) {
-      global = node + nnode_read;
-      RXS(ref_node_local(ref_node, global, &local), REF_NOT_FOUND, "local");
-      if (REF_EMPTY != local) {
-        for (i = 0; i < *ldim; i++) {
-          (*scalar)[i + local * (*ldim)] = data[i + node * (*ldim)];
-        }
-      }
-      if (2 == dim) {
-        global = nnode + (REF_GLOB)node + nnode_read;
-        RXS(ref_node_local(ref_node, global, &local), REF_NOT_FOUND, "local");
-        if (REF_EMPTY != local) {
-          for (i = 0; i < *ldim; i++) {
-            (*scalar)[i + local * (*ldim)] = data[i + node * (*ldim)];
-          }
-        }
+    RSS(ref_mpi_bcast(ref_mpi, data, (*ldim) * chunk, REF_DBL_TYPE), "bcast");
+    RSS(ref_part_solb_section(ref_node, dim, nnode, nnode_read, section_size,
+                              *ldim, data, *ldim, *scalar),
+        "section");
+    nnode_read += (REF_LONG)section_size;
+  }
+
+  ref_free(data);
+
+  if (ref_mpi_once(ref_mpi))
+    REIS(next_position, ref_mmap_position(ref_mmap), "end location");
+  return REF_SUCCESS;
+}
+
+REF_FCN static REF_STATUS ref_part_scalar_solb(REF_NODE ref_node, REF_INT *ldim,
+                                               REF_DBL **scalar,
+                                               const char *filename) {
+  REF_MMAP ref_mmap = NULL;
+  if (ref_mpi_once(ref_node_mpi(ref_node)))
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+  RSS(ref_part_scalar_solb_mmap(ref_node, ldim, scalar, filename, ref_mmap),
+      "solb");
+  if (ref_mpi_once(ref_node_mpi(ref_node)))
+    RSS(ref_mmap_free(ref_mmap), "unmap");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_part_scalar_fields(REF_GRID ref_grid,
+                                          const char *filename, REF_INT nfield,
+                                          REF_INT *field, REF_INT stride,
+                                          REF_DBL *scalar) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_FILEPOS next_position;
+  REF_MMAP ref_mmap;
+  REF_INT chunk, section_size, dim, ldim, node, i;
+  REF_LONG nnode, nnode_read;
+  REF_DBL *data;
+  REF_BYTE *record;
+  REF_SIZE width;
+
+  RAS(0 < nfield && nfield <= stride, "nfield outside of stride");
+  ref_mmap = NULL;
+  if (ref_mpi_once(ref_mpi))
+    RSS(ref_mmap_create(&ref_mmap, filename, REF_FALSE), "map");
+  RSS(ref_part_solb_header(ref_node, filename, ref_mmap, &next_position, &dim,
+                           &nnode, &ldim),
+      "header");
+  for (i = 0; i < nfield; i++) {
+    RAB(0 <= field[i] && field[i] < ldim, "field outside of solb", {
+      printf("field %d of %d\n", field[i], ldim);
+      ref_mmap_free(ref_mmap);
+    });
+  }
+
+  chunk = (REF_INT)MAX(100000, nnode / (REF_LONG)ref_mpi_n(ref_mpi));
+  chunk = (REF_INT)MIN((REF_LONG)chunk, nnode);
+  width = (REF_SIZE)ldim * sizeof(REF_DBL);
+
+  ref_malloc_init(data, nfield * chunk, REF_DBL, -1.0);
+
+  nnode_read = 0;
+  while (nnode_read < nnode) {
+    section_size = MIN(chunk, (REF_INT)(nnode - nnode_read));
+    if (ref_mpi_once(ref_mpi)) { /* skipped columns are never copied */
+      for (node = 0; node < section_size; node++) {
+        RSS(ref_mmap_view(ref_mmap, width, &record), "record");
+        for (i = 0; i < nfield; i++)
+          memcpy(&(data[i + nfield * node]),
+                 &(record[sizeof(REF_DBL) * (REF_SIZE)field[i]]),
+                 sizeof(REF_DBL));
       }
     }
+    RSS(ref_mpi_bcast(ref_mpi, data, nfield * chunk, REF_DBL_TYPE), "bcast");
+    RSS(ref_part_solb_section(ref_node, dim, nnode, nnode_read, section_size,
+                              nfield, data, stride, scalar),
+        "section");
     nnode_read += (REF_LONG)section_size;
   }
 
   ref_free(data);
 
-  if (ref_mpi_once(ref_node_mpi(ref_node))) {
-    REIS(next_position, ftello(file), "end location");
-    REIS(0, fclose(file), "close file");
+  if (ref_mpi_once(ref_mpi)) {
+    REIS(next_position, ref_mmap_position(ref_mmap), "end location");
+    RSS(ref_mmap_free(ref_mmap), "unmap");
   }
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_part_field_index(REF_INT nname, const char **names,
+                                        const char *name, REF_INT *index) {
+  REF_INT i;
+  char *end;
+  long value;
+  *index = REF_EMPTY;
+  for (i = 0; i < nname; i++) {
+    if (0 == strcmp(names[i], name)) {
+      *index = i;
+      return REF_SUCCESS;
+    }
+  }
+  value = strtol(name, &end, 10);
+  if (end == name || '\0' != *end || value < 0 || value > REF_INT_MAX)
+    return REF_NOT_FOUND;
+  *index = (REF_INT)value;
+  return REF_SUCCESS;
+}
+
 REF_FCN static REF_STATUS ref_part_scalar_snap(REF_NODE ref_node, REF_INT *ldim,
                                                REF_DBL **scalar,
                                                const char *filename) {
@@ -3281,6 +3414,102 @@ REF_FCN REF_STATUS ref_part_scalar(REF_GRID ref_grid, REF_INT *ldim,
   return REF_FAILURE;
 }
 
+/* checkpoint header and adapt settings, padded for version 2 */
+REF_FCN static REF_STATUS ref_part_checkpoint_settings(REF_MMAP ref_mmap,
+                                                       REF_INT nsetting,
+                                                       REF_DBL *setting) {
+  REF_FILEPOS next_position = REF_EMPTY;
+  REF_FILEPOS key_pos[REF_IMPORT_MESHB_LAST_KEYWORD];
+  REF_BOOL available;
+  REF_INT version;
+  REF_LONG nsetting_long;
+
+  RSS(ref_import_meshb_header_mmap(ref_mmap, &version, key_pos), "header");
+  RSS(ref_import_meshb_jump(ref_mmap, version, key_pos,
+                            REF_IMPORT_MESHB_CHECKPOINT_KEYWORD, &available,
+                            &next_position),
+      "jump");
+  RAS(available, "checkpoint settings missing");
+  RSS(ref_part_meshb_long(ref_mmap, version, &nsetting_long), "nsetting");
+  /* version 2 ends before active_region, the last adapt setting */
+  RAS(nsetting == nsetting_long || nsetting - 1 == nsetting_long,
+      "checkpoint settings size");
+  setting[nsetting - 1] = (REF_DBL)REF_FALSE;
+  RSS(ref_mmap_dbls(ref_mmap, (REF_INT)nsetting_long, setting), "settings");
+  RAB(REF_GATHER_CHECKPOINT_VERSION == (REF_INT)setting[0] ||
+          2 == (REF_INT)setting[0],
+      "checkpoint version", { printf(" %d version\n", (REF_INT)setting[0]); });
+  if (nsetting - 1 == nsetting_long)
+    REIS(2, (REF_INT)setting[0], "short settings are only version 2");
+  REIS(next_position, ref_mmap_position(ref_mmap), "end location");
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_part_checkpoint(REF_GRID *ref_grid_ptr,
+                                       REF_MPI ref_mpi, const char *filename,
+                                       REF_BOOL *curvature_metric,
+                                       REF_BOOL *partitioned) {
+  REF_GRID ref_grid;
+  REF_NODE ref_node;
+  REF_MMAP ref_mmap;
+  REF_STATUS status;
+  REF_INT nsetting, ldim, naux, nproc, node, i;
+  REF_DBL setting[REF_GATHER_CHECKPOINT_HEADER + REF_ADAPT_NSETTING];
+  REF_DBL *state;
+
+  /* mapped once for the mesh, settings, and state, failures on the once
+   * rank are broadcast so the other ranks do not wait on it */
+  nsetting = REF_GATHER_CHECKPOINT_HEADER + REF_ADAPT_NSETTING;
+  ref_mmap = NULL;
+  status = REF_SUCCESS;
+  if (ref_mpi_once(ref_mpi)) {
+    status = ref_mmap_create(&ref_mmap, filename, REF_FALSE);
+    if (REF_SUCCESS == status)
+      status = ref_part_checkpoint_settings(ref_mmap, nsetting, setting);
+  }
+  RSS(ref_mpi_bcast(ref_mpi, &status, 1, REF_INT_TYPE), "bcast status");
+  if (REF_SUCCESS != status && NULL != ref_mmap) ref_mmap_free(ref_mmap);
+  RSS(status, "checkpoint settings");
+  RSS(ref_mpi_bcast(ref_mpi, setting, nsetting, REF_DBL_TYPE), "bcast");
+
+  RSS(ref_part_meshb_mmap(ref_grid_ptr, ref_mpi, ref_mmap), "checkpoint meshb");
+  ref_grid = *ref_grid_ptr;
+  ref_node = ref_grid_node(ref_grid);
+
+  nproc = (REF_INT)setting[1];
+  naux = (REF_INT)setting[2];
+  *curvature_metric = (REF_BOOL)setting[3];
+  RSS(ref_adapt_unpack(ref_grid->adapt,
+                       &(setting[REF_GATHER_CHECKPOINT_HEADER])),
+      "unpack");
+
+  RSS(ref_part_scalar_solb_mmap(ref_node, &ldim, &state, filename, ref_mmap),
+      "state");
+  if (ref_mpi_once(ref_mpi)) RSS(ref_mmap_free(ref_mmap), "unmap");
+  REIS(6 + naux + 2, ldim, "log metric, aux, age, part expected");
+  ref_node_naux(ref_node) = naux;
+  RSS(ref_node_resize_aux(ref_node), "size aux");
+  each_ref_node_valid_node(ref_node, node) {
+    RSS(ref_node_metric_set_log(ref_node, node, &(state[ldim * node])), "log");
+    for (i = 0; i < naux; i++)
+      ref_node_aux(ref_node, i, node) = state[6 + i + ldim * node];
+    ref_node_age(ref_node, node) = (REF_INT)state[6 + naux + ldim * node];
+  }
+
+  /* partition ids are only meaningful with the same number of ranks */
+  *partitioned = (nproc == ref_mpi_n(ref_grid_mpi(ref_grid)));
+  if (*partitioned) {
+    each_ref_node_valid_node(ref_node, node) {
+      ref_node_part(ref_node, node) = (REF_INT)state[7 + naux + ldim * node];
+    }
+    RSS(ref_migrate_shufflin(ref_grid), "restore partition");
+  }
+  ref_free(state);
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_part_by_extension(REF_GRID *ref_grid_ptr,
                                          REF_MPI ref_mpi,
                                          const char *filename) {
@@ -71,6 +71,12 @@ BEGIN_C_DECLORATION
 REF_FCN REF_STATUS ref_part_by_extension(REF_GRID *ref_grid, REF_MPI ref_mpi,
                                          const char *filename);
 
+/* reads ref_gather_checkpoint, restores the partition with the same ranks
+ * (partitioned is true when restored) */
+REF_FCN REF_STATUS ref_part_checkpoint(REF_GRID *ref_grid, REF_MPI ref_mpi,
+                                       const char *filename,
+                                       REF_BOOL *curvature_metric,
+                                       REF_BOOL *partitioned);
 REF_FCN REF_STATUS ref_part_cad_data(REF_GRID ref_grid, const char *filename);
 REF_FCN REF_STATUS ref_part_cad_association(REF_GRID ref_grid,
                                             const char *filename);
@@ -82,6 +88,15 @@ REF_FCN REF_STATUS ref_part_bamg_metric(REF_GRID ref_grid,
 REF_FCN REF_STATUS ref_part_metric(REF_NODE ref_node, const char *filename);
 REF_FCN REF_STATUS ref_part_scalar(REF_GRID ref_grid, REF_INT *ldim,
                                    REF_DBL **scalar, const char *filename);
+/* streams the listed field columns of a .solb into the caller's
+ * scalar[j + stride * node], unlisted columns are skipped */
+REF_FCN REF_STATUS ref_part_scalar_fields(REF_GRID ref_grid,
+                                          const char *filename, REF_INT nfield,
+                                          REF_INT *field, REF_INT stride,
+                                          REF_DBL *scalar);
+/* position of name in names or a non-negative integer column index */
+REF_FCN REF_STATUS ref_part_field_index(REF_INT nname, const char **names,
+                                        const char *name, REF_INT *index);
 
 END_C_DECLORATION
 
@@ -29,6 +29,7 @@
 #include "ref_cell.h"
 #include "ref_clump.h"
 #include "ref_collapse.h"
+#include "ref_compress.h"
 #include "ref_dict.h"
 #include "ref_edge.h"
 #include "ref_export.h"
@@ -60,7 +61,26 @@ int main(int argc, char *argv[]) {
 
     ref_mpi_stopwatch_start(ref_mpi);
     RSS(ref_part_by_extension(&import_grid, ref_mpi, argv[1]), "import");
-    ref_mpi_stopwatch_stop(ref_mpi, "import");
+    { /* throughput of the partitioned read */
+      REF_DBL seconds;
+      REF_LONG bytes = 0;
+      FILE *file;
+      RSS(ref_mpi_stopwatch_delta(ref_mpi, &seconds), "delta");
+      if (ref_mpi_once(ref_mpi)) {
+        file = fopen(argv[1], "rb");
+        RNS(file, "unable to open file");
+        REIS(0, fseeko(file, 0, SEEK_END), "seek end");
+        bytes = (REF_LONG)ftello(file);
+        REIS(0, fclose(file), "close");
+        seconds = MAX(seconds, 1.0e-9);
+        printf("import %.3f s %.2f MB/s " REF_GLOB_FMT " nodes %.3e nodes/s\n",
+               seconds, (REF_DBL)bytes / seconds / 1.0e6,
+               ref_node_n_global(ref_grid_node(import_grid)),
+               (REF_DBL)ref_node_n_global(ref_grid_node(import_grid)) /
+                   seconds);
+      }
+    }
+    ref_mpi_stopwatch_start(ref_mpi);
 
     snprintf(viz_file, 256, "ref_part_test_n%d_p%d.tec",
              ref_mpi_n(ref_grid_mpi(import_grid)),
@@ -238,6 +258,49 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
   }
 
+  { /* part packed tet brick lb8.ugrid */
+    REF_GRID export_grid, import_grid;
+    char grid_file[] = "ref_part_test_packed.lb8.ugrid";
+    REF_GLOB nnode = 0;
+    REF_LONG ntet = 0, ntet_import;
+    if (ref_mpi_once(ref_mpi)) {
+      FILE *file;
+      REF_BYTE *raw, *packed;
+      REF_SIZE raw_size, packed_size;
+      RSS(ref_fixture_tet_brick_grid(&export_grid, ref_mpi), "set up tet");
+      RSS(ref_export_by_extension(export_grid, grid_file), "export");
+      nnode = ref_node_n_global(ref_grid_node(export_grid));
+      ntet = ref_cell_n(ref_grid_tet(export_grid));
+      RSS(ref_grid_free(export_grid), "free");
+      file = fopen(grid_file, "r");
+      RNS(file, "unable to open file");
+      REIS(0, fseek(file, 0, SEEK_END), "end");
+      raw_size = (REF_SIZE)ftell(file);
+      rewind(file);
+      ref_malloc_size_t(raw, raw_size, REF_BYTE);
+      REIS(raw_size, fread(raw, sizeof(REF_BYTE), raw_size, file), "read");
+      REIS(0, fclose(file), "close");
+      RSS(ref_compress_pack(raw, raw_size, 0, &packed, &packed_size), "pack");
+      file = fopen(grid_file, "w");
+      RNS(file, "unable to open file");
+      REIS(packed_size, fwrite(packed, sizeof(REF_BYTE), packed_size, file),
+           "write");
+      REIS(0, fclose(file), "close");
+      ref_free(packed);
+      ref_free(raw);
+    }
+    RSS(ref_mpi_bcast(ref_mpi, &nnode, 1, REF_GLOB_TYPE), "bcast");
+    RSS(ref_mpi_bcast(ref_mpi, &ntet, 1, REF_LONG_TYPE), "bcast");
+    RSS(ref_part_by_extension(&import_grid, ref_mpi, grid_file), "import");
+    REIS(nnode, ref_node_n_global(ref_grid_node(import_grid)), "nnode");
+    RSS(ref_cell_ncell(ref_grid_tet(import_grid), ref_grid_node(import_grid),
+                       &ntet_import),
+        "ntet");
+    REIS(ntet, ntet_import, "ntet");
+    RSS(ref_grid_free(import_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
+  }
+
   { /* part tet brick b8.ugrid */
     REF_GRID export_grid, import_grid;
     char grid_file[] = "ref_part_test.b8.ugrid";
@@ -440,6 +503,70 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) REIS(0, remove(grid_file), "test clean up");
   }
 
+  { /* checkpoint node state and adapt settings */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_INT node;
+    REF_LONG ntet;
+    REF_DBL log_m[6];
+    REF_BOOL curvature_metric, partitioned;
+    char checkpoint[] = "ref_part_test_checkpoint.meshb";
+
+    RSS(ref_fixture_tet_grid(&ref_grid, ref_mpi), "set up tet");
+    ref_node = ref_grid_node(ref_grid);
+    ref_node_naux(ref_node) = 2;
+    RSS(ref_node_resize_aux(ref_node), "size aux");
+    each_ref_node_valid_node(ref_node, node) {
+      REF_DBL g = (REF_DBL)ref_node_global(ref_node, node);
+      log_m[0] = 0.1 * g;
+      log_m[1] = 0.01;
+      log_m[2] = 0.0;
+      log_m[3] = 0.2;
+      log_m[4] = 0.0;
+      log_m[5] = -0.3 * g;
+      RSS(ref_node_metric_set_log(ref_node, node, log_m), "set log");
+      ref_node_aux(ref_node, 0, node) = 10.0 + g;
+      ref_node_aux(ref_node, 1, node) = 20.0 + g;
+      ref_node_age(ref_node, node) = 3 + (REF_INT)g;
+    }
+    ref_grid_adapt(ref_grid, split_ratio) = 1.7;
+    ref_grid_adapt(ref_grid, swap_max_degree) = 11;
+    ref_grid_adapt(ref_grid, unlock_tet) = REF_TRUE;
+    ref_grid_adapt(ref_grid, timing_level) = 2;
+    RSS(ref_gather_checkpoint(ref_grid, REF_TRUE, checkpoint), "save");
+    RSS(ref_grid_free(ref_grid), "free");
+
+    curvature_metric = REF_FALSE;
+    partitioned = REF_FALSE;
+    RSS(ref_part_checkpoint(&ref_grid, ref_mpi, checkpoint, &curvature_metric,
+                            &partitioned),
+        "load");
+    REIS(REF_TRUE, curvature_metric, "curvature metric");
+    REIS(REF_TRUE, partitioned, "same ranks");
+    ref_node = ref_grid_node(ref_grid);
+    REIS(4, ref_node_n_global(ref_node), "nodes");
+    RSS(ref_cell_ncell(ref_grid_tet(ref_grid), ref_node, &ntet), "ntet");
+    REIS(1, ntet, "tet");
+    REIS(2, ref_node_naux(ref_node), "naux");
+    each_ref_node_valid_node(ref_node, node) {
+      REF_DBL g = (REF_DBL)ref_node_global(ref_node, node);
+      RSS(ref_node_metric_get_log(ref_node, node, log_m), "get log");
+      RWDS(0.1 * g, log_m[0], -1, "m0");
+      RWDS(0.01, log_m[1], -1, "m1");
+      RWDS(0.2, log_m[3], -1, "m3");
+      RWDS(-0.3 * g, log_m[5], -1, "m5");
+      RWDS(10.0 + g, ref_node_aux(ref_node, 0, node), -1, "aux0");
+      RWDS(20.0 + g, ref_node_aux(ref_node, 1, node), -1, "aux1");
+      REIS(3 + (REF_INT)g, ref_node_age(ref_node, node), "age");
+    }
+    RWDS(1.7, ref_grid_adapt(ref_grid, split_ratio), -1, "split ratio");
+    REIS(11, ref_grid_adapt(ref_grid, swap_max_degree), "swap degree");
+    REIS(REF_TRUE, ref_grid_adapt(ref_grid, unlock_tet), "unlock");
+    REIS(0, ref_grid_adapt(ref_grid, timing_level), "timing not saved");
+    RSS(ref_grid_free(ref_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(checkpoint), "test clean up");
+  }
+
   { /* metric */
     REF_GRID ref_grid;
     char metric_file[] = "ref_part_test.metric";
@@ -635,6 +762,64 @@ int main(int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) REIS(0, remove(meshb), "test clean up");
   }
 
+  { /* selected .solb fields */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_INT ldim, node, i;
+    REF_INT field[2] = {2, 0};
+    REF_DBL *scalar;
+    char meshb[] = "ref_part_test_fields.meshb";
+    char solb[] = "ref_part_test_fields.solb";
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "set up tet");
+    ref_node = ref_grid_node(ref_grid);
+    RSS(ref_gather_by_extension(ref_grid, meshb), "gather meshb");
+    ldim = 3;
+    ref_malloc(scalar, ldim * ref_node_max(ref_node), REF_DBL);
+    each_ref_node_valid_node(ref_node, node) {
+      for (i = 0; i < ldim; i++)
+        scalar[i + ldim * node] =
+            (REF_DBL)i + 10.0 * (REF_DBL)ref_node_global(ref_node, node);
+    }
+    RSS(ref_gather_scalar_by_extension(ref_grid, ldim, scalar, NULL, solb),
+        "gather solb");
+    ref_free(scalar);
+    RSS(ref_grid_free(ref_grid), "free");
+    RSS(ref_part_by_extension(&ref_grid, ref_mpi, meshb), "part meshb");
+    ref_node = ref_grid_node(ref_grid);
+    ref_malloc_init(scalar, 3 * ref_node_max(ref_node), REF_DBL, -1.0);
+    RSS(ref_part_scalar_fields(ref_grid, solb, 2, field, 3, scalar),
+        "part fields");
+    each_ref_node_valid_node(ref_node, node) {
+      RWDS(2.0 + 10.0 * (REF_DBL)ref_node_global(ref_node, node),
+           scalar[0 + 3 * node], -1, "field 2");
+      RWDS(10.0 * (REF_DBL)ref_node_global(ref_node, node),
+           scalar[1 + 3 * node], -1, "field 0");
+      RWDS(-1.0, scalar[2 + 3 * node], -1, "untouched");
+    }
+    field[0] = 3;
+    REIS(REF_FAILURE,
+         ref_part_scalar_fields(ref_grid, solb, 1, field, 3, scalar),
+         "expected out of range");
+    ref_free(scalar);
+    RSS(ref_grid_free(ref_grid), "free");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(solb), "test clean up");
+    if (ref_mpi_once(ref_mpi)) REIS(0, remove(meshb), "test clean up");
+  }
+
+  { /* field names and indexes */
+    const char *names[] = {"rho", "u", "v", "w", "p"};
+    REF_INT index;
+    RSS(ref_part_field_index(5, names, "p", &index), "name");
+    REIS(4, index, "p");
+    RSS(ref_part_field_index(5, names, "7", &index), "integer");
+    REIS(7, index, "7");
+    REIS(REF_NOT_FOUND, ref_part_field_index(5, names, "mach", &index),
+         "unknown");
+    REIS(REF_EMPTY, index, "unknown");
+    REIS(REF_NOT_FOUND, ref_part_field_index(0, NULL, "-1", &index),
+         "negative");
+  }
+
   /* gather/part FEBRICK .plt by extension */
   {
     REF_GRID ref_grid;
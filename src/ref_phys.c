@@ -1727,24 +1727,87 @@ REF_FCN REF_STATUS ref_phys_wall_distance_static(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
+/* bisect wall faces along the longest centroid extent until each chunk has at
+ * most max_chunk faces, permuting order so chunks are contiguous */
+REF_FCN static REF_STATUS ref_phys_wall_chunk(REF_INT node_per, REF_DBL *xyz,
+                                              REF_INT *order, REF_INT first,
+                                              REF_INT n, REF_INT max_chunk,
+                                              REF_INT *nchunk,
+                                              REF_INT *chunk_first) {
+  REF_DBL *coord, low[3], high[3], centroid;
+  REF_INT *sorted, *permuted;
+  REF_INT i, j, node, dir, half;
+
+  if (n <= max_chunk) {
+    chunk_first[*nchunk] = first;
+    (*nchunk)++;
+    return REF_SUCCESS;
+  }
+
+  for (j = 0; j < 3; j++) {
+    low[j] = REF_DBL_MAX;
+    high[j] = -REF_DBL_MAX;
+  }
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < 3; j++) {
+      centroid = 0.0;
+      for (node = 0; node < node_per; node++) {
+        centroid += xyz[j + 3 * node + 3 * node_per * order[first + i]];
+      }
+      centroid /= (REF_DBL)node_per;
+      low[j] = MIN(low[j], centroid);
+      high[j] = MAX(high[j], centroid);
+    }
+  }
+  dir = 0;
+  if (high[1] - low[1] > high[dir] - low[dir]) dir = 1;
+  if (high[2] - low[2] > high[dir] - low[dir]) dir = 2;
+
+  ref_malloc(coord, n, REF_DBL);
+  ref_malloc(sorted, n, REF_INT);
+  ref_malloc(permuted, n, REF_INT);
+  for (i = 0; i < n; i++) {
+    coord[i] = 0.0;
+    for (node = 0; node < node_per; node++) {
+      coord[i] += xyz[dir + 3 * node + 3 * node_per * order[first + i]];
+    }
+  }
+  RSS(ref_sort_heap_dbl(n, coord, sorted), "sort centroids");
+  for (i = 0; i < n; i++) permuted[i] = order[first + sorted[i]];
+  for (i = 0; i < n; i++) order[first + i] = permuted[i];
+  ref_free(permuted);
+  ref_free(sorted);
+  ref_free(coord);
+
+  half = n / 2;
+  RSS(ref_phys_wall_chunk(node_per, xyz, order, first, half, max_chunk, nchunk,
+                          chunk_first),
+      "low half");
+  RSS(ref_phys_wall_chunk(node_per, xyz, order, first + half, n - half,
+                          max_chunk, nchunk, chunk_first),
+      "high half");
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_phys_wall_distance(REF_GRID ref_grid, REF_DICT ref_dict,
                                           REF_DBL *distance) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
-  REF_INT nowned, nbalance, nstationary, *stationary;
-  REF_INT ncell, local_ncell, *part_ncell, part_complete, max_ncell;
-  REF_INT nnode, part;
+  REF_INT local_ncell, local_node_per, node_per;
+  REF_DBL *local_xyz, *ordered_xyz;
+  REF_INT *order, *chunk_first, local_nchunk, nchunk;
+  REF_INT *part_nchunk, *part_nsphere, *chunk_part;
+  REF_DBL *local_sphere, *sphere;
+  REF_INT max_chunk = 1024;
+  REF_SEARCH chunk_search, local_search;
+  REF_LIST ref_list;
   REF_INT a_total, b_total;
-  REF_INT *a_size, *b_size;
-  REF_INT *a_next;
-  REF_DBL *a_xyz, *b_xyz;
-  REF_DBL *a_dist, *b_dist;
-  REF_DBL *local_xyz, *xyz;
-  REF_INT local_node_per, node_per;
-  REF_INT node, cell;
-  REF_INT *permutation, i;
-  REF_SEARCH ref_search;
-  REF_DBL center[3], radius;
+  REF_INT *a_size, *b_size, *a_next, *a_node, *last_node;
+  REF_DBL *a_query, *b_query, *a_dist, *b_dist;
+  REF_INT node, cell, chunk, item, part, i, j, k;
+  REF_INT *permutation;
+  REF_DBL center[3], radius, low[3], high[3];
   REF_DBL scale = 1.0 + 1.0e-8;
 
   if (ref_grid_twod(ref_grid)) {
@@ -1753,47 +1816,151 @@ REF_FCN REF_STATUS ref_phys_wall_distance(REF_GRID ref_grid, REF_DICT ref_dict,
     node_per = 3;
   }
 
-  ref_malloc_init(a_size, ref_mpi_n(ref_mpi), REF_INT, 0);
-  ref_malloc_init(b_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  RSS(ref_phys_local_wall(ref_grid, ref_dict, &local_node_per, &local_ncell,
+                          &local_xyz),
+      "local wall");
+  REIS(node_per, local_node_per, "node_per miss match");
 
-  nowned = 0;
-  each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
-      nowned++;
+  /* reorder local wall faces into spatially compact chunks */
+  ref_malloc(order, local_ncell, REF_INT);
+  for (cell = 0; cell < local_ncell; cell++) order[cell] = cell;
+  ref_malloc(chunk_first, local_ncell + 1, REF_INT);
+  local_nchunk = 0;
+  if (local_ncell > 0) {
+    RSS(ref_phys_wall_chunk(node_per, local_xyz, order, 0, local_ncell,
+                            max_chunk, &local_nchunk, chunk_first),
+        "chunk");
+  }
+  chunk_first[local_nchunk] = local_ncell;
+  ref_malloc(ordered_xyz, 3 * node_per * local_ncell, REF_DBL);
+  for (cell = 0; cell < local_ncell; cell++) {
+    for (i = 0; i < 3 * node_per; i++) {
+      ordered_xyz[i + 3 * node_per * cell] =
+          local_xyz[i + 3 * node_per * order[cell]];
     }
   }
-  /* limit the nodes that are balanced to prevent all2all overload */
-  nbalance = MIN(nowned, REF_INT_MAX / ref_mpi_n(ref_mpi));
+  ref_free(local_xyz);
+  local_xyz = ordered_xyz;
+  ref_free(order);
 
-  /* count the balanced nodes based on destination, count stationary */
-  nnode = 0;
-  nstationary = 0;
-  each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
-      if (nnode < nbalance) {
-        part = ref_part_implicit(nbalance, ref_mpi_n(ref_mpi), nnode);
-        if (ref_mpi_rank(ref_mpi) == part) {
-          nstationary++;
-        } else {
-          a_size[part]++;
+  /* publish a bounding sphere of each local chunk to every rank */
+  ref_malloc(local_sphere, 4 * local_nchunk, REF_DBL);
+  for (chunk = 0; chunk < local_nchunk; chunk++) {
+    for (j = 0; j < 3; j++) {
+      low[j] = REF_DBL_MAX;
+      high[j] = -REF_DBL_MAX;
+    }
+    for (cell = chunk_first[chunk]; cell < chunk_first[chunk + 1]; cell++) {
+      for (i = 0; i < node_per; i++) {
+        for (j = 0; j < 3; j++) {
+          low[j] = MIN(low[j], local_xyz[j + 3 * i + 3 * node_per * cell]);
+          high[j] = MAX(high[j], local_xyz[j + 3 * i + 3 * node_per * cell]);
         }
-        nnode++;
       }
     }
+    radius = 0.0;
+    for (j = 0; j < 3; j++) {
+      local_sphere[j + 4 * chunk] = 0.5 * (low[j] + high[j]);
+      radius += pow(0.5 * (high[j] - low[j]), 2);
+    }
+    local_sphere[3 + 4 * chunk] = scale * sqrt(radius);
+  }
+  ref_free(chunk_first);
+
+  ref_malloc(part_nchunk, ref_mpi_n(ref_mpi), REF_INT);
+  RSS(ref_mpi_allgather(ref_mpi, &local_nchunk, part_nchunk, REF_INT_TYPE),
+      "allgather part nchunk");
+  ref_malloc(part_nsphere, ref_mpi_n(ref_mpi), REF_INT);
+  nchunk = 0;
+  each_ref_mpi_part(ref_mpi, part) {
+    part_nsphere[part] = 4 * part_nchunk[part];
+    nchunk += part_nchunk[part];
+  }
+  ref_malloc(sphere, 4 * nchunk, REF_DBL);
+  RSS(ref_mpi_allgatherv(ref_mpi, local_sphere, part_nsphere, sphere,
+                         REF_DBL_TYPE),
+      "allgatherv chunk spheres");
+  ref_free(part_nsphere);
+  ref_free(local_sphere);
+  ref_malloc(chunk_part, nchunk, REF_INT);
+  chunk = 0;
+  each_ref_mpi_part(ref_mpi, part) {
+    for (i = 0; i < part_nchunk[part]; i++) {
+      chunk_part[chunk] = part;
+      chunk++;
+    }
+  }
+  ref_free(part_nchunk);
+
+  /* permutation randomizes tree insertion to improve balance/reduce depth */
+  RSS(ref_search_create(&chunk_search, nchunk), "make chunk search");
+  ref_malloc(permutation, nchunk, REF_INT);
+  RSS(ref_sort_shuffle(nchunk, permutation), "shuffle");
+  for (i = 0; i < nchunk; i++) {
+    chunk = permutation[i];
+    RSS(ref_search_insert(chunk_search, chunk, &(sphere[4 * chunk]),
+                          sphere[3 + 4 * chunk]),
+        "ins");
+  }
+  ref_free(permutation);
+
+  RSS(ref_search_create(&local_search, local_ncell), "make local search");
+  ref_malloc(permutation, local_ncell, REF_INT);
+  RSS(ref_sort_shuffle(local_ncell, permutation), "shuffle");
+  for (i = 0; i < local_ncell; i++) {
+    cell = permutation[i];
+    RSS(ref_node_bounding_sphere_xyz(&(local_xyz[3 * node_per * cell]),
+                                     node_per, center, &radius),
+        "bound");
+    RSS(ref_search_insert(local_search, cell, center, scale * radius), "ins");
+  }
+  ref_free(permutation);
+
+  /* the nearest chunk sphere bounds the distance from above, then the exact
+   * local distance tightens that bound before any remote query */
+  each_ref_node_valid_node(ref_node, node) {
+    distance[node] = REF_DBL_MAX;
+    if (!ref_node_owned(ref_node, node)) continue;
+    RSS(ref_search_trim_radius(chunk_search, ref_node_xyz_ptr(ref_node, node),
+                               &(distance[node])),
+        "chunk upper bound");
+    RSS(ref_search_nearest_element(local_search, node_per, local_xyz,
+                                   ref_node_xyz_ptr(ref_node, node),
+                                   &(distance[node])),
+        "local candidates");
+  }
+
+  /* query each rank once per node that has a chunk closer than the bound */
+  RSS(ref_list_create(&ref_list), "create list");
+  ref_malloc_init(a_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(b_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(last_node, ref_mpi_n(ref_mpi), REF_INT, REF_EMPTY);
+  each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_owned(ref_node, node)) continue;
+    RSS(ref_list_erase(ref_list), "erase");
+    RSS(ref_search_touching(chunk_search, ref_list,
+                            ref_node_xyz_ptr(ref_node, node), distance[node]),
+        "touching chunks");
+    each_ref_list_item(ref_list, item) {
+      part = chunk_part[ref_list_value(ref_list, item)];
+      if (ref_mpi_rank(ref_mpi) == part || node == last_node[part]) continue;
+      last_node[part] = node;
+      a_size[part]++;
+    }
   }
-  ref_malloc_init(stationary, nstationary, REF_INT, REF_EMPTY);
 
   RSS(ref_mpi_alltoall(ref_mpi, a_size, b_size, REF_INT_TYPE),
       "alltoall sizes");
 
   a_total = 0;
   each_ref_mpi_part(ref_mpi, part) { a_total += a_size[part]; }
-  ref_malloc(a_xyz, 3 * a_total, REF_DBL);
+  ref_malloc(a_node, a_total, REF_INT);
+  ref_malloc(a_query, 4 * a_total, REF_DBL);
   ref_malloc(a_dist, a_total, REF_DBL);
 
   b_total = 0;
   each_ref_mpi_part(ref_mpi, part) { b_total += b_size[part]; }
-  ref_malloc(b_xyz, 3 * b_total, REF_DBL);
+  ref_malloc(b_query, 4 * b_total, REF_DBL);
   ref_malloc(b_dist, b_total, REF_DBL);
 
   ref_malloc(a_next, ref_mpi_n(ref_mpi), REF_INT);
@@ -1802,121 +1969,65 @@ REF_FCN REF_STATUS ref_phys_wall_distance(REF_GRID ref_grid, REF_DICT ref_dict,
     a_next[part] = a_next[part - 1] + a_size[part - 1];
   }
 
-  /* fill the balanced nodes based on destination, fill stationary */
-  nnode = 0;
-  nstationary = 0;
+  each_ref_mpi_part(ref_mpi, part) { last_node[part] = REF_EMPTY; }
   each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
-      if (nnode < nbalance) {
-        part = ref_part_implicit(nbalance, ref_mpi_n(ref_mpi), nnode);
-        if (ref_mpi_rank(ref_mpi) == part) {
-          stationary[nstationary] = node;
-          nstationary++;
-        } else {
-          for (i = 0; i < 3; i++) {
-            a_xyz[i + 3 * a_next[part]] = ref_node_xyz(ref_node, i, node);
-          }
-          a_next[part]++;
-        }
-        nnode++;
+    if (!ref_node_owned(ref_node, node)) continue;
+    RSS(ref_list_erase(ref_list), "erase");
+    RSS(ref_search_touching(chunk_search, ref_list,
+                            ref_node_xyz_ptr(ref_node, node), distance[node]),
+        "touching chunks");
+    each_ref_list_item(ref_list, item) {
+      part = chunk_part[ref_list_value(ref_list, item)];
+      if (ref_mpi_rank(ref_mpi) == part || node == last_node[part]) continue;
+      last_node[part] = node;
+      k = a_next[part];
+      a_node[k] = node;
+      for (i = 0; i < 3; i++) {
+        a_query[i + 4 * k] = ref_node_xyz(ref_node, i, node);
       }
+      a_query[3 + 4 * k] = distance[node];
+      a_next[part]++;
     }
   }
+  RSS(ref_list_free(ref_list), "free list");
+  ref_free(last_node);
 
-  RSS(ref_mpi_alltoallv(ref_mpi, a_xyz, a_size, b_xyz, b_size, 3, REF_DBL_TYPE),
-      "alltoallv xyz");
-
-  for (node = 0; node < b_total; node++) {
-    b_dist[node] = REF_DBL_MAX;
-  }
-  each_ref_node_valid_node(ref_node, node) { distance[node] = REF_DBL_MAX; }
-
-  RSS(ref_phys_local_wall(ref_grid, ref_dict, &local_node_per, &local_ncell,
-                          &local_xyz),
-      "local wall");
-  REIS(node_per, local_node_per, "node_per miss match");
-
-  ref_malloc(part_ncell, ref_mpi_n(ref_mpi), REF_INT);
-  RSS(ref_mpi_allgather(ref_mpi, &local_ncell, part_ncell, REF_INT_TYPE),
-      "allgather part ncell");
-
-  max_ncell = 1000000; /* (8 * 3 * node_per) bytes per element */
-
-  part_complete = 0;
-  while (part_complete < ref_mpi_n(ref_mpi)) {
-    xyz = NULL;
-    ncell = 0;
-    RSS(ref_phys_bcast_parts(ref_mpi, &part_complete, part_ncell, max_ncell,
-                             node_per, local_xyz, &ncell, &xyz),
-        "bcast part");
-
-    RSS(ref_search_create(&ref_search, ncell), "make search");
-    ref_malloc(permutation, ncell, REF_INT);
-    /* permutation randomizes tree insertion to improve balance/reduce depth */
-    RSS(ref_sort_shuffle(ncell, permutation), "shuffle");
-    for (i = 0; i < ncell; i++) {
-      cell = permutation[i];
-      RSS(ref_node_bounding_sphere_xyz(&(xyz[3 * node_per * cell]), node_per,
-                                       center, &radius),
-          "bound");
-      RSS(ref_search_insert(ref_search, cell, center, scale * radius), "ins");
-    }
-    ref_free(permutation);
-
-    for (i = 0; i < b_total; i++) {
-      RSS(ref_search_nearest_element(ref_search, node_per, xyz, &(b_xyz[3 * i]),
-                                     &(b_dist[i])),
-          "balanced candidates");
-    }
-    for (i = 0; i < nstationary; i++) {
-      node = stationary[i];
-      RSS(ref_search_nearest_element(
-              ref_search, node_per, xyz,
-              ref_node_xyz_ptr(ref_grid_node(ref_grid), node),
-              &(distance[node])),
-          "stationary candidates");
-    }
-    RSS(ref_search_free(ref_search), "free");
-
-    ref_free(xyz);
+  RSS(ref_mpi_alltoallv(ref_mpi, a_query, a_size, b_query, b_size, 4,
+                        REF_DBL_TYPE),
+      "alltoallv query");
+
+  /* the carried distance prunes the remote search to faces that improve it */
+  for (i = 0; i < b_total; i++) {
+    b_dist[i] = b_query[3 + 4 * i];
+    RSS(ref_search_nearest_element(local_search, node_per, local_xyz,
+                                   &(b_query[4 * i]), &(b_dist[i])),
+        "remote candidates");
   }
 
-  ref_free(part_ncell);
-  ref_free(local_xyz);
-
   RSS(ref_mpi_alltoallv(ref_mpi, b_dist, b_size, a_dist, a_size, 1,
                         REF_DBL_TYPE),
       "alltoallv dist");
 
-  a_next[0] = 0;
-  each_ref_mpi_worker(ref_mpi, part) {
-    a_next[part] = a_next[part - 1] + a_size[part - 1];
-  }
-  nnode = 0;
-  each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
-      if (nnode < nbalance) {
-        part = ref_part_implicit(nbalance, ref_mpi_n(ref_mpi), nnode);
-        if (ref_mpi_rank(ref_mpi) == part) {
-        } else {
-          distance[node] = a_dist[a_next[part]];
-          a_next[part]++;
-        }
-        nnode++;
-      }
-    }
+  for (i = 0; i < a_total; i++) {
+    node = a_node[i];
+    distance[node] = MIN(distance[node], a_dist[i]);
   }
 
   RSS(ref_node_ghost_dbl(ref_node, distance, 1), "ghost distance");
 
+  ref_free(a_next);
   ref_free(b_dist);
-  ref_free(b_xyz);
+  ref_free(b_query);
   ref_free(a_dist);
-  ref_free(a_xyz);
-  ref_free(a_next);
-  ref_free(stationary);
+  ref_free(a_query);
+  ref_free(a_node);
   ref_free(b_size);
   ref_free(a_size);
+  RSS(ref_search_free(local_search), "free");
+  RSS(ref_search_free(chunk_search), "free");
+  ref_free(chunk_part);
+  ref_free(sphere);
+  ref_free(local_xyz);
   return REF_SUCCESS;
 }
 
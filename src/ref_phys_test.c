@@ -1155,7 +1155,7 @@ int main(int argc, char *argv[]) {
 
     ref_mpi_stopwatch_stop(ref_mpi, "wall dist init");
     RSS(ref_phys_wall_distance(ref_grid, ref_dict, distance2), "store");
-    ref_mpi_stopwatch_stop(ref_mpi, "alltoall balanced wall dist");
+    ref_mpi_stopwatch_stop(ref_mpi, "pruned wall dist");
 
     if (argc <= 2) {
       each_ref_node_valid_node(ref_node, node) {
@@ -2308,6 +2308,49 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  { /* enclosed brick wall dist spans many chunks */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_DICT ref_dict;
+    REF_DBL *distance;
+    REF_DBL *distance2;
+    REF_INT node, id;
+    REF_INT n = 17;
+    char grid_file[] = "ref_phys_test_brick_wall_dist4.lb8.ugrid";
+    if (ref_mpi_once(ref_mpi)) {
+      RSS(ref_fixture_tet_brick_args_grid(&ref_grid, ref_mpi, 0, 1, 0, 2, 0, 3,
+                                          n, n, n),
+          "set up tet");
+      RSS(ref_export_by_extension(ref_grid, grid_file), "export");
+      RSS(ref_grid_free(ref_grid), "free");
+    }
+    RSS(ref_part_by_extension(&ref_grid, ref_mpi, grid_file), "import");
+    ref_node = ref_grid_node(ref_grid);
+
+    RSS(ref_dict_create(&ref_dict), "dict");
+    ref_malloc_init(distance, ref_node_max(ref_node), REF_DBL, -1.0);
+    ref_malloc_init(distance2, ref_node_max(ref_node), REF_DBL, -1.0);
+    for (id = 1; id <= 6; id++) {
+      RSS(ref_dict_store(ref_dict, id, 4000), "store");
+    }
+
+    RSS(ref_phys_wall_distance_static(ref_grid, ref_dict, distance), "store");
+
+    RSS(ref_phys_wall_distance(ref_grid, ref_dict, distance2), "store");
+
+    each_ref_node_valid_node(ref_node, node) {
+      RWDS(distance[node], distance2[node], -1, "static");
+    }
+
+    ref_free(distance2);
+    ref_free(distance);
+    ref_dict_free(ref_dict);
+    ref_grid_free(ref_grid);
+    if (ref_mpi_once(ref_mpi)) {
+      REIS(0, remove(grid_file), "test clean up");
+    }
+  }
+
   { /* USM3D BC Flags */
     REF_INT generic, usm3d;
 
@@ -422,27 +422,23 @@ REF_FCN static REF_STATUS ref_recon_l2_projection_hessian(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_recon_kexact_with_aux(REF_GLOB center_global,
-                                                    REF_CLOUD ref_cloud,
-                                                    REF_BOOL twod,
-                                                    REF_DBL *gradient,
-                                                    REF_DBL *hessian) {
-  REF_DBL geom[9], ab[90];
-  REF_DBL dx, dy, dz, dq;
+/* pseudo-inverse of the least-squares system, 9 weights (hessian then
+ * gradient) per cloud member except the center, applied to the member
+ * scalar minus the center scalar */
+REF_FCN static REF_STATUS ref_recon_kexact_weights(REF_GLOB center_global,
+                                                   REF_CLOUD ref_cloud,
+                                                   REF_BOOL twod,
+                                                   REF_DBL *weight) {
+  REF_DBL geom[9], *ab;
+  REF_DBL dx, dy, dz;
   REF_DBL *a, *q, *r;
-  REF_INT m, n;
+  REF_INT m, n, nrhs, rhs;
   REF_GLOB cloud_global;
-  REF_INT item, im, i, j;
+  REF_INT item, i, j;
   REF_DBL xyzs[4];
+  REF_STATUS status;
   REF_BOOL verbose = REF_FALSE;
 
-  for (im = 0; im < 6; im++) {
-    hessian[im] = 0.0;
-  }
-  for (im = 0; im < 3; im++) {
-    gradient[im] = 0.0;
-  }
-
   RSS(ref_cloud_item(ref_cloud, center_global, &item), "missing center");
   each_ref_cloud_aux(ref_cloud, i) {
     xyzs[i] = ref_cloud_aux(ref_cloud, i, item);
@@ -558,59 +554,37 @@ REF_FCN static REF_STATUS ref_recon_kexact_with_aux(REF_GLOB center_global,
   REIS(m, i, "A row miscount");
   RSS(ref_matrix_qr(m, n, a, q, r), "kexact lsq hess qr");
   if (verbose) RSS(ref_matrix_show_aqr(m, n, a, q, r), "show qr");
-  for (i = 0; i < 90; i++) ab[i] = 0.0;
+  /* solve R X = Q^T for the member columns, fake twod rows have dq = 0 */
+  nrhs = ref_cloud_n(ref_cloud) - 1;
+  ref_malloc_init(ab, 9 * (9 + nrhs), REF_DBL, 0.0);
   for (i = 0; i < 9; i++) {
     for (j = 0; j < 9; j++) {
       ab[i + 9 * j] += r[i + 9 * j];
     }
   }
-  i = 0;
-  if (twod) {
-    dq = 0;
+  i = m - nrhs;
+  for (rhs = 0; rhs < nrhs; rhs++) {
     for (j = 0; j < 9; j++) {
-      ab[j + 9 * 9] += q[i + m * j] * dq;
-    }
-    i++;
-    dq = 0;
-    for (j = 0; j < 9; j++) {
-      ab[j + 9 * 9] += q[i + m * j] * dq;
-    }
-    i++;
-    dq = 0;
-    for (j = 0; j < 9; j++) {
-      ab[j + 9 * 9] += q[i + m * j] * dq;
-    }
-    i++;
-    dq = 0;
-    for (j = 0; j < 9; j++) {
-      ab[j + 9 * 9] += q[i + m * j] * dq;
-    }
-    i++;
-  }
-  each_ref_cloud_global(ref_cloud, item, cloud_global) {
-    if (center_global == cloud_global) continue; /* skip self */
-    dq = ref_cloud_aux(ref_cloud, 3, item) - xyzs[3];
-    for (j = 0; j < 9; j++) {
-      ab[j + 9 * 9] += q[i + m * j] * dq;
+      ab[j + 9 * (9 + rhs)] = q[i + m * j];
     }
     i++;
   }
   REIS(m, i, "b row miscount");
-  if (verbose) RSS(ref_matrix_show_ab(9, 10, ab), "show");
-  RAISE(ref_matrix_solve_ab(9, 10, ab));
-  if (verbose) RSS(ref_matrix_show_ab(9, 10, ab), "show");
-  j = 9;
-  for (im = 0; im < 6; im++) {
-    hessian[im] = ab[im + 9 * j];
-  }
-  for (im = 0; im < 3; im++) {
-    gradient[im] = ab[im + 6 + 9 * j];
+  if (verbose) RSS(ref_matrix_show_ab(9, 9 + nrhs, ab), "show");
+  status = ref_matrix_solve_ab(9, 9 + nrhs, ab);
+  if (REF_SUCCESS == status) {
+    for (rhs = 0; rhs < nrhs; rhs++) {
+      for (j = 0; j < 9; j++) {
+        weight[j + 9 * rhs] = ab[j + 9 * (9 + rhs)];
+      }
+    }
   }
+  ref_free(ab);
   ref_free(r);
   ref_free(q);
   ref_free(a);
 
-  return REF_SUCCESS;
+  return status;
 }
 
 REF_FCN static REF_STATUS ref_recon_kexact_center(REF_DBL *xyz,
@@ -736,7 +710,7 @@ REF_FCN static REF_STATUS ref_recon_local_immediate_cloud(REF_CLOUD *one_layer,
           xyzs[0] = ref_node_xyz(ref_node, 0, target);
           xyzs[1] = ref_node_xyz(ref_node, 1, target);
           xyzs[2] = ref_node_xyz(ref_node, 2, target);
-          xyzs[3] = scalar[target];
+          xyzs[3] = (NULL == scalar) ? 0.0 : scalar[target];
           RSS(ref_cloud_store(one_layer[node], global, xyzs),
               "store could stencil");
         }
@@ -952,94 +926,378 @@ REF_FCN static REF_STATUS ref_recon_grow_cloud_one_layer(REF_CLOUD ref_cloud,
   return REF_SUCCESS;
 }
 
-REF_FCN static REF_STATUS ref_recon_kexact_gradient_hessian(REF_GRID ref_grid,
-                                                            REF_DBL *scalar,
-                                                            REF_DBL *gradient,
-                                                            REF_DBL *hessian) {
+REF_FCN static REF_STATUS ref_recon_halo_entry(REF_CLOUD ref_cloud,
+                                               REF_CLOUD *one_layer,
+                                               REF_NODE ref_node,
+                                               REF_GLOB global,
+                                               REF_INT *part) {
+  REF_INT item, pivot;
+  REF_GLOB global_pivot;
+  REF_STATUS ref_status;
+
+  /* off-rank members arrived through a ghost pivot, its owner has them */
+  *part = REF_EMPTY;
+  each_ref_cloud_global(ref_cloud, item, global_pivot) {
+    ref_status = ref_node_local(ref_node, global_pivot, &pivot);
+    if (REF_NOT_FOUND == ref_status) continue;
+    RSS(ref_status, "local search");
+    if (ref_node_owned(ref_node, pivot)) continue;
+    if (ref_cloud_has_global(one_layer[pivot], global)) {
+      *part = ref_node_part(ref_node, pivot);
+      return REF_SUCCESS;
+    }
+  }
+
+  return REF_NOT_FOUND;
+}
+
+REF_FCN static REF_STATUS ref_recon_create_halo(REF_RECON ref_recon,
+                                                REF_NODE ref_node,
+                                                REF_INT n_halo,
+                                                REF_INT *halo_entry,
+                                                REF_INT *halo_part,
+                                                REF_GLOB *halo_global) {
+  REF_MPI ref_mpi = ref_node_mpi(ref_node);
+  REF_INT *halo_next, *halo_size, *donor_size, *donor_node;
+  REF_GLOB *recept_global, *donor_global;
+  REF_INT halo, part, n_donor, donor, slot;
+
+  ref_malloc_init(halo_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  ref_malloc_init(donor_size, ref_mpi_n(ref_mpi), REF_INT, 0);
+  for (halo = 0; halo < n_halo; halo++) {
+    halo_size[halo_part[halo]]++;
+  }
+  RSS(ref_mpi_alltoall(ref_mpi, halo_size, donor_size, REF_INT_TYPE),
+      "alltoall sizes");
+  n_donor = 0;
+  each_ref_mpi_part(ref_mpi, part) { n_donor += donor_size[part]; }
+
+  /* halo slots grouped by donor part, values return in this order */
+  ref_malloc(halo_next, ref_mpi_n(ref_mpi), REF_INT);
+  halo_next[0] = 0;
+  each_ref_mpi_worker(ref_mpi, part) {
+    halo_next[part] = halo_next[part - 1] + halo_size[part - 1];
+  }
+  ref_malloc(recept_global, n_halo, REF_GLOB);
+  for (halo = 0; halo < n_halo; halo++) {
+    slot = halo_next[halo_part[halo]];
+    recept_global[slot] = halo_global[halo];
+    ref_recon->entry[halo_entry[halo]] = -1 - slot;
+    halo_next[halo_part[halo]]++;
+  }
+  ref_free(halo_next);
+
+  ref_malloc(donor_global, n_donor, REF_GLOB);
+  RSS(ref_mpi_alltoallv(ref_mpi, recept_global, halo_size, donor_global,
+                        donor_size, 1, REF_GLOB_TYPE),
+      "alltoallv global");
+  ref_free(recept_global);
+  ref_malloc(donor_node, n_donor, REF_INT);
+  for (donor = 0; donor < n_donor; donor++) {
+    RSS(ref_node_local(ref_node, donor_global[donor], &(donor_node[donor])),
+        "halo donor not local");
+  }
+  ref_free(donor_global);
+
+  ref_recon->n_halo = n_halo;
+  ref_recon->halo_size = halo_size;
+  ref_recon->n_donor = n_donor;
+  ref_recon->donor_size = donor_size;
+  ref_recon->donor_node = donor_node;
+
+  return REF_SUCCESS;
+}
+
+static void ref_recon_hash(REF_ULONG *hash, void *data, size_t size) {
+  unsigned char *bytes = (unsigned char *)data;
+  size_t byte;
+  for (byte = 0; byte < size; byte++)
+    *hash = (*hash ^ (REF_ULONG)bytes[byte]) * 1099511628211UL;
+}
+
+/* FNV-1a of the node globals, valid node xyz, and cell nodes */
+REF_FCN static REF_STATUS ref_recon_fingerprint(REF_GRID ref_grid,
+                                                REF_ULONG *fingerprint) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
-  REF_INT node, im;
+  REF_INT node, n_c2n;
+  REF_GLOB global;
+
+  if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_tri(ref_grid);
+
+  *fingerprint = 14695981039346656037UL;
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    global = ref_node_global(ref_node, node);
+    ref_recon_hash(fingerprint, &global, sizeof(REF_GLOB));
+    if (!ref_node_valid(ref_node, node)) continue;
+    ref_recon_hash(fingerprint, ref_node_xyz_ptr(ref_node, node),
+                   3 * sizeof(REF_DBL));
+  }
+  n_c2n = ref_cell_size_per(ref_cell) * ref_cell_max(ref_cell);
+  ref_recon_hash(fingerprint, ref_cell->c2n, (size_t)n_c2n * sizeof(REF_INT));
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_create(REF_RECON *ref_recon_ptr,
+                                    REF_GRID ref_grid) {
+  REF_RECON ref_recon;
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_CELL ref_cell = ref_grid_tet(ref_grid);
+  REF_INT node, i, item, local, max_entry, n_entry;
+  REF_INT n_halo, max_halo, *halo_entry, *halo_part;
+  REF_GLOB *halo_global, global;
   REF_CLOUD ref_cloud;
-  REF_DBL node_gradient[3], node_hessian[6];
+  REF_DBL *node_weight;
   REF_STATUS status;
   REF_CLOUD *one_layer;
   REF_INT layer;
 
   if (ref_grid_twod(ref_grid)) ref_cell = ref_grid_tri(ref_grid);
 
+  ref_malloc(*ref_recon_ptr, 1, REF_RECON_STRUCT);
+  ref_recon = (*ref_recon_ptr);
+
+  RSS(ref_recon_fingerprint(ref_grid, &(ref_recon->fingerprint)), "print");
+
   ref_malloc_init(one_layer, ref_node_max(ref_node), REF_CLOUD, NULL);
   each_ref_node_valid_node(ref_node, node) {
     RSS(ref_cloud_create(&(one_layer[node]), 4), "cloud storage");
   }
-
-  RSS(ref_recon_local_immediate_cloud(one_layer, ref_node, ref_cell, scalar),
+  RSS(ref_recon_local_immediate_cloud(one_layer, ref_node, ref_cell, NULL),
       "fill immediate cloud");
   RSS(ref_recon_ghost_cloud(one_layer, ref_node), "fill ghosts");
 
-  each_ref_node_valid_node(ref_node, node) {
-    if (ref_node_owned(ref_node, node)) {
-      /* use ref_cloud to get a unique list of halo(2) nodes */
-      RSS(ref_cloud_deep_copy(&ref_cloud, one_layer[node]), "create ref_cloud");
-      status = REF_INVALID;
-      for (layer = 2; status != REF_SUCCESS && layer <= 8; layer++) {
-        RSS(ref_recon_grow_cloud_one_layer(ref_cloud, one_layer, ref_node),
-            "grow");
-        status = ref_recon_kexact_with_aux(ref_node_global(ref_node, node),
-                                           ref_cloud, ref_grid_twod(ref_grid),
-                                           node_gradient, node_hessian);
-        if (REF_NOT_FOUND == status) {
-          ref_node_location(ref_node, node);
-          printf(
-              " caught %s, for %d layers to kexact cloud; "
-              "zero gradient and hessian\n",
-              "REF_NOT_FOUND", layer);
-          status = REF_SUCCESS;
-          break;
-        }
-        if (REF_DIV_ZERO == status && layer > 4) {
-          ref_node_location(ref_node, node);
-          printf(" caught %s, for %d layers to kexact cloud; retry\n",
-                 "REF_DIV_ZERO", layer);
-        }
-        if (REF_ILL_CONDITIONED == status && layer > 4) {
-          ref_node_location(ref_node, node);
-          printf(" caught %s, for %d layers to kexact cloud; retry\n",
-                 "REF_ILL_CONDITIONED", layer);
-        }
+  max_entry = 32 * ref_node_n(ref_node) + 1;
+  max_halo = 32;
+  n_entry = 0;
+  n_halo = 0;
+  ref_malloc_init(ref_recon->ptr, ref_node_max(ref_node) + 1, REF_INT, 0);
+  ref_malloc(ref_recon->entry, max_entry, REF_INT);
+  ref_malloc(ref_recon->weight, 9 * max_entry, REF_DBL);
+  ref_malloc(halo_entry, max_halo, REF_INT);
+  ref_malloc(halo_part, max_halo, REF_INT);
+  ref_malloc(halo_global, max_halo, REF_GLOB);
+
+  for (node = 0; node < ref_node_max(ref_node); node++) {
+    ref_recon->ptr[node] = n_entry;
+    if (!ref_node_valid(ref_node, node) || !ref_node_owned(ref_node, node))
+      continue;
+    /* use ref_cloud to get a unique list of halo(2) nodes */
+    RSS(ref_cloud_deep_copy(&ref_cloud, one_layer[node]), "create ref_cloud");
+    node_weight = NULL;
+    status = REF_INVALID;
+    for (layer = 2; status != REF_SUCCESS && layer <= 8; layer++) {
+      RSS(ref_recon_grow_cloud_one_layer(ref_cloud, one_layer, ref_node),
+          "grow");
+      ref_free(node_weight);
+      ref_malloc(node_weight, 9 * ref_cloud_n(ref_cloud), REF_DBL);
+      status = ref_recon_kexact_weights(ref_node_global(ref_node, node),
+                                        ref_cloud, ref_grid_twod(ref_grid),
+                                        node_weight);
+      if (REF_NOT_FOUND == status) {
+        ref_node_location(ref_node, node);
+        printf(
+            " caught %s, for %d layers to kexact cloud; "
+            "zero gradient and hessian\n",
+            "REF_NOT_FOUND", layer);
+        break;
       }
-      if (NULL != gradient) {
-        if (ref_grid_twod(ref_grid)) {
-          node_gradient[2] = 0.0;
-        }
-        for (im = 0; im < 3; im++) {
-          gradient[im + 3 * node] = node_gradient[im];
-        }
+      if (REF_DIV_ZERO == status && layer > 4) {
+        ref_node_location(ref_node, node);
+        printf(" caught %s, for %d layers to kexact cloud; retry\n",
+               "REF_DIV_ZERO", layer);
       }
-      if (NULL != hessian) {
-        if (ref_grid_twod(ref_grid)) {
-          node_hessian[2] = 0.0;
-          node_hessian[4] = 0.0;
-          node_hessian[5] = 0.0;
+      if (REF_ILL_CONDITIONED == status && layer > 4) {
+        ref_node_location(ref_node, node);
+        printf(" caught %s, for %d layers to kexact cloud; retry\n",
+               "REF_ILL_CONDITIONED", layer);
+      }
+    }
+    /* failed nodes keep an empty row, zero gradient and hessian */
+    if (REF_SUCCESS == status) {
+      if (n_entry + ref_cloud_n(ref_cloud) > max_entry) {
+        max_entry = MAX(2 * max_entry, n_entry + ref_cloud_n(ref_cloud));
+        ref_realloc(ref_recon->entry, max_entry, REF_INT);
+        ref_realloc(ref_recon->weight, 9 * max_entry, REF_DBL);
+      }
+      each_ref_cloud_global(ref_cloud, item, global) {
+        if (ref_node_global(ref_node, node) == global) continue; /* self */
+        for (i = 0; i < 9; i++) {
+          ref_recon->weight[i + 9 * n_entry] =
+              node_weight[i + 9 * (n_entry - ref_recon->ptr[node])];
         }
-        for (im = 0; im < 6; im++) {
-          hessian[im + 6 * node] = node_hessian[im];
+        status = ref_node_local(ref_node, global, &local);
+        if (REF_NOT_FOUND == status) {
+          if (n_halo >= max_halo) {
+            max_halo *= 2;
+            ref_realloc(halo_entry, max_halo, REF_INT);
+            ref_realloc(halo_part, max_halo, REF_INT);
+            ref_realloc(halo_global, max_halo, REF_GLOB);
+          }
+          RSS(ref_recon_halo_entry(ref_cloud, one_layer, ref_node, global,
+                                   &(halo_part[n_halo])),
+              "halo pivot");
+          halo_entry[n_halo] = n_entry;
+          halo_global[n_halo] = global;
+          n_halo++;
+          local = REF_EMPTY;
+        } else {
+          RSS(status, "local search");
         }
+        ref_recon->entry[n_entry] = local;
+        n_entry++;
       }
-      RSS(ref_cloud_free(ref_cloud), "free ref_cloud");
     }
+    ref_free(node_weight);
+    RSS(ref_cloud_free(ref_cloud), "free ref_cloud");
   }
+  ref_recon->ptr[ref_node_max(ref_node)] = n_entry;
 
   each_ref_node_valid_node(ref_node, node) {
     ref_cloud_free(one_layer[node]); /* no-op for null */
   }
   ref_free(one_layer);
 
+  RSS(ref_recon_create_halo(ref_recon, ref_node, n_halo, halo_entry,
+                            halo_part, halo_global),
+      "halo");
+  ref_free(halo_global);
+  ref_free(halo_part);
+  ref_free(halo_entry);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_free(REF_RECON ref_recon) {
+  if (NULL == (void *)ref_recon) return REF_NULL;
+  ref_free(ref_recon->donor_node);
+  ref_free(ref_recon->donor_size);
+  ref_free(ref_recon->halo_size);
+  ref_free(ref_recon->weight);
+  ref_free(ref_recon->entry);
+  ref_free(ref_recon->ptr);
+  ref_free(ref_recon);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_expired(REF_RECON ref_recon, REF_GRID ref_grid,
+                                     REF_BOOL *expired) {
+  REF_ULONG fingerprint;
+
+  RSS(ref_recon_fingerprint(ref_grid, &fingerprint), "print");
+  *expired = (fingerprint != ref_recon->fingerprint);
+  RSS(ref_mpi_all_or(ref_grid_mpi(ref_grid), expired), "any expired");
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_cache(REF_GRID ref_grid,
+                                   REF_RECON_RECONSTRUCTION recon,
+                                   REF_BOOL *cached) {
+  REF_BOOL expired;
+  *cached = REF_FALSE;
+  if (REF_RECON_KEXACT != recon) return REF_SUCCESS;
+  if (NULL != (void *)ref_grid_recon(ref_grid)) {
+    RSS(ref_recon_expired(ref_grid_recon(ref_grid), ref_grid, &expired),
+        "expired");
+    if (!expired) return REF_SUCCESS;
+    RSS(ref_recon_free(ref_grid_recon(ref_grid)), "free expired");
+    ref_grid_recon(ref_grid) = NULL;
+  }
+  RSS(ref_recon_create(&(ref_grid_recon(ref_grid)), ref_grid), "create");
+  *cached = REF_TRUE;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_uncache(REF_GRID ref_grid, REF_BOOL cached) {
+  /* already released by an adaptation pass or a later expired cache */
+  if (!cached || NULL == (void *)ref_grid_recon(ref_grid)) return REF_SUCCESS;
+  RSS(ref_recon_free(ref_grid_recon(ref_grid)), "free");
+  ref_grid_recon(ref_grid) = NULL;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_kexact(REF_GRID ref_grid, REF_INT ldim,
+                                    REF_DBL *scalar, REF_DBL *gradient,
+                                    REF_DBL *hessian) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
+  REF_RECON ref_recon = ref_grid_recon(ref_grid);
+  REF_INT node, entry, donor, i, im;
+  REF_DBL *halo, *donor_scalar, *value, *weight, dq;
+
+  /* weights are several KB per node, only kept when cached */
+  if (NULL == (void *)ref_recon) {
+    RSS(ref_recon_create(&ref_recon, ref_grid), "create");
+  }
+
+  ref_malloc(donor_scalar, ldim * ref_recon->n_donor, REF_DBL);
+  for (donor = 0; donor < ref_recon->n_donor; donor++) {
+    for (i = 0; i < ldim; i++) {
+      donor_scalar[i + ldim * donor] =
+          scalar[i + ldim * ref_recon->donor_node[donor]];
+    }
+  }
+  ref_malloc(halo, ldim * ref_recon->n_halo, REF_DBL);
+  RSS(ref_mpi_alltoallv(ref_mpi, donor_scalar, ref_recon->donor_size, halo,
+                        ref_recon->halo_size, ldim, REF_DBL_TYPE),
+      "alltoallv halo");
+  ref_free(donor_scalar);
+
+  each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_owned(ref_node, node)) continue;
+    for (i = 0; i < ldim; i++) {
+      if (NULL != gradient) {
+        for (im = 0; im < 3; im++) gradient[im + 3 * (i + ldim * node)] = 0.0;
+      }
+      if (NULL != hessian) {
+        for (im = 0; im < 6; im++) hessian[im + 6 * (i + ldim * node)] = 0.0;
+      }
+    }
+    for (entry = ref_recon->ptr[node]; entry < ref_recon->ptr[node + 1];
+         entry++) {
+      if (0 <= ref_recon->entry[entry]) {
+        value = &(scalar[ldim * ref_recon->entry[entry]]);
+      } else {
+        value = &(halo[ldim * (-1 - ref_recon->entry[entry])]);
+      }
+      weight = &(ref_recon->weight[9 * entry]);
+      for (i = 0; i < ldim; i++) {
+        dq = value[i] - scalar[i + ldim * node];
+        if (NULL != gradient) {
+          for (im = 0; im < 3; im++)
+            gradient[im + 3 * (i + ldim * node)] += weight[6 + im] * dq;
+        }
+        if (NULL != hessian) {
+          for (im = 0; im < 6; im++)
+            hessian[im + 6 * (i + ldim * node)] += weight[im] * dq;
+        }
+      }
+    }
+    if (ref_grid_twod(ref_grid)) {
+      for (i = 0; i < ldim; i++) {
+        if (NULL != gradient) gradient[2 + 3 * (i + ldim * node)] = 0.0;
+        if (NULL != hessian) {
+          hessian[2 + 6 * (i + ldim * node)] = 0.0;
+          hessian[4 + 6 * (i + ldim * node)] = 0.0;
+          hessian[5 + 6 * (i + ldim * node)] = 0.0;
+        }
+      }
+    }
+  }
+  ref_free(halo);
+
   if (NULL != gradient) {
-    RSS(ref_node_ghost_dbl(ref_node, gradient, 3), "update ghosts");
+    RSS(ref_node_ghost_dbl(ref_node, gradient, 3 * ldim), "update ghosts");
   }
 
   if (NULL != hessian) {
-    RSS(ref_node_ghost_dbl(ref_node, hessian, 6), "update ghosts");
+    RSS(ref_node_ghost_dbl(ref_node, hessian, 6 * ldim), "update ghosts");
+  }
+
+  if (ref_recon != ref_grid_recon(ref_grid)) {
+    RSS(ref_recon_free(ref_recon), "free");
   }
 
   return REF_SUCCESS;
@@ -1344,8 +1602,7 @@ REF_FCN REF_STATUS ref_recon_gradient(REF_GRID ref_grid, REF_DBL *scalar,
           "l2");
       break;
     case REF_RECON_KEXACT:
-      RSS(ref_recon_kexact_gradient_hessian(ref_grid, scalar, grad, NULL),
-          "k-exact");
+      RSS(ref_recon_kexact(ref_grid, 1, scalar, grad, NULL), "k-exact");
       break;
     case REF_RECON_LAST:
     default:
@@ -1429,8 +1686,7 @@ REF_FCN REF_STATUS ref_recon_signed_hessian(REF_GRID ref_grid, REF_DBL *scalar,
       ref_free(replace);
       break;
     case REF_RECON_KEXACT:
-      RSS(ref_recon_kexact_gradient_hessian(ref_grid, scalar, NULL, hessian),
-          "k-exact");
+      RSS(ref_recon_kexact(ref_grid, 1, scalar, NULL, hessian), "k-exact");
       break;
     case REF_RECON_LAST:
     default:
@@ -1448,6 +1704,94 @@ REF_FCN REF_STATUS ref_recon_hessian(REF_GRID ref_grid, REF_DBL *scalar,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_recon_gradient_many(REF_GRID ref_grid, REF_INT ldim,
+                                           REF_DBL *scalar, REF_DBL *grad,
+                                           REF_RECON_RECONSTRUCTION recon) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL *one, *one_grad;
+  REF_INT i, im, node;
+
+  if (REF_RECON_KEXACT == recon) {
+    RSS(ref_recon_kexact(ref_grid, ldim, scalar, grad, NULL), "k-exact");
+    return REF_SUCCESS;
+  }
+
+  ref_malloc(one, ref_node_max(ref_node), REF_DBL);
+  ref_malloc(one_grad, 3 * ref_node_max(ref_node), REF_DBL);
+  for (i = 0; i < ldim; i++) {
+    each_ref_node_valid_node(ref_node, node) {
+      one[node] = scalar[i + ldim * node];
+    }
+    RSS(ref_recon_gradient(ref_grid, one, one_grad, recon), "grad");
+    each_ref_node_valid_node(ref_node, node) {
+      for (im = 0; im < 3; im++)
+        grad[im + 3 * (i + ldim * node)] = one_grad[im + 3 * node];
+    }
+  }
+  ref_free(one_grad);
+  ref_free(one);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_signed_hessian_many(
+    REF_GRID ref_grid, REF_INT ldim, REF_DBL *scalar, REF_DBL *hessian,
+    REF_RECON_RECONSTRUCTION recon) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL *one, *one_hess;
+  REF_INT i, im, node;
+
+  if (REF_RECON_KEXACT == recon) {
+    RSS(ref_recon_kexact(ref_grid, ldim, scalar, NULL, hessian), "k-exact");
+    return REF_SUCCESS;
+  }
+
+  ref_malloc(one, ref_node_max(ref_node), REF_DBL);
+  ref_malloc(one_hess, 6 * ref_node_max(ref_node), REF_DBL);
+  for (i = 0; i < ldim; i++) {
+    each_ref_node_valid_node(ref_node, node) {
+      one[node] = scalar[i + ldim * node];
+    }
+    RSS(ref_recon_signed_hessian(ref_grid, one, one_hess, recon), "hess");
+    each_ref_node_valid_node(ref_node, node) {
+      for (im = 0; im < 6; im++)
+        hessian[im + 6 * (i + ldim * node)] = one_hess[im + 6 * node];
+    }
+  }
+  ref_free(one_hess);
+  ref_free(one);
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_recon_hessian_many(REF_GRID ref_grid, REF_INT ldim,
+                                          REF_DBL *scalar, REF_DBL *hessian,
+                                          REF_RECON_RECONSTRUCTION recon) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL diag_system[12], *m;
+  REF_INT i, node;
+
+  RSS(ref_recon_signed_hessian_many(ref_grid, ldim, scalar, hessian, recon),
+      "signed hess");
+
+  /* positive eigenvalues to make positive definite */
+  each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_owned(ref_node, node)) continue;
+    for (i = 0; i < ldim; i++) {
+      m = &(hessian[6 * (i + ldim * node)]);
+      RSS(ref_matrix_diag_m(m, diag_system), "decomp");
+      ref_matrix_eig(diag_system, 0) = ABS(ref_matrix_eig(diag_system, 0));
+      ref_matrix_eig(diag_system, 1) = ABS(ref_matrix_eig(diag_system, 1));
+      ref_matrix_eig(diag_system, 2) = ABS(ref_matrix_eig(diag_system, 2));
+      RSS(ref_matrix_form_m(diag_system, m), "re-form");
+    }
+  }
+
+  RSS(ref_node_ghost_dbl(ref_node, hessian, 6 * ldim), "update ghosts");
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_recon_normal(REF_GRID ref_grid, REF_INT node,
                                     REF_DBL *normal) {
   REF_NODE ref_node = ref_grid_node(ref_grid);
@@ -27,6 +27,8 @@ typedef enum REF_RECON_RECONSTRUCTIONS { /* 0 */ REF_RECON_L2PROJECTION,
                                          /* 1 */ REF_RECON_KEXACT,
                                          /* 2 */ REF_RECON_LAST
 } REF_RECON_RECONSTRUCTION;
+typedef struct REF_RECON_STRUCT REF_RECON_STRUCT;
+typedef REF_RECON_STRUCT *REF_RECON;
 END_C_DECLORATION
 
 #include "ref_cloud.h"
@@ -35,6 +37,38 @@ END_C_DECLORATION
 
 BEGIN_C_DECLORATION
 
+/* k-exact least-squares weights of one grid, rebuilt by each
+ * ref_recon_kexact call unless cached on the grid by ref_recon_cache */
+struct REF_RECON_STRUCT {
+  REF_ULONG fingerprint; /* node globals, xyz, and cells when formed */
+  REF_INT *ptr;          /* CSR rows of each owned node stencil */
+  REF_INT *entry;        /* local node, or -1 - halo index */
+  REF_DBL *weight;       /* 9 per entry, hessian then gradient */
+  REF_INT n_halo;
+  REF_INT *halo_size;
+  REF_INT n_donor;
+  REF_INT *donor_size;
+  REF_INT *donor_node;
+};
+
+REF_FCN REF_STATUS ref_recon_create(REF_RECON *ref_recon, REF_GRID ref_grid);
+REF_FCN REF_STATUS ref_recon_free(REF_RECON ref_recon);
+/* collective, compares a fingerprint of the grid with the one formed */
+REF_FCN REF_STATUS ref_recon_expired(REF_RECON ref_recon, REF_GRID ref_grid,
+                                     REF_BOOL *expired);
+/* keep k-exact weights on the grid over several calls, cached is set when
+ * this call formed them and the same caller should release them, collective,
+ * weights formed on a grid that has since changed are formed again */
+REF_FCN REF_STATUS ref_recon_cache(REF_GRID ref_grid,
+                                   REF_RECON_RECONSTRUCTION recon,
+                                   REF_BOOL *cached);
+REF_FCN REF_STATUS ref_recon_uncache(REF_GRID ref_grid, REF_BOOL cached);
+/* gradient and hessian of ldim scalars, gradient[d+3*(i+ldim*node)] and
+ * hessian[m+6*(i+ldim*node)] of scalar[i+ldim*node], either can be NULL */
+REF_FCN REF_STATUS ref_recon_kexact(REF_GRID ref_grid, REF_INT ldim,
+                                    REF_DBL *scalar, REF_DBL *gradient,
+                                    REF_DBL *hessian);
+
 /* public for one-ring/plugin-refine */
 REF_FCN REF_STATUS ref_recon_l2_projection_grad(REF_GRID ref_grid,
                                                 REF_DBL *scalar, REF_DBL *grad);
@@ -48,6 +82,16 @@ REF_FCN REF_STATUS ref_recon_signed_hessian(REF_GRID ref_grid, REF_DBL *scalar,
 REF_FCN REF_STATUS ref_recon_hessian(REF_GRID ref_grid, REF_DBL *scalar,
                                      REF_DBL *hessian,
                                      REF_RECON_RECONSTRUCTION recon);
+/* ldim interleaved scalars, one k-exact pass for all of them */
+REF_FCN REF_STATUS ref_recon_gradient_many(REF_GRID ref_grid, REF_INT ldim,
+                                           REF_DBL *scalar, REF_DBL *grad,
+                                           REF_RECON_RECONSTRUCTION recon);
+REF_FCN REF_STATUS ref_recon_signed_hessian_many(
+    REF_GRID ref_grid, REF_INT ldim, REF_DBL *scalar, REF_DBL *hessian,
+    REF_RECON_RECONSTRUCTION recon);
+REF_FCN REF_STATUS ref_recon_hessian_many(REF_GRID ref_grid, REF_INT ldim,
+                                          REF_DBL *scalar, REF_DBL *hessian,
+                                          REF_RECON_RECONSTRUCTION recon);
 
 REF_FCN REF_STATUS ref_recon_extrapolate_zeroth(REF_GRID ref_grid,
                                                 REF_DBL *recon,
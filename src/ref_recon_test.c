@@ -672,6 +672,130 @@ int main(int argc, char *argv[]) {
     RSS(ref_grid_free(ref_grid), "free");
   }
 
+  if (!ref_mpi_para(ref_mpi)) { /* seq k-exact two fields with cached weights */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_INT node, i;
+    REF_DBL *scalar, *gradient, *hessian;
+    REF_BOOL expired, cached;
+    REF_DBL tol = -1.0;
+
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+    ref_node = ref_grid_node(ref_grid);
+    ref_malloc(scalar, 2 * ref_node_max(ref_node), REF_DBL);
+    ref_malloc(gradient, 6 * ref_node_max(ref_node), REF_DBL);
+    ref_malloc(hessian, 12 * ref_node_max(ref_node), REF_DBL);
+    each_ref_node_valid_node(ref_node, node) {
+      REF_DBL x = ref_node_xyz(ref_node, 0, node);
+      REF_DBL y = ref_node_xyz(ref_node, 1, node);
+      REF_DBL z = ref_node_xyz(ref_node, 2, node);
+      scalar[0 + 2 * node] = 0.5 + 0.3 * x + 0.02 * x * y;
+      scalar[1 + 2 * node] = 0.1 * z + 0.06 * (0.5 * z * z);
+    }
+    RSS(ref_recon_kexact(ref_grid, 2, scalar, gradient, hessian), "k-exact");
+    RAS(NULL == ref_grid_recon(ref_grid), "temporary weights kept");
+    RSS(ref_recon_cache(ref_grid, REF_RECON_KEXACT, &cached), "cache");
+    RAS(cached, "not cached");
+    RAS(NULL != ref_grid_recon(ref_grid), "weights not cached");
+    RSS(ref_recon_gradient_many(ref_grid, 2, scalar, gradient,
+                                REF_RECON_KEXACT),
+        "grad many");
+    RSS(ref_recon_signed_hessian_many(ref_grid, 2, scalar, hessian,
+                                      REF_RECON_KEXACT),
+        "hess many");
+    each_ref_node_valid_node(ref_node, node) {
+      REF_DBL x = ref_node_xyz(ref_node, 0, node);
+      REF_DBL y = ref_node_xyz(ref_node, 1, node);
+      REF_DBL z = ref_node_xyz(ref_node, 2, node);
+      RWDS(0.3 + 0.02 * y, gradient[0 + 3 * 0 + 6 * node], tol, "dq0dx");
+      RWDS(0.02 * x, gradient[1 + 3 * 0 + 6 * node], tol, "dq0dy");
+      RWDS(0.1 + 0.06 * z, gradient[2 + 3 * 1 + 6 * node], tol, "dq1dz");
+      RWDS(0.02, hessian[1 + 6 * 0 + 12 * node], tol, "q0 m[1]");
+      RWDS(0.06, hessian[5 + 6 * 1 + 12 * node], tol, "q1 m[5]");
+    }
+
+    RSS(ref_recon_expired(ref_grid_recon(ref_grid), ref_grid, &expired),
+        "expired");
+    RAS(!expired, "unchanged grid expired");
+    ref_node_xyz(ref_node, 0, 0) += 0.01;
+    RSS(ref_recon_expired(ref_grid_recon(ref_grid), ref_grid, &expired),
+        "expired");
+    RAS(expired, "moved node did not expire");
+    RSS(ref_recon_cache(ref_grid, REF_RECON_KEXACT, &cached), "cache");
+    RAS(cached, "expired weights not formed again");
+    RSS(ref_recon_uncache(ref_grid, cached), "uncache");
+    ref_node_xyz(ref_node, 0, 0) -= 0.01;
+    RSS(ref_recon_cache(ref_grid, REF_RECON_KEXACT, &cached), "cache");
+    RAS(cached, "released weights not formed again");
+
+    /* single field matches batch */
+    each_ref_node_valid_node(ref_node, node) {
+      scalar[node] = scalar[1 + 2 * node];
+    }
+    RSS(ref_recon_kexact(ref_grid, 1, scalar, gradient, hessian), "k-exact");
+    each_ref_node_valid_node(ref_node, node) {
+      REF_DBL z = ref_node_xyz(ref_node, 2, node);
+      for (i = 0; i < 2; i++) {
+        RWDS(0.0, gradient[i + 3 * node], tol, "dq1dxy");
+      }
+      RWDS(0.1 + 0.06 * z, gradient[2 + 3 * node], tol, "dq1dz");
+      RWDS(0.06, hessian[5 + 6 * node], tol, "q1 m[5]");
+    }
+    RSS(ref_recon_uncache(ref_grid, cached), "uncache");
+    RAS(NULL == ref_grid_recon(ref_grid), "weights kept");
+
+    ref_free(hessian);
+    ref_free(gradient);
+    ref_free(scalar);
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
+  if (!ref_mpi_para(ref_mpi)) { /* seq l2 hessian many matches each field */
+    REF_GRID ref_grid;
+    REF_NODE ref_node;
+    REF_INT node, i, im;
+    REF_DBL *scalar, *one, *hessian, *one_hessian;
+    REF_DBL tol = -1.0;
+
+    RSS(ref_fixture_tet_brick_grid(&ref_grid, ref_mpi), "brick");
+    ref_node = ref_grid_node(ref_grid);
+    ref_malloc(scalar, 2 * ref_node_max(ref_node), REF_DBL);
+    ref_malloc(one, ref_node_max(ref_node), REF_DBL);
+    ref_malloc(hessian, 12 * ref_node_max(ref_node), REF_DBL);
+    ref_malloc(one_hessian, 6 * ref_node_max(ref_node), REF_DBL);
+    each_ref_node_valid_node(ref_node, node) {
+      REF_DBL x = ref_node_xyz(ref_node, 0, node);
+      REF_DBL y = ref_node_xyz(ref_node, 1, node);
+      REF_DBL z = ref_node_xyz(ref_node, 2, node);
+      scalar[0 + 2 * node] = 0.5 * x * x - 0.3 * y * z;
+      scalar[1 + 2 * node] = 0.1 * z + 0.06 * (0.5 * z * z);
+    }
+    RSS(ref_recon_hessian_many(ref_grid, 2, scalar, hessian,
+                               REF_RECON_L2PROJECTION),
+        "hess many");
+    for (i = 0; i < 2; i++) {
+      each_ref_node_valid_node(ref_node, node) {
+        one[node] = scalar[i + 2 * node];
+      }
+      RSS(ref_recon_hessian(ref_grid, one, one_hessian, REF_RECON_L2PROJECTION),
+          "hess");
+      each_ref_node_valid_node(ref_node, node) {
+        for (im = 0; im < 6; im++) {
+          RWDS(one_hessian[im + 6 * node], hessian[im + 6 * (i + 2 * node)],
+               tol, "many");
+        }
+      }
+    }
+
+    ref_free(one_hessian);
+    ref_free(hessian);
+    ref_free(one);
+    ref_free(scalar);
+
+    RSS(ref_grid_free(ref_grid), "free");
+  }
+
   { /* para file k-exact hessian for small variation */
     REF_GRID ref_grid;
     REF_NODE ref_node;
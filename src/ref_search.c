@@ -455,6 +455,59 @@ REF_FCN REF_STATUS ref_search_selection(REF_MPI ref_mpi, REF_INT n,
   return REF_SUCCESS;
 }
 
+REF_FCN REF_STATUS ref_search_weighted_selection(REF_MPI ref_mpi, REF_INT n,
+                                                 REF_DBL *elements,
+                                                 REF_DBL *weights,
+                                                 REF_DBL target,
+                                                 REF_DBL *value) {
+  REF_INT i, bisection;
+  REF_DBL below, total;
+  REF_DBL low_val, high_val, temp, mid_val;
+  total = 0.0;
+  low_val = REF_DBL_MAX;
+  high_val = REF_DBL_MIN;
+  for (i = 0; i < n; i++) {
+    total += weights[i];
+    low_val = MIN(low_val, elements[i]);
+    high_val = MAX(high_val, elements[i]);
+  }
+  RSS(ref_mpi_allsum(ref_mpi, &total, 1, REF_DBL_TYPE), "total");
+  temp = low_val;
+  RSS(ref_mpi_min(ref_mpi, &temp, &low_val, REF_DBL_TYPE), "min");
+  RSS(ref_mpi_bcast(ref_mpi, &low_val, 1, REF_DBL_TYPE), "bcast");
+  temp = high_val;
+  RSS(ref_mpi_max(ref_mpi, &temp, &high_val, REF_DBL_TYPE), "max");
+  RSS(ref_mpi_bcast(ref_mpi, &high_val, 1, REF_DBL_TYPE), "bcast");
+
+  if (target <= 0.0) {
+    *value = low_val;
+    return REF_SUCCESS;
+  }
+
+  if (target >= total) {
+    *value = high_val;
+    return REF_SUCCESS;
+  }
+
+  mid_val = 0.5 * (low_val + high_val); /* ensure initialized */
+  for (bisection = 0; bisection < 40; bisection++) {
+    mid_val = 0.5 * (low_val + high_val);
+    below = 0.0;
+    for (i = 0; i < n; i++) {
+      if (elements[i] <= mid_val) below += weights[i];
+    }
+
+    RSS(ref_mpi_allsum(ref_mpi, &below, 1, REF_DBL_TYPE), "sum");
+    if (below <= target) {
+      low_val = mid_val;
+    } else {
+      high_val = mid_val;
+    }
+  }
+  *value = mid_val;
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_search_distance2(REF_DBL *xyz0, REF_DBL *xyz1,
                                         REF_DBL *xyz, REF_DBL *distance) {
   REF_DBL dl[3], dxyz[3], len2, proj2, t;
@@ -71,6 +71,13 @@ REF_FCN REF_STATUS ref_search_selection(REF_MPI ref_mpi, REF_INT n,
                                         REF_DBL *elements, REF_LONG position,
                                         REF_DBL *value);
 
+/* value where the weight of elements at or below it first exceeds target */
+REF_FCN REF_STATUS ref_search_weighted_selection(REF_MPI ref_mpi, REF_INT n,
+                                                 REF_DBL *elements,
+                                                 REF_DBL *weights,
+                                                 REF_DBL target,
+                                                 REF_DBL *value);
+
 REF_FCN REF_STATUS ref_search_distance2(REF_DBL *xyz0, REF_DBL *xyz1,
                                         REF_DBL *xyz, REF_DBL *distance);
 REF_FCN REF_STATUS ref_search_distance3(REF_DBL *xyz0, REF_DBL *xyz1,
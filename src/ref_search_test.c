@@ -391,6 +391,29 @@ int main(int argc, char *argv[]) {
     ref_free(elements);
   }
 
+  { /* weighted selection */
+    REF_DBL elements[3] = {1.0, 2.0, 3.0};
+    REF_DBL weights[3] = {1.0, 1.0, 2.0};
+    REF_DBL nproc, value;
+    nproc = (REF_DBL)ref_mpi_n(ref_mpi);
+    RSS(ref_search_weighted_selection(ref_mpi, 3, elements, weights, 0.0,
+                                      &value),
+        "low");
+    RWDS(1.0, value, -1.0, "low expected");
+    RSS(ref_search_weighted_selection(ref_mpi, 3, elements, weights,
+                                      1.5 * nproc, &value),
+        "between");
+    RWDS(2.0, value, 1.0e-8, "second expected");
+    RSS(ref_search_weighted_selection(ref_mpi, 3, elements, weights,
+                                      3.0 * nproc, &value),
+        "heavy");
+    RWDS(3.0, value, 1.0e-8, "heavy expected");
+    RSS(ref_search_weighted_selection(ref_mpi, 3, elements, weights,
+                                      4.0 * nproc, &value),
+        "high");
+    RWDS(3.0, value, -1.0, "high expected");
+  }
+
   { /* dist to unit segment */
     REF_DBL xyz0[3] = {0.0, 0.0, 0.0};
     REF_DBL xyz1[3] = {1.0, 0.0, 0.0};
@@ -834,8 +834,10 @@ REF_FCN static REF_STATUS ref_smooth_no_geom_edge_improve(REF_GRID ref_grid,
       }
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++)
@@ -934,8 +936,10 @@ REF_FCN static REF_STATUS ref_smooth_meshlink_edge_improve(REF_GRID ref_grid,
       }
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++)
@@ -1116,8 +1120,10 @@ REF_FCN static REF_STATUS ref_smooth_no_geom_tri_improve(REF_GRID ref_grid,
       }
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++)
@@ -1214,8 +1220,10 @@ REF_FCN static REF_STATUS ref_smooth_meshlink_face_improve(REF_GRID ref_grid,
       }
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++)
@@ -1496,8 +1504,10 @@ REF_FCN REF_STATUS ref_smooth_tet_improve(REF_GRID ref_grid, REF_INT node) {
       return REF_SUCCESS;
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   for (ixyz = 0; ixyz < 3; ixyz++)
@@ -1669,8 +1679,10 @@ REF_FCN REF_STATUS ref_smooth_geom_edge(REF_GRID ref_grid, REF_INT node) {
       return REF_SUCCESS;
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   RSS(ref_geom_add(ref_geom, node, REF_GEOM_EDGE, id, &t_orig), "set t");
@@ -1801,8 +1813,10 @@ REF_FCN REF_STATUS ref_smooth_geom_face(REF_GRID ref_grid, REF_INT node) {
       return REF_SUCCESS;
     }
     backoff *= 0.5;
-    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status)
+    if (REF_EMPTY != interp_guess && REF_SUCCESS != interp_status) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
   }
 
   RSS(ref_geom_add(ref_geom, node, REF_GEOM_FACE, id, uv_orig), "set t");
@@ -1816,13 +1830,34 @@ REF_FCN REF_STATUS ref_smooth_geom_face(REF_GRID ref_grid, REF_INT node) {
   return REF_SUCCESS;
 }
 
+/* smoothing yield, a move is accepted when it is longer than this fraction
+ * of a unit metric length, shorter moves are jitter that leaves the
+ * smoothing pass busy without changing the mesh */
+#define REF_SMOOTH_TALLY_MOVE (0.2)
+REF_FCN static REF_STATUS ref_smooth_tally(REF_GRID ref_grid, REF_INT node,
+                                           REF_DBL *xyz) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_DBL m[6], dxyz[3];
+  REF_INT i;
+  for (i = 0; i < 3; i++) dxyz[i] = ref_node_xyz(ref_node, i, node) - xyz[i];
+  RSS(ref_node_metric_get(ref_node, node, m), "get");
+  ref_grid_adapt(ref_grid, attempted)++;
+  if (ref_matrix_vt_m_v(m, dxyz) >
+      REF_SMOOTH_TALLY_MOVE * REF_SMOOTH_TALLY_MOVE) {
+    ref_grid_adapt(ref_grid, accepted)++;
+    RSS(ref_grid_touch(ref_grid, node), "touch");
+  }
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
   REF_CELL ref_cell;
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_GEOM ref_geom = ref_grid_geom(ref_grid);
-  REF_INT geom, node;
+  REF_INT geom, node, i;
   REF_BOOL allowed, geom_node, geom_edge, geom_face, interior;
   REF_BOOL vol_val = REF_FALSE;
+  REF_DBL xyz[3];
 
   if (ref_grid_surf(ref_grid) || ref_grid_twod(ref_grid)) {
     ref_cell = ref_grid_tri(ref_grid);
@@ -1838,6 +1873,8 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
     /* don't move geom nodes */
     RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_NODE, &geom_node), "node check");
     if (geom_node) continue;
+    /* nothing changed nearby since the last sweep */
+    if (!ref_node_active(ref_node, node)) continue;
     /* next to ghost node, can't move */
     RSS(ref_smooth_local_cell_about(ref_cell, ref_node, node, &allowed),
         "para");
@@ -1845,11 +1882,13 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
       ref_node_age(ref_node, node)++;
       continue;
     }
+    for (i = 0; i < 3; i++) xyz[i] = ref_node_xyz(ref_node, i, node);
     if (ref_geom_meshlinked(ref_geom)) {
       RSS(ref_smooth_meshlink_edge_improve(ref_grid, node), "improve");
     } else {
       RSS(ref_smooth_geom_edge(ref_grid, node), "ideal node for edge");
     }
+    RSS(ref_smooth_tally(ref_grid, node, xyz), "tally");
     ref_node_age(ref_node, node) = 0;
   }
 
@@ -1863,6 +1902,7 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
     RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_EDGE, &geom_edge), "edge check");
     if (geom_edge) continue;
 
+    if (!ref_node_active(ref_node, node)) continue;
     RSS(ref_smooth_local_cell_about(ref_cell, ref_node, node, &allowed),
         "para");
     if (!allowed) {
@@ -1871,7 +1911,9 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
     }
 
     ref_node_age(ref_node, node) = 0;
+    for (i = 0; i < 3; i++) xyz[i] = ref_node_xyz(ref_node, i, node);
     RSS(ref_smooth_no_geom_edge_improve(ref_grid, node), "improve");
+    RSS(ref_smooth_tally(ref_grid, node, xyz), "tally");
   }
 
   if (vol_val) RSS(ref_validation_cell_volume(ref_grid), "vol nogeom edge");
@@ -1885,6 +1927,7 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
     /* don't move geom nodes */
     RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_EDGE, &geom_edge), "edge check");
     if (geom_edge) continue;
+    if (!ref_node_active(ref_node, node)) continue;
     /* next to ghost node, can't move */
     RSS(ref_smooth_local_cell_about(ref_cell, ref_node, node, &allowed),
         "para");
@@ -1892,11 +1935,13 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
       ref_node_age(ref_node, node)++;
       continue;
     }
+    for (i = 0; i < 3; i++) xyz[i] = ref_node_xyz(ref_node, i, node);
     if (ref_geom_meshlinked(ref_geom)) {
       RSS(ref_smooth_meshlink_face_improve(ref_grid, node), "improve");
     } else {
       RSS(ref_smooth_geom_face(ref_grid, node), "ideal node for face");
     }
+    RSS(ref_smooth_tally(ref_grid, node, xyz), "tally");
     ref_node_age(ref_node, node) = 0;
   }
 
@@ -1914,13 +1959,16 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
     RSS(ref_geom_is_a(ref_geom, node, REF_GEOM_FACE, &geom_face), "face check");
     if (geom_face) continue;
 
+    if (!ref_node_active(ref_node, node)) continue;
     RSS(ref_smooth_local_cell_about(ref_cell, ref_node, node, &allowed),
         "para");
     if (!allowed) {
       ref_node_age(ref_node, node)++;
       continue;
     }
+    for (i = 0; i < 3; i++) xyz[i] = ref_node_xyz(ref_node, i, node);
     RSS(ref_smooth_no_geom_tri_improve(ref_grid, node), "no geom smooth");
+    RSS(ref_smooth_tally(ref_grid, node, xyz), "tally");
   }
 
   if (vol_val) RSS(ref_validation_cell_volume(ref_grid), "vol face nogeom");
@@ -1932,6 +1980,7 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
   ref_cell = ref_grid_tet(ref_grid);
 
   each_ref_node_valid_node(ref_node, node) {
+    if (!ref_node_active(ref_node, node)) continue;
     RSS(ref_smooth_local_cell_about(ref_cell, ref_node, node, &allowed),
         "para");
     if (!allowed) {
@@ -1943,7 +1992,9 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
                ref_cell_node_empty(ref_grid_qua(ref_grid), node) &&
                !ref_cell_node_empty(ref_grid_tet(ref_grid), node);
     if (interior) {
+      for (i = 0; i < 3; i++) xyz[i] = ref_node_xyz(ref_node, i, node);
       RSS(ref_smooth_tet_improve(ref_grid, node), "ideal tet node");
+      RSS(ref_smooth_tally(ref_grid, node, xyz), "tally");
       ref_node_age(ref_node, node) = 0;
     }
   }
@@ -1958,12 +2009,31 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
 
   if (!ref_grid_surf(ref_grid)) {
     REF_DBL quality, min_quality = 0.10;
+    REF_DBL block[REF_NODE_QUALITY_BLOCK];
+    REF_INT first = REF_EMPTY;
+    REF_BOOL moved = REF_FALSE;
     REF_INT cell, cell_node, nodes[REF_CELL_MAX_SIZE_PER];
     each_ref_cell_valid_cell_with_nodes(ref_cell, cell, nodes) {
-      RSS(ref_node_tet_quality(ref_node, nodes, &quality), "qual");
+      if (REF_EMPTY == first || cell >= first + REF_NODE_QUALITY_BLOCK) {
+        first = cell;
+        RSS(ref_node_tet_quality_block(
+                ref_node,
+                MIN(REF_NODE_QUALITY_BLOCK, ref_cell_max(ref_cell) - first),
+                &(ref_cell_c2n(ref_cell, 0, first)),
+                ref_cell_size_per(ref_cell), block, NULL),
+            "block qual");
+        moved = REF_FALSE;
+      }
+      /* screened values are stale once a node in this block moves */
+      if (moved) {
+        RSS(ref_node_tet_quality(ref_node, nodes, &quality), "qual");
+      } else {
+        quality = block[cell - first];
+      }
       if (quality < min_quality) {
         each_ref_cell_cell_node(ref_cell, cell_node) {
           node = nodes[cell_node];
+          if (!ref_node_active(ref_node, node)) continue;
           RSS(ref_smooth_local_cell_about(ref_cell, ref_node, node, &allowed),
               "para");
           if (!allowed) {
@@ -1974,8 +2044,11 @@ REF_FCN REF_STATUS ref_smooth_pass(REF_GRID ref_grid) {
           interior = ref_cell_node_empty(ref_grid_tri(ref_grid), node) &&
                      ref_cell_node_empty(ref_grid_qua(ref_grid), node);
           if (interior) {
+            for (i = 0; i < 3; i++) xyz[i] = ref_node_xyz(ref_node, i, node);
             RSS(ref_smooth_tet_improve(ref_grid, node), "ideal");
+            RSS(ref_smooth_tally(ref_grid, node, xyz), "tally");
             ref_node_age(ref_node, node) = 0;
+            moved = REF_TRUE;
           }
         }
       }
@@ -2230,8 +2303,10 @@ REF_FCN static REF_STATUS ref_smooth_tet_nso_step(REF_GRID ref_grid,
     ref_node_xyz(ref_node, 0, node) = xyz[0];
     ref_node_xyz(ref_node, 1, node) = xyz[1];
     ref_node_xyz(ref_node, 2, node) = xyz[2];
-    if (REF_SUCCESS != interp_status && REF_EMPTY != interp_guess)
+    if (REF_SUCCESS != interp_status && REF_EMPTY != interp_guess) {
+      RSS(ref_interp_plan_free(ref_interp), "plan");
       ref_interp_cell(ref_interp, node) = interp_guess;
+    }
     RXS(ref_metric_interpolate_node(ref_grid, node), REF_NOT_FOUND, "interp");
     *complete = REF_TRUE;
   }
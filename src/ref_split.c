@@ -29,16 +29,17 @@
 #include "ref_edge.h"
 #include "ref_gather.h"
 #include "ref_geom.h"
+#include "ref_heap.h"
 #include "ref_malloc.h"
 #include "ref_math.h"
 #include "ref_matrix.h"
 #include "ref_metric.h"
 #include "ref_mpi.h"
 #include "ref_smooth.h"
-#include "ref_sort.h"
 #include "ref_subdiv.h"
 
 #define MAX_CELL_SPLIT (100)
+#define MAX_NODE_LIST (1000)
 
 REF_FCN static REF_STATUS ref_split_edge_ratio_post_report(REF_GRID ref_grid,
                                                            REF_INT node0,
@@ -73,14 +74,52 @@ REF_FCN static REF_STATUS ref_split_edge_ratio_post_report(REF_GRID ref_grid,
   return REF_SUCCESS;
 }
 
+/* the candidate item is the node pair at 2 * item of pairs */
+REF_FCN static REF_STATUS ref_split_queue(REF_LIST pairs, REF_HEAP ref_heap,
+                                          REF_INT node0, REF_INT node1,
+                                          REF_DBL ratio) {
+  RSS(ref_heap_push(ref_heap, ref_list_n(pairs) / 2, ratio), "push");
+  RSS(ref_list_push(pairs, node0), "node0");
+  RSS(ref_list_push(pairs, node1), "node1");
+  return REF_SUCCESS;
+}
+
+/* queue the long edges created by a split of new_node */
+REF_FCN static REF_STATUS ref_split_queue_new(REF_GRID ref_grid,
+                                              REF_CELL ref_cell,
+                                              REF_LIST pairs,
+                                              REF_HEAP ref_heap,
+                                              REF_INT new_node) {
+  REF_NODE ref_node = ref_grid_node(ref_grid);
+  REF_INT nnode, node_list[MAX_NODE_LIST];
+  REF_INT node;
+  REF_DBL ratio;
+  REF_STATUS status;
+
+  status = ref_cell_node_list_around(ref_cell, new_node, MAX_NODE_LIST, &nnode,
+                                     node_list);
+  if (REF_INCREASE_LIMIT == status) return REF_SUCCESS;
+  RSS(status, "around new node");
+  for (node = 0; node < nnode; node++) {
+    RSS(ref_node_ratio(ref_node, new_node, node_list[node], &ratio), "ratio");
+    if (ratio > ref_grid_adapt(ref_grid, split_ratio))
+      RSS(ref_split_queue(pairs, ref_heap, new_node, node_list[node], ratio),
+          "queue");
+  }
+
+  return REF_SUCCESS;
+}
+
 REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
   REF_MPI ref_mpi = ref_grid_mpi(ref_grid);
   REF_NODE ref_node = ref_grid_node(ref_grid);
   REF_CELL ref_cell = ref_grid_tet(ref_grid);
   REF_EDGE ref_edge;
   REF_DBL *ratio;
-  REF_INT *edges, *order;
-  REF_INT i, n, edge;
+  REF_LIST pairs;
+  REF_HEAP ref_heap;
+  REF_INT i, item, edge;
+  REF_DBL key, current;
   REF_BOOL allowed_ratio, allowed_tri_conformity, allowed_tet_quality;
   REF_BOOL allowed, allowed_local, geom_support, valid_cavity, try_cavity;
   REF_BOOL allowed_cavity_ratio, has_edge;
@@ -113,34 +152,43 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
   RSS(ref_edge_create(&ref_edge, ref_grid), "orig edges");
 
   ref_malloc(ratio, ref_edge_n(ref_edge), REF_DBL);
-  ref_malloc(order, ref_edge_n(ref_edge), REF_INT);
-  ref_malloc(edges, ref_edge_n(ref_edge), REF_INT);
 
-  n = 0;
+  RSS(ref_node_ratio_active(ref_node, ref_edge_n(ref_edge), ref_edge->e2n,
+                            0.0, ratio),
+      "ratio");
+  /* longest first, edges created by splits join the queue as they appear */
+  RSS(ref_list_create(&pairs), "candidate pairs");
+  RSS(ref_heap_create(&ref_heap), "candidate queue");
   for (edge = 0; edge < ref_edge_n(ref_edge); edge++) {
-    node0 = ref_edge_e2n(ref_edge, 0, edge);
-    node1 = ref_edge_e2n(ref_edge, 1, edge);
-    RSS(ref_node_ratio(ref_node, node0, node1, &(ratio[n])), "ratio");
-    if (ratio[n] > ref_grid_adapt(ref_grid, split_ratio)) {
-      edges[n] = edge;
-      n++;
+    if (ratio[edge] > ref_grid_adapt(ref_grid, split_ratio)) {
+      RSS(ref_split_queue(pairs, ref_heap, ref_edge_e2n(ref_edge, 0, edge),
+                          ref_edge_e2n(ref_edge, 1, edge), ratio[edge]),
+          "queue");
     }
   }
+  ref_free(ratio);
+  RSS(ref_edge_free(ref_edge), "free edge");
 
-  RSS(ref_sort_heap_dbl(n, ratio, order), "sort lengths");
-
-  for (i = n - 1; i >= 0; i--) {
-    edge = edges[order[i]];
-    node0 = ref_edge_e2n(ref_edge, 0, edge);
-    node1 = ref_edge_e2n(ref_edge, 1, edge);
+  while (REF_SUCCESS == ref_heap_pop(ref_heap, &item, &key)) {
+    node0 = ref_list_value(pairs, 2 * item);
+    node1 = ref_list_value(pairs, 2 * item + 1);
 
-    /* transcript = (ratio[order[i]] > 3.0); */
-    if (transcript) printf("transcript on ratio %f\n", ratio[order[i]]);
+    /* transcript = (key > 3.0); */
+    if (transcript) printf("transcript on ratio %f\n", key);
 
     RSS(ref_cell_has_side(ref_cell, node0, node1, &allowed), "has side");
     if (transcript && !allowed) printf("not a side anymore\n");
     if (!allowed) continue;
 
+    /* lazy invalidation, nearby changes may have shortened the edge */
+    RSS(ref_node_ratio(ref_node, node0, node1, &current), "ratio");
+    if (current < (1.0 - 1.0e-8) * key) {
+      if (current > ref_grid_adapt(ref_grid, split_ratio))
+        RSS(ref_split_queue(pairs, ref_heap, node0, node1, current), "queue");
+      continue;
+    }
+    ref_grid_adapt(ref_grid, attempted)++;
+
     /* skip if neither node is owned */
     if (!ref_node_owned(ref_node, node0) && !ref_node_owned(ref_node, node1)) {
       if (transcript) printf("neither node is local\n");
@@ -294,10 +342,14 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
           RSS(ref_cavity_replace(ref_cavity), "cav replace");
           RSS(ref_cavity_free(ref_cavity), "cav free");
           ref_cavity = (REF_CAVITY)NULL;
+          ref_grid_adapt(ref_grid, accepted)++;
           ref_node_age(ref_node, node0) = 0;
           ref_node_age(ref_node, node1) = 0;
           RSS(ref_smooth_post_edge_split(ref_grid, new_node),
               "smooth after split");
+          RSS(ref_split_queue_new(ref_grid, ref_cell, pairs, ref_heap,
+                                  new_node),
+              "queue new edges");
           continue;
         }
       } else {
@@ -308,7 +360,7 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
         }
       }
       if (REF_CAVITY_PARTITION_CONSTRAINED == ref_cavity_state(ref_cavity)) {
-        if (span_parts) RSS(ref_list_push(para_cavity, edge), "push");
+        if (span_parts) RSS(ref_list_push(para_cavity, item), "push");
       }
       RSS(ref_cavity_free(ref_cavity), "cav free");
       ref_cavity = (REF_CAVITY)NULL;
@@ -321,7 +373,7 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
         "local tet");
     if (!allowed_local) {
       if (span_parts) {
-        RSS(ref_list_push(para_no_geom, edge), "push");
+        RSS(ref_list_push(para_no_geom, item), "push");
       } else {
         ref_node_age(ref_node, node0)++;
         ref_node_age(ref_node, node1)++;
@@ -343,15 +395,17 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
     if (transcript)
       RSS(ref_split_edge_ratio_post_report(ref_grid, node0, node1, new_node),
           "report ratio");
+    ref_grid_adapt(ref_grid, accepted)++;
+    RSS(ref_grid_touch(ref_grid, new_node), "touch");
     ref_node_age(ref_node, node0) = 0;
     ref_node_age(ref_node, node1) = 0;
 
     RSS(ref_smooth_post_edge_split(ref_grid, new_node), "smooth after split");
+    RSS(ref_split_queue_new(ref_grid, ref_cell, pairs, ref_heap, new_node),
+        "queue new edges");
   }
 
-  ref_free(edges);
-  ref_free(order);
-  ref_free(ratio);
+  RSS(ref_heap_free(ref_heap), "free queue");
 
   if (span_parts) {
     if (ref_grid_adapt(ref_grid, timing_level) > 0)
@@ -360,15 +414,18 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
     ref_subdiv_new_mark_allowed(ref_subdiv) = REF_FALSE;
     ref_subdiv->instrument = REF_TRUE;
     each_ref_list_item(para_no_geom, i) {
-      edge = ref_list_value(para_no_geom, i);
-      node0 = ref_edge_e2n(ref_edge, 0, edge);
-      node1 = ref_edge_e2n(ref_edge, 1, edge);
+      item = ref_list_value(para_no_geom, i);
+      node0 = ref_list_value(pairs, 2 * item);
+      node1 = ref_list_value(pairs, 2 * item + 1);
       RSS(ref_cell_has_side(ref_grid_tet(ref_grid), node0, node1, &allowed),
           "has side");
       if (!allowed) continue;
 
       RSS(ref_subdiv_mark_to_split(ref_subdiv, node0, node1),
           "mark edge to para split");
+      ref_grid_adapt(ref_grid, accepted)++;
+      RSS(ref_grid_touch(ref_grid, node0), "touch");
+      RSS(ref_grid_touch(ref_grid, node1), "touch");
     }
 
     RSS(ref_subdiv_split(ref_subdiv), "split");
@@ -386,7 +443,7 @@ REF_FCN REF_STATUS ref_split_pass(REF_GRID ref_grid) {
     ref_list_free(para_cavity);
   }
 
-  ref_edge_free(ref_edge);
+  RSS(ref_list_free(pairs), "free pairs");
 
   return REF_SUCCESS;
 }
@@ -229,8 +229,9 @@ int main(int argc, char *argv[]) {
         "set top small");
     RSS(ref_split_pass(ref_grid), "pass");
 
-    REIS(7, ref_node_n(ref_grid_node(ref_grid)), "nodes");
-    REIS(4, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
+    /* long edges created by the first splits are split in the same pass */
+    REIS(9, ref_node_n(ref_grid_node(ref_grid)), "nodes");
+    REIS(6, ref_cell_n(ref_grid_tet(ref_grid)), "tets");
 
     /* ref_export_by_extension(ref_grid,"ref_split_test.tec"); */
 
@@ -297,8 +298,9 @@ int main(int argc, char *argv[]) {
 
     RSS(ref_split_pass(ref_grid), "pass");
 
-    REIS(5, ref_node_n(ref_grid_node(ref_grid)), "nodes");
-    REIS(3, ref_cell_n(ref_grid_tri(ref_grid)), "tri");
+    /* long edges created by the first splits are split in the same pass */
+    REIS(6, ref_node_n(ref_grid_node(ref_grid)), "nodes");
+    REIS(4, ref_cell_n(ref_grid_tri(ref_grid)), "tri");
     REIS(2, ref_cell_n(ref_grid_edg(ref_grid)), "edg");
 
     /*
@@ -24,6 +24,7 @@
 
 #include "ref_adapt.h"
 #include "ref_args.h"
+#include "ref_async.h"
 #include "ref_axi.h"
 #include "ref_defs.h"
 #include "ref_dist.h"
@@ -123,6 +124,17 @@ static void adapt_help(const char *name) {
   printf("      3: Zoltan graph partitioning.\n");
   printf("      4: Zoltan recursive bisection.\n");
   printf("      5: native recursive bisection.\n");
+  printf("      6: native multilevel graph partitioning.\n");
+  printf("  --partitioner-work weights partitions by predicted adapt work.\n");
+  printf("  --partitioner-imbalance <limit> diffuses parts between passes\n");
+  printf("      and repartitions when the imbalance exceeds limit.\n");
+  printf("  --active-region limits operators to nodes near recent changes.\n");
+  printf("  --async-output writes gathered files on background threads.\n");
+  printf("  --compress-output packs --checkpoint and .solb files,\n");
+  printf("      readable by refine.\n");
+  printf("  --checkpoint <file.meshb> saves mesh, metric, and settings\n");
+  printf("      after each pass.\n");
+  printf("  --restart reads input_mesh.meshb as a --checkpoint file.\n");
   printf("\n");
 }
 static void collar_help(const char *name) {
@@ -220,6 +232,13 @@ static void loop_help(const char *name) {
   printf("       3: Zoltan graph partitioning.\n");
   printf("       4: Zoltan recursive bisection.\n");
   printf("       5: native recursive bisection.\n");
+  printf("       6: native multilevel graph partitioning.\n");
+  printf("   --partitioner-work weights partitions by predicted adapt work.\n");
+  printf("   --partitioner-imbalance <limit> diffuses parts between passes\n");
+  printf("       and repartitions when the imbalance exceeds limit.\n");
+  printf("   --active-region limits operators to nodes near recent changes.\n");
+  printf("   --async-output writes gathered files on background threads.\n");
+  printf("   --compress-output packs .solb files, readable by refine.\n");
   printf("   --mesh-extension <output mesh extension> (replaces lb8.ugrid).\n");
   printf("   --fixed-point <middle-string> \\\n");
   printf("       <first_timestep> <timestep_increment> <last_timestep>\n");
@@ -275,6 +294,7 @@ static void multiscale_help(const char *name) {
   printf("   --pcd <project.pcd> exports isotropic spacing point cloud.\n");
   printf("   --combine <scalar2.solb> <scalar2 ratio>.\n");
   printf("   --aspect-ratio <aspect ratio limit>.\n");
+  printf("   --field <index> reads one column of a multiple field solb.\n");
   printf("\n");
 }
 static void node_help(const char *name) {
@@ -650,6 +670,11 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   REF_BOOL form_quads = REF_FALSE;
   REF_BOOL form_prism = REF_FALSE;
   REF_BOOL mesh_exported = REF_FALSE;
+  REF_BOOL restart = REF_FALSE;
+  REF_BOOL restart_curvature = REF_FALSE;
+  REF_BOOL restart_partitioned = REF_FALSE;
+  char *checkpoint = NULL;
+  REF_ASYNC ref_async = NULL;
   REF_INT pass, passes = 30;
   REF_INT opt, pos;
   REF_LONG ntet;
@@ -660,7 +685,17 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   if (argc < 3) goto shutdown;
   in_mesh = argv[2];
 
-  if (ref_mpi_para(ref_mpi)) {
+  RXS(ref_args_find(argc, argv, "--restart", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (ref_mpi_once(ref_mpi)) printf("restart from checkpoint %s\n", in_mesh);
+    RSS(ref_part_checkpoint(&ref_grid, ref_mpi, in_mesh, &restart_curvature,
+                            &restart_partitioned),
+        "restart");
+    ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
+    ref_mpi_stopwatch_stop(ref_mpi, "restart");
+    restart = REF_TRUE;
+  } else if (ref_mpi_para(ref_mpi)) {
     if (ref_mpi_once(ref_mpi)) printf("part %s\n", in_mesh);
     RSS(ref_part_by_extension(&ref_grid, ref_mpi, in_mesh), "part");
     ref_mpi = ref_grid_mpi(ref_grid); /* ref_grid made a deep copy */
@@ -764,6 +799,51 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
              (int)ref_grid_partitioner(ref_grid));
   }
 
+  RXS(ref_args_find(argc, argv, "--partitioner-work", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    ref_grid_partitioner_work(ref_grid) = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--partitioner-work partition by predicted adapt work\n");
+  }
+
+  RXS(ref_args_find(argc, argv, "--partitioner-imbalance", &pos),
+      REF_NOT_FOUND, "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    ref_grid_partitioner_imbalance(ref_grid) = atof(argv[pos + 1]);
+    if (ref_mpi_once(ref_mpi))
+      printf("--partitioner-imbalance %f diffusion limit\n",
+             ref_grid_partitioner_imbalance(ref_grid));
+  }
+
+  RXS(ref_args_find(argc, argv, "--active-region", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    ref_grid_adapt(ref_grid, active_region) = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--active-region limits operators to recent changes\n");
+  }
+
+  RXS(ref_args_find(argc, argv, "--async-output", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    RSS(ref_async_create(&ref_async), "create async output");
+    if (ref_mpi_once(ref_mpi))
+      printf("--async-output writes gathered files in background\n");
+  }
+
+  RXS(ref_args_find(argc, argv, "--compress-output", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (NULL == ref_async)
+      RSS(ref_async_create(&ref_async), "create async output");
+    ref_async_compress(ref_async) = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--compress-output writes checkpoint and .solb files packed\n");
+  }
+  /* checkpoints and exports overlap the following work */
+  ref_gather_async(ref_grid_gather(ref_grid)) = ref_async;
+
   RXS(ref_args_find(argc, argv, "--ratio-method", &pos), REF_NOT_FOUND,
       "arg search");
   if (REF_EMPTY != pos && pos < argc - 1) {
@@ -803,6 +883,17 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     if (ref_mpi_once(ref_mpi)) printf("--topo checks active\n");
   }
 
+  if (restart && !restart_curvature)
+    curvature_metric = REF_FALSE; /* metric from checkpoint */
+
+  RXS(ref_args_find(argc, argv, "--checkpoint", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    checkpoint = argv[pos + 1];
+    if (ref_mpi_once(ref_mpi))
+      printf("--checkpoint %s after each pass\n", checkpoint);
+  }
+
   RXS(ref_args_char(argc, argv, "--metric", "-m", &in_metric), REF_NOT_FOUND,
       "metric arg search");
   if (NULL != in_metric) {
@@ -969,7 +1060,8 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
 
   RSS(ref_validation_cell_volume(ref_grid), "vol");
 
-  RSS(ref_migrate_to_balance(ref_grid), "balance");
+  if (!restart_partitioned) /* checkpoint partition with the same ranks */
+    RSS(ref_migrate_to_balance(ref_grid), "balance");
   RSS(ref_grid_pack(ref_grid), "pack");
   ref_mpi_stopwatch_stop(ref_mpi, "pack");
 
@@ -1020,9 +1112,14 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     RSS(ref_validation_cell_volume(ref_grid), "vol");
     RSS(ref_adapt_tattle_faces(ref_grid), "tattle");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "tattle faces");
-    RSS(ref_migrate_to_balance(ref_grid), "balance");
+    RSS(ref_migrate_to_rebalance(ref_grid), "balance");
     RSS(ref_grid_pack(ref_grid), "pack");
     ref_mpi_stopwatch_stop(ref_mpi, "pack");
+    if (NULL != checkpoint) {
+      RSS(ref_gather_checkpoint(ref_grid, curvature_metric, checkpoint),
+          "checkpoint");
+      ref_mpi_stopwatch_stop(ref_mpi, "checkpoint");
+    }
   }
 
   RXS(ref_args_find(argc, argv, "--usm3d", &pos), REF_NOT_FOUND, "parse usm3d");
@@ -1052,6 +1149,7 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
           printf(
               " extrusion automatically added for ugrid output of 2D mesh.\n");
         RSS(ref_grid_extrude_twod(&extruded_grid, ref_grid, 2), "extrude");
+        ref_gather_async(ref_grid_gather(extruded_grid)) = ref_async;
         RXS(ref_args_find(argc, argv, "--axi", &pos), REF_NOT_FOUND,
             "arg search");
         if (REF_EMPTY != pos) {
@@ -1123,6 +1221,13 @@ static REF_STATUS adapt(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     }
   }
 
+  if (NULL != ref_async) {
+    if (ref_mpi_once(ref_mpi))
+      printf("wait for %d async writes\n", ref_async_n(ref_async));
+    RSS(ref_async_free(ref_async), "wait for async output");
+    ref_mpi_stopwatch_stop(ref_mpi, "async output");
+  }
+
   RSS(ref_dict_free(ref_dict_bcs), "free");
   RSS(ref_grid_free(ref_grid), "free");
 
@@ -3048,6 +3153,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
   REF_GRID ref_grid = NULL;
   REF_MPI ref_mpi = ref_mpi_orig;
   REF_GRID extruded_grid = NULL;
+  REF_ASYNC ref_async = NULL;
   REF_BOOL all_done = REF_FALSE;
   REF_BOOL all_done0 = REF_FALSE;
   REF_BOOL all_done1 = REF_FALSE;
@@ -3260,6 +3366,51 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
              (int)ref_grid_partitioner(ref_grid));
   }
 
+  RXS(ref_args_find(argc, argv, "--partitioner-work", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    ref_grid_partitioner_work(ref_grid) = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--partitioner-work partition by predicted adapt work\n");
+  }
+
+  RXS(ref_args_find(argc, argv, "--partitioner-imbalance", &pos),
+      REF_NOT_FOUND, "arg search");
+  if (REF_EMPTY != pos && pos < argc - 1) {
+    ref_grid_partitioner_imbalance(ref_grid) = atof(argv[pos + 1]);
+    if (ref_mpi_once(ref_mpi))
+      printf("--partitioner-imbalance %f diffusion limit\n",
+             ref_grid_partitioner_imbalance(ref_grid));
+  }
+
+  RXS(ref_args_find(argc, argv, "--active-region", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    ref_grid_adapt(ref_grid, active_region) = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--active-region limits operators to recent changes\n");
+  }
+
+  RXS(ref_args_find(argc, argv, "--async-output", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    RSS(ref_async_create(&ref_async), "create async output");
+    if (ref_mpi_once(ref_mpi))
+      printf("--async-output writes gathered files in background\n");
+  }
+
+  RXS(ref_args_find(argc, argv, "--compress-output", &pos), REF_NOT_FOUND,
+      "arg search");
+  if (REF_EMPTY != pos) {
+    if (NULL == ref_async)
+      RSS(ref_async_create(&ref_async), "create async output");
+    ref_async_compress(ref_async) = REF_TRUE;
+    if (ref_mpi_once(ref_mpi))
+      printf("--compress-output writes .solb files packed\n");
+  }
+  /* checkpoints and exports overlap the following work */
+  ref_gather_async(ref_grid_gather(ref_grid)) = ref_async;
+
   RXS(ref_args_find(argc, argv, "--quad", &pos), REF_NOT_FOUND, "arg search");
   if (ref_grid_twod(ref_grid) && REF_EMPTY != pos) {
     form_quads = REF_TRUE;
@@ -3678,7 +3829,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     RSS(ref_validation_cell_volume(ref_grid), "vol");
     RSS(ref_adapt_tattle_faces(ref_grid), "tattle");
     ref_mpi_stopwatch_stop(ref_grid_mpi(ref_grid), "tattle faces");
-    RSS(ref_migrate_to_balance(ref_grid), "balance");
+    RSS(ref_migrate_to_rebalance(ref_grid), "balance");
     RSS(ref_grid_pack(ref_grid), "pack");
     ref_mpi_stopwatch_stop(ref_mpi, "pack");
   }
@@ -3718,6 +3869,7 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
       ref_grid_twod(ref_grid)) {
     if (ref_mpi_once(ref_mpi)) printf("extrude twod\n");
     RSS(ref_grid_extrude_twod(&extruded_grid, ref_grid, 2), "extrude");
+    ref_gather_async(ref_grid_gather(extruded_grid)) = ref_async;
     RXS(ref_args_find(argc, argv, "--axi", &pos), REF_NOT_FOUND, "arg search");
     if (REF_EMPTY != pos) {
       if (ref_mpi_once(ref_mpi)) printf(" --axi convert extrusion to wedge.\n");
@@ -3844,6 +3996,13 @@ static REF_STATUS loop(REF_MPI ref_mpi_orig, int argc, char *argv[]) {
     }
   }
 
+  if (NULL != ref_async) {
+    if (ref_mpi_once(ref_mpi))
+      printf("wait for %d async writes\n", ref_async_n(ref_async));
+    RSS(ref_async_free(ref_async), "wait for async output");
+    ref_mpi_stopwatch_stop(ref_mpi, "async output");
+  }
+
   RSS(ref_dict_free(ref_dict_bcs), "free");
   RSS(ref_grid_free(ref_grid), "free");
 
@@ -4020,9 +4179,23 @@ static REF_STATUS multiscale(REF_MPI ref_mpi, int argc, char *argv[]) {
                            complexity),
         "hessian multiscale");
   } else {
-    if (ref_mpi_once(ref_mpi)) printf("part scalar %s\n", in_scalar);
-    RSS(ref_part_scalar(ref_grid, &ldim, &scalar, in_scalar), "part scalar");
-    REIS(1, ldim, "expected one scalar");
+    RXS(ref_args_find(argc, argv, "--field", &pos), REF_NOT_FOUND,
+        "arg search");
+    if (REF_EMPTY != pos && pos < argc - 1) {
+      REF_INT field;
+      RSS(ref_part_field_index(0, NULL, argv[pos + 1], &field),
+          "--field <index>");
+      if (ref_mpi_once(ref_mpi))
+        printf("part field %d of scalar %s\n", field, in_scalar);
+      ref_malloc(scalar, ref_node_max(ref_grid_node(ref_grid)), REF_DBL);
+      RSS(ref_part_scalar_fields(ref_grid, in_scalar, 1, &field, 1, scalar),
+          "part field");
+    } else {
+      if (ref_mpi_once(ref_mpi)) printf("part scalar %s\n", in_scalar);
+      RSS(ref_part_scalar(ref_grid, &ldim, &scalar, in_scalar),
+          "part scalar");
+      REIS(1, ldim, "expected one scalar");
+    }
     ref_mpi_stopwatch_stop(ref_mpi, "part scalar");
 
     if (ref_mpi_once(ref_mpi)) printf("reconstruct Hessian, compute metric\n");
@@ -994,6 +994,7 @@ REF_FCN static REF_STATUS ref_subdiv_new_node(REF_SUBDIV ref_subdiv) {
       for (i = 0; i < REF_NODE_REAL_PER; i++)
         ref_node_real(ref_node, i, node) =
             edge_real[i + REF_NODE_REAL_PER * edge];
+      ref_node_metric_stale(ref_node, node);
       for (i = 0; i < ref_node_naux(ref_node); i++)
         ref_node_aux(ref_node, i, node) =
             edge_aux[i + ref_node_naux(ref_node) * edge];
@@ -749,6 +749,10 @@ REF_FCN REF_STATUS ref_swap_tri_pass(REF_GRID ref_grid) {
     /* skip if neither node is owned */
     if (!ref_node_owned(ref_node, node0) && !ref_node_owned(ref_node, node1))
       continue;
+    /* skip converged region */
+    if (!ref_node_active(ref_node, node0) && !ref_node_active(ref_node, node1))
+      continue;
+    ref_grid_adapt(ref_grid, attempted)++;
 
     RSS(ref_swap_edge_mixed(ref_grid, node0, node1, &allowed), "faceid");
     if (!allowed) continue;
@@ -778,6 +782,9 @@ REF_FCN REF_STATUS ref_swap_tri_pass(REF_GRID ref_grid) {
     }
 
     RSS(ref_swap_tri_edge(ref_grid, node0, node1), "swap");
+    ref_grid_adapt(ref_grid, accepted)++;
+    RSS(ref_grid_touch(ref_grid, node0), "touch");
+    RSS(ref_grid_touch(ref_grid, node1), "touch");
   }
 
   ref_edge_free(ref_edge);
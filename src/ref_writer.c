@@ -0,0 +1,220 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_writer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ref_malloc.h"
+
+REF_FCN REF_STATUS ref_writer_create(REF_WRITER *ref_writer_ptr, FILE *file,
+                                     REF_BOOL swap_endian) {
+  REF_WRITER ref_writer;
+  void *buffer;
+
+  ref_malloc(*ref_writer_ptr, 1, REF_WRITER_STRUCT);
+  ref_writer = (*ref_writer_ptr);
+
+  ref_writer->file = file;
+  ref_writer->swap_endian = swap_endian;
+  ref_writer->position = (REF_FILEPOS)ftello(file);
+  RAS(0 <= ref_writer->position, "file position");
+  ref_writer->n = 0;
+  ref_writer->max = REF_WRITER_BUFFER;
+  REIS(0, posix_memalign(&buffer, REF_WRITER_ALIGN, REF_WRITER_BUFFER),
+       "aligned buffer");
+  ref_writer->buffer = (REF_BYTE *)buffer;
+
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_free(REF_WRITER ref_writer) {
+  if (NULL == (void *)ref_writer) return REF_NULL;
+  RSS(ref_writer_flush(ref_writer), "flush");
+  free(ref_writer->buffer); /* from posix_memalign */
+  ref_free(ref_writer);
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_flush(REF_WRITER ref_writer) {
+  if (0 < ref_writer->n) {
+    REIS(ref_writer->n,
+         fwrite(ref_writer->buffer, sizeof(REF_BYTE), ref_writer->n,
+                ref_writer->file),
+         "buffer write");
+  }
+  ref_writer->position += (REF_FILEPOS)ref_writer->n;
+  ref_writer->n = 0;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_tell(REF_WRITER ref_writer,
+                                   REF_FILEPOS *position) {
+  *position = ref_writer->position + (REF_FILEPOS)ref_writer->n;
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_skip(REF_WRITER ref_writer, REF_SIZE bytes) {
+  RSS(ref_writer_flush(ref_writer), "flush");
+  ref_writer->position += (REF_FILEPOS)bytes;
+  REIS(0, fseeko(ref_writer->file, ref_writer->position, SEEK_SET), "seek");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_swap(REF_BYTE *bytes, REF_SIZE n,
+                                   REF_INT width) {
+  REF_SIZE i;
+  REF_BYTE b0, b1, b2, b3;
+  switch (width) {
+    case 4:
+      for (i = 0; i < n; i++) {
+        b0 = bytes[0 + 4 * i];
+        b1 = bytes[1 + 4 * i];
+        bytes[0 + 4 * i] = bytes[3 + 4 * i];
+        bytes[1 + 4 * i] = bytes[2 + 4 * i];
+        bytes[2 + 4 * i] = b1;
+        bytes[3 + 4 * i] = b0;
+      }
+      break;
+    case 8:
+      for (i = 0; i < n; i++) {
+        b0 = bytes[0 + 8 * i];
+        b1 = bytes[1 + 8 * i];
+        b2 = bytes[2 + 8 * i];
+        b3 = bytes[3 + 8 * i];
+        bytes[0 + 8 * i] = bytes[7 + 8 * i];
+        bytes[1 + 8 * i] = bytes[6 + 8 * i];
+        bytes[2 + 8 * i] = bytes[5 + 8 * i];
+        bytes[3 + 8 * i] = bytes[4 + 8 * i];
+        bytes[4 + 8 * i] = b3;
+        bytes[5 + 8 * i] = b2;
+        bytes[6 + 8 * i] = b1;
+        bytes[7 + 8 * i] = b0;
+      }
+      break;
+    default:
+      RSS(REF_IMPLEMENT, "unknown width");
+  }
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_bytes(REF_WRITER ref_writer, REF_SIZE size,
+                                    const void *bytes) {
+  if (ref_writer->n + size > ref_writer->max) {
+    RSS(ref_writer_flush(ref_writer), "flush");
+  }
+  if (size > ref_writer->max) {
+    REIS(size, fwrite(bytes, sizeof(REF_BYTE), size, ref_writer->file),
+         "direct write");
+    ref_writer->position += (REF_FILEPOS)size;
+    return REF_SUCCESS;
+  }
+  memcpy(&(ref_writer->buffer[ref_writer->n]), bytes, size);
+  ref_writer->n += size;
+  return REF_SUCCESS;
+}
+
+/* stage n words in buffer sized pieces, swapping each staged piece at once */
+REF_FCN static REF_STATUS ref_writer_words(REF_WRITER ref_writer, REF_SIZE n,
+                                           REF_INT width, REF_BYTE *words) {
+  REF_SIZE piece, written;
+  written = 0;
+  while (written < n) {
+    if (ref_writer->n + (REF_SIZE)width > ref_writer->max) {
+      RSS(ref_writer_flush(ref_writer), "flush");
+    }
+    piece = (ref_writer->max - ref_writer->n) / (REF_SIZE)width;
+    piece = MIN(piece, n - written);
+    memcpy(&(ref_writer->buffer[ref_writer->n]),
+           &(words[(REF_SIZE)width * written]), (REF_SIZE)width * piece);
+    if (ref_writer->swap_endian) {
+      RSS(ref_writer_swap(&(ref_writer->buffer[ref_writer->n]), piece, width),
+          "swap");
+    }
+    ref_writer->n += (REF_SIZE)width * piece;
+    written += piece;
+  }
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_int(REF_WRITER ref_writer, REF_INT value) {
+  RSS(ref_writer_words(ref_writer, 1, (REF_INT)sizeof(REF_INT),
+                       (REF_BYTE *)&value),
+      "int");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_long(REF_WRITER ref_writer, REF_LONG value) {
+  RSS(ref_writer_words(ref_writer, 1, (REF_INT)sizeof(REF_LONG),
+                       (REF_BYTE *)&value),
+      "long");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_float(REF_WRITER ref_writer, float value) {
+  RSS(ref_writer_words(ref_writer, 1, (REF_INT)sizeof(float),
+                       (REF_BYTE *)&value),
+      "float");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_dbl(REF_WRITER ref_writer, REF_DBL value) {
+  RSS(ref_writer_words(ref_writer, 1, (REF_INT)sizeof(REF_DBL),
+                       (REF_BYTE *)&value),
+      "dbl");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_ints(REF_WRITER ref_writer, REF_INT n,
+                                   REF_INT *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_writer_words(ref_writer, (REF_SIZE)n, (REF_INT)sizeof(REF_INT),
+                       (REF_BYTE *)values),
+      "ints");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_longs(REF_WRITER ref_writer, REF_INT n,
+                                    REF_LONG *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_writer_words(ref_writer, (REF_SIZE)n, (REF_INT)sizeof(REF_LONG),
+                       (REF_BYTE *)values),
+      "longs");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_floats(REF_WRITER ref_writer, REF_INT n,
+                                     float *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_writer_words(ref_writer, (REF_SIZE)n, (REF_INT)sizeof(float),
+                       (REF_BYTE *)values),
+      "floats");
+  return REF_SUCCESS;
+}
+
+REF_FCN REF_STATUS ref_writer_dbls(REF_WRITER ref_writer, REF_INT n,
+                                   REF_DBL *values) {
+  RAS(0 <= n, "negative n");
+  RSS(ref_writer_words(ref_writer, (REF_SIZE)n, (REF_INT)sizeof(REF_DBL),
+                       (REF_BYTE *)values),
+      "dbls");
+  return REF_SUCCESS;
+}
@@ -0,0 +1,83 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#ifndef REF_WRITER_H
+#define REF_WRITER_H
+
+#include <stdio.h>
+
+#include "ref_defs.h"
+
+BEGIN_C_DECLORATION
+typedef struct REF_WRITER_STRUCT REF_WRITER_STRUCT;
+typedef REF_WRITER_STRUCT *REF_WRITER;
+END_C_DECLORATION
+
+BEGIN_C_DECLORATION
+struct REF_WRITER_STRUCT {
+  FILE *file;
+  REF_BOOL swap_endian;
+  REF_FILEPOS position; /* bytes in file, excluding staged bytes */
+  REF_SIZE n, max;
+  REF_BYTE *buffer;
+};
+
+/* staging bytes held before a single fwrite */
+#define REF_WRITER_BUFFER (8 * 1024 * 1024)
+/* page aligned staging buffer */
+#define REF_WRITER_ALIGN (4096)
+
+#define ref_writer_file(ref_writer) ((ref_writer)->file)
+#define ref_writer_swap_endian(ref_writer) ((ref_writer)->swap_endian)
+
+/* buffers binary output to file, the file is flushed but not closed by free */
+REF_FCN REF_STATUS ref_writer_create(REF_WRITER *ref_writer, FILE *file,
+                                     REF_BOOL swap_endian);
+REF_FCN REF_STATUS ref_writer_free(REF_WRITER ref_writer);
+
+REF_FCN REF_STATUS ref_writer_flush(REF_WRITER ref_writer);
+/* file position including staged bytes */
+REF_FCN REF_STATUS ref_writer_tell(REF_WRITER ref_writer,
+                                   REF_FILEPOS *position);
+/* flush and seek bytes ahead, leaving a gap for other writers */
+REF_FCN REF_STATUS ref_writer_skip(REF_WRITER ref_writer, REF_SIZE bytes);
+
+REF_FCN REF_STATUS ref_writer_bytes(REF_WRITER ref_writer, REF_SIZE size,
+                                    const void *bytes);
+
+REF_FCN REF_STATUS ref_writer_int(REF_WRITER ref_writer, REF_INT value);
+REF_FCN REF_STATUS ref_writer_long(REF_WRITER ref_writer, REF_LONG value);
+REF_FCN REF_STATUS ref_writer_float(REF_WRITER ref_writer, float value);
+REF_FCN REF_STATUS ref_writer_dbl(REF_WRITER ref_writer, REF_DBL value);
+
+REF_FCN REF_STATUS ref_writer_ints(REF_WRITER ref_writer, REF_INT n,
+                                   REF_INT *values);
+REF_FCN REF_STATUS ref_writer_longs(REF_WRITER ref_writer, REF_INT n,
+                                    REF_LONG *values);
+REF_FCN REF_STATUS ref_writer_floats(REF_WRITER ref_writer, REF_INT n,
+                                     float *values);
+REF_FCN REF_STATUS ref_writer_dbls(REF_WRITER ref_writer, REF_INT n,
+                                   REF_DBL *values);
+
+/* reverse the byte order of n words of width bytes in place */
+REF_FCN REF_STATUS ref_writer_swap(REF_BYTE *bytes, REF_SIZE n, REF_INT width);
+
+END_C_DECLORATION
+
+#endif /* REF_WRITER_H */
@@ -0,0 +1,145 @@
+
+/* Copyright 2006, 2014, 2021 United States Government as represented
+ * by the Administrator of the National Aeronautics and Space
+ * Administration. No copyright is claimed in the United States under
+ * Title 17, U.S. Code.  All Other Rights Reserved.
+ *
+ * The refine version 3 unstructured grid adaptation platform is
+ * licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+ * implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "ref_writer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ref_endian.h"
+#include "ref_malloc.h"
+#include "ref_mpi.h"
+
+int main(int argc, char *argv[]) {
+  REF_MPI ref_mpi;
+  RSS(ref_mpi_start(argc, argv), "start");
+  RSS(ref_mpi_create(&ref_mpi), "make mpi");
+
+  if (ref_mpi_once(ref_mpi)) { /* scalars with tell */
+    REF_WRITER ref_writer;
+    FILE *file;
+    char filename[] = "ref_writer_test_scalar.bin";
+    REF_FILEPOS position;
+    REF_INT int_value;
+    REF_LONG long_value;
+    REF_DBL dbl_value;
+    float float_value;
+
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "create");
+    RSS(ref_writer_int(ref_writer, 7), "int");
+    RSS(ref_writer_long(ref_writer, 8), "long");
+    RSS(ref_writer_dbl(ref_writer, 9.0), "dbl");
+    RSS(ref_writer_float(ref_writer, 10.0f), "float");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(4 + 8 + 8 + 4, position, "staged position");
+    RSS(ref_writer_free(ref_writer), "free");
+    fclose(file);
+
+    file = fopen(filename, "r");
+    RNS(file, "unable to open file");
+    REIS(1, fread(&int_value, sizeof(int_value), 1, file), "int");
+    REIS(7, int_value, "int");
+    REIS(1, fread(&long_value, sizeof(long_value), 1, file), "long");
+    REIS(8, long_value, "long");
+    REIS(1, fread(&dbl_value, sizeof(dbl_value), 1, file), "dbl");
+    RWDS(9.0, dbl_value, -1, "dbl");
+    REIS(1, fread(&float_value, sizeof(float_value), 1, file), "float");
+    RWDS(10.0, (REF_DBL)float_value, -1, "float");
+    fclose(file);
+    REIS(0, remove(filename), "test clean up");
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* swapped arrays span buffer flushes */
+    REF_WRITER ref_writer;
+    FILE *file;
+    char filename[] = "ref_writer_test_swap.bin";
+    REF_INT i, n = REF_WRITER_BUFFER / 8 + 3;
+    REF_INT *ints, int_value;
+    REF_DBL *dbls, dbl_value;
+
+    ref_malloc(ints, n, REF_INT);
+    ref_malloc(dbls, n, REF_DBL);
+    for (i = 0; i < n; i++) {
+      ints[i] = i;
+      dbls[i] = 0.5 * (REF_DBL)i;
+    }
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    RSS(ref_writer_create(&ref_writer, file, REF_TRUE), "create");
+    RSS(ref_writer_ints(ref_writer, n, ints), "ints");
+    RSS(ref_writer_dbls(ref_writer, n, dbls), "dbls");
+    RSS(ref_writer_free(ref_writer), "free");
+    fclose(file);
+
+    file = fopen(filename, "r");
+    RNS(file, "unable to open file");
+    for (i = 0; i < n; i++) {
+      REIS(1, fread(&int_value, sizeof(int_value), 1, file), "int");
+      SWAP_INT(int_value);
+      REIS(i, int_value, "int");
+    }
+    for (i = 0; i < n; i++) {
+      REIS(1, fread(&dbl_value, sizeof(dbl_value), 1, file), "dbl");
+      SWAP_DBL(dbl_value);
+      RWDS(0.5 * (REF_DBL)i, dbl_value, -1, "dbl");
+    }
+    fclose(file);
+    REIS(0, remove(filename), "test clean up");
+    ref_free(dbls);
+    ref_free(ints);
+  }
+
+  if (ref_mpi_once(ref_mpi)) { /* floats around a skipped gap */
+    REF_WRITER ref_writer;
+    FILE *file;
+    char filename[] = "ref_writer_test_skip.bin";
+    REF_FILEPOS position;
+    float floats[3] = {1.0f, 2.0f, 3.0f}, float_value;
+    REF_INT i;
+
+    file = fopen(filename, "w");
+    RNS(file, "unable to open file");
+    RSS(ref_writer_create(&ref_writer, file, REF_FALSE), "create");
+    RSS(ref_writer_floats(ref_writer, 3, floats), "floats");
+    RSS(ref_writer_skip(ref_writer, 2 * sizeof(float)), "skip");
+    RSS(ref_writer_tell(ref_writer, &position), "tell");
+    REIS(5 * sizeof(float), position, "skipped position");
+    RSS(ref_writer_float(ref_writer, 6.0f), "float");
+    RSS(ref_writer_free(ref_writer), "free");
+    fclose(file);
+
+    file = fopen(filename, "r");
+    RNS(file, "unable to open file");
+    for (i = 0; i < 3; i++) {
+      REIS(1, fread(&float_value, sizeof(float_value), 1, file), "float");
+      RWDS((REF_DBL)floats[i], (REF_DBL)float_value, -1, "float");
+    }
+    REIS(0, fseeko(file, (REF_FILEPOS)(5 * sizeof(float)), SEEK_SET), "seek");
+    REIS(1, fread(&float_value, sizeof(float_value), 1, file), "float");
+    RWDS(6.0, (REF_DBL)float_value, -1, "after gap");
+    fclose(file);
+    REIS(0, remove(filename), "test clean up");
+  }
+
+  RSS(ref_mpi_free(ref_mpi), "free");
+  RSS(ref_mpi_stop(), "stop");
+  return 0;
+}